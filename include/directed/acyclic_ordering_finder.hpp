@@ -5,6 +5,7 @@
 #include <string>
 #include <list>
 #include <vector>
+#include <queue>
 #include <exception>
 
 #include "directed/di_base.hpp"
@@ -161,6 +162,41 @@
  *               Eventually, (3,4) and (3,5) will be flipped to make the
  *               graph acyclic.
  *
+ * @remark
+ *        Greedy strategy (GREEDY)
+ *
+ *        As an alternative to the process above, which solves a network
+ *        simplex problem, a cost-weighted variant of the greedy heuristic
+ *        by Eades, Lin, and Smyth can be selected with setStrategy().
+ *        It builds the ordering from both ends, with s1 from the left
+ *        and s2 from the right, removing one node at a time from the
+ *        remaining graph.
+ *
+ *        - While there is a sink, remove it and prepend it to s2.
+ *        - While there is a source, remove it and append it to s1.
+ *        - Otherwise remove the node v with the maximum
+ *          (cost of the remaining outgoing edges) -
+ *          (cost of the remaining incoming edges) and append it to s1.
+ *
+ *        The ordering is s1 followed by s2. The node of the maximum
+ *        difference is found with a binary heap whose stale entries are
+ *        skipped on removal, and it runs in O((|V|+|E|) log |V|).
+ *        If G is acyclic, the ordering is topological.
+ *
+ *        For the example above, it removes 1, 4, and 5 by the maximum
+ *        difference, and then 3 and 2 as sinks.
+ *
+ *               Acyclic ordering: 1, 4, 5, 2, 3
+ *
+ *        (4,1), (3,4), and (3,5) will be flipped, whose total cost is 6,
+ *        while it is 5 above. Although it is worse for this example,
+ *        on large random digraphs it usually gives a lower total cost
+ *        and runs much faster.
+ *
+ * @reference P. Eades, X. Lin, and W. F. Smyth. A fast and effective
+ *            heuristic for the feedback arc set problem. Information
+ *            Processing Letters, 47(6):319-323, 1993.
+ *
  */
 namespace Wailea {
 
@@ -231,7 +267,7 @@ class AOFNode : public DiNode {
     inline AOFEdge& nextChild() { 
         edge_list_it_t eit = *mNextEdge;
         mNextEdge++;
-        return dynamic_cast<AOFEdge&>(*(*eit));
+        return downcast<AOFEdge>(*(*eit));
     }
 
     inline node_list_it_t dfsParent() { return mDfsParent; }
@@ -261,6 +297,16 @@ class AOFNode : public DiNode {
      */
     long                mRank;
 
+    /** @brief number of the incoming edges from the remaining nodes.
+     *         Used by the greedy strategy.
+     */
+    long                mNumInRemaining;
+
+    /** @brief number of the outgoing edges to the remaining nodes.
+     *         Used by the greedy strategy.
+     */
+    long                mNumOutRemaining;
+
     /** @brief (sum of cost of outgoing edges)-(sum of cost of incoming edges) 
      *
      *         If this is positive, the pull from the outgoing edges is 
@@ -271,6 +317,9 @@ class AOFNode : public DiNode {
      *
      *         This is also used by sweeping leave/enter algorithm in
      *         findMinimumRankGap().
+     *
+     *         The greedy strategy uses this for the costs of the edges
+     *         incident to the remaining nodes only.
      */
     long                mCost;
 
@@ -295,15 +344,40 @@ friend class AcyclicOrderingFinderTests;
 class AcyclicOrderingFinder {
 
   public:
+
+    /** @brief strategy to find the ordering.
+     *
+     *  - NETWORK_SIMPLEX: DFS feedback edges, ranking by network simplex,
+     *                     and the minimum gap.
+     *
+     *  - GREEDY:          cost-weighted Eades-Lin-Smyth heuristic.
+     */
+    enum strategyType {
+        NETWORK_SIMPLEX,
+        GREEDY
+    };
+
     /** @brief constructor
      *
      *  @param   G (in/out): The inpug graph for which an acyclic ordering
      *                       is to be found.
      */
-    inline AcyclicOrderingFinder(DiGraph& G):mG(G),mSupCost(0),mInfCost(0){;}
+    inline AcyclicOrderingFinder(DiGraph& G):
+        mG(G),
+        mSupCost(0),
+        mInfCost(0),
+        mStrategy(NETWORK_SIMPLEX){;}
 
     inline virtual ~AcyclicOrderingFinder(){;}
 
+    /** @brief sets the strategy. The default is NETWORK_SIMPLEX.
+     *
+     *  @param  strategy (in): strategy used by find()
+     */
+    inline void setStrategy(enum strategyType strategy) {
+        mStrategy = strategy;
+    }
+
     /** @brief finds the acyclic ordering. Also it sets AOFNode::rank()
      *         accordingly.
      *
@@ -311,8 +385,42 @@ class AcyclicOrderingFinder {
      */
     vector<node_list_it_t> find();
 
+    /** @brief returns the total cost of the edges that run against the
+     *         given ordering. Those are the edges to be flipped.
+     *
+     *  @param  ordering (in): ordering of all the nodes in G.
+     *
+     *  @return total cost of the feedback edges.
+     */
+    long feedbackCost(vector<node_list_it_t>& ordering);
+
   private:
 
+    /** @brief finds the acyclic ordering with the greedy strategy.
+     *
+     *  @return acyclic ordering of the node.  
+     */
+    vector<node_list_it_t> findByGreedy();
+
+    /** @brief removes the given node from the remaining graph for
+     *         findByGreedy(), and updates the adjacent nodes.
+     *
+     *  @param  N       (in):     node to be removed
+     *
+     *  @param  sources (in/out): the indices of the new sources are pushed
+     *
+     *  @param  sinks   (in/out): the indices of the new sinks are pushed
+     *
+     *  @param  heap    (in/out): the updated (cost, -index) of the
+     *                            adjacent nodes are pushed
+     */
+    void removeForGreedy(
+        AOFNode&                          N,
+        vector<long>&                     sources,
+        vector<long>&                     sinks,
+        priority_queue<pair<long,long> >& heap
+    );
+
     /** @brief find feedback edges using DFS.
      *
      *  @return number of feedback edges found.
@@ -358,6 +466,9 @@ class AcyclicOrderingFinder {
     /** @brief total cost of the edges going out from the inf node.*/
     long     mInfCost;
 
+    /** @brief strategy used by find() */
+    enum strategyType mStrategy;
+
 #ifdef UNIT_TESTS
 friend class AcyclicOrderingFinderTests;
 #endif
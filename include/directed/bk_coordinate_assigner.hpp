@@ -0,0 +1,320 @@
+#ifndef _WAILEA_DIRECTED_BK_COORDINATE_ASSIGNER_HPP_
+#define _WAILEA_DIRECTED_BK_COORDINATE_ASSIGNER_HPP_
+
+#include <iostream>
+#include <string>
+#include <list>
+#include <vector>
+#include <exception>
+
+#include "directed/di_base.hpp"
+#include "directed/sugiyama_digraph.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file directed/bk_coordinate_assigner.hpp
+ *
+ * @brief it assigns x-coordinates to the nodes of a SugiyamaDiGraph whose
+ *        nodes are arranged in ranks, such that the edges are as vertical
+ *        as possible and the nodes in the same rank do not overlap.
+ *
+ * @details
+ *    The input is the ranks of the nodes in the order found by, e.g.,
+ *    GKNVcrossingsReducer, and the width of each node given by
+ *    SugiyamaDiNode::setWidth(). Every edge must run between two adjacent
+ *    ranks, which is the case after
+ *    SugiyamaDiGraph::rankNodesAndAddVirtualNodes().
+ *    The x-coordinate of the center of each node is set to
+ *    SugiyamaDiNode::x(). Two adjacent nodes u and v in a rank are at
+ *    least (width(u) + width(v))/2 + node separation apart.
+ *
+ *    Process [BK]
+ *
+ *    1. Mark the type 1 conflicts, i.e., the edges that cross an inner
+ *       segment, which is an edge between two virtual nodes. This makes
+ *       the long edges straight.
+ *
+ *    2. For each of the four combinations of the vertical direction
+ *       (top-down or bottom-up) and the horizontal direction (left-right
+ *       or right-left):
+ *
+ *       2.1 Vertical alignment. Each node is aligned with one of its
+ *           median neighbors in the previous rank if the edge to it is not
+ *           marked and does not cross the alignments made so far in the
+ *           rank. The aligned nodes form a block, which is a vertical path
+ *           whose nodes get the same x-coordinate.
+ *
+ *       2.2 Horizontal compaction. The blocks are placed as close as
+ *           possible to their predecessors in the horizontal direction.
+ *           The blocks that are transitively bound by the predecessors
+ *           form a class, and each class is then shifted toward its
+ *           neighboring classes as far as possible.
+ *
+ *    3. The four layouts are aligned to the one with the smallest width,
+ *       and each node gets the average of the two median x-coordinates.
+ *       If the result violates the separation, which may happen with
+ *       non-uniform widths, the smallest layout is used instead.
+ *
+ *    4. Optionally, the priority method [STT] is applied for the given
+ *       number of sweeps. In each rank, the nodes are moved toward the
+ *       barycenter of their neighbors in the previous rank, in the
+ *       descending order of the priority. The virtual nodes have the
+ *       highest priority, and the others have their degrees toward the
+ *       previous rank. A node can push the nodes of lower priorities
+ *       but not the ones of higher priorities.
+ *
+ *    The steps 1-3 run in O(|V|+|E|). The step 4 runs in O(|V|*w) per
+ *    sweep where w is the maximum number of nodes in a rank.
+ *
+ *    The implementation of 2.2 records the required distance between
+ *    two classes, and computes the shifts of the classes in the
+ *    topological order of the classes, so that the shifts are propagated
+ *    transitively [BWZ]. The block placement is done iteratively with an
+ *    explicit stack for deep blocks.
+ *
+ * @reference [BK] U. Brandes and B. Koepf. Fast and simple horizontal
+ *            coordinate assignment. Graph Drawing 2001, LNCS 2265,
+ *            pp. 31-44, 2002.
+ *
+ * @reference [BWZ] U. Brandes, J. Walter, and J. Zink. Erratum: Fast and
+ *            simple horizontal coordinate assignment. arXiv:2008.01252,
+ *            2020.
+ *
+ * @reference [STT] K. Sugiyama, S. Tagawa, and M. Toda. Methods for
+ *            visual understanding of hierarchical system structures.
+ *            IEEE Transactions on Systems, Man, and Cybernetics,
+ *            11(2):109-125, 1981.
+ */
+namespace Wailea {
+
+namespace Directed {
+
+using namespace std;
+
+using namespace Wailea::Directed;
+
+
+/** @class  BKCoordinateAssigner
+ *
+ *  @brief  assigns the x-coordinates to the nodes of a SugiyamaDiGraph.
+ */
+class BKCoordinateAssigner {
+
+  public:
+
+    /** @brief default minimum gap between two adjacent nodes in a rank.
+     */
+    static constexpr double kDefaultNodeSeparation = 1.0;
+
+    /** @brief default number of the sweeps of the priority method.
+     */
+    static constexpr size_t kDefaultNumRefinementSweeps = 4;
+
+    /** @brief optional refinement after the Brandes-Koepf layout.
+     *
+     *  - NO_REFINEMENT:   Brandes-Koepf only.
+     *
+     *  - PRIORITY_METHOD: the priority method by Sugiyama et al.
+     */
+    enum refinementType {
+        NO_REFINEMENT,
+        PRIORITY_METHOD
+    };
+
+    /** @brief constructor
+     *
+     *  @param   G (in/out): The graph whose nodes are given x-coordinates.
+     */
+    inline BKCoordinateAssigner(SugiyamaDiGraph& G):
+        mG(G),
+        mNodeSeparation(kDefaultNodeSeparation),
+        mRefinement(NO_REFINEMENT),
+        mNumRefinementSweeps(kDefaultNumRefinementSweeps){;}
+
+    inline virtual ~BKCoordinateAssigner(){;}
+
+    /** @brief sets the minimum gap between two adjacent nodes in a rank.
+     *
+     *  @param  sep (in): gap between the boundaries of the nodes.
+     */
+    inline void setNodeSeparation(double sep) { mNodeSeparation = sep; }
+
+    /** @brief sets the refinement.
+     *
+     *  @param  refinement (in): refinement type
+     *
+     *  @param  numSweeps  (in): number of the sweeps for PRIORITY_METHOD.
+     */
+    inline void setRefinement(
+        enum refinementType refinement,
+        size_t              numSweeps = kDefaultNumRefinementSweeps
+    ) {
+        mRefinement          = refinement;
+        mNumRefinementSweeps = numSweeps;
+    }
+
+    /** @brief assigns the x-coordinates to the nodes in ranks.
+     *         The minimum of (x - width/2) becomes 0.0.
+     *
+     *  @param ranks (in): ranks[i] is the ordered list of the nodes in
+     *                     rank i.
+     */
+    void assign(vector<vector<node_list_it_t> >& ranks);
+
+  private:
+
+    /** @brief makes the dense node indices, the widths, and the neighbor
+     *         lists in the adjacent ranks sorted by the positions.
+     */
+    void prepare(vector<vector<node_list_it_t> >& ranks);
+
+    /** @brief marks the type 1 conflicts to mMarked.
+     */
+    void markType1Conflicts();
+
+    /** @brief finds the blocks by the vertical alignment.
+     *
+     *  @param  topDown   (in):  vertical direction
+     *
+     *  @param  leftRight (in):  horizontal direction
+     *
+     *  @param  root      (out): root[v] is the topmost node of the block of
+     *                           v in the vertical direction.
+     *
+     *  @param  align     (out): align[v] is the next node in the block of
+     *                           v. The last one points to the root.
+     */
+    void alignVertically(
+        bool          topDown,
+        bool          leftRight,
+        vector<long>& root,
+        vector<long>& align
+    );
+
+    /** @brief places the blocks by the horizontal compaction.
+     *
+     *  @param  leftRight (in):  horizontal direction
+     *
+     *  @param  root      (in):  output of alignVertically()
+     *
+     *  @param  align     (in):  output of alignVertically()
+     *
+     *  @param  x         (out): x-coordinates of the nodes
+     */
+    void compactHorizontally(
+        bool            leftRight,
+        vector<long>&   root,
+        vector<long>&   align,
+        vector<double>& x
+    );
+
+    /** @brief places the blocks by the longest paths in the block graph.
+     *         Used if the classes do not form an acyclic graph.
+     *
+     *  @param  leftRight (in):  horizontal direction
+     *
+     *  @param  root      (in):  output of alignVertically()
+     *
+     *  @param  x         (out): x-coordinates of the nodes
+     */
+    void compactByLongestPaths(
+        bool            leftRight,
+        vector<long>&   root,
+        vector<double>& x
+    );
+
+    /** @brief combines the four layouts.
+     *
+     *  @param  xs (in):  four layouts
+     *
+     *  @param  x  (out): combined layout
+     */
+    void balance(vector<vector<double> >& xs, vector<double>& x);
+
+    /** @brief applies the priority method.
+     *
+     *  @param  x  (in/out): layout
+     */
+    void refineByPriorityMethod(vector<double>& x);
+
+    /** @brief returns true if the nodes in each rank are apart at least
+     *         by the separation in x.
+     */
+    bool isValidLayout(vector<double>& x);
+
+    /** @brief returns the minimum distance between the centers of the
+     *         given two nodes that are adjacent in a rank.
+     */
+    inline double separation(long u, long v) {
+        return (mWidths[u] + mWidths[v]) / 2.0 + mNodeSeparation;
+    }
+
+    /** @brief returns the node before v in the horizontal direction in
+     *         the rank of v, or -1 if v is the first one.
+     */
+    long predecessor(long v, bool leftRight);
+
+    /** @brief the input graph */
+    SugiyamaDiGraph&           mG;
+
+    /** @brief minimum gap between two adjacent nodes */
+    double                     mNodeSeparation;
+
+    /** @brief refinement type */
+    enum refinementType        mRefinement;
+
+    /** @brief number of the sweeps of the priority method */
+    size_t                     mNumRefinementSweeps;
+
+    /** @brief the nodes in the dense indices */
+    vector<node_list_it_t>     mNodes;
+
+    /** @brief the node indices in each rank */
+    vector<vector<long> >      mLayers;
+
+    /** @brief rank of each node */
+    vector<long>               mLayerOf;
+
+    /** @brief position of each node in its rank */
+    vector<long>               mPos;
+
+    /** @brief width of each node */
+    vector<double>             mWidths;
+
+    /** @brief true if the node is virtual */
+    vector<bool>               mVirtual;
+
+    /** @brief mUpNodes[mUpStart[v]..mUpStart[v+1]) are the neighbors of
+     *         v in the previous rank sorted by the positions.
+     */
+    vector<long>               mUpStart;
+    vector<long>               mUpNodes;
+
+    /** @brief true if the edge for the entry in mUpNodes has a type 1
+     *         conflict.
+     */
+    vector<bool>               mMarked;
+
+    /** @brief mDownNodes[mDownStart[v]..mDownStart[v+1]) are the neighbors
+     *         of v in the next rank sorted by the positions.
+     *         mDownUpIndex holds the corresponding index in mUpNodes.
+     */
+    vector<long>               mDownStart;
+    vector<long>               mDownNodes;
+    vector<long>               mDownUpIndex;
+
+#ifdef UNIT_TESTS
+friend class BKCoordinateAssignerTests;
+#endif
+};
+
+
+}// namespace Directed
+
+}// namespace Wailea
+
+#endif /*_WAILEA_DIRECTED_BK_COORDINATE_ASSIGNER_HPP_*/
@@ -6,6 +6,7 @@
 #include <list>
 #include <vector>
 #include <exception>
+#include <stdexcept>
 
 #include "directed/di_base.hpp"
 
@@ -50,6 +51,20 @@
  *          3. Forward BFS again. Assume the earliest time for all the source
  *             nodes are equal to their latest time found in the previous BFS,
  *             find the earliest time for each node.
+ *
+ *          The nodes are visited in a topological order, and each node
+ *          pulls its time from its predecessors (forward) or successors
+ *          (backward). In PARALLEL mode, the nodes are grouped into the
+ *          levels by the longest number of edges from the sources, and the
+ *          nodes in a level are processed by the worker threads at the same
+ *          time, as no edge connects two nodes in the same level.
+ *
+ *          After findCriticalPaths(), the lengths can be changed by
+ *          setNodeLength() and setEdgeLength(), and updateCriticalPaths()
+ *          recomputes the times only for the nodes affected by the changes.
+ *          Each of the 3 passes starts from the nodes whose inputs have
+ *          changed, and it proceeds in the topological order only while the
+ *          times change.
  */
 
 namespace Wailea {
@@ -73,7 +88,9 @@ class CPDiNode : public DiNode {
         mLength(length),
         mEarliestStart(0),
         mLatestStart(0),
-        mNumNeighborsProcessed(0){;}
+        mInitialEarliestStart(0),
+        mNumNeighborsProcessed(0),
+        mOrder(0){;}
 
     inline virtual ~CPDiNode(){;}
 
@@ -82,6 +99,7 @@ class CPDiNode : public DiNode {
     inline long earliestFinish() const noexcept {
                                               return mEarliestStart + mLength;}
     inline long latestFinish()  const noexcept {return mLatestStart + mLength;}
+    inline long length()        const noexcept {return mLength;}
 
 
   protected:
@@ -99,11 +117,20 @@ class CPDiNode : public DiNode {
      */
     long           mLatestStart;
 
+    /** @brief the earliest possible start time found by the first forward
+     *         BFS, where all the source nodes start at 0.
+     */
+    long           mInitialEarliestStart;
+
     /** @brief number of neighbors that have checked this node
      *         used in BFS to enqueue this node.
      */
     size_t         mNumNeighborsProcessed;
 
+    /** @brief position in the topological order.
+     */
+    size_t         mOrder;
+
     friend class CriticalPath;
 #ifdef UNIT_TESTS
   friend class CriticalPathTests;
@@ -123,6 +150,8 @@ class CPDiEdge : public DiEdge {
 
     inline virtual ~CPDiEdge(){;}
 
+    inline long length() const noexcept {return mLength;}
+
   protected:
 
     /** @ brief minimum length of the time required 
@@ -146,6 +175,35 @@ class CPDiEdge : public DiEdge {
 class CriticalPath {
 
   public:
+
+    enum executionMode {
+        SEQUENTIAL,
+        PARALLEL
+    };
+
+    inline CriticalPath():
+        mExecutionMode(SEQUENTIAL),
+        mNumThreads(0),
+        mGraph(nullptr),
+        mMaxEarliestStart(0){;}
+
+    /** @brief sets how the full computation in findCriticalPaths() is
+     *         performed.
+     *
+     *  @param  mode       (in): execution mode
+     *
+     *  @param  numThreads (in): number of the worker threads for PARALLEL.
+     *                           If it is 0,
+     *                           std::thread::hardware_concurrency() is used.
+     */
+    inline void setExecutionMode(
+        enum executionMode mode,
+        size_t             numThreads = 0
+    ) {
+        mExecutionMode = mode;
+        mNumThreads    = numThreads;
+    }
+
     /** @brief finds critical path in the given digraph.
      *
      *  @param D (in/out) : DiGraph with CPDiNode and CPDiEdges as 
@@ -162,50 +220,168 @@ class CriticalPath {
      */
     void findCriticalPaths(DiGraph& D);
 
-  private:
+    /** @brief changes the length of a node in the digraph given to the last
+     *         call to findCriticalPaths(). The times are not updated until
+     *         updateCriticalPaths() is called.
+     *
+     *  @param N      (in/out): node whose length is changed
+     *
+     *  @param length (in):     new length
+     *
+     *  @throw  std::invalid_argument(Constants::kExceptionNodeNotInGraph)
+     *              if N is not in the digraph.
+     */
+    void setNodeLength(CPDiNode& N, long length);
 
-    /** @brief find the source and destination nodes.
+    /** @brief changes the length of an edge in the digraph given to the last
+     *         call to findCriticalPaths(). The times are not updated until
+     *         updateCriticalPaths() is called.
+     *
+     *  @param E      (in/out): edge whose length is changed
+     *
+     *  @param length (in):     new length
+     *
+     *  @throw  std::invalid_argument(Constants::kExceptionEdgeNotInGraph)
+     *              if E is not in the digraph.
      */
-    void findTerminals(DiGraph& D);
+    void setEdgeLength(CPDiEdge& E, long length);
 
-    /** @brief it sets earliest time of the nodes to 0.
+    /** @brief updates the times after the lengths have been changed by
+     *         setNodeLength() and setEdgeLength().
+     *
+     *  @remark  The result is the same as findCriticalPaths() with the new
+     *           lengths. The nodes and edges must not be added or removed
+     *           after findCriticalPaths(). If the latest earliest start time
+     *           in the digraph changes, all the nodes are scanned once to
+     *           find the ones affected by it.
      */
-    void resetForForwardPath1(DiGraph& D);
+    void updateCriticalPaths();
 
-    /** @brief it sets the latest time of the nodes to the specified value
-     *         except for the destinations for which it is set to their 
-     *         earliest time.
+  private:
+
+    /** @brief finds the topological order and the levels of the nodes.
+     */
+    void findTopologicalOrder(DiGraph& D);
+
+    /** @brief returns the earliest start time of the node found from its
+     *         predecessors.
+     *
+     *  @param N       (in): node
      *
-     *  @param latestStart (in): the value set to the latest time of the nodes
+     *  @param initial (in): true for the first forward BFS where the source
+     *                       nodes start at 0.
      */
-    void resetForBackwardPath(DiGraph& D, long latestStart);
+    long earliestStartFromPredecessors(CPDiNode& N, bool initial);
 
-    /** @brief it sets the earliest time of the nodes to 0
-     *         except for the source nodes for which it is set to their
-     *         latest time.
+    /** @brief returns the latest start time of the node found from its
+     *         successors.
      */
-    void resetForForwardPath2(DiGraph& D);
+    long latestStartFromSuccessors(CPDiNode& N);
+
+    /** @brief returns the latest (greatest) earliest start time found by
+     *         the first forward BFS.
+     */
+    long findMaxEarliestStart();
 
     /** @brief performs a forward BFS and find the earliest time for each
-     *         node. It also finds the latest (greatest) start time found.
+     *         node.
      *
-     *  @return  the latest start time found
+     *  @param initial (in): true for the first forward BFS.
      */
-    long performForwardPath(DiGraph&   D);
+    void performForwardPath(bool initial);
 
     /** @brief performs a backward BFS and find the latest time for each
      *         node.
      */
-    void performBackwardPath(DiGraph&  D);
+    void performBackwardPath();
 
+    /** @brief visits all the nodes level by level, and calls the given
+     *         function for each node.
+     *
+     *  @param forward (in): true if the levels are visited from the
+     *                       sources.
+     *
+     *  @param visit   (in): function called for each node. It must modify
+     *                       only the node given to it.
+     */
+    template<class FUNC>
+    void visitLevels(bool forward, FUNC visit);
+
+    /** @brief updates the earliest times of the nodes affected by the
+     *         given nodes in the topological order.
+     *
+     *  @param seeds   (in):  nodes whose predecessors or lengths have
+     *                        changed
+     *
+     *  @param initial (in):  true for the first forward BFS.
+     *
+     *  @param changed (out): nodes whose earliest times have changed and
+     *                        their old values.
+     */
+    void propagateForward(
+        vector<CPDiNode*>&               seeds,
+        bool                             initial,
+        vector<pair<CPDiNode*, long>>&   changed
+    );
+
+    /** @brief updates the latest times of the nodes affected by the
+     *         given nodes in the reverse topological order.
+     *
+     *  @param seeds   (in):  nodes whose successors or lengths have changed
+     *
+     *  @param changed (out): nodes whose latest times have changed.
+     */
+    void propagateBackward(
+        vector<CPDiNode*>&               seeds,
+        vector<CPDiNode*>&               changed
+    );
+
+    /** @brief returns the number of the threads to be used.
+     */
+    size_t numThreadsFor(size_t numTasks);
+
+    /** @brief execution mode */
+    enum executionMode     mExecutionMode;
+
+    /** @brief number of the worker threads for PARALLEL.
+     *         0 means std::thread::hardware_concurrency().
+     */
+    size_t                 mNumThreads;
+
+    /** @brief digraph given to the last call to findCriticalPaths().
+     */
+    DiGraph*               mGraph;
+
+    /** @brief nodes in the topological order.
+     */
+    vector<CPDiNode*>      mOrder;
+
+    /** @brief index into mOrder where each level starts followed by
+     *         mOrder.size().
+     */
+    vector<size_t>         mLevelBegins;
 
-    /** @brief stores the source nodes of the graph.
+    /** @brief the latest earliest start time found by the first forward
+     *         BFS.
      */
-    vector<node_list_it_t> mSources;
+    long                   mMaxEarliestStart;
 
-    /** @brief stores the destination nodes of the graph.
+    /** @brief nodes whose lengths have been changed by setNodeLength().
      */
-    vector<node_list_it_t> mDestinations;
+    vector<CPDiNode*>      mChangedNodes;
+
+    /** @brief edges whose lengths have been changed by setEdgeLength().
+     */
+    vector<CPDiEdge*>      mChangedEdges;
+
+    /** @brief flags used in the propagations not to enqueue a node twice.
+     *         Indexed by the topological order.
+     */
+    vector<bool>           mQueued;
+
+#ifdef UNIT_TESTS
+  friend class CriticalPathTests;
+#endif
 
 };
 
@@ -211,7 +211,7 @@ class DFSDiNode : public BASE_NODE {
                 it++;
                 if (mReversed) {
                     for(;it != this->incidentEdgesIn().second; it++) {
-                        DDiEdge& e = dynamic_cast<DDiEdge&>(*(*(*it)));
+                        DDiEdge& e = downcast<DDiEdge>(*(*(*it)));
                         if (e.isVisited()==false) {
                             return true;
                         }
@@ -219,7 +219,7 @@ class DFSDiNode : public BASE_NODE {
                 }
                 else {
                     for(;it != this->incidentEdgesOut().second; it++) {
-                        DDiEdge& e = dynamic_cast<DDiEdge&>(*(*(*it)));
+                        DDiEdge& e = downcast<DDiEdge>(*(*(*it)));
                         if (e.isVisited()==false) {
                             return true;
                         }
@@ -233,7 +233,7 @@ class DFSDiNode : public BASE_NODE {
                 for(auto it = mEdgeVisiting;
                                   it != this->incidentEdgesIn().second; it++) {
                                                                       
-                    DDiEdge& e = dynamic_cast<DDiEdge&>(*(*(*it)));
+                    DDiEdge& e = downcast<DDiEdge>(*(*(*it)));
                     if (e.isVisited()==false) {
                         return true;
                     }
@@ -243,7 +243,7 @@ class DFSDiNode : public BASE_NODE {
                 for(auto it = mEdgeVisiting;
                                  it != this->incidentEdgesOut().second; it++) {
                                                                       
-                    DDiEdge& e = dynamic_cast<DDiEdge&>(*(*(*it)));
+                    DDiEdge& e = downcast<DDiEdge>(*(*(*it)));
                     if (e.isVisited()==false) {
                         return true;
                     }
@@ -256,7 +256,7 @@ class DFSDiNode : public BASE_NODE {
 
     inline DDiEdge& currentDFSEdge() noexcept {
 
-        return dynamic_cast<DDiEdge&>(*(*(*mEdgeVisiting)));
+        return downcast<DDiEdge>(*(*(*mEdgeVisiting)));
 
     }
 
@@ -402,7 +402,7 @@ class DFSDiEdge : public BASE_EDGE {
     inline DFSDiNode<BASE_GRAPH,BASE_NODE,BASE_EDGE>& adjacentDFSDiNode(
         DFSDiNode<BASE_GRAPH,BASE_NODE,BASE_EDGE>& n
     ) const noexcept {
-        return dynamic_cast<DFSDiNode<BASE_GRAPH,BASE_NODE,BASE_EDGE>&>
+        return downcast<DFSDiNode<BASE_GRAPH,BASE_NODE,BASE_EDGE>>
                    (this->adjacentNode(n));
     }
 
@@ -731,7 +731,7 @@ inline void DiNode::reorderIncidenceIn(
         throw std::invalid_argument(Constants::kExceptionNodeNotInGraph);
     }
 
-    mIncidenceIn = std::move(reorderedEdgesIn);
+    mIncidenceIn.assign(reorderedEdgesIn.begin(), reorderedEdgesIn.end());
 
     for (auto mit = mIncidenceIn.begin(); mit != mIncidenceIn.end(); mit++) {
 
@@ -758,7 +758,8 @@ inline void DiNode::reorderIncidenceOut(
         throw std::invalid_argument(Constants::kExceptionNodeNotInGraph);
     }
 
-    mIncidenceOut = std::move(reorderedEdgesOut);
+    mIncidenceOut.assign(
+                  reorderedEdgesOut.begin(), reorderedEdgesOut.end());
 
     for (auto mit = mIncidenceOut.begin(); mit != mIncidenceOut.end(); mit++) {
 
@@ -20,6 +20,26 @@
  * @brief it tries to reduce the number of crossings for a given acyclic
  *        digraph whose nodes are given acyclic ranks
  *
+ *  @details
+ *    In PARALLEL mode, reduce() runs several restarts of the heuristics
+ *    from different initial orders in worker threads and keeps the one
+ *    with the fewest crossings. Restart 0 starts from the same initial
+ *    order as SEQUENTIAL, and restart k > 0 starts from the DFS whose
+ *    roots are picked in a shuffled order with the seed k. The odd
+ *    restarts begin with a backward median sweep.
+ *    In PARALLEL mode, the transposition is also applied to the even
+ *    ranks and then to the odd ranks. A swap in a rank only reads the
+ *    adjacent ranks, so the ranks of the same parity can be processed
+ *    concurrently. If there is only one restart, they are processed
+ *    by the worker threads.
+ *    The result depends only on the number of restarts, not on the number
+ *    of threads.
+ *
+ *    The positions of the nodes in the neighboring ranks are kept in a
+ *    buffer per thread indexed by the node index in the utility, which is
+ *    set before the heuristics are applied and is only read by the
+ *    threads.
+ *
  *  @reference [GKNV] E. R. Gansner, E. Koutsofios, S. C. North, and
  *             K.-P Vo. A technique for drawing directed graphs. IEEE
  *             Transactions on Software Engineering, 19(3):214–230, 
@@ -43,14 +63,64 @@ class GKNVcrossingsReducer {
 
   public:
 
+    /** @brief default number of the restarts in PARALLEL mode.
+     */
+    static constexpr size_t kDefaultNumRestarts = 4;
+
+    /** @brief minimum number of the nodes per thread for the parity
+     *         transposition of a single restart in PARALLEL mode. Below
+     *         this, the synchronization of the threads costs more than the
+     *         transposition, and fewer threads are used.
+     */
+    static constexpr size_t kMinNodesPerTransposeThread = 128;
+
+    /** @brief how the heuristics are applied.
+     *
+     *  - SEQUENTIAL: one run from the DFS order.
+     *
+     *  - PARALLEL:   multiple restarts in the worker threads, and the
+     *                transposition over the ranks of the same parity at a
+     *                time.
+     */
+    enum executionMode {
+        SEQUENTIAL,
+        PARALLEL
+    };
+
     /** @brief constructor
      *
      *  @param   G (in/out): The inpug digraph
      */
-    inline GKNVcrossingsReducer(DiGraph& G):mG(G){;}
+    inline GKNVcrossingsReducer(DiGraph& G):
+        mG(G),
+        mExecutionMode(SEQUENTIAL),
+        mNumRestarts(kDefaultNumRestarts),
+        mNumThreads(0),
+        mMinNodesPerTransposeThread(kMinNodesPerTransposeThread){;}
 
     inline virtual ~GKNVcrossingsReducer(){;}
 
+    /** @brief sets how the heuristics are applied.
+     *
+     *  @param  mode        (in): execution mode
+     *
+     *  @param  numRestarts (in): number of the restarts for PARALLEL.
+     *                            If it is 0, kDefaultNumRestarts is used.
+     *
+     *  @param  numThreads  (in): number of the worker threads for PARALLEL.
+     *                            If it is 0,
+     *                            std::thread::hardware_concurrency() is used.
+     */
+    inline void setExecutionMode(
+        enum executionMode mode,
+        size_t             numRestarts = kDefaultNumRestarts,
+        size_t             numThreads  = 0
+    ) {
+        mExecutionMode = mode;
+        mNumRestarts   = (numRestarts == 0) ? kDefaultNumRestarts : numRestarts;
+        mNumThreads    = numThreads;
+    }
+
 
     /** @brief main function to attempt to reduce the number of crossings
      *         of edges using GKNV heuristics for a given node rank assignment
@@ -72,8 +142,61 @@ class GKNVcrossingsReducer {
     /** @brief reorder the nodes in each rank based on DFS.
      *
      *  @param ranks (in/out): ranks. Each rank has an ordered list of nodes.
+     *
+     *  @param seed  (in):     if it is 0, the DFS roots are picked in the
+     *                         order of the nodes in ranks. Otherwise, in
+     *                         an order shuffled with this seed.
+     */
+    void initialOrderByDFS(
+        vector<vector<node_list_it_t> >& ranks,
+        unsigned long                    seed = 0
+    );
+
+
+    /** @brief sets the index of each node to its utility, which is used to
+     *         access the position buffers.
+     */
+    void pushNodeIndices();
+
+
+    /** @brief removes the utility set by pushNodeIndices().
      */
-    void initialOrderByDFS(vector<vector<node_list_it_t> >& ranks);
+    void popNodeIndices();
+
+
+    /** @brief returns the number of the threads to use for the given
+     *         number of the tasks.
+     */
+    size_t numThreadsFor(size_t numTasks);
+
+
+    /** @brief iterates the median and the transpose heuristics from the
+     *         current arrangement.
+     *
+     *  @param  ranks         (in/out): node arrangement
+     *
+     *  @param  numIterations (in): max number of iterations
+     *
+     *  @param  forwardFirst  (in): true if the first median sweep is
+     *                              forward.
+     *
+     *  @param  byParity      (in): true if the transposition is applied to
+     *                              the even ranks and then to the odd ranks.
+     *
+     *  @param  numThreads    (in): max number of the threads for the
+     *                              transposition if byParity is true.
+     *                              The threads are created once, and they
+     *                              are reused over the iterations.
+     *
+     *  @return number of crossings with the resultant node arrangement.
+     */
+    long iterateHeuristics(
+        vector<vector<node_list_it_t> >& ranks,
+        long                             numIterations,
+        bool                             forwardFirst,
+        bool                             byParity,
+        size_t                           numThreads
+    );
 
 
     /** @brief one iteration of median heuristic either forward or backward
@@ -84,20 +207,69 @@ class GKNVcrossingsReducer {
      *
      *  @param  forward  (in): true if the direction is from rank 0 forward.
      *                         false if the direction is down to 0 backward.
+     *
+     *  @param  positionOf (in/out): position buffer indexed by the node
+     *                               index.
      */
     void applyMedianHeuristic(
         vector<vector<node_list_it_t> >& oldRanks,
         vector<vector<node_list_it_t> >& newRanks,
-        bool forward
+        bool forward,
+        vector<long>& positionOf
     );
 
 
     /** @brief applies transpose heuristic. Swap two adjacent nodes in the 
      *         the same rank and see if it reduces the crossings.
      *
-     *  @param  ranks (in/out): node arrangement
+     *  @param  ranks      (in/out): node arrangement
+     *
+     *  @param  positionOf (in/out): position buffer indexed by the node
+     *                               index.
+     */
+    void applyTransposeHeuristic(
+        vector<vector<node_list_it_t> >& ranks,
+        vector<long>&                    positionOf
+    );
+
+
+    /** @brief applies transpose heuristic to the ranks of the given
+     *         parity assigned to a worker thread. The ranks of the other
+     *         parity are only read.
+     *
+     *  @param  ranks      (in/out): node arrangement
+     *
+     *  @param  parity     (in):     0 for the even ranks, 1 for the odd.
+     *
+     *  @param  t          (in):     index of the thread
+     *
+     *  @param  numThreads (in):     number of the threads
+     *
+     *  @param  positionOf (in/out): position buffer of the thread.
+     */
+    void applyTransposeHeuristicToParity(
+        vector<vector<node_list_it_t> >& ranks,
+        long                             parity,
+        size_t                           t,
+        size_t                           numThreads,
+        vector<long>&                    positionOf
+    );
+
+
+    /** @brief applies transpose heuristic to one rank.
+     *
+     *  @param  ranks      (in/out): node arrangement
+     *
+     *  @param  i          (in):     index of the rank
+     *
+     *  @param  positionOf (in/out): position buffer indexed by the node
+     *                               index.
      */
-    void applyTransposeHeuristic(vector<vector<node_list_it_t> >& ranks);
+    void transposeRank(
+        vector<vector<node_list_it_t> >& ranks,
+        long                             i,
+        vector<long>&                    positionOf
+    );
 
 
     /** @brief try swapping the adjacent nodes on the left hand side.
@@ -106,10 +278,13 @@ class GKNVcrossingsReducer {
      *  @param   leftRank    (in): rank[0]
      *
      *  @param   rightRank   (in): rank[1]
+     *
+     *  @param   positionOf  (in/out): position buffer
      */
     void tryTransposeLeft(
         vector<node_list_it_t>& leftRank,
-        vector<node_list_it_t>& rightRank
+        vector<node_list_it_t>& rightRank,
+        vector<long>&           positionOf
     );
 
 
@@ -120,11 +295,14 @@ class GKNVcrossingsReducer {
      *  @param   midRank     (in): rank[i]
      *
      *  @param   rightRank   (in): rank[i+1]
+     *
+     *  @param   positionOf  (in/out): position buffer
      */
     void tryTransposeMid(
         vector<node_list_it_t>& leftRank,
         vector<node_list_it_t>& midRank,
-        vector<node_list_it_t>& rightRank
+        vector<node_list_it_t>& rightRank,
+        vector<long>&           positionOf
     );
 
 
@@ -134,35 +312,94 @@ class GKNVcrossingsReducer {
      *  @param   leftRank    (in): rank[last -1]
      *
      *  @param   rightRank   (in): rank[last]
+     *
+     *  @param   positionOf  (in/out): position buffer
      */
     void tryTransposeRight(
         vector<node_list_it_t>& leftRank,
-        vector<node_list_it_t>& rightRank
+        vector<node_list_it_t>& rightRank,
+        vector<long>&           positionOf
     );
 
 
     /** @brief calculates the number of crossings in the input graph in mG.
      *
-     *  @param ranks (in): ranks. Each rank has an ordered list of nodes.
+     *  @param ranks      (in): ranks. Each rank has an ordered list of nodes.
+     *
+     *  @param positionOf (in/out): position buffer
      *
      *  @return number of crossings
      */
-    long calculateNumberOfCrossings(vector<vector<node_list_it_t> >& ranks);
+    long calculateNumberOfCrossings(
+        vector<vector<node_list_it_t> >& ranks,
+        vector<long>&                    positionOf
+    );
 
 
     /** @brief calculates the number of crossings between
      *         two consecutive ranks as a bipartite graph
+     *         in O(|E| log |V|) with the accumulator tree by Barth, Juenger,
+     *         and Mutzel.
      *
      *  @param leftNodes (in): ordered list of nodes on the left hand side,
      *                         assuming the graph flows from left to right.
      *
      *  @param rightNodes (in): ordered list of nodes on the right hand side.
      *
+     *  @param positionOf (in/out): position buffer
+     *
      *  @return number of crossings
      */
     long calculateNumberOfCrossings(
         vector<node_list_it_t>& leftNodes,
-        vector<node_list_it_t>& rightNodes
+        vector<node_list_it_t>& rightNodes,
+        vector<long>&           positionOf
+    );
+
+
+    /** @brief collects the sorted positions of the adjacent nodes of each
+     *         node in the neighboring rank.
+     *
+     *  @param nodes         (in): ordered list of nodes in a rank.
+     *
+     *  @param adjacentNodes (in): ordered list of nodes in the neighboring
+     *                             rank.
+     *
+     *  @param outgoing      (in): true if adjacentNodes are on the right
+     *                             hand side (out-edges are used).
+     *                             false if on the left (in-edges are used).
+     *
+     *  @param positions    (out): positions[i] is the sorted list of the
+     *                             positions in adjacentNodes of the adjacent
+     *                             nodes of nodes[i].
+     *
+     *  @param positionOf   (in/out): buffer to hold the positions of
+     *                             adjacentNodes indexed by the node index.
+     */
+    void findAdjacentPositions(
+        vector<node_list_it_t>& nodes,
+        vector<node_list_it_t>& adjacentNodes,
+        bool                    outgoing,
+        vector<vector<long> >&  positions,
+        vector<long>&           positionOf
+    );
+
+
+    /** @brief calculates the number of crossings among the edges incident
+     *         to two nodes u and v in the same rank where u is placed
+     *         before v.
+     *
+     *  @param positionsU (in): sorted positions of the adjacent nodes of u
+     *                          in the neighboring rank.
+     *
+     *  @param positionsV (in): sorted positions of the adjacent nodes of v
+     *                          in the neighboring rank.
+     *
+     *  @return number of crossings
+     */
+    static long countCrossingsOfPair(
+        const vector<long>& positionsU,
+        const vector<long>& positionsV
     );
 
 
@@ -174,11 +411,14 @@ class GKNVcrossingsReducer {
      *  @param rightNodes (in): ordered list of right nodes.
      *
      *  @param newRightNodes (out): reordered list of right nodes.
+     *
+     *  @param positionOf (in/out): position buffer
      */
     void reorderRightSideByMedianHeuristic(
         vector<node_list_it_t>& leftNodes,
         vector<node_list_it_t>& rightNodes,
-        vector<node_list_it_t>& newRightNodes
+        vector<node_list_it_t>& newRightNodes,
+        vector<long>&           positionOf
     );
 
 
@@ -190,11 +430,14 @@ class GKNVcrossingsReducer {
      *  @param rightNodes (in): ordered list of right nodes.
      *
      *  @param newLeftNodes (out): reordered list of left nodes.
+     *
+     *  @param positionOf (in/out): position buffer
      */
     void reorderLeftSideByMedianHeuristic(
         vector<node_list_it_t>& leftNodes,
         vector<node_list_it_t>& rightNodes,
-        vector<node_list_it_t>& newLeftNodes
+        vector<node_list_it_t>& newLeftNodes,
+        vector<long>&           positionOf
     );
 
 
@@ -211,6 +454,22 @@ class GKNVcrossingsReducer {
     /** @brief the input graph */
     DiGraph& mG;
 
+    /** @brief execution mode */
+    enum executionMode mExecutionMode;
+
+    /** @brief number of the restarts for PARALLEL */
+    size_t             mNumRestarts;
+
+    /** @brief number of the worker threads for PARALLEL.
+     *         0 means std::thread::hardware_concurrency().
+     */
+    size_t             mNumThreads;
+
+    /** @brief minimum number of the nodes per thread for the parity
+     *         transposition.
+     */
+    size_t             mMinNodesPerTransposeThread;
+
 
     /** @brief utility functions for std::sort() to rearrange the
      *         incident edge list of nodes.
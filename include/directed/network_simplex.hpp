@@ -6,8 +6,10 @@
 #include <list>
 #include <vector>
 #include <exception>
+#include <cmath>
 
 #include "directed/di_base.hpp"
+#include "undirected/element_pool.hpp"
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -193,24 +195,30 @@
  *          The non-basis edges that have negative Z are kept in the list
  *          so that an entering edge can be found in O(1) time without scanning
  *          the edes in the digraph.
+ *          Which of them enters the basis is decided by the pricing strategy
+ *          set by setPricing(). By default the first one in the list is
+ *          picked. Dantzig's rule (the most negative Z), partial pricing
+ *          over a block of the list, and a cyclic search that resumes where
+ *          the previous one stopped are also available. The number of
+ *          pivots is reported by numPivots().
  *
  *        - Orientation of the spanning tree from a designated root.
  *          Orienting the spanning tree from the root and adding some
  *          additional attributes will make the discovery of (ve2,ve1)-path,
  *          and STnr efficient. Each spanning tree node has the following 
  *          attributes.
- *           - mDepth           : distance from the root on the spanning tree
  *           - mPrec            : the parent edge toward the root
- *           - mThreadPrev&Next : list of nodes in the pre-order traversal of
- *                                DFS from the root.
+ *           - mSize            : number of the nodes in the subtree rooted
+ *                                at the node
  *
  *          (ve2,ve1)-path is found from ve2 and ve1 forming two paths by 
  *          following the parent link mPrec from those two nodes.
- *          Those two paths eventually merge at a node.
- *          To avoid one from passing the other path, mDepth is used such that
- *          only the deeper of the two nodes is advanced.
- *
- *                      -----------------  Depth  --------------->
+ *          Those two paths eventually merge at a node (apex).
+ *          The two paths are followed alternately marking the nodes with
+ *          mCycleGeneration, and the first node found marked by the other
+ *          path is the apex. Neither path goes beyond the apex by more
+ *          than the length of the other, and this takes time proportional
+ *          to the length of the cycle.
  *
  *                   mPrec     mPrec     mPrec                  mPrec
  *           merging <----n2 <------ n3 <---...     <------ nx <----- ve2
@@ -219,10 +227,90 @@
  *                 ------ n1 <------ n2 <-...--  ve1 - - - - - - - - - -
  *                  mPrec     mPrec                      (ve1,ve2) entering
  *
- *          STnr is found by mThreadPrev/Next. The root of STnr is the deeper
- *          of vl1 or vl2. Starting from the root, follow mThreadNext until
- *          the depth of the nodes gets shallower than the root.
- *          This gives the nodes in STnr.
+ *          The root of STnr is the child side of (vl1,vl2), i.e., the node
+ *          whose mPrec is (vl1,vl2).
+ *
+ *        - Smaller side of the cut.
+ *          The size of STnr is mSize of its root, which is known before any
+ *          node is visited. If STnr has at most half of the nodes, STnr is
+ *          collected by a DFS on the spanning tree from its root. Otherwise
+ *          ST\STnr is collected by a DFS from the root that does not cross
+ *          (vl1,vl2). Either way only the nodes on the smaller side are
+ *          visited, and they are marked with mNsGeneration, which makes the
+ *          test if a node is in STnr O(1).
+ *          The cut set at P5 is found from the incident edges of the nodes
+ *          on that side, and at P7 y_{n} of the nodes in ST\STnr are
+ *          shifted in the opposite direction when it is the smaller side,
+ *          which gives the same Z. As the root may be shifted, Y is
+ *          anchored at the root again at the end.
+ *
+ *        - Update of the spanning tree at P9.
+ *          STnr is hung from the root side of (ve1,ve2) by reversing mPrec
+ *          on the path from the STnr side of (ve1,ve2) to the root of STnr.
+ *          mSize changes only on that path and on the (ve2,ve1)-path below
+ *          the apex. The root does not change, and the update takes time
+ *          proportional to the length of the cycle.
+ *          Together with the above, a pivot takes time proportional to the
+ *          length of the cycle plus the size of the smaller side and the
+ *          number of the edges incident to it.
+ *          The vectors for the cycle, the nodes, the cut, and the DFS stack
+ *          are kept in the members and reused by the pivots.
+ *
+ *        - Strongly feasible tree (STRONGLY_FEASIBLE_TREE)
+ *          A spanning tree is strongly feasible if every basis edge with
+ *          zero X is oriented toward the root.
+ *          The initial tree is a star from an artificial root that has an
+ *          artificial edge to every node, (v,root) if b(v) >= 0 and
+ *          (root,v) otherwise. The edges with zero X are of the former kind,
+ *          and the star is strongly feasible.
+ *          If more than one edge on the cycle attains the minimum X at P3,
+ *          the last one encountered when the cycle is traversed along the
+ *          orientation of (ve1,ve2) starting from the merging node (apex)
+ *          is picked [Cunningham76]. This keeps the tree strongly feasible
+ *          after the pivot, and the degenerate pivots can not cycle.
+ *          The artificial root stays in the second phase, where the
+ *          artificial edges have zero cost and can not enter the basis.
+ *          The ones left in the basis have zero X and are oriented toward
+ *          the root. A cycle through the root therefore leaves the root
+ *          against one of them, and the pivot is degenerate. No flow goes
+ *          through the root.
+ *          At the optimum, each artificial basis edge but one is replaced
+ *          with the real edge of the minimum Z in its cut, shifting Y of one
+ *          side by that Z, which keeps all Z non-negative. Then the
+ *          artificial node is removed.
+ *          The other initializations break the ties at P3 by the
+ *          perturbation.
+ *
+ *        - Feasible tree initialization (FEASIBLE_TREE)
+ *          If the network is acyclic, or all the costs are non-negative,
+ *          the auxiliary problem can be skipped as in [GKNV93].
+ *          1. Find dual feasible Y (Z >= 0 for all the edges) in O(|V|+|E|).
+ *             For an acyclic network, Y is the shortest distance from a
+ *             virtual source connected to all the nodes with zero cost,
+ *             which is found in a topological order. Otherwise Y = 0.
+ *          2. Grow a tight spanning tree (Z = 0 on its edges) from a root
+ *             like Prim's algorithm. The edge with the minimum Z between the
+ *             tree and the rest is added, and the Y of the rest of the nodes
+ *             are shifted by its Z. The shift is kept as an offset and the
+ *             candidate edges are kept in two heaps, one for each direction,
+ *             so that this takes O(|E|log|E|).
+ *          3. Find X of the tree edges by the leaf elimination. The tree is
+ *             dual feasible but some X can be negative.
+ *          4. Dual simplex pivots until all X are non-negative.
+ *             A basis edge with negative X leaves. The entering edge is the
+ *             non-basis edge with the minimum Z in the cut made by the
+ *             leaving edge among those oriented in the opposite direction
+ *             to the leaving edge. If there is no such edge, the problem is
+ *             infeasible. X, Y, Z, and the spanning tree are updated in the
+ *             same way as P6-P9.
+ *             A pivot is degenerate if the entering edge has zero Z, and Y
+ *             does not change. After kMaxDegenerateDualPivots degenerate
+ *             pivots in a row, the leaving edge is the one with the
+ *             smallest perturbation among those with negative X until a
+ *             non-degenerate pivot. With the ties of the entering edge also
+ *             broken by the perturbation, this is Bland's rule for the dual
+ *             simplex, and the degenerate pivots can not cycle. A
+ *             non-degenerate pivot strictly increases the dual objective.
  */
 namespace Wailea {
 
@@ -269,6 +357,8 @@ class NetworkSimplexNode : public DiNode {
   friend class NetworkSimplex;
 
 #ifdef UNIT_TESTS
+  friend class NetworkSimplexTests;
+
   public:
     long mDebugId;
 #endif
@@ -344,18 +434,22 @@ class NetworkSimplexEdge : public DiEdge {
     list<edge_list_it_t>::iterator mNZEbackIt;
 
   friend class NetworkSimplex;
+#ifdef UNIT_TESTS
+  friend class NetworkSimplexTests;
+#endif
 
 };
 
 
 /** Following two are used by the spanning tree.
  */
-class NSSpanningTreeEdge : public Edge {};
-class NSSpanningTreeNode : public Node {
+class NSSpanningTreeEdge : public Edge, public PooledElement {};
+class NSSpanningTreeNode : public Node, public PooledElement {
 
   public:
 
-    inline NSSpanningTreeNode():mNsGeneration(0){;}
+    inline NSSpanningTreeNode():
+                     mNsGeneration(0),mSize(1),mCycleGeneration(0){;}
     inline virtual ~NSSpanningTreeNode(){;}
 
     /** @brief called if this node is to be explored by DFS for the first time
@@ -372,8 +466,8 @@ class NSSpanningTreeNode : public Node {
 
         for (mNextEdge = incidentEdges().first;
                             mNextEdge != incidentEdges().second; mNextEdge++) {
-            auto& E = dynamic_cast<NSSpanningTreeEdge&>(*(*(*mNextEdge)));
-            auto& A = dynamic_cast<NSSpanningTreeNode&>(E.adjacentNode(*this));
+            auto& E = downcast<NSSpanningTreeEdge>(*(*(*mNextEdge)));
+            auto& A = downcast<NSSpanningTreeNode>(E.adjacentNode(*this));
             if (A.mNsGeneration < mNsGeneration) {
                 break;
             }
@@ -396,14 +490,14 @@ class NSSpanningTreeNode : public Node {
         // call to nextChild().
         mNextEdge++;
         for ( ; mNextEdge != incidentEdges().second; mNextEdge++) {
-            auto& E = dynamic_cast<NSSpanningTreeEdge&>(*(*(*mNextEdge)));
-            auto& A = dynamic_cast<NSSpanningTreeNode&>(E.adjacentNode(*this));
+            auto& E = downcast<NSSpanningTreeEdge>(*(*(*mNextEdge)));
+            auto& A = downcast<NSSpanningTreeNode>(E.adjacentNode(*this));
             if (A.mNsGeneration < mNsGeneration) {
                 break;
             }
         }
 
-        return dynamic_cast<NSSpanningTreeEdge&>(*(*eit));
+        return downcast<NSSpanningTreeEdge>(*(*eit));
     }
 
 
@@ -427,23 +521,24 @@ class NSSpanningTreeNode : public Node {
      */
     node_list_it_t      mDfsParent;
 
-    /** @brief depth of this node in the current spanning tree.
-     */
-    long                mDepth;
-
     /** @brief the predecessor (parent) edge of this node in the current 
      *         spanning tree.
      */
     edge_list_it_t      mPrec;
 
-    /** @brief thread links of the nodes in the current spanning tree.
-     *         A thread is an ordered list of nodes according to the DFS
-     *         pre-traversal visiting ordering.
+    /** @brief number of the nodes in the subtree rooted at this node in
+     *         the current spanning tree.
      */
-    node_list_it_t      mThreadPrev;
-    node_list_it_t      mThreadNext;
+    long                mSize;
+
+    /** @brief used to find the apex of the cycle made by an entering edge.
+     */
+    long                mCycleGeneration;
 
   friend class NetworkSimplex;
+#ifdef UNIT_TESTS
+  friend class NetworkSimplexTests;
+#endif
 };
 
 
@@ -465,9 +560,99 @@ class NetworkSimplex {
      *                    There must be at least one positive supply node.
      *                    The edge costs must be non-zero.
      */
-    inline NetworkSimplex(DiGraph& G):mG(G),mNsGeneration(0){;}
+    inline NetworkSimplex(DiGraph& G):
+        mG(G),
+        mNsGeneration(0),
+        mPricing(FIRST_ELIGIBLE),
+        mBlockSize(0),
+        mInitialTree(AUXILIARY_PROBLEM),
+        mStronglyFeasible(false),
+        mArtificialEdgesFixed(false),
+        mDegenerateDualPivots(0),
+        mNumPivots(0),
+        mPricingCursor(mNegativeZEdges.end()),
+        mEdgeCursor(G.edges().second),
+        mSpanningTreeBuilt(false),
+        mBasisAvailable(false),
+        mSideIsSubtree(true),
+        mCycleGeneration(0),
+        mApexPos(0){;}
+
     inline virtual ~NetworkSimplex(){;}
 
+    /** @brief strategy to pick the entering edge among the non-basis
+     *         edges with negative Z at each pivot.
+     *
+     *   FIRST_ELIGIBLE: the oldest edge in the list of negative Z edges.
+     *
+     *   MOST_NEGATIVE:  Dantzig's rule. The edge with the most negative Z
+     *                   among all the negative Z edges.
+     *
+     *   BLOCK_SEARCH:   partial pricing. The edge with the most negative Z
+     *                   in the next block of the candidate list. The next
+     *                   search starts after the block.
+     *
+     *   CYCLIC:         the first edge with negative Z found by scanning
+     *                   the edges of the digraph cyclically from the one
+     *                   after the previous entering edge, as in [GKNV93].
+     */
+    enum pricingType {
+        FIRST_ELIGIBLE,
+        MOST_NEGATIVE,
+        BLOCK_SEARCH,
+        CYCLIC
+    };
+
+    /** @brief sets the pricing strategy used by solve().
+     *
+     *  @param  pricing   (in): pricing strategy
+     *
+     *  @param  blockSize (in): number of the candidates examined at each
+     *                          pivot for BLOCK_SEARCH. If it is 0, 
+     *                          sqrt(|E|) is used.
+     */
+    inline void setPricing(enum pricingType pricing, size_t blockSize = 0) {
+        mPricing   = pricing;
+        mBlockSize = blockSize;
+    }
+
+    /** @brief how solve() finds the initial basis.
+     *
+     *   AUXILIARY_PROBLEM: the two-phase method with the artificial node
+     *                      and edges. It works for any valid network.
+     *
+     *   FEASIBLE_TREE:     a tight spanning tree on dual feasible Y followed
+     *                      by the dual simplex pivots as in [GKNV93].
+     *                      It is used only if the network is acyclic or all
+     *                      the costs are non-negative, and also connected.
+     *                      Otherwise AUXILIARY_PROBLEM is used.
+     *                      It is suitable for the rank assignment problem.
+     *
+     *   STRONGLY_FEASIBLE_TREE: the two-phase method with an artificial
+     *                      root connected to all the nodes. The spanning
+     *                      tree is kept strongly feasible through the both
+     *                      phases, and the degenerate pivots can not cycle.
+     *                      It works for any valid network.
+     */
+    enum initialTreeType {
+        AUXILIARY_PROBLEM,
+        FEASIBLE_TREE,
+        STRONGLY_FEASIBLE_TREE
+    };
+
+    /** @brief sets how solve() finds the initial basis.
+     *
+     *  @param  initialTree (in): initialization method
+     */
+    inline void setInitialTree(enum initialTreeType initialTree) {
+        mInitialTree = initialTree;
+    }
+
+    /** @brief returns the number of pivots performed by the last solve()
+     *         including the ones for the auxiliary problem.
+     */
+    inline size_t numPivots() const { return mNumPivots; }
+
     /** @brief checks the validity of the input graph.
      *
      *  @return true : if the given digraph (network) is valid.
@@ -490,8 +675,126 @@ class NetworkSimplex {
      */
     bool solve();
 
+    /** @brief re-optimizes the problem starting from the optimum basis
+     *         found by the previous solve() or resolve().
+     *         It is intended for the cases where the problem is solved
+     *         repeatedly after small changes by NetworkSimplexNode::setB(),
+     *         NetworkSimplexEdge::setC(), and addition and removal of 
+     *         edges.
+     *         If the previous basis is still a spanning tree and it is 
+     *         primal feasible for the current supply/demand, the phase 2
+     *         is resumed from it. Otherwise, it falls back to solve().
+     *
+     *  @return true : the problem is feasible and an optimum has been found.
+     *          false: the problem is infeasible.
+     *
+     *  @remark if nodes have been added or removed, or a basis edge has
+     *          been removed, the basis can not be reused.
+     */
+    bool resolve();
+
   private:
 
+    /** @brief main part of solve() after the previous spanning tree has 
+     *         been released.
+     */
+    bool solveFromScratch();
+
+    /** @brief releases the spanning tree and the links to it from the
+     *         nodes and edges of mG made by the previous solve().
+     *         The basis flags of the edges are kept.
+     */
+    void releaseSpanningTree();
+
+    /** @brief constructs the spanning tree from the edges in mG marked as
+     *         basis and sets up its internal structure.
+     *
+     *  @return true if the basis edges form a spanning tree of mG.
+     */
+    bool rebuildSpanningTreeFromBasis();
+
+    /** @brief finds X of the basis edges from the supply/demand of the
+     *         nodes. The nodes are collected in the DFS pre-order of the
+     *         spanning tree by collectSpanningTreeNodes(), and visited in
+     *         the reverse order. X of the edge to the parent of each node
+     *         is set to the residual supply/demand of the node, which is
+     *         then carried to the parent. X of the non-basis edges are set
+     *         to zero.
+     *
+     *  @return true if X of all the basis edges are non-negative, i.e., the
+     *          basis is primal feasible.
+     */
+    bool findTreeX();
+
+    /** @brief finds dual feasible Y, i.e., Z >= 0 for all the edges, in
+     *         linear time without a basis.
+     *
+     *  @return true if such Y has been found, i.e., the network is acyclic
+     *          or all the costs are non-negative.
+     *
+     *  @remark the real costs must have been set by prepareZeroBGraph().
+     */
+    bool findDualFeasibleY();
+
+    /** @brief grows a spanning tree of the edges with Z = 0 from a root
+     *         shifting Y of the nodes not in the tree yet keeping Z >= 0.
+     *         The tree edges are marked as basis.
+     *
+     *  @return true if the spanning tree has been made. 
+     *          false if mG is not connected, in which case no edge is
+     *          marked as basis.
+     *
+     *  @remark Y must be dual feasible.
+     */
+    bool makeTightSpanningTree();
+
+    /** @brief solves the problem from the tight spanning tree made by
+     *         makeTightSpanningTree() with the dual simplex pivots and then
+     *         the primal ones.
+     *
+     *  @return true : the problem is feasible and an optimum has been found.
+     *          false: the problem is infeasible, or the basis edges do not
+     *                 form a spanning tree.
+     */
+    bool solveFromFeasibleTree();
+
+    /** @brief perform one dual simplex pivot.
+     *
+     *  @param  feasible (out): set to false if the problem turns out to be
+     *                          infeasible.
+     *
+     *  @return true : a pivot has been performed.
+     *          false: a pivot not performed as the current solution is primal
+     *                 feasible, or the problem is infeasible.
+     */
+    bool dualPivot(bool& feasible);
+
+    /** @brief finds a basis edge with negative X by scanning the edges of
+     *         mG cyclically from mEdgeCursor. After kMaxDegenerateDualPivots
+     *         degenerate pivots in a row, it finds the one with the
+     *         smallest perturbation instead.
+     *
+     *  @return the leaving edge, or nullptr if all X are non-negative.
+     */
+    NetworkSimplexEdge* findDualLeavingEdge();
+
+    /** @brief finds the non-basis edge with the minimum Z in the cut that
+     *         is oriented in the opposite direction to the leaving edge.
+     *
+     *  @param Eleave (in): leaving edge
+     *
+     *  @param cut    (in): cut made by the leaving edge
+     *
+     *  @return the entering edge, or nullptr if there is no such edge.
+     *
+     *  @remark it depends on mNsGeneration of NSSpaningTreeNodes set by
+     *          findSubtree().
+     */
+    NetworkSimplexEdge* findDualEnteringEdge(
+        NetworkSimplexEdge&     Eleave,
+        vector<edge_list_it_t>& cut
+    );
+
     /** @brief checks if all the supply/demand values are zero, in which case
      *         the X values in a solution are trivially zero.
      */
@@ -512,6 +815,10 @@ class NetworkSimplex {
 
     /** @brief make a solution if |E| = |V| -1, where there is only one
      *         trivial basis.
+     *         The flow conservation equations on the spanning tree are
+     *         solved in O(|V|) by eliminating the leaves in the reverse
+     *         DFS order, instead of a general simultaneous equations
+     *         solver.
      *  @return true if the solution is feasible.
      *          false if the solution is infeasible.
      */
@@ -537,8 +844,13 @@ class NetworkSimplex {
      *         artificial edge to one so that at an optimum of the auxiliary
      *         solution the basis edges's costs are all zero, i.e., they are
      *         non-artificial edges.
+     *
+     *  @param allNodes (in): if true, the artificial edges are made for
+     *                        all the nodes. The edge for a node with zero
+     *                        supply/demand is oriented toward the
+     *                        artificial node.
      */
-    void makeAuxGraph();
+    void makeAuxGraph(bool allNodes);
 
     /** @brief constructs the initial spanning tree for the auxiliary problem
      *         it includes all the artificial edges and possibly some
@@ -546,9 +858,16 @@ class NetworkSimplex {
      */
     void makeInitialAuxSpanningTree();
 
-    /** @brief it selects an arbitrary node of the spanning tree as it root,
-     *         orient the tree from it, and then sets the deptsh, predecessor,
-     *         and the thread (ordered node list in pre-traversal of DFS).
+    /** @brief constructs the initial strongly feasible spanning tree, which
+     *         consists of the artificial edges made by makeAuxGraph(true).
+     */
+    void makeInitialStronglyFeasibleSpanningTree();
+
+    /** @brief it selects a node of the spanning tree as it root, orient the
+     *         tree from it, and then sets the predecessor and the size of
+     *         the subtree.
+     *         The root is the artificial node if mStronglyFeasible is true,
+     *         and an arbitrary non-artificial node otherwise.
      */
     void createInitialInternalStructureForSpanningTree();
 
@@ -575,15 +894,33 @@ class NetworkSimplex {
      */
     bool pivot();
 
+    /** @brief picks the entering edge from mNegativeZEdges according to
+     *         mPricing.
+     *
+     *  @return the entering edge
+     *
+     *  @remark mNegativeZEdges must not be empty.
+     */
+    NetworkSimplexEdge& findEnteringEdge();
+
+    /** @brief removes the edge from mNegativeZEdges keeping mPricingCursor
+     *         valid.
+     */
+    void eraseNegativeZEdge(NetworkSimplexEdge& Eg);
+
     /** @brief finds (ve2,ve1)-path where (ve1, ve2) is the entering edge.
      *
-     *  @param Eg  (in): entering edge
+     *  @param Eg    (in):  entering edge
+     *
+     *  @param cycle (out): list of edges on (ve2,ve1)-path in this ordering.
      *
-     *  @return list of edges on (ve2,ve1)-path in this ordering.
+     *  @remark it sets mApexPos.
      */
-    vector<edge_list_it_t> findCycle(NetworkSimplexEdge& Eg);
+    void findCycle(NetworkSimplexEdge& Eg, vector<edge_list_it_t>& cycle);
 
     /** @brief finds the leaving edge in the (ve2,ve1)-path.
+     *         Ties are broken by Cunningham's rule if mStronglyFeasible is
+     *         true, and by the perturbation otherwise.
      *
      *  @param Eg (in):    enteirng edge
      *
@@ -598,8 +935,8 @@ class NetworkSimplex {
 
 
     /** @brief utility routine to find the deeper of two incident nodes 
-     *         of an edge. Such a node is used to find the subtree root
-     *         of STnr.
+     *         of a basis edge, i.e., the one whose parent edge it is.
+     *         Such a node is used to find the subtree root of STnr.
      *
      *  @param Eleave  (in): edge
      *
@@ -607,6 +944,44 @@ class NetworkSimplex {
      */
     NSSpanningTreeNode& deeperSpanningTreeNode(NetworkSimplexEdge& Eleave);
 
+    /** @brief returns the parent of the node in the spanning tree.
+     *
+     *  @remark Nst must not be the root.
+     */
+    inline NSSpanningTreeNode& parentSpanningTreeNode(
+                                                    NSSpanningTreeNode& Nst) {
+        auto& Est = downcast<NSSpanningTreeEdge>(*(*(Nst.mPrec)));
+        return downcast<NSSpanningTreeNode>(Est.adjacentNode(Nst));
+    }
+
+    /** @brief finds the closest common ancestor of two nodes in the
+     *         spanning tree in time proportional to the length of the
+     *         path between them.
+     *
+     *  @remark it updates mCycleGeneration of NSSpanningTreeNodes.
+     */
+    NSSpanningTreeNode& findApex(
+        NSSpanningTreeNode& N1st,
+        NSSpanningTreeNode& N2st
+    );
+
+    /** @brief collects the nodes reachable from a node on the spanning
+     *         tree without crossing the given edge by DFS in pre-order.
+     *         The nodes are marked with mNsGeneration.
+     *
+     *  @param Sst     (in):  start node
+     *
+     *  @param blocked (in):  tree edge not to be crossed, or the end of
+     *                        the edges of mSpanningTree.
+     *
+     *  @param nodes   (out): nodes in mG appended in DFS pre-order.
+     */
+    void collectSpanningTreeNodes(
+        NSSpanningTreeNode&     Sst,
+        edge_list_it_t          blocked,
+        vector<node_list_it_t>& nodes
+    );
+
 
     /** @brief utility to find the root side of the incident node of 
      *         the entering edge.
@@ -620,35 +995,48 @@ class NetworkSimplex {
     NSSpanningTreeNode& nonRootSideOfEnter(NetworkSimplexEdge& Eg);
 
 
-    /** @brief finds STnr as in the list of nodes.   
-     *
-     *  @param Eleave            (in):  leaving edge
+    /** @brief finds STnr, and the smaller of STnr and ST\STnr as in the
+     *         list of nodes.
      *
-     *  @param subtreeThreadPrev (out): the previous link in the thread of STnr
-     *                                  STnr.
+     *  @param Eleave    (in):  leaving edge
      *
-     *  @param subtreeThreadPrev (out): the next link in the thread of STnr
+     *  @param sideNodes (out): list of nodes in STnr if mSideIsSubtree is
+     *                          set. Otherwise list of nodes in ST\STnr.
      *
-     *  @return list of nodes in STnr.
-     *
-     *  @remark it brings mNsGeneration of NSSpaningTreeNodes in STnr 
-     *          up-to-date.
+     *  @remark it marks the nodes on the smaller side with mNsGeneration
+     *          and sets mSideIsSubtree. It visits only the nodes on the
+     *          smaller side.
      */
-    vector<node_list_it_t> findSubtree(NetworkSimplexEdge& Eleave);
+    void findSubtree(
+        NetworkSimplexEdge&     Eleave,
+        vector<node_list_it_t>& sideNodes
+    );
+
+    /** @brief returns true if the node is in STnr found by the last call
+     *         to findSubtree().
+     */
+    inline bool isInSubtree(NSSpanningTreeNode& Nst) const {
+        return (Nst.mNsGeneration == mNsGeneration) == mSideIsSubtree;
+    }
 
     /** @brief finds the cut set between STnr and ST\STnr.
      *
-     *  @param subtreeNodes (in): nodes in STnr.
+     *  @param sideNodes (in):  nodes found by findSubtree().
      *
-     *  @return list of edges in the cut
+     *  @param cut       (out): list of edges in the cut
      *
-     *  @remark it depends on mNsGeneration of NSSpaningTreeNodes
-     *          to identify the nodes in STnr in O(1).
+     *  @remark it depends on mNsGeneration of NSSpaningTreeNodes set by
+     *          findSubtree() to identify the nodes in STnr in O(1).
      */
-    vector<edge_list_it_t> findCutSet(vector<node_list_it_t>& subtreeNodes);
+    void findCutSet(
+        vector<node_list_it_t>& sideNodes,
+        vector<edge_list_it_t>& cut
+    );
 
     /** @brief updates the X values of the edges on (ve2,ve1)-path and
      *         (ve1,ve2).
+     *         The amount pushed around the cycle is |x| of the leaving edge,
+     *         which is negative for the dual simplex pivots.
      *
      *  @param cycle  (in): (ve2,ve1)-path
      *
@@ -662,14 +1050,19 @@ class NetworkSimplex {
         NetworkSimplexEdge&     Eleave
     );
 
-    /** @brief updates the Y values of the nodes in STnr.
+    /** @brief updates the Y values of the nodes in STnr, or the ones in
+     *         ST\STnr in the opposite direction.
      *
-     *  @param subtreeNodes: (in) nodes in STnr.
+     *  @param sideNodes: (in) nodes found by findSubtree().
      *
-     *  @param Eenter:       (in) entering edge
+     *  @param Eenter:    (in) entering edge
      */
     void updateY(
-             vector<node_list_it_t>& subtreeNodes, NetworkSimplexEdge& Eenter);
+             vector<node_list_it_t>& sideNodes, NetworkSimplexEdge& Eenter);
+
+    /** @brief shifts Y of all the nodes so that Y of the root is zero.
+     */
+    void anchorY();
 
     /** @brief updates the Z values of the edges in the cut.
      *
@@ -678,7 +1071,8 @@ class NetworkSimplex {
     void updateZ(vector<edge_list_it_t>& cut);
 
     /** @brief updates the spanning tree by removing the leaving edge and
-     *         adding the entering one.
+     *         adding the entering one. mPrec and mSize are updated only
+     *         on the cycle.
      *
      *  @param Eenter (in): entering edge   
      *
@@ -689,6 +1083,37 @@ class NetworkSimplex {
         NetworkSimplexEdge& Eleave
     );
 
+    /** @brief at an optimum of the auxiliary problem, replaces the 
+     *         artificial edges in the basis except one with non-artificial
+     *         edges by degenerate pivots so that the basis remains a
+     *         spanning tree after the artificial node is removed.
+     *
+     *  @param keepZ (in): if true, the non-artificial edge with the minimum
+     *                     Z in the cut enters, and Y of one side is shifted
+     *                     so that Z of the non-artificial edges stay
+     *                     non-negative. Otherwise any non-artificial edge
+     *                     in the cut enters, and Y is left as it is.
+     *
+     *  @remark all the artificial edges in the basis must have zero X.
+     */
+    void replaceDegenerateArtificialBasisEdges(bool keepZ);
+
+    /** @brief solves the problem with the two-phase method keeping the
+     *         spanning tree strongly feasible.
+     *
+     *  @return true : the problem is feasible and an optimum has been found.
+     *          false: the problem is infeasible.
+     */
+    bool solveFromStronglyFeasibleTree();
+
+    /** @brief checks if the non-basis edge can enter the basis.
+     *         The artificial edges can not once mArtificialEdgesFixed has
+     *         been set.
+     */
+    inline bool isEnteringCandidate(NetworkSimplexEdge& Eg) const {
+        return !Eg.mArtificial || !mArtificialEdgesFixed;
+    }
+
     /** @brief restores the original problem by removing the artificial node
      *         and the edges, restoring the real cost values for the edges.
      */
@@ -717,11 +1142,88 @@ class NetworkSimplex {
     /** @brief the spanning tree */
     Graph                  mSpanningTree;
 
+    /** @brief pricing strategy to pick the entering edge */
+    enum pricingType       mPricing;
+
+    /** @brief number of candidates examined per pivot for BLOCK_SEARCH */
+    size_t                 mBlockSize;
+
+    /** @brief initialization method of solve() */
+    enum initialTreeType   mInitialTree;
+
+    /** @brief true while the spanning tree is kept strongly feasible with
+     *         the artificial node as the root.
+     */
+    bool                   mStronglyFeasible;
+
+    /** @brief true if the artificial edges can not enter the basis, i.e.,
+     *         in the second phase of STRONGLY_FEASIBLE_TREE.
+     */
+    bool                   mArtificialEdgesFixed;
+
+    /** @brief number of the degenerate dual pivots in a row */
+    size_t                 mDegenerateDualPivots;
+
+    /** @brief number of the degenerate dual pivots in a row after which
+     *         the leaving edge is picked by Bland's rule.
+     */
+    static const size_t    kMaxDegenerateDualPivots = 10;
+
+    /** @brief number of pivots performed */
+    size_t                 mNumPivots;
+
+    /** @brief position in mNegativeZEdges at which the next search starts
+     *         for BLOCK_SEARCH.
+     */
+    list<edge_list_it_t>::iterator mPricingCursor;
+
+    /** @brief position in the edges of mG at which the next search starts
+     *         for CYCLIC.
+     */
+    edge_list_it_t         mEdgeCursor;
+
+    /** @brief true if mSpanningTree and the links to it have been made. */
+    bool                   mSpanningTreeBuilt;
+
+    /** @brief true if the basis flags of the edges hold an optimum basis
+     *         of the previous solve() or resolve().
+     */
+    bool                   mBasisAvailable;
+
+    /** @brief scratch buffers reused by the pivots for the cycle, the nodes
+     *         on the smaller side of the cut, and the cut.
+     *         mCycleHalf holds (ve1,apex) part of the cycle temporarily.
+     */
+    vector<edge_list_it_t> mCycle;
+    vector<edge_list_it_t> mCycleHalf;
+    vector<node_list_it_t> mSideNodes;
+    vector<edge_list_it_t> mCut;
+
+    /** @brief true if the nodes found by the last findSubtree() are in STnr.
+     *         false if they are in ST\STnr.
+     */
+    bool                   mSideIsSubtree;
+
+    /** @brief generation value for mCycleGeneration of the nodes. */
+    long                   mCycleGeneration;
+
+    /** @brief position of the apex in the cycle found by the last
+     *         findCycle(), i.e., the number of the edges in (ve2,apex) part.
+     */
+    size_t                 mApexPos;
+
+    /** @brief DFS stack used by collectSpanningTreeNodes(). Each entry
+     *         is a node in mSpanningTree and the edge it was reached by.
+     */
+    vector<pair<node_list_it_t, edge_list_it_t> > mDfsStack;
+
 
 #ifdef UNIT_TESTS
     void printDebug();
     void printDebugNode(NetworkSimplexNode& Ng);
     void printDebugEdge(NetworkSimplexEdge& Eg);
+
+  friend class NetworkSimplexTests;
 #endif
 };
 
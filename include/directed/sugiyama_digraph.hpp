@@ -17,11 +17,24 @@ using namespace std;
 class SugiyamaDiNode : public DiNode {
 
   public:
-      inline SugiyamaDiNode():mVirtual(false),mRank(0),mPos(0){;}
+      inline SugiyamaDiNode():
+                        mVirtual(false),mRank(0),mPos(0),mWidth(0.0),mX(0.0){;}
       inline virtual ~SugiyamaDiNode(){;}
       inline bool isVirtual() const  {return mVirtual;}
       inline long rank() const {return mRank;}
       inline long pos() const {return mPos;}
+
+      /** @brief sets the horizontal extent of the node used by
+       *         BKCoordinateAssigner. The virtual nodes have 0.0 by default.
+       */
+      inline void   setWidth(double w) {mWidth = w;}
+      inline double width() const {return mWidth;}
+
+      /** @brief x-coordinate of the center of the node found by
+       *         BKCoordinateAssigner.
+       */
+      inline double x() const {return mX;}
+
   private:
 
     /** @brief true if this is introduced to make 
@@ -38,7 +51,16 @@ class SugiyamaDiNode : public DiNode {
      */
     long            mPos;
 
+    /** @brief horizontal extent of the node
+     */
+    double          mWidth;
+
+    /** @brief x-coordinate of the center of the node
+     */
+    double          mX;
+
 friend class SugiyamaDiGraph;
+friend class BKCoordinateAssigner;
 
 #ifdef UNIT_TESTS
 friend class SugiyamaDiGraphTests;
@@ -7,6 +7,8 @@
 #include <vector>
 #include <exception>
 
+#include "undirected/element_pool.hpp"
+
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
 #endif
@@ -97,11 +99,14 @@ class Node;
 
 using generation_t        = unsigned long long;
 using utility_t           = unsigned long long;
-using node_list_t         = list<unique_ptr<Node>>;
+using node_list_t         = list<unique_ptr<Node>,
+                                 PoolAllocator<unique_ptr<Node>>>;
 using node_list_it_t      = node_list_t::iterator;
-using edge_list_t         = list<unique_ptr<Edge>>;
+using edge_list_t         = list<unique_ptr<Edge>,
+                                 PoolAllocator<unique_ptr<Edge>>>;
 using edge_list_it_t      = edge_list_t::iterator;
-using node_incidence_t    = list<edge_list_it_t>;
+using node_incidence_t    = list<edge_list_it_t,
+                                 PoolAllocator<edge_list_it_t>>;
 using node_incidence_it_t = node_incidence_t::iterator;
 using node_ptr_t          = unique_ptr<Node>;
 using edge_ptr_t          = unique_ptr<Edge>;
@@ -130,6 +135,31 @@ class Constants {
 };
 
 
+/** @brief downcasts a reference to a graph, node, or edge to its subclass.
+ *
+ *  @details The algorithms access the elements of their graphs through the
+ *           references to the base classes held in the lists, while the
+ *           actual types are known as they have created the elements, or
+ *           as they are specified in the preconditions.
+ *           In the checked builds (UNIT_TESTS or WAILEA_CHECKED_DOWNCAST
+ *           defined) this is dynamic_cast, and std::bad_cast is thrown if
+ *           the actual type is not T.
+ *           Otherwise this is static_cast without the RTTI lookup, and the
+ *           behavior is undefined if the actual type is not T.
+ *
+ *  @remark  Use dynamic_cast where the actual type is not known in advance.
+ */
+template<class T, class B>
+inline T& downcast(B& b)
+{
+#if defined(UNIT_TESTS) || defined(WAILEA_CHECKED_DOWNCAST)
+    return dynamic_cast<T&>(b);
+#else
+    return static_cast<T&>(b);
+#endif
+}
+
+
 /** @class  Node
  *  @brief  This class represents the basic undirected node concept.
  */
@@ -1439,11 +1469,11 @@ private:
 
     /**  @brief the list of the nodes in the graph with their ownerships.
      */
-    list<node_ptr_t> mNodes;
+    node_list_t mNodes;
 
     /**  @brief the list of the edges in the graph with their ownerships.
      */
-    list<edge_ptr_t> mEdges;
+    edge_list_t mEdges;
 
     /** @brief internal general purpose counter.
      *         an example usage is to identify the edge induced nodes.
@@ -1607,7 +1637,8 @@ inline void Node::reorderIncidence(std::list<edge_list_it_t>&& reorderedEdges)
         throw std::invalid_argument(Constants::kExceptionNodeNotInGraph);
     }
 
-    mIncidence = std::move(reorderedEdges);
+    // The cells of mIncidence are reused as they are from ElementPool.
+    mIncidence.assign(reorderedEdges.begin(), reorderedEdges.end());
 
     for (auto mit = mIncidence.begin(); mit != mIncidence.end(); mit++) {
 
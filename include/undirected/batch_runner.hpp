@@ -0,0 +1,181 @@
+#ifndef _WAILEA_UNDIRECTED_BATCH_RUNNER_HPP_
+#define _WAILEA_UNDIRECTED_BATCH_RUNNER_HPP_
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <functional>
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+/**
+ * @file undirected/batch_runner.hpp
+ *
+ * @brief processes a stream of graph specifications on a pool of threads,
+ *        and writes the results in the input order.
+ *
+ * @details
+ *    The command-line tools read one specification from a file and write
+ *    one result to another file. To lay out a large number of small
+ *    graphs, the process start-up and the file round-trips dominate.
+ *    With the batch mode, the tools read the specifications from one
+ *    stream and write the results to another.
+ *
+ *    Stream format
+ *
+ *      [Specification 1]
+ *      GRAPH_END
+ *      [Specification 2]
+ *      GRAPH_END
+ *      ...
+ *
+ *    Each specification is in the same format as the input file of the
+ *    tool. The terminator of the last one can be omitted. The output
+ *    has the same structure, and the i-th result corresponds to the i-th
+ *    specification. If the processing of a specification fails, its
+ *    result consists of a comment line '# ERROR: [message]' and the
+ *    processing continues with the next one.
+ *
+ *    Each worker thread takes the next specification from the input under
+ *    a lock, processes it without a lock, and then appends the result to
+ *    the completed ones. The results are written out as soon as all the
+ *    preceding ones have been written. The number of the specifications
+ *    read but not yet written is bounded by maxInFlight so that the memory
+ *    stays bounded for an arbitrarily long stream.
+ *
+ *  @remark
+ *    The processor is called concurrently from multiple threads, and it
+ *    must not share mutable state across calls.
+ */
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+/** @class BatchRunner
+ *
+ *  @brief runs a processor for each graph specification in a stream.
+ */
+class BatchRunner {
+
+  public:
+
+    /** @brief processes one specification.
+     *
+     *  @param  is   (in):  specification
+     *
+     *  @param  os   (out): result
+     *
+     *  @param  name (in):  name of the specification used in the error
+     *                      messages. E.g., '<stdin>:3'.
+     */
+    using processor_t =
+                     function<void(istream& is, ostream& os, const char* name)>;
+
+    /** @brief line that terminates each specification and each result.
+     */
+    static const string GRAPH_END;
+
+    /** @brief default maximum number of the specifications read and not
+     *         yet written, per thread.
+     */
+    static constexpr size_t kDefaultInFlightPerThread = 4;
+
+    /** @brief constructor
+     *
+     *  @param  processor (in): processor called for each specification.
+     */
+    inline BatchRunner(processor_t processor):
+        mProcessor(processor),
+        mNumThreads(0),
+        mMaxInFlight(0){;}
+
+    inline virtual ~BatchRunner(){;}
+
+    /** @brief sets the number of the worker threads.
+     *
+     *  @param  numThreads  (in): 0 means the number of the hardware threads.
+     */
+    inline void setNumThreads(size_t numThreads) { mNumThreads = numThreads; }
+
+    /** @brief sets the maximum number of the specifications read and not
+     *         yet written.
+     *
+     *  @param  maxInFlight (in): 0 means kDefaultInFlightPerThread times the
+     *                            number of the threads.
+     */
+    inline void setMaxInFlight(size_t maxInFlight) {
+        mMaxInFlight = maxInFlight;
+    }
+
+    /** @brief processes all the specifications in the input stream.
+     *
+     *  @param  is         (in):  input stream
+     *
+     *  @param  os         (out): output stream
+     *
+     *  @param  streamName (in):  name of the input stream used in the error
+     *                            messages.
+     *
+     *  @return number of the specifications that failed.
+     */
+    size_t run(istream& is, ostream& os, const string& streamName);
+
+    /** @brief entry point for the batch mode of the command-line tools.
+     *         It parses the arguments after '-b', which are
+     *         '[-j num_threads] [input_file]', and processes the input file
+     *         or stdin if not given, to stdout.
+     *
+     *  @param  argc      (in): argc of main() after '-b'.
+     *
+     *  @param  argv      (in): argv of main() after '-b'.
+     *
+     *  @param  processor (in): processor of the tool.
+     *
+     *  @return exit status: 0 if all succeeded, 1 on a usage error, and 2
+     *          if some specifications failed.
+     */
+    static int runFromCommandLine(
+        int         argc,
+        char*       argv[],
+        processor_t processor
+    );
+
+    /** @brief prints the usage of the batch mode.
+     *
+     *  @param  os       (out): output stream
+     *
+     *  @param  toolName (in):  name of the tool
+     */
+    static void printUsage(ostream& os, const char* toolName);
+
+  private:
+
+    /** @brief reads the next specification up to GRAPH_END.
+     *
+     *  @param  is   (in):  input stream
+     *
+     *  @param  spec (out): specification without the terminator
+     *
+     *  @return false if there is no more specification.
+     */
+    static bool readSpec(istream& is, string& spec);
+
+    processor_t mProcessor;
+    size_t      mNumThreads;
+    size_t      mMaxInFlight;
+
+#ifdef UNIT_TESTS
+friend class BatchRunnerTests;
+#endif
+};
+
+
+}// namespace Undirected
+
+}// namespace Wailea
+
+#endif /*_WAILEA_UNDIRECTED_BATCH_RUNNER_HPP_*/
@@ -8,6 +8,7 @@
 #include <exception>
 
 #include "undirected/base.hpp"
+#include "undirected/element_pool.hpp"
 #include "undirected/dfs.hpp"
 
 #ifdef UNIT_TESTS
@@ -71,7 +72,7 @@
  *               defines->BCDFSNode
  *               defines->BCDFSEdge
  *         
- *               owns->DFSExplorer<Graph,BCDFSNode,BCDFSEdge>
+ *               owns->StaticDFSExplorer<Graph,BCDFSNode,BCDFSEdge>
  *                       explores->DFSGraph<Graph,BCDFSNode,BCDFSEdge>
  *                                     owns->DFSNode<Graph,BCDFSNode,BCDFSEdge>
  *                                     owns->DFSEdge<Graph,BCDFSNode,BCDFSEdge>
@@ -622,7 +623,7 @@ class BiconnectedDecomposer {
      *         This class is augumented to DFSNode<Graph,BCDFSNode,BCDFSEdge>
      *         for DFSExplorer<Graph,BCDFSNode,BCDFSEdge>.
      */
-    class BCDFSNode : public Node {
+    class BCDFSNode : public Node, public PooledElement {
  
       public:
         inline BCDFSNode():mNum(0),mLowPt(0),mCutVertex(false){;}
@@ -641,7 +642,7 @@ class BiconnectedDecomposer {
     };
 
 
-    class BCDFSEdge : public Edge {
+    class BCDFSEdge : public Edge, public PooledElement {
 
       public:
         inline BCDFSEdge(){;}
@@ -795,27 +796,27 @@ inline BCTreeEdge::BCTreeEdge(bool cutVertexOnNode1) noexcept:
 inline BCTreeNode& BCTreeEdge::blockNode() noexcept
 {
     if (mCutVertexOnNode1) {
-        return dynamic_cast<BCTreeNode&>(incidentNode2());
+        return downcast<BCTreeNode>(incidentNode2());
     }
     else {
-        return dynamic_cast<BCTreeNode&>(incidentNode1());
+        return downcast<BCTreeNode>(incidentNode1());
     }
 };
 
 inline BCTreeNode& BCTreeEdge::cutVertexNode() noexcept
 {
     if (mCutVertexOnNode1) {
-        return dynamic_cast<BCTreeNode&>(incidentNode1());
+        return downcast<BCTreeNode>(incidentNode1());
     }
     else {
-        return dynamic_cast<BCTreeNode&>(incidentNode2());
+        return downcast<BCTreeNode>(incidentNode2());
     }
 };
 
 
 inline BlockNode& BCTreeEdge::cutVertexInBlock() noexcept 
 {
-    return dynamic_cast<BlockNode&>(*(*mCutVertexInBlock));
+    return downcast<BlockNode>(*(*mCutVertexInBlock));
 };
 
 
@@ -853,7 +854,7 @@ inline void Block::setBackTreeNode(node_list_it_t it) noexcept
 
 inline BCTreeNode& Block::BCTreeNode() noexcept
 {
-    return dynamic_cast<class BCTreeNode&>(*(*mBCTreeNode));
+    return downcast<class BCTreeNode>(*(*mBCTreeNode));
 }
 
 
@@ -875,7 +876,7 @@ inline void BlockNode::setBCTreeEdge(edge_list_it_t it) noexcept
 
 inline BCTreeEdge& BlockNode::treeEdge() noexcept
 {
-    return dynamic_cast<BCTreeEdge&>(*(*mBCEdge));
+    return downcast<BCTreeEdge>(*(*mBCEdge));
 }
 
 
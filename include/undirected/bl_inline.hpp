@@ -16,14 +16,23 @@ using namespace std;
 
 
 inline BLTreeNode::BLTreeNode(BLTree& t) noexcept :mTree(t)
+{
+    reinitialize();
+}
+
+
+/** @brief brings this node to the state right after the construction.
+ *         Used when the node is taken from the free list of BLTree.
+ */
+inline void BLTreeNode::reinitialize() noexcept
 {
 
     mNodeType                      = TypeUnknown;
-    mEndChild1                     = t.nil();
-    mEndChild2                     = t.nil();
-    mSibling1                      = t.nil();
-    mSibling2                      = t.nil();
-    mParent                        = t.nil();
+    mEndChild1                     = mTree.nil();
+    mEndChild2                     = mTree.nil();
+    mSibling1                      = mTree.nil();
+    mSibling2                      = mTree.nil();
+    mParent                        = mTree.nil();
     mGeneration                    = 0;
     mBlocked                       = false;
     mUnblocked                     = false;
@@ -31,14 +40,28 @@ inline BLTreeNode::BLTreeNode(BLTree& t) noexcept :mTree(t)
     mPertinentChildrenCountProcessed = 0;
     mPertinentLeavesCount          = 0;
     mPertinentType                 = PertinentUnknown;
-    mSinglyPartialChild1           = t.nil();
-    mSinglyPartialChild2           = t.nil();
-    mCDPartialChild                = t.nil();
+    mSinglyPartialChild1           = mTree.nil();
+    mSinglyPartialChild2           = mTree.nil();
+    mCDPartialChild                = mTree.nil();
 
     mFullChildrenSet               = false;
 
     mChildrenCount                 = 0;
 
+    // The lists of a recycled node may still have the elements.
+    mChildren.clear();
+    mFullChildren.clear();
+    mOrientInNorm.clear();
+    mOrientInReversed.clear();
+    mOrientOutNorm.clear();
+    mOrientOutReversed.clear();
+    mAssumedOrientInNorm.clear();
+    mAssumedOrientInReversed.clear();
+    mAssumedOrientOutNorm.clear();
+    mAssumedOrientOutReversed.clear();
+    mCollectedEdges.clear();
+    mCollectedEdgesSide2.clear();
+
 #ifdef UNIT_TESTS
     mNodeNum                       = ++nodeNumMaster;
 #endif
@@ -299,7 +322,7 @@ inline void BLTreeNode::addTwoInitialChildrenToQType(
     mEndChild1              = fIt;
     mEndChild2              = eIt;
 
-    F.createFullLink(dynamic_cast<BLTreeNode&>(*this));
+    F.createFullLink(downcast<BLTreeNode>(*this));
 
     mPertinentChildrenCount = 1;
     mPertinentLeavesCount   = F.mPertinentLeavesCount;
@@ -717,6 +740,22 @@ inline BLTree::BLTree():
 inline BLTree::~BLTree(){;}
 
 
+inline void BLTree::clear()
+{
+    while (numNodes() > 0) {
+        releaseNode(toNodeRef(nodes().first));
+    }
+    mTrackQFlippings = false;
+    mCollectingEdges = false;
+}
+
+
+inline size_t BLTree::numFreeNodes() const
+{
+    return mFreeNodes.size();
+}
+
+
 inline node_list_it_t BLTree::nil()
 {
     return nodes().second;
@@ -737,7 +776,7 @@ inline bool BLTree::isTrackingQFlippings()
 
 inline BLTreeNode& BLTree::toNodeRef(node_list_it_t nIt)
 {
-    return dynamic_cast<BLTreeNode&>(*(*nIt));
+    return downcast<BLTreeNode>(*(*nIt));
 }
 
 
@@ -747,10 +786,27 @@ inline bool BLTree::isNil(node_list_it_t nIt)
 }
 
 
+inline node_list_it_t BLTree::newNode()
+{
+    if (mFreeNodes.empty()) {
+        return addNode(make_unique<BLTreeNode>(*this)).backIt();
+    }
+    auto np = std::move(mFreeNodes.back());
+    mFreeNodes.pop_back();
+    downcast<BLTreeNode>(*np).reinitialize();
+    return addNode(std::move(np)).backIt();
+}
+
+
+inline void BLTree::releaseNode(BLTreeNode& N)
+{
+    mFreeNodes.push_back(removeNode(N));
+}
+
+
 inline node_list_it_t BLTree::makePAttachment()
 {
-    auto  np    = make_unique<BLTreeNode>(*this);
-    auto  nIt   = addNode(std::move(np)).backIt();
+    auto  nIt   = newNode();
     auto& N     = toNodeRef(nIt);
     N.mNodeType = BLTreeNode::PType;
     return nIt;
@@ -829,7 +885,7 @@ inline void BLTree::removeVirtualRoot(node_list_it_t vIt)
 {
     auto& V = toNodeRef(vIt);
     V.clearFullChildren();
-    removeNode(V);
+    releaseNode(V);
 }
 
 
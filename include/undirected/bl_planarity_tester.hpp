@@ -2,6 +2,7 @@
 #define _WAILEA_UNDIRECTED_BL_PLANARITY_TESTER_HPP_
 
 #include "undirected/base.hpp"
+#include "undirected/element_pool.hpp"
 
 /**
  * @file undirected/bl_planarity_tester.hpp
@@ -22,6 +23,14 @@
  *
  * @remark on the complexity
  *    The planarity test runs in O(|N|+|E|) as in [BL76].
+ *
+ * @remark on reuse
+ *    A BLPlanarityTester object can be used for any number of calls.
+ *    The PQ-tree and the working vectors are kept in the object between
+ *    the calls, and the PQ-tree nodes are taken from the free list of the
+ *    previous calls. It is more efficient to reuse one object for
+ *    a series of tests than to make a new one per test.
+ *    An object must not be used by two threads at the same time.
  * 
  *   dependency: undirected/base.{hpp,cpp}
  *
@@ -109,7 +118,7 @@ class BLGraph : public Graph {
  * @brief the input graph edges are augumented to this class internally
  *        to be processed by BLPlanarityTester.
  */
-class BLGraphEdge : public Edge {
+class BLGraphEdge : public Edge, public PooledElement {
 
   public:
 
@@ -125,7 +134,7 @@ class BLGraphEdge : public Edge {
  * @brief the input graph nodes are augumented to this class internally
  *        to be processed by BLPlanarityTester.
  */
-class BLGraphNode : public Node {
+class BLGraphNode : public Node, public PooledElement {
 
   public:
 
@@ -181,6 +190,13 @@ class BLPlanarityTester {
 
   public:
 
+    BLPlanarityTester();
+
+    virtual ~BLPlanarityTester();
+
+    BLPlanarityTester(const BLPlanarityTester& rhs) = delete;
+    BLPlanarityTester& operator=(const BLPlanarityTester& rhs) = delete;
+
     /** @brief tests if the given graph is planar or not
      *
      *  @param G              (in):  simple connected graph to be planarized
@@ -194,9 +210,9 @@ class BLPlanarityTester {
      *           if there is a memory shortage during a call.
      *
      *  @remark on exception safety
-     *           If an exception is thrown, all the data structures internally
-     *           allocated during a call will be freed, and the input graph
-     *           G, and the list stOrder will be unchanged.
+     *           If an exception is thrown, the input graph G and the list
+     *           stOrder will be unchanged. The object can still be used
+     *           for the next call.
      *
      *  @remark on undefined behavior
      *           If G or G + {s,t} is not simple biconnected, 
@@ -239,9 +255,8 @@ class BLPlanarityTester {
      *           if there is a memory shortage during a call.
      *
      *  @remark on exception safety
-     *           If an exception is thrown, all the data structures internally
-     *           allocated during a call will be freed, and the input graph
-     *           G, and the list stOrder will be unchanged, except that
+     *           If an exception is thrown, the input graph G, and the list
+     *           stOrder will be unchanged, except that
      *           the incident edges list of some nodes in G may have been
      *           rearranged, but their integrity is kept.
      *
@@ -302,6 +317,25 @@ class BLPlanarityTester {
     );
 
 
+    /** @brief   same as above but stores the leaves to the given vector.
+     *
+     *  @param   edgeList        (in): graph edges in BLGraphEdge 
+     *                                 of the copied graph.
+     *
+     *  @param   leaves         (out): corresponding PQ-tree nodes of L type.
+     */
+    void fromGraphEdgesToPQLeaves(
+        list<edge_list_it_t>&   edgeList,
+        vector<node_list_it_t>& leaves
+    );
+
+
+    /** @brief   returns the PQ-tree kept in this object after clearing it.
+     *           The tree is created at the first call.
+     */
+    BLTree& resetPQTree();
+
+
     /** @brief peforms BubbleUp() in [BL76]. It find a superset of the
      *         pertinent tree.
      *         After a call, following holds for the pertinent nodes.
@@ -727,6 +761,18 @@ class BLPlanarityTester {
     list<node_list_it_t>           mOrientOutNorm;
     list<node_list_it_t>           mOrientOutReversed;
 
+    /** @brief PQ-tree reused across the calls.
+     */
+    unique_ptr<BLTree>             mPQTree;
+
+    /** @brief working vectors reused across the calls.
+     *         Their capacities are retained.
+     */
+    vector<node_list_it_t>         mStOrderCopy;
+    vector<node_list_it_t>         mPertinentLeaves;
+    vector<pair<node_list_it_t,node_ptr_t>> mNodePairs;
+    vector<pair<edge_list_it_t,edge_ptr_t>> mEdgePairs;
+
 
 #ifdef UNIT_TESTS
   friend class BLPlanarityTesterTests;
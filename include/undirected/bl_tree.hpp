@@ -7,7 +7,12 @@
  * @file undirected/bl_tree.hpp
  *
  * @brief an implementation of O(|N| + |E|) PQ-tree used by BLPlanarityTester.
- *       
+ *
+ * @remark on memory
+ *    The tree nodes removed during the reductions are kept in a free list
+ *    and reused for the new nodes, instead of being destroyed. clear()
+ *    moves all the nodes to the free list so that the tree can be reused
+ *    for another graph. The memory is released when the tree is destroyed.
  */
 namespace Wailea {
 
@@ -49,12 +54,34 @@ class BLTree : public Graph {
 
     bool isNil(node_list_it_t nIt);
 
+    /** @brief removes all the tree nodes into the free list, and resets
+     *         the tree to the state right after the construction.
+     */
+    void clear();
+
+    /** @brief returns the number of the nodes in the free list.
+     */
+    size_t numFreeNodes() const;
+
     node_list_it_t makePAttachment();
 
     void initializeForOneIteration();
 
     void advanceSib(node_list_it_t& prev, node_list_it_t& cur);
 
+    /** @brief adds a tree node taken from the free list, or a new one if
+     *         the list is empty.
+     *
+     *  @return the node in the state right after the construction.
+     */
+    node_list_it_t newNode();
+
+    /** @brief removes the tree node and puts it in the free list.
+     *
+     *  @param N (in): node to be removed.
+     */
+    void releaseNode(BLTreeNode& N);
+
     void unlinkFromPTypeParent(list<node_list_it_t>& children);
 
     /** @brief creates a new P node and put children under.
@@ -186,6 +213,10 @@ class BLTree : public Graph {
      */
     bool                 mVirtualNextSibAssumeReversed;
 
+    /** @brief tree nodes removed from the tree to be reused.
+     */
+    vector<node_ptr_t>   mFreeNodes;
+
 friend class BLPlanarityTester;
 friend class BLTreeNode;
 
@@ -2,6 +2,7 @@
 #define _WAILEA_UNDIRECTED_BL_TREE_NODE_HPP_
 
 #include "undirected/base.hpp"
+#include "undirected/element_pool.hpp"
 
 /**
  * @file undirected/bl_tree_node.hpp
@@ -26,7 +27,7 @@ class BLTree;
  *
  * @brief represents a PQ-tree node.
  */
-class BLTreeNode : public Node {
+class BLTreeNode : public Node, public PooledElement {
 
 #ifdef UNIT_TESTS
     static int nodeNumMaster;
@@ -41,6 +42,11 @@ class BLTreeNode : public Node {
     inline BLTreeNode(BLTree& tree) noexcept;
     inline virtual ~BLTreeNode();
 
+    /** @brief brings this node to the state right after the construction.
+     *         Used by BLTree to reuse the nodes in its free list.
+     */
+    inline void reinitialize() noexcept;
+
     /** @brief makes this node 'pertinent' by bringing mGeneration
      *         up-to-date. It also resets all the fields for pertinent
      *         type, wha values, wha type, and template application.
@@ -0,0 +1,338 @@
+#ifndef _WAILEA_UNDIRECTED_COMPACT_GRAPH_HPP_
+#define _WAILEA_UNDIRECTED_COMPACT_GRAPH_HPP_
+
+#include <iostream>
+#include <string>
+#include <list>
+#include <vector>
+#include <exception>
+#include <limits>
+
+#include "undirected/base.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+/**
+ * @file undirected/compact_graph.hpp
+ *
+ * @brief index-based read-only representation of undirected graph G(V,E).
+ *
+ * @details
+ *    CompactGraph stores the nodes and edges of a graph in contiguous arrays
+ *    and identifies them by integer indices [0, |V|) and [0, |E|).
+ *    The incidence of the nodes is stored in the CSR (compressed sparse row)
+ *    form: the incident edges of node n are found in mIncidence in the
+ *    range [mIncidenceOffsets[n], mIncidenceOffsets[n+1]) in the same
+ *    order as in the incidence list of the original Node.
+ *    The incident nodes of the edges are stored in two separate arrays
+ *    (struct-of-arrays) so that a traversal touches only the data it needs.
+ *
+ *    A CompactGraph is built from a Graph with build(Graph&), or directly
+ *    from a list of node index pairs with build(size_t, vector<>&).
+ *    The ordering of the nodes and edges follows nodes() and edges() of
+ *    the Graph. The iterators to the original nodes and edges are kept so
+ *    that the results of an algorithm run against the CompactGraph can be
+ *    mapped back to the Graph.
+ *    A Graph isomorphic to the CompactGraph can be created with
+ *    copyToGraph().
+ *
+ *    Unlike Graph, CompactGraph is immutable once built. It is intended for
+ *    the traversal-heavy phases of the algorithms on large inputs where the
+ *    pointer chasing through list<> cells dominates the running time.
+ *
+ *    The following run on CompactGraph.
+ *    - ConnectedDecomposer::decompose()
+ *    - STNumbering::getBipolarOrientation(). The overload on Graph
+ *      converts the graph and runs on the CompactGraph. It gives the
+ *      st-orderings to BLPlanarityTester and VisRepFinder.
+ *    BLPlanarityTester and VisRepFinder themselves still work on Graph.
+ *    Their working graphs are modified while they run: the PQ-tree
+ *    reductions reorder the incidence lists, and the visibility
+ *    representation adds nodes and edges to the dual graphs. An immutable
+ *    CSR graph does not fit them.
+ *
+ *  @remarks memory footprint
+ *    Each node takes 1 offset, and each edge takes 2 incident nodes and 2
+ *    entries in the incidence array, all of type cg_index_t.
+ *    The iterators to the original graph take 1 iterator per node and edge
+ *    if the CompactGraph is built from a Graph.
+ */
+
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+using cg_index_t = unsigned int;
+
+/** @class CompactGraph
+ *
+ *  @brief immutable CSR representation of an undirected graph.
+ */
+class CompactGraph {
+
+  public:
+
+    /** @brief index value that does not designate any node or edge.
+     */
+    static constexpr cg_index_t kInvalidIndex =
+                                         std::numeric_limits<cg_index_t>::max();
+
+    /** @brief  default-constructs an empty CompactGraph.
+     */
+    inline CompactGraph() noexcept;
+
+
+    /** @brief  destructs this object
+     */
+    inline virtual ~CompactGraph() noexcept;
+
+
+    /** @brief  builds the compact representation of the given graph.
+     *          Node i corresponds to the i-th node in g.nodes(), and
+     *          edge j corresponds to the j-th edge in g.edges().
+     *          The incident edges of each node are in the same order as
+     *          in its incidence list in g.
+     *
+     *  @param  g (in): the graph to be converted.
+     *
+     *  @remark It uses Node::utility internally.
+     */
+    void build(Graph& g);
+
+
+    /** @brief  builds the compact representation from the list of edges
+     *          given in the pairs of node indices.
+     *          Edge j has incident nodes edges[j].first and edges[j].second.
+     *          The incident edges of each node are in the ascending order
+     *          of the edge indices.
+     *
+     *  @param  numNodes (in): number of nodes
+     *
+     *  @param  edges    (in): incident nodes of the edges
+     *
+     *  @throw  std::invalid_argument(Constants::kExceptionNodeNotInGraph)
+     *              if a node index is out of range.
+     */
+    void build(size_t numNodes, const vector<pair<cg_index_t,cg_index_t>>& edges);
+
+
+    /** @brief  creates a graph isomorphic to this CompactGraph in g
+     *          using Node and Edge objects.
+     *
+     *  @param  g        (in):  empty graph to which the nodes and edges are
+     *                          added.
+     *
+     *  @param  nodeMap  (out): nodeMap[i] is the node in g for node i.
+     *
+     *  @param  edgeMap  (out): edgeMap[j] is the edge in g for edge j.
+     *
+     *  @throw  std::invalid_argument(Constants::kExceptionNotEmpty)
+     *              if g is not empty.
+     *
+     *  @remark The incidence lists of the nodes in g have the same order as
+     *          in this CompactGraph.
+     */
+    void copyToGraph(
+        Graph&                  g,
+        vector<node_list_it_t>& nodeMap,
+        vector<edge_list_it_t>& edgeMap
+    ) const;
+
+
+    /** @brief  releases all the arrays.
+     */
+    void clear() noexcept;
+
+
+    /** @brief  returns the number of nodes.
+     */
+    inline size_t numNodes() const noexcept;
+
+
+    /** @brief  returns the number of edges.
+     */
+    inline size_t numEdges() const noexcept;
+
+
+    /** @brief  returns the degree of the node n.
+     */
+    inline size_t degree(cg_index_t n) const noexcept;
+
+
+    /** @brief  returns the pair of begin and end pointers to the indices
+     *          of the incident edges of the node n.
+     */
+    inline pair<const cg_index_t*, const cg_index_t*>
+                                     incidentEdges(cg_index_t n) const noexcept;
+
+
+    /** @brief  returns the index of incident node 1 of the edge e.
+     */
+    inline cg_index_t incidentNode1(cg_index_t e) const noexcept;
+
+
+    /** @brief  returns the index of incident node 2 of the edge e.
+     */
+    inline cg_index_t incidentNode2(cg_index_t e) const noexcept;
+
+
+    /** @brief  returns the incident node of the edge e opposed to n.
+     */
+    inline cg_index_t adjacentNode(cg_index_t e, cg_index_t n) const noexcept;
+
+
+    /** @brief  returns true if this CompactGraph has been built from a Graph
+     *          and the original nodes and edges are available.
+     */
+    inline bool hasOriginal() const noexcept;
+
+
+    /** @brief  returns the node in the original graph for the node n.
+     *
+     *  @throw  std::invalid_argument(Constants::kExceptionWrongType)
+     *              if it is not built from a Graph.
+     */
+    inline node_list_it_t originalNode(cg_index_t n) const;
+
+
+    /** @brief  returns the edge in the original graph for the edge e.
+     *
+     *  @throw  std::invalid_argument(Constants::kExceptionWrongType)
+     *              if it is not built from a Graph.
+     */
+    inline edge_list_it_t originalEdge(cg_index_t e) const;
+
+
+  private:
+
+    /** @brief allocates the CSR arrays from mEdgeNode1 and mEdgeNode2.
+     *         the incident edges of each node are in the ascending order
+     *         of the edge indices.
+     */
+    void buildIncidenceFromEdges(size_t numNodes);
+
+    /** @brief offsets into mIncidence. It has |V|+1 elements.
+     */
+    vector<cg_index_t>     mIncidenceOffsets;
+
+    /** @brief incident edges of all the nodes concatenated.
+     *         It has 2|E| elements.
+     */
+    vector<cg_index_t>     mIncidence;
+
+    /** @brief incident node 1 of each edge.
+     */
+    vector<cg_index_t>     mEdgeNode1;
+
+    /** @brief incident node 2 of each edge.
+     */
+    vector<cg_index_t>     mEdgeNode2;
+
+    /** @brief nodes in the original graph. empty if not built from a Graph.
+     */
+    vector<node_list_it_t> mOriginalNodes;
+
+    /** @brief edges in the original graph. empty if not built from a Graph.
+     */
+    vector<edge_list_it_t> mOriginalEdges;
+
+#ifdef UNIT_TESTS
+  friend class CompactGraphTests;
+#endif
+
+};
+
+
+/*
+ * inline functions
+ */
+
+inline CompactGraph::CompactGraph() noexcept {;}
+
+
+inline CompactGraph::~CompactGraph() noexcept {;}
+
+
+inline size_t CompactGraph::numNodes() const noexcept
+{
+    return mIncidenceOffsets.size() == 0 ? 0 : mIncidenceOffsets.size() - 1;
+}
+
+
+inline size_t CompactGraph::numEdges() const noexcept
+{
+    return mEdgeNode1.size();
+}
+
+
+inline size_t CompactGraph::degree(cg_index_t n) const noexcept
+{
+    return mIncidenceOffsets[n+1] - mIncidenceOffsets[n];
+}
+
+
+inline pair<const cg_index_t*, const cg_index_t*>
+CompactGraph::incidentEdges(cg_index_t n) const noexcept
+{
+    const cg_index_t* base = mIncidence.data();
+    return make_pair(base + mIncidenceOffsets[n],
+                     base + mIncidenceOffsets[n+1]);
+}
+
+
+inline cg_index_t CompactGraph::incidentNode1(cg_index_t e) const noexcept
+{
+    return mEdgeNode1[e];
+}
+
+
+inline cg_index_t CompactGraph::incidentNode2(cg_index_t e) const noexcept
+{
+    return mEdgeNode2[e];
+}
+
+
+inline cg_index_t CompactGraph::adjacentNode(
+    cg_index_t e,
+    cg_index_t n
+) const noexcept
+{
+    return (mEdgeNode1[e] == n) ? mEdgeNode2[e] : mEdgeNode1[e];
+}
+
+
+inline bool CompactGraph::hasOriginal() const noexcept
+{
+    return mOriginalNodes.size() == numNodes() &&
+           mOriginalEdges.size() == numEdges() &&
+           (numNodes() > 0 || numEdges() > 0);
+}
+
+
+inline node_list_it_t CompactGraph::originalNode(cg_index_t n) const
+{
+    if (n >= mOriginalNodes.size()) {
+        throw std::invalid_argument(Constants::kExceptionWrongType);
+    }
+    return mOriginalNodes[n];
+}
+
+
+inline edge_list_it_t CompactGraph::originalEdge(cg_index_t e) const
+{
+    if (e >= mOriginalEdges.size()) {
+        throw std::invalid_argument(Constants::kExceptionWrongType);
+    }
+    return mOriginalEdges[e];
+}
+
+
+}// namespace Undirected
+
+}// namespace Wailea
+
+#endif /*_WAILEA_UNDIRECTED_COMPACT_GRAPH_HPP_*/
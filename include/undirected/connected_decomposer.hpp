@@ -8,6 +8,7 @@
 #include <exception>
 
 #include "undirected/base.hpp"
+#include "undirected/compact_graph.hpp"
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -57,6 +58,25 @@ class ConnectedDecomposer {
     void decompose(Graph& g, vector<vector<node_list_it_t> >& nodeSets,
                              vector<vector<edge_list_it_t> >& edgeSets);
 
+
+    /** @brief performs the decomposition on the compact representation.
+     *
+     *  @param   g (in):         input graph.
+     *
+     *  @param   nodeSets (out): lists of node indices. Each list contains
+     *                           the nodes for a connected component.
+     *
+     *  @param   edgeSets (out): lists of edge indices. Each list contains
+     *                           the edges for a connected component.
+     *
+     *  @remark  The components and the nodes in them are found in the same
+     *           order as decompose(Graph&,...) for the graph from which g
+     *           has been built.
+     */
+    void decompose(const CompactGraph& g,
+                   vector<vector<cg_index_t> >& nodeSets,
+                   vector<vector<cg_index_t> >& edgeSets);
+
   private:
 
 #ifdef UNIT_TESTS
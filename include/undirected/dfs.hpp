@@ -168,7 +168,7 @@ class DFSNode : public BASE_NODE {
                 auto it = mEdgeVisiting;
                 it++;
                 for(;it != this->incidentEdges().second; it++) {
-                    DEdge& e = dynamic_cast<DEdge&>(*(*(*it)));
+                    DEdge& e = downcast<DEdge>(*(*(*it)));
                     if (e.isVisited()==false) {
                         return true;
                     }
@@ -179,7 +179,7 @@ class DFSNode : public BASE_NODE {
         else {
             for(auto it = mEdgeVisiting;it != this->incidentEdges().second;
                                                                        it++) {
-                DEdge& e = dynamic_cast<DEdge&>(*(*(*it)));
+                DEdge& e = downcast<DEdge>(*(*(*it)));
                 if (e.isVisited()==false) {
                     return true;
                 }
@@ -191,7 +191,7 @@ class DFSNode : public BASE_NODE {
 
     inline DEdge& currentDFSEdge() noexcept {
 
-        return dynamic_cast<DEdge&>(*(*(*mEdgeVisiting)));
+        return downcast<DEdge>(*(*(*mEdgeVisiting)));
 
     }
 
@@ -313,7 +313,7 @@ class DFSEdge : public BASE_EDGE {
     inline DFSNode<BASE_GRAPH,BASE_NODE,BASE_EDGE>& adjacentDFSNode(
         DFSNode<BASE_GRAPH,BASE_NODE,BASE_EDGE>& n
     ) const noexcept {
-        return dynamic_cast<DFSNode<BASE_GRAPH,BASE_NODE,BASE_EDGE>&>
+        return downcast<DFSNode<BASE_GRAPH,BASE_NODE,BASE_EDGE>>
                    (this->adjacentNode(n));
     }
 
@@ -0,0 +1,304 @@
+#ifndef _WAILEA_UNDIRECTED_ELEMENT_POOL_HPP_
+#define _WAILEA_UNDIRECTED_ELEMENT_POOL_HPP_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+/**
+ * @file undirected/element_pool.hpp
+ *
+ * @brief pooled allocation of the nodes and edges of the working graphs
+ *        that the algorithms create internally.
+ *
+ * @details
+ *    Most of the algorithms make a copy of the input graph in their own
+ *    subclasses of Node and Edge (e.g. BLGraphNode, ST_DFS_Node,
+ *    SPQR_DFS_Node), run on the copy, and then discard it. This results in
+ *    a large number of small allocations and deallocations of objects of
+ *    only a handful of sizes.
+ *
+ *    ElementPool is a size-segregated free-list allocator. The requested
+ *    size is rounded up to a multiple of kGranularity, and each size class
+ *    has its own free list. The blocks are carved out of chunks of
+ *    kChunkSize bytes, and a freed block is pushed back to the free list of
+ *    its size class in O(1) for reuse.
+ *    The chunks are aligned at kChunkSize, and the first kGranularity bytes
+ *    of a chunk are its header that tells the owner of the chunk. The owner
+ *    of a block is found from the header of the chunk it is in.
+ *    The free lists are per thread, and no lock is taken except when a
+ *    thread runs out of blocks or exits. When a thread exits, its free
+ *    blocks are handed over to a process-wide depot from which the other
+ *    threads refill. A block can be freed by a thread other than the one
+ *    that allocated it.
+ *    The chunks are retained for the life of the process and are not
+ *    returned to the system.
+ *    Requests larger than kMaxPooledSize are passed to the global
+ *    operator new and delete.
+ *
+ *    ElementArena is a bump allocator for a working graph that is built
+ *    and discarded as a whole. While an ElementArena::Scope is alive on a
+ *    thread, the requests to ElementPool up to kMaxPooledSize on that
+ *    thread are served from the arena. The blocks in an arena are not
+ *    reused, and deallocate() on them does nothing. When the arena is
+ *    destroyed, its chunks are returned to the system at once, which takes
+ *    time proportional to the number of the chunks, not the elements.
+ *    The arena must outlive all the objects and the list cells allocated
+ *    in its scope. The scope is meant to be put only around the code that
+ *    copies the input graph into the working graph.
+ *
+ *    A class opts in by deriving from PooledElement in addition to Node or
+ *    Edge. Since Graph owns its elements by unique_ptr and the destructors
+ *    are virtual, the class-specific operator delete of the most derived
+ *    class is used on destruction with the actual object size.
+ *    The subclasses of an opted-in class such as DFSNode<> inherit the
+ *    pooled allocation.
+ *
+ *    Defining WAILEA_NO_ELEMENT_POOL at the compile time makes
+ *    PooledElement empty, and all the allocations go to the global
+ *    operator new and delete. This is useful for memory debugging tools.
+ *
+ *    The list cells of Graph and Node, i.e., node_list_t, edge_list_t, and
+ *    node_incidence_t, use PoolAllocator, which passes the requests to
+ *    ElementPool. They come from the arena in a scope in the same way.
+ */
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+/** @class ElementPool
+ *
+ *  @brief size-segregated free-list allocator with per-thread caches.
+ */
+class ElementPool {
+
+  public:
+
+    /** @brief the sizes of the blocks are multiples of this value.
+     */
+    static constexpr size_t kGranularity   = 16;
+
+    /** @brief the requests larger than this go to the global operator new.
+     */
+    static constexpr size_t kMaxPooledSize = 512;
+
+    /** @brief number of bytes allocated from the system at a time.
+     */
+    static constexpr size_t kChunkSize     = 64 * 1024;
+
+    /** @brief number of the size classes.
+     */
+    static constexpr size_t kNumClasses    = kMaxPooledSize / kGranularity;
+
+    /** @brief allocates a block of at least the given size.
+     *
+     *  @param  size (in): size of the block in bytes.
+     *
+     *  @return pointer to the block aligned at kGranularity.
+     *
+     *  @throws bad_alloc()
+     *           if there is a memory shortage.
+     */
+    static void* allocate(size_t size);
+
+
+    /** @brief returns the block to the free list.
+     *
+     *  @param  p    (in): pointer returned by allocate(size). nullptr is
+     *                     ignored.
+     *
+     *  @param  size (in): the size given to allocate().
+     */
+    static void  deallocate(void* p, size_t size) noexcept;
+
+
+    /** @brief returns the number of the chunks allocated so far by all the
+     *         threads for the free lists. The ones for the arenas are not
+     *         counted.
+     */
+    static size_t numChunks() noexcept;
+
+  private:
+
+    /** @brief returns the size class of the given size.
+     */
+    static inline size_t sizeClass(size_t size) noexcept {
+        return (size + kGranularity - 1) / kGranularity - 1;
+    }
+
+#ifdef UNIT_TESTS
+  friend class ElementPoolTests;
+#endif
+
+};
+
+
+/** @class ElementArena
+ *
+ *  @brief bump allocator whose chunks are released together when it is
+ *         destroyed.
+ */
+class ElementArena {
+
+  public:
+
+    /** @brief makes the arena the destination of ElementPool::allocate()
+     *         on the current thread while it is alive. The previous one is
+     *         restored on destruction, and the scopes can be nested.
+     *
+     *  @remark A working copy of the input graph made in a scope is
+     *          released in whole chunks together with the arena, not
+     *          element by element. The arena is declared before the
+     *          working graph so that it is destroyed after the graph.
+     */
+    class Scope {
+
+      public:
+
+        Scope(ElementArena& arena);
+
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+
+        ElementArena* mPrevious;
+    };
+
+    inline ElementArena():mCur(nullptr),mEnd(nullptr){;}
+
+    /** @brief returns all the chunks to the system.
+     */
+    ~ElementArena();
+
+    ElementArena(const ElementArena&) = delete;
+
+    ElementArena& operator=(const ElementArena&) = delete;
+
+    /** @brief returns the number of the chunks held by the arena.
+     */
+    inline size_t numChunks() const noexcept { return mChunks.size(); }
+
+  private:
+
+    /** @brief allocates a block from the current chunk, or a new chunk if
+     *         it does not have enough room.
+     *
+     *  @param  size (in): size in bytes up to ElementPool::kMaxPooledSize.
+     */
+    void* allocate(size_t size);
+
+    /** @brief next free byte in the current chunk */
+    char*         mCur;
+
+    /** @brief end of the current chunk */
+    char*         mEnd;
+
+    /** @brief chunks held by the arena */
+    std::vector<char*> mChunks;
+
+  friend class ElementPool;
+
+#ifdef UNIT_TESTS
+  friend class ElementPoolTests;
+#endif
+
+};
+
+
+/** @class PoolAllocator
+ *
+ *  @brief allocator for the standard containers that passes the requests
+ *         to ElementPool. It has no state, and all the instances are
+ *         interchangeable.
+ */
+template<class T>
+class PoolAllocator {
+
+  public:
+
+    using value_type = T;
+
+    inline PoolAllocator() noexcept {;}
+
+    template<class U>
+    inline PoolAllocator(const PoolAllocator<U>&) noexcept {;}
+
+#ifndef WAILEA_NO_ELEMENT_POOL
+
+    inline T* allocate(size_t n) {
+        return static_cast<T*>(ElementPool::allocate(n * sizeof(T)));
+    }
+
+    inline void deallocate(T* p, size_t n) noexcept {
+        ElementPool::deallocate(p, n * sizeof(T));
+    }
+
+#else
+
+    inline T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    inline void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p);
+    }
+
+#endif /*WAILEA_NO_ELEMENT_POOL*/
+
+};
+
+
+template<class T, class U>
+inline bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+    return true;
+}
+
+
+template<class T, class U>
+inline bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+    return false;
+}
+
+
+/** @class PooledElement
+ *
+ *  @brief mixin to route new and delete of the derived class to
+ *         ElementPool.
+ *         It has no data member.
+ */
+class PooledElement {
+
+#ifndef WAILEA_NO_ELEMENT_POOL
+
+  public:
+
+    static inline void* operator new(size_t size) {
+        return ElementPool::allocate(size);
+    }
+
+    static inline void operator delete(void* p, size_t size) noexcept {
+        ElementPool::deallocate(p, size);
+    }
+
+#endif /*WAILEA_NO_ELEMENT_POOL*/
+
+};
+
+
+}// namespace Undirected
+
+}// namespace Wailea
+
+#endif /*_WAILEA_UNDIRECTED_ELEMENT_POOL_HPP_*/
@@ -467,8 +467,17 @@ class EmbeddedBCTree : public Graph {
      *         BlockType and EmbeddedNodes & EmbeddedEdges in 
      *         EmbeddedBCTreeNode::embeddedGraph() are cross-linked with
      *         IGForwardLink and IGBackwardLink.
+     *
+     *  @param  numThreads (in): number of the worker threads that embed
+     *                           the blocks concurrently. 1 embeds them one
+     *                           by one. If it is 0,
+     *                           std::thread::hardware_concurrency() is used.
+     *
+     *  @remark The blocks are independent graphs, and the biggest blocks
+     *          are given to the threads first. The result does not depend
+     *          on the number of the threads.
      */
-    void makeDefaultEmbedding();
+    void makeDefaultEmbedding(size_t numThreads = 1);
 
 
     /** @brief find the geometric embedding based on the given block node
@@ -558,6 +567,13 @@ class EmbeddedBCTree : public Graph {
         edge_list_it_t& eCCWIt
     );
 
+    /** @brief makes an embedding of the block of the given node and its
+     *         dual graph. It modifies only the block and the node.
+     *
+     *  @param  ETN (in/out): EmbeddedBCTreeNode of BlockType
+     */
+    void embedBlock(EmbeddedBCTreeNode& ETN);
+
 #ifdef UNIT_TESTS
   friend class EmbeddedBCTreeTests;
 #endif
@@ -970,7 +986,7 @@ EmbeddedBCTree::ExplorationNode& EmbeddedBCTree::ExplorationTree::root(){
         throw std::invalid_argument(
                          ConstantsEmbeddedBCTree::kExceptionBCTreeRootNotSet);
     }                            
-    return dynamic_cast<ExplorationNode&>(*(*mRoot));
+    return downcast<ExplorationNode>(*(*mRoot));
 }
 
 EmbeddedBCTree::ExplorationNode::ExplorationNode(EmbeddedBCTreeNode& org):
@@ -1084,7 +1100,7 @@ EmbeddedFace& EmbeddedBCTreeNode::outerFace()
         throw std::invalid_argument(
                             ConstantsBCTree::kExceptionBCTreeInvalidNodeType);
     }
-    return dynamic_cast<EmbeddedFace&>(*(*mOuterFace));
+    return downcast<EmbeddedFace>(*(*mOuterFace));
 }
 
 EmbeddedNode& EmbeddedBCTreeNode::topNode()
@@ -1093,7 +1109,7 @@ EmbeddedNode& EmbeddedBCTreeNode::topNode()
         throw std::invalid_argument(
                             ConstantsBCTree::kExceptionBCTreeInvalidNodeType);
     }
-    return dynamic_cast<EmbeddedNode&>(*(*mTopNode));
+    return downcast<EmbeddedNode>(*(*mTopNode));
 }
 
 
@@ -1125,12 +1141,12 @@ EmbeddedBCTreeEdge::EmbeddedBCTreeEdge(BCTreeEdge& original)
 
 EmbeddedBCTreeNode& EmbeddedBCTreeEdge::incidentNodeBlockType()
 {
-    auto& N1 = dynamic_cast<EmbeddedBCTreeNode&>(incidentNode1());
+    auto& N1 = downcast<EmbeddedBCTreeNode>(incidentNode1());
     if (N1.type() == BCTreeNode::BlockType) {
         return N1;
     }
     else {
-        return dynamic_cast<EmbeddedBCTreeNode&>(incidentNode2());
+        return downcast<EmbeddedBCTreeNode>(incidentNode2());
     }
 }
 
@@ -1142,7 +1158,7 @@ EmbeddedBCTreeNode& EmbeddedBCTree::root(){
         throw std::invalid_argument(
                          ConstantsEmbeddedBCTree::kExceptionBCTreeRootNotSet);
     }                            
-    return dynamic_cast<EmbeddedBCTreeNode&>(*(*mRoot)); 
+    return downcast<EmbeddedBCTreeNode>(*(*mRoot)); 
 }
 
 UnificationGroup::UnificationGroup(){;}
@@ -1252,7 +1268,7 @@ UnificationFace::UnificationFace(){;}
 UnificationFace::~UnificationFace(){;} 
 
 EmbeddedBCTreeNode& UnificationFace::treeNode(){
-    return dynamic_cast<EmbeddedBCTreeNode&>(*(*mNodeInEmbeddedBCTree));
+    return downcast<EmbeddedBCTreeNode>(*(*mNodeInEmbeddedBCTree));
 }
 
 
@@ -1271,20 +1287,20 @@ void UnificationFace::setOrientation() {
 }
 
 EmbeddedFace& UnificationFace::faceInDG() {
-                           return dynamic_cast<EmbeddedFace&>(*(*mFaceInDG)); }
+                           return downcast<EmbeddedFace>(*(*mFaceInDG)); }
 node_list_it_t UnificationFace::faceInDGIt() { return mFaceInDG; }
 
 EmbeddedNode& UnificationFace::cutVertexInEG() {
-                      return dynamic_cast<EmbeddedNode&>(*(*mCutVertexInEG)); }
+                      return downcast<EmbeddedNode>(*(*mCutVertexInEG)); }
 node_list_it_t UnificationFace::cutVertexInEGIt() { return mCutVertexInEG; }
 
 EmbeddedEdge& UnificationFace::edgeCCWInEG() {
-                        return dynamic_cast<EmbeddedEdge&>(*(*mEdgeCCWInEG)); }
+                        return downcast<EmbeddedEdge>(*(*mEdgeCCWInEG)); }
 
 edge_list_it_t UnificationFace::edgeCCWInEGIt() { return mEdgeCCWInEG; }
 
 EmbeddedEdge& UnificationFace::edgeCWInEG() {
-                         return dynamic_cast<EmbeddedEdge&>(*(*mEdgeCWInEG)); }
+                         return downcast<EmbeddedEdge>(*(*mEdgeCWInEG)); }
 
 edge_list_it_t UnificationFace::edgeCWInEGIt() { return mEdgeCWInEG; }
 
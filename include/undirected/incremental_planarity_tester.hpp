@@ -0,0 +1,256 @@
+#ifndef _WAILEA_UNDIRECTED_INCREMENTAL_PLANARITY_TESTER_HPP_
+#define _WAILEA_UNDIRECTED_INCREMENTAL_PLANARITY_TESTER_HPP_
+
+#include "undirected/base.hpp"
+#include "undirected/bl_planarity_tester.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+/**
+ * @file undirected/incremental_planarity_tester.hpp
+ *
+ * @brief online planarity test for the edges added one by one to a
+ *        biconnected planar graph. An edge is added only if the graph
+ *        stays planar.
+ *
+ * @details
+ *    The tester keeps a combinatorial embedding of the graph as the cyclic
+ *    order of the sides of the edges around each node, and a face label for
+ *    each side of each edge. The incidence lists of the graph keep their
+ *    order, and the new edges are appended to them. For a new edge
+ *    {n1, n2}:
+ *
+ *    1. If n1 and n2 are on a common face of the current embedding, the
+ *       edge is put into the face. The graph stays planar, and the face is
+ *       split into two. Only the smaller of the two new faces is
+ *       relabeled, as the two sides are walked alternately.
+ *
+ *    2. Otherwise, if the graph is triconnected, the embedding is unique up
+ *       to the mirror image [W33], and the edge can not be added.
+ *
+ *    3. Otherwise, the edge is added and
+ *       BLPlanarityTester::findEmbedding() is run on the whole graph.
+ *       If it is not planar, the edge is removed, and the embedding
+ *       without it is kept. If it is, the new embedding is taken, and the
+ *       faces are labeled again.
+ *
+ *    The embedding is used only if the faces found satisfy Euler's
+ *    formula |N| - |E| + |F| = 2. Otherwise all the queries go to the case
+ *    3 until a new embedding is found.
+ *    The edges accepted are the same as the ones by a full planarity test
+ *    per edge.
+ *    Adding edges never breaks triconnectivity. Once the graph becomes
+ *    triconnected, every query is answered in the case 1 or 2.
+ *
+ * @remark on the complexity
+ *    The cases 1 and 2 take O(deg(n1) + deg(n2)) plus the length of the
+ *    smaller new face. Each side of an edge is relabeled O(log|E|) times
+ *    over a series of insertions in the case 1 between two full
+ *    relabelings.
+ *    The case 3 takes O(|N|+|E|) for BL and for the SPQR decomposition
+ *    that checks the triconnectivity after a success.
+ *    A fully dynamic test in sublinear time for the case 3, as in [DT96],
+ *    is not implemented.
+ *
+ * @remark on the graph
+ *    The graph must be a simple biconnected planar graph, and the edges
+ *    added must keep it simple. The st-ordering given to initialize()
+ *    stays valid as edges are added.
+ *    While the tester is in use, the top of the utility stack of each edge
+ *    is used for its index. It is pushed by initialize() and popped by
+ *    cleanUp(). The graph must not be modified in other ways in between.
+ *
+ * @usage
+ *
+ *   IncrementalPlanarityTester tester;
+ *   tester.initialize(G, stOrder);
+ *   for (...) {
+ *       auto ep = make_unique<Edge>();
+ *       if (tester.insertEdgeIfPlanar(std::move(ep), N1, N2)) {
+ *           // The edge is in G.
+ *       }
+ *   }
+ *   tester.cleanUp();
+ *
+ * @references
+ *  [W33] Hassler Whitney (1933), "2-isomorphic graphs", American Journal of
+ *        Mathematics 55 (1): 245-254
+ *
+ *  [DT96] Giuseppe Di Battista, Roberto Tamassia (1996), "On-line planarity
+ *        testing", SIAM Journal on Computing 25 (5): 956-997
+ */
+
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+class ConstantsIncrementalPlanarityTester {
+
+  public:
+    static constexpr const char* kExceptionNotPlanar
+                    = "The graph is not planar.";
+};
+
+
+/**
+ * @class IncrementalPlanarityTester
+ *
+ * @brief keeps a planar embedding of a graph while edges are added.
+ */
+class IncrementalPlanarityTester {
+
+  public:
+
+    inline IncrementalPlanarityTester():
+        mG(nullptr),
+        mNumFaces(0),
+        mStamp(0),
+        mEmbedded(false),
+        mTriconnected(false),
+        mNumFullTests(0){;}
+
+    /** @brief finds a planar embedding of g, and labels the faces.
+     *
+     *  @param  g       (in/out): simple biconnected planar graph to which
+     *                            the edges are added.
+     *
+     *  @param  stOrder (in):     st-ordering of the nodes of g.
+     *
+     *  @throws std::invalid_argument(
+     *              ConstantsIncrementalPlanarityTester::kExceptionNotPlanar)
+     *              if g is not planar.
+     */
+    void initialize(Graph& g, vector<node_list_it_t>& stOrder);
+
+    /** @brief adds an edge between n1 and n2 if the graph stays planar.
+     *
+     *  @param  e   (in): edge to be added. If it can not be added, it is
+     *                    left in e.
+     *
+     *  @param  n1  (in): node of the graph to become incident node 1.
+     *
+     *  @param  n2  (in): node of the graph to become incident node 2.
+     *
+     *  @return true if the edge has been added.
+     */
+    bool insertEdgeIfPlanar(edge_ptr_t&& e, Node& n1, Node& n2);
+
+    /** @brief pops the edge indices from the utility stacks of the edges.
+     */
+    void cleanUp();
+
+    /** @brief returns true if the graph is known to be triconnected.
+     */
+    inline bool isTriconnected() const noexcept { return mTriconnected; }
+
+    /** @brief returns the number of the full planarity tests run by
+     *         insertEdgeIfPlanar() so far.
+     */
+    inline size_t numFullTests() const noexcept { return mNumFullTests; }
+
+  private:
+
+    /** @brief returns the index of the side of e that goes out of n.
+     */
+    inline size_t halfEdge(Edge& e, Node& n) const {
+        return 2 * e.utility() + ((&(e.incidentNode1()) == &n) ? 0 : 1);
+    }
+
+    /** @brief adds e between n1 and n2 if they share a face, and splits
+     *         the face.
+     *
+     *  @return true if e has been added.
+     */
+    bool insertEdgeIntoCommonFace(edge_ptr_t& e, Node& n1, Node& n2);
+
+    /** @brief puts h before hNext in the rotation around their node.
+     */
+    void insertIntoRotation(size_t h, size_t hNext);
+
+    /** @brief finds a planar embedding of the graph, labels the faces,
+     *         and checks the triconnectivity of the graph.
+     *         The incidence lists of the graph are left in their order.
+     *
+     *  @return false if the graph is not planar. The current embedding
+     *          is not changed.
+     */
+    bool embed();
+
+    /** @brief returns the side of the edge that follows h on its face.
+     *         It is the one after the reverse of h around the head of h.
+     */
+    inline size_t nextHalfEdge(size_t h) const { return mNext[h ^ 1]; }
+
+    /** @brief labels the faces of all the edges on the current
+     *         incidence lists.
+     */
+    void labelAllFaces();
+
+    /** @brief splits the face of the new edge e into two, and gives a new
+     *         label to the smaller one.
+     */
+    void splitFace(Edge& e);
+
+    /** @brief the graph being tested */
+    Graph*                  mG;
+
+    /** @brief st-ordering of mG */
+    vector<node_list_it_t>  mStOrder;
+
+    /** @brief face label of each side of each edge.
+     *         2i for the side out of incidentNode1() of the edge with the
+     *         index i, and 2i+1 for the other side.
+     */
+    vector<size_t>          mFaces;
+
+    /** @brief side of the edge that comes after each side around the node
+     *         it goes out of.
+     */
+    vector<size_t>          mNext;
+
+    /** @brief side of the edge that comes before each side around the node
+     *         it goes out of.
+     */
+    vector<size_t>          mPrev;
+
+    /** @brief edges of mG in their indices */
+    vector<Edge*>           mEdges;
+
+    /** @brief number of the face labels */
+    size_t                  mNumFaces;
+
+    /** @brief stamp per face to find a common face */
+    vector<size_t>          mFaceStamps;
+
+    /** @brief current value of the stamp */
+    size_t                  mStamp;
+
+    /** @brief true if the incidence lists of mG are a planar embedding
+     *         with the faces in mFaces.
+     */
+    bool                    mEmbedded;
+
+    /** @brief true if mG is known to be triconnected */
+    bool                    mTriconnected;
+
+    /** @brief number of the full tests */
+    size_t                  mNumFullTests;
+
+    /** @brief tester for the full tests */
+    BLPlanarityTester       mTester;
+
+#ifdef UNIT_TESTS
+  friend class IncrementalPlanarityTesterTests;
+#endif
+
+};
+
+}// namespace Undirected
+
+}// namespace Wailea
+
+#endif /*_WAILEA_UNDIRECTED_INCREMENTAL_PLANARITY_TESTER_HPP_*/
@@ -11,6 +11,37 @@
  *        1. JTS algorithm to find a good spanning planar subgraph.
  *        2. BL algorighm to find a maximal spanning planar subgraph
  *        3. GMW edge insertion algorithm to insert removed edges back in.
+ *
+ * @details
+ *        For the maximal planar subgraph, the edges removed by JTS are
+ *        tried one by one in the original order with
+ *        IncrementalPlanarityTester. It keeps an embedding of the subgraph
+ *        and answers most of the queries without a full planarity test.
+ *
+ *        By default the removed edges are inserted back one by one. Each
+ *        insertion path is found on the planarized graph that includes all
+ *        the edges inserted so far.
+ *        Alternatively the insertion paths of a batch of removed edges can
+ *        be found concurrently by worker threads, each of which runs GMW on
+ *        its own copy (snapshot) of the current planarized graph. Then the
+ *        paths whose crossed edges are disjoint from those of the preceding
+ *        paths in the batch are the candidates, and the longest prefix of
+ *        the candidates whose simultaneous insertion keeps the graph planar
+ *        is inserted. The rest of the batch is retried in the next round
+ *        against the updated graph. At least one edge is inserted in each
+ *        round, as the first path of a batch is always valid.
+ *        Each edge is inserted with the minimum number of crossings
+ *        for the planarized graph at the beginning of the round, which can
+ *        only be smaller than or equal to that for the planarized graph
+ *        with more edges inserted.
+ *        The result does not depend on the number of threads, but it can be
+ *        different from the one by the sequential insertion, as the edges
+ *        are inserted into a different sequence of graphs.
+ *
+ *        planarizeConnectedGraph() can also planarize the blocks
+ *        concurrently by worker threads, as the blocks are independent
+ *        graphs. The result is identical to the one by the sequential
+ *        processing.
  */
 
 namespace Wailea {
@@ -19,13 +50,72 @@ namespace Undirected {
 
 using namespace std;
 
+class BLPlanarityTester;
+
 class JTS_BL_GMW_Planarizer {
 
   public:
 
+    /** @brief default number of the removed edges processed in a round in
+     *         SPECULATIVE_BATCH.
+     */
+    static constexpr size_t kDefaultBatchSize = 64;
+
+    /** @brief strategy to insert the removed edges back.
+     *
+     *  - SEQUENTIAL:        inserts the edges one by one.
+     *
+     *  - SPECULATIVE_BATCH: finds the insertion paths of a batch of edges
+     *                       concurrently, and inserts the ones that do not
+     *                       conflict with each other at once.
+     */
+    enum insertionMode {
+        SEQUENTIAL,
+        SPECULATIVE_BATCH
+    };
+
+    inline JTS_BL_GMW_Planarizer():
+        mInsertionMode(SEQUENTIAL),
+        mNumThreads(0),
+        mBatchSize(kDefaultBatchSize),
+        mNumBlockThreads(1){;}
+
+    /** @brief sets the strategy to insert the removed edges back.
+     *
+     *  @param  mode       (in): insertion strategy
+     *
+     *  @param  numThreads (in): number of the worker threads for
+     *                           SPECULATIVE_BATCH. If it is 0,
+     *                           std::thread::hardware_concurrency() is used.
+     *
+     *  @param  batchSize  (in): number of the edges processed in a round for
+     *                           SPECULATIVE_BATCH. If it is 0,
+     *                           kDefaultBatchSize is used.
+     */
+    inline void setInsertionMode(
+        enum insertionMode mode,
+        size_t             numThreads = 0,
+        size_t             batchSize  = kDefaultBatchSize
+    ) {
+        mInsertionMode = mode;
+        mNumThreads    = numThreads;
+        mBatchSize     = (batchSize == 0) ? kDefaultBatchSize : batchSize;
+    }
+
+    /** @brief sets the number of the worker threads that planarize the
+     *         blocks concurrently in planarizeConnectedGraph().
+     *
+     *  @param  numThreads (in): 1 planarizes the blocks one by one.
+     *                           If it is 0,
+     *                           std::thread::hardware_concurrency() is used.
+     */
+    inline void setNumBlockThreads(size_t numThreads) {
+        mNumBlockThreads = numThreads;
+    }
+
     /** @brief finds a planarized graph of the given connected graph.
      *
-     *  @param  G              (in): the input graph. Must be biconnected.
+     *  @param  G              (in): the input graph. Must be connected.
      *
      *  @param  planarizedG   (out): planarized copy of G.
      */
@@ -70,6 +160,79 @@ class JTS_BL_GMW_Planarizer {
         vector<edge_list_it_t>& removedEdges
     );
 
+    /** @brief inserts the removed edges back in SPECULATIVE_BATCH.
+     *
+     *  @param  planarSubgraph  (in/out): biconnected planar subgraph.
+     *
+     *  @param  removedEdges    (in): edges in G to be inserted.
+     */
+    void reinsertRemovedEdgesSpeculatively(
+        PlanarizableGraph&      planarSubgraph,
+        vector<edge_list_it_t>& removedEdges
+    );
+
+    /** @brief finds the insertion paths of the edges in [begin, end) on
+     *         the snapshots of planarSubgraph with worker threads.
+     *         The nodes of planarSubgraph must have their indices in
+     *         nodes() as the utility values.
+     *
+     *  @param  planarSubgraph  (in): planar subgraph. It is not modified.
+     *
+     *  @param  nodeIts         (in): nodes of planarSubgraph in nodes().
+     *
+     *  @param  removedEdges    (in): edges in G to be inserted.
+     *
+     *  @param  begin           (in): start of the range in removedEdges.
+     *
+     *  @param  end             (in): end of the range in removedEdges.
+     *
+     *  @return insertion paths in the edges of planarSubgraph for the edges
+     *          in the range.
+     */
+    vector<list<edge_list_it_t>> findInsertionPathsInParallel(
+        PlanarizableGraph&      planarSubgraph,
+        vector<node_list_it_t>& nodeIts,
+        vector<edge_list_it_t>& removedEdges,
+        size_t                  begin,
+        size_t                  end
+    );
+
+    /** @brief tests if planarSubgraph stays planar after the first
+     *         numInsertions candidates are inserted along their paths.
+     *         The nodes of planarSubgraph must have their indices in
+     *         nodes() as the utility values, and the edges crossed by the
+     *         i-th candidate must have i+1 as the utility values.
+     *
+     *  @param  planarSubgraph  (in): biconnected planar subgraph.
+     *
+     *  @param  endPoints       (in): pairs of the node indices of the
+     *                                candidates.
+     *
+     *  @param  paths           (in): insertion paths of the candidates.
+     *
+     *  @param  numInsertions   (in): number of the candidates to insert.
+     *
+     *  @return true if the resultant graph is planar.
+     */
+    bool isPlanarWithInsertions(
+        PlanarizableGraph&                   planarSubgraph,
+        vector<pair<size_t,size_t>>&         endPoints,
+        vector<const list<edge_list_it_t>*>& paths,
+        size_t                               numInsertions
+    );
+
+    /** @brief strategy to insert the removed edges back */
+    enum insertionMode mInsertionMode;
+
+    /** @brief number of the worker threads for SPECULATIVE_BATCH */
+    size_t             mNumThreads;
+
+    /** @brief number of the edges processed in a round */
+    size_t             mBatchSize;
+
+    /** @brief number of the worker threads for the blocks */
+    size_t             mNumBlockThreads;
+
 #ifdef UNIT_TESTS
 friend class JTS_BL_GMW_PlanarizerTests;
 #endif
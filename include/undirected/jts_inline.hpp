@@ -137,7 +137,7 @@ inline bool JTSTreeNode::isEmpty() {
 inline void JTSTreeNode::markGraphEdgeRemoved()
 {
     if (mNodeType == LType) {
-        auto& E = dynamic_cast<JTSGraphEdge&>(*(*(mGraphEdge)));
+        auto& E = downcast<JTSGraphEdge>(*(*(mGraphEdge)));
         E.mRemoved = true;
     }
 }
@@ -146,7 +146,7 @@ inline void JTSTreeNode::markGraphEdgeRemoved()
 inline bool JTSTreeNode::isGraphEdgeRemoved()
 {
     if (mNodeType == LType) {
-        auto& E = dynamic_cast<JTSGraphEdge&>(*(*(mGraphEdge)));
+        auto& E = downcast<JTSGraphEdge>(*(*(mGraphEdge)));
         return E.mRemoved;
     }
     return false;
@@ -221,7 +221,7 @@ inline JTSTree::~JTSTree(){;}
 
 inline JTSTreeNode& JTSTree::toNodeRef(node_list_it_t nIt)
 {
-    return dynamic_cast<JTSTreeNode&>(*(*nIt));
+    return downcast<JTSTreeNode>(*(*nIt));
 }
 
 
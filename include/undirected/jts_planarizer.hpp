@@ -1,6 +1,7 @@
 #ifndef _WAILEA_UNDIRECTED_JTS_PLANARIZER_HPP_
 #define _WAILEA_UNDIRECTED_JTS_PLANARIZER_HPP_
 #include "undirected/base.hpp"
+#include "undirected/element_pool.hpp"
 #include "undirected/planarizable_graph.hpp"
 /**
  * @file undirected/jts_planarizer.hpp
@@ -110,7 +111,7 @@ class JTSGraph : public Graph {
  * @brief the input graph edges are augumented to this class internally
  *        to be processed by JTSPlanarizer.
  */
-class JTSGraphEdge : public Edge {
+class JTSGraphEdge : public Edge, public PooledElement {
 
   public:
 
@@ -131,7 +132,7 @@ class JTSGraphEdge : public Edge {
  * @brief the input graph nodes are augumented to this class internally
  *        to be processed by JTSPlanarizer.
  */
-class JTSGraphNode : public Node {
+class JTSGraphNode : public Node, public PooledElement {
 
   public:
 
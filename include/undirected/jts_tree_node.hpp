@@ -2,6 +2,7 @@
 #define _WAILEA_UNDIRECTED_JTS_TREE_NODE_HPP_
 
 #include "undirected/base.hpp"
+#include "undirected/element_pool.hpp"
 
 /**
  * @file undirected/jts_tree_node.hpp
@@ -26,7 +27,7 @@ class JTSTree;
  *
  * @brief represents a PQ-tree node.
  */
-class JTSTreeNode : public Node {
+class JTSTreeNode : public Node, public PooledElement {
 
   public:
 
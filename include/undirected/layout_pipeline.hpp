@@ -0,0 +1,143 @@
+#ifndef _WAILEA_UNDIRECTED_LAYOUT_PIPELINE_HPP_
+#define _WAILEA_UNDIRECTED_LAYOUT_PIPELINE_HPP_
+
+#include <cstddef>
+
+#include "undirected/base.hpp"
+#include "undirected/planarizable_graph.hpp"
+#include "undirected/vis_rep_finder.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+/**
+ * @file undirected/layout_pipeline.hpp
+ *
+ * @brief lays out a connected undirected graph with labels as a visibility
+ *        representation in memory.
+ *
+ * @details
+ *    This runs the same steps as the chain of the command-line tools
+ *    decomposer, planarizer, biconnected_embedding_finder, and
+ *    vis_rep_finder, without the serialization of the intermediate
+ *    results.
+ *
+ *    1. The input graph is decomposed into the blocks, and each block is
+ *       planarized by JTS_BL_GMW_Planarizer. The blocks are processed
+ *       concurrently by worker threads.
+ *
+ *    2. The planarized graph is copied into a VRRectLabelGraph.
+ *       Each crossing becomes a virtual node with the label of
+ *       (2 * horizontal gap) x (2 * vertical gap).
+ *       Each original edge becomes a chain of edges from its node 1 to its
+ *       node 2. The first edge of the chain gets the label on the node 1
+ *       side, the last one gets the label on the node 2 side, and the
+ *       ((number of edges - 1) / 2)-th one gets the middle label.
+ *
+ *    3. A planar embedding of each block is found, and the embeddings are
+ *       unified at each cut vertex into the biggest faces by
+ *       EmbeddedBCTree::makeDefaultEmbedding(). The blocks are embedded
+ *       concurrently if more than one thread is used.
+ *
+ *    4. The geometric embedding is fixed. If the top node is given, the
+ *       largest block that contains it becomes the root block, and the
+ *       biggest face incident to it becomes the outer face. Otherwise
+ *       EmbeddedBCTree::findGeometricEmbedding() chooses them.
+ *
+ *    5. The visibility representation is found by VisRepFinder in its
+ *       PARALLEL mode if more than one thread is used.
+ */
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+
+/** @class LayoutPipeline
+ *
+ *  @brief lays out a connected graph with labels in memory.
+ */
+class LayoutPipeline {
+
+  public:
+
+    inline LayoutPipeline():mNumThreads(1){;}
+
+    inline virtual ~LayoutPipeline(){;}
+
+    /** @brief sets the number of the worker threads used for the blocks.
+     *
+     *  @param  numThreads (in): 1 processes everything in the calling
+     *                           thread. If it is 0,
+     *                           std::thread::hardware_concurrency() is used.
+     */
+    inline void setNumThreads(size_t numThreads) { mNumThreads = numThreads; }
+
+    /** @brief lays out the given connected graph.
+     *
+     *  @param  G       (in):  connected simple graph of VRRectLabelNodes and
+     *                         VRRectLabelEdges with the labels and the
+     *                         gaps set.
+     *
+     *  @param  LG      (out): planarized copy of G with the coordinates
+     *                         found. It must be empty.
+     *
+     *  @param  topNode (in):  node in G placed at the top of the drawing.
+     *                         If it is G.nodes().second, it is chosen
+     *                         automatically.
+     *
+     *  @throw  std::invalid_argument(Constants::kExceptionNotEmpty)
+     *          if LG is not empty.
+     *
+     *  @remark on inter-graph links. After the call, G and LG are
+     *          interconnected as follows.
+     *          - The IGBackwardLink of a non-virtual node in LG points to
+     *            the node in G, and that of a virtual node points to
+     *            G.nodes().second.
+     *          - The IGBackwardLink of an edge in LG points to the original
+     *            edge in G.
+     *          - The top of the IGForwardLink stack of a node in G points
+     *            to the node in LG, and that of an edge in G points to the
+     *            first edge of its chain in LG.
+     */
+    void layout(
+        VRRectLabelGraph& G,
+        VRRectLabelGraph& LG,
+        node_list_it_t    topNode
+    );
+
+    void layout(VRRectLabelGraph& G, VRRectLabelGraph& LG);
+
+  private:
+
+    /** @brief copies the planarized graph into LG and distributes the
+     *         labels of the original edges over the chains.
+     *
+     *  @param  G  (in):  original graph
+     *
+     *  @param  PG (in):  planarized graph of G
+     *
+     *  @param  LG (out): copy of PG
+     */
+    void copyPlanarizedGraph(
+        VRRectLabelGraph&  G,
+        PlanarizableGraph& PG,
+        VRRectLabelGraph&  LG
+    );
+
+    /** @brief number of the worker threads */
+    size_t mNumThreads;
+
+#ifdef UNIT_TESTS
+friend class LayoutPipelineTests;
+#endif
+};
+
+
+}// namespace Undirected
+
+}// namespace Wailea
+
+#endif /*_WAILEA_UNDIRECTED_LAYOUT_PIPELINE_HPP_*/
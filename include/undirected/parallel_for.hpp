@@ -0,0 +1,197 @@
+#ifndef _WAILEA_UNDIRECTED_PARALLEL_FOR_HPP_
+#define _WAILEA_UNDIRECTED_PARALLEL_FOR_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file undirected/parallel_for.hpp
+ *
+ * @brief fork/join of worker threads shared by the parallel modes of the
+ *        algorithms.
+ *
+ * @details
+ *    parallelFor(numThreads, fn) calls fn(t) for t = 0, ..., numThreads-1,
+ *    each on its own thread, and returns when all of them have returned.
+ *    fn(0) is called on the calling thread, and numThreads-1 threads are
+ *    created for the rest. If numThreads is 1 or less, fn(0) is just
+ *    called, and no thread is created.
+ *    An exception thrown by fn(t) is caught on its thread. After all the
+ *    threads have been joined, the one from the lowest t is rethrown.
+ *    fn is responsible for letting the other workers finish if they wait
+ *    for each other.
+ *    The threads wait at a start gate until all of them have been created.
+ *    If a thread can not be created, the gate is closed, the threads
+ *    already created return without calling fn, and the std::system_error
+ *    is rethrown after they have been joined. fn is not called at all in
+ *    that case, and the workers that use a WorkerBarrier for numThreads
+ *    threads are never left waiting for the missing ones.
+ *
+ *    numWorkerThreads(numThreads, numTasks) resolves the number of the
+ *    threads set by the user: 0 means std::thread::hardware_concurrency(),
+ *    and the result is clamped to [1, numTasks].
+ *
+ *    WorkerBarrier lets the workers of a parallelFor() run several phases
+ *    in the same threads. No worker passes wait() until all of them have
+ *    called it.
+ */
+
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+/** @brief returns the number of the worker threads to use.
+ *
+ *  @param  numThreads  (in): number of the threads requested. 0 means
+ *                            std::thread::hardware_concurrency().
+ *
+ *  @param  numTasks    (in): number of the independent tasks. No more
+ *                            threads than this are used.
+ *
+ *  @return number of the threads in [1, numTasks], or 1 if numTasks is 0.
+ */
+inline size_t numWorkerThreads(size_t numThreads, size_t numTasks)
+{
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+    }
+    return std::max(size_t(1), std::min(numThreads, numTasks));
+}
+
+
+/** @brief calls fn(t) for each t in [0, numThreads) on its own thread,
+ *         and waits for all of them.
+ *
+ *  @param  numThreads  (in): number of the threads including the calling
+ *                            thread.
+ *
+ *  @param  fn          (in): callable taking the thread index as size_t.
+ *
+ *  @throws the exception thrown by fn(t) of the lowest t, if any.
+ *
+ *  @throws std::system_error if a thread can not be created. fn has not
+ *          been called.
+ */
+template<class FUNC>
+void parallelFor(size_t numThreads, FUNC fn)
+{
+    if (numThreads <= 1) {
+        fn(size_t(0));
+        return;
+    }
+
+    vector<exception_ptr> errors(numThreads);
+    auto worker = [&](size_t t) {
+        try {
+            fn(t);
+        }
+        catch (...) {
+            errors[t] = current_exception();
+        }
+    };
+
+    // 0: not open yet, 1: open, 2: closed.
+    mutex              gateMutex;
+    condition_variable gateCond;
+    int                gate = 0;
+    auto gatedWorker = [&](size_t t) {
+        {
+            unique_lock<mutex> lock(gateMutex);
+            gateCond.wait(lock, [&]{ return gate != 0; });
+            if (gate == 2) {
+                return;
+            }
+        }
+        worker(t);
+    };
+    auto openGate = [&](int state) {
+        {
+            lock_guard<mutex> lock(gateMutex);
+            gate = state;
+        }
+        gateCond.notify_all();
+    };
+
+    vector<std::thread> threads;
+    try {
+        threads.reserve(numThreads - 1);
+        for (size_t t = 1; t < numThreads; t++) {
+            threads.emplace_back(gatedWorker, t);
+        }
+    }
+    catch (...) {
+        openGate(2);
+        for (auto& th : threads) {
+            th.join();
+        }
+        throw;
+    }
+    openGate(1);
+    worker(0);
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    for (auto& e : errors) {
+        if (e != nullptr) {
+            rethrow_exception(e);
+        }
+    }
+}
+
+
+/** @class WorkerBarrier
+ *
+ *  @brief reusable barrier at which the worker threads wait for each
+ *         other.
+ */
+class WorkerBarrier {
+
+  public:
+
+    /** @brief constructor
+     *
+     *  @param  numThreads  (in): number of the threads that call wait()
+     *                            at each phase.
+     */
+    inline WorkerBarrier(size_t numThreads):
+        mNumThreads(numThreads),
+        mNumWaiting(0),
+        mGeneration(0){;}
+
+    /** @brief blocks until all the threads have called wait().
+     */
+    inline void wait() {
+        unique_lock<mutex> lock(mMutex);
+        size_t generation = mGeneration;
+        mNumWaiting++;
+        if (mNumWaiting == mNumThreads) {
+            mNumWaiting = 0;
+            mGeneration++;
+            mCond.notify_all();
+        }
+        else {
+            mCond.wait(lock, [&]{ return generation != mGeneration; });
+        }
+    }
+
+  private:
+
+    mutex              mMutex;
+    condition_variable mCond;
+    size_t             mNumThreads;
+    size_t             mNumWaiting;
+    size_t             mGeneration;
+};
+
+}// namespace Undirected
+
+}// namespace Wailea
+
+#endif /*_WAILEA_UNDIRECTED_PARALLEL_FOR_HPP_*/
@@ -8,6 +8,7 @@
 #include <exception>
 
 #include "undirected/base.hpp"
+#include "undirected/element_pool.hpp"
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -123,7 +124,7 @@ class EmbeddedGraph : public Graph {
  *
  *  @brief represents a copied node in EmbeddedGraph.
  */
-class EmbeddedNode : public Node {
+class EmbeddedNode : public Node, public PooledElement {
 
 #ifdef UNIT_TESTS
 public:
@@ -224,7 +225,7 @@ private:
  *         It contains two half edges in the opposite direction of each other.
  *         It points to the corresponding dual edge in the dual graph.
  */
-class EmbeddedEdge : public Edge {
+class EmbeddedEdge : public Edge, public PooledElement {
 
 public:
     /** @brief directed half edge 1
@@ -269,7 +270,7 @@ class DualGraph : public Graph {
  *         The incident dual edge list is ordered in accordance with the
  *         surrounding half edges.
  */
-class EmbeddedFace : public Node {
+class EmbeddedFace : public Node, public PooledElement {
 public:
     /** @brief ordered list of surrounding half edges in EmbeddedGraph.
      *         the order is aligned with the order if incident dual edge list
@@ -299,7 +300,7 @@ public:
  *         It contains a pointer to the corresponding edge to an EmbeddedEdge
  *         in EmbeddedGraph.
  */
-class DualEdge : public Edge {
+class DualEdge : public Edge, public PooledElement {
 
 public:
 
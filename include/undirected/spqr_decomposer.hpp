@@ -15,7 +15,6 @@
 #include "undirected/spqr_proc1.hpp"
 #include "undirected/spqr_proc2.hpp"
 #include "undirected/spqr_proc3.hpp"
-#include "undirected/spqr_proc4.hpp"
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -86,7 +85,7 @@
  *                defines->SPQR_DFS_Node
  *                defines->SPQR_DFS_Edge
  *
- *                owns->DFSExplorer<Graph,SPQR_DFS_Node,SPQR_DFS_Edge>
+ *                owns->StaticDFSExplorer<Graph,SPQR_DFS_Node,SPQR_DFS_Edge>
  *                        explores->DFSGraph<Graph,SPQR_DFS_Node,SPQR_DFS_Edge>
  *                                  owns->DFSGraph<SPQR_DFS_Node,SPQR_DFS_Edge>
  *                                  owns->DFSGraph<SPQR_DFS_Node,SPQR_DFS_Edge>
@@ -806,20 +805,17 @@ class SPQRDecomposer {
     void calculatePhi(SPQR_DFS_Edge&e);
 
 
-    /** @brief creates an internal copy of the input SPQRTree for DFS 
-     *         exploration.
+    /** @brief merges the adjacent S nodes and the adjacent P nodes in
+     *         the tree in the DFS order from the first tree node.
      *
-     *  @param tree (in): the input graph whose copy is created.
+     *  @param tree (in/out): SPQR tree whose node types have been
+     *                        determined.
      *
-     *  @param copiedGraph (in): copy of the spqr tree for DFS Proc4.
+     *  @remarks the tree edges are listed first with an explicit stack,
+     *           and then the merges are performed directly on the tree
+     *           without making a copy of it for the exploration.
      */
-    void copySPQRTree(SPQRTree& tree, Graph& copiedGraph);
-
-
-    /** @brief helper to copySPQRTree(). Converts the type of SPQR_TREE_Node to
-     *         the same type of SPQR_PROC4_Node.
-     */
-    SPQR_PROC4_Node::type convertNodeType(node_list_it_t nit);
+    void mergeSPNodes(SPQRTree& tree);
 
 
     /** @brief merges the clusters of S and P types and form a proper 
@@ -8,6 +8,7 @@
 #include <exception>
 
 #include "undirected/base.hpp"
+#include "undirected/element_pool.hpp"
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -27,7 +28,7 @@ class SPQR_DFS_Edge;
  *         This class is augumented to DFSNode<SPQR_DFS_Node,SPQR_DFS_Edge>
  *         for DFSExplorer<Grah,SPQR_DFS_Node,SPQR_DFS_Edge>.
  */
-class SPQR_DFS_Node : public Node {
+class SPQR_DFS_Node : public Node, public PooledElement {
 
   public:
     inline SPQR_DFS_Node():mNum(0),mLowPt1(0),mLowPt2(0),mNd(0){;}
@@ -62,13 +63,11 @@ class SPQR_DFS_Node : public Node {
 
     /** @brief the adjacency order for DFS Proc 2.
      */
-    list<edge_list_it_t> mOrderedAdjacencyType1;
-    list<edge_list_it_t> mOrderedAdjacencyType1Back;
+    vector<edge_list_it_t> mOrderedAdjacencyType1;
 
     /** @brief the adjacency order for DFS Proc 3.
      */
-    list<edge_list_it_t> mOrderedAdjacencyType2;
-    list<edge_list_it_t> mOrderedAdjacencyType2Back;
+    vector<edge_list_it_t> mOrderedAdjacencyType2;
 
     /** @brief the list of adjacent nodes of the indicent fronds
      *         in the reverse orientation.
@@ -97,7 +96,7 @@ class SPQR_DFS_Node : public Node {
  *         This class is augumented to DFSNode<SPQR_DFS_Node,SPQR_DFS_Edge>
  *         for DFSExplorer<Grah,SPQR_DFS_Node,SPQR_DFS_Edge>.
  */
-class SPQR_DFS_Edge : public Edge {
+class SPQR_DFS_Edge : public Edge, public PooledElement {
 
   public:
     enum type {
@@ -138,7 +137,7 @@ inline SPQR_DFS_Edge& SPQR_DFS_Node::adjacentEdge(SPQR_DFS_Edge& e){
     }
     auto itPair = this->incidentEdges();
     for(auto it = itPair.first ; it != itPair.second; it++) {
-        SPQR_DFS_Edge& a = dynamic_cast<SPQR_DFS_Edge&>(*(*(*it)));
+        SPQR_DFS_Edge& a = downcast<SPQR_DFS_Edge>(*(*(*it)));
         if (&a !=  &e) {
             return a;
         }
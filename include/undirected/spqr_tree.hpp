@@ -6,6 +6,7 @@
 #include <list>
 #include <vector>
 #include <exception>
+#include <unordered_map>
 
 #include "undirected/base.hpp"
 #include "undirected/dfs.hpp"
@@ -47,6 +48,14 @@ class SPQRComponentEdge;
  *           A SPQRTreeNode has a component SPQRComponent as a copy of the
  *           subgraph of the original graph.
  *
+ *  @remarks on the updates
+ *           insertEdge() and subdivideEdge() keep the tree in step with
+ *           an original graph that only grows. Edges can not be deleted.
+ *           This is not a dynamic planarizer. No embedding is kept, and
+ *           the GMW planarizer still makes a new decomposition for each
+ *           edge, as its skeletons and dual graph take O(|E|) per edge
+ *           anyway.
+ *
  */
 class SPQRTree : public Graph {
 
@@ -240,8 +249,113 @@ class SPQRTree : public Graph {
                      SPQRTreeNode& nodeTo, SPQRComponentEdge& newVirtualEdge);
 
 
+    /** @brief updates the tree for an edge that has been added to the
+     *         original graph between two existing nodes.
+     *
+     *  @param eit (in): the new edge in the original graph.
+     *
+     *  @throws invalid_argument(Constants::kExceptionNodeNotInGraph)
+     *          if an incident node of the edge is not in the tree.
+     *
+     *  @remarks
+     *     The tree is restructured by the cases in [DT96]. If a tree node
+     *     has both the incident nodes, the edge is added to the P node,
+     *     or a new P node is made for the separation pair, or an S node is
+     *     split into two S nodes and a P node, or the edge is added to the
+     *     R node. Otherwise the tree nodes on the shortest path between
+     *     the nodes that have the incident nodes are merged into one new R
+     *     node. The parts of the S and P nodes on the path that are not
+     *     on the new cycles are left in new S and P nodes.
+     *     The forward link and the utility of the edge are pushed in the
+     *     same way as SPQRDecomposer::decompose(). Those of the existing
+     *     edges in the affected components are updated in place.
+     *
+     *  @remarks on complexity:
+     *     The first call makes an index from the original nodes to the
+     *     component nodes in O(|E|). After that, it runs in the order of
+     *     the tree nodes visited to find the path plus the sizes of the
+     *     components of the tree nodes restructured.
+     *     The path is found by a breadth-first search on the tree, which
+     *     may visit all the tree nodes. The logarithmic bound of [DT96]
+     *     needs the dynamic trees on the SPQR tree, which are not kept.
+     *
+     *     [DT96] Di Battista, Giuseppe; Tamassia, Roberto (1996), "On-line
+     *     maintenance of triconnected components with SPQR-trees",
+     *     Algorithmica 15 (4): 302-318, doi:10.1007/BF01961541
+     */
+    void insertEdge(edge_list_it_t eit);
+
+
+    /** @brief updates the tree for a node that has been inserted on an
+     *         edge in the original graph.
+     *
+     *  @param eit  (in): the edge {A,B} in the original graph that is
+     *                    being subdivided. It must be still in the
+     *                    original graph. The caller removes it after this
+     *                    call.
+     *
+     *  @param eit1 (in): the new edge {A,X} in the original graph.
+     *
+     *  @param eit2 (in): the new edge {X,B} in the original graph.
+     *
+     *  @remarks if the edge is in an S node, the cycle is extended.
+     *           Otherwise, it is replaced with a virtual edge to a new S
+     *           node of the triangle {A,X,B}.
+     */
+    void subdivideEdge(
+               edge_list_it_t eit, edge_list_it_t eit1, edge_list_it_t eit2);
+
+
   private:
 
+    /** @brief makes the index from the original nodes to the component
+     *         nodes if it has not been made yet.
+     */
+    void buildAllocations();
+
+    /** @brief returns the component node in the tree node for the given
+     *         original node. It is created if it does not exist.
+     */
+    node_list_it_t componentNode(SPQRTreeNode& tn, node_list_it_t orgNit);
+
+    /** @brief adds a new tree node with an empty component.
+     *         The type is set by the caller.
+     */
+    SPQRTreeNode& addTreeNode();
+
+    /** @brief removes the tree node and its component, and updates the
+     *         index. The incident tree edges are removed.
+     */
+    void removeTreeNode(SPQRTreeNode& tn);
+
+    /** @brief adds an ordinary edge to the component of the tree node,
+     *         and points the forward link of the original edge to it.
+     */
+    void addOrdinaryEdge(SPQRTreeNode& tn, edge_list_it_t orgEit);
+
+    /** @brief makes a copy of the component edge of one tree node in
+     *         another. If it is virtual, its pair and the tree edge are
+     *         relinked to the copy. The edge in nodeFrom is left as it is.
+     */
+    void transferEdge(SPQRComponentEdge& ce, SPQRTreeNode& nodeFrom,
+                                                       SPQRTreeNode& nodeTo);
+
+    /** @brief adds the virtual edges {A,B} to the components of two tree
+     *         nodes, and a tree edge between them.
+     */
+    void addVirtualPair(SPQRTreeNode& tn1, SPQRTreeNode& tn2,
+                              node_list_it_t orgNitA, node_list_it_t orgNitB);
+
+    /** @brief moves the given edges between A and B of a tree node to
+     *         another. If there are more than one edge, they are moved to
+     *         a new S node if series is true, or a new P node otherwise,
+     *         and it is linked with a virtual edge {A,B}.
+     */
+    void condenseEdges(SPQRTreeNode& nodeFrom, SPQRTreeNode& nodeTo,
+                   vector<edge_list_it_t>& edges, bool series,
+                   node_list_it_t orgNitA, node_list_it_t orgNitB);
+
+
     /** @brief fill the empty component of the newly create SPQR tree node
      *         with the split components.
      *  
@@ -286,6 +400,15 @@ class SPQRTree : public Graph {
      */
     Graph* mOriginal;
 
+    /** @brief index from the original nodes to the component nodes,
+     *         made by the first call to insertEdge() or subdivideEdge().
+     */
+    unordered_map<const Node*, vector<node_list_it_t>> mAllocations;
+
+    /** @brief true if mAllocations has been made.
+     */
+    bool   mAllocationsBuilt;
+
 #ifdef UNIT_TESTS
   friend class SPQRTreeTests;
   friend class GMWSkeletonTests;
@@ -667,26 +790,32 @@ inline SPQRComponent& SPQRComponent::operator=(SPQRComponent&& rhs) noexcept {
 
 
 inline SPQRTreeNode& SPQRComponent::SPQRTreeNode() const {
-    return dynamic_cast<class SPQRTreeNode&>(*(*(mTreeNode)));
+    return downcast<class SPQRTreeNode>(*(*(mTreeNode)));
 }
 
 
 inline void SPQRComponent::setBackLink(node_list_it_t it) noexcept 
                                                            { mTreeNode = it; }
 
-inline SPQRTree::SPQRTree(Graph& original) noexcept : mOriginal(&original){;}
+inline SPQRTree::SPQRTree(Graph& original) noexcept :
+                             mOriginal(&original), mAllocationsBuilt(false){;}
 
 
 inline SPQRTree::~SPQRTree() noexcept {;}
 
 
 inline SPQRTree::SPQRTree(SPQRTree&& rhs) noexcept :
-                                 Graph(move(rhs)), mOriginal(rhs.mOriginal){;}
+                                 Graph(move(rhs)),
+                                 mOriginal(rhs.mOriginal),
+                                 mAllocations(move(rhs.mAllocations)),
+                                 mAllocationsBuilt(rhs.mAllocationsBuilt){;}
 
 inline SPQRTree& SPQRTree::operator=(SPQRTree&& rhs) noexcept
 {
     Graph::operator = (move(rhs));
     mOriginal = move(rhs.mOriginal);
+    mAllocations      = move(rhs.mAllocations);
+    mAllocationsBuilt = rhs.mAllocationsBuilt;
     return *this;
 }
 
@@ -739,7 +868,7 @@ inline SPQRComponentEdge& SPQRComponentEdge::pairVirtualEdge() const {
     if (mType != VirtualType) {
         throw std::invalid_argument(Constants::kExceptionWrongType);
     }
-    return dynamic_cast<SPQRComponentEdge&>(*(*mVirtualPairEdge));
+    return downcast<SPQRComponentEdge>(*(*mVirtualPairEdge));
 }
 
 
@@ -747,7 +876,7 @@ inline SPQRTreeNode& SPQRComponentEdge::pairTreeNode() const {
     if (mType != VirtualType) {
         throw std::invalid_argument(Constants::kExceptionWrongType);
     }
-    return dynamic_cast<SPQRTreeNode&>(*(*mVirtualPairTreeNode));
+    return downcast<SPQRTreeNode>(*(*mVirtualPairTreeNode));
 }
 
 
@@ -759,7 +888,7 @@ inline SPQRTreeEdge& SPQRComponentEdge::treeEdge() const {
     if (mType != VirtualType) {
         throw std::invalid_argument(Constants::kExceptionWrongType);
     }
-    return dynamic_cast<SPQRTreeEdge&>(*(*mTreeEdge));
+    return downcast<SPQRTreeEdge>(*(*mTreeEdge));
 }
 
 }// namespace Undirected
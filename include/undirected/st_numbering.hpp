@@ -8,6 +8,8 @@
 #include <exception>
 
 #include "undirected/base.hpp"
+#include "undirected/compact_graph.hpp"
+#include "undirected/element_pool.hpp"
 #include "undirected/dfs.hpp"
 #include "undirected/spqr_dfs_elements.hpp"
 
@@ -265,7 +267,7 @@ using namespace std;
  *         This class is augumented to DFSNode<ST_DFS_Node,ST_DFS_Edge>
  *         for DFSExplorer<Graph,ST_DFS_Node,ST_DFS_Edge>.
  */
-class ST_DFS_Node : public Node {
+class ST_DFS_Node : public Node, public PooledElement {
 
   public:
     inline ST_DFS_Node():mPre(0),mLow(0),mSignPlus(false){;}
@@ -309,7 +311,7 @@ class ST_DFS_Node : public Node {
  *         This class is augumented to DFSNode<ST_DFS_Node,ST_DFS_Edge>
  *         for DFSExplorer<Grah,ST_DFS_Node,ST_DFS_Edge>.
  */
-class ST_DFS_Edge : public Edge {
+class ST_DFS_Edge : public Edge, public PooledElement {
 
   public:
     enum type {
@@ -336,6 +338,17 @@ class ST_DFS_Edge : public Edge {
  *          in a vertex list.
  *          
  *  @details 
+ *      The two DFS steps run on CompactGraph with the palm tree, the
+ *      pre-order numbers, the low points, and the list L held in arrays
+ *      indexed by the node indices. Each step is a loop over the
+ *      incidence ranges without a recursion.
+ *      Since the second DFS follows the same tree arcs in the same order as
+ *      the first, it is performed as a scan of the nodes in the pre-order.
+ *      getBipolarOrientation() on a Graph builds a CompactGraph of it,
+ *      which keeps the incidence order. The result depends only on the
+ *      incidence order, and it is the same as the one by DFSExplorer with
+ *      ST_DFS_Node and ST_DFS_Edge.
+ *
  *      Complexities:
  *        It uses heap memory in the order of O(|N|+|E|).
  *        It runs in the order of  O(|N|+|E|).
@@ -371,21 +384,21 @@ class STNumbering {
      */
     vector<node_list_it_t> getBipolarOrientation(Graph& g, Node& s, Node& t);
 
-  private:
-
-    /** @brief   creates a copy of the input graph for DFS exploration.
+    /** @brief generates bipolar orientation on a CompactGraph.
      *
-     *  @param   src (in):  the input graph whose copy is created.
-     *  @param   dst (out): the copy graph to which nodes and edges are added.
-     *  @param   startNode (in): the start node in the input graph.
+     *  @param   g (in): input graph. It must be simple and biconnected.
+     *  @param   s (in): index of the source node
+     *  @param   t (in): index of the destination node
+     *
+     *  @return  indices of the nodes in the bipolar orientation from s to t.
      *
-     *  @return  the start node in the copied graph.
+     *  @remark  The conditions on g are the same as the ones on Graph
+     *           above.
      */
-    void copyInputGraph(
-            Graph& src,           Graph& dst, 
-            node_list_it_t srcIt, node_list_it_t& srcCopyIt, 
-            node_list_it_t dstIt, node_list_it_t& dstCopyIt );
+    vector<cg_index_t> getBipolarOrientation(
+                         const CompactGraph& g, cg_index_t s, cg_index_t t);
 
+  private:
 
 #ifdef UNIT_TESTS
   friend class STNumberingTests;
@@ -0,0 +1,258 @@
+#ifndef _WAILEA_UNDIRECTED_STATIC_DFS_HPP_
+#define _WAILEA_UNDIRECTED_STATIC_DFS_HPP_
+
+#include <type_traits>
+#include <vector>
+
+#include "undirected/base.hpp"
+#include "undirected/dfs.hpp"
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/** @file  undirected/static_dfs.hpp
+ *
+ *  @brief DFS explorer with the strategy given as a template parameter.
+ *
+ *  StaticDFSExplorer walks the graph in exactly the same way as
+ *  DFSExplorer, and calls the same hook functions of DFSStrategy at the
+ *  same points. The differences are the following.
+ *
+ *  - The strategy class is a template parameter, and the hook functions
+ *    are called with the qualified names such as STRATEGY::enterNode().
+ *    The calls are bound at compile time and they can be inlined if the
+ *    strategy is defined in the same translation unit, instead of going
+ *    through the vtable on every step.
+ *
+ *  - The DFS stack is held in a vector of the nodes in the explorer,
+ *    instead of following DFSNode::parentInDFS() back to the parent
+ *    through the node list iterators. The vector is reserved for all the
+ *    nodes before the exploration.
+ *
+ *  - The whole exploration runs in one loop in run() instead of calling
+ *    oneStep() per step.
+ *
+ *  The visited flags and the current incident edges stay in DFSNode and
+ *  DFSEdge, as the strategies read and update them during the exploration.
+ *  (E.g., SPQRStrategyProc3 calls DFSNode::setNextDFSEdge() and adds new
+ *  visited edges to the graph.)
+ *
+ *  The implementation is in this header as the strategies of the DFS-based
+ *  algorithms are local to their translation units.
+ *
+ *  Usage
+ *
+ *      MyStrategy strategy;
+ *      StaticDFSExplorer<Graph,MyNode,MyEdge,MyStrategy> explorer(g,strategy);
+ *      explorer.reset(g);
+ *      explorer.run(startNode);
+ */
+namespace Wailea {
+
+namespace Undirected {
+
+/** @class StaticDFSExplorer
+ *
+ *  @brief performs depth-first exploration of the given graph from
+ *         the specified node with the statically bound strategy.
+ *
+ *  @remark STRATEGY must be derived from
+ *          DFSStrategy<BASE_GRAPH,BASE_NODE,BASE_EDGE>.
+ */
+template <class BASE_GRAPH, class BASE_NODE, class BASE_EDGE, class STRATEGY>
+class StaticDFSExplorer {
+
+    using DGraph    = DFSGraph<BASE_GRAPH,BASE_NODE,BASE_EDGE>;
+    using DEdge     = DFSEdge<BASE_GRAPH,BASE_NODE,BASE_EDGE>;
+    using DNode     = DFSNode<BASE_GRAPH,BASE_NODE,BASE_EDGE>;
+    using DStrategy = DFSStrategy<BASE_GRAPH,BASE_NODE,BASE_EDGE>;
+
+    static_assert(std::is_base_of<DStrategy, STRATEGY>::value,
+                                 "STRATEGY must be derived from DFSStrategy");
+
+  public:
+
+    /** @brief  default constructor is prohibited.
+     */
+    StaticDFSExplorer()=delete;
+
+
+    /** @brief  constructor
+     *
+     *  @param  g        (in): graph in which the DFS exploration is performed.
+     *
+     *          strategy (in): collection of routines for the DFS performed at
+     *                         the specific hooking points.
+     */
+    inline StaticDFSExplorer(DGraph& g, STRATEGY& s):mG(g),mStrategy(s){;}
+
+    virtual ~StaticDFSExplorer(){;}
+
+
+    /** @brief  inizialize all the nodes and edges in the given graph
+     *          before performing DFS.
+     *
+     *  @param  g  (in): graph whose nodes and edges are initialized.
+     */
+    inline void reset(DGraph& g) noexcept;
+
+
+    /** @brief  performs a DFS from a given node.
+     *
+     *  @param  st       (in): the starting node from which the DFS is
+     *                         performed.
+     *
+     *  @throws  any exception that the accompanying strategy's hook
+     *           functions can throw.
+     *
+     *  @remarks the hook functions are called in the same order as
+     *           DFSExplorer::run().
+     *
+     *  @remarks on complexity:
+     *           this function runs in O(|N|+|E|). It uses O(|N|) extra
+     *           memory for the DFS stack.
+     */
+    inline void run(DNode& st);
+
+  private:
+
+    /** @brief DFSGraph object in which DFS is performed.
+     */
+    DGraph&        mG;
+
+    /** @brief strategy whose functions are called during a DFS.
+     */
+    STRATEGY&      mStrategy;
+
+    /** @brief DFS stack. The top is the node currently explored.
+     */
+    std::vector<DNode*> mStack;
+
+#ifdef UNIT_TESTS
+  friend class DFSTests;
+#endif
+
+};
+
+
+template <class BASE_GRAPH, class BASE_NODE, class BASE_EDGE, class STRATEGY>
+void StaticDFSExplorer<BASE_GRAPH,BASE_NODE,BASE_EDGE,STRATEGY>::reset(
+    DGraph& g
+) noexcept
+{
+    auto nodeItPair = g.nodes();
+    for (auto nit = nodeItPair.first; nit != nodeItPair.second; nit++) {
+        downcast<DNode>(*(*nit)).resetForDFS();
+    }
+
+    auto edgeItPair = g.edges();
+    for (auto eit = edgeItPair.first; eit != edgeItPair.second; eit++) {
+        downcast<DEdge>(*(*eit)).resetForDFS();
+    }
+}
+
+
+template <class BASE_GRAPH, class BASE_NODE, class BASE_EDGE, class STRATEGY>
+void StaticDFSExplorer<BASE_GRAPH,BASE_NODE,BASE_EDGE,STRATEGY>::run(
+    DNode& st
+) {
+    mStack.clear();
+    mStack.reserve(mG.numNodes());
+
+    st.initExploration(mG.nodes().second);
+    mStack.push_back(&st);
+    mStrategy.resetEarlyOut();
+
+    // The body corresponds to DFSExplorer::oneStep().
+    while (!mStack.empty()) {
+
+        DNode& currentNode = *(mStack.back());
+
+        if ( !currentNode.isVisited() ) {
+
+            // It has just entered this node.
+            mStrategy.STRATEGY::enterNode(currentNode);
+            currentNode.setVisited();
+            currentNode.resetWaitingForChild();
+
+        }
+        else if (currentNode.isWaitingForChild()) {
+
+            // It has come back from the last child.
+            mStrategy.STRATEGY::afterVisitingChild(
+                                   currentNode, currentNode.currentDFSEdge());
+            currentNode.resetWaitingForChild();
+            currentNode.advanceDFSEdge();
+
+        }
+        else if (currentNode.hasExploredAllEdges()) {
+
+            // There is no more unexplored edge.
+            mStrategy.STRATEGY::leaveNode(currentNode);
+
+            // Going back to the parent node.
+            mStack.pop_back();
+
+        }
+        else {
+
+            DEdge& currentEdge = currentNode.currentDFSEdge();
+
+            if (currentEdge.isVisited()) {
+
+                // The edge has been already processed as a frond
+                // when the adjacent node was explored. Skipping.
+                currentNode.advanceDFSEdge();
+
+            }
+            else {
+
+                DNode& adjacentNode = currentEdge.adjacentDFSNode(currentNode);
+
+                if (adjacentNode.isVisited()) {
+
+                    // The current edge is a frond.
+                    // See DFSExplorer::oneStep() for setWaitingForChild().
+                    currentNode.setWaitingForChild();
+                    mStrategy.STRATEGY::processFrond(currentNode, currentEdge);
+                    currentNode.resetWaitingForChild();
+
+                    currentEdge.setVisited();
+                    currentNode.advanceDFSEdge();
+
+                }
+                else if (mStrategy.STRATEGY::isVisitingChild(
+                                                 currentNode, currentEdge)) {
+
+                    currentNode.setWaitingForChild();
+                    mStrategy.STRATEGY::beforeVisitingChild(
+                                                     currentNode, currentEdge);
+                    currentEdge.setVisited();
+
+                    // Going to the adjacent node at the next iteration.
+                    adjacentNode.initExploration(currentNode.backIt());
+                    mStack.push_back(&adjacentNode);
+
+                }
+                else {
+
+                    mStrategy.STRATEGY::notVisitingChild(
+                                                     currentNode, currentEdge);
+                    currentNode.advanceDFSEdge();
+                }
+            }
+        }
+
+        if (mStrategy.isEarlyOut()) {
+            break;
+        }
+    }
+}
+
+}// namespace Undirected
+
+}// namespace Wailea
+
+#endif /*_WAILEA_UNDIRECTED_STATIC_DFS_HPP_*/
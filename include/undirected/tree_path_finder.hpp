@@ -8,6 +8,7 @@
 #include <exception>
 
 #include "undirected/base.hpp"
+#include "undirected/element_pool.hpp"
 #include "undirected/dfs.hpp"
 
 #ifdef UNIT_TESTS
@@ -26,7 +27,7 @@
  *        defines->TreePathFinderStrategy
  *        defines->TPF_DFS_Node
  *        defines->TPF_DFS_Edge
- *        owns->DFSExplorer<Graph,TPF_DFS_Node,TPF_DFS_Edge>
+ *        owns->StaticDFSExplorer<Graph,TPF_DFS_Node,TPF_DFS_Edge>
  *        owns->SPQRStrategy<Graph,TPF_DFS_Node,TPF_DFS_Edge>
  */
  
@@ -43,7 +44,7 @@ using namespace std;
  *         This class is augumented to DFSNode<TPF_DFS_Node,TPF_DFS_Edge>
  *         for DFSExplorer<Graph,TPF_DFS_Node, TPF_DFS_Edge>.
  */
-class TPF_DFS_Node : public Node {
+class TPF_DFS_Node : public Node, public PooledElement {
 
   public:
     /** @brief indicates the edge from which this node is being explored.
@@ -58,7 +59,7 @@ class TPF_DFS_Node : public Node {
  *         This class is augumented to DFSNode<TPF_DFS_Node,TPF_DFS_Edge>
  *         for DFSExplorer<Grah,TPF_DFS_Node,TPF_DFS_Edge>.
  */
-class TPF_DFS_Edge : public Edge {};
+class TPF_DFS_Edge : public Edge, public PooledElement {};
 
 
 /** @class  TreePathFinder
@@ -1743,15 +1743,50 @@ class VisRepFinder {
 
   public:
 
+    /** @brief how the blocks are processed in pass 1 and pass 2.
+     *
+     *  - SEQUENTIAL: one block at a time in the breadth-first order.
+     *
+     *  - PARALLEL:   the blocks are processed by worker threads as soon as
+     *                their children (pass 1) or their parent (pass 2) have
+     *                been processed. The result is identical to SEQUENTIAL,
+     *                as each block reads only the results of its children
+     *                in pass 1 and those of its parent in pass 2, and
+     *                writes only its own and, in pass 2, its children's.
+     */
+    enum executionMode {
+        SEQUENTIAL,
+        PARALLEL
+    };
+
     /** @brief constructor with the input EmbeddedBCTree
      *
      *  @param tree (in): EmbeddedBCTree as input.
      */
 #ifdef UNIT_TESTS
-    inline VisRepFinder(EmbeddedBCTree& tree):mDebugPrint(false),mEBCTree(tree){;}
+    inline VisRepFinder(EmbeddedBCTree& tree):mDebugPrint(false),mEBCTree(tree),
+        mExecutionMode(SEQUENTIAL),mNumThreads(0){;}
 #else
-    inline VisRepFinder(EmbeddedBCTree& tree):mEBCTree(tree){;}
+    inline VisRepFinder(EmbeddedBCTree& tree):mEBCTree(tree),
+        mExecutionMode(SEQUENTIAL),mNumThreads(0){;}
 #endif
+
+    /** @brief sets how the blocks are processed.
+     *
+     *  @param  mode       (in): execution mode
+     *
+     *  @param  numThreads (in): number of the worker threads for PARALLEL.
+     *                           If it is 0,
+     *                           std::thread::hardware_concurrency() is used.
+     */
+    inline void setExecutionMode(
+        enum executionMode mode,
+        size_t             numThreads = 0
+    ) {
+        mExecutionMode = mode;
+        mNumThreads    = numThreads;
+    }
+
     /** @brief main function. Generates a visibility representation.
      */
     void find();
@@ -1769,6 +1804,14 @@ class VisRepFinder {
      */        
     EmbeddedBCTree&   mEBCTree;
 
+    /** @brief how the blocks are processed in pass 1 and pass 2.
+     */
+    enum executionMode mExecutionMode;
+
+    /** @brief number of the worker threads for PARALLEL.
+     */
+    size_t            mNumThreads;
+
     /** @brief holds temporary auxiliary data structure to augument
      *         EmbeddedBCTreeNode,
      *         EmbeddedNode, EmbeddedEdge, EmbeddedFace, and DualEdge.
@@ -2302,6 +2345,19 @@ class VisRepFinder {
      */
     void performPass2TopDown();
 
+    /** @brief performs pass 1 or pass 2 with worker threads.
+     *         A block becomes ready when all of its children have been
+     *         processed in pass 1, or when its parent has been processed in
+     *         pass 2. The ready blocks are taken by the first idle worker.
+     *
+     *  @param  bottomUp (in): true for pass 1, false for pass 2.
+     */
+    void performPassInParallel(bool bottomUp);
+
+    /** @brief sets the anchor of the root block for pass 2.
+     */
+    void setRootAnchor();
+
 
     /** @brief top-level dispatch function for each node of pass 2.
      *
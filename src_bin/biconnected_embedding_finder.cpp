@@ -4,10 +4,14 @@
 #include "undirected/bl_planarity_tester.hpp"
 #include "undirected/planar_dual_graph_maker.hpp"
 #include "undirected/planarizable_graph.hpp"
+#include "undirected/batch_runner.hpp"
+#include "undirected/text_spec_reader.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
+#include <stdexcept>
 
 namespace Wailea {
 
@@ -37,9 +41,12 @@ class CommandLineBiconnectedEmbeddingFinder {
 
   public:
 
-    void parseSpec(const char* filename);
+    bool parseSpec(const char* filename);
+    bool parseSpec(std::istream& is, const char* filename);
+    bool parseSpec(TextSpecReader& reader, const char* filename);
     void generateEmbedding();
     void emitEmbeddingSpec(const char* filename);
+    void emitEmbeddingSpec(std::ostream& os);
 
     class _node {public:long n; node_list_it_t it;};
     class _edge {public:vector<long> ns; vector<edge_list_it_t> its;};
@@ -64,20 +71,16 @@ class CommandLineBiconnectedEmbeddingFinder {
         END
     };
 
-    bool isSectionHeader(std::string line, enum parseState& state);
+    bool isSectionHeader(TextSpecReader& reader, enum parseState& state);
 
-    bool isCommentLine(std::string line);
-
-    size_t splitLine(
-              const std::string& txt, std::vector<std::string>& strs, char ch);
     void handleNode(
-      std::string line, const char* filename, long lineNumber,bool& errorFlag);
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
 
     void handleVirtualNode(
-      std::string line, const char* filename, long lineNumber,bool& errorFlag);
-        
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
+
     void handleEdge(
-     std::string line, const char* filename, long lineNumber, bool& errorFlag);
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
 
     void emitError(
      const char* filename, long lineNumber, const char* mess, bool& errorFlag);
@@ -89,6 +92,12 @@ class CommandLineBiconnectedEmbeddingFinder {
     EmbeddedGraph     mEmb;
     DualGraph         mDual;
 
+    /** @brief node number to node in mG */
+    std::unordered_map<long, node_list_it_t> mNumToNode;
+
+    /** @brief node in mG to node number */
+    std::unordered_map<const Node*, long>    mNodeToNum;
+
 };
 
 const std::string CommandLineBiconnectedEmbeddingFinder::NODES = "NODES";
@@ -100,54 +109,75 @@ const std::string CommandLineBiconnectedEmbeddingFinder::
 const std::string CommandLineBiconnectedEmbeddingFinder::FACES = "FACES";
 
 
-void CommandLineBiconnectedEmbeddingFinder::parseSpec(const char* filename)
+bool CommandLineBiconnectedEmbeddingFinder::parseSpec(const char* filename)
 {
-    std::ifstream   is(filename);
-    long            lineNumber = 0;
+    TextSpecReader reader;
+    if (!reader.open(filename)) {
+        std::cerr << "Cannot open: " << filename << "\n";
+        return false;
+    }
+    return parseSpec(reader, filename);
+}
+
+
+bool CommandLineBiconnectedEmbeddingFinder::parseSpec(
+    std::istream& is,
+    const char*   filename
+) {
+    TextSpecReader reader;
+    reader.load(is);
+    return parseSpec(reader, filename);
+}
+
+
+bool CommandLineBiconnectedEmbeddingFinder::parseSpec(
+    TextSpecReader& reader,
+    const char*     filename
+) {
     bool            error      = false;
     enum parseState state      = INIT;
-    while (!is.eof() && !error) {
-        std::string line;
-        std::getline(is, line);
-        if (line.empty()) {continue;}
-        if ((line[line.size()-1] == '\n')||(line[line.size()- 1] == '\r')) {
-            line.erase(line.size() - 1);
-        }
-	lineNumber++;
-        if (isCommentLine(line)) {continue;}
-        if(isSectionHeader(line, state)){continue;}
+    while (!error && reader.nextLine()) {
+        if (reader.isBlank()) {continue;}
+        if (reader.isComment()) {continue;}
+        if(isSectionHeader(reader, state)){continue;}
         switch(state) {
           case INIT:
           case END:
-            emitError(filename, lineNumber, "", error);
+            emitError(filename, reader.lineNumber(), "", error);
             break;
           case IN_NODES:
-            handleNode(line, filename, lineNumber, error);
+            handleNode(reader, filename, error);
             break;
           case IN_VIRTUAL_NODES:
-            handleVirtualNode(line, filename, lineNumber, error);
+            handleVirtualNode(reader, filename, error);
             break;
           case IN_EDGES:
-            handleEdge(line, filename, lineNumber, error);
+            handleEdge(reader, filename, error);
             break;
         }
     }
+    return !error;
 }
 
 
 bool CommandLineBiconnectedEmbeddingFinder::isSectionHeader(
-                                      std::string line, enum parseState& state)
-{
-    if (line.compare(0, NODES.size(), NODES)==0) {
+    TextSpecReader&  reader,
+    enum parseState& state
+) {
+    if (reader.startsWith(NODES)) {
         state = IN_NODES;
+        mNodes.reserve(mNodes.size() + reader.countSectionLines());
         return true;
     }
-    else if (line.compare(0, VIRTUAL_NODES.size(), VIRTUAL_NODES)==0) {
+    else if (reader.startsWith(VIRTUAL_NODES)) {
         state = IN_VIRTUAL_NODES;
+        mVirtualNodes.reserve(
+                         mVirtualNodes.size() + reader.countSectionLines());
         return true;
     }
-    else if (line.compare(0, EDGES.size(), EDGES)==0) {
+    else if (reader.startsWith(EDGES)) {
         state = IN_EDGES;
+        mEdges.reserve(mEdges.size() + reader.countSectionLines());
         return true;
     }
 
@@ -174,102 +204,57 @@ void CommandLineBiconnectedEmbeddingFinder::emitError(
 }
 
 
-bool CommandLineBiconnectedEmbeddingFinder::isCommentLine(std::string line)
-{
-    return line.at(0) == '#';
-}
-
-
-size_t CommandLineBiconnectedEmbeddingFinder::splitLine(
-    const std::string&        txt,
-    std::vector<std::string>& strs,
-    char                      ch
-) {
-
-    auto   pos        = txt.find( ch );
-    size_t initialPos = 0;
-
-    strs.clear();
-
-    while( pos != std::string::npos && initialPos < txt.size()) {
-
-        if (pos > initialPos) {
-            strs.push_back( txt.substr( initialPos, pos - initialPos) );
-        }
-
-        initialPos = pos + 1;
-
-        if (initialPos < txt.size()) {
-            pos = txt.find( ch, initialPos );
-        }
-
-    }
-
-    if(initialPos < txt.size()) {
-        strs.push_back( txt.substr( initialPos, txt.size() - initialPos) );
-    }
-
-    return strs.size();
-}
-
-
 void CommandLineBiconnectedEmbeddingFinder::handleNode(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 1) {
-        emitError(filename, lineNumber, "Invalid Node", errorFlag);
-    }
-
     _node n;
-    n.n = std::stol(fields[0]);
+    if (reader.split() != 1 || !reader.token(0).toLong(n.n)) {
+        emitError(filename, reader.lineNumber(), "Invalid Node", errorFlag);
+        return;
+    }
     mNodes.push_back(n);
 }
 
 
 void CommandLineBiconnectedEmbeddingFinder::handleVirtualNode(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 1) {
-        emitError(filename, lineNumber, "Invalid Virtual Node", errorFlag);
-    }
-
     _node n;
-    n.n = std::stol(fields[0]);
+    if (reader.split() != 1 || !reader.token(0).toLong(n.n)) {
+        emitError(filename, reader.lineNumber(),
+                                            "Invalid Virtual Node", errorFlag);
+        return;
+    }
     mVirtualNodes.push_back(n);
 }
 
 
 void CommandLineBiconnectedEmbeddingFinder::handleEdge(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-    size_t numFields = splitLine(line, fields, ' ');
+    size_t numFields = reader.split();
 
     if (numFields < 2) {
-        emitError(filename, lineNumber, "Invalid Edge", errorFlag);
+        emitError(filename, reader.lineNumber(), "Invalid Edge", errorFlag);
+        return;
     }
 
     _edge e;
-    for (long index = 0; index < numFields; index++) {    
-        e.ns.push_back(std::stol(fields[index]));
+    e.ns.resize(numFields);
+    for (size_t index = 0; index < numFields; index++) {
+        if (!reader.token(index).toLong(e.ns[index])) {
+            emitError(filename, reader.lineNumber(), "Invalid Edge",
+                                                                  errorFlag);
+            return;
+        }
     }
-    mEdges.push_back(e);
+    mEdges.push_back(std::move(e));
 
 }
 
@@ -277,11 +262,15 @@ void CommandLineBiconnectedEmbeddingFinder::handleEdge(
 void CommandLineBiconnectedEmbeddingFinder::generateEmbedding()
 {
 
+    mNumToNode.reserve(mNodes.size() + mVirtualNodes.size());
+    mNodeToNum.reserve(mNodes.size() + mVirtualNodes.size());
     for (auto& n : mNodes) {
         auto  np  = std::make_unique<PlanarizableNode>();
         auto& nr  = dynamic_cast<PlanarizableNode&>(
                                                     mG.addNode(std::move(np)));
         n.it = nr.backIt();
+        mNumToNode.emplace(n.n, n.it);
+        mNodeToNum[&nr] = n.n;
     }
     for (auto& n : mVirtualNodes) {
         auto  np  = std::make_unique<PlanarizableNode>();
@@ -289,6 +278,8 @@ void CommandLineBiconnectedEmbeddingFinder::generateEmbedding()
                                                     mG.addNode(std::move(np)));
         n.it = nr.backIt();
         nr.setVirtual(true);
+        mNumToNode.emplace(n.n, n.it);
+        mNodeToNum[&nr] = n.n;
     }
 
     for (auto& e : mEdges) {
@@ -337,15 +328,9 @@ void CommandLineBiconnectedEmbeddingFinder::generateEmbedding()
 
 Node& CommandLineBiconnectedEmbeddingFinder::toNodeRef(long num)
 {
-    for (auto& n : mNodes) {
-        if (n.n == num) {
-            return dynamic_cast<Node&>(*(*n.it));
-        }
-    }
-    for (auto& n : mVirtualNodes) {
-        if (n.n == num) {
-            return dynamic_cast<Node&>(*(*n.it));
-        }
+    auto it = mNumToNode.find(num);
+    if (it != mNumToNode.end()) {
+        return dynamic_cast<Node&>(*(*(it->second)));
     }
     cerr << "ERROR\n";
     return dynamic_cast<Node&>(*(*(mNodes[0].it)));
@@ -354,15 +339,9 @@ Node& CommandLineBiconnectedEmbeddingFinder::toNodeRef(long num)
 
 long CommandLineBiconnectedEmbeddingFinder::toNodeNum(node_list_it_t it)
 {
-    for (auto& n : mNodes) {
-        if (n.it == it) {
-            return n.n;
-        }
-    }
-    for (auto& n : mVirtualNodes) {
-        if (n.it == it) {
-            return n.n;
-        }
+    auto nit = mNodeToNum.find((*it).get());
+    if (nit != mNodeToNum.end()) {
+        return nit->second;
     }
     cerr << "ERROR\n";
     return -1;
@@ -372,9 +351,14 @@ long CommandLineBiconnectedEmbeddingFinder::toNodeNum(node_list_it_t it)
 void CommandLineBiconnectedEmbeddingFinder::emitEmbeddingSpec(
     const char* filename
 ) {
-
     std::ofstream   os(filename);
+    emitEmbeddingSpec(os);
+}
 
+
+void CommandLineBiconnectedEmbeddingFinder::emitEmbeddingSpec(
+    std::ostream& os
+) {
     os << INCIDENCES << "\n";
     os << "#[Node Num] [Incident Node 1] ... [ Incident Node X]\n";
 
@@ -444,11 +428,30 @@ static void print_usage()
     std::cerr << "        FACES\n";
     std::cerr << "        [Face Index] [Incident Node 1] ... [ Incident Node X]\n";
     std::cerr << "\n";
+    Wailea::Undirected::BatchRunner::printUsage(
+                                    std::cerr, "biconnected_embedding_finder");
 
 }
 
 int main(int argc, char *argv[])
 {
+    if (argc >= 2 && std::string(argv[1]) == "-b") {
+        int status = Wailea::Undirected::BatchRunner::runFromCommandLine(
+            argc - 2, argv + 2,
+            [](std::istream& is, std::ostream& os, const char* name) {
+                Wailea::Undirected::CommandLineBiconnectedEmbeddingFinder p;
+                if (!p.parseSpec(is, name)) {
+                    throw std::invalid_argument("syntax error");
+                }
+                p.generateEmbedding();
+                p.emitEmbeddingSpec(os);
+            }
+        );
+        if (status == 1) {
+            print_usage();
+        }
+        return status;
+    }
     if (argc!=3) {
         print_usage();
         return 1;
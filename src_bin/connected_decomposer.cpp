@@ -1,9 +1,11 @@
 #include "undirected/base.hpp"
 #include "undirected/connected_decomposer.hpp"
+#include "undirected/text_spec_reader.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
 
 namespace Wailea {
 
@@ -68,17 +70,13 @@ class CommandLineConnectedDecomposer {
         END
     };
 
-    bool isSectionHeader(std::string line, enum parseState& state);
+    bool isSectionHeader(TextSpecReader& reader, enum parseState& state);
 
-    bool isCommentLine(std::string line);
-
-    size_t splitLine(
-              const std::string& txt, std::vector<std::string>& strs, char ch);
     void handleNode(
-      std::string line, const char* filename, long lineNumber,bool& errorFlag);
-        
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
+
     void handleEdge(
-     std::string line, const char* filename, long lineNumber, bool& errorFlag);
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
 
     void emitError(
      const char* filename, long lineNumber, const char* mess, bool& errorFlag);
@@ -89,6 +87,12 @@ class CommandLineConnectedDecomposer {
     Graph  mG;
     vector<vector<node_list_it_t> > mNodeSets;
     vector<vector<edge_list_it_t> > mEdgeSets;
+
+    /** @brief node number to index into mNodes */
+    std::unordered_map<long, size_t>        mNumToIndex;
+
+    /** @brief node in mG to node number */
+    std::unordered_map<const Node*, long>   mNodeToNum;
 };
 
 
@@ -97,30 +101,27 @@ const std::string CommandLineConnectedDecomposer::EDGES = "EDGES";
 
 void CommandLineConnectedDecomposer::parseSpec(const char* filename)
 {
-    std::ifstream   is(filename);
-    long            lineNumber = 0;
+    TextSpecReader  reader;
     bool            error      = false;
     enum parseState state      = INIT;
-    while (!is.eof() && !error) {
-        std::string line;
-        std::getline(is, line);
-        if (line.empty()) {continue;}
-        if ((line[line.size()-1] == '\n')||(line[line.size()- 1] == '\r')) {
-            line.erase(line.size() - 1);
-        }
-	lineNumber++;
-        if (isCommentLine(line)) {continue;}
-        if(isSectionHeader(line, state)){continue;}
+    if (!reader.open(filename)) {
+        std::cerr << "Cannot open: " << filename << "\n";
+        return;
+    }
+    while (!error && reader.nextLine()) {
+        if (reader.isBlank()) {continue;}
+        if (reader.isComment()) {continue;}
+        if(isSectionHeader(reader, state)){continue;}
         switch(state) {
           case INIT:
           case END:
-            emitError(filename, lineNumber, "", error);
+            emitError(filename, reader.lineNumber(), "", error);
             break;
           case IN_NODES:
-            handleNode(line, filename, lineNumber, error);
+            handleNode(reader, filename, error);
             break;
           case IN_EDGES:
-            handleEdge(line, filename, lineNumber, error);
+            handleEdge(reader, filename, error);
             break;
         }
     }
@@ -128,14 +129,19 @@ void CommandLineConnectedDecomposer::parseSpec(const char* filename)
 
 
 bool CommandLineConnectedDecomposer::isSectionHeader(
-                                      std::string line, enum parseState& state)
-{
-    if (line.compare(0, NODES.size(), NODES)==0) {
+    TextSpecReader&  reader,
+    enum parseState& state
+) {
+    if (reader.startsWith(NODES)) {
         state = IN_NODES;
+        size_t num = mNodes.size() + reader.countSectionLines();
+        mNodes.reserve(num);
+        mNumToIndex.reserve(num);
         return true;
     }
-    else if (line.compare(0, EDGES.size(), EDGES)==0) {
+    else if (reader.startsWith(EDGES)) {
         state = IN_EDGES;
+        mEdges.reserve(mEdges.size() + reader.countSectionLines());
         return true;
     }
 
@@ -162,90 +168,45 @@ void CommandLineConnectedDecomposer::emitError(
 }
 
 
-bool CommandLineConnectedDecomposer::isCommentLine(std::string line)
-{
-    return line.at(0) == '#';
-}
-
-
-size_t CommandLineConnectedDecomposer::splitLine(
-    const std::string&        txt,
-    std::vector<std::string>& strs,
-    char                      ch
-) {
-
-    auto   pos        = txt.find( ch );
-    size_t initialPos = 0;
-
-    strs.clear();
-
-    while( pos != std::string::npos && initialPos < txt.size()) {
-
-        if (pos > initialPos) {
-            strs.push_back( txt.substr( initialPos, pos - initialPos) );
-        }
-
-        initialPos = pos + 1;
-
-        if (initialPos < txt.size()) {
-            pos = txt.find( ch, initialPos );
-        }
-
-    }
-
-    if(initialPos < txt.size()) {
-        strs.push_back( txt.substr( initialPos, txt.size() - initialPos) );
-    }
-
-    return strs.size();
-}
-
-
 void CommandLineConnectedDecomposer::handleNode(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 1) {
-        emitError(filename, lineNumber, "Invalid Node", errorFlag);
-    }
-
     _node n;
-    n.n = std::stol(fields[0]);
+    if (reader.split() != 1 || !reader.token(0).toLong(n.n)) {
+        emitError(filename, reader.lineNumber(), "Invalid Node", errorFlag);
+        return;
+    }
+    mNumToIndex.emplace(n.n, mNodes.size());
     mNodes.push_back(n);
 }
 
 
 void CommandLineConnectedDecomposer::handleEdge(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 2) {
-        emitError(filename, lineNumber, "Invalid Edge", errorFlag);
-    }
-
     _edge e;
-    e.n1  = std::stol(fields[0]);
-    e.n2  = std::stol(fields[1]);
+    if (reader.split() != 2                 ||
+        !reader.token(0).toLong(e.n1)       ||
+        !reader.token(1).toLong(e.n2)         ) {
+        emitError(filename, reader.lineNumber(), "Invalid Edge", errorFlag);
+        return;
+    }
     mEdges.push_back(e);
 }
 
 
 void CommandLineConnectedDecomposer::decompose()
 {
+    mNodeToNum.reserve(mNodes.size());
     for (auto& n : mNodes) {
         auto  np  = std::make_unique<Node>();
         auto& nr  = dynamic_cast<Node&>(mG.addNode(std::move(np)));
         n.it = nr.backIt();
+        mNodeToNum[&nr] = n.n;
     }
     for (auto& e : mEdges) {
 
@@ -263,10 +224,9 @@ void CommandLineConnectedDecomposer::decompose()
 
 Node& CommandLineConnectedDecomposer::toNodeRef(long num)
 {
-    for(auto& n : mNodes) {
-      if (n.n == num) {
-            return dynamic_cast<Node&>(*(*n.it));
-	    }
+    auto it = mNumToIndex.find(num);
+    if (it != mNumToIndex.end()) {
+        return dynamic_cast<Node&>(*(*(mNodes[it->second].it)));
     }
     cerr << "ERROR\n";
     return dynamic_cast<Node&>(*(*(mNodes[0].it)));
@@ -275,10 +235,9 @@ Node& CommandLineConnectedDecomposer::toNodeRef(long num)
 
 long CommandLineConnectedDecomposer::toNodeNum(node_list_it_t it)
 {
-    for(auto& n : mNodes) {
-        if (n.it == it) {
-            return n.n;
-        }
+    auto nit = mNodeToNum.find((*it).get());
+    if (nit != mNodeToNum.end()) {
+        return nit->second;
     }
     cerr << "ERROR\n";
     return -1;
@@ -1,9 +1,13 @@
 #include "undirected/base.hpp"
 #include "undirected/bctree.hpp"
+#include "undirected/batch_runner.hpp"
+#include "undirected/text_spec_reader.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
+#include <stdexcept>
 
 namespace Wailea {
 
@@ -40,9 +44,12 @@ class CommandLineDecomposer {
 
   public:
 
-    void parseSpec(const char* filename);
+    bool parseSpec(const char* filename);
+    bool parseSpec(std::istream& is, const char* filename);
+    bool parseSpec(TextSpecReader& reader, const char* filename);
     void generateBCTree();
     void emitBCTreeSpec(const char* filename);
+    void emitBCTreeSpec(std::ostream& os);
 
     class _node {public:long n; node_list_it_t it;};
     class _edge {public:long n1; long n2; edge_list_it_t it;};
@@ -68,17 +75,13 @@ class CommandLineDecomposer {
         END
     };
 
-    bool isSectionHeader(std::string line, enum parseState& state);
+    bool isSectionHeader(TextSpecReader& reader, enum parseState& state);
 
-    bool isCommentLine(std::string line);
-
-    size_t splitLine(
-              const std::string& txt, std::vector<std::string>& strs, char ch);
     void handleNode(
-      std::string line, const char* filename, long lineNumber,bool& errorFlag);
-        
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
+
     void handleEdge(
-     std::string line, const char* filename, long lineNumber, bool& errorFlag);
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
 
     void emitError(
      const char* filename, long lineNumber, const char* mess, bool& errorFlag);
@@ -89,6 +92,12 @@ class CommandLineDecomposer {
     Graph  mG;
     BCTree mBCTree;
 
+    /** @brief node number to index into mNodes */
+    std::unordered_map<long, size_t>        mNumToIndex;
+
+    /** @brief node in mG to node number */
+    std::unordered_map<const Node*, long>   mNodeToNum;
+
 };
 
 
@@ -104,47 +113,66 @@ const std::string CommandLineDecomposer::BLOCK_EDGES = "BLOCK_EDGES";
 const std::string CommandLineDecomposer::BLOCK_END = "BLOCK_END";
 
 
-void CommandLineDecomposer::parseSpec(const char* filename)
+bool CommandLineDecomposer::parseSpec(const char* filename)
+{
+    TextSpecReader reader;
+    if (!reader.open(filename)) {
+        std::cerr << "Cannot open: " << filename << "\n";
+        return false;
+    }
+    return parseSpec(reader, filename);
+}
+
+
+bool CommandLineDecomposer::parseSpec(std::istream& is, const char* filename)
 {
-    std::ifstream   is(filename);
-    long            lineNumber = 0;
+    TextSpecReader reader;
+    reader.load(is);
+    return parseSpec(reader, filename);
+}
+
+
+bool CommandLineDecomposer::parseSpec(
+    TextSpecReader& reader,
+    const char*     filename
+) {
     bool            error      = false;
     enum parseState state      = INIT;
-    while (!is.eof() && !error) {
-        std::string line;
-        std::getline(is, line);
-        if (line.empty()) {continue;}
-        if ((line[line.size()-1] == '\n')||(line[line.size()- 1] == '\r')) {
-            line.erase(line.size() - 1);
-        }
-	lineNumber++;
-        if (isCommentLine(line)) {continue;}
-        if(isSectionHeader(line, state)){continue;}
+    while (!error && reader.nextLine()) {
+        if (reader.isBlank()) {continue;}
+        if (reader.isComment()) {continue;}
+        if(isSectionHeader(reader, state)){continue;}
         switch(state) {
           case INIT:
           case END:
-            emitError(filename, lineNumber, "", error);
+            emitError(filename, reader.lineNumber(), "", error);
             break;
           case IN_NODES:
-            handleNode(line, filename, lineNumber, error);
+            handleNode(reader, filename, error);
             break;
           case IN_EDGES:
-            handleEdge(line, filename, lineNumber, error);
+            handleEdge(reader, filename, error);
             break;
         }
     }
+    return !error;
 }
 
 
 bool CommandLineDecomposer::isSectionHeader(
-                                      std::string line, enum parseState& state)
-{
-    if (line.compare(0, NODES.size(), NODES)==0) {
+    TextSpecReader&  reader,
+    enum parseState& state
+) {
+    if (reader.startsWith(NODES)) {
         state = IN_NODES;
+        size_t num = mNodes.size() + reader.countSectionLines();
+        mNodes.reserve(num);
+        mNumToIndex.reserve(num);
         return true;
     }
-    else if (line.compare(0, EDGES.size(), EDGES)==0) {
+    else if (reader.startsWith(EDGES)) {
         state = IN_EDGES;
+        mEdges.reserve(mEdges.size() + reader.countSectionLines());
         return true;
     }
 
@@ -171,90 +199,45 @@ void CommandLineDecomposer::emitError(
 }
 
 
-bool CommandLineDecomposer::isCommentLine(std::string line)
-{
-    return line.at(0) == '#';
-}
-
-
-size_t CommandLineDecomposer::splitLine(
-    const std::string&        txt,
-    std::vector<std::string>& strs,
-    char                      ch
-) {
-
-    auto   pos        = txt.find( ch );
-    size_t initialPos = 0;
-
-    strs.clear();
-
-    while( pos != std::string::npos && initialPos < txt.size()) {
-
-        if (pos > initialPos) {
-            strs.push_back( txt.substr( initialPos, pos - initialPos) );
-        }
-
-        initialPos = pos + 1;
-
-        if (initialPos < txt.size()) {
-            pos = txt.find( ch, initialPos );
-        }
-
-    }
-
-    if(initialPos < txt.size()) {
-        strs.push_back( txt.substr( initialPos, txt.size() - initialPos) );
-    }
-
-    return strs.size();
-}
-
-
 void CommandLineDecomposer::handleNode(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 1) {
-        emitError(filename, lineNumber, "Invalid Node", errorFlag);
-    }
-
     _node n;
-    n.n = std::stol(fields[0]);
+    if (reader.split() != 1 || !reader.token(0).toLong(n.n)) {
+        emitError(filename, reader.lineNumber(), "Invalid Node", errorFlag);
+        return;
+    }
+    mNumToIndex.emplace(n.n, mNodes.size());
     mNodes.push_back(n);
 }
 
 
 void CommandLineDecomposer::handleEdge(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 2) {
-        emitError(filename, lineNumber, "Invalid Edge", errorFlag);
-    }
-
     _edge e;
-    e.n1  = std::stol(fields[0]);
-    e.n2  = std::stol(fields[1]);
+    if (reader.split() != 2                 ||
+        !reader.token(0).toLong(e.n1)       ||
+        !reader.token(1).toLong(e.n2)         ) {
+        emitError(filename, reader.lineNumber(), "Invalid Edge", errorFlag);
+        return;
+    }
     mEdges.push_back(e);
 }
 
 
 void CommandLineDecomposer::generateBCTree()
 {
+    mNodeToNum.reserve(mNodes.size());
     for (auto& n : mNodes) {
         auto  np  = std::make_unique<Node>();
         auto& nr  = dynamic_cast<Node&>(mG.addNode(std::move(np)));
         n.it = nr.backIt();
+        mNodeToNum[&nr] = n.n;
     }
     for (auto& e : mEdges) {
 
@@ -272,10 +255,9 @@ void CommandLineDecomposer::generateBCTree()
 
 Node& CommandLineDecomposer::toNodeRef(long num)
 {
-    for(auto& n : mNodes) {
-      if (n.n == num) {
-            return dynamic_cast<Node&>(*(*n.it));
-	    }
+    auto it = mNumToIndex.find(num);
+    if (it != mNumToIndex.end()) {
+        return dynamic_cast<Node&>(*(*(mNodes[it->second].it)));
     }
     cerr << "ERROR\n";
     return dynamic_cast<Node&>(*(*(mNodes[0].it)));
@@ -284,10 +266,9 @@ Node& CommandLineDecomposer::toNodeRef(long num)
 
 long CommandLineDecomposer::toNodeNum(node_list_it_t it)
 {
-    for(auto& n : mNodes) {
-        if (n.it == it) {
-            return n.n;
-        }
+    auto nit = mNodeToNum.find((*it).get());
+    if (nit != mNodeToNum.end()) {
+        return nit->second;
     }
     cerr << "ERROR\n";
     return -1;
@@ -296,9 +277,13 @@ long CommandLineDecomposer::toNodeNum(node_list_it_t it)
 
 void CommandLineDecomposer::emitBCTreeSpec(const char* filename)
 {
-   
     std::ofstream   os(filename);
+    emitBCTreeSpec(os);
+}
+
 
+void CommandLineDecomposer::emitBCTreeSpec(std::ostream& os)
+{
     utility_t cutVertexIndex = 0;
     utility_t blockIndex = 0;
 
@@ -401,6 +386,7 @@ static void print_usage()
     std::cerr << "decomposer : decomposes the given connected graph into BC-tree\n";
     std::cerr << "    Usage : decomposer <input_file> <output_file>\n";
     std::cerr << "\n";
+    Wailea::Undirected::BatchRunner::printUsage(std::cerr, "decomposer");
     std::cerr << "    Input file format:\n";
     std::cerr << "        NODES\n";
     std::cerr << "        [Node Num]\n";
@@ -431,6 +417,23 @@ static void print_usage()
 
 int main(int argc, char *argv[])
 {
+    if (argc >= 2 && std::string(argv[1]) == "-b") {
+        int status = Wailea::Undirected::BatchRunner::runFromCommandLine(
+            argc - 2, argv + 2,
+            [](std::istream& is, std::ostream& os, const char* name) {
+                Wailea::Undirected::CommandLineDecomposer p;
+                if (!p.parseSpec(is, name)) {
+                    throw std::invalid_argument("syntax error");
+                }
+                p.generateBCTree();
+                p.emitBCTreeSpec(os);
+            }
+        );
+        if (status == 1) {
+            print_usage();
+        }
+        return status;
+    }
     if (argc!=3) {
         print_usage();
         return 1;
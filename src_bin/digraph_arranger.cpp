@@ -4,11 +4,15 @@
 #include "directed/network_simplex.hpp"
 #include "directed/gknv_crossings_reducer.hpp"
 #include "directed/sugiyama_digraph.hpp"
+#include "directed/bk_coordinate_assigner.hpp"
+#include "undirected/batch_runner.hpp"
+#include "undirected/text_spec_reader.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
-#include <map>
+#include <unordered_map>
+#include <stdexcept>
 
 namespace Wailea {
 
@@ -23,11 +27,13 @@ namespace Directed {
  * =================
  *
  * NODES
- * [Node Num]
+ * [Node Num] ([Width])
  *
  * EDGES
  * [Node Src] [Node Dst] [Flipping Cost] [Extending Cost]
  *
+ * The width is optional and defaults to 1.0.
+ *
  * ==================
  * Output file format
  * ==================
@@ -57,6 +63,11 @@ namespace Directed {
  * [Node Num] [Incident Node Num1] ... [Incident Node Num X]
  * ...
  *
+ * X_COORDINATES
+ * [Node Num] [X]
+ * ...
+ *
+ * X is the center of the node. The virtual nodes have width 0.0.
  */
 namespace DiGraphArranger { 
 
@@ -68,9 +79,11 @@ namespace DiGraphArranger {
  */
 class DGANode : public DiNode {
   public:
-    DGANode(long num, bool isVirtual):mNum(num), mVirtual(isVirtual){;}
-    long mNum;
-    bool mVirtual;
+    DGANode(long num, bool isVirtual, double width = 1.0):
+        mNum(num), mVirtual(isVirtual), mWidth(width){;}
+    long   mNum;
+    bool   mVirtual;
+    double mWidth;
 };
 
 
@@ -108,8 +121,30 @@ class Parser {
      *
      *  @param  filename (in): name of the file to be opened and parsed.
      *
+     *  @return false if the file can not be opened or a syntax error
+     *          is found.
+     */
+    bool parseSpec(const char* filename);
+
+    /** @brief
+     *
+     *  @param  is       (in): stream to be parsed.
+     *
+     *  @param  filename (in): name of the stream used in the error messages.
+     *
+     *  @return false if a syntax error is found.
+     */
+    bool parseSpec(std::istream& is, const char* filename);
+
+    /** @brief
+     *
+     *  @param  reader   (in): reader on the file or the stream to be parsed.
+     *
+     *  @param  filename (in): name of the input used in the error messages.
+     *
+     *  @return false if a syntax error is found.
      */
-    void parseSpec(const char* filename);
+    bool parseSpec(TextSpecReader& reader, const char* filename);
 
     static const std::string NODES;
     static const std::string EDGES;
@@ -123,18 +158,13 @@ class Parser {
         END
     };
 
-    bool isSectionHeader(std::string line, enum parseState& state);
-
-    bool isCommentLine(std::string line);
+    bool isSectionHeader(TextSpecReader& reader, enum parseState& state);
 
-    size_t splitLine(
-              const std::string& txt, std::vector<std::string>& strs, char ch);
-        
     void handleNode(
-      std::string line, const char* filename, long lineNumber,bool& errorFlag);
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
 
     void handleEdge(
-     std::string line, const char* filename, long lineNumber, bool& errorFlag);
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
 
     void emitError(
      const char* filename, long lineNumber, const char* mess, bool& errorFlag);
@@ -142,7 +172,7 @@ class Parser {
     DiGraph& mG;
 
     /** @brief used during parsing to find a node from a node number.*/
-    map<long,node_list_it_t> mNodeMap;      
+    std::unordered_map<long,node_list_it_t> mNodeMap;
 
 
 };
@@ -150,35 +180,39 @@ class Parser {
 const std::string Parser::NODES          = "NODES";
 const std::string Parser::EDGES          = "EDGES";
 
-void Parser::parseSpec(const char* filename)
+bool Parser::parseSpec(const char* filename)
 {
-    std::ifstream   is(filename);
-    long            lineNumber = 0;
-    bool            error      = false;
-    enum parseState state      = INIT;
+    TextSpecReader reader;
+    if (!reader.open(filename)) {
+        std::cerr << "Cannot open: " << filename << "\n";
+        return false;
+    }
+    return parseSpec(reader, filename);
+}
 
-    while (!is.eof() && !error) {
 
-        std::string line;
+bool Parser::parseSpec(std::istream& is, const char* filename)
+{
+    TextSpecReader reader;
+    reader.load(is);
+    return parseSpec(reader, filename);
+}
 
-        std::getline(is, line);
 
-        if (!line.empty() && line[line.size() - 1] == '\n'){
-            line.erase(line.size() - 1);
-        }
-        if (!line.empty() && line[line.size() - 1] == '\r'){
-            line.erase(line.size() - 1);
-        }
+bool Parser::parseSpec(TextSpecReader& reader, const char* filename)
+{
+    bool            error      = false;
+    enum parseState state      = INIT;
 
-        lineNumber++;
+    while (!error && reader.nextLine()) {
 
-        if (line.empty()) {
+        if (reader.isBlank()) {
             continue;
         }
-        if (isCommentLine(line)) {
+        if (reader.isComment()) {
             continue;
         }
-        if(isSectionHeader(line, state)){
+        if(isSectionHeader(reader, state)){
             continue;
         }
 
@@ -186,40 +220,42 @@ void Parser::parseSpec(const char* filename)
 
           case INIT:
 
-            emitError(filename, lineNumber, "", error);
+            emitError(filename, reader.lineNumber(), "", error);
             break;
 
           case IN_NODES:
 
-            handleNode(line, filename, lineNumber, error);
+            handleNode(reader, filename, error);
             break;
 
           case IN_EDGES:
 
-            handleEdge(line, filename, lineNumber, error);
+            handleEdge(reader, filename, error);
             break;
 
           case END:
           default:
-            emitError(filename, lineNumber, "", error);
+            emitError(filename, reader.lineNumber(), "", error);
             break;
 
         }
 
     }
 
+    return !error;
 }
 
 
 bool Parser::isSectionHeader(
-    std::string line,
+    TextSpecReader&  reader,
     enum parseState& state
 ) {
-    if (line.compare(0, NODES.size(), NODES)==0) {
+    if (reader.startsWith(NODES)) {
         state = IN_NODES;
+        mNodeMap.reserve(mNodeMap.size() + reader.countSectionLines());
         return true;
     }
-    else if (line.compare(0, EDGES.size(), EDGES)==0) {
+    else if (reader.startsWith(EDGES)) {
         state = IN_EDGES;
         return true;
     }
@@ -247,86 +283,50 @@ void Parser::emitError(
 }
 
 
-bool Parser::isCommentLine(std::string line)
-{
-    return line.at(0) == '#';
-}
-
-
-size_t Parser::splitLine(
-    const std::string&        txt,
-    std::vector<std::string>& strs,
-    char                      ch
-) {
-
-    auto   pos        = txt.find( ch );
-    size_t initialPos = 0;
-
-    strs.clear();
-
-    while( pos != std::string::npos && initialPos < txt.size()) {
-
-        if (pos > initialPos) {
-            strs.push_back( txt.substr( initialPos, pos - initialPos) );
-        }
-
-        initialPos = pos + 1;
-
-        if (initialPos < txt.size()) {
-            pos = txt.find( ch, initialPos );
-        }
-
-    }
-
-    if(initialPos < txt.size()) {
-        strs.push_back( txt.substr( initialPos, txt.size() - initialPos) );
-    }
-
-    return strs.size();
-}
-
-
 void Parser::handleNode(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 1) {
-        emitError(filename, lineNumber, "Invalid Node", errorFlag);
+    size_t numFields = reader.split();
+    long   nodeNum;
+    double width     = 1.0;
+    if ((numFields != 1 && numFields != 2)                       ||
+        !reader.token(0).toLong(nodeNum)                         ||
+        (numFields == 2 && !reader.token(1).toDouble(width))       ) {
+        emitError(filename, reader.lineNumber(), "Invalid Node", errorFlag);
+        return;
     }
 
-    long nodeNum = std::stol(fields[0]);
-
-    auto  np = std::make_unique<DGANode>(nodeNum, false);
+    auto  np = std::make_unique<DGANode>(nodeNum, false, width);
     auto& N  = dynamic_cast<DGANode&>(mG.addNode(std::move(np)));
     mNodeMap[nodeNum] = N.backIt();
 }
 
 
 void Parser::handleEdge(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 4) {
-        emitError(filename, lineNumber, "Invalid Edge", errorFlag);
+    long N1num, N2num, Fcost, Ecost;
+    if (reader.split() != 4              ||
+        !reader.token(0).toLong(N1num)   ||
+        !reader.token(1).toLong(N2num)   ||
+        !reader.token(2).toLong(Fcost)   ||
+        !reader.token(3).toLong(Ecost)     ) {
+        emitError(filename, reader.lineNumber(), "Invalid Edge", errorFlag);
+        return;
     }
 
-    auto N1num = std::stol(fields[0]);
-    auto N2num = std::stol(fields[1]);
-    auto Fcost = std::stol(fields[2]);
-    auto Ecost = std::stol(fields[3]);
-
-    auto& N1 = dynamic_cast<DGANode&>(*(*(mNodeMap[N1num])));
-    auto& N2 = dynamic_cast<DGANode&>(*(*(mNodeMap[N2num])));
+    auto n1it = mNodeMap.find(N1num);
+    auto n2it = mNodeMap.find(N2num);
+    if (n1it == mNodeMap.end() || n2it == mNodeMap.end()) {
+        emitError(filename, reader.lineNumber(), "Unknown Node", errorFlag);
+        return;
+    }
+    auto& N1 = dynamic_cast<DGANode&>(*(*(n1it->second)));
+    auto& N2 = dynamic_cast<DGANode&>(*(*(n2it->second)));
 
     auto  ep = std::make_unique<DGAEdge>(Fcost, Ecost);
     mG.addEdge(std::move(ep), N1, N2);
@@ -336,22 +336,27 @@ void Parser::handleEdge(
 class Generator {
 
   public:
-    Generator(DiGraph& G):mG(G),mSG(G){;}
+    Generator(DiGraph& G, bool greedy = false, bool refine = false):
+        mG(G),mSG(G),mGreedy(greedy),mRefine(refine){;}
 
     void generate(const char* filename);
+    void generate(std::ostream& os);
   private:
 
     void makeAcyclicOrdering();
     void findRanksAndPos();
     void updateBasisGraph();
-    void emitNodesSpec(std::ofstream& os);
-    void emitEdgesSpec(std::ofstream& os);
-    void emitRanksSpec(std::ofstream& os);
-    void emitIncidenceInSpec(std::ofstream& os);
-    void emitIncidenceOutSpec(std::ofstream& os);
+    void emitNodesSpec(std::ostream& os);
+    void emitEdgesSpec(std::ostream& os);
+    void emitRanksSpec(std::ostream& os);
+    void emitIncidenceInSpec(std::ostream& os);
+    void emitIncidenceOutSpec(std::ostream& os);
+    void emitXCoordinatesSpec(std::ostream& os);
 
     DiGraph&        mG;
     SugiyamaDiGraph mSG;
+    bool            mGreedy;
+    bool            mRefine;
 
     vector<vector<node_list_it_t> > mRanks;
 };
@@ -384,6 +389,12 @@ void Generator::updateBasisGraph()
 void Generator::generate(const char* filename)
 {
     std::ofstream   os(filename);
+    generate(os);
+}
+
+
+void Generator::generate(std::ostream& os)
+{
     makeAcyclicOrdering();
     findRanksAndPos();
     updateBasisGraph();
@@ -392,10 +403,11 @@ void Generator::generate(const char* filename)
     emitRanksSpec(os);
     emitIncidenceInSpec(os);
     emitIncidenceOutSpec(os);
+    emitXCoordinatesSpec(os);
 }
 
 
-void Generator::emitNodesSpec(std::ofstream& os)
+void Generator::emitNodesSpec(std::ostream& os)
 {
     if (mSG.numNodes() > 0) {
         os << "NODES\n";
@@ -422,7 +434,7 @@ void Generator::emitNodesSpec(std::ofstream& os)
 }
 
 
-void Generator::emitEdgesSpec(std::ofstream& os)
+void Generator::emitEdgesSpec(std::ostream& os)
 {
     if (mSG.numEdges() > 0) {
 
@@ -481,7 +493,7 @@ void Generator::emitEdgesSpec(std::ofstream& os)
 }
 
 
-void Generator::emitRanksSpec(std::ofstream& os)
+void Generator::emitRanksSpec(std::ostream& os)
 {
     if (mRanks.size() > 0) {
         os << "\n";
@@ -504,7 +516,7 @@ void Generator::emitRanksSpec(std::ofstream& os)
 }
 
 
-void Generator::emitIncidenceInSpec(std::ofstream& os)
+void Generator::emitIncidenceInSpec(std::ostream& os)
 {
     if (mSG.numEdges() > 0) {    
         os << "\n";
@@ -527,7 +539,7 @@ void Generator::emitIncidenceInSpec(std::ofstream& os)
 }
 
 
-void Generator::emitIncidenceOutSpec(std::ofstream& os)
+void Generator::emitIncidenceOutSpec(std::ostream& os)
 {
     if (mSG.numEdges() > 0) {
         os << "\n";
@@ -550,6 +562,19 @@ void Generator::emitIncidenceOutSpec(std::ofstream& os)
 }
 
 
+void Generator::emitXCoordinatesSpec(std::ostream& os)
+{
+    if (mSG.numNodes() > 0) {
+        os << "\n";
+        os << "X_COORDINATES\n";
+        for (auto nit = mSG.nodes().first; nit != mSG.nodes().second; nit++) {
+            auto& Ns   = dynamic_cast<SugiyamaDiNode&>(*(*nit));
+            os << Ns.utility() << " " << Ns.x() << "\n";
+        }
+    }
+}
+
+
 void Generator::makeAcyclicOrdering()
 {
     DiGraph AG;
@@ -573,6 +598,9 @@ void Generator::makeAcyclicOrdering()
         Eaof.setCost(Eorg.mFlippingCost);
     }
     AcyclicOrderingFinder  finder(AG);
+    if (mGreedy) {
+        finder.setStrategy(AcyclicOrderingFinder::GREEDY);
+    }
     vector<node_list_it_t> ListAOF = finder.find();
     vector<node_list_it_t> ListOrg;
     for (auto nit : ListAOF) {
@@ -688,6 +716,19 @@ void Generator::findRanksAndPos()
 
     GKNVcrossingsReducer reducer(mSG);
     /*long numCrossings = */reducer.reduce(mRanks, 20);
+
+    for (auto nit = mSG.nodes().first; nit != mSG.nodes().second; nit++) {
+        auto& Ns = dynamic_cast<SugiyamaDiNode&>(*(*nit));
+        if (!Ns.isVirtual()) {
+            auto& Norg = dynamic_cast<DGANode&>(Ns.IGBackwardLinkRef());
+            Ns.setWidth(Norg.mWidth);
+        }
+    }
+    BKCoordinateAssigner assigner(mSG);
+    if (mRefine) {
+        assigner.setRefinement(BKCoordinateAssigner::PRIORITY_METHOD);
+    }
+    assigner.assign(mRanks);
 }
 
 } // namespace DiGraphArranger 
@@ -700,11 +741,19 @@ void Generator::findRanksAndPos()
 static void print_usage()
 {
     std::cerr << "digraph_arranger : finds horizontal and vertical arrangement of the nodes of the given digraph for drawing.\n";
-    std::cerr << "    Usage : digraph_arranger <input_file> <output_file>\n";
+    std::cerr << "    Usage : digraph_arranger [-g] [-p] <input_file> <output_file>\n";
+    std::cerr << "\n";
+    std::cerr << "    Options:\n";
+    std::cerr << "        -g : uses the greedy heuristic instead of network simplex\n";
+    std::cerr << "             to find the acyclic ordering. Faster on large graphs.\n";
+    std::cerr << "        -p : refines the x-coordinates by the priority method.\n";
+    std::cerr << "\n";
+    Wailea::Undirected::BatchRunner::printUsage(
+                                     std::cerr, "digraph_arranger [-g] [-p]");
     std::cerr << "\n";
     std::cerr << "    Input file format:\n";
     std::cerr << "        NODES\n";
-    std::cerr << "        [Node Num]\n";
+    std::cerr << "        [Node Num] ([Width])\n";
     std::cerr << "\n";
     std::cerr << "        EDGES\n";
     std::cerr << "        [Node Src] [Node Dst] [Flipping Cost] [Extending Cost]\n";
@@ -736,12 +785,54 @@ static void print_usage()
     std::cerr << "        [Node Num] [Incident Node Num1] ... [Incident Node Num X]\n";
     std::cerr << "        ...\n";  
     std::cerr << "\n";
+    std::cerr << "        X_COORDINATES\n";
+    std::cerr << "        [Node Num] [X]\n";
+    std::cerr << "        ...\n";  
+    std::cerr << "\n";
 
 }
 
 
 int main(int argc, char *argv[])
 {
+    bool greedy = false;
+    bool refine = false;
+    while (argc > 1) {
+        if (std::string(argv[1]) == "-g") {
+            greedy = true;
+        }
+        else if (std::string(argv[1]) == "-p") {
+            refine = true;
+        }
+        else {
+            break;
+        }
+        argv++;
+        argc--;
+    }
+
+    if (argc >= 2 && std::string(argv[1]) == "-b") {
+        int status = Wailea::Undirected::BatchRunner::runFromCommandLine(
+            argc - 2, argv + 2,
+            [greedy, refine](
+                std::istream& is, std::ostream& os, const char* name
+            ) {
+                Wailea::Directed::DiGraph DGA;
+                Wailea::Directed::DiGraphArranger::Parser p(DGA);
+                if (!p.parseSpec(is, name)) {
+                    throw std::invalid_argument("syntax error");
+                }
+                Wailea::Directed::DiGraphArranger::Generator g(
+                                                         DGA, greedy, refine);
+                g.generate(os);
+            }
+        );
+        if (status == 1) {
+            print_usage();
+        }
+        return status;
+    }
+
     if (argc!=3) {
 
         print_usage();
@@ -755,7 +846,7 @@ int main(int argc, char *argv[])
 
     p.parseSpec(argv[1]);
 
-    Wailea::Directed::DiGraphArranger::Generator g(DGA);
+    Wailea::Directed::DiGraphArranger::Generator g(DGA, greedy, refine);
 
     g.generate(argv[2]);
 
@@ -0,0 +1,551 @@
+#include "undirected/base.hpp"
+#include "undirected/vis_rep_finder.hpp"
+#include "undirected/layout_pipeline.hpp"
+#include "undirected/batch_runner.hpp"
+#include "undirected/text_spec_reader.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <stdexcept>
+
+namespace Wailea {
+
+namespace Undirected {
+/**
+ *
+ * @brief quick and dirty command line interface to LayoutPipeline.
+ *        It does what decomposer, planarizer, biconnected_embedding_finder,
+ *        and vis_rep_finder do in one process.
+ *
+ * =================
+ * Input file format
+ * =================
+ *
+ * TOP NODE
+ * [Node Num]
+ *
+ * GAPS
+ * [W] [H]
+ *
+ * NODES
+ * [Node Num] [Label W] [Label H]
+ *
+ * EDGES
+ * [Node 1] [Node 2] CENTER/CW/CCW [Label1 W] [Label1 H] \
+ *                   CENTER/CW/CCW [LabelM W] [LabelM H] \
+ *                   CENTER/CW/CCW [Label2 W] [Label2 H] \
+ *
+ * TOP NODE is optional.
+ *
+ * ==================
+ * Output file format
+ * ==================
+ * AREA
+ * [W] [H]
+ *
+ * NODES
+ * [Node Num] [X Left] [X Right] [Y]
+ *
+ * EDGES
+ * [Node 1] [Node 2] [X] [Y1] [Y2] FLIPPED/NOTFLIPPED
+ *
+ * The virtual nodes for the crossings are numbered from
+ * (the largest node number + 1).
+ */
+class CommandLineGraphLayouter {
+
+  public:
+
+    inline CommandLineGraphLayouter():
+        mHgap(0),mVgap(0),mTopNode(-1),mMaxNodeNum(0),mNumThreads(1){;}
+
+    inline void setNumThreads(size_t n) { mNumThreads = n; }
+
+    bool parseSpec(const char* filename);
+    bool parseSpec(std::istream& is, const char* filename);
+    bool parseSpec(TextSpecReader& reader, const char* filename);
+    void generateLayout();
+    void emitCoordSpec(const char* filename);
+    void emitCoordSpec(std::ostream& os);
+
+  private:
+
+    using pType = enum Wailea::Undirected::VRRectLabelEdge::posType;
+
+    static const std::string TOP_NODE;
+    static const std::string GAPS;
+    static const std::string NODES;
+    static const std::string EDGES;
+    static const std::string CENTER;
+    static const std::string CCW;
+    static const std::string CW;
+
+    enum parseState {
+        INIT,
+        IN_TOP_NODE,
+        IN_GAPS,
+        IN_NODES,
+        IN_EDGES
+    };
+
+    coord_t                   mHgap;
+    coord_t                   mVgap;
+    long                      mTopNode;
+    long                      mMaxNodeNum;
+    size_t                    mNumThreads;
+    std::unordered_map<long, node_list_it_t> mNumToNode;
+
+    VRRectLabelGraph          mG;
+    VRRectLabelGraph          mLG;
+
+    bool isSectionHeader(TextSpecReader& reader, enum parseState& state);
+
+    void handleTopNode(
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
+    );
+
+    void handleGaps(
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
+    );
+
+    void handleNode(
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
+    );
+
+    void handleEdge(
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
+    );
+
+    bool strToPosType(const TextSpecReader::Token& token, pType &type);
+
+    void emitError(
+        const char* filename,
+        long        lineNumber,
+        const char* mess ,
+        bool&       errorFlag
+    );
+
+    long toLayoutNodeNum(Node& LN);
+
+};
+
+const std::string CommandLineGraphLayouter::TOP_NODE = "TOP NODE";
+const std::string CommandLineGraphLayouter::GAPS     = "GAPS";
+const std::string CommandLineGraphLayouter::NODES    = "NODES";
+const std::string CommandLineGraphLayouter::EDGES    = "EDGES";
+const std::string CommandLineGraphLayouter::CENTER   = "CENTER";
+const std::string CommandLineGraphLayouter::CCW      = "CCW";
+const std::string CommandLineGraphLayouter::CW       = "CW";
+
+
+bool CommandLineGraphLayouter::parseSpec(const char* filename)
+{
+    TextSpecReader reader;
+    if (!reader.open(filename)) {
+        std::cerr << "Cannot open: " << filename << "\n";
+        return false;
+    }
+    return parseSpec(reader, filename);
+}
+
+
+bool CommandLineGraphLayouter::parseSpec(
+    std::istream& is,
+    const char*   filename
+) {
+    TextSpecReader reader;
+    reader.load(is);
+    return parseSpec(reader, filename);
+}
+
+
+bool CommandLineGraphLayouter::parseSpec(
+    TextSpecReader& reader,
+    const char*     filename
+) {
+    bool            error      = false;
+    enum parseState state      = INIT;
+
+    while (!error && reader.nextLine()) {
+
+        if (reader.isBlank()) {
+            continue;
+        }
+        if (reader.isComment()) {
+            continue;
+        }
+        if(isSectionHeader(reader, state)){
+            continue;
+        }
+
+        switch(state) {
+
+          case INIT:
+
+            emitError(filename, reader.lineNumber(), "", error);
+            break;
+
+          case IN_TOP_NODE:
+
+            handleTopNode(reader, filename, error);
+            break;
+
+          case IN_GAPS:
+
+            handleGaps(reader, filename, error);
+            break;
+
+          case IN_NODES:
+
+            handleNode(reader, filename, error);
+            break;
+
+          case IN_EDGES:
+
+            handleEdge(reader, filename, error);
+            break;
+        }
+    }
+
+    if (!error && mTopNode != -1 &&
+                                  mNumToNode.find(mTopNode)==mNumToNode.end()) {
+        emitError(filename, reader.lineNumber(), "Unknown Top Node", error);
+    }
+    return !error;
+}
+
+
+bool CommandLineGraphLayouter::isSectionHeader(
+    TextSpecReader&  reader,
+    enum parseState& state
+) {
+    if (reader.startsWith(TOP_NODE)) {
+        state = IN_TOP_NODE;
+        return true;
+    }
+    else if (reader.startsWith(GAPS)) {
+        state = IN_GAPS;
+        return true;
+    }
+    else if (reader.startsWith(NODES)) {
+        state = IN_NODES;
+        mNumToNode.reserve(mNumToNode.size() + reader.countSectionLines());
+        return true;
+    }
+    else if (reader.startsWith(EDGES)) {
+        state = IN_EDGES;
+        return true;
+    }
+
+    return false;
+}
+
+
+void CommandLineGraphLayouter::emitError(
+    const char* filename,
+    long        lineNumber,
+    const char* message ,
+    bool&       errorFlag
+) {
+
+    std::cerr << "Syntax Error: "
+              << filename
+              << " at line: "
+              << lineNumber
+              << " "
+              << message
+              << "\n";
+
+    errorFlag = true;
+}
+
+
+void CommandLineGraphLayouter::handleTopNode(
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
+) {
+    if (reader.split() != 1 || !reader.token(0).toLong(mTopNode)) {
+        emitError(filename, reader.lineNumber(), "Invalid Top Node",
+                                                                   errorFlag);
+    }
+}
+
+
+void CommandLineGraphLayouter::handleGaps(
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
+) {
+    if (reader.split() != 2                 ||
+        !reader.token(0).toDouble(mHgap)    ||
+        !reader.token(1).toDouble(mVgap)      ) {
+        emitError(filename, reader.lineNumber(), "Invalid Gaps", errorFlag);
+        return;
+    }
+
+    mG.setHorizontalGap(mHgap);
+    mG.setVerticalGap(mVgap);
+}
+
+
+void CommandLineGraphLayouter::handleNode(
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
+) {
+    long    num;
+    coord_t w, h;
+    if (reader.split() != 3             ||
+        !reader.token(0).toLong(num)    ||
+        !reader.token(1).toDouble(w)    ||
+        !reader.token(2).toDouble(h)      ) {
+        emitError(filename, reader.lineNumber(), "Invalid Node", errorFlag);
+        return;
+    }
+
+    if (mNumToNode.find(num) != mNumToNode.end()) {
+        emitError(filename, reader.lineNumber(), "Duplicate Node", errorFlag);
+        return;
+    }
+
+    auto  np = std::make_unique<VRRectLabelNode>(w, h);
+    auto& N  = mG.addNode(std::move(np));
+    N.pushUtility(num);
+    mNumToNode[num] = N.backIt();
+    if (mNumToNode.size() == 1 || mMaxNodeNum < num) {
+        mMaxNodeNum = num;
+    }
+}
+
+
+bool CommandLineGraphLayouter::strToPosType(
+    const TextSpecReader::Token& token,
+    enum Wailea::Undirected::VRRectLabelEdge::posType &type
+) {
+    if (token.equals(CENTER)) {
+        type = VRRectLabelEdge::POS_CENTER;
+        return true;
+    }
+    else if (token.equals(CCW)) {
+        type = VRRectLabelEdge::POS_COUNTER_CLOCKWISE;
+        return true;
+    }
+    else if (token.equals(CW)) {
+        type = VRRectLabelEdge::POS_CLOCKWISE;
+        return true;
+    }
+    else{
+        return false;
+    }
+}
+
+
+void CommandLineGraphLayouter::handleEdge(
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
+) {
+    long    n1, n2;
+    coord_t w1, h1, wm, hm, w2, h2;
+    pType   p1, pm, p2;
+    if (reader.split() != 11                  ||
+        !reader.token(0).toLong(n1)           ||
+        !reader.token(1).toLong(n2)           ||
+        !strToPosType(reader.token(2), p1)    ||
+        !reader.token(3).toDouble(w1)         ||
+        !reader.token(4).toDouble(h1)         ||
+        !strToPosType(reader.token(5), pm)    ||
+        !reader.token(6).toDouble(wm)         ||
+        !reader.token(7).toDouble(hm)         ||
+        !strToPosType(reader.token(8), p2)    ||
+        !reader.token(9).toDouble(w2)         ||
+        !reader.token(10).toDouble(h2)          ) {
+        emitError(filename, reader.lineNumber(), "Invalid Edge", errorFlag);
+        return;
+    }
+
+    auto n1it = mNumToNode.find(n1);
+    auto n2it = mNumToNode.find(n2);
+    if (n1it == mNumToNode.end() || n2it == mNumToNode.end()) {
+        emitError(filename, reader.lineNumber(), "Unknown Node", errorFlag);
+        return;
+    }
+
+    auto  ep = std::make_unique<VRRectLabelEdge>();
+    auto& E  = dynamic_cast<VRRectLabelEdge&>(mG.addEdge(
+                       std::move(ep), *(*(n1it->second)), *(*(n2it->second))));
+    E.setLabelNode1Side(p1, w1, h1);
+    E.setLabelMiddle   (pm, wm, hm);
+    E.setLabelNode2Side(p2, w2, h2);
+}
+
+
+void CommandLineGraphLayouter::generateLayout()
+{
+    LayoutPipeline pipeline;
+    pipeline.setNumThreads(mNumThreads);
+    if (mTopNode != -1) {
+        pipeline.layout(mG, mLG, mNumToNode[mTopNode]);
+    }
+    else {
+        pipeline.layout(mG, mLG);
+    }
+
+    // Number the virtual nodes from the largest node number + 1.
+    long nextNum = mNumToNode.empty() ? 1 : (mMaxNodeNum + 1);
+    for (auto nit = mLG.nodes().first; nit != mLG.nodes().second; nit++) {
+        auto& N = dynamic_cast<VRRectLabelNode&>(*(*nit));
+        if (N.isVirtual()) {
+            N.pushUtility(nextNum++);
+        }
+    }
+}
+
+
+long CommandLineGraphLayouter::toLayoutNodeNum(Node& LN)
+{
+    auto& N = dynamic_cast<VRRectLabelNode&>(LN);
+    if (N.isVirtual()) {
+        return N.utility();
+    }
+    return N.IGBackwardLinkRef().utility();
+}
+
+
+void CommandLineGraphLayouter::emitCoordSpec(
+    const char* filename
+) {
+    std::ofstream   os(filename);
+    emitCoordSpec(os);
+}
+
+
+void CommandLineGraphLayouter::emitCoordSpec(std::ostream& os)
+{
+    os << "AREA\n";
+    os << mLG.width() << " " << mLG.height() << "\n";
+    os << "\n";
+    os << "NODES\n";
+    for (auto nit = mLG.nodes().first; nit != mLG.nodes().second; nit++) {
+        auto& N = dynamic_cast<VRRectLabelNode&>(*(*nit));
+        os << toLayoutNodeNum(N) << " ";
+        os << N.xLeft()  << " ";
+        os << N.xRight() << " ";
+        os << N.y() << "\n";
+    }
+    os << "\n";
+    os << "EDGES\n";
+    for (auto eit = mLG.edges().first; eit != mLG.edges().second; eit++) {
+        auto& E  = dynamic_cast<VRRectLabelEdge&>(*(*eit));
+        os << toLayoutNodeNum(E.incidentNode1()) << " ";
+        os << toLayoutNodeNum(E.incidentNode2()) << " ";
+        os << E.x()  << " ";
+        os << E.y1() << " ";
+        os << E.y2() << " ";
+        if (E.isFlipped()) {
+            os << "FLIPPED";
+        }
+        else {
+            os << "NOTFLIPPED";
+        }
+        os << "\n";
+    }
+}
+
+} // namespace Undirected
+
+} // namespace Wailea
+
+static void print_usage()
+{
+
+    std::cerr << "graph_layouter : finds a visibility representation of the given connected graph in one process\n";
+    std::cerr << "    Usage : graph_layouter [-j num_threads] <input_file> <output_file>\n";
+    std::cerr << "\n";
+    std::cerr << "    Input file format:\n";
+    std::cerr << "        TOP NODE (optional)\n";
+    std::cerr << "        [Node Num]\n";
+    std::cerr << "\n";
+    std::cerr << "        GAPS\n";
+    std::cerr << "        [W] [H]\n";
+    std::cerr << "\n";
+    std::cerr << "        NODES\n";
+    std::cerr << "        [Node Num] [Label W] [Label H]\n";
+    std::cerr << "\n";
+    std::cerr << "        EDGES\n";
+    std::cerr << "        [Node 1] [Node 2] CENTER/CW/CCW [Label1 W] [Label1 H] CENTER/CW/CCW [LabelM W] [LabelM H] CENTER/CW/CCW [Label2 W] [Label2 H]\n";
+    std::cerr << "\n";
+    std::cerr << "    Output file format:\n";
+    std::cerr << "        AREA\n";
+    std::cerr << "        [W] [H]\n";
+    std::cerr << "\n";
+    std::cerr << "        NODES\n";
+    std::cerr << "        [Node Num] [X Left] [X Right] [Y]\n";
+    std::cerr << "\n";
+    std::cerr << "        EDGES\n";
+    std::cerr << "        [Node 1] [Node 2] [X] [Y1] [Y2] FLIPPED/NOTFLIPPED\n";
+    std::cerr << "\n";
+    std::cerr << "        The virtual nodes for the crossings are numbered from (the largest node num + 1).\n";
+    std::cerr << "\n";
+    Wailea::Undirected::BatchRunner::printUsage(std::cerr, "graph_layouter");
+
+}
+
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 2 && std::string(argv[1]) == "-b") {
+        int status = Wailea::Undirected::BatchRunner::runFromCommandLine(
+            argc - 2, argv + 2,
+            [](std::istream& is, std::ostream& os, const char* name) {
+                // The specifications are already processed in parallel.
+                Wailea::Undirected::CommandLineGraphLayouter p;
+                if (!p.parseSpec(is, name)) {
+                    throw std::invalid_argument("syntax error");
+                }
+                p.generateLayout();
+                p.emitCoordSpec(os);
+            }
+        );
+        if (status == 1) {
+            print_usage();
+        }
+        return status;
+    }
+
+    size_t numThreads = 1;
+    int    argIndex   = 1;
+    if (argc >= 3 && std::string(argv[1]) == "-j") {
+        try {
+            numThreads = std::stoul(argv[2]);
+        }
+        catch (const std::exception&) {
+            print_usage();
+            return 1;
+        }
+        argIndex = 3;
+    }
+    if (argc - argIndex != 2) {
+        print_usage();
+        return 1;
+    }
+    Wailea::Undirected::CommandLineGraphLayouter p;
+    p.setNumThreads(numThreads);
+    if (!p.parseSpec(argv[argIndex])) {
+        return 1;
+    }
+    p.generateLayout();
+    p.emitCoordSpec(argv[argIndex + 1]);
+    return 0;
+}
@@ -8,6 +8,7 @@
 #include "undirected/bl_tree_node.hpp"
 #include "undirected/bl_inline.hpp"
 #include "undirected/st_numbering.hpp"
+#include "undirected/text_spec_reader.hpp"
 
 using namespace std;
 using namespace Wailea::Undirected;
@@ -39,40 +40,52 @@ int main(int argc, char *argv[]) {
 
     //std::srand( time( NULL ) );
 
-    string   filename(argv[1]);
-    ifstream gs;
-    string   oneLine;
-
-    size_t   numNodes = 0;
-    size_t   numEdges = 0;
-    gs.open (filename);;
-    if (gs.is_open()) {
+    TextSpecReader reader;
+    if (!reader.open(argv[1])) {
+        std::cerr << "Cannot open: " << argv[1] << "\n";
+        return 1;
+    }
 
-        getline(gs, oneLine);
-        stringstream lineStream(oneLine);
-        lineStream >> numNodes >> numEdges;
-    }        
+    long numNodesIn = 0;
+    long numEdgesIn = 0;
+    if (!reader.nextLine()                      ||
+        reader.split() < 2                      ||
+        !reader.token(0).toLong(numNodesIn)     ||
+        !reader.token(1).toLong(numEdgesIn)     ||
+        numNodesIn < 0 || numEdgesIn < 0          ) {
+        std::cerr << "Syntax Error: " << argv[1] << " at line: 1"
+                  << " Invalid Header\n";
+        return 1;
+    }
+    size_t numNodes = static_cast<size_t>(numNodesIn);
+    size_t numEdges = static_cast<size_t>(numEdgesIn);
 
     Graph G;
     vector <node_list_it_t> nodes;
+    nodes.reserve(numNodes);
     for (size_t i = 0; i < numNodes; i++) {
         auto& N = G.addNode(make_unique<NumNode>(i+1));
         nodes.push_back(N.backIt());
     }
     size_t cycle = 0;
-    while (getline(gs, oneLine)) {
-        if(oneLine.length()>0) {
+    while (reader.nextLine()) {
+        if (!reader.isBlank()) {
             cycle++;
-            size_t I1;
-            size_t I2;
-            stringstream lineStream(oneLine);
-            lineStream >> I1 >> I2;
+            long I1;
+            long I2;
+            if (reader.split() < 2                                  ||
+                !reader.token(0).toLong(I1)                         ||
+                !reader.token(1).toLong(I2)                         ||
+                I1 < 1 || I1 > numNodesIn || I2 < 1 || I2 > numNodesIn ) {
+                std::cerr << "Syntax Error: " << argv[1] << " at line: "
+                          << reader.lineNumber() << " Invalid Edge\n";
+                return 1;
+            }
             auto& N1 = dynamic_cast<NumNode&>(*(*nodes[I1-1]));
             auto& N2 = dynamic_cast<NumNode&>(*(*nodes[I2-1]));
             G.addEdge(make_unique<Edge>(), N1, N2);
         }
     }
-    gs.close();
 
     if (cycle != numEdges) {
         return 1;
@@ -1,10 +1,14 @@
 #include "undirected/base.hpp"
 #include "undirected/planarizable_graph.hpp"
 #include "undirected/jts_bl_gmw_planarizer.hpp"
+#include "undirected/batch_runner.hpp"
+#include "undirected/text_spec_reader.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
+#include <stdexcept>
 
 namespace Wailea {
 
@@ -38,9 +42,12 @@ class CommandLinePlanarizer {
   public:
     inline CommandLinePlanarizer():mVirtualNodeStart(0){;}
     inline virtual ~CommandLinePlanarizer(){;}
-    void parseUnplanarizedSpec(const char* filename);
+    bool parseUnplanarizedSpec(const char* filename);
+    bool parseUnplanarizedSpec(std::istream& is, const char* filename);
+    bool parseUnplanarizedSpec(TextSpecReader& reader, const char* filename);
     void generateGraphs();
     void emitPlanarizedSpec(const char* filename);
+    void emitPlanarizedSpec(std::ostream& os);
 
     class _node {public:long n; node_list_it_t it;};
     class _edge {public:long n1; long n2; edge_list_it_t it;};
@@ -56,20 +63,16 @@ class CommandLinePlanarizer {
 
     enum parseState {INIT, IN_NODES, IN_EDGES, IN_VIRTUAL_NODE_START, END};
 
-    bool isSectionHeader(std::string line, enum parseState& state);
+    bool isSectionHeader(TextSpecReader& reader, enum parseState& state);
 
-    bool isCommentLine(std::string line);
-
-    size_t splitLine(
-              const std::string& txt, std::vector<std::string>& strs, char ch);
     void handleNode(
-      std::string line, const char* filename, long lineNumber,bool& errorFlag);
-        
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
+
     void handleEdge(
-     std::string line, const char* filename, long lineNumber, bool& errorFlag);
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
 
     void handleVirtualNodeStart(
-     std::string line, const char* filename, long lineNumber, bool& errorFlag);
+           TextSpecReader& reader, const char* filename, bool& errorFlag);
 
 
     void emitError(
@@ -84,6 +87,12 @@ class CommandLinePlanarizer {
     PlanarizableGraph mGunplanarized;
     PlanarizableGraph mGplanarized;
 
+    /** @brief node number to index into mNodes */
+    std::unordered_map<long, size_t>        mNumToIndex;
+
+    /** @brief node in mGunplanarized to node number */
+    std::unordered_map<const Node*, long>   mNodeToNum;
+
 };
 
 
@@ -91,57 +100,77 @@ const std::string CommandLinePlanarizer::NODES = "NODES";
 const std::string CommandLinePlanarizer::EDGES = "EDGES";
 const std::string CommandLinePlanarizer::VIRTUAL_NODE_START = "VIRTUAL NODE START";
 
-void CommandLinePlanarizer::parseUnplanarizedSpec(const char* filename)
+bool CommandLinePlanarizer::parseUnplanarizedSpec(const char* filename)
 {
-    std::ifstream   is(filename);
-    long            lineNumber = 0;
+    TextSpecReader reader;
+    if (!reader.open(filename)) {
+        std::cerr << "Cannot open: " << filename << "\n";
+        return false;
+    }
+    return parseUnplanarizedSpec(reader, filename);
+}
+
+
+bool CommandLinePlanarizer::parseUnplanarizedSpec(
+    std::istream& is,
+    const char*   filename
+) {
+    TextSpecReader reader;
+    reader.load(is);
+    return parseUnplanarizedSpec(reader, filename);
+}
+
+
+bool CommandLinePlanarizer::parseUnplanarizedSpec(
+    TextSpecReader& reader,
+    const char*     filename
+) {
     bool            error      = false;
     enum parseState state      = INIT;
-    while (!is.eof() && !error) {
-        std::string line;
-        std::getline(is, line);
-        if (line.empty()) {continue;}
-        if ((line[line.size()-1] == '\n')||(line[line.size()- 1] == '\r')) {
-            line.erase(line.size() - 1);
-        }
-	lineNumber++;
-        if (isCommentLine(line)) {continue;}
-        if(isSectionHeader(line, state)){continue;}
+    while (!error && reader.nextLine()) {
+        if (reader.isBlank()) {continue;}
+        if (reader.isComment()) {continue;}
+        if(isSectionHeader(reader, state)){continue;}
         switch(state) {
           case INIT:
           case END:
-            emitError(filename, lineNumber, "", error);
+            emitError(filename, reader.lineNumber(), "", error);
             break;
           case IN_NODES:
-            handleNode(line, filename, lineNumber, error);
+            handleNode(reader, filename, error);
             break;
           case IN_EDGES:
-            handleEdge(line, filename, lineNumber, error);
+            handleEdge(reader, filename, error);
             break;
           case IN_VIRTUAL_NODE_START:
-            handleVirtualNodeStart(line, filename, lineNumber, error);
+            handleVirtualNodeStart(reader, filename, error);
             break;
         }
     }
+    return !error;
 }
 
 
 bool CommandLinePlanarizer::isSectionHeader(
-                                      std::string line, enum parseState& state)
-{
-    if (line.compare(0, NODES.size(), NODES)==0) {
+    TextSpecReader&  reader,
+    enum parseState& state
+) {
+    if (reader.startsWith(NODES)) {
         state = IN_NODES;
+        size_t num = mNodes.size() + reader.countSectionLines();
+        mNodes.reserve(num);
+        mNumToIndex.reserve(num);
         return true;
     }
-    else if (line.compare(0, EDGES.size(), EDGES)==0) {
+    else if (reader.startsWith(EDGES)) {
         state = IN_EDGES;
+        mEdges.reserve(mEdges.size() + reader.countSectionLines());
         return true;
     }
-    else if (line.compare(0, VIRTUAL_NODE_START.size(), VIRTUAL_NODE_START)==0) {
+    else if (reader.startsWith(VIRTUAL_NODE_START)) {
         state = IN_VIRTUAL_NODE_START;
         return true;
     }
-
     return false;
 }
 
@@ -165,108 +194,58 @@ void CommandLinePlanarizer::emitError(
 }
 
 
-bool CommandLinePlanarizer::isCommentLine(std::string line)
-{
-    return line.at(0) == '#';
-}
-
-
-size_t CommandLinePlanarizer::splitLine(
-    const std::string&        txt,
-    std::vector<std::string>& strs,
-    char                      ch
-) {
-
-    auto   pos        = txt.find( ch );
-    size_t initialPos = 0;
-
-    strs.clear();
-
-    while( pos != std::string::npos && initialPos < txt.size()) {
-
-        if (pos > initialPos) {
-            strs.push_back( txt.substr( initialPos, pos - initialPos) );
-        }
-
-        initialPos = pos + 1;
-
-        if (initialPos < txt.size()) {
-            pos = txt.find( ch, initialPos );
-        }
-
-    }
-
-    if(initialPos < txt.size()) {
-        strs.push_back( txt.substr( initialPos, txt.size() - initialPos) );
-    }
-
-    return strs.size();
-}
-
-
 void CommandLinePlanarizer::handleNode(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 1) {
-        emitError(filename, lineNumber, "Invalid Node", errorFlag);
-    }
-
     _node n;
-    n.n = std::stol(fields[0]);
+    if (reader.split() != 1 || !reader.token(0).toLong(n.n)) {
+        emitError(filename, reader.lineNumber(), "Invalid Node", errorFlag);
+        return;
+    }
+    mNumToIndex.emplace(n.n, mNodes.size());
     mNodes.push_back(n);
 }
 
 
 void CommandLinePlanarizer::handleEdge(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 2) {
-        emitError(filename, lineNumber, "Invalid Edge", errorFlag);
-    }
-
     _edge e;
-    e.n1  = std::stol(fields[0]);
-    e.n2  = std::stol(fields[1]);
+    if (reader.split() != 2                 ||
+        !reader.token(0).toLong(e.n1)       ||
+        !reader.token(1).toLong(e.n2)         ) {
+        emitError(filename, reader.lineNumber(), "Invalid Edge", errorFlag);
+        return;
+    }
     mEdges.push_back(e);
 }
 
 
 void CommandLinePlanarizer::handleVirtualNodeStart(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 1) {
-        emitError(filename, lineNumber, "Invalid Virtual Node Start", errorFlag);
+    if (reader.split() != 1 || !reader.token(0).toLong(mVirtualNodeStart)) {
+        emitError(filename, reader.lineNumber(),
+                                      "Invalid Virtual Node Start", errorFlag);
     }
-
-    mVirtualNodeStart = std::stol(fields[0]);
 }
 
 
-
 void CommandLinePlanarizer::generateGraphs()
 {
+    mNodeToNum.reserve(mNodes.size());
     for (auto& n : mNodes) {
         auto  np  = std::make_unique<PlanarizableNode>();
         auto& nr  = dynamic_cast<PlanarizableNode&>(
                                         mGunplanarized.addNode(std::move(np)));
         n.it = nr.backIt();
+        mNodeToNum[&nr] = n.n;
     }
     for (auto& e : mEdges) {
         auto  ep  = std::make_unique<PlanarizableEdge>();
@@ -283,10 +262,9 @@ void CommandLinePlanarizer::generateGraphs()
 
 PlanarizableNode& CommandLinePlanarizer::toNodeRef(long num)
 {
-    for(auto& n : mNodes) {
-      if (n.n == num) {
-            return dynamic_cast<PlanarizableNode&>(*(*n.it));
-	    }
+    auto it = mNumToIndex.find(num);
+    if (it != mNumToIndex.end()) {
+        return dynamic_cast<PlanarizableNode&>(*(*(mNodes[it->second].it)));
     }
     cerr << "ERROR toNodeRef()\n";
     return dynamic_cast<PlanarizableNode&>(*(*(mNodes[0].it)));
@@ -295,10 +273,9 @@ PlanarizableNode& CommandLinePlanarizer::toNodeRef(long num)
 
 long CommandLinePlanarizer::toNodeNum(node_list_it_t it)
 {
-    for(auto& n : mNodes) {
-        if (n.it == it) {
-            return n.n;
-        }
+    auto nit = mNodeToNum.find((*it).get());
+    if (nit != mNodeToNum.end()) {
+        return nit->second;
     }
     cerr << "ERROR toNodeNum()\n";
     return -1;
@@ -308,8 +285,15 @@ long CommandLinePlanarizer::toNodeNum(node_list_it_t it)
 void CommandLinePlanarizer::emitPlanarizedSpec(const char* filename)
 {
     std::ofstream   os(filename);
+    emitPlanarizedSpec(os);
+}
+
 
+void CommandLinePlanarizer::emitPlanarizedSpec(std::ostream& os)
+{
     vector<_node> newNodes;
+    std::unordered_map<const Node*, long> newNodeNums;
+    newNodeNums.reserve(mGplanarized.numNodes());
 
     for (auto& n : mNodes) {
         mVirtualNodeStart = std::max(mVirtualNodeStart, n.n + 1);
@@ -329,6 +313,7 @@ void CommandLinePlanarizer::emitPlanarizedSpec(const char* filename)
             n.n  = toNodeNum(N.IGBackwardLink());
         }
         newNodes.push_back(n);
+        newNodeNums[&N] = n.n;
     }
 
     class _splitEdge {public:list<long> ns;};
@@ -346,15 +331,7 @@ void CommandLinePlanarizer::emitPlanarizedSpec(const char* filename)
             _splitEdge e;
             for(auto nit : nodeList) {
 
-                for (auto& n : newNodes) {
-
-                    if (n.it == nit) {
-
-                        e.ns.push_back(n.n);
-
-                    }
-
-                }
+                e.ns.push_back(newNodeNums[(*nit).get()]);
 
             }
 
@@ -538,11 +515,30 @@ static void print_usage()
     std::cerr << "\n";
     std::cerr << "        EDGES\n";
     std::cerr << "        [Node1] [Virtual Node2]... [Virtual NodeX-1] [NodeX]\n";
+    std::cerr << "\n";
+    Wailea::Undirected::BatchRunner::printUsage(std::cerr, "planarizer");
 }
 
 
 int main(int argc, char *argv[])
 {
+    if (argc >= 2 && std::string(argv[1]) == "-b") {
+        int status = Wailea::Undirected::BatchRunner::runFromCommandLine(
+            argc - 2, argv + 2,
+            [](std::istream& is, std::ostream& os, const char* name) {
+                Wailea::Undirected::CommandLinePlanarizer p;
+                if (!p.parseUnplanarizedSpec(is, name)) {
+                    throw std::invalid_argument("syntax error");
+                }
+                p.generateGraphs();
+                p.emitPlanarizedSpec(os);
+            }
+        );
+        if (status == 1) {
+            print_usage();
+        }
+        return status;
+    }
     if (argc!=3) {
         print_usage();
         return 1;
@@ -2,10 +2,14 @@
 #include "undirected/bctree.hpp"
 #include "undirected/embedded_bctree.hpp"
 #include "undirected/vis_rep_finder.hpp"
+#include "undirected/batch_runner.hpp"
+#include "undirected/text_spec_reader.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
+#include <stdexcept>
 
 namespace Wailea {
 
@@ -64,9 +68,12 @@ class CommandLineVisRepFinder {
 
   public:
 
-    void parseSpec(const char* filename);
+    bool parseSpec(const char* filename);
+    bool parseSpec(std::istream& is, const char* filename);
+    bool parseSpec(TextSpecReader& reader, const char* filename);
     void generateVisRep();
     void emitCoordSpec(const char* filename);
+    void emitCoordSpec(std::ostream& os);
 
   private:
 
@@ -165,74 +172,65 @@ class CommandLineVisRepFinder {
 
     VRRectLabelGraph          mLG;
 
-    bool isSectionHeader(std::string line, enum parseState& state);
+    /** @brief node number to index into mNodes */
+    std::unordered_map<long, size_t>        mNumToIndex;
 
-    bool isCommentLine(std::string line);
-
-    size_t splitLine(
-        const std::string&        txt,
-        std::vector<std::string>& strs,
-        char                      ch
-    );
+    /** @brief node in mLG to node number */
+    std::unordered_map<const Node*, long>   mNodeToNum;
 
+    bool isSectionHeader(TextSpecReader& reader, enum parseState& state);
 
     void handleGaps(
-        std::string line,
-        const char* filename,
-        long        lineNumber,
-        bool&       errorFlag
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
     );
 
     void handleNode(
-        std::string line,
-        const char* filename,
-        long        lineNumber,
-        bool&       errorFlag
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
     );
 
     void handleEdge(
-        std::string line,
-        const char* filename,
-        long        lineNumber,
-        bool&       errorFlag
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
     );
 
     void handleIncidence(
-        std::string line,
-        const char* filename,
-        long        lineNumber,
-        bool&       errorFlag
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
     );
 
     void handleBlock(
-        std::string line,
-        const char* filename,
-        long        lineNumber,
-        bool&       errorFlag
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
     );
 
     void handleFace(
-        std::string line,
-        const char* filename,
-        long        lineNumber,
-        bool&       errorFlag
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
     );
 
     void handleUnificationGroup(
-        std::string line,
-        const char* filename,
-        long        lineNumber,
-        bool&       errorFlag
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
     );
 
     void handleRoot(
-        std::string line,
-        const char* filename,
-        long        lineNumber,
-        bool&       errorFlag
+        TextSpecReader& reader,
+        const char*     filename,
+        bool&           errorFlag
     );
 
-    bool strToPosType(std::string& str, pType &type);
+    bool strToPosType(const TextSpecReader::Token& token, pType &type);
+
+    bool toDimension(const TextSpecReader::Token& token, long& val);
 
 
     void emitError(
@@ -298,36 +296,41 @@ const std::string CommandLineVisRepFinder::CCW         = "CCW";
 const std::string CommandLineVisRepFinder::CW          = "CW";
 
 
-void CommandLineVisRepFinder::parseSpec(const char* filename)
+bool CommandLineVisRepFinder::parseSpec(const char* filename)
 {
+    TextSpecReader reader;
+    if (!reader.open(filename)) {
+        std::cerr << "Cannot open: " << filename << "\n";
+        return false;
+    }
+    return parseSpec(reader, filename);
+}
 
-    std::ifstream   is(filename);
-    long            lineNumber = 0;
-    bool            error      = false;
-    enum parseState state      = INIT;
-
-    while (!is.eof() && !error) {
 
-        std::string line;
+bool CommandLineVisRepFinder::parseSpec(std::istream& is, const char* filename)
+{
+    TextSpecReader reader;
+    reader.load(is);
+    return parseSpec(reader, filename);
+}
 
-        std::getline(is, line);
 
-        if (!line.empty() && line[line.size() - 1] == '\n'){
-            line.erase(line.size() - 1);
-        }
-        if (!line.empty() && line[line.size() - 1] == '\r'){
-            line.erase(line.size() - 1);
-        }
+bool CommandLineVisRepFinder::parseSpec(
+    TextSpecReader& reader,
+    const char*     filename
+) {
+    bool            error      = false;
+    enum parseState state      = INIT;
 
-        lineNumber++;
+    while (!error && reader.nextLine()) {
 
-        if (line.empty()) {
+        if (reader.isBlank()) {
             continue;
         }
-        if (isCommentLine(line)) {
+        if (reader.isComment()) {
             continue;
         }
-        if(isSectionHeader(line, state)){
+        if(isSectionHeader(reader, state)){
             continue;
         }
 
@@ -335,91 +338,101 @@ void CommandLineVisRepFinder::parseSpec(const char* filename)
 
           case INIT:
 
-            emitError(filename, lineNumber, "", error);
+            emitError(filename, reader.lineNumber(), "", error);
             break;
 
           case IN_GAPS:
 
-            handleGaps(line, filename, lineNumber, error);
+            handleGaps(reader, filename, error);
             break;
 
 
           case IN_NODES:
 
-            handleNode(line, filename, lineNumber, error);
+            handleNode(reader, filename, error);
             break;
 
           case IN_EDGES:
 
-            handleEdge(line, filename, lineNumber, error);
+            handleEdge(reader, filename, error);
             break;
 
           case IN_INCIDENCES:
 
-            handleIncidence(line, filename, lineNumber, error);
+            handleIncidence(reader, filename, error);
             break;
 
           case IN_BLOCKS:
 
-            handleBlock(line, filename, lineNumber, error);
+            handleBlock(reader, filename, error);
             break;
 
           case IN_FACES:
 
-            handleFace(line, filename, lineNumber, error);
+            handleFace(reader, filename, error);
             break;
 
           case IN_UNIFICATION_GROUPS:
 
-            handleUnificationGroup(line, filename, lineNumber, error);
+            handleUnificationGroup(reader, filename, error);
             break;
 
           case IN_ROOT:
 
-            handleRoot(line, filename, lineNumber, error);
+            handleRoot(reader, filename, error);
             break;
 
           case END:
 
-            emitError(filename, lineNumber, "", error);
+            emitError(filename, reader.lineNumber(), "", error);
             break;
         }
 
     }
+    return !error;
 }
 
 
-bool CommandLineVisRepFinder::isSectionHeader(std::string line, enum parseState& state)
-{
-    if (line.compare(0, GAPS.size(), GAPS)==0) {
+bool CommandLineVisRepFinder::isSectionHeader(
+    TextSpecReader&  reader,
+    enum parseState& state
+) {
+    if (reader.startsWith(GAPS)) {
         state = IN_GAPS;
         return true;
     }
-    else if (line.compare(0, NODES.size(), NODES)==0) {
+    else if (reader.startsWith(NODES)) {
         state = IN_NODES;
+        size_t num = mNodes.size() + reader.countSectionLines();
+        mNodes.reserve(num);
+        mNumToIndex.reserve(num);
         return true;
     }
-    else if (line.compare(0, EDGES.size(), EDGES)==0) {
+    else if (reader.startsWith(EDGES)) {
         state = IN_EDGES;
+        mEdges.reserve(mEdges.size() + reader.countSectionLines());
         return true;
     }
-    else if (line.compare(0, INCIDENCES.size(), INCIDENCES)==0) {
+    else if (reader.startsWith(INCIDENCES)) {
         state = IN_INCIDENCES;
+        mIncidences.reserve(mIncidences.size() + reader.countSectionLines());
         return true;
     }
-    else if (line.compare(0, BLOCKS.size(), BLOCKS)==0) {
+    else if (reader.startsWith(BLOCKS)) {
         state = IN_BLOCKS;
+        mBlocks.reserve(mBlocks.size() + reader.countSectionLines());
         return true;
     }
-    else if (line.compare(0, FACES.size(), FACES)==0) {
+    else if (reader.startsWith(FACES)) {
         state = IN_FACES;
+        mFaces.reserve(mFaces.size() + reader.countSectionLines());
         return true;
     }
-    else if (line.compare(0,UNIFICATION_GROUPS.size(), UNIFICATION_GROUPS)==0){
+    else if (reader.startsWith(UNIFICATION_GROUPS)) {
         state = IN_UNIFICATION_GROUPS;
         return true;
     }
-    else if (line.compare(0, ROOT.size(), ROOT)==0) {
+    else if (reader.startsWith(ROOT)) {
         state = IN_ROOT;
         return true;
     }
@@ -447,97 +460,50 @@ void CommandLineVisRepFinder::emitError(
 }
 
 
-bool CommandLineVisRepFinder::isCommentLine(std::string line)
-{
-    return line.at(0) == '#';
-}
-
-
-size_t CommandLineVisRepFinder::splitLine(
-    const std::string&        txt,
-    std::vector<std::string>& strs,
-    char                      ch
-) {
-
-    auto   pos        = txt.find( ch );
-    size_t initialPos = 0;
-
-    strs.clear();
-
-    while( pos != std::string::npos && initialPos < txt.size()) {
-
-        if (pos > initialPos) {
-            strs.push_back( txt.substr( initialPos, pos - initialPos) );
-        }
-
-        initialPos = pos + 1;
-
-        if (initialPos < txt.size()) {
-            pos = txt.find( ch, initialPos );
-        }
-
-    }
-
-    if(initialPos < txt.size()) {
-        strs.push_back( txt.substr( initialPos, txt.size() - initialPos) );
-    }
-
-    return strs.size();
-}
-
-
 void CommandLineVisRepFinder::handleGaps(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 2) {
-        emitError(filename, lineNumber, "Invalid Gaps", errorFlag);
+    if (reader.split() != 2                     ||
+        !toDimension(reader.token(0), mHgap)    ||
+        !toDimension(reader.token(1), mVgap)      ) {
+        emitError(filename, reader.lineNumber(), "Invalid Gaps", errorFlag);
     }
-
-    mHgap = std::stol(fields[0]);
-    mVgap = std::stol(fields[1]);
 }
 
 
 void CommandLineVisRepFinder::handleNode(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 3) {
-        emitError(filename, lineNumber, "Invalid Node", errorFlag);
-    }
-
     _node n;
-    n.n = std::stol(fields[0]);
-    n.w = std::stol(fields[1]);
-    n.h = std::stol(fields[2]);
+    if (reader.split() != 3                 ||
+        !reader.token(0).toLong(n.n)        ||
+        !toDimension(reader.token(1), n.w)  ||
+        !toDimension(reader.token(2), n.h)    ) {
+        emitError(filename, reader.lineNumber(), "Invalid Node", errorFlag);
+        return;
+    }
+    mNumToIndex.emplace(n.n, mNodes.size());
     mNodes.push_back(n);
 }
 
 
 bool CommandLineVisRepFinder::strToPosType(
-    std::string& str,
+    const TextSpecReader::Token& token,
     enum Wailea::Undirected::VRRectLabelEdge::posType &type
 ) {
-    if (str.compare(0, CENTER.size(), CENTER)==0) {
+    if (token.equals(CENTER)) {
         type = VRRectLabelEdge::POS_CENTER;
         return true;
     }
-    else if (str.compare(0, CCW.size(), CCW)==0) {
+    else if (token.equals(CCW)) {
         type = VRRectLabelEdge::POS_COUNTER_CLOCKWISE;
         return true;
     }
-    else if (str.compare(0, CW.size(), CW)==0) {
+    else if (token.equals(CW)) {
         type = VRRectLabelEdge::POS_CLOCKWISE;
         return true;
     }
@@ -547,182 +513,167 @@ bool CommandLineVisRepFinder::strToPosType(
 }
 
 
-void CommandLineVisRepFinder::handleEdge(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+bool CommandLineVisRepFinder::toDimension(
+    const TextSpecReader::Token& token,
+    long&                        val
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ')!= 11) {
-        emitError(filename, lineNumber, "Invalid Edge", errorFlag);
-    }
-
-    _edge e;
-    enum Wailea::Undirected::VRRectLabelEdge::posType t;
-
-    e.n1  = std::stol(fields[0]);
-    e.n2  = std::stol(fields[1]);
-
-    if (strToPosType(fields[2], t)){
-        e.p1  = t;
-    }
-    else{
-        emitError(filename, lineNumber, "Invalid Edge", errorFlag);
+    // Gaps and label sizes may be written with a fraction as in "10.0",
+    // which is truncated.
+    double d;
+    if (!token.toDouble(d)) {
+        return false;
     }
-    e.w1  = std::stol(fields[3]);
-    e.h1  = std::stol(fields[4]);
+    val = static_cast<long>(d);
+    return true;
+}
 
-    if (strToPosType(fields[5], t)){
-        e.pm  = t;
-    }
-    else{
-        emitError(filename, lineNumber, "Invalid Edge", errorFlag);
-    }
-    e.wm  = std::stol(fields[6]);
-    e.hm  = std::stol(fields[7]);
 
-    if (strToPosType(fields[8], t)){
-        e.p2  = t;
-    }
-    else{
-        emitError(filename, lineNumber, "Invalid Edge", errorFlag);
+void CommandLineVisRepFinder::handleEdge(
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
+) {
+    _edge e;
+    if (reader.split() != 11                   ||
+        !reader.token(0).toLong(e.n1)          ||
+        !reader.token(1).toLong(e.n2)          ||
+        !strToPosType(reader.token(2),  e.p1)  ||
+        !toDimension (reader.token(3),  e.w1)  ||
+        !toDimension (reader.token(4),  e.h1)  ||
+        !strToPosType(reader.token(5),  e.pm)  ||
+        !toDimension (reader.token(6),  e.wm)  ||
+        !toDimension (reader.token(7),  e.hm)  ||
+        !strToPosType(reader.token(8),  e.p2)  ||
+        !toDimension (reader.token(9),  e.w2)  ||
+        !toDimension (reader.token(10), e.h2)    ) {
+        emitError(filename, reader.lineNumber(), "Invalid Edge", errorFlag);
+        return;
     }
-    e.w2  = std::stol(fields[9]);
-    e.h2  = std::stol(fields[10]);
-
     mEdges.push_back(e);
 }
 
 
 void CommandLineVisRepFinder::handleIncidence(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ') < 2) {
-        emitError(filename, lineNumber, "Invalid Incidence", errorFlag);
-    }
-
     _incidence inc;
-
-    inc.n  = std::stol(fields[0]);
-    for (size_t i = 1; i < fields.size();i++) {
-        inc.incNodes.push_back(std::stol(fields[i]));
+    size_t     num = reader.split();
+    if (num < 2 || !reader.token(0).toLong(inc.n)) {
+        emitError(filename, reader.lineNumber(), "Invalid Incidence",
+                                                                   errorFlag);
+        return;
+    }
+    inc.incNodes.resize(num - 1);
+    for (size_t i = 1; i < num; i++) {
+        if (!reader.token(i).toLong(inc.incNodes[i-1])) {
+            emitError(filename, reader.lineNumber(), "Invalid Incidence",
+                                                                   errorFlag);
+            return;
+        }
     }
-
-    mIncidences.push_back(inc);
+    mIncidences.push_back(std::move(inc));
 }
 
 
 void CommandLineVisRepFinder::handleBlock(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-    vector<std::string> fields;
-    if (splitLine(line, fields, ' ') < 3) {
-        emitError(filename, lineNumber, "Invalid block", errorFlag);
-    }
-
     _block blk;
-    blk.b  = std::stol(fields[0]);
-    for (size_t i = 1; i < fields.size();i++) {
-        blk.nodes.push_back(std::stol(fields[i]));
+    size_t num = reader.split();
+    if (num < 3 || !reader.token(0).toLong(blk.b)) {
+        emitError(filename, reader.lineNumber(), "Invalid block", errorFlag);
+        return;
+    }
+    blk.nodes.resize(num - 1);
+    for (size_t i = 1; i < num; i++) {
+        if (!reader.token(i).toLong(blk.nodes[i-1])) {
+            emitError(filename, reader.lineNumber(), "Invalid block",
+                                                                   errorFlag);
+            return;
+        }
     }
-    mBlocks.push_back(blk);
+    mBlocks.push_back(std::move(blk));
 }
 
 
 void CommandLineVisRepFinder::handleFace(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-    if (splitLine(line, fields, ' ') < 3) {
-        emitError(filename, lineNumber, "Invalid Face", errorFlag);
-    }
-
-    _face fc;
-    fc.f  = std::stol(fields[0]);
-    for (size_t i = 1; i < fields.size();i++) {
-        fc.nodes.push_back(std::stol(fields[i]));
+    _face  fc;
+    size_t num = reader.split();
+    if (num < 3 || !reader.token(0).toLong(fc.f)) {
+        emitError(filename, reader.lineNumber(), "Invalid Face", errorFlag);
+        return;
+    }
+    fc.nodes.resize(num - 1);
+    for (size_t i = 1; i < num; i++) {
+        if (!reader.token(i).toLong(fc.nodes[i-1])) {
+            emitError(filename, reader.lineNumber(), "Invalid Face",
+                                                                   errorFlag);
+            return;
+        }
     }
-    mFaces.push_back(fc);
+    mFaces.push_back(std::move(fc));
 }
 
 
 void CommandLineVisRepFinder::handleUnificationGroup(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-    if (splitLine(line, fields, ' ') < 6) {
-
-        emitError(filename, lineNumber, "Invalid UG", errorFlag);
-    }
-    if ((fields.size() - 2) % 4 != 0) {
-
-        emitError(filename, lineNumber, "Invalid UG", errorFlag);
-    }
-
     _unificationGroup ug;
-    ug.g  = std::stol(fields[0]);
-    ug.c  = std::stol(fields[1]);
+    size_t            num = reader.split();
+    if (num < 6 || (num - 2) % 4 != 0   ||
+        !reader.token(0).toLong(ug.g)   ||
+        !reader.token(1).toLong(ug.c)     ) {
+        emitError(filename, reader.lineNumber(), "Invalid UG", errorFlag);
+        return;
+    }
 
-    for (size_t i = 2; i < fields.size();i+=4) {
+    for (size_t i = 2; i < num; i+=4) {
 
         _unificationFace uf;
-        uf.b = std::stol(fields[i]);
-        uf.f = std::stol(fields[i+1]);
-        uf.nccw = std::stol(fields[i+2]);
-        uf.ncw = std::stol(fields[i+3]);
+        if (!reader.token(i  ).toLong(uf.b)    ||
+            !reader.token(i+1).toLong(uf.f)    ||
+            !reader.token(i+2).toLong(uf.nccw) ||
+            !reader.token(i+3).toLong(uf.ncw)    ) {
+            emitError(filename, reader.lineNumber(), "Invalid UG", errorFlag);
+            return;
+        }
         ug.ufs.push_back(uf);
     }
 
-    mUnificationGroups.push_back(ug);
+    mUnificationGroups.push_back(std::move(ug));
 
 }
 
 
 void CommandLineVisRepFinder::handleRoot(
-    std::string line,
-    const char* filename,
-    long        lineNumber,
-    bool&       errorFlag
+    TextSpecReader& reader,
+    const char*     filename,
+    bool&           errorFlag
 ) {
-
-    vector<std::string> fields;
-
-    if (splitLine(line, fields, ' ') != 3) {
-        emitError(filename, lineNumber, "Invalid root", errorFlag);
+    if (reader.split() != 3                       ||
+        !reader.token(0).toLong(mRootBlock)       ||
+        !reader.token(1).toLong(mRootTopNode)     ||
+        !reader.token(2).toLong(mRootOuterFace)     ) {
+        emitError(filename, reader.lineNumber(), "Invalid root", errorFlag);
     }
-
-    mRootBlock     = std::stol(fields[0]);
-    mRootTopNode   = std::stol(fields[1]);
-    mRootOuterFace = std::stol(fields[2]);
 }
 
 
 VRRectLabelNode& CommandLineVisRepFinder::toVRRectLabelNodeRef(long num)
 {
-    for(auto& n : mNodes) {
-        if (n.n == num) {
-            return dynamic_cast<VRRectLabelNode&>(*(*n.it));
-        }
+    auto it = mNumToIndex.find(num);
+    if (it != mNumToIndex.end()) {
+        return dynamic_cast<VRRectLabelNode&>(*(*(mNodes[it->second].it)));
     }
     cerr << "ERROR toVRRectLabelNodeRef()\n";
     return dynamic_cast<VRRectLabelNode&>(*(*(mNodes[0].it)));
@@ -956,10 +907,9 @@ EmbeddedEdge& CommandLineVisRepFinder::toEmbeddedEdgeRef(
 
 long CommandLineVisRepFinder::toVRRectLabelNodeNum(node_list_it_t it)
 {
-    for(auto& n : mNodes) {
-        if (n.it == it) {
-            return n.n;
-        }
+    auto nit = mNodeToNum.find((*it).get());
+    if (nit != mNodeToNum.end()) {
+        return nit->second;
     }
     cerr << "ERROR toVRRectLabelNodeNum()\n";
     return mNodes[0].n;
@@ -1067,10 +1017,12 @@ void CommandLineVisRepFinder::generateVisRep()
     mLG.setHorizontalGap(mHgap);
     mLG.setVerticalGap(mVgap);
 
+    mNodeToNum.reserve(mNodes.size());
     for (auto& n : mNodes) {
         auto  np  = std::make_unique<VRRectLabelNode>(n.w, n.h);
         auto& nr  = dynamic_cast<VRRectLabelNode&>(mLG.addNode(std::move(np)));
         n.it = nr.backIt();
+        mNodeToNum[&nr] = n.n;
     }
 
     for (auto& e : mEdges) {
@@ -1184,7 +1136,12 @@ void CommandLineVisRepFinder::emitCoordSpec(
     const char* filename
 ) {
     std::ofstream   os(filename);
+    emitCoordSpec(os);
+}
 
+
+void CommandLineVisRepFinder::emitCoordSpec(std::ostream& os)
+{
     os << "AREA\n";
     os << mLG.width() << " " << mLG.height() << "\n";
     os << "\n";
@@ -1262,12 +1219,30 @@ static void print_usage()
     std::cerr << "        EDGES\n";
     std::cerr << "        [Node 1] [Node 2] [X] [Y1] [Y2] FLIPPED/NOTFLIPPED\n";
     std::cerr << "\n";
+    Wailea::Undirected::BatchRunner::printUsage(std::cerr, "vis_rep_finder");
 
 }
 
 
 int main(int argc, char *argv[])
 {
+    if (argc >= 2 && std::string(argv[1]) == "-b") {
+        int status = Wailea::Undirected::BatchRunner::runFromCommandLine(
+            argc - 2, argv + 2,
+            [](std::istream& is, std::ostream& os, const char* name) {
+                Wailea::Undirected::CommandLineVisRepFinder p;
+                if (!p.parseSpec(is, name)) {
+                    throw std::invalid_argument("syntax error");
+                }
+                p.generateVisRep();
+                p.emitCoordSpec(os);
+            }
+        );
+        if (status == 1) {
+            print_usage();
+        }
+        return status;
+    }
     if (argc!=3) {
         print_usage();
         return 1;
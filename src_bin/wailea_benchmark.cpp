@@ -0,0 +1,1278 @@
+#include "undirected/base.hpp"
+#include "undirected/bctree.hpp"
+#include "undirected/st_numbering.hpp"
+#include "undirected/bl_planarity_tester.hpp"
+#include "undirected/spqr_decomposer.hpp"
+#include "undirected/tree_path_finder.hpp"
+#include "undirected/static_dfs.hpp"
+#include "undirected/jts_bl_gmw_planarizer.hpp"
+#include "undirected/planar_dual_graph_maker.hpp"
+#include "undirected/embedded_bctree.hpp"
+#include "undirected/vis_rep_finder.hpp"
+#include "undirected/layout_pipeline.hpp"
+#include "directed/di_base.hpp"
+#include "directed/acyclic_ordering_finder.hpp"
+#include "directed/network_simplex.hpp"
+#include "directed/gknv_crossings_reducer.hpp"
+#include "directed/sugiyama_digraph.hpp"
+#include "directed/bk_coordinate_assigner.hpp"
+#include "directed/critical_path.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Wailea {
+
+namespace Benchmark {
+
+using namespace std;
+using namespace Wailea::Undirected;
+using namespace Wailea::Directed;
+
+/**
+ * @brief benchmark harness for the stages of the drawing pipelines.
+ *
+ * Each stage is run against generated graphs of increasing size.
+ * The size parameter S specifies the following inputs.
+ *
+ * Undirected stages:
+ *   Triangular mesh of S x S nodes from which the edges not on the comb
+ *   (the first row and all the columns) are removed randomly.
+ *   The resultant graph is planar, connected and usually has cut vertices.
+ *   The stages that require a biconnected graph take the largest block of
+ *   the mesh. The planarizer takes the largest block plus random chords.
+ *   tree_path_finder takes the comb as a tree, and finds the path between
+ *   the two bottom corners.
+ *   dfs_explorer and static_dfs_explorer run a DFS over the mesh with a
+ *   strategy that counts the nodes and the fronds, through DFSExplorer and
+ *   StaticDFSExplorer respectively.
+ *   layout_pipeline runs LayoutPipeline over the mesh with 10 x 10 node
+ *   labels.
+ *
+ * Directed stages:
+ *   acyclic_ordering_finder: random digraph of S*S nodes and 2*S*S edges
+ *                            with random costs in [1, 10].
+ *   acyclic_ordering_greedy: the same input with the greedy strategy.
+ *   network_simplex        : random transshipment problem of S*S nodes on
+ *                            a bidirectional chain plus S*S random edges.
+ *   gknv_crossings_reducer : layered digraph of S ranks of S nodes each.
+ *   bk_coordinate_assigner : the same input with unit node widths.
+ *   critical_path          : the same input with random node and edge
+ *                            lengths in [1, 10].
+ *
+ * Options of the stages:
+ *   The stages that have a parallel mode run in it if 'parallel' is set
+ *   with 'numThreads' worker threads: planarizer (SPECULATIVE_BATCH),
+ *   embedded_bctree, vis_rep_finder, layout_pipeline,
+ *   gknv_crossings_reducer and critical_path (PARALLEL). Otherwise they
+ *   run sequentially.
+ *   network_simplex uses 'pricing' and 'initialTree'.
+ *
+ * For each stage and size, the input is regenerated for every repetition
+ * outside of the measured section. The first 'warmup' repetitions are
+ * discarded.
+ *
+ * Output: one record per (stage, size) with |V|, |E|, the number of
+ * measured repetitions, min, median, p90, p99, max and mean in
+ * microseconds, the peak resident set size of the process in KB
+ * observed after the stage, and the quality of the output of the last
+ * repetition. The quality is the total cost of the feedback edges for
+ * the acyclic ordering stages, the number of the fronds for the DFS
+ * explorer stages, and -1 for the others.
+ */
+
+
+/** @brief deterministic random number generator so that the inputs are
+ *         identical across runs and machines.
+ */
+class LinearCongruentialGenerator {
+
+  public:
+
+    LinearCongruentialGenerator(uint64_t seed):mState(seed){;}
+
+    size_t next(size_t range) {
+        mState = mState * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<size_t>((mState >> 33) % range);
+    }
+
+  private:
+
+    uint64_t mState;
+};
+
+
+/** @brief undirected or directed graph in node index pairs.
+ */
+class GraphSpec {
+
+  public:
+
+    GraphSpec():mNumNodes(0){;}
+
+    size_t                       mNumNodes;
+    vector<pair<size_t,size_t> > mEdges;
+};
+
+
+class Stopwatch {
+
+  public:
+
+    void start() { mStart = chrono::steady_clock::now(); }
+
+    void stop()  { mEnd   = chrono::steady_clock::now(); }
+
+    double elapsedMicroseconds() const {
+        return chrono::duration<double, micro>(mEnd - mStart).count();
+    }
+
+  private:
+
+    chrono::steady_clock::time_point mStart;
+    chrono::steady_clock::time_point mEnd;
+};
+
+
+class BenchmarkResult {
+
+  public:
+
+    string mStage;
+    size_t mSize;
+    size_t mNumNodes;
+    size_t mNumEdges;
+    size_t mRepetitions;
+    double mMin;
+    double mMedian;
+    double mP90;
+    double mP99;
+    double mMax;
+    double mMean;
+    long   mPeakRSSKB;
+    long   mQuality;
+};
+
+
+/** @brief DFS strategy for the dfs_explorer stages.
+ */
+class DFSCountingStrategy : public DFSStrategy<Graph, Node, Edge> {
+
+  public:
+
+    DFSCountingStrategy():mNumNodes(0),mNumFronds(0){;}
+
+    void enterNode(DNode& n) override { mNumNodes++; }
+
+    void processFrond(DNode& n, DEdge& c) override { mNumFronds++; }
+
+    size_t mNumNodes;
+    size_t mNumFronds;
+};
+
+
+class PipelineBenchmark {
+
+  public:
+
+    PipelineBenchmark():
+        mWarmup(2),
+        mRepetitions(10),
+        mSeed(1),
+        mRemovalPercent(40),
+        mParallel(false),
+        mNumThreads(0),
+        mPricing(NetworkSimplex::FIRST_ELIGIBLE),
+        mInitialTree(NetworkSimplex::AUXILIARY_PROBLEM),
+        mQuality(-1){;}
+
+    vector<size_t> mSizes;
+    set<string>    mStages;
+    size_t         mWarmup;
+    size_t         mRepetitions;
+    uint64_t       mSeed;
+    size_t         mRemovalPercent;
+
+    /** @brief true if the stages run in their parallel modes. */
+    bool           mParallel;
+
+    /** @brief worker threads for the parallel modes. 0 means
+     *         std::thread::hardware_concurrency().
+     */
+    size_t         mNumThreads;
+
+    enum NetworkSimplex::pricingType     mPricing;
+    enum NetworkSimplex::initialTreeType mInitialTree;
+
+    static const vector<string> kStageNames;
+
+    void run();
+
+    void emitText(ostream& os);
+    void emitCSV(ostream& os);
+    void emitJSON(ostream& os);
+
+  private:
+
+    using stage_fn_t = function<void(Stopwatch&)>;
+
+    static constexpr long kGKNVIterations = 20;
+
+    vector<BenchmarkResult> mResults;
+
+    /** @brief set by the stage function to report the quality of its
+     *         output. Reset to -1 before each stage.
+     */
+    long                    mQuality;
+
+    bool isSelected(const string& stage);
+
+    void measure(
+        const string& stage,
+        size_t        size,
+        size_t        numNodes,
+        size_t        numEdges,
+        stage_fn_t    fn
+    );
+
+    GraphSpec makeMesh(size_t size);
+    GraphSpec makeComb(size_t size);
+    GraphSpec findLargestBlock(const GraphSpec& spec);
+    GraphSpec addChords(const GraphSpec& spec, size_t numChords);
+    GraphSpec makeRandomDigraph(size_t numNodes, size_t numEdges);
+    GraphSpec makeLayeredDigraph(size_t numRanks, size_t width);
+
+    template<class NODE, class EDGE>
+    static vector<node_list_it_t> makeGraph(const GraphSpec& spec, Graph& G);
+
+    static Node& adjacentNodeOfFirstIncidentEdge(Node& N);
+
+    void runUndirectedStages(size_t size);
+    void runDirectedStages(size_t size);
+
+    static long peakRSSKB();
+
+    static double percentile(vector<double>& sorted, double p);
+};
+
+
+const vector<string> PipelineBenchmark::kStageNames = {
+    "biconnected_decomposer",
+    "st_numbering",
+    "bl_planarity_test",
+    "bl_embedding",
+    "spqr_decomposer",
+    "tree_path_finder",
+    "dfs_explorer",
+    "static_dfs_explorer",
+    "planarizer",
+    "planar_dual_graph_maker",
+    "embedded_bctree",
+    "vis_rep_finder",
+    "layout_pipeline",
+    "acyclic_ordering_finder",
+    "acyclic_ordering_greedy",
+    "network_simplex",
+    "gknv_crossings_reducer",
+    "bk_coordinate_assigner",
+    "critical_path"
+};
+
+
+void PipelineBenchmark::run()
+{
+    for (auto size : mSizes) {
+        runUndirectedStages(size);
+        runDirectedStages(size);
+    }
+}
+
+
+bool PipelineBenchmark::isSelected(const string& stage)
+{
+    return mStages.empty() || mStages.find(stage) != mStages.end();
+}
+
+
+void PipelineBenchmark::measure(
+    const string& stage,
+    size_t        size,
+    size_t        numNodes,
+    size_t        numEdges,
+    stage_fn_t    fn
+) {
+    Stopwatch sw;
+    mQuality = -1;
+    for (size_t i = 0; i < mWarmup; i++) {
+        fn(sw);
+    }
+
+    vector<double> samples;
+    for (size_t i = 0; i < mRepetitions; i++) {
+        fn(sw);
+        samples.push_back(sw.elapsedMicroseconds());
+    }
+    sort(samples.begin(), samples.end());
+
+    BenchmarkResult r;
+    r.mStage       = stage;
+    r.mSize        = size;
+    r.mNumNodes    = numNodes;
+    r.mNumEdges    = numEdges;
+    r.mRepetitions = samples.size();
+    r.mMin         = samples.empty() ? 0.0 : samples.front();
+    r.mMedian      = percentile(samples, 50.0);
+    r.mP90         = percentile(samples, 90.0);
+    r.mP99         = percentile(samples, 99.0);
+    r.mMax         = samples.empty() ? 0.0 : samples.back();
+    double sum = 0.0;
+    for (auto s : samples) {
+        sum += s;
+    }
+    r.mMean        = samples.empty() ? 0.0 : sum / samples.size();
+    r.mPeakRSSKB   = peakRSSKB();
+    r.mQuality     = mQuality;
+    mResults.push_back(r);
+
+    cerr << "# " << stage << " size " << size << " done\n";
+}
+
+
+/** @brief nearest-rank percentile of the sorted samples.
+ */
+double PipelineBenchmark::percentile(vector<double>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(ceil(p / 100.0 * sorted.size()));
+    if (rank == 0) {
+        rank = 1;
+    }
+    return sorted[rank - 1];
+}
+
+
+long PipelineBenchmark::peakRSSKB()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+
+template<class NODE, class EDGE>
+vector<node_list_it_t> PipelineBenchmark::makeGraph(
+    const GraphSpec& spec,
+    Graph&           G
+) {
+    vector<node_list_it_t> nodes;
+    for (size_t i = 0; i < spec.mNumNodes; i++) {
+        auto& N = G.addNode(make_unique<NODE>());
+        nodes.push_back(N.backIt());
+    }
+    for (auto& e : spec.mEdges) {
+        G.addEdge(make_unique<EDGE>(), *(*nodes[e.first]), *(*nodes[e.second]));
+    }
+    return nodes;
+}
+
+
+Node& PipelineBenchmark::adjacentNodeOfFirstIncidentEdge(Node& N)
+{
+    auto& E = *(*(*(N.incidentEdges().first)));
+    return E.adjacentNode(N);
+}
+
+
+/** @brief generates a triangular mesh of size x size nodes, and removes
+ *         mRemovalPercent of the edges that are not on the comb.
+ *         The comb (the first row and all the columns) keeps the graph
+ *         connected.
+ */
+GraphSpec PipelineBenchmark::makeMesh(size_t size)
+{
+    LinearCongruentialGenerator rng(mSeed + size);
+
+    GraphSpec spec;
+    spec.mNumNodes = size * size;
+
+    for (size_t r = 0; r < size; r++) {
+        for (size_t c = 0; c < size; c++) {
+            size_t n = r * size + c;
+            if (r + 1 < size) {
+                spec.mEdges.push_back(make_pair(n, n + size));
+            }
+            if (c + 1 < size) {
+                if (r == 0 || rng.next(100) >= mRemovalPercent) {
+                    spec.mEdges.push_back(make_pair(n, n + 1));
+                }
+            }
+            if (r + 1 < size && c + 1 < size) {
+                if (rng.next(100) >= mRemovalPercent) {
+                    spec.mEdges.push_back(make_pair(n, n + size + 1));
+                }
+            }
+        }
+    }
+    return spec;
+}
+
+
+/** @brief generates the comb of the mesh of size x size nodes, i.e., the
+ *         first row and all the columns, which is a tree.
+ */
+GraphSpec PipelineBenchmark::makeComb(size_t size)
+{
+    GraphSpec spec;
+    spec.mNumNodes = size * size;
+    for (size_t r = 0; r < size; r++) {
+        for (size_t c = 0; c < size; c++) {
+            size_t n = r * size + c;
+            if (r + 1 < size) {
+                spec.mEdges.push_back(make_pair(n, n + size));
+            }
+            if (r == 0 && c + 1 < size) {
+                spec.mEdges.push_back(make_pair(n, n + 1));
+            }
+        }
+    }
+    return spec;
+}
+
+
+/** @brief returns the largest block of the given connected graph in the
+ *         compacted node indices.
+ */
+GraphSpec PipelineBenchmark::findLargestBlock(const GraphSpec& spec)
+{
+    Graph G;
+    auto  nodes = makeGraph<Node, Edge>(spec, G);
+
+    unordered_map<Node*, size_t> nodeIndices;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        nodeIndices[&(*(*nodes[i]))] = i;
+    }
+
+    BiconnectedDecomposer decomp;
+    BCTree bcTree = decomp.decompose(G, *(*nodes[0]));
+
+    Block* largest = nullptr;
+    for (auto tnit = bcTree.nodes().first; tnit != bcTree.nodes().second;
+                                                                      tnit++) {
+        auto& TN = dynamic_cast<BCTreeNode&>(*(*tnit));
+        if (TN.type() == BCTreeNode::BlockType) {
+            auto& B = TN.block();
+            if (largest == nullptr || B.numEdges() > largest->numEdges()) {
+                largest = &B;
+            }
+        }
+    }
+
+    GraphSpec blockSpec;
+    if (largest == nullptr) {
+        return blockSpec;
+    }
+
+    unordered_map<size_t, size_t> compacted;
+    for (auto bnit = largest->nodes().first;
+                                   bnit != largest->nodes().second; bnit++) {
+        auto& BN = *(*bnit);
+        size_t org = nodeIndices[&(BN.IGBackwardLinkRef())];
+        compacted[org] = blockSpec.mNumNodes++;
+    }
+    for (auto beit = largest->edges().first;
+                                   beit != largest->edges().second; beit++) {
+        auto& BE = *(*beit);
+        size_t n1 = nodeIndices[&(BE.incidentNode1().IGBackwardLinkRef())];
+        size_t n2 = nodeIndices[&(BE.incidentNode2().IGBackwardLinkRef())];
+        blockSpec.mEdges.push_back(make_pair(compacted[n1], compacted[n2]));
+    }
+    return blockSpec;
+}
+
+
+/** @brief adds random chords between non-adjacent nodes to make the graph
+ *         non-planar. The biconnectivity is preserved.
+ */
+GraphSpec PipelineBenchmark::addChords(const GraphSpec& spec, size_t numChords)
+{
+    LinearCongruentialGenerator rng(mSeed + spec.mNumNodes * 31);
+
+    GraphSpec chorded = spec;
+    set<pair<size_t,size_t> > existing;
+    for (auto& e : spec.mEdges) {
+        existing.insert(make_pair(min(e.first, e.second),
+                                  max(e.first, e.second)));
+    }
+
+    size_t maxEdges = spec.mNumNodes * (spec.mNumNodes - 1) / 2;
+    while (numChords > 0 && existing.size() < maxEdges) {
+        size_t n1 = rng.next(spec.mNumNodes);
+        size_t n2 = rng.next(spec.mNumNodes);
+        auto   key = make_pair(min(n1, n2), max(n1, n2));
+        if (n1 == n2 || existing.find(key) != existing.end()) {
+            continue;
+        }
+        existing.insert(key);
+        chorded.mEdges.push_back(key);
+        numChords--;
+    }
+    return chorded;
+}
+
+
+GraphSpec PipelineBenchmark::makeRandomDigraph(size_t numNodes, size_t numEdges)
+{
+    LinearCongruentialGenerator rng(mSeed + numNodes * 17);
+
+    GraphSpec spec;
+    spec.mNumNodes = numNodes;
+    if (numNodes < 2) {
+        return spec;
+    }
+
+    set<pair<size_t,size_t> > existing;
+    size_t maxEdges = numNodes * (numNodes - 1);
+    while (spec.mEdges.size() < numEdges && existing.size() < maxEdges) {
+        size_t src = rng.next(numNodes);
+        size_t dst = rng.next(numNodes);
+        auto   key = make_pair(src, dst);
+        if (src == dst || existing.find(key) != existing.end()) {
+            continue;
+        }
+        existing.insert(key);
+        spec.mEdges.push_back(key);
+    }
+    return spec;
+}
+
+
+/** @brief generates numRanks ranks of width nodes each. Each node except for
+ *         the ones in the last rank has up to two out-edges to the next rank.
+ *         Node i belongs to rank (i / width).
+ */
+GraphSpec PipelineBenchmark::makeLayeredDigraph(size_t numRanks, size_t width)
+{
+    LinearCongruentialGenerator rng(mSeed + numRanks * 13);
+
+    GraphSpec spec;
+    spec.mNumNodes = numRanks * width;
+    for (size_t r = 0; r + 1 < numRanks; r++) {
+        for (size_t p = 0; p < width; p++) {
+            size_t src  = r * width + p;
+            size_t dst1 = (r + 1) * width + rng.next(width);
+            size_t dst2 = (r + 1) * width + rng.next(width);
+            spec.mEdges.push_back(make_pair(src, dst1));
+            if (dst2 != dst1) {
+                spec.mEdges.push_back(make_pair(src, dst2));
+            }
+        }
+    }
+    return spec;
+}
+
+
+void PipelineBenchmark::runUndirectedStages(size_t size)
+{
+    GraphSpec mesh    = makeMesh(size);
+    GraphSpec block   = findLargestBlock(mesh);
+    GraphSpec chorded = addChords(block, block.mNumNodes / 20 + 1);
+
+    if (isSelected("biconnected_decomposer")) {
+        measure("biconnected_decomposer", size,
+                mesh.mNumNodes, mesh.mEdges.size(), [&](Stopwatch& sw) {
+            Graph G;
+            auto  nodes = makeGraph<Node, Edge>(mesh, G);
+            sw.start();
+            BiconnectedDecomposer decomp;
+            BCTree bcTree = decomp.decompose(G, *(*nodes[0]));
+            sw.stop();
+        });
+    }
+
+    if (isSelected("st_numbering")) {
+        measure("st_numbering", size,
+                block.mNumNodes, block.mEdges.size(), [&](Stopwatch& sw) {
+            Graph G;
+            auto  nodes = makeGraph<Node, Edge>(block, G);
+            auto& S     = *(*nodes[0]);
+            auto& T     = adjacentNodeOfFirstIncidentEdge(S);
+            sw.start();
+            STNumbering st;
+            vector<node_list_it_t> stOrder = st.getBipolarOrientation(G, S, T);
+            sw.stop();
+        });
+    }
+
+    if (isSelected("bl_planarity_test")) {
+        measure("bl_planarity_test", size,
+                block.mNumNodes, block.mEdges.size(), [&](Stopwatch& sw) {
+            Graph G;
+            auto  nodes = makeGraph<Node, Edge>(block, G);
+            auto& S     = *(*nodes[0]);
+            auto& T     = adjacentNodeOfFirstIncidentEdge(S);
+            STNumbering st;
+            vector<node_list_it_t> stOrder = st.getBipolarOrientation(G, S, T);
+            sw.start();
+            BLPlanarityTester tester;
+            if (!tester.isPlanar(G, stOrder)) {
+                cerr << "Nonplanar!\n";
+            }
+            sw.stop();
+        });
+    }
+
+    if (isSelected("bl_embedding")) {
+        measure("bl_embedding", size,
+                block.mNumNodes, block.mEdges.size(), [&](Stopwatch& sw) {
+            Graph G;
+            auto  nodes = makeGraph<Node, Edge>(block, G);
+            auto& S     = *(*nodes[0]);
+            auto& T     = adjacentNodeOfFirstIncidentEdge(S);
+            STNumbering st;
+            vector<node_list_it_t> stOrder = st.getBipolarOrientation(G, S, T);
+            sw.start();
+            BLPlanarityTester tester;
+            if (!tester.findEmbedding(G, stOrder)) {
+                cerr << "Nonplanar!\n";
+            }
+            sw.stop();
+        });
+    }
+
+    if (isSelected("spqr_decomposer")) {
+        measure("spqr_decomposer", size,
+                block.mNumNodes, block.mEdges.size(), [&](Stopwatch& sw) {
+            Graph G;
+            auto  nodes = makeGraph<Node, Edge>(block, G);
+            sw.start();
+            SPQRDecomposer decomp;
+            SPQRTree spqrTree = decomp.decompose(G, *(*nodes[0]));
+            sw.stop();
+        });
+    }
+
+    if (isSelected("tree_path_finder")) {
+        GraphSpec comb = makeComb(size);
+        measure("tree_path_finder", size,
+                comb.mNumNodes, comb.mEdges.size(), [&](Stopwatch& sw) {
+            Graph G;
+            auto  nodes = makeGraph<Node, Edge>(comb, G);
+            list<node_list_it_t> pathNodes;
+            list<edge_list_it_t> pathEdges;
+            sw.start();
+            TreePathFinder finder;
+            finder.findPath(G, *(*nodes[comb.mNumNodes - size]),
+                               *(*nodes[comb.mNumNodes - 1]),
+                            pathNodes, pathEdges);
+            sw.stop();
+        });
+    }
+
+    using DFSGraphT = DFSGraph<Graph, Node, Edge>;
+    using DFSNodeT  = DFSNode <Graph, Node, Edge>;
+    using DFSEdgeT  = DFSEdge <Graph, Node, Edge>;
+
+    if (isSelected("dfs_explorer")) {
+        measure("dfs_explorer", size,
+                mesh.mNumNodes, mesh.mEdges.size(), [&](Stopwatch& sw) {
+            DFSGraphT G;
+            auto  nodes = makeGraph<DFSNodeT, DFSEdgeT>(mesh, G);
+            sw.start();
+            DFSCountingStrategy                strategy;
+            DFSExplorer<Graph, Node, Edge>     explorer(G, strategy);
+            explorer.reset(G);
+            explorer.run(dynamic_cast<DFSNodeT&>(*(*nodes[0])));
+            sw.stop();
+            mQuality = strategy.mNumFronds;
+        });
+    }
+
+    if (isSelected("static_dfs_explorer")) {
+        measure("static_dfs_explorer", size,
+                mesh.mNumNodes, mesh.mEdges.size(), [&](Stopwatch& sw) {
+            DFSGraphT G;
+            auto  nodes = makeGraph<DFSNodeT, DFSEdgeT>(mesh, G);
+            sw.start();
+            DFSCountingStrategy strategy;
+            StaticDFSExplorer<Graph, Node, Edge, DFSCountingStrategy>
+                                explorer(G, strategy);
+            explorer.reset(G);
+            explorer.run(dynamic_cast<DFSNodeT&>(*(*nodes[0])));
+            sw.stop();
+            mQuality = strategy.mNumFronds;
+        });
+    }
+
+    if (isSelected("planarizer")) {
+        measure("planarizer", size,
+                chorded.mNumNodes, chorded.mEdges.size(), [&](Stopwatch& sw) {
+            PlanarizableGraph G;
+            makeGraph<PlanarizableNode, PlanarizableEdge>(chorded, G);
+            PlanarizableGraph planarizedG;
+            sw.start();
+            JTS_BL_GMW_Planarizer planarizer;
+            if (mParallel) {
+                planarizer.setInsertionMode(
+                     JTS_BL_GMW_Planarizer::SPECULATIVE_BATCH, mNumThreads);
+            }
+            planarizer.planarizeBiconnectedGraph(G, planarizedG);
+            sw.stop();
+        });
+    }
+
+    if (isSelected("planar_dual_graph_maker")) {
+        measure("planar_dual_graph_maker", size,
+                block.mNumNodes, block.mEdges.size(), [&](Stopwatch& sw) {
+            Graph G;
+            auto  nodes = makeGraph<Node, Edge>(block, G);
+            auto& S     = *(*nodes[0]);
+            auto& T     = adjacentNodeOfFirstIncidentEdge(S);
+            STNumbering st;
+            vector<node_list_it_t> stOrder = st.getBipolarOrientation(G, S, T);
+            BLPlanarityTester tester;
+            tester.findEmbedding(G, stOrder);
+            EmbeddedGraph eg;
+            DualGraph     dg;
+            sw.start();
+            PlanarDualGraphMaker maker;
+            maker.makeDualGraph(G, eg, dg);
+            sw.stop();
+        });
+    }
+
+    if (isSelected("embedded_bctree")) {
+        measure("embedded_bctree", size,
+                mesh.mNumNodes, mesh.mEdges.size(), [&](Stopwatch& sw) {
+            Graph G;
+            auto  nodes = makeGraph<Node, Edge>(mesh, G);
+            BiconnectedDecomposer decomp;
+            BCTree bcTree = decomp.decompose(G, *(*nodes[0]));
+            sw.start();
+            EmbeddedBCTree embBCTree(bcTree);
+            embBCTree.makeDefaultEmbedding(mParallel ? mNumThreads : 1);
+            embBCTree.findGeometricEmbedding();
+            sw.stop();
+        });
+    }
+
+    if (isSelected("vis_rep_finder")) {
+        measure("vis_rep_finder", size,
+                mesh.mNumNodes, mesh.mEdges.size(), [&](Stopwatch& sw) {
+            VRRectLabelGraph G;
+            vector<node_list_it_t> nodes;
+            for (size_t i = 0; i < mesh.mNumNodes; i++) {
+                auto& N = G.addNode(make_unique<VRRectLabelNode>(10, 10));
+                nodes.push_back(N.backIt());
+            }
+            for (auto& e : mesh.mEdges) {
+                G.addEdge(make_unique<VRRectLabelEdge>(),
+                          *(*nodes[e.first]), *(*nodes[e.second]));
+            }
+            BiconnectedDecomposer decomp;
+            BCTree bcTree = decomp.decompose(G, *(*nodes[0]));
+            EmbeddedBCTree embBCTree(bcTree);
+            embBCTree.makeDefaultEmbedding();
+            embBCTree.findGeometricEmbedding();
+            sw.start();
+            VisRepFinder finder(embBCTree);
+            if (mParallel) {
+                finder.setExecutionMode(VisRepFinder::PARALLEL, mNumThreads);
+            }
+            finder.find();
+            sw.stop();
+        });
+    }
+
+    if (isSelected("layout_pipeline")) {
+        measure("layout_pipeline", size,
+                mesh.mNumNodes, mesh.mEdges.size(), [&](Stopwatch& sw) {
+            VRRectLabelGraph G;
+            G.setHorizontalGap(1.0);
+            G.setVerticalGap(1.0);
+            vector<node_list_it_t> nodes;
+            for (size_t i = 0; i < mesh.mNumNodes; i++) {
+                auto& N = G.addNode(make_unique<VRRectLabelNode>(10, 10));
+                nodes.push_back(N.backIt());
+            }
+            for (auto& e : mesh.mEdges) {
+                G.addEdge(make_unique<VRRectLabelEdge>(),
+                          *(*nodes[e.first]), *(*nodes[e.second]));
+            }
+            VRRectLabelGraph LG;
+            sw.start();
+            LayoutPipeline pipeline;
+            pipeline.setNumThreads(mParallel ? mNumThreads : 1);
+            pipeline.layout(G, LG);
+            sw.stop();
+        });
+    }
+}
+
+
+void PipelineBenchmark::runDirectedStages(size_t size)
+{
+    size_t numNodes = size * size;
+
+    if (isSelected("acyclic_ordering_finder") ||
+        isSelected("acyclic_ordering_greedy")    ) {
+
+        GraphSpec spec = makeRandomDigraph(numNodes, numNodes * 2);
+        LinearCongruentialGenerator rng(mSeed + numNodes * 5);
+        vector<long> costs;
+        for (size_t i = 0; i < spec.mEdges.size(); i++) {
+            costs.push_back(static_cast<long>(rng.next(10)) + 1);
+        }
+
+        auto runFinder = [&](Stopwatch& sw, bool greedy) {
+            DiGraph G;
+            makeGraph<AOFNode, AOFEdge>(spec, G);
+            size_t index = 0;
+            for (auto eit = G.edges().first; eit != G.edges().second; eit++) {
+                dynamic_cast<AOFEdge&>(*(*eit)).setCost(costs[index++]);
+            }
+            sw.start();
+            AcyclicOrderingFinder finder(G);
+            if (greedy) {
+                finder.setStrategy(AcyclicOrderingFinder::GREEDY);
+            }
+            vector<node_list_it_t> order = finder.find();
+            sw.stop();
+            mQuality = finder.feedbackCost(order);
+        };
+
+        if (isSelected("acyclic_ordering_finder")) {
+            measure("acyclic_ordering_finder", size,
+                    spec.mNumNodes, spec.mEdges.size(), [&](Stopwatch& sw) {
+                runFinder(sw, false);
+            });
+        }
+        if (isSelected("acyclic_ordering_greedy")) {
+            measure("acyclic_ordering_greedy", size,
+                    spec.mNumNodes, spec.mEdges.size(), [&](Stopwatch& sw) {
+                runFinder(sw, true);
+            });
+        }
+    }
+
+    if (isSelected("network_simplex")) {
+        // Bidirectional chain for feasibility plus random edges.
+        GraphSpec spec = makeRandomDigraph(numNodes, numNodes);
+        for (size_t i = 0; i + 1 < numNodes; i++) {
+            spec.mEdges.push_back(make_pair(i, i + 1));
+            spec.mEdges.push_back(make_pair(i + 1, i));
+        }
+        LinearCongruentialGenerator rng(mSeed + numNodes * 7);
+        vector<long> supplies;
+        long total = 0;
+        for (size_t i = 0; i + 1 < numNodes; i++) {
+            long b = static_cast<long>(rng.next(101)) - 50;
+            supplies.push_back(b);
+            total += b;
+        }
+        supplies.push_back(-1 * total);
+        vector<long> costs;
+        for (size_t i = 0; i < spec.mEdges.size(); i++) {
+            costs.push_back(static_cast<long>(rng.next(100)) + 1);
+        }
+
+        measure("network_simplex", size,
+                spec.mNumNodes, spec.mEdges.size(), [&](Stopwatch& sw) {
+            DiGraph G;
+            makeGraph<NetworkSimplexNode, NetworkSimplexEdge>(spec, G);
+            size_t index = 0;
+            for (auto nit = G.nodes().first; nit != G.nodes().second; nit++) {
+                dynamic_cast<NetworkSimplexNode&>(*(*nit)).setB(
+                                                           supplies[index++]);
+            }
+            index = 0;
+            for (auto eit = G.edges().first; eit != G.edges().second; eit++) {
+                dynamic_cast<NetworkSimplexEdge&>(*(*eit)).setC(
+                                                              costs[index++]);
+            }
+            sw.start();
+            NetworkSimplex ns(G);
+            ns.setPricing(mPricing);
+            ns.setInitialTree(mInitialTree);
+            if (!ns.solve()) {
+                cerr << "Infeasible!\n";
+            }
+            sw.stop();
+        });
+    }
+
+    if (isSelected("gknv_crossings_reducer")) {
+        GraphSpec spec = makeLayeredDigraph(size, size);
+        measure("gknv_crossings_reducer", size,
+                spec.mNumNodes, spec.mEdges.size(), [&](Stopwatch& sw) {
+            DiGraph G;
+            auto nodes = makeGraph<DiNode, DiEdge>(spec, G);
+            vector<vector<node_list_it_t> > ranks(size);
+            for (size_t i = 0; i < nodes.size(); i++) {
+                ranks[i / size].push_back(nodes[i]);
+            }
+            sw.start();
+            GKNVcrossingsReducer reducer(G);
+            if (mParallel) {
+                reducer.setExecutionMode(GKNVcrossingsReducer::PARALLEL,
+                               GKNVcrossingsReducer::kDefaultNumRestarts,
+                               mNumThreads);
+            }
+            reducer.reduce(ranks, kGKNVIterations);
+            sw.stop();
+        });
+    }
+
+    if (isSelected("bk_coordinate_assigner")) {
+        GraphSpec spec = makeLayeredDigraph(size, size);
+        measure("bk_coordinate_assigner", size,
+                spec.mNumNodes, spec.mEdges.size(), [&](Stopwatch& sw) {
+            DiGraph G;
+            auto nodes = makeGraph<DiNode, DiEdge>(spec, G);
+            SugiyamaDiGraph SG(G);
+            SG.generateFromAcyclicOrdering(nodes);
+            vector<vector<node_list_it_t> > ranks(size);
+            for (size_t i = 0; i < nodes.size(); i++) {
+                auto& Ns = dynamic_cast<SugiyamaDiNode&>(
+                                           (*(*nodes[i])).IGForwardLinkRef());
+                Ns.setWidth(1.0);
+                ranks[i / size].push_back(Ns.backIt());
+            }
+            ranks = SG.rankNodesAndAddVirtualNodes(ranks);
+            sw.start();
+            BKCoordinateAssigner assigner(SG);
+            assigner.assign(ranks);
+            sw.stop();
+        });
+    }
+
+    if (isSelected("critical_path")) {
+        GraphSpec spec = makeLayeredDigraph(size, size);
+        LinearCongruentialGenerator rng(mSeed + numNodes * 11);
+        vector<long> nodeLengths;
+        for (size_t i = 0; i < spec.mNumNodes; i++) {
+            nodeLengths.push_back(static_cast<long>(rng.next(10)) + 1);
+        }
+        vector<long> edgeLengths;
+        for (size_t i = 0; i < spec.mEdges.size(); i++) {
+            edgeLengths.push_back(static_cast<long>(rng.next(10)) + 1);
+        }
+        measure("critical_path", size,
+                spec.mNumNodes, spec.mEdges.size(), [&](Stopwatch& sw) {
+            DiGraph G;
+            vector<node_list_it_t> nodes;
+            for (size_t i = 0; i < spec.mNumNodes; i++) {
+                auto& N = G.addNode(make_unique<CPDiNode>(nodeLengths[i]));
+                nodes.push_back(N.backIt());
+            }
+            for (size_t i = 0; i < spec.mEdges.size(); i++) {
+                auto& e = spec.mEdges[i];
+                G.addEdge(make_unique<CPDiEdge>(edgeLengths[i]),
+                          *(*nodes[e.first]), *(*nodes[e.second]));
+            }
+            sw.start();
+            CriticalPath cp;
+            if (mParallel) {
+                cp.setExecutionMode(CriticalPath::PARALLEL, mNumThreads);
+            }
+            cp.findCriticalPaths(G);
+            sw.stop();
+        });
+    }
+}
+
+
+void PipelineBenchmark::emitText(ostream& os)
+{
+    os << left  << setw(26) << "stage"
+       << right << setw(6)  << "size"
+                << setw(9)  << "|V|"
+                << setw(9)  << "|E|"
+                << setw(6)  << "reps"
+                << setw(13) << "min(us)"
+                << setw(13) << "median(us)"
+                << setw(13) << "p90(us)"
+                << setw(13) << "p99(us)"
+                << setw(13) << "max(us)"
+                << setw(13) << "mean(us)"
+                << setw(13) << "peakRSS(KB)"
+                << setw(10) << "quality" << "\n";
+    os << fixed << setprecision(1);
+    for (auto& r : mResults) {
+        os << left  << setw(26) << r.mStage
+           << right << setw(6)  << r.mSize
+                    << setw(9)  << r.mNumNodes
+                    << setw(9)  << r.mNumEdges
+                    << setw(6)  << r.mRepetitions
+                    << setw(13) << r.mMin
+                    << setw(13) << r.mMedian
+                    << setw(13) << r.mP90
+                    << setw(13) << r.mP99
+                    << setw(13) << r.mMax
+                    << setw(13) << r.mMean
+                    << setw(13) << r.mPeakRSSKB
+                    << setw(10) << r.mQuality << "\n";
+    }
+}
+
+
+void PipelineBenchmark::emitCSV(ostream& os)
+{
+    os << "stage,size,num_nodes,num_edges,repetitions,min_us,median_us,"
+          "p90_us,p99_us,max_us,mean_us,peak_rss_kb,quality\n";
+    os << fixed << setprecision(3);
+    for (auto& r : mResults) {
+        os << r.mStage       << ","
+           << r.mSize        << ","
+           << r.mNumNodes    << ","
+           << r.mNumEdges    << ","
+           << r.mRepetitions << ","
+           << r.mMin         << ","
+           << r.mMedian      << ","
+           << r.mP90         << ","
+           << r.mP99         << ","
+           << r.mMax         << ","
+           << r.mMean        << ","
+           << r.mPeakRSSKB   << ","
+           << r.mQuality     << "\n";
+    }
+}
+
+
+void PipelineBenchmark::emitJSON(ostream& os)
+{
+    os << fixed << setprecision(3);
+    os << "[\n";
+    for (size_t i = 0; i < mResults.size(); i++) {
+        auto& r = mResults[i];
+        os << "  {"
+           << "\"stage\": \""      << r.mStage       << "\", "
+           << "\"size\": "         << r.mSize        << ", "
+           << "\"num_nodes\": "    << r.mNumNodes    << ", "
+           << "\"num_edges\": "    << r.mNumEdges    << ", "
+           << "\"repetitions\": "  << r.mRepetitions << ", "
+           << "\"min_us\": "       << r.mMin         << ", "
+           << "\"median_us\": "    << r.mMedian      << ", "
+           << "\"p90_us\": "       << r.mP90         << ", "
+           << "\"p99_us\": "       << r.mP99         << ", "
+           << "\"max_us\": "       << r.mMax         << ", "
+           << "\"mean_us\": "      << r.mMean        << ", "
+           << "\"peak_rss_kb\": "  << r.mPeakRSSKB  << ", "
+           << "\"quality\": "      << r.mQuality
+           << "}" << (i + 1 < mResults.size() ? ",\n" : "\n");
+    }
+    os << "]\n";
+}
+
+
+} // namespace Benchmark
+
+} // namespace Wailea
+
+
+static void print_usage()
+{
+    std::cerr << "wailea_benchmark : measures the running time of each stage of the pipelines on generated graphs.\n";
+    std::cerr << "    Usage : wailea_benchmark [options]\n";
+    std::cerr << "\n";
+    std::cerr << "    Options:\n";
+    std::cerr << "        -s S1,S2,...  : sizes of the generated graphs. (default 8,16,32)\n";
+    std::cerr << "                        S x S nodes for each graph.\n";
+    std::cerr << "        -r N          : number of measured repetitions. (default 10)\n";
+    std::cerr << "        -w N          : number of warmup repetitions. (default 2)\n";
+    std::cerr << "        -t T1,T2,...  : stages to run. (default all)\n";
+    std::cerr << "        -f FORMAT     : text, csv, or json. (default text)\n";
+    std::cerr << "        -o FILE       : output file. (default stdout)\n";
+    std::cerr << "        -d SEED       : random seed. (default 1)\n";
+    std::cerr << "        -p PERCENT    : percentage of mesh edges removed. (default 40)\n";
+    std::cerr << "        -m MODE       : sequential or parallel. (default sequential)\n";
+    std::cerr << "                        parallel runs planarizer, embedded_bctree, vis_rep_finder,\n";
+    std::cerr << "                        layout_pipeline, gknv_crossings_reducer, and critical_path\n";
+    std::cerr << "                        in their parallel modes.\n";
+    std::cerr << "        -j N          : number of worker threads for -m parallel.\n";
+    std::cerr << "                        0 for the hardware concurrency. (default 0)\n";
+    std::cerr << "        -n PRICING    : pricing of network_simplex. first_eligible, most_negative,\n";
+    std::cerr << "                        block_search, or cyclic. (default first_eligible)\n";
+    std::cerr << "        -i INIT       : initial tree of network_simplex. auxiliary_problem,\n";
+    std::cerr << "                        feasible_tree, or strongly_feasible_tree.\n";
+    std::cerr << "                        (default auxiliary_problem)\n";
+    std::cerr << "\n";
+    std::cerr << "    Stages:\n";
+    for (auto& s : Wailea::Benchmark::PipelineBenchmark::kStageNames) {
+        std::cerr << "        " << s << "\n";
+    }
+    std::cerr << "\n";
+    std::cerr << "    Output columns:\n";
+    std::cerr << "        stage, size, |V|, |E|, repetitions, min, median, p90, p99, max, mean\n";
+    std::cerr << "        in micro seconds, peak RSS of the process in KB after the stage,\n";
+    std::cerr << "        and quality (feedback cost for the acyclic ordering stages, number of fronds\n";
+    std::cerr << "        for the DFS explorer stages, -1 otherwise).\n";
+    std::cerr << "\n";
+}
+
+
+static std::vector<std::string> split_list(const std::string& str)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.length() > 0) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+
+int main(int argc, char *argv[])
+{
+    Wailea::Benchmark::PipelineBenchmark bench;
+    std::string format = "text";
+    std::string outFile;
+
+    for (int i = 1; i < argc; i++) {
+        std::string opt(argv[i]);
+        if (opt == "-h") {
+            print_usage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            print_usage();
+            return 1;
+        }
+        std::string val(argv[++i]);
+        if (opt == "-s") {
+            for (auto& s : split_list(val)) {
+                bench.mSizes.push_back(std::stoul(s));
+            }
+        }
+        else if (opt == "-r") {
+            bench.mRepetitions = std::stoul(val);
+        }
+        else if (opt == "-w") {
+            bench.mWarmup = std::stoul(val);
+        }
+        else if (opt == "-t") {
+            for (auto& s : split_list(val)) {
+                auto& names = Wailea::Benchmark::PipelineBenchmark::kStageNames;
+                if (std::find(names.begin(), names.end(), s) == names.end()) {
+                    std::cerr << "Unknown stage: " << s << "\n";
+                    return 1;
+                }
+                bench.mStages.insert(s);
+            }
+        }
+        else if (opt == "-f") {
+            format = val;
+        }
+        else if (opt == "-o") {
+            outFile = val;
+        }
+        else if (opt == "-d") {
+            bench.mSeed = std::stoull(val);
+        }
+        else if (opt == "-p") {
+            bench.mRemovalPercent = std::min(std::stoul(val), 100UL);
+        }
+        else if (opt == "-m") {
+            if (val != "sequential" && val != "parallel") {
+                print_usage();
+                return 1;
+            }
+            bench.mParallel = (val == "parallel");
+        }
+        else if (opt == "-j") {
+            bench.mNumThreads = std::stoul(val);
+        }
+        else if (opt == "-n") {
+            using NS = Wailea::Directed::NetworkSimplex;
+            const std::unordered_map<std::string, enum NS::pricingType>
+                pricings = {
+                {"first_eligible",         NS::FIRST_ELIGIBLE},
+                {"most_negative",          NS::MOST_NEGATIVE},
+                {"block_search",           NS::BLOCK_SEARCH},
+                {"cyclic",                 NS::CYCLIC}
+            };
+            auto it = pricings.find(val);
+            if (it == pricings.end()) {
+                print_usage();
+                return 1;
+            }
+            bench.mPricing = it->second;
+        }
+        else if (opt == "-i") {
+            using NS = Wailea::Directed::NetworkSimplex;
+            const std::unordered_map<std::string, enum NS::initialTreeType>
+                initialTrees = {
+                {"auxiliary_problem",      NS::AUXILIARY_PROBLEM},
+                {"feasible_tree",          NS::FEASIBLE_TREE},
+                {"strongly_feasible_tree", NS::STRONGLY_FEASIBLE_TREE}
+            };
+            auto it = initialTrees.find(val);
+            if (it == initialTrees.end()) {
+                print_usage();
+                return 1;
+            }
+            bench.mInitialTree = it->second;
+        }
+        else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (format != "text" && format != "csv" && format != "json") {
+        print_usage();
+        return 1;
+    }
+
+    if (bench.mSizes.empty()) {
+        bench.mSizes = {8, 16, 32};
+    }
+    for (auto s : bench.mSizes) {
+        if (s < 2) {
+            std::cerr << "Size must be 2 or greater.\n";
+            return 1;
+        }
+    }
+
+    bench.run();
+
+    std::ofstream ofs;
+    if (outFile.length() > 0) {
+        ofs.open(outFile);
+    }
+    std::ostream& os = (outFile.length() > 0) ? ofs : std::cout;
+
+    if (format == "csv") {
+        bench.emitCSV(os);
+    }
+    else if (format == "json") {
+        bench.emitJSON(os);
+    }
+    else {
+        bench.emitText(os);
+    }
+    return 0;
+}
@@ -31,12 +31,12 @@ long AcyclicOrderingFinder::findCyclicRanks(long numFeedbackEdges)
     auto nPair = mG.nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 //cerr << "findCyclicRanks() 1\n";
-        auto& Ng = dynamic_cast<AOFNode&>(*(*nit));
+        auto& Ng = downcast<AOFNode>(*(*nit));
 #ifdef UNIT_TESTS
-        auto& Nn = dynamic_cast<NetworkSimplexNode&>(
+        auto& Nn = downcast<NetworkSimplexNode>(
            network.addNode(std::make_unique<NetworkSimplexNode>(Ng.mDebugId)));
 #else
-        auto& Nn = dynamic_cast<NetworkSimplexNode&>(
+        auto& Nn = downcast<NetworkSimplexNode>(
                       network.addNode(std::make_unique<NetworkSimplexNode>()));
 #endif
         Ng.pushIGForwardLink(Nn.backIt());
@@ -45,7 +45,7 @@ long AcyclicOrderingFinder::findCyclicRanks(long numFeedbackEdges)
         long cost = 0;
         auto iPairIn = Ng.incidentEdgesIn();
         for (auto iit = iPairIn.first; iit != iPairIn.second; iit++) {
-            auto& E = dynamic_cast<AOFEdge&>(*(*(*iit)));
+            auto& E = downcast<AOFEdge>(*(*(*iit)));
             cost -= E.mCost;
             if (E.mFeedbackEdge) {
                 mInfCost += E.mCost;
@@ -54,7 +54,7 @@ long AcyclicOrderingFinder::findCyclicRanks(long numFeedbackEdges)
 //cerr << "findCyclicRanks() 3\n";
         auto iPairOut = Ng.incidentEdgesOut();
         for (auto iit = iPairOut.first; iit != iPairOut.second; iit++) {
-            auto& E = dynamic_cast<AOFEdge&>(*(*(*iit)));
+            auto& E = downcast<AOFEdge>(*(*(*iit)));
             cost +=  E.mCost;
             if (E.mFeedbackEdge) {
                 mSupCost -= E.mCost;
@@ -68,14 +68,14 @@ long AcyclicOrderingFinder::findCyclicRanks(long numFeedbackEdges)
     // Create two artificial extremal nodes.
 
 #ifdef UNIT_TESTS
-    auto& Nsup = dynamic_cast<NetworkSimplexNode&>(
+    auto& Nsup = downcast<NetworkSimplexNode>(
              network.addNode(std::make_unique<NetworkSimplexNode>(10)));
-    auto& Ninf = dynamic_cast<NetworkSimplexNode&>(
+    auto& Ninf = downcast<NetworkSimplexNode>(
              network.addNode(std::make_unique<NetworkSimplexNode>(-2)));
 #else
-    auto& Nsup = dynamic_cast<NetworkSimplexNode&>(
+    auto& Nsup = downcast<NetworkSimplexNode>(
                       network.addNode(std::make_unique<NetworkSimplexNode>()));
-    auto& Ninf = dynamic_cast<NetworkSimplexNode&>(
+    auto& Ninf = downcast<NetworkSimplexNode>(
                       network.addNode(std::make_unique<NetworkSimplexNode>()));
 #endif
     Nsup.setB(mSupCost * -1);
@@ -85,22 +85,22 @@ long AcyclicOrderingFinder::findCyclicRanks(long numFeedbackEdges)
     auto ePair = mG.edges();
     for (auto eit = ePair.first; eit != ePair.second; eit++) {
 //cerr << "findCyclicRanks() 7\n";
-        auto& Eg = dynamic_cast<AOFEdge&>(*(*eit));
+        auto& Eg = downcast<AOFEdge>(*(*eit));
 
-        auto& Ngs = dynamic_cast<AOFNode&>(Eg.incidentNodeSrc());
-        auto& Ngd = dynamic_cast<AOFNode&>(Eg.incidentNodeDst());
+        auto& Ngs = downcast<AOFNode>(Eg.incidentNodeSrc());
+        auto& Ngd = downcast<AOFNode>(Eg.incidentNodeDst());
 
-        auto& Nns = dynamic_cast<NetworkSimplexNode&>(Ngs.IGForwardLinkRef());
-        auto& Nnd = dynamic_cast<NetworkSimplexNode&>(Ngd.IGForwardLinkRef());
+        auto& Nns = downcast<NetworkSimplexNode>(Ngs.IGForwardLinkRef());
+        auto& Nnd = downcast<NetworkSimplexNode>(Ngd.IGForwardLinkRef());
 
         if(Eg.mFeedbackEdge) {
 //cerr << "findCyclicRanks() 8\n";
 
             auto  ep1 = std::make_unique<NetworkSimplexEdge>();
             auto  ep2 = std::make_unique<NetworkSimplexEdge>();
-            auto& En1 = dynamic_cast<NetworkSimplexEdge&>(
+            auto& En1 = downcast<NetworkSimplexEdge>(
                                    network.addEdge(std::move(ep1), Nsup, Nns));
-            auto& En2 = dynamic_cast<NetworkSimplexEdge&>(
+            auto& En2 = downcast<NetworkSimplexEdge>(
                                    network.addEdge(std::move(ep2), Nnd, Ninf));
             En1.setC(-1);
             En2.setC(-1);
@@ -108,7 +108,7 @@ long AcyclicOrderingFinder::findCyclicRanks(long numFeedbackEdges)
         else {
 //cerr << "findCyclicRanks() 9\n";
             auto  ep = std::make_unique<NetworkSimplexEdge>();
-            auto& En = dynamic_cast<NetworkSimplexEdge&>(
+            auto& En = downcast<NetworkSimplexEdge>(
                                      network.addEdge(std::move(ep), Nnd, Nns));
             En.setC(-1);
         }
@@ -130,8 +130,8 @@ long AcyclicOrderingFinder::findCyclicRanks(long numFeedbackEdges)
 //cerr << "findCyclicRanks() 14\n";
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 //cerr << "findCyclicRanks() 15\n";
-        auto& Ng = dynamic_cast<AOFNode&>(*(*nit));
-        auto& Nn = dynamic_cast<NetworkSimplexNode&>(Ng.IGForwardLinkRef());
+        auto& Ng = downcast<AOFNode>(*(*nit));
+        auto& Nn = downcast<NetworkSimplexNode>(Ng.IGForwardLinkRef());
         Ng.mRank = Nn.y();
 //cerr << "findCyclicRanks() 16:" << Ng.mRank << "\n";
         if (nit == nPair.first) {
@@ -154,7 +154,7 @@ long AcyclicOrderingFinder::findCyclicRanks(long numFeedbackEdges)
     // Normalize the rank with zero origin.
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 //cerr << "findCyclicRanks() 20\n";
-        auto& Ng = dynamic_cast<AOFNode&>(*(*nit));
+        auto& Ng = downcast<AOFNode>(*(*nit));
         Ng.mRank -= minRank;
     }
 //cerr << "findCyclicRanks() 21\n";
@@ -167,8 +167,8 @@ long AcyclicOrderingFinder::findCyclicRanks(long numFeedbackEdges)
 // Compare utility for std::sort.
 bool AOFNode::nodeComp(node_list_it_t it1, node_list_it_t it2)
 {
-    auto& N1 = dynamic_cast<AOFNode&>(*(*it1));
-    auto& N2 = dynamic_cast<AOFNode&>(*(*it2));
+    auto& N1 = downcast<AOFNode>(*(*it1));
+    auto& N2 = downcast<AOFNode>(*(*it2));
     return N1.mCost < N2.mCost;
 }
 
@@ -186,7 +186,7 @@ vector<node_list_it_t> AcyclicOrderingFinder::serializeCyclicRanks(
 
     auto nPair = mG.nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
-        auto& N = dynamic_cast<AOFNode&>(*(*nit));
+        auto& N = downcast<AOFNode>(*(*nit));
         ranks[N.mRank].push_back(nit);
 
     }
@@ -197,7 +197,7 @@ vector<node_list_it_t> AcyclicOrderingFinder::serializeCyclicRanks(
         std::sort (rank.begin(), rank.end(), AOFNode::nodeComp);
         for (auto nit : rank) {
 
-            auto& N = dynamic_cast<AOFNode&>(*(*nit));
+            auto& N = downcast<AOFNode>(*(*nit));
             flattenedRanks.push_back(nit);
             N.mRank = index;
             index++;
@@ -220,7 +220,7 @@ size_t AcyclicOrderingFinder::findMinimumRankGap(
 //cerr << numActiveEdges << "\n";
     for (size_t i = 0; i < cyclicRanks.size(); i++) {    
 
-        auto& N = dynamic_cast<AOFNode&>(*(*(cyclicRanks[i])));
+        auto& N = downcast<AOFNode>(*(*(cyclicRanks[i])));
         numActiveEdges += N.mCost;
 //cerr << numActiveEdges << "\n";
         if (numActiveEdges < minNumActiveEdges) {
@@ -247,7 +247,7 @@ long AcyclicOrderingFinder::findFeedbackEdges()
     auto nPair = mG.nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 //cerr << "findFeedbackEdges() 2\n";
-        auto& N = dynamic_cast<AOFNode&>(*(*nit));
+        auto& N = downcast<AOFNode>(*(*nit));
         N.mVisited = false;
         N.mActive  = false;
         N.mNodeListBackIt = unvisitedNodes.insert(
@@ -259,13 +259,13 @@ long AcyclicOrderingFinder::findFeedbackEdges()
     auto ePair = mG.edges();
     for (auto eit = ePair.first; eit != ePair.second; eit++) {
 //cerr << "findFeedbackEdges() 4\n";
-        auto& E = dynamic_cast<AOFEdge&>(*(*eit));
+        auto& E = downcast<AOFEdge>(*(*eit));
         E.mFeedbackEdge = false;
     }
 
     while(unvisitedNodesSize > 0) {
 //cerr << "findFeedbackEdges() 5\n";
-        auto&R = dynamic_cast<AOFNode&>(*(*(*(unvisitedNodes.begin()))));
+        auto&R = downcast<AOFNode>(*(*(*(unvisitedNodes.begin()))));
         R.initForDFS(mG.nodes().second);
         R.mActive = true;
         unvisitedNodes.erase(R.mNodeListBackIt);
@@ -274,12 +274,12 @@ long AcyclicOrderingFinder::findFeedbackEdges()
 
         while(nodeBeingVisited != mG.nodes().second) {
 //cerr << "findFeedbackEdges() 6\n";
-            auto& N = dynamic_cast<AOFNode&>(*(*(nodeBeingVisited)));
+            auto& N = downcast<AOFNode>(*(*(nodeBeingVisited)));
 
             if (N.hasNextChild()) {
 //cerr << "findFeedbackEdges() 7\n";
                 auto& E = N.nextChild();
-                auto& A = dynamic_cast<AOFNode&>(E.adjacentNode(N));
+                auto& A = downcast<AOFNode>(E.adjacentNode(N));
                 if (!A.mVisited) {
 //cerr << "findFeedbackEdges() 8\n";
                     unvisitedNodes.erase(A.mNodeListBackIt);
@@ -310,6 +310,10 @@ long AcyclicOrderingFinder::findFeedbackEdges()
 
 vector<node_list_it_t> AcyclicOrderingFinder::find()
 {
+    if (mStrategy == GREEDY) {
+        return findByGreedy();
+    }
+
     long numFeedbackEdges                 = findFeedbackEdges();
 
     long maxRank                          = findCyclicRanks(numFeedbackEdges);
@@ -334,6 +338,184 @@ vector<node_list_it_t> AcyclicOrderingFinder::find()
     return acyclicOrdering;
 }
 
+
+vector<node_list_it_t> AcyclicOrderingFinder::findByGreedy()
+{
+    vector<node_list_it_t>           nodes;
+    vector<long>                     sources;
+    vector<long>                     sinks;
+    priority_queue<pair<long,long> > heap;
+
+    // The index of each node is kept in the utility.
+    long index = 0;
+    auto nPair = mG.nodes();
+    for (auto nit = nPair.first; nit != nPair.second; nit++) {
+        auto& N = downcast<AOFNode>(*(*nit));
+        N.pushUtility(index);
+        N.mVisited         = false;
+        N.mNumInRemaining  = N.degreeIn();
+        N.mNumOutRemaining = N.degreeOut();
+        long cost = 0;
+        auto iPairIn = N.incidentEdgesIn();
+        for (auto iit = iPairIn.first; iit != iPairIn.second; iit++) {
+            cost -= downcast<AOFEdge>(*(*(*iit))).mCost;
+        }
+        auto iPairOut = N.incidentEdgesOut();
+        for (auto iit = iPairOut.first; iit != iPairOut.second; iit++) {
+            cost += downcast<AOFEdge>(*(*(*iit))).mCost;
+        }
+        N.mCost = cost;
+        nodes.push_back(nit);
+        index++;
+    }
+
+    // Each node is pushed once to the sinks or to the sources if it has
+    // become so, and the nodes removed in the meantime are skipped.
+    // A heap entry is stale if the cost has changed since it was pushed.
+    for (long i = long(nodes.size()) - 1; i >= 0; i--) {
+        auto& N = downcast<AOFNode>(*(*nodes[i]));
+        if (N.mNumOutRemaining == 0) {
+            sinks.push_back(i);
+        }
+        else if (N.mNumInRemaining == 0) {
+            sources.push_back(i);
+        }
+        else {
+            heap.push(make_pair(N.mCost, -1 * i));
+        }
+    }
+
+    vector<node_list_it_t> leftSeq;
+    vector<node_list_it_t> rightSeq;
+    long numRemaining = long(nodes.size());
+
+    while (numRemaining > 0) {
+
+        long i;
+        bool isSink = false;
+        if (!sinks.empty()) {
+            i = sinks.back();
+            sinks.pop_back();
+            isSink = true;
+        }
+        else if (!sources.empty()) {
+            i = sources.back();
+            sources.pop_back();
+        }
+        else {
+            auto top = heap.top();
+            heap.pop();
+            i = -1 * top.second;
+            auto& N = downcast<AOFNode>(*(*nodes[i]));
+            if (N.mVisited || N.mCost != top.first) {
+                continue;
+            }
+        }
+
+        auto& N = downcast<AOFNode>(*(*nodes[i]));
+        if (N.mVisited) {
+            continue;
+        }
+        removeForGreedy(N, sources, sinks, heap);
+        numRemaining--;
+        if (isSink) {
+            rightSeq.push_back(nodes[i]);
+        }
+        else {
+            leftSeq.push_back(nodes[i]);
+        }
+    }
+
+    vector<node_list_it_t> acyclicOrdering(leftSeq.begin(), leftSeq.end());
+    acyclicOrdering.insert(
+                    acyclicOrdering.end(), rightSeq.rbegin(), rightSeq.rend());
+
+    long rank = 0;
+    for (auto nit : acyclicOrdering) {
+        auto& N = downcast<AOFNode>(*(*nit));
+        N.mRank = rank++;
+        N.popUtility();
+    }
+
+    auto ePair = mG.edges();
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto& E    = downcast<AOFEdge>(*(*eit));
+        auto& Nsrc = downcast<AOFNode>(E.incidentNodeSrc());
+        auto& Ndst = downcast<AOFNode>(E.incidentNodeDst());
+        E.mFeedbackEdge = (Nsrc.mRank >= Ndst.mRank);
+    }
+
+    return acyclicOrdering;
+}
+
+
+void AcyclicOrderingFinder::removeForGreedy(
+    AOFNode&                          N,
+    vector<long>&                     sources,
+    vector<long>&                     sinks,
+    priority_queue<pair<long,long> >& heap
+) {
+    N.mVisited = true;
+
+    auto iPairOut = N.incidentEdgesOut();
+    for (auto iit = iPairOut.first; iit != iPairOut.second; iit++) {
+        auto& E = downcast<AOFEdge>(*(*(*iit)));
+        auto& A = downcast<AOFNode>(E.incidentNodeDst());
+        if (A.mVisited) {
+            continue;
+        }
+        A.mNumInRemaining--;
+        A.mCost += E.mCost;
+        if (A.mNumInRemaining == 0) {
+            sources.push_back(long(A.utility()));
+        }
+        else if (A.mNumOutRemaining > 0) {
+            heap.push(make_pair(A.mCost, -1 * long(A.utility())));
+        }
+    }
+
+    auto iPairIn = N.incidentEdgesIn();
+    for (auto iit = iPairIn.first; iit != iPairIn.second; iit++) {
+        auto& E = downcast<AOFEdge>(*(*(*iit)));
+        auto& A = downcast<AOFNode>(E.incidentNodeSrc());
+        if (A.mVisited) {
+            continue;
+        }
+        A.mNumOutRemaining--;
+        A.mCost -= E.mCost;
+        if (A.mNumOutRemaining == 0) {
+            sinks.push_back(long(A.utility()));
+        }
+        else if (A.mNumInRemaining > 0) {
+            heap.push(make_pair(A.mCost, -1 * long(A.utility())));
+        }
+    }
+}
+
+
+long AcyclicOrderingFinder::feedbackCost(vector<node_list_it_t>& ordering)
+{
+    utility_t position = 0;
+    for (auto nit : ordering) {
+        (*nit)->pushUtility(position++);
+    }
+
+    long cost = 0;
+    auto ePair = mG.edges();
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto& E = downcast<AOFEdge>(*(*eit));
+        if (E.incidentNodeSrc().utility() >= E.incidentNodeDst().utility()) {
+            cost += E.mCost;
+        }
+    }
+
+    for (auto nit : ordering) {
+        (*nit)->popUtility();
+    }
+    return cost;
+}
+
+
 }// namespace Directed
 
 }// namespace Wailea
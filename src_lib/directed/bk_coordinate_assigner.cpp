@@ -0,0 +1,623 @@
+#include "directed/bk_coordinate_assigner.hpp"
+#include <algorithm>
+#include <limits>
+
+#ifdef UNIT_TESTS
+#include "gtest/gtest_prod.h"
+#endif
+
+
+/**
+ * @file directed/bk_coordinate_assigner.cpp
+ *
+ * @brief implementation of BKCoordinateAssigner.
+ */
+namespace Wailea {
+
+namespace Directed {
+
+using namespace std;
+
+using namespace Wailea::Directed;
+
+
+void BKCoordinateAssigner::assign(vector<vector<node_list_it_t> >& ranks)
+{
+    prepare(ranks);
+
+    if (mNodes.size() == 0) {
+        return;
+    }
+
+    markType1Conflicts();
+
+    vector<vector<double> > xs;
+    for (long i = 0; i < 4; i++) {
+        bool topDown   = (i / 2 == 0);
+        bool leftRight = (i % 2 == 0);
+        vector<long>   root;
+        vector<long>   align;
+        vector<double> x;
+        alignVertically(topDown, leftRight, root, align);
+        compactHorizontally(leftRight, root, align, x);
+        xs.push_back(std::move(x));
+    }
+
+    vector<double> x;
+    balance(xs, x);
+
+    if (mRefinement == PRIORITY_METHOD) {
+        refineByPriorityMethod(x);
+    }
+
+    double minLeft = numeric_limits<double>::max();
+    for (size_t v = 0; v < mNodes.size(); v++) {
+        minLeft = std::min(minLeft, x[v] - mWidths[v] / 2.0);
+    }
+    for (size_t v = 0; v < mNodes.size(); v++) {
+        auto& N = downcast<SugiyamaDiNode>(*(*mNodes[v]));
+        N.mX = x[v] - minLeft;
+    }
+}
+
+
+void BKCoordinateAssigner::prepare(vector<vector<node_list_it_t> >& ranks)
+{
+    mNodes.clear();
+    mLayers.clear();
+    mLayerOf.clear();
+    mPos.clear();
+    mWidths.clear();
+    mVirtual.clear();
+
+    // The utility holds (index + 1). 0 means the node is not in ranks.
+    mG.pushDefaultUtilityToNodes();
+
+    for (long i = 0; i < long(ranks.size()); i++) {
+        vector<long> layer;
+        long pos = 0;
+        for (auto nit : ranks[i]) {
+            auto& N = downcast<SugiyamaDiNode>(*(*nit));
+            long index = long(mNodes.size());
+            N.setUtility(index + 1);
+            mNodes.push_back(nit);
+            mLayerOf.push_back(i);
+            mPos.push_back(pos++);
+            mWidths.push_back(N.width());
+            mVirtual.push_back(N.isVirtual());
+            layer.push_back(index);
+        }
+        mLayers.push_back(std::move(layer));
+    }
+
+    long numNodes = long(mNodes.size());
+
+    // Count the neighbors in the previous rank.
+    mUpStart.assign(numNodes + 1, 0);
+    mDownStart.assign(numNodes + 1, 0);
+    for (long v = 0; v < numNodes; v++) {
+        auto& N = downcast<SugiyamaDiNode>(*(*mNodes[v]));
+        for (auto eit = N.incidentEdges().first;
+                                    eit != N.incidentEdges().second; eit++) {
+            auto& E = downcast<DiEdge>(*(*(*eit)));
+            auto& A = E.adjacentNode(N);
+            long  a = long(A.utility()) - 1;
+            if (a < 0) {
+                continue;
+            }
+            if (mLayerOf[a] == mLayerOf[v] - 1) {
+                mUpStart[v + 1]++;
+            }
+            else if (mLayerOf[a] == mLayerOf[v] + 1) {
+                mDownStart[v + 1]++;
+            }
+        }
+    }
+    for (long v = 0; v < numNodes; v++) {
+        mUpStart[v + 1]   += mUpStart[v];
+        mDownStart[v + 1] += mDownStart[v];
+    }
+
+    // Fill the upper neighbors by scanning each rank in order, so that
+    // each list is sorted by the positions.
+    mUpNodes.assign(mUpStart[numNodes], 0);
+    vector<long> fill(mUpStart.begin(), mUpStart.end() - 1);
+    for (auto& layer : mLayers) {
+        for (auto u : layer) {
+            auto& N = downcast<SugiyamaDiNode>(*(*mNodes[u]));
+            for (auto eit = N.incidentEdges().first;
+                                    eit != N.incidentEdges().second; eit++) {
+                auto& E = downcast<DiEdge>(*(*(*eit)));
+                auto& A = E.adjacentNode(N);
+                long  v = long(A.utility()) - 1;
+                if (v >= 0 && mLayerOf[v] == mLayerOf[u] + 1) {
+                    mUpNodes[fill[v]++] = u;
+                }
+            }
+        }
+    }
+
+    // Fill the lower neighbors in the same way from the upper neighbors.
+    mDownNodes.assign(mDownStart[numNodes], 0);
+    mDownUpIndex.assign(mDownStart[numNodes], 0);
+    fill.assign(mDownStart.begin(), mDownStart.end() - 1);
+    for (auto& layer : mLayers) {
+        for (auto v : layer) {
+            for (long j = mUpStart[v]; j < mUpStart[v + 1]; j++) {
+                long u = mUpNodes[j];
+                mDownNodes[fill[u]]   = v;
+                mDownUpIndex[fill[u]] = j;
+                fill[u]++;
+            }
+        }
+    }
+
+    mMarked.assign(mUpNodes.size(), false);
+
+    mG.popUtilityFromNodes();
+}
+
+
+void BKCoordinateAssigner::markType1Conflicts()
+{
+    for (long i = 0; i + 1 < long(mLayers.size()); i++) {
+
+        auto& upper = mLayers[i];
+        auto& lower = mLayers[i + 1];
+        long  k0    = 0;
+        long  l     = 0;
+
+        for (long l1 = 0; l1 < long(lower.size()); l1++) {
+
+            long v     = lower[l1];
+            long inner = -1;
+            if (mVirtual[v]) {
+                for (long j = mUpStart[v]; j < mUpStart[v + 1]; j++) {
+                    if (mVirtual[mUpNodes[j]]) {
+                        inner = mUpNodes[j];
+                        break;
+                    }
+                }
+            }
+
+            if (l1 == long(lower.size()) - 1 || inner != -1) {
+
+                long k1 = (inner != -1) ? mPos[inner] : long(upper.size()) - 1;
+
+                for (; l <= l1; l++) {
+                    long w = lower[l];
+                    for (long j = mUpStart[w]; j < mUpStart[w + 1]; j++) {
+                        long u = mUpNodes[j];
+                        long k = mPos[u];
+                        bool isInner = mVirtual[u] && mVirtual[w];
+                        if ((k < k0 || k > k1) && !isInner) {
+                            mMarked[j] = true;
+                        }
+                    }
+                }
+                k0 = k1;
+            }
+        }
+    }
+}
+
+
+long BKCoordinateAssigner::predecessor(long v, bool leftRight)
+{
+    auto& layer = mLayers[mLayerOf[v]];
+    if (leftRight) {
+        return (mPos[v] > 0) ? layer[mPos[v] - 1] : -1;
+    }
+    else {
+        return (mPos[v] < long(layer.size()) - 1) ? layer[mPos[v] + 1] : -1;
+    }
+}
+
+
+void BKCoordinateAssigner::alignVertically(
+    bool          topDown,
+    bool          leftRight,
+    vector<long>& root,
+    vector<long>& align
+) {
+    long numNodes  = long(mNodes.size());
+    long numLayers = long(mLayers.size());
+
+    root.resize(numNodes);
+    align.resize(numNodes);
+    for (long v = 0; v < numNodes; v++) {
+        root[v]  = v;
+        align[v] = v;
+    }
+
+    for (long li = 1; li < numLayers; li++) {
+
+        auto& layer = mLayers[topDown ? li : numLayers - 1 - li];
+        long  width = long(layer.size());
+        long  r     = -1;
+
+        for (long k = 0; k < width; k++) {
+
+            long v = layer[leftRight ? k : width - 1 - k];
+
+            long start = topDown ? mUpStart[v]     : mDownStart[v];
+            long end   = topDown ? mUpStart[v + 1] : mDownStart[v + 1];
+            long d     = end - start;
+            if (d == 0) {
+                continue;
+            }
+
+            long medians[2] = { (d - 1) / 2, d / 2 };
+            for (long m = 0; m < 2; m++) {
+
+                if (m == 1 && medians[1] == medians[0]) {
+                    break;
+                }
+                if (align[v] != v) {
+                    break;
+                }
+                long j = leftRight ? start + medians[m] : end - 1 - medians[m];
+                long u = topDown ? mUpNodes[j] : mDownNodes[j];
+                bool marked = topDown ? mMarked[j] : mMarked[mDownUpIndex[j]];
+                long posU = leftRight ?
+                    mPos[u] : long(mLayers[mLayerOf[u]].size()) - 1 - mPos[u];
+                if (!marked && r < posU) {
+                    align[u] = v;
+                    root[v]  = root[u];
+                    align[v] = root[v];
+                    r        = posU;
+                }
+            }
+        }
+    }
+}
+
+
+void BKCoordinateAssigner::compactHorizontally(
+    bool            leftRight,
+    vector<long>&   root,
+    vector<long>&   align,
+    vector<double>& x
+) {
+    long numNodes = long(mNodes.size());
+
+    vector<long>   sink(numNodes);
+    vector<bool>   placed(numNodes, false);
+    vector<double> xb(numNodes, 0.0);
+    for (long v = 0; v < numNodes; v++) {
+        sink[v] = v;
+    }
+
+    // Pair of adjacent nodes in different classes. It requires
+    // shift[sink[root[p]]] <= shift[sink[root[w]]] + xb[root[w]] -
+    // xb[root[p]] - separation(p, w), which is evaluated after all the
+    // blocks are placed.
+    class ClassConstraint {
+      public:
+        long mP;
+        long mW;
+    };
+    vector<ClassConstraint> constraints;
+
+    // The frames of place_block() in [BK]. The child flag indicates that
+    // the block of the predecessor of mW has been pushed.
+    class Frame {
+      public:
+        long mV;
+        long mW;
+        bool mChild;
+    };
+    vector<Frame> frames;
+
+    for (auto& layer : mLayers) {
+        for (long k = 0; k < long(layer.size()); k++) {
+
+            long r = layer[leftRight ? k : long(layer.size()) - 1 - k];
+            if (root[r] != r || placed[r]) {
+                continue;
+            }
+            placed[r] = true;
+            frames.push_back(Frame{r, r, false});
+
+            while (!frames.empty()) {
+
+                auto& f = frames.back();
+                long  v = f.mV;
+                long  w = f.mW;
+                long  p = predecessor(w, leftRight);
+
+                if (p != -1) {
+                    long u = root[p];
+                    if (!f.mChild && !placed[u]) {
+                        f.mChild  = true;
+                        placed[u] = true;
+                        frames.push_back(Frame{u, u, false});
+                        continue;
+                    }
+                    if (sink[v] == v) {
+                        sink[v] = sink[u];
+                    }
+                    if (sink[v] != sink[u]) {
+                        constraints.push_back(ClassConstraint{p, w});
+                    }
+                    else {
+                        xb[v] = std::max(xb[v], xb[u] + separation(p, w));
+                    }
+                }
+
+                f.mChild = false;
+                f.mW     = align[w];
+                if (f.mW == v) {
+                    frames.pop_back();
+                }
+            }
+        }
+    }
+
+    // Shift the classes in the topological order from the right.
+    vector<long> numPending(numNodes, 0);
+    vector<vector<long> > constraintsOfRight(numNodes);
+    for (long i = 0; i < long(constraints.size()); i++) {
+        numPending[sink[root[constraints[i].mP]]]++;
+        constraintsOfRight[sink[root[constraints[i].mW]]].push_back(i);
+    }
+
+    const double inf = numeric_limits<double>::max();
+    vector<double> shift(numNodes, inf);
+    vector<long>   queue;
+    long numClasses = 0;
+    for (long v = 0; v < numNodes; v++) {
+        if (root[v] == v && sink[v] == v) {
+            numClasses++;
+            if (numPending[v] == 0) {
+                queue.push_back(v);
+            }
+        }
+    }
+    long numDone = 0;
+    while (!queue.empty()) {
+        long c = queue.back();
+        queue.pop_back();
+        numDone++;
+        if (shift[c] == inf) {
+            shift[c] = 0.0;
+        }
+        for (auto i : constraintsOfRight[c]) {
+            long p = constraints[i].mP;
+            long w = constraints[i].mW;
+            long l = sink[root[p]];
+            shift[l] = std::min(shift[l], shift[c] + xb[root[w]] -
+                                          xb[root[p]] - separation(p, w));
+            if (--numPending[l] == 0) {
+                queue.push_back(l);
+            }
+        }
+    }
+
+    if (numDone < numClasses) {
+        compactByLongestPaths(leftRight, root, x);
+        return;
+    }
+
+    x.resize(numNodes);
+    for (long v = 0; v < numNodes; v++) {
+        long   r  = root[v];
+        double xv = xb[r] + shift[sink[r]];
+        x[v] = leftRight ? xv : -1.0 * xv;
+    }
+}
+
+
+void BKCoordinateAssigner::compactByLongestPaths(
+    bool            leftRight,
+    vector<long>&   root,
+    vector<double>& x
+) {
+    long numNodes = long(mNodes.size());
+
+    vector<long> numPending(numNodes, 0);
+    vector<vector<long> > successors(numNodes);
+    for (long w = 0; w < numNodes; w++) {
+        long p = predecessor(w, leftRight);
+        if (p != -1) {
+            successors[p].push_back(w);
+            numPending[root[w]]++;
+        }
+    }
+
+    vector<double> xb(numNodes, 0.0);
+    vector<long>   queue;
+    for (long v = 0; v < numNodes; v++) {
+        if (root[v] == v && numPending[v] == 0) {
+            queue.push_back(v);
+        }
+    }
+    // Visit the blocks in the topological order. Each block is released
+    // when the blocks of all the predecessors of its nodes are placed.
+    vector<vector<long> > members(numNodes);
+    for (long v = 0; v < numNodes; v++) {
+        members[root[v]].push_back(v);
+    }
+    while (!queue.empty()) {
+        long b = queue.back();
+        queue.pop_back();
+        for (auto p : members[b]) {
+            for (auto w : successors[p]) {
+                long c = root[w];
+                xb[c] = std::max(xb[c], xb[b] + separation(p, w));
+                if (--numPending[c] == 0) {
+                    queue.push_back(c);
+                }
+            }
+        }
+    }
+
+    x.resize(numNodes);
+    for (long v = 0; v < numNodes; v++) {
+        double xv = xb[root[v]];
+        x[v] = leftRight ? xv : -1.0 * xv;
+    }
+}
+
+
+void BKCoordinateAssigner::balance(
+    vector<vector<double> >& xs,
+    vector<double>&          x
+) {
+    long numNodes = long(mNodes.size());
+
+    vector<double> minLeft(4,  numeric_limits<double>::max());
+    vector<double> maxRight(4, numeric_limits<double>::lowest());
+    for (long i = 0; i < 4; i++) {
+        for (long v = 0; v < numNodes; v++) {
+            minLeft[i]  = std::min(minLeft[i],  xs[i][v] - mWidths[v] / 2.0);
+            maxRight[i] = std::max(maxRight[i], xs[i][v] + mWidths[v] / 2.0);
+        }
+    }
+
+    long smallest = 0;
+    for (long i = 1; i < 4; i++) {
+        if (maxRight[i] - minLeft[i] < maxRight[smallest] - minLeft[smallest]){
+            smallest = i;
+        }
+    }
+
+    // The left-right layouts are aligned at the left end, and the
+    // right-left ones at the right end.
+    for (long i = 0; i < 4; i++) {
+        double d = (i % 2 == 0) ? minLeft[smallest]  - minLeft[i]
+                                : maxRight[smallest] - maxRight[i];
+        for (long v = 0; v < numNodes; v++) {
+            xs[i][v] += d;
+        }
+    }
+
+    x.resize(numNodes);
+    for (long v = 0; v < numNodes; v++) {
+        double vals[4] = { xs[0][v], xs[1][v], xs[2][v], xs[3][v] };
+        std::sort(vals, vals + 4);
+        x[v] = (vals[1] + vals[2]) / 2.0;
+    }
+
+    if (!isValidLayout(x)) {
+        x = xs[smallest];
+    }
+}
+
+
+bool BKCoordinateAssigner::isValidLayout(vector<double>& x)
+{
+    const double eps = 1.0e-9;
+    for (auto& layer : mLayers) {
+        for (long k = 1; k < long(layer.size()); k++) {
+            long u = layer[k - 1];
+            long v = layer[k];
+            if (x[v] - x[u] < separation(u, v) - eps) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+void BKCoordinateAssigner::refineByPriorityMethod(vector<double>& x)
+{
+    long numLayers   = long(mLayers.size());
+    long maxPriority = long(mNodes.size()) + 1;
+
+    for (size_t s = 0; s < mNumRefinementSweeps; s++) {
+
+        bool down = (s % 2 == 0);
+
+        for (long li = 1; li < numLayers; li++) {
+
+            auto& layer = mLayers[down ? li : numLayers - 1 - li];
+            long  width = long(layer.size());
+
+            vector<long> priority(width);
+            vector<long> order(width);
+            for (long k = 0; k < width; k++) {
+                long v = layer[k];
+                long d = down ? (mUpStart[v + 1] - mUpStart[v])
+                              : (mDownStart[v + 1] - mDownStart[v]);
+                priority[k] = mVirtual[v] ? maxPriority : d;
+                order[k]    = k;
+            }
+            std::stable_sort(order.begin(), order.end(),
+                    [&priority](long a, long b) {
+                        return priority[a] > priority[b];
+                    });
+
+            vector<bool> processed(width, false);
+            for (auto k : order) {
+
+                long v     = layer[k];
+                long start = down ? mUpStart[v]     : mDownStart[v];
+                long end   = down ? mUpStart[v + 1] : mDownStart[v + 1];
+                processed[k] = true;
+                if (start == end) {
+                    continue;
+                }
+
+                double target = 0.0;
+                for (long j = start; j < end; j++) {
+                    target += x[down ? mUpNodes[j] : mDownNodes[j]];
+                }
+                target /= double(end - start);
+
+                if (target > x[v]) {
+                    // The processed nodes have higher priorities and are
+                    // not pushed.
+                    double limit = target - x[v];
+                    double req   = 0.0;
+                    for (long r = k + 1; r < width; r++) {
+                        req += separation(layer[r - 1], layer[r]);
+                        if (processed[r]) {
+                            limit = std::min(limit, x[layer[r]] - req - x[v]);
+                            break;
+                        }
+                    }
+                    if (limit > 0.0) {
+                        x[v] += limit;
+                        for (long r = k + 1; r < width; r++) {
+                            double need = x[layer[r - 1]] +
+                                          separation(layer[r - 1], layer[r]);
+                            if (x[layer[r]] >= need) {
+                                break;
+                            }
+                            x[layer[r]] = need;
+                        }
+                    }
+                }
+                else if (target < x[v]) {
+                    double limit = x[v] - target;
+                    double req   = 0.0;
+                    for (long r = k - 1; r >= 0; r--) {
+                        req += separation(layer[r], layer[r + 1]);
+                        if (processed[r]) {
+                            limit = std::min(limit, x[v] - req - x[layer[r]]);
+                            break;
+                        }
+                    }
+                    if (limit > 0.0) {
+                        x[v] -= limit;
+                        for (long r = k - 1; r >= 0; r--) {
+                            double need = x[layer[r + 1]] -
+                                          separation(layer[r], layer[r + 1]);
+                            if (x[layer[r]] <= need) {
+                                break;
+                            }
+                            x[layer[r]] = need;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+}// namespace Directed
+
+}// namespace Wailea
@@ -1,4 +1,8 @@
 #include "directed/critical_path.hpp"
+#include "undirected/parallel_for.hpp"
+
+#include <algorithm>
+#include <queue>
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -27,125 +31,373 @@ using namespace Wailea::Undirected;
 
 void CriticalPath::findCriticalPaths(DiGraph& D) {
 
-    findTerminals(D);
+    mGraph = &D;
+    mChangedNodes.clear();
+    mChangedEdges.clear();
+
+    findTopologicalOrder(D);
 
-    resetForForwardPath1(D);
+    performForwardPath(true);
 
-    long latestStart = performForwardPath(D);
+    mMaxEarliestStart = findMaxEarliestStart();
 
-    resetForBackwardPath(D, latestStart);
+    performBackwardPath();
 
-    performBackwardPath(D);
+    performForwardPath(false);
 
-    resetForForwardPath2(D);
+}
 
-    performForwardPath(D);
 
+void CriticalPath::setNodeLength(CPDiNode& N, long length)
+{
+    if (mGraph == nullptr || &(N.graph()) != mGraph) {
+        throw std::invalid_argument(Constants::kExceptionNodeNotInGraph);
+    }
+    N.mLength = length;
+    mChangedNodes.push_back(&N);
 }
 
 
-void CriticalPath::findTerminals(DiGraph& D) {
-    for (auto nit = D.nodes().first; nit != D.nodes().second; nit++) {
-        auto& N = dynamic_cast<CPDiNode&>(*(*nit));
-        if (N.degreeIn() == 0) {
-             mSources.push_back(nit);
+void CriticalPath::setEdgeLength(CPDiEdge& E, long length)
+{
+    if (mGraph == nullptr || &(E.graph()) != mGraph) {
+        throw std::invalid_argument(Constants::kExceptionEdgeNotInGraph);
+    }
+    E.mLength = length;
+    mChangedEdges.push_back(&E);
+}
+
+
+void CriticalPath::updateCriticalPaths()
+{
+    if (mChangedNodes.empty() && mChangedEdges.empty()) {
+        return;
+    }
+
+    // First forward BFS from the nodes after the changed lengths.
+    vector<CPDiNode*> seeds;
+    for (auto* N : mChangedNodes) {
+        for (auto eit = N->incidentEdgesOut().first;
+                                  eit != N->incidentEdgesOut().second; eit++) {
+            auto& E = downcast<CPDiEdge>(*(*(*eit)));
+            seeds.push_back(&downcast<CPDiNode>(E.adjacentNode(*N)));
+        }
+    }
+    for (auto* E : mChangedEdges) {
+        seeds.push_back(&downcast<CPDiNode>(E->incidentNodeDst()));
+    }
+    vector<pair<CPDiNode*, long>> changedInitial;
+    propagateForward(seeds, true, changedInitial);
+
+    // If the node that had the latest earliest start time has become
+    // earlier, the new one can be anywhere.
+    long oldMax = mMaxEarliestStart;
+    bool rescan = false;
+    for (auto& c : changedInitial) {
+        auto& N = *(c.first);
+        if (mMaxEarliestStart < N.mInitialEarliestStart) {
+            mMaxEarliestStart = N.mInitialEarliestStart;
+        }
+        else if (c.second == oldMax && N.mInitialEarliestStart < oldMax) {
+            rescan = true;
+        }
+    }
+    if (rescan) {
+        mMaxEarliestStart = findMaxEarliestStart();
+    }
+
+    // Backward BFS from the nodes before the changed lengths and the
+    // destinations whose earliest start times have changed.
+    seeds.clear();
+    for (auto* N : mChangedNodes) {
+        seeds.push_back(N);
+    }
+    for (auto* E : mChangedEdges) {
+        seeds.push_back(&downcast<CPDiNode>(E->incidentNodeSrc()));
+    }
+    for (auto& c : changedInitial) {
+        if (c.first->degreeOut() == 0) {
+            seeds.push_back(c.first);
+        }
+    }
+    if (mMaxEarliestStart != oldMax) {
+        // The latest start time is min(mMaxEarliestStart, the value from
+        // the successors).
+        for (auto* N : mOrder) {
+            if (N->degreeOut() > 0 && (N->mLatestStart == oldMax ||
+                                       N->mLatestStart > mMaxEarliestStart)) {
+                seeds.push_back(N);
+            }
         }
-        if (N.degreeOut() == 0) {
-             mDestinations.push_back(nit);
+    }
+    vector<CPDiNode*> changedLatest;
+    propagateBackward(seeds, changedLatest);
+
+    // Second forward BFS from the nodes after the changed lengths and the
+    // sources whose latest start times have changed.
+    seeds.clear();
+    for (auto* N : mChangedNodes) {
+        for (auto eit = N->incidentEdgesOut().first;
+                                  eit != N->incidentEdgesOut().second; eit++) {
+            auto& E = downcast<CPDiEdge>(*(*(*eit)));
+            seeds.push_back(&downcast<CPDiNode>(E.adjacentNode(*N)));
+        }
+    }
+    for (auto* E : mChangedEdges) {
+        seeds.push_back(&downcast<CPDiNode>(E->incidentNodeDst()));
+    }
+    for (auto* N : changedLatest) {
+        if (N->degreeIn() == 0) {
+            seeds.push_back(N);
         }
     }
+    vector<pair<CPDiNode*, long>> changedFinal;
+    propagateForward(seeds, false, changedFinal);
+
+    mChangedNodes.clear();
+    mChangedEdges.clear();
 }
 
 
-void CriticalPath::resetForForwardPath1(DiGraph& D) {
+void CriticalPath::findTopologicalOrder(DiGraph& D) {
+
+    mOrder.clear();
+    mLevelBegins.clear();
+
     for (auto nit = D.nodes().first; nit != D.nodes().second; nit++) {
-        auto& N = dynamic_cast<CPDiNode&>(*(*nit));
+        auto& N = downcast<CPDiNode>(*(*nit));
         N.mNumNeighborsProcessed = 0;
-        N.mEarliestStart = 0;
+        N.mOrder = D.numNodes();
+        if (N.degreeIn() == 0) {
+            mOrder.push_back(&N);
+        }
     }
-}
 
+    // Check the types here, as the worker threads must not throw.
+    for (auto eit = D.edges().first; eit != D.edges().second; eit++) {
+        downcast<CPDiEdge>(*(*eit));
+    }
 
-void CriticalPath::resetForForwardPath2(DiGraph& D) {
-    for (auto nit = D.nodes().first; nit != D.nodes().second; nit++) {
-        auto& N = dynamic_cast<CPDiNode&>(*(*nit));
-        N.mNumNeighborsProcessed = 0;
-        if (N.degreeIn() > 0) {
-            N.mEarliestStart = 0;
-        } 
-        else {
-            N.mEarliestStart = N.mLatestStart;
+    size_t begin = 0;
+    while (begin < mOrder.size()) {
+        size_t end = mOrder.size();
+        mLevelBegins.push_back(begin);
+        for (size_t i = begin; i < end; i++) {
+            auto& N = *(mOrder[i]);
+            N.mOrder = i;
+            for (auto eit = N.incidentEdgesOut().first;
+                                   eit != N.incidentEdgesOut().second; eit++) {
+                auto& E = downcast<CPDiEdge>(*(*(*eit)));
+                auto& A = downcast<CPDiNode>(E.adjacentNode(N));
+                A.mNumNeighborsProcessed++;
+                if (A.mNumNeighborsProcessed == A.degreeIn()) {
+                    mOrder.push_back(&A);
+                }
+            }
         }
+        begin = end;
     }
+    mLevelBegins.push_back(mOrder.size());
+
+    mQueued.assign(mOrder.size(), false);
 }
 
 
-void CriticalPath::resetForBackwardPath(DiGraph& D, long latestStart) {
-    for (auto nit = D.nodes().first; nit != D.nodes().second; nit++) {
-        auto& N = dynamic_cast<CPDiNode&>(*(*nit));
-        N.mNumNeighborsProcessed = 0;
-        if (N.degreeOut() > 0) {
-            N.mLatestStart = latestStart;
-        } 
-        else {
-            N.mLatestStart = N.mEarliestStart;
+long CriticalPath::earliestStartFromPredecessors(CPDiNode& N, bool initial)
+{
+    if (N.degreeIn() == 0) {
+        return initial ? 0 : N.mLatestStart;
+    }
+    long earliestStart = 0;
+    for (auto eit = N.incidentEdgesIn().first;
+                                   eit != N.incidentEdgesIn().second; eit++) {
+        auto& E = downcast<CPDiEdge>(*(*(*eit)));
+        auto& A = downcast<CPDiNode>(E.adjacentNode(N));
+        long start = initial ? A.mInitialEarliestStart : A.mEarliestStart;
+        long sum   = start + A.mLength + E.mLength;
+        if (earliestStart < sum) {
+            earliestStart = sum;
         }
     }
+    return earliestStart;
 }
 
 
-long CriticalPath::performForwardPath(DiGraph& D) {
+long CriticalPath::latestStartFromSuccessors(CPDiNode& N)
+{
+    if (N.degreeOut() == 0) {
+        return N.mInitialEarliestStart;
+    }
+    long latestStart = mMaxEarliestStart;
+    for (auto eit = N.incidentEdgesOut().first;
+                                   eit != N.incidentEdgesOut().second; eit++) {
+        auto& E = downcast<CPDiEdge>(*(*(*eit)));
+        auto& A = downcast<CPDiNode>(E.adjacentNode(N));
+        long sum = A.mLatestStart - (N.mLength + E.mLength);
+        if (latestStart > sum) {
+            latestStart = sum;
+        }
+    }
+    return latestStart;
+}
+
 
-    list<node_list_it_t> Q(mSources.begin(), mSources.end());
+long CriticalPath::findMaxEarliestStart()
+{
     long maxEarliestStart = 0;
-    while (Q.size() > 0) {    
-        auto nit = *(Q.rbegin());
-        Q.pop_back();
-        auto& N = dynamic_cast<CPDiNode&>(*(*nit));
-        for (auto eit = N.incidentEdgesOut().first; 
-                                   eit != N.incidentEdgesOut().second; eit++) {
-            auto& E = dynamic_cast<CPDiEdge&>(*(*(*eit)));
-            auto& A = dynamic_cast<CPDiNode&>(E.adjacentNode(N));
-            long sum = N.mEarliestStart + N.mLength + E.mLength;
-            if (A.mEarliestStart < sum) {
-                A.mEarliestStart = sum;
+    for (auto* N : mOrder) {
+        if (N->degreeIn() > 0 && maxEarliestStart < N->mInitialEarliestStart) {
+            maxEarliestStart = N->mInitialEarliestStart;
+        }
+    }
+    return maxEarliestStart;
+}
+
+
+template<class FUNC>
+void CriticalPath::visitLevels(bool forward, FUNC visit)
+{
+    size_t numLevels = mLevelBegins.size() - 1;
+    size_t maxWidth  = 0;
+    for (size_t l = 0; l < numLevels; l++) {
+        maxWidth = std::max(maxWidth, mLevelBegins[l+1] - mLevelBegins[l]);
+    }
+
+    size_t numThreads = 1;
+    if (mExecutionMode == PARALLEL) {
+        numThreads = numThreadsFor(maxWidth);
+    }
+
+    if (numThreads == 1) {
+        if (forward) {
+            for (size_t i = 0; i < mOrder.size(); i++) {
+                visit(*(mOrder[i]));
             }
-            if (maxEarliestStart < sum) {
-                maxEarliestStart = sum;
+        }
+        else {
+            for (size_t i = mOrder.size(); i > 0; i--) {
+                visit(*(mOrder[i-1]));
             }
-            A.mNumNeighborsProcessed++;
-            if (A.mNumNeighborsProcessed == A.degreeIn()) {
-                Q.push_front(A.backIt());
+        }
+        return;
+    }
+
+    WorkerBarrier barrier(numThreads);
+    parallelFor(numThreads, [&](size_t t) {
+        for (size_t l = 0; l < numLevels; l++) {
+            size_t level = forward ? l : (numLevels - 1 - l);
+            for (size_t i  = mLevelBegins[level] + t;
+                        i  < mLevelBegins[level + 1];
+                        i += numThreads) {
+                visit(*(mOrder[i]));
             }
+            barrier.wait();
+        }
+    });
+}
+
+
+void CriticalPath::performForwardPath(bool initial) {
+
+    visitLevels(true, [this, initial](CPDiNode& N) {
+        long earliestStart = earliestStartFromPredecessors(N, initial);
+        if (initial) {
+            N.mInitialEarliestStart = earliestStart;
+        }
+        else {
+            N.mEarliestStart = earliestStart;
+        }
+    });
+}
+
+
+void CriticalPath::performBackwardPath() {
+
+    visitLevels(false, [this](CPDiNode& N) {
+        N.mLatestStart = latestStartFromSuccessors(N);
+    });
+}
+
+
+void CriticalPath::propagateForward(
+    vector<CPDiNode*>&               seeds,
+    bool                             initial,
+    vector<pair<CPDiNode*, long>>&   changed
+) {
+    priority_queue<size_t, vector<size_t>, greater<size_t>> Q;
+    auto enqueue = [&](CPDiNode& N) {
+        if (N.mOrder < mOrder.size() && !mQueued[N.mOrder]) {
+            mQueued[N.mOrder] = true;
+            Q.push(N.mOrder);
+        }
+    };
+
+    for (auto* N : seeds) {
+        enqueue(*N);
+    }
+    while (!Q.empty()) {
+        auto& N = *(mOrder[Q.top()]);
+        Q.pop();
+        mQueued[N.mOrder] = false;
+
+        long  earliestStart = earliestStartFromPredecessors(N, initial);
+        long& current = initial ? N.mInitialEarliestStart : N.mEarliestStart;
+        if (current == earliestStart) {
+            continue;
+        }
+        changed.push_back(make_pair(&N, current));
+        current = earliestStart;
+
+        for (auto eit = N.incidentEdgesOut().first;
+                                   eit != N.incidentEdgesOut().second; eit++) {
+            auto& E = downcast<CPDiEdge>(*(*(*eit)));
+            enqueue(downcast<CPDiNode>(E.adjacentNode(N)));
         }
     }
-    return maxEarliestStart;
 }
 
 
-void CriticalPath::performBackwardPath(DiGraph& D) {
+void CriticalPath::propagateBackward(
+    vector<CPDiNode*>&               seeds,
+    vector<CPDiNode*>&               changed
+) {
+    priority_queue<size_t> Q;
+    auto enqueue = [&](CPDiNode& N) {
+        if (N.mOrder < mOrder.size() && !mQueued[N.mOrder]) {
+            mQueued[N.mOrder] = true;
+            Q.push(N.mOrder);
+        }
+    };
+
+    for (auto* N : seeds) {
+        enqueue(*N);
+    }
+    while (!Q.empty()) {
+        auto& N = *(mOrder[Q.top()]);
+        Q.pop();
+        mQueued[N.mOrder] = false;
+
+        long latestStart = latestStartFromSuccessors(N);
+        if (N.mLatestStart == latestStart) {
+            continue;
+        }
+        changed.push_back(&N);
+        N.mLatestStart = latestStart;
 
-    list<node_list_it_t> Q(mDestinations.begin(), mDestinations.end());
-    while (Q.size() > 0) {    
-        auto nit = *(Q.rbegin());
-        Q.pop_back();
-        auto& N = dynamic_cast<CPDiNode&>(*(*nit));
-        for (auto eit = N.incidentEdgesIn().first; 
+        for (auto eit = N.incidentEdgesIn().first;
                                    eit != N.incidentEdgesIn().second; eit++) {
-            auto& E = dynamic_cast<CPDiEdge&>(*(*(*eit)));
-            auto& A = dynamic_cast<CPDiNode&>(E.adjacentNode(N));
-            long sum = N.mLatestStart - (A.mLength + E.mLength);
-            if (A.mLatestStart > sum) {
-                A.mLatestStart = sum;
-            }
-            A.mNumNeighborsProcessed++;
-            if (A.mNumNeighborsProcessed == A.degreeOut()) {
-                Q.push_front(A.backIt());
-            }
+            auto& E = downcast<CPDiEdge>(*(*(*eit)));
+            enqueue(downcast<CPDiNode>(E.adjacentNode(N)));
         }
     }
 }
 
+
+size_t CriticalPath::numThreadsFor(size_t numTasks)
+{
+    return numWorkerThreads(mNumThreads, numTasks);
+}
+
 }// namespace Directed
 
 }// namespace Wailea
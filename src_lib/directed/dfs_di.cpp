@@ -29,12 +29,12 @@ void DFSDiExplorer<BASE_GRAPH,BASE_NODE,BASE_EDGE>::reset(
 
     auto nodeItPair = g.nodes();
     for (auto nit = nodeItPair.first; nit != nodeItPair.second; nit++) {
-        dynamic_cast<DDiNode&>(*(*nit)).resetForDFS(reversed);
+        downcast<DDiNode>(*(*nit)).resetForDFS(reversed);
     }
 
     auto edgeItPair = g.edges();
     for (auto eit = edgeItPair.first; eit != edgeItPair.second; eit++) {
-        dynamic_cast<DDiEdge&>(*(*eit)).resetForDFS();
+        downcast<DDiEdge>(*(*eit)).resetForDFS();
     }
 
 }
@@ -53,7 +53,7 @@ template <class BASE_GRAPH, class BASE_NODE, class BASE_EDGE>
 bool DFSDiExplorer<BASE_GRAPH,BASE_NODE,BASE_EDGE>::oneStep()
 {
 
-    DDiNode& currentNode = dynamic_cast<DDiNode&>(*(*mCurrentNodeIt));
+    DDiNode& currentNode = downcast<DDiNode>(*(*mCurrentNodeIt));
 
     if ( !currentNode.isVisited() ) {
 
@@ -81,7 +81,7 @@ bool DFSDiExplorer<BASE_GRAPH,BASE_NODE,BASE_EDGE>::oneStep()
                 }
                 else {
 
-                    DDiNode& adjacentNode = dynamic_cast<DDiNode&>(
+                    DDiNode& adjacentNode = downcast<DDiNode>(
                                     currentEdge.adjacentNode(currentNode));
 
                     if (adjacentNode.isVisited()) {
@@ -1,4 +1,9 @@
 #include "directed/gknv_crossings_reducer.hpp"
+#include "undirected/parallel_for.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -21,7 +26,8 @@ using namespace Wailea::Directed;
 
 
 void GKNVcrossingsReducer::initialOrderByDFS(
-    vector<vector<node_list_it_t> >& ranks
+    vector<vector<node_list_it_t> >& ranks,
+    unsigned long                    seed
 ) {
 
     /** @class GknvDfsNode
@@ -54,7 +60,7 @@ void GKNVcrossingsReducer::initialOrderByDFS(
         inline DiEdge& nextChild() {
             edge_list_it_t eit = *mNextEdge;
             mNextEdge++;
-            return dynamic_cast<DiEdge&>(*(*eit));
+            return downcast<DiEdge>(*(*eit));
         }
 
         inline node_list_it_t dfsParent() { return mDfsParent; }
@@ -92,40 +98,49 @@ void GKNVcrossingsReducer::initialOrderByDFS(
 
     mG.pushDefaultIGForwardLinkToNodes();
 
+    // The DFS roots are picked from the front of unvisitedNodes.
+    vector<pair<long, node_list_it_t> > rankedNodes;
     for (long i = 0; i < ranks.size(); i++) {
-
         for (auto nit : ranks[i]) {
+            rankedNodes.push_back(make_pair(i, nit));
+        }
+    }
+    if (seed != 0) {
+        std::minstd_rand rng(seed);
+        std::shuffle(rankedNodes.begin(), rankedNodes.end(), rng);
+    }
+
+    for (auto& rn : rankedNodes) {
 
-            auto& Norg = dynamic_cast<DiNode&>(*(*nit));
+        auto& Norg = downcast<DiNode>(*(*(rn.second)));
 
-            auto& Ndfs = dynamic_cast<GknvDfsNode&>(
+        auto& Ndfs = downcast<GknvDfsNode>(
                                 mDFS.addNode(std::make_unique<GknvDfsNode>()));
-            Ndfs.mRank = i;
-            Ndfs.mVisited = false;
-            Norg.setIGForwardLink(Ndfs.backIt());
-            Ndfs.pushIGBackwardLink(Norg.backIt());
+        Ndfs.mRank = rn.first;
+        Ndfs.mVisited = false;
+        Norg.setIGForwardLink(Ndfs.backIt());
+        Ndfs.pushIGBackwardLink(Norg.backIt());
 
-            Ndfs.mDFSbackIt = unvisitedNodes.insert(
+        Ndfs.mDFSbackIt = unvisitedNodes.insert(
                                           unvisitedNodes.end(), Ndfs.backIt());
-            unvisitedNodesSize++;
-        }
+        unvisitedNodesSize++;
     }
 
     for (auto eit = mG.edges().first; eit != mG.edges().second; eit++) {
 
-        auto& Eorg = dynamic_cast<DiEdge&>(*(*eit));
+        auto& Eorg = downcast<DiEdge>(*(*eit));
 
-        auto& NsrcOrg = dynamic_cast<DiNode&>(Eorg.incidentNodeSrc());
+        auto& NsrcOrg = downcast<DiNode>(Eorg.incidentNodeSrc());
 
-        auto& NdstOrg = dynamic_cast<DiNode&>(Eorg.incidentNodeDst());
+        auto& NdstOrg = downcast<DiNode>(Eorg.incidentNodeDst());
 
-        auto& NsrcDfs = dynamic_cast<GknvDfsNode&>(NsrcOrg.IGForwardLinkRef());
+        auto& NsrcDfs = downcast<GknvDfsNode>(NsrcOrg.IGForwardLinkRef());
 
-        auto& NdstDfs = dynamic_cast<GknvDfsNode&>(NdstOrg.IGForwardLinkRef());
+        auto& NdstDfs = downcast<GknvDfsNode>(NdstOrg.IGForwardLinkRef());
 
         auto  ep = std::make_unique<DiEdge>();
 
-        auto& Edfs = dynamic_cast<DiEdge&>(
+        auto& Edfs = downcast<DiEdge>(
                                 mDFS.addEdge(std::move(ep), NsrcDfs, NdstDfs));
 
         Eorg.pushIGForwardLink(Edfs.backIt());
@@ -142,9 +157,9 @@ void GKNVcrossingsReducer::initialOrderByDFS(
 
     while(unvisitedNodesSize > 0) {
 
-        auto&Rdfs = dynamic_cast<GknvDfsNode&>(
+        auto&Rdfs = downcast<GknvDfsNode>(
                                               *(*(*(unvisitedNodes.begin()))));
-        auto& Rorg = dynamic_cast<DiNode&>(Rdfs.IGBackwardLinkRef());
+        auto& Rorg = downcast<DiNode>(Rdfs.IGBackwardLinkRef());
 
         ranks[Rdfs.mRank].push_back(Rorg.backIt());
 //        cerr << "Pushing " << Rorg.num() << "to rank " << Rdfs.mRank << "\n";
@@ -158,13 +173,13 @@ void GKNVcrossingsReducer::initialOrderByDFS(
 
         while(nodeBeingVisited != mDFS.nodes().second) {
 
-            auto& Ndfs = dynamic_cast<GknvDfsNode&>(*(*(nodeBeingVisited)));
+            auto& Ndfs = downcast<GknvDfsNode>(*(*(nodeBeingVisited)));
 
             if (Ndfs.hasNextChild()) {
 
                 auto& Edfs = Ndfs.nextChild();
 
-                auto& Adfs = dynamic_cast<GknvDfsNode&>(
+                auto& Adfs = downcast<GknvDfsNode>(
                                                       Edfs.adjacentNode(Ndfs));
 
                 if (!Adfs.mVisited) {
@@ -177,7 +192,7 @@ void GKNVcrossingsReducer::initialOrderByDFS(
 
                     nodeBeingVisited = Adfs.backIt();
 
-                    auto& Aorg = dynamic_cast<DiNode&>(
+                    auto& Aorg = downcast<DiNode>(
                                                      Adfs.IGBackwardLinkRef());
 
                     ranks[Adfs.mRank].push_back(Aorg.backIt());
@@ -201,71 +216,119 @@ void GKNVcrossingsReducer::initialOrderByDFS(
 }
 
 
+void GKNVcrossingsReducer::pushNodeIndices()
+{
+    utility_t index = 0;
+    for (auto nit = mG.nodes().first; nit != mG.nodes().second; nit++) {
+        auto& N = downcast<DiNode>(*(*nit));
+        N.pushUtility(index++);
+    }
+}
+
+
+void GKNVcrossingsReducer::popNodeIndices()
+{
+    mG.popUtilityFromNodes();
+}
+
+
+size_t GKNVcrossingsReducer::numThreadsFor(size_t numTasks)
+{
+    return numWorkerThreads(mNumThreads, numTasks);
+}
+
+
 long GKNVcrossingsReducer::calculateNumberOfCrossings(
     vector<node_list_it_t>& leftNodes,
-    vector<node_list_it_t>& rightNodes
+    vector<node_list_it_t>& rightNodes,
+    vector<long>&           positionOf
 ) {
-//cerr << "E 1\n";
-    long index = 0;
-    for(auto nit : rightNodes) {
-//cerr << "E 2.1\n";
-        auto& N = dynamic_cast<DiNode&>(*(*nit));
-//cerr << "E 2.2\n";
-        N.pushUtility(index++);
-//cerr << "E 2.3\n";
+    // Bilayer cross counting by an accumulator tree.
+    // [BJM] W. Barth, M. Juenger, and P. Mutzel. Simple and efficient
+    //       bilayer cross counting. Graph Drawing 2002, LNCS 2528.
+    //
+    // The edges are sorted lexicographically by the positions of the left
+    // and the right incident nodes, and the number of crossings is the
+    // number of inversions in the resultant sequence of the right
+    // positions.
+    if (leftNodes.size() < 2 || rightNodes.size() == 0) {
+        return 0;
     }
-//cerr << "E 3\n";
-    long numCrossings = 0;
 
-    for(long i = 0; i < long(leftNodes.size()) - 1; i++) {
-//cerr << "E 4\n";
-        auto& Ni = dynamic_cast<DiNode&>(*(*(leftNodes[i])));
-//cerr << "E 5\n";
-        for(long j = i + 1; j < long(leftNodes.size()) ; j++) {
-//cerr << "E 6\n";
-            auto& Nj = dynamic_cast<DiNode&>(*(*(leftNodes[j])));
-//cerr << "E 7\n";
-            for (auto sit = Ni.incidentEdgesOut().first;
-                                  sit != Ni.incidentEdgesOut().second; sit++) {
-//cerr << "E 8\n";
-                auto& Es = dynamic_cast<DiEdge&>(*(*(*sit)));
-//cerr << "E 9\n";
-                auto& Ns = dynamic_cast<DiNode&>(Es.adjacentNode(Ni));
-//cerr << "E 10\n";
-                auto  s  = Ns.utility();
-//cerr << "E 11\n";
-                for (auto tit = Nj.incidentEdgesOut().first;
-                                  tit != Nj.incidentEdgesOut().second; tit++) {
-//cerr << "E 12\n";
-                    auto& Et = dynamic_cast<DiEdge&>(*(*(*tit)));
-//cerr << "E 13\n";
-                    auto& Nt = dynamic_cast<DiNode&>(Et.adjacentNode(Nj));
-//cerr << "E 14\n";
-                    auto  t  = Nt.utility();
-//cerr << "E 15\n";
-                    // Invariant: i < j. If s > t, (i,s) and (j,t) crosses.
-                    if (s > t) {
-//cerr << "E 16\n";
-                        numCrossings++;
-//cerr << "E 17\n";
-                    }
-//cerr << "E 18\n";
+    vector<vector<long> > positions;
+    findAdjacentPositions(leftNodes, rightNodes, true, positions, positionOf);
+
+    long firstIndex = 1;
+    while (firstIndex < long(rightNodes.size())) {
+        firstIndex *= 2;
+    }
+    long treeSize = 2 * firstIndex - 1;
+    firstIndex -= 1;
+    vector<long> tree(treeSize, 0);
+
+    long numCrossings = 0;
+    for (auto& posVec : positions) {
+        for (auto pos : posVec) {
+            long index = pos + firstIndex;
+            tree[index]++;
+            while (index > 0) {
+                if (index % 2 == 1) {
+                    numCrossings += tree[index + 1];
                 }
-//cerr << "E 19\n";
+                index = (index - 1) / 2;
+                tree[index]++;
             }
-//cerr << "E 20\n";
         }
-//cerr << "E 21\n";
     }
-//cerr << "E 22\n";
-    for(auto nit : rightNodes) {
-//cerr << "E 23\n";
-        auto& N = dynamic_cast<DiNode&>(*(*nit));
-//cerr << "E 24\n";
-        N.popUtility();
-//cerr << "E 25\n";
+    return numCrossings;
+}
+
+
+void GKNVcrossingsReducer::findAdjacentPositions(
+    vector<node_list_it_t>&  nodes,
+    vector<node_list_it_t>&  adjacentNodes,
+    bool                     outgoing,
+    vector<vector<long> >&   positions,
+    vector<long>&            positionOf
+) {
+    long index = 0;
+    for(auto nit : adjacentNodes) {
+        auto& N = downcast<DiNode>(*(*nit));
+        positionOf[N.utility()] = index++;
+    }
+
+    positions.clear();
+    positions.reserve(nodes.size());
+
+    for(auto nit : nodes) {
+        auto& N = downcast<DiNode>(*(*nit));
+        auto  iPair = outgoing ? N.incidentEdgesOut() : N.incidentEdgesIn();
+        vector<long> posVec;
+        posVec.reserve(outgoing ? N.degreeOut() : N.degreeIn());
+        for (auto iit = iPair.first; iit != iPair.second; iit++) {
+            auto& E = downcast<DiEdge>(*(*(*iit)));
+            auto& A = downcast<DiNode>(E.adjacentNode(N));
+            posVec.push_back(positionOf[A.utility()]);
+        }
+        std::sort(posVec.begin(), posVec.end());
+        positions.push_back(std::move(posVec));
+    }
+}
+
+
+long GKNVcrossingsReducer::countCrossingsOfPair(
+    const vector<long>& positionsU,
+    const vector<long>& positionsV
+) {
+    // Number of pairs (s, t) with s in positionsU, t in positionsV, s > t.
+    long numCrossings = 0;
+    size_t j = 0;
+    for (auto s : positionsU) {
+        while (j < positionsV.size() && positionsV[j] < s) {
+            j++;
+        }
+        numCrossings += long(j);
     }
-//cerr << "E 26\n";
     return numCrossings;
 }
 
@@ -273,15 +336,16 @@ long GKNVcrossingsReducer::calculateNumberOfCrossings(
 void GKNVcrossingsReducer::reorderRightSideByMedianHeuristic(
     vector<node_list_it_t>& leftNodes,
     vector<node_list_it_t>& rightNodes,
-    vector<node_list_it_t>& newRightNodes
+    vector<node_list_it_t>& newRightNodes,
+    vector<long>&           positionOf
 ) {
 
     vector<vector<node_list_it_t> >buckets;
 
     long index = 0;
     for(auto nit : leftNodes) {
-        auto& N = dynamic_cast<DiNode&>(*(*nit));
-        N.pushUtility(index++);
+        auto& N = downcast<DiNode>(*(*nit));
+        positionOf[N.utility()] = index++;
         vector<node_list_it_t> vec;
         buckets.push_back(std::move(vec));
     }
@@ -289,7 +353,7 @@ void GKNVcrossingsReducer::reorderRightSideByMedianHeuristic(
                                          
     float findex = 0.0;
     for(auto nit : rightNodes) {
-        auto& N = dynamic_cast<DiNode&>(*(*nit));
+        auto& N = downcast<DiNode>(*(*nit));
         if (N.degreeIn()==0) {
             buckets[long(findex*leftRightRatio)].push_back(nit);
 
@@ -298,9 +362,9 @@ void GKNVcrossingsReducer::reorderRightSideByMedianHeuristic(
             vector<long> incidentNodes;
             for (auto iit = N.incidentEdgesIn().first;
                                     iit != N.incidentEdgesIn().second; iit++) {
-                auto& E = dynamic_cast<DiEdge&>(*(*(*iit)));
-                auto& A = dynamic_cast<DiNode&>(E.adjacentNode(N));
-                incidentNodes.push_back(A.utility());
+                auto& E = downcast<DiEdge>(*(*(*iit)));
+                auto& A = downcast<DiNode>(E.adjacentNode(N));
+                incidentNodes.push_back(positionOf[A.utility()]);
             }
             std::sort(incidentNodes.begin(), incidentNodes.end());
             long degree = N.degreeIn();
@@ -325,10 +389,6 @@ void GKNVcrossingsReducer::reorderRightSideByMedianHeuristic(
         }
         findex += 1.0;
     }
-    for(auto nit : leftNodes) {
-        auto& N = dynamic_cast<DiNode&>(*(*nit));
-        N.popUtility();
-    }
     newRightNodes.clear();
     for (auto& v : buckets) {
         for (auto nit : v) {
@@ -341,22 +401,23 @@ void GKNVcrossingsReducer::reorderRightSideByMedianHeuristic(
 void GKNVcrossingsReducer::reorderLeftSideByMedianHeuristic(
     vector<node_list_it_t>& leftNodes,
     vector<node_list_it_t>& rightNodes,
-    vector<node_list_it_t>& newLeftNodes
+    vector<node_list_it_t>& newLeftNodes,
+    vector<long>&           positionOf
 ) {
 
     vector<vector<node_list_it_t> >buckets;
 
     long index = 0;
     for(auto nit : rightNodes) {
-        auto& N = dynamic_cast<DiNode&>(*(*nit));
-        N.pushUtility(index++);
+        auto& N = downcast<DiNode>(*(*nit));
+        positionOf[N.utility()] = index++;
         vector<node_list_it_t> vec;
         buckets.push_back(std::move(vec));
     }
     float rightLeftRatio = float(rightNodes.size()) / float(leftNodes.size());
     float findex = 0.0;
     for(auto nit : leftNodes) {
-        auto& N = dynamic_cast<DiNode&>(*(*nit));
+        auto& N = downcast<DiNode>(*(*nit));
         if (N.degreeOut()==0) {
             buckets[long(findex*rightLeftRatio)].push_back(nit);
 
@@ -365,9 +426,9 @@ void GKNVcrossingsReducer::reorderLeftSideByMedianHeuristic(
             vector<long> incidentNodes;
             for (auto iit = N.incidentEdgesOut().first;
                                    iit != N.incidentEdgesOut().second; iit++) {
-                auto& E = dynamic_cast<DiEdge&>(*(*(*iit)));
-                auto& A = dynamic_cast<DiNode&>(E.adjacentNode(N));
-                incidentNodes.push_back(A.utility());
+                auto& E = downcast<DiEdge>(*(*(*iit)));
+                auto& A = downcast<DiNode>(E.adjacentNode(N));
+                incidentNodes.push_back(positionOf[A.utility()]);
             }
             std::sort(incidentNodes.begin(), incidentNodes.end());
             long degree = N.degreeOut();
@@ -391,10 +452,6 @@ void GKNVcrossingsReducer::reorderLeftSideByMedianHeuristic(
         }
         findex += 1.0;
     }
-    for(auto nit : rightNodes) {
-        auto& N = dynamic_cast<DiNode&>(*(*nit));
-        N.popUtility();
-    }
     newLeftNodes.clear();
     for (auto& v : buckets) {
         for (auto nit : v) {
@@ -408,49 +465,191 @@ long GKNVcrossingsReducer::reduce(
     vector<vector<node_list_it_t> >& ranks,
     long numIterations
 ) {
-    long stagnant = 0;
-//cerr << "C 1\n";
-    initialOrderByDFS(ranks);
-//cerr << "C 2.1\n";
-    auto numCrossings = calculateNumberOfCrossings(ranks);
-//cerr << "C 2.2\n";
-//    cerr << "Initial: " << numCrossings << "\n";
-    if (numCrossings == 0) {
-//cerr << "C 2.3\n";
+    if (mExecutionMode == SEQUENTIAL) {
+
+        initialOrderByDFS(ranks);
+        pushNodeIndices();
+        auto numCrossings = iterateHeuristics(
+                                        ranks, numIterations, true, false, 1);
+        popNodeIndices();
         rearrangeIncidenceLists(ranks);
-//cerr << "C 2.4\n";
-        return 0;
+        return numCrossings;
     }
-//cerr << "C 3\n";
-    for (long i = 0; i < numIterations; i++) {
-//        cerr << "Iteration: " << i << "\n";
-        vector<vector<node_list_it_t> > updatedRanks;
 
-        applyMedianHeuristic(ranks, updatedRanks, i%2==0);
+    // The initial orders are made serially, as initialOrderByDFS() uses
+    // the IG links of mG.
+    size_t numRestarts = mNumRestarts;
+    vector<vector<vector<node_list_it_t> > > candidates(numRestarts, ranks);
+    vector<long> numCrossings(numRestarts, 0);
+    for (size_t k = 0; k < numRestarts; k++) {
+        initialOrderByDFS(candidates[k], k);
+    }
+
+    pushNodeIndices();
+
+    if (numRestarts == 1) {
+        numCrossings[0] = iterateHeuristics(
+                            candidates[0], numIterations, true, true,
+                            numThreadsFor((ranks.size() + 1) / 2));
+    }
+    else {
+        size_t numThreads = numThreadsFor(numRestarts);
+
+        // The worker threads only read the node indices in the utility of
+        // mG and write to their own candidates.
+        try {
+            parallelFor(numThreads, [&](size_t t) {
+                for (size_t k = t; k < numRestarts; k += numThreads) {
+                    numCrossings[k] = iterateHeuristics(
+                                     candidates[k], numIterations, k%2 == 0,
+                                     true, 1);
+                }
+            });
+        }
+        catch (...) {
+            popNodeIndices();
+            throw;
+        }
+    }
 
-        applyTransposeHeuristic(updatedRanks);
+    popNodeIndices();
 
-        auto updatedNumCrossings = calculateNumberOfCrossings(updatedRanks);
-//        cerr << "Crossings: " << updatedNumCrossings << "\n";
+    size_t best = 0;
+    for (size_t k = 1; k < numRestarts; k++) {
+        if (numCrossings[k] < numCrossings[best]) {
+            best = k;
+        }
+    }
+    ranks = std::move(candidates[best]);
+    rearrangeIncidenceLists(ranks);
+    return numCrossings[best];
+}
+
+
+long GKNVcrossingsReducer::iterateHeuristics(
+    vector<vector<node_list_it_t> >& ranks,
+    long                             numIterations,
+    bool                             forwardFirst,
+    bool                             byParity,
+    size_t                           numThreads
+) {
+    if (byParity) {
+        size_t numNodes = 0;
+        for (auto& rank : ranks) {
+            numNodes += rank.size();
+        }
+        numThreads = numWorkerThreads(numThreads,
+                                    numNodes / mMinNodesPerTransposeThread);
+    }
+    else {
+        numThreads = 1;
+    }
+
+    vector<vector<long> > positionOfs(numThreads, vector<long>(mG.numNodes()));
+    auto& positionOf = positionOfs[0];
+
+    auto numCrossings = calculateNumberOfCrossings(ranks, positionOf);
+    if (numCrossings == 0) {
+        return 0;
+    }
+
+    long stagnant = 0;
+    vector<vector<node_list_it_t> > updatedRanks;
+
+    // Keeps the better of ranks and updatedRanks after an iteration, and
+    // returns true if the iterations should stop.
+    auto evaluate = [&]() {
+        auto updatedNumCrossings =
+                         calculateNumberOfCrossings(updatedRanks, positionOf);
         if (updatedNumCrossings < numCrossings) {
-            ranks = std::move(updatedRanks);
+            ranks.swap(updatedRanks);
             numCrossings = updatedNumCrossings;
-            if (numCrossings == 0) {
-                break;
-            }
             stagnant = 0;
+            return numCrossings == 0;
         }
-        else {
-            stagnant++;
-            if (stagnant >= 4) {
-//                cerr << "Stagnant. Giving up\n";
+        stagnant++;
+        return stagnant >= 4;
+    };
+
+    if (numThreads == 1) {
+        for (long i = 0; i < numIterations; i++) {
+
+            applyMedianHeuristic(ranks, updatedRanks,
+                                 (i%2==0) == forwardFirst, positionOf);
+
+            if (byParity) {
+                applyTransposeHeuristicToParity(
+                                      updatedRanks, 0, 0, 1, positionOf);
+                applyTransposeHeuristicToParity(
+                                      updatedRanks, 1, 0, 1, positionOf);
+            }
+            else {
+                applyTransposeHeuristic(updatedRanks, positionOf);
+            }
+
+            if (evaluate()) {
                 break;
             }
         }
+        return numCrossings;
     }
-//cerr << "C 4\n";
-    rearrangeIncidenceLists(ranks);
-//cerr << "C 5\n";
+
+    // The worker threads are created once for all the iterations. Thread 0
+    // runs the median heuristic and evaluates the result, and all the
+    // threads transpose the ranks of each parity in between. The phases
+    // are separated by the barrier. done is written only by thread 0
+    // before the last barrier of an iteration.
+    // If a phase throws, the thread keeps going through the barriers so
+    // that the others are not blocked, the iterations stop at the end of
+    // the current one, and the exception is rethrown by parallelFor().
+    WorkerBarrier       barrier(numThreads);
+    std::atomic<bool>   failed(false);
+    bool                done = false;
+    parallelFor(numThreads, [&](size_t t) {
+
+        exception_ptr error;
+        auto guarded = [&](auto phase) {
+            if (failed) {
+                return;
+            }
+            try {
+                phase();
+            }
+            catch (...) {
+                error  = current_exception();
+                failed = true;
+            }
+        };
+
+        for (long i = 0; i < numIterations && !done; i++) {
+
+            if (t == 0) {
+                guarded([&]{
+                    applyMedianHeuristic(ranks, updatedRanks,
+                                     (i%2==0) == forwardFirst, positionOf);
+                });
+            }
+            barrier.wait();
+
+            for (long parity = 0; parity < 2; parity++) {
+                guarded([&]{
+                    applyTransposeHeuristicToParity(updatedRanks, parity,
+                                          t, numThreads, positionOfs[t]);
+                });
+                barrier.wait();
+            }
+
+            if (t == 0) {
+                guarded([&]{ done = evaluate(); });
+                done = done || failed;
+            }
+            barrier.wait();
+        }
+
+        if (error != nullptr) {
+            rethrow_exception(error);
+        }
+    });
     return numCrossings;
 }
 
@@ -463,7 +662,7 @@ void GKNVcrossingsReducer::rearrangeIncidenceLists(
     for (auto& rank : ranks) {
         long index = 0;
         for (auto nit : rank) {
-            auto& N = dynamic_cast<DiNode&>(*(*nit));
+            auto& N = downcast<DiNode>(*(*nit));
             N.setUtility(index++);
         }
     }
@@ -472,7 +671,7 @@ void GKNVcrossingsReducer::rearrangeIncidenceLists(
         auto& leftRank  = ranks[i];
 
         for (auto nit : leftRank) {
-            auto&N = dynamic_cast<DiNode&>(*(*nit));
+            auto&N = downcast<DiNode>(*(*nit));
             vector<edge_list_it_t> incidence(N.incidentEdgesOut().first,
                                              N.incidentEdgesOut().second );
 
@@ -487,7 +686,7 @@ void GKNVcrossingsReducer::rearrangeIncidenceLists(
         auto& rightRank  = ranks[i];
 
         for (auto nit : rightRank) {
-            auto&N = dynamic_cast<DiNode&>(*(*nit));
+            auto&N = downcast<DiNode>(*(*nit));
             vector<edge_list_it_t> incidence(N.incidentEdgesIn().first,
                                              N.incidentEdgesIn().second );
 
@@ -505,19 +704,19 @@ void GKNVcrossingsReducer::rearrangeIncidenceLists(
 void GKNVcrossingsReducer::applyMedianHeuristic(
     vector<vector<node_list_it_t> >& oldRanks,
     vector<vector<node_list_it_t> >& newRanks,
-    bool forward
+    bool forward,
+    vector<long>& positionOf
 ) {
-    newRanks.clear();
+    // The ranks in newRanks are reused to keep their capacities.
+    newRanks.resize(oldRanks.size());
+    for (auto& rank : newRanks) {
+        rank.clear();
+    }
     if (oldRanks.size()==0) {
         return;
     }
     long lastIndex = long(oldRanks.size()) - 1;
 
-    for (long i = 0; i <= lastIndex; i++) {
-        vector<node_list_it_t> emptyRank;
-        newRanks.push_back(std::move(emptyRank));
-    }
-
     if(forward) {
         newRanks[0].insert(
                     newRanks[0].end(), oldRanks[0].begin(), oldRanks[0].end());
@@ -534,51 +733,79 @@ void GKNVcrossingsReducer::applyMedianHeuristic(
     if (forward) {
         for (long j = 0; j < lastIndex; j++) {
             reorderRightSideByMedianHeuristic(
-                                    oldRanks[j], oldRanks[j+1], newRanks[j+1]);
+                        oldRanks[j], oldRanks[j+1], newRanks[j+1], positionOf);
         }
     }
     else {
         for (long j = lastIndex -1 ; j >= 0; j--) {
             reorderLeftSideByMedianHeuristic(
-                                      oldRanks[j], oldRanks[j+1], newRanks[j]);
+                          oldRanks[j], oldRanks[j+1], newRanks[j], positionOf);
         }
     }
 }
 
 
 void GKNVcrossingsReducer::applyTransposeHeuristic(
-    vector<vector<node_list_it_t> >& ranks
+    vector<vector<node_list_it_t> >& ranks,
+    vector<long>&                    positionOf
 ) {
     for (long i = 0; i < long(ranks.size()); i++) {
-        if (i == 0) {
-            tryTransposeLeft(ranks[0], ranks[1]);
-        }
-        else if (i == long(ranks.size()) - 1) {
-            tryTransposeRight(ranks[i-1], ranks[i]);
-        }
-        else {
-            tryTransposeMid(ranks[i-1], ranks[i], ranks[i+1]);
-        }
+        transposeRank(ranks, i, positionOf);
+    }
+}
+
+
+void GKNVcrossingsReducer::applyTransposeHeuristicToParity(
+    vector<vector<node_list_it_t> >& ranks,
+    long                             parity,
+    size_t                           t,
+    size_t                           numThreads,
+    vector<long>&                    positionOf
+) {
+    long numRanks = long(ranks.size());
+    for (long i = parity + 2 * long(t); i < numRanks;
+                                               i += 2 * long(numThreads)) {
+        transposeRank(ranks, i, positionOf);
+    }
+}
+
+
+void GKNVcrossingsReducer::transposeRank(
+    vector<vector<node_list_it_t> >& ranks,
+    long                             i,
+    vector<long>&                    positionOf
+) {
+    if (i == 0) {
+        tryTransposeLeft(ranks[0], ranks[1], positionOf);
+    }
+    else if (i == long(ranks.size()) - 1) {
+        tryTransposeRight(ranks[i-1], ranks[i], positionOf);
+    }
+    else {
+        tryTransposeMid(ranks[i-1], ranks[i], ranks[i+1], positionOf);
     }
 }
 
 
 void GKNVcrossingsReducer::tryTransposeLeft(
     vector<node_list_it_t>& leftRank,
-    vector<node_list_it_t>& rightRank
+    vector<node_list_it_t>& rightRank,
+    vector<long>&           positionOf
 ) {
+    // Only the crossings among the edges incident to the swapped pair
+    // change by a swap. The positions in rightRank do not change here.
+    vector<vector<long> > outPositions;
+    findAdjacentPositions(leftRank, rightRank, true, outPositions, positionOf);
 
     for (long i = 0; i < long(leftRank.size()) - 1; i++) {
-        auto numOrg = calculateNumberOfCrossings(leftRank, rightRank);
-
-        // Swap i and i + 1 and see how the crossings changes
-        std::swap(leftRank[i], leftRank[i+1]);
-
-        auto numSwapped = calculateNumberOfCrossings(leftRank, rightRank);
 
-        if (numSwapped >= numOrg) {
-            // Swap back to the original
+        auto numOrg     = countCrossingsOfPair(outPositions[i],
+                                               outPositions[i+1]);
+        auto numSwapped = countCrossingsOfPair(outPositions[i+1],
+                                               outPositions[i]);
+        if (numSwapped < numOrg) {
             std::swap(leftRank[i], leftRank[i+1]);
+            std::swap(outPositions[i], outPositions[i+1]);
         }
     }
 }
@@ -587,22 +814,28 @@ void GKNVcrossingsReducer::tryTransposeLeft(
 void GKNVcrossingsReducer::tryTransposeMid(
     vector<node_list_it_t>& leftRank,
     vector<node_list_it_t>& midRank,
-    vector<node_list_it_t>& rightRank
+    vector<node_list_it_t>& rightRank,
+    vector<long>&           positionOf
 ) {
+    vector<vector<long> > inPositions;
+    vector<vector<long> > outPositions;
+    findAdjacentPositions(midRank, leftRank,  false, inPositions,  positionOf);
+    findAdjacentPositions(midRank, rightRank, true,  outPositions, positionOf);
 
     for (long i = 0; i < long(midRank.size()) - 1; i++) {
-        auto numOrg = calculateNumberOfCrossings(leftRank, midRank);
-        numOrg += calculateNumberOfCrossings(midRank, rightRank);
-
-        // Swap i and i + 1 and see how the crossings changes
-        std::swap(midRank[i], midRank[i+1]);
-
-        auto numSwapped = calculateNumberOfCrossings(leftRank, midRank);
-        numSwapped += calculateNumberOfCrossings(midRank, rightRank);
 
-        if (numSwapped >= numOrg) {
-            // Swap back to the original
+        auto numOrg     = countCrossingsOfPair(inPositions[i],
+                                               inPositions[i+1]);
+        numOrg         += countCrossingsOfPair(outPositions[i],
+                                               outPositions[i+1]);
+        auto numSwapped = countCrossingsOfPair(inPositions[i+1],
+                                               inPositions[i]);
+        numSwapped     += countCrossingsOfPair(outPositions[i+1],
+                                               outPositions[i]);
+        if (numSwapped < numOrg) {
             std::swap(midRank[i], midRank[i+1]);
+            std::swap(inPositions[i], inPositions[i+1]);
+            std::swap(outPositions[i], outPositions[i+1]);
         }
     }
 
@@ -611,27 +844,29 @@ void GKNVcrossingsReducer::tryTransposeMid(
 
 void GKNVcrossingsReducer::tryTransposeRight(
     vector<node_list_it_t>& leftRank,
-    vector<node_list_it_t>& rightRank
+    vector<node_list_it_t>& rightRank,
+    vector<long>&           positionOf
 ) {
+    vector<vector<long> > inPositions;
+    findAdjacentPositions(rightRank, leftRank, false, inPositions, positionOf);
 
     for (long i = 0; i < long(rightRank.size()) - 1; i++) {
-        auto numOrg = calculateNumberOfCrossings(leftRank, rightRank);
 
-        // Swap i and i + 1 and see how the crossings changes
-        std::swap(rightRank[i], rightRank[i+1]);
-
-        auto numSwapped = calculateNumberOfCrossings(leftRank, rightRank);
-
-        if (numSwapped >= numOrg) {
-            // Swap back to the original
+        auto numOrg     = countCrossingsOfPair(inPositions[i],
+                                               inPositions[i+1]);
+        auto numSwapped = countCrossingsOfPair(inPositions[i+1],
+                                               inPositions[i]);
+        if (numSwapped < numOrg) {
             std::swap(rightRank[i], rightRank[i+1]);
+            std::swap(inPositions[i], inPositions[i+1]);
         }
     }
 }
 
 
 long GKNVcrossingsReducer::calculateNumberOfCrossings(
-    vector<vector<node_list_it_t> >& ranks
+    vector<vector<node_list_it_t> >& ranks,
+    vector<long>&                    positionOf
 ) {
 //cerr << "D 1\n";
     long numCrossings = 0;
@@ -642,7 +877,8 @@ long GKNVcrossingsReducer::calculateNumberOfCrossings(
 //cerr << "D 4\n";
         auto& rightRank = ranks[i+1];
 //cerr << "D 5\n";
-        numCrossings += calculateNumberOfCrossings(leftRank, rightRank);
+        numCrossings +=
+                   calculateNumberOfCrossings(leftRank, rightRank, positionOf);
 //cerr << "D 6\n";
     }
 //cerr << "D 7\n";
@@ -652,20 +888,20 @@ long GKNVcrossingsReducer::calculateNumberOfCrossings(
 
 bool GKNVcrossingsReducer::nodeCompDst(edge_list_it_t it1, edge_list_it_t it2)
 {
-    auto& E1 = dynamic_cast<DiEdge&>(*(*it1));
-    auto& E2 = dynamic_cast<DiEdge&>(*(*it2));
-    auto& N1 = dynamic_cast<DiNode&>(E1.incidentNodeDst());
-    auto& N2 = dynamic_cast<DiNode&>(E2.incidentNodeDst());
+    auto& E1 = downcast<DiEdge>(*(*it1));
+    auto& E2 = downcast<DiEdge>(*(*it2));
+    auto& N1 = downcast<DiNode>(E1.incidentNodeDst());
+    auto& N2 = downcast<DiNode>(E2.incidentNodeDst());
     return N1.utility() > N2.utility();
 }
 
 
 bool GKNVcrossingsReducer::nodeCompSrc(edge_list_it_t it1, edge_list_it_t it2)
 {
-    auto& E1 = dynamic_cast<DiEdge&>(*(*it1));
-    auto& E2 = dynamic_cast<DiEdge&>(*(*it2));
-    auto& N1 = dynamic_cast<DiNode&>(E1.incidentNodeSrc());
-    auto& N2 = dynamic_cast<DiNode&>(E2.incidentNodeSrc());
+    auto& E1 = downcast<DiEdge>(*(*it1));
+    auto& E2 = downcast<DiEdge>(*(*it2));
+    auto& N1 = downcast<DiNode>(E1.incidentNodeSrc());
+    auto& N2 = downcast<DiNode>(E2.incidentNodeSrc());
     return N1.utility() < N2.utility();
 }
 
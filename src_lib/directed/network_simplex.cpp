@@ -1,6 +1,8 @@
 #include "directed/network_simplex.hpp"
 #include "undirected/connected_decomposer.hpp"
-#include "directed/tot_unimod_simul_eqs_solver.hpp"
+
+#include <queue>
+#include <functional>
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -28,7 +30,7 @@ void NetworkSimplex::prepareZeroBGraph()
     auto ePair = mG.edges();
     for(auto eit = ePair.first; eit != ePair.second; eit++) {
 
-        auto& E = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+        auto& E = downcast<NetworkSimplexEdge>(*(*eit));
 
         E.mArtificial    = false;
         E.mC             = E.mCreal;
@@ -42,10 +44,10 @@ void NetworkSimplex::makeInitialZeroBSpanningTree()
     auto nPair = mG.nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 
-        auto& Ng = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
 
         auto np = make_unique<NSSpanningTreeNode>();
-        auto& Nst = dynamic_cast<NSSpanningTreeNode&>(
+        auto& Nst = downcast<NSSpanningTreeNode>(
                                          mSpanningTree.addNode(std::move(np)));
         Nst.pushIGBackwardLink(Ng.backIt());
         Ng.pushIGForwardLink(Nst.backIt());
@@ -54,8 +56,8 @@ void NetworkSimplex::makeInitialZeroBSpanningTree()
     mNsGeneration++;
     list<node_list_it_t> nodesToBeChecked;
 
-    auto& Rg  = dynamic_cast<NetworkSimplexNode&>(*(*nPair.first));
-    auto& Rst = dynamic_cast<NSSpanningTreeNode&>(Rg.IGForwardLinkRef());
+    auto& Rg  = downcast<NetworkSimplexNode>(*(*nPair.first));
+    auto& Rst = downcast<NSSpanningTreeNode>(Rg.IGForwardLinkRef());
     Rst.mNsGeneration = mNsGeneration;
     nodesToBeChecked.push_back(Rg.backIt());
 
@@ -65,13 +67,13 @@ void NetworkSimplex::makeInitialZeroBSpanningTree()
         auto nit = *(nodesToBeChecked.rbegin());
         nodesToBeChecked.pop_back();
 
-        auto& Ng  = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+        auto& Ng  = downcast<NetworkSimplexNode>(*(*nit));
                                                         
         auto iPairIn = Ng.incidentEdgesIn();
         for (auto iit = iPairIn.first; iit != iPairIn.second; iit++) {
-            auto& Eg =  dynamic_cast<NetworkSimplexEdge&>(*(*(*iit)));
-            auto& Ag =  dynamic_cast<NetworkSimplexNode&>(Eg.adjacentNode(Ng));
-            auto& Ast = dynamic_cast<NSSpanningTreeNode&>(
+            auto& Eg =  downcast<NetworkSimplexEdge>(*(*(*iit)));
+            auto& Ag =  downcast<NetworkSimplexNode>(Eg.adjacentNode(Ng));
+            auto& Ast = downcast<NSSpanningTreeNode>(
                                                         Ag.IGForwardLinkRef());
             if (Ast.mNsGeneration < mNsGeneration) {
                 Ast.mNsGeneration = mNsGeneration;
@@ -82,10 +84,10 @@ void NetworkSimplex::makeInitialZeroBSpanningTree()
 
         auto iPairOut = Ng.incidentEdgesOut();
         for (auto iit = iPairOut.first; iit != iPairOut.second; iit++) {
-            auto& Eg =  dynamic_cast<NetworkSimplexEdge&>(*(*(*iit)));
-            auto& Ag =  dynamic_cast<NetworkSimplexNode&>(Eg.adjacentNode(Ng));
+            auto& Eg =  downcast<NetworkSimplexEdge>(*(*(*iit)));
+            auto& Ag =  downcast<NetworkSimplexNode>(Eg.adjacentNode(Ng));
                                                           
-            auto& Ast = dynamic_cast<NSSpanningTreeNode&>(
+            auto& Ast = downcast<NSSpanningTreeNode>(
                                                         Ag.IGForwardLinkRef());
             if (Ast.mNsGeneration < mNsGeneration) {
                 Ast.mNsGeneration = mNsGeneration;
@@ -103,14 +105,14 @@ void NetworkSimplex::findInitialZeroBX() {
     auto ePair = mG.edges();
     for (auto eit = ePair.first; eit != ePair.second; eit++) {
 
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
         Eg.mX = 0;
     }
 
 }
 
 
-void NetworkSimplex::makeAuxGraph()
+void NetworkSimplex::makeAuxGraph(bool allNodes)
 {
 
     long perturbation = 0;
@@ -119,7 +121,7 @@ void NetworkSimplex::makeAuxGraph()
     auto ePair = mG.edges();
     for(auto eit = ePair.first; eit != ePair.second; eit++) {
 
-        auto& E = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+        auto& E = downcast<NetworkSimplexEdge>(*(*eit));
 
         E.mArtificial    = false;
         E.mC             = 0;
@@ -132,7 +134,7 @@ void NetworkSimplex::makeAuxGraph()
 #else
     auto  np = make_unique<NetworkSimplexNode>();
 #endif
-    auto& Na = dynamic_cast<NetworkSimplexNode&>(mG.addNode(std::move(np)));
+    auto& Na = downcast<NetworkSimplexNode>(mG.addNode(std::move(np)));
                     
     Na.mArtificial    = true;
     Na.mB             = 0;// Artificial node's supply/demand is 0.
@@ -142,12 +144,12 @@ void NetworkSimplex::makeAuxGraph()
     auto nPair = mG.nodes();
     for(auto nit = nPair.first; nit != nPair.second; nit++) {
 
-        auto& Ng = dynamic_cast<NetworkSimplexNode&>(*(*nit));
-        if (Ng.mB != 0) {
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
+        if (nit != mArtificialNodeIt && (Ng.mB != 0 || allNodes)) {
 
             auto  ep = make_unique<NetworkSimplexEdge>();
-            auto& Ea = dynamic_cast<NetworkSimplexEdge&>(mG.addEdge(
-                             std::move(ep), (Ng.mB>0)?Ng:Na, (Ng.mB>0)?Na:Ng));
+            auto& Ea = downcast<NetworkSimplexEdge>(mG.addEdge(
+                           std::move(ep), (Ng.mB>=0)?Ng:Na, (Ng.mB>=0)?Na:Ng));
             Ea.mArtificial    = true;
             Ea.mC             = 1; // Temporary artificial cost.
             Ea.mCperturbation = perturbation++;
@@ -161,13 +163,13 @@ NSSpanningTreeEdge& NetworkSimplex::createSpanningTreeEdge(
     NetworkSimplexEdge& Eg
 ) {
 
-    auto& Ngs  = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-    auto& Ngd  = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
-    auto& Nsts = dynamic_cast<NSSpanningTreeNode&>(Ngs.IGForwardLinkRef());
-    auto& Nstd = dynamic_cast<NSSpanningTreeNode&>(Ngd.IGForwardLinkRef());
+    auto& Ngs  = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+    auto& Ngd  = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
+    auto& Nsts = downcast<NSSpanningTreeNode>(Ngs.IGForwardLinkRef());
+    auto& Nstd = downcast<NSSpanningTreeNode>(Ngd.IGForwardLinkRef());
 
     auto  ep  = make_unique<NSSpanningTreeEdge>();
-    auto& Est = dynamic_cast<NSSpanningTreeEdge&>(mSpanningTree.addEdge(
+    auto& Est = downcast<NSSpanningTreeEdge>(mSpanningTree.addEdge(
                         std::move(ep),
                         Nsts,
                         Nstd,
@@ -183,7 +185,7 @@ NSSpanningTreeEdge& NetworkSimplex::createSpanningTreeEdge(
 
 void NetworkSimplex::removeSpanningTreeEdge(NetworkSimplexEdge& Eg)
 {
-    auto& Est = dynamic_cast<NSSpanningTreeEdge&>(Eg.IGForwardLinkRef());
+    auto& Est = downcast<NSSpanningTreeEdge>(Eg.IGForwardLinkRef());
     Eg.mInBasis = false;
     Eg.popIGForwardLink();
     Est.popIGBackwardLink();
@@ -202,10 +204,10 @@ void NetworkSimplex::makeInitialAuxSpanningTree() {
     auto nPair = mG.nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 
-        auto& Ng = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
 
         auto np = make_unique<NSSpanningTreeNode>();
-        auto& Nst = dynamic_cast<NSSpanningTreeNode&>(
+        auto& Nst = downcast<NSSpanningTreeNode>(
                                          mSpanningTree.addNode(std::move(np)));
         Nst.pushIGBackwardLink(Ng.backIt());
         Ng.pushIGForwardLink(Nst.backIt());
@@ -223,7 +225,7 @@ void NetworkSimplex::makeInitialAuxSpanningTree() {
     }
 
     for (auto eit : mArtificialEdges) {
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
         createSpanningTreeEdge(Eg);
     }
 
@@ -233,13 +235,13 @@ void NetworkSimplex::makeInitialAuxSpanningTree() {
         auto nit = *(nodesToBeChecked.rbegin());
         nodesToBeChecked.pop_back();
 
-        auto& Ng  = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+        auto& Ng  = downcast<NetworkSimplexNode>(*(*nit));
                                                         
         auto iPairIn = Ng.incidentEdgesIn();
         for (auto iit = iPairIn.first; iit != iPairIn.second; iit++) {
-            auto& Eg =  dynamic_cast<NetworkSimplexEdge&>(*(*(*iit)));
-            auto& Ag =  dynamic_cast<NetworkSimplexNode&>(Eg.adjacentNode(Ng));
-            auto& Ast = dynamic_cast<NSSpanningTreeNode&>(
+            auto& Eg =  downcast<NetworkSimplexEdge>(*(*(*iit)));
+            auto& Ag =  downcast<NetworkSimplexNode>(Eg.adjacentNode(Ng));
+            auto& Ast = downcast<NSSpanningTreeNode>(
                                                         Ag.IGForwardLinkRef());
             if (Ast.mNsGeneration < mNsGeneration) {
                 Ast.mNsGeneration = mNsGeneration;
@@ -250,10 +252,10 @@ void NetworkSimplex::makeInitialAuxSpanningTree() {
 
         auto iPairOut = Ng.incidentEdgesOut();
         for (auto iit = iPairOut.first; iit != iPairOut.second; iit++) {
-            auto& Eg =  dynamic_cast<NetworkSimplexEdge&>(*(*(*iit)));
-            auto& Ag =  dynamic_cast<NetworkSimplexNode&>(Eg.adjacentNode(Ng));
+            auto& Eg =  downcast<NetworkSimplexEdge>(*(*(*iit)));
+            auto& Ag =  downcast<NetworkSimplexNode>(Eg.adjacentNode(Ng));
                                                           
-            auto& Ast = dynamic_cast<NSSpanningTreeNode&>(
+            auto& Ast = downcast<NSSpanningTreeNode>(
                                                         Ag.IGForwardLinkRef());
             if (Ast.mNsGeneration < mNsGeneration) {
                 Ast.mNsGeneration = mNsGeneration;
@@ -265,53 +267,71 @@ void NetworkSimplex::makeInitialAuxSpanningTree() {
 }
 
 
+void NetworkSimplex::makeInitialStronglyFeasibleSpanningTree()
+{
+    auto nPair = mG.nodes();
+    for (auto nit = nPair.first; nit != nPair.second; nit++) {
+
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
+
+        auto np = make_unique<NSSpanningTreeNode>();
+        auto& Nst = downcast<NSSpanningTreeNode>(
+                                         mSpanningTree.addNode(std::move(np)));
+        Nst.pushIGBackwardLink(Ng.backIt());
+        Ng.pushIGForwardLink(Nst.backIt());
+    }
+
+    for (auto eit : mArtificialEdges) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        createSpanningTreeEdge(Eg);
+    }
+}
+
+
 void NetworkSimplex::createInitialInternalStructureForSpanningTree()
 {
     auto invalidNodeInST = mSpanningTree.nodes().second;
     auto invalidEdgeInST = mSpanningTree.edges().second;
 
-    // Pick an arbitrary node for the root.
+    // Pick the artificial node for a strongly feasible tree, and an
+    // arbitrary node otherwise.
     auto nPair = mG.nodes();
     mRootIt = nPair.second;
-    for (auto nit = nPair.first; nit != nPair.second; nit++) {
-        auto& Ng  = dynamic_cast<NetworkSimplexNode&>(*(*nit));
-        auto& Ns  = dynamic_cast<NSSpanningTreeNode&>(Ng.IGForwardLinkRef());
-        if (mRootIt == nPair.second && nit != mArtificialNodeIt) {
-            mRootIt = nit;
+    if (mStronglyFeasible) {
+        mRootIt = mArtificialNodeIt;
+    }
+    else {
+        for (auto nit = nPair.first; nit != nPair.second; nit++) {
+            if (nit != mArtificialNodeIt) {
+                mRootIt = nit;
+                break;
+            }
         }
-        Ns.mThreadPrev = invalidNodeInST;
-        Ns.mThreadNext = invalidNodeInST;
     }
 
-    // From the root, create depth, prec, and thread structures.
-    auto& Rg = dynamic_cast<NetworkSimplexNode&>(*(*mRootIt));
-    auto& Rs = dynamic_cast<NSSpanningTreeNode&>(Rg.IGForwardLinkRef());
+    // From the root, create prec, and size.
+    auto& Rg = downcast<NetworkSimplexNode>(*(*mRootIt));
+    auto& Rs = downcast<NSSpanningTreeNode>(Rg.IGForwardLinkRef());
 
     mNsGeneration++;
 
     Rs.initForDFS(mNsGeneration, invalidNodeInST);
-    Rs.mDepth      = 0;
     Rs.mPrec       = invalidEdgeInST;
+    Rs.mSize       = 1;
 
     auto nodeBeingVisited = Rs.backIt();
-    auto nodePrevThread   = Rs.backIt();
 
     while(nodeBeingVisited != invalidNodeInST) {
 
-        auto& Ns = dynamic_cast<NSSpanningTreeNode&>(*(*(nodeBeingVisited)));
+        auto& Ns = downcast<NSSpanningTreeNode>(*(*(nodeBeingVisited)));
 
         if (Ns.hasNextChild()) {
 
             auto& Es = Ns.nextChild();
-            auto& As = dynamic_cast<NSSpanningTreeNode&>(Es.adjacentNode(Ns));
+            auto& As = downcast<NSSpanningTreeNode>(Es.adjacentNode(Ns));
                                                           
-            As.mDepth      = Ns.mDepth + 1;
             As.mPrec       = Es.backIt();
-
-            auto& Np = dynamic_cast<NSSpanningTreeNode&>(*(*nodePrevThread));
-            Np.mThreadNext = As.backIt();
-            As.mThreadPrev = Np.backIt();
-            nodePrevThread = As.backIt();
+            As.mSize       = 1;
 
             As.initForDFS(mNsGeneration, Ns.backIt());
             nodeBeingVisited = As.backIt();
@@ -319,7 +339,13 @@ void NetworkSimplex::createInitialInternalStructureForSpanningTree()
         }
         else {
 
+            // The subtree of Ns is complete.
             nodeBeingVisited = Ns.dfsParent();
+            if (nodeBeingVisited != invalidNodeInST) {
+                auto& Ps = downcast<NSSpanningTreeNode>(
+                                                      *(*(nodeBeingVisited)));
+                Ps.mSize += Ns.mSize;
+            }
         }
     }
 }
@@ -328,8 +354,8 @@ void NetworkSimplex::createInitialInternalStructureForSpanningTree()
 void NetworkSimplex::findInitialY() {
 //cerr << "findInitialY() BEGIN\n";
     // From the root, find mY in DFS on the spanning tree.
-    auto& Rg  = dynamic_cast<NetworkSimplexNode&>(*(*mRootIt));
-    auto& Rst = dynamic_cast<NSSpanningTreeNode&>(Rg.IGForwardLinkRef());
+    auto& Rg  = downcast<NetworkSimplexNode>(*(*mRootIt));
+    auto& Rst = downcast<NSSpanningTreeNode>(Rg.IGForwardLinkRef());
 //cerr << "findInitialY() 1\n";
     mNsGeneration++;
     auto invalidNodeInST = mSpanningTree.nodes().second;
@@ -340,25 +366,25 @@ void NetworkSimplex::findInitialY() {
 //cerr << "findInitialY() 2\n";   
     while(nodeBeingVisited != invalidNodeInST) {
 //cerr << "findInitialY() 3\n";
-        auto& Ns = dynamic_cast<NSSpanningTreeNode&>(*(*(nodeBeingVisited)));
-        auto& Ng = dynamic_cast<NetworkSimplexNode&>(Ns.IGBackwardLinkRef());
+        auto& Ns = downcast<NSSpanningTreeNode>(*(*(nodeBeingVisited)));
+        auto& Ng = downcast<NetworkSimplexNode>(Ns.IGBackwardLinkRef());
 //cerr << "findInitialY() 4\n";
         if (Ns.hasNextChild()) {
 //cerr << "findInitialY() 5\n";
             auto& Es = Ns.nextChild();
-            auto& Eg = dynamic_cast<NetworkSimplexEdge&>(
+            auto& Eg = downcast<NetworkSimplexEdge>(
                                                        Es.IGBackwardLinkRef());
-            auto& As = dynamic_cast<NSSpanningTreeNode&>(Es.adjacentNode(Ns));
+            auto& As = downcast<NSSpanningTreeNode>(Es.adjacentNode(Ns));
 //cerr << "findInitialY() 6\n";
             if (Eg.incidentNodeSrc().backIt() == Ng.backIt()) {
                 // Discovered(Ng) ====> New (Nd)
-                auto& Nd = dynamic_cast<NetworkSimplexNode&>(
+                auto& Nd = downcast<NetworkSimplexNode>(
                                                          Eg.incidentNodeDst());
                 Nd.mY = Ng.mY + Eg.mC;
             }
             else {
                 // New (Ns) ====> Discovered(Ng)
-                auto& Ns = dynamic_cast<NetworkSimplexNode&>(
+                auto& Ns = downcast<NetworkSimplexNode>(
                                                          Eg.incidentNodeSrc());
                 Ns.mY = Ng.mY - Eg.mC;
             }
@@ -384,19 +410,19 @@ void NetworkSimplex::findInitialZ() {
     auto ePair = mG.edges();
     for (auto eit = ePair.first; eit != ePair.second; eit++) {
 //cerr << "findInitialZ() 1\n";
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
 
         if (Eg.mInBasis) {
 //cerr << "findInitialZ() 2\n";
             Eg.mZ = 0;
         }
         else {
-            auto& Ns = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-            auto& Nd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
+            auto& Ns = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+            auto& Nd = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
 
             Eg.mZ = Eg.mC - Nd.mY + Ns.mY;
 //cerr << "findInitialZ() 3: ]" << Eg.mZ << "\n";
-            if (Eg.mZ < 0) {
+            if (Eg.mZ < 0 && isEnteringCandidate(Eg)) {
 //cerr << "findInitialZ() 4\n";
                 Eg.mNZEbackIt = mNegativeZEdges.insert(
                                            mNegativeZEdges.end(), Eg.backIt());
@@ -412,9 +438,9 @@ void NetworkSimplex::findInitialAuxX() {
     auto ePair = mG.edges();
     for (auto eit = ePair.first; eit != ePair.second; eit++) {
 
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
-        auto& Ns = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-        auto& Nd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        auto& Ns = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+        auto& Nd = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
 
         if (Eg.mArtificial) {
             if (Ns.backIt() == mArtificialNodeIt) {
@@ -439,67 +465,67 @@ bool NetworkSimplex::pivot() {
     }
 
     // Find a non-basis edge that has negative Z.
-    auto& Eenter = dynamic_cast<NetworkSimplexEdge&>(
-                                             *(*(*(mNegativeZEdges.begin()))));
+    auto& Eenter = findEnteringEdge();
+    mNumPivots++;
 #ifdef UNIT_TESTS_DEBUG_PRINT
     {
-        auto& Ngs =dynamic_cast<NetworkSimplexNode&>(Eenter.incidentNodeSrc());
-        auto& Ngd =dynamic_cast<NetworkSimplexNode&>(Eenter.incidentNodeDst());
+        auto& Ngs =downcast<NetworkSimplexNode>(Eenter.incidentNodeSrc());
+        auto& Ngd =downcast<NetworkSimplexNode>(Eenter.incidentNodeDst());
         cerr << "Entering: (" << Ngs.mDebugId << "," << Ngd.mDebugId << ")\n";
     }
 #endif
 
-    vector<edge_list_it_t> cycle = findCycle(Eenter);
+    findCycle(Eenter, mCycle);
 
 #ifdef UNIT_TESTS_DEBUG_PRINT
     cerr << "Cycle: ";
-    for (auto cit : cycle) {
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*cit));
-        auto& Ngs = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-        auto& Ngd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
+    for (auto cit : mCycle) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*cit));
+        auto& Ngs = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+        auto& Ngd = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
         cerr << "(" << Ngs.mDebugId << "," << Ngd.mDebugId << ") ";
     }
     cerr << "\n";
 #endif
 
-    auto& Eleave = findLeavingEdge(Eenter, cycle);
+    auto& Eleave = findLeavingEdge(Eenter, mCycle);
 
 #ifdef UNIT_TESTS_DEBUG_PRINT
     {
-        auto& Ngs =dynamic_cast<NetworkSimplexNode&>(Eleave.incidentNodeSrc());
-        auto& Ngd =dynamic_cast<NetworkSimplexNode&>(Eleave.incidentNodeDst());
+        auto& Ngs =downcast<NetworkSimplexNode>(Eleave.incidentNodeSrc());
+        auto& Ngd =downcast<NetworkSimplexNode>(Eleave.incidentNodeDst());
         cerr << "Leaving: (" << Ngs.mDebugId << "," << Ngd.mDebugId << ")\n";
     }
 #endif
 
-    vector<node_list_it_t> subtreeNodes = findSubtree(Eleave);
+    findSubtree(Eleave, mSideNodes);
 
 #ifdef UNIT_TESTS_DEBUG_PRINT
-    cerr << "Subtree nodes: ";
-    for (auto nit : subtreeNodes) {
-        auto& Ng = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+    cerr << (mSideIsSubtree?"Subtree nodes: ":"Non-subtree nodes: ");
+    for (auto nit : mSideNodes) {
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
         cerr << Ng.mDebugId << " ";
     }
     cerr << "\n";
 #endif
 
-    vector<edge_list_it_t> cut =findCutSet(subtreeNodes);
+    findCutSet(mSideNodes, mCut);
 
 #ifdef UNIT_TESTS_DEBUG_PRINT
     cerr << "Cut: ";
-    for (auto eit : cut) {
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));  
-        auto& Ngs = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-        auto& Ngd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
+    for (auto eit : mCut) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));  
+        auto& Ngs = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+        auto& Ngd = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
         cerr << "(" << Ngs.mDebugId << "," << Ngd.mDebugId << ") ";
     }
     cerr << "\n";
 #endif
 
 
-    updateX(cycle, Eenter, Eleave);
-    updateY(subtreeNodes, Eenter);
-    updateZ(cut);
+    updateX(mCycle, Eenter, Eleave);
+    updateY(mSideNodes, Eenter);
+    updateZ(mCut);
     updateSpanningTree(Eenter, Eleave);
 
 
@@ -512,58 +538,136 @@ bool NetworkSimplex::pivot() {
 }
 
 
-vector<edge_list_it_t> NetworkSimplex::findCycle(NetworkSimplexEdge& Eg)
+NetworkSimplexEdge& NetworkSimplex::findEnteringEdge()
 {
-    list<edge_list_it_t> edgeListInG1;
-    list<edge_list_it_t> edgeListInG2;
-    auto& Ngs = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-    auto& Ngd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
-    auto NsIt1 = Ngs.IGForwardLink();
-    auto NsIt2 = Ngd.IGForwardLink();
-    while (NsIt1!= NsIt2) {
-        auto& Ns1 = dynamic_cast<NSSpanningTreeNode&>(*(*NsIt1));
-        auto& Ns2 = dynamic_cast<NSSpanningTreeNode&>(*(*NsIt2));
-        if (Ns1.mDepth == Ns2.mDepth) {
-            auto& Es1 = dynamic_cast<NSSpanningTreeEdge&>(*(*(Ns1.mPrec)));
-            auto& Es2 = dynamic_cast<NSSpanningTreeEdge&>(*(*(Ns2.mPrec)));
-            auto& As1 = dynamic_cast<NSSpanningTreeNode&>(
-                                                        Es1.adjacentNode(Ns1));
-            auto& As2 = dynamic_cast<NSSpanningTreeNode&>(
-                                                        Es2.adjacentNode(Ns2));
-            edgeListInG1.push_front(Es1.IGBackwardLink());
-            edgeListInG2.push_back(Es2.IGBackwardLink());
-
-            NsIt1 = As1.backIt();
-            NsIt2 = As2.backIt();
-        }
-        else if (Ns1.mDepth > Ns2.mDepth) {
-            auto& Es1 = dynamic_cast<NSSpanningTreeEdge&>(*(*(Ns1.mPrec)));
-            auto& As1 = dynamic_cast<NSSpanningTreeNode&>(
-                                                        Es1.adjacentNode(Ns1));
-            edgeListInG1.push_front(Es1.IGBackwardLink());
-            NsIt1 = As1.backIt();
-        }
-        else { //(Ns1.mDepth < Ns2.mDepth)
-            auto& Es2 = dynamic_cast<NSSpanningTreeEdge&>(*(*(Ns2.mPrec)));
-            auto& As2 = dynamic_cast<NSSpanningTreeNode&>(
-                                                        Es2.adjacentNode(Ns2));
-            edgeListInG2.push_back(Es2.IGBackwardLink());
-
-            NsIt2 = As2.backIt();
-        }        
-    }
-
-    vector<edge_list_it_t> combinedListInG;
-
-    for (auto e : edgeListInG2) {
-        combinedListInG.push_back(e);
-    }    
-
-    for (auto e : edgeListInG1) {
-        combinedListInG.push_back(e);
-    }    
-
-    return combinedListInG;
+    if (mPricing == FIRST_ELIGIBLE) {
+        return downcast<NetworkSimplexEdge>(
+                                             *(*(*(mNegativeZEdges.begin()))));
+    }
+
+    if (mPricing == CYCLIC) {
+        // There is at least one non-basis edge with negative Z.
+        auto ePair = mG.edges();
+        while (true) {
+            if (mEdgeCursor == ePair.second) {
+                mEdgeCursor = ePair.first;
+            }
+            auto& Eg = downcast<NetworkSimplexEdge>(*(*mEdgeCursor));
+            mEdgeCursor++;
+            if (!Eg.mInBasis && Eg.mZ < 0 && isEnteringCandidate(Eg)) {
+                return Eg;
+            }
+        }
+    }
+
+    size_t numCandidates;
+    if (mPricing == MOST_NEGATIVE) {
+        numCandidates = mNegativeZEdges.size();
+        mPricingCursor = mNegativeZEdges.begin();
+    }
+    else {
+        numCandidates = mBlockSize;
+        if (numCandidates == 0) {
+            numCandidates = size_t(sqrt(double(mG.numEdges())));
+        }
+        if (numCandidates == 0) {
+            numCandidates = 1;
+        }
+    }
+
+    // Scan numCandidates edges from mPricingCursor wrapping around at the
+    // end of the list. Ties are broken by the perturbation.
+    NetworkSimplexEdge* Ebest = nullptr;
+    for (size_t i = 0; i < numCandidates && i < mNegativeZEdges.size(); i++) {
+
+        if (mPricingCursor == mNegativeZEdges.end()) {
+            mPricingCursor = mNegativeZEdges.begin();
+        }
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*(*mPricingCursor)));
+        if ( Ebest == nullptr || Eg.mZ < Ebest->mZ ||
+            (Eg.mZ == Ebest->mZ && Eg.mCperturbation<Ebest->mCperturbation)) {
+            Ebest = &Eg;
+        }
+        mPricingCursor++;
+    }
+
+    return *Ebest;
+}
+
+
+void NetworkSimplex::eraseNegativeZEdge(NetworkSimplexEdge& Eg)
+{
+    if (mPricingCursor == Eg.mNZEbackIt) {
+        mPricingCursor++;
+    }
+    mNegativeZEdges.erase(Eg.mNZEbackIt);
+}
+
+
+void NetworkSimplex::findCycle(
+    NetworkSimplexEdge&     Eg,
+    vector<edge_list_it_t>& cycle
+) {
+    // (ve2, apex) part goes to cycle, and (ve1, apex) part goes to 
+    // mCycleHalf, which is appended in the reverse order at the end.
+    cycle.clear();
+    mCycleHalf.clear();
+    auto& Ngs = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+    auto& Ngd = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
+    auto& Nsts = downcast<NSSpanningTreeNode>(Ngs.IGForwardLinkRef());
+    auto& Nstd = downcast<NSSpanningTreeNode>(Ngd.IGForwardLinkRef());
+
+    auto& Pst = findApex(Nsts, Nstd);
+
+    for (auto* Nst = &Nstd; Nst != &Pst; Nst = &parentSpanningTreeNode(*Nst)){
+        auto& Est = downcast<NSSpanningTreeEdge>(*(*(Nst->mPrec)));
+        cycle.push_back(Est.IGBackwardLink());
+    }
+    mApexPos = cycle.size();
+
+    for (auto* Nst = &Nsts; Nst != &Pst; Nst = &parentSpanningTreeNode(*Nst)){
+        auto& Est = downcast<NSSpanningTreeEdge>(*(*(Nst->mPrec)));
+        mCycleHalf.push_back(Est.IGBackwardLink());
+    }
+
+    cycle.insert(cycle.end(), mCycleHalf.rbegin(), mCycleHalf.rend());
+}
+
+
+NSSpanningTreeNode& NetworkSimplex::findApex(
+    NSSpanningTreeNode& N1st,
+    NSSpanningTreeNode& N2st
+) {
+    // Climb from the two nodes alternately marking the nodes. The first
+    // node found marked by the other climb is the apex.
+    mCycleGeneration++;
+
+    auto invalidEdgeInST = mSpanningTree.edges().second;
+    auto* P1st = &N1st;
+    auto* P2st = &N2st;
+
+    P1st->mCycleGeneration = mCycleGeneration;
+    if (P2st->mCycleGeneration == mCycleGeneration) {
+        return *P2st;
+    }
+    P2st->mCycleGeneration = mCycleGeneration;
+
+    while (true) {
+        if (P1st->mPrec != invalidEdgeInST) {
+            P1st = &parentSpanningTreeNode(*P1st);
+            if (P1st->mCycleGeneration == mCycleGeneration) {
+                return *P1st;
+            }
+            P1st->mCycleGeneration = mCycleGeneration;
+        }
+        if (P2st->mPrec != invalidEdgeInST) {
+            P2st = &parentSpanningTreeNode(*P2st);
+            if (P2st->mCycleGeneration == mCycleGeneration) {
+                return *P2st;
+            }
+            P2st->mCycleGeneration = mCycleGeneration;
+        }
+    }
 }
 
 
@@ -571,115 +675,152 @@ NetworkSimplexEdge& NetworkSimplex::findLeavingEdge(
     NetworkSimplexEdge&     Eg,
     vector<edge_list_it_t>& cycle
 ) {
-    auto prevIt = Eg.incidentNodeDst().backIt();
-    long minX  = 0;
-    long pert  = 0;
-    auto minIt = mG.edges().second;
-    for (auto eit : cycle) {
-        auto& Cg  = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+    // The cycle is (ve2, apex, ve1), and the apex is at mApexPos.
+    size_t apexPos  = mApexPos;
+
+    // Among the edges against the orientation with the minimum X, pick the
+    // one with the smallest perturbation, or for a strongly feasible tree,
+    // the last one from the apex along the orientation, i.e., 
+    // (apex,ve1) part, (ve1,ve2), and then (ve2,apex) part.
+    auto   prevIt = Eg.incidentNodeDst().backIt();
+    long   minX   = 0;
+    long   pert   = 0;
+    size_t maxPos = 0;
+    auto   minIt  = mG.edges().second;
+    for (size_t i = 0; i < cycle.size(); i++) {
+        auto& Cg  = downcast<NetworkSimplexEdge>(*(*(cycle[i])));
         if (Cg.incidentNodeSrc().backIt() == prevIt) {
             prevIt = Cg.incidentNodeDst().backIt();
         }
         else {
-            if (minIt == mG.edges().second) {
-                minX  = Cg.mX;
-                pert  = Cg.mCperturbation;
-                minIt = Cg.backIt();
+            size_t pos = (i < apexPos) ? (i + cycle.size()) : i;
+            bool   better;
+            if (minIt == mG.edges().second || Cg.mX < minX) {
+                better = true;
             }
-            else if (Cg.mX < minX) {
-                minX  = Cg.mX;
-                pert  = Cg.mCperturbation;
-                minIt = Cg.backIt();
+            else if (Cg.mX > minX) {
+                better = false;
             }
-            else if (Cg.mX == minX && Cg.mCperturbation < pert) {
-
-                minX  = Cg.mX;
-                pert  = Cg.mCperturbation;
-                minIt = Cg.backIt();
+            else if (mStronglyFeasible) {
+                better = (pos > maxPos);
+            }
+            else {
+                better = (Cg.mCperturbation < pert);
+            }
+            if (better) {
+                minX   = Cg.mX;
+                pert   = Cg.mCperturbation;
+                maxPos = pos;
+                minIt  = Cg.backIt();
             }
             prevIt = Cg.incidentNodeSrc().backIt();
         }
     }
 
-    return dynamic_cast<NetworkSimplexEdge&>(*(*minIt));
+    return downcast<NetworkSimplexEdge>(*(*minIt));
 }
 
 
 NSSpanningTreeNode& NetworkSimplex::deeperSpanningTreeNode(
     NetworkSimplexEdge& Eg
 ) {
-    auto& N1g = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNode1());
-    auto& N2g = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNode2());
-    auto& N1st = dynamic_cast<NSSpanningTreeNode&>(N1g.IGForwardLinkRef());
-    auto& N2st = dynamic_cast<NSSpanningTreeNode&>(N2g.IGForwardLinkRef());
-    return (N1st.mDepth > N2st.mDepth)?N1st:N2st;
+    auto& N1g = downcast<NetworkSimplexNode>(Eg.incidentNode1());
+    auto& N2g = downcast<NetworkSimplexNode>(Eg.incidentNode2());
+    auto& N1st = downcast<NSSpanningTreeNode>(N1g.IGForwardLinkRef());
+    auto& N2st = downcast<NSSpanningTreeNode>(N2g.IGForwardLinkRef());
+    return (N1st.mPrec == Eg.IGForwardLink())?N1st:N2st;
 }
 
 
+void NetworkSimplex::collectSpanningTreeNodes(
+    NSSpanningTreeNode&     Sst,
+    edge_list_it_t          blocked,
+    vector<node_list_it_t>& nodes
+) {
+    mDfsStack.clear();
+    mDfsStack.push_back(make_pair(Sst.backIt(), blocked));
 
-vector<node_list_it_t> NetworkSimplex::findSubtree(NetworkSimplexEdge& Eleave)
-{
+    while (!mDfsStack.empty()) {
 
-    mNsGeneration++;        
+        auto nit  = mDfsStack.back().first;
+        auto from = mDfsStack.back().second;
+        mDfsStack.pop_back();
 
-    vector<node_list_it_t> subtreeNodes;
+        auto& Nst = downcast<NSSpanningTreeNode>(*(*nit));
+        Nst.mNsGeneration = mNsGeneration;
+        nodes.push_back(Nst.IGBackwardLink());
+
+        auto iPair = Nst.incidentEdges();
+        for (auto iit = iPair.first; iit != iPair.second; iit++) {
+            if (*iit != from && *iit != blocked) {
+                auto& Est = downcast<NSSpanningTreeEdge>(*(*(*iit)));
+                mDfsStack.push_back(
+                               make_pair(Est.adjacentNode(Nst).backIt(), *iit));
+            }
+        }
+    }
+}
 
-    auto& Rst  = deeperSpanningTreeNode(Eleave);
 
-    auto nit = Rst.backIt();
+void NetworkSimplex::findSubtree(
+    NetworkSimplexEdge&     Eleave,
+    vector<node_list_it_t>& sideNodes
+) {
+    sideNodes.clear();
 
-    while(nit != mSpanningTree.nodes().second) {
+    mNsGeneration++;
 
-        auto& Nst = dynamic_cast<NSSpanningTreeNode&>(*(*nit));
-        auto& Ng  = dynamic_cast<NetworkSimplexNode&>(Nst.IGBackwardLinkRef());
+    auto& Rst = deeperSpanningTreeNode(Eleave);
 
-        if (Nst.mDepth <= Rst.mDepth && nit != Rst.backIt()) {
-            break;
-        }
-        Nst.mNsGeneration = mNsGeneration;
-        subtreeNodes.push_back(Ng.backIt());
-        nit = Nst.mThreadNext;
+    mSideIsSubtree = (size_t(Rst.mSize) * 2 <= mSpanningTree.numNodes());
+
+    if (mSideIsSubtree) {
+        collectSpanningTreeNodes(Rst, Eleave.IGForwardLink(), sideNodes);
+    }
+    else {
+        // ST\STnr is smaller.
+        auto& Tg  = downcast<NetworkSimplexNode>(*(*mRootIt));
+        auto& Tst = downcast<NSSpanningTreeNode>(Tg.IGForwardLinkRef());
+        collectSpanningTreeNodes(Tst, Eleave.IGForwardLink(), sideNodes);
     }
-    return subtreeNodes;
 }
 
 
-vector<edge_list_it_t> NetworkSimplex::findCutSet(
-    vector<node_list_it_t>& subtreeNodes
+void NetworkSimplex::findCutSet(
+    vector<node_list_it_t>& sideNodes,
+    vector<edge_list_it_t>& cut
 ) {
 
-    vector<edge_list_it_t> cutSet;
+    cut.clear();
 
-    for (auto nit : subtreeNodes) {
+    for (auto nit : sideNodes) {
 
-        auto& Ng  = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+        auto& Ng  = downcast<NetworkSimplexNode>(*(*nit));
 
         auto iPairIn = Ng.incidentEdgesIn();
         for (auto iit = iPairIn.first; iit != iPairIn.second; iit++) {
-            auto& IEg = dynamic_cast<NetworkSimplexEdge&>(*(*(*iit)));
-            auto& Ag  = dynamic_cast<NetworkSimplexNode&>(
+            auto& IEg = downcast<NetworkSimplexEdge>(*(*(*iit)));
+            auto& Ag  = downcast<NetworkSimplexNode>(
                                                          IEg.adjacentNode(Ng));
-            auto& Ast = dynamic_cast<NSSpanningTreeNode&>(
+            auto& Ast = downcast<NSSpanningTreeNode>(
                                                         Ag.IGForwardLinkRef());
-            if (Ast.mNsGeneration < mNsGeneration) {
-                cutSet.push_back(*iit);
+            if (isInSubtree(Ast) != mSideIsSubtree) {
+                cut.push_back(*iit);
             }
         }
 
         auto iPairOut = Ng.incidentEdgesOut();
         for (auto iit = iPairOut.first; iit != iPairOut.second; iit++) {
-            auto& IEg = dynamic_cast<NetworkSimplexEdge&>(*(*(*iit)));
-            auto& Ag  = dynamic_cast<NetworkSimplexNode&>(
+            auto& IEg = downcast<NetworkSimplexEdge>(*(*(*iit)));
+            auto& Ag  = downcast<NetworkSimplexNode>(
                                                          IEg.adjacentNode(Ng));
-            auto& Ast = dynamic_cast<NSSpanningTreeNode&>(
+            auto& Ast = downcast<NSSpanningTreeNode>(
                                                         Ag.IGForwardLinkRef());
-            if (Ast.mNsGeneration < mNsGeneration) {
-                cutSet.push_back(*iit);
+            if (isInSubtree(Ast) != mSideIsSubtree) {
+                cut.push_back(*iit);
             }
         }
     }
-
-    return cutSet;
 }
 
 
@@ -690,10 +831,13 @@ void NetworkSimplex::updateX(
 ) {
 
     auto prevIt = Eenter.incidentNodeDst().backIt();
-    auto t      = Eleave.mX;
+
+    // Eleave is against the orientation with non-negative X for the primal
+    // pivots, and along it with negative X for the dual ones.
+    auto t      = (Eleave.mX >= 0) ? Eleave.mX : -1 * Eleave.mX;
 
     for (auto eit : cycle) {
-        auto& Cg  = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+        auto& Cg  = downcast<NetworkSimplexEdge>(*(*eit));
                                                          
         if (Cg.incidentNodeSrc().backIt() == prevIt) {
             Cg.mX += t;
@@ -710,22 +854,38 @@ void NetworkSimplex::updateX(
 
 
 void NetworkSimplex::updateY(
-    vector<node_list_it_t>& subtreeNodes,
+    vector<node_list_it_t>& sideNodes,
     NetworkSimplexEdge&     Eenter
 ) {
-    auto& Ngs  = dynamic_cast<NetworkSimplexNode&>(Eenter.incidentNodeSrc());
-    auto& Nsts = dynamic_cast<NSSpanningTreeNode&>(Ngs.IGForwardLinkRef());
+    auto& Ngs  = downcast<NetworkSimplexNode>(Eenter.incidentNodeSrc());
+    auto& Nsts = downcast<NSSpanningTreeNode>(Ngs.IGForwardLinkRef());
     auto t = Eenter.mZ;
-    for (auto nit : subtreeNodes) {
-        auto& N = dynamic_cast<NetworkSimplexNode&>(*(*nit));
-        if (Nsts.mNsGeneration < mNsGeneration) {
-            // Source node is on the root side.
-            N.mY += t;
-        }
-        else {
-            // Destination node is on the root side.
-            N.mY -= t;
-        }
+    if (isInSubtree(Nsts)) {
+        // Destination node is on the root side.
+        t = -1 * t;
+    }
+    if (!mSideIsSubtree) {
+        // Shifting ST\STnr in the opposite direction gives the same Z.
+        t = -1 * t;
+    }
+    for (auto nit : sideNodes) {
+        auto& N = downcast<NetworkSimplexNode>(*(*nit));
+        N.mY += t;
+    }
+}
+
+
+void NetworkSimplex::anchorY()
+{
+    auto& Rg = downcast<NetworkSimplexNode>(*(*mRootIt));
+    auto  t  = Rg.mY;
+    if (t == 0) {
+        return;
+    }
+    auto nPair = mG.nodes();
+    for (auto nit = nPair.first; nit != nPair.second; nit++) {
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
+        Ng.mY -= t;
     }
 }
 
@@ -735,20 +895,24 @@ void NetworkSimplex::updateZ(vector<edge_list_it_t>& cut)
 
     for (auto eit : cut) {
 
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
-        auto& Ns = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-        auto& Nd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        auto& Ns = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+        auto& Nd = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
 
         auto oldZ = Eg.mZ;
 
         Eg.mZ = Eg.mC - Nd.mY + Ns.mY;
 
+        if (!isEnteringCandidate(Eg)) {
+            continue;
+        }
+
         if (oldZ >= 0 && Eg.mZ < 0) {
             Eg.mNZEbackIt = mNegativeZEdges.insert(
                                           mNegativeZEdges.end(), Eg.backIt());
         }
         else if  (oldZ < 0 && Eg.mZ >= 0) {
-            mNegativeZEdges.erase(Eg.mNZEbackIt);
+            eraseNegativeZEdge(Eg);
         }
     }
 }
@@ -756,26 +920,26 @@ void NetworkSimplex::updateZ(vector<edge_list_it_t>& cut)
 
 NSSpanningTreeNode& NetworkSimplex::rootSideOfEnter(NetworkSimplexEdge& Eg)
 {
-    auto& Ngs  = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-    auto& Nsts = dynamic_cast<NSSpanningTreeNode&>(Ngs.IGForwardLinkRef());
+    auto& Ngs  = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+    auto& Nsts = downcast<NSSpanningTreeNode>(Ngs.IGForwardLinkRef());
 
-    auto& Ngd  = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
-    auto& Nstd = dynamic_cast<NSSpanningTreeNode&>(Ngd.IGForwardLinkRef());
+    auto& Ngd  = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
+    auto& Nstd = downcast<NSSpanningTreeNode>(Ngd.IGForwardLinkRef());
 
-    return (Nsts.mNsGeneration < mNsGeneration)?Nsts:Nstd;
+    return isInSubtree(Nsts)?Nstd:Nsts;
 }
 
 
 NSSpanningTreeNode& NetworkSimplex::nonRootSideOfEnter(
     NetworkSimplexEdge& Eg
 ) {
-    auto& Ngs  = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-    auto& Nsts = dynamic_cast<NSSpanningTreeNode&>(Ngs.IGForwardLinkRef());
+    auto& Ngs  = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+    auto& Nsts = downcast<NSSpanningTreeNode>(Ngs.IGForwardLinkRef());
 
-    auto& Ngd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
-    auto& Nstd = dynamic_cast<NSSpanningTreeNode&>(Ngd.IGForwardLinkRef());
+    auto& Ngd = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
+    auto& Nstd = downcast<NSSpanningTreeNode>(Ngd.IGForwardLinkRef());
 
-    return (Nsts.mNsGeneration < mNsGeneration)?Nstd:Nsts;
+    return isInSubtree(Nsts)?Nsts:Nstd;
 }
 
 
@@ -783,206 +947,362 @@ void NetworkSimplex::updateSpanningTree(
     NetworkSimplexEdge& Eenter,
     NetworkSimplexEdge& Eleave
 ) {
-
-    // Identify the new thread's link points.
-    
     auto& Ast  = rootSideOfEnter(Eenter);    // Root side
     auto& Rst  = nonRootSideOfEnter(Eenter); // STnr side
     auto& LDst = deeperSpanningTreeNode(Eleave);
+    auto& LPst = parentSpanningTreeNode(LDst);
 
 #ifdef UNIT_TESTS_DEBUG_PRINT
     {
-        auto& Ag = dynamic_cast<NetworkSimplexNode&>(Ast.IGBackwardLinkRef());
-        auto& Rg = dynamic_cast<NetworkSimplexNode&>(Rst.IGBackwardLinkRef());
-        auto& LDg= dynamic_cast<NetworkSimplexNode&>(LDst.IGBackwardLinkRef());
+        auto& Ag = downcast<NetworkSimplexNode>(Ast.IGBackwardLinkRef());
+        auto& Rg = downcast<NetworkSimplexNode>(Rst.IGBackwardLinkRef());
+        auto& LDg= downcast<NetworkSimplexNode>(LDst.IGBackwardLinkRef());
         cerr << "Ag:" << Ag.mDebugId << "\n";
         cerr << "Rg:" << Rg.mDebugId << "\n";
         cerr << "LDg:" << LDg.mDebugId << "\n";
     }
 #endif
 
-    // New subtree will be inserted between Ast and astNextIt.
-
-    auto ldPrevIt  = LDst.mThreadPrev;
+    // STnr moves from below LPst to below Ast. The sizes change only
+    // below the apex.
+    auto& Pst  = findApex(Ast, LPst);
+    long  size = LDst.mSize;
+    for (auto* Nst = &LPst; Nst != &Pst; Nst = &parentSpanningTreeNode(*Nst)){
+        Nst->mSize -= size;
+    }
+    for (auto* Nst = &Ast;  Nst != &Pst; Nst = &parentSpanningTreeNode(*Nst)){
+        Nst->mSize += size;
+    }
 
+    removeSpanningTreeEdge(Eleave);
+    createSpanningTreeEdge(Eenter);
 
-#ifdef UNIT_TESTS_DEBUG_PRINT
-    {
-        auto& LDstPrev = dynamic_cast<NSSpanningTreeNode&>(*(*(ldPrevIt)));
-        auto& LDgPrev  = dynamic_cast<NetworkSimplexNode&>(
-                                                 LDstPrev.IGBackwardLinkRef());
-        cerr << "LDgPrev:" << LDgPrev.mDebugId << "\n";
+    // Re-hang STnr from Rst by reversing the parent edges on the path from
+    // Rst to LDst. The new size of a node on the path is the size of STnr
+    // minus the old size of the previous node on the path.
+    auto  newPrec     = Eenter.IGForwardLink();
+    long  prevOldSize = 0;
+    auto* Nst         = &Rst;
+    while (true) {
+        auto  oldPrec = Nst->mPrec;
+        long  oldSize = Nst->mSize;
+        bool  last    = (Nst == &LDst);
+        auto* Next    = last ? nullptr : &parentSpanningTreeNode(*Nst);
+        Nst->mPrec    = newPrec;
+        Nst->mSize    = size - prevOldSize;
+        if (last) {
+            break;
+        }
+        newPrec     = oldPrec;
+        prevOldSize = oldSize;
+        Nst         = Next;
     }
-#endif
+}
 
-    // From LDst, follow the thread until the node that is shallower or 
-    // at the same level as LDst.
-    auto invalidNodeInST = mSpanningTree.nodes().second;
-    auto ldNextIt = LDst.mThreadNext;
-    while (ldNextIt != invalidNodeInST) {
 
-        auto& N = dynamic_cast<NSSpanningTreeNode&>(*(*ldNextIt));
-        if (N.mDepth <= LDst.mDepth) {
-            break;
-        }        
+void NetworkSimplex::replaceDegenerateArtificialBasisEdges(bool keepZ)
+{
+    bool keptOne = false;
+    for (auto eit : mArtificialEdges) {
 
-        ldNextIt = N.mThreadNext;
-    }
+        auto& Eleave = downcast<NetworkSimplexEdge>(*(*eit));
+        if (!Eleave.mInBasis) {
+            continue;
+        }
+        if (!keptOne) {
+            keptOne = true;
+            continue;
+        }
 
-#ifdef UNIT_TESTS_DEBUG_PRINT
-    {
-        if (ldNextIt == invalidNodeInST) {
-            cerr << "LDgNext: (Null)\n";
+        // Both sides of the cut have a non-artificial node, and the 
+        // digraph is connected. Eleave is the only basis edge in the cut.
+        findSubtree(Eleave, mSideNodes);
+        findCutSet(mSideNodes, mCut);
+        NetworkSimplexEdge* Eenter = nullptr;
+        for (auto cit : mCut) {
+            auto& Eg = downcast<NetworkSimplexEdge>(*(*cit));
+            if (Eg.mArtificial) {
+                continue;
+            }
+            if (!keepZ) {
+                Eenter = &Eg;
+                break;
+            }
+            if ( Eenter == nullptr || Eg.mZ < Eenter->mZ ||
+                (Eg.mZ == Eenter->mZ &&
+                                Eg.mCperturbation < Eenter->mCperturbation)) {
+                Eenter = &Eg;
+            }
         }
-        else {
-            auto& LDstNext = dynamic_cast<NSSpanningTreeNode&>(*(*(ldNextIt)));
-            auto& LDgNext  = dynamic_cast<NetworkSimplexNode&>(
-                                                 LDstNext.IGBackwardLinkRef());
-            cerr << "LDgNext:" << LDgNext.mDebugId << "\n";
+        if (Eenter == nullptr) {
+            continue;
         }
+        if (keepZ) {
+            // Shift Y of one side so that Eenter gets tight. The other
+            // edges in the same direction had Z not smaller than Eenter,
+            // and the ones in the opposite direction get larger Z.
+            updateY(mSideNodes, *Eenter);
+            updateZ(mCut);
+        }
+        // Degenerate pivot. No change in X.
+        updateSpanningTree(*Eenter, Eleave);
     }
-#endif
-    // Update the thread link on the leaving side
-    if (ldPrevIt != invalidNodeInST) {
-          auto& LDprev = dynamic_cast<NSSpanningTreeNode&>(*(*ldPrevIt));
-          LDprev.mThreadNext = ldNextIt;
-    }
+}
 
-    if (ldNextIt != invalidNodeInST) {
-          auto& LDnext = dynamic_cast<NSSpanningTreeNode&>(*(*ldNextIt));
-          LDnext.mThreadPrev = ldPrevIt;
-    }
 
-    // Remove Eleave from the spanning tree.
-    removeSpanningTreeEdge(Eleave);
+void NetworkSimplex::restoreOriginalProblem() {
 
-    // DFS into the subtree and update values.
-    mNsGeneration++;
+    auto& Ag  = downcast<NetworkSimplexNode>(*(*mArtificialNodeIt));
+    auto& Ast = downcast<NSSpanningTreeNode>(Ag.IGForwardLinkRef());
 
-    Rst.mDepth = Ast.mDepth + 1;
+    mG.removeNode(Ag);
+    mSpanningTree.removeNode(Ast);
 
-    Rst.initForDFS(mNsGeneration, invalidNodeInST);
+    auto ePair = mG.edges();
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        Eg.mC = Eg.mCreal;
+    }
 
-    node_list_it_t nodeBeingVisited = Rst.backIt();
-    node_list_it_t nodePrevThread   = Rst.backIt();
+    createInitialInternalStructureForSpanningTree();
+}
 
-    auto astNextItsaved = Ast.mThreadNext;
 
-    Ast.mThreadNext = Rst.backIt();
-    Rst.mThreadPrev = Ast.backIt();
+bool NetworkSimplex::areAllBZero()
+{
+    auto nPair = mG.nodes();
+    for(auto nit = nPair.first; nit != nPair.second; nit++) {
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
+        if (Ng.mB != 0) {
+            return false;
+        }
+    }
+    return true;
+}
 
-    while(nodeBeingVisited != invalidNodeInST) {
 
-        auto& Ns = dynamic_cast<NSSpanningTreeNode&>(*(*(nodeBeingVisited)));
+bool NetworkSimplex::solve()
+{
+    releaseSpanningTree();
 
-        if (Ns.hasNextChild()) {
+    mNumPivots            = 0;
+    mEdgeCursor           = mG.edges().second;
+    mStronglyFeasible     = false;
+    mArtificialEdgesFixed = false;
 
-            auto& Es = Ns.nextChild();
-            auto& As = dynamic_cast<NSSpanningTreeNode&>(Es.adjacentNode(Ns));
+    mBasisAvailable = solveFromScratch();
+    return mBasisAvailable;
+}
 
-            As.mDepth      = Ns.mDepth + 1;
-            As.mPrec       = Es.backIt();
 
-            auto& Np = dynamic_cast<NSSpanningTreeNode&>(*(*nodePrevThread));
-            Np.mThreadNext = As.backIt();
-            As.mThreadPrev = Np.backIt();
-            nodePrevThread = As.backIt();
+bool NetworkSimplex::resolve()
+{
+    if (!mBasisAvailable || mG.numNodes() <= 1) {
+        return solve();
+    }
 
-            As.initForDFS(mNsGeneration, Ns.backIt());
-            nodeBeingVisited = As.backIt();
+    releaseSpanningTree();
 
-        }
-        else {
+    mNumPivots            = 0;
+    mEdgeCursor           = mG.edges().second;
+    mArtificialNodeIt     = mG.nodes().second;
+    mStronglyFeasible     = false;
+    mArtificialEdgesFixed = false;
 
-            // No children. Leaving.
-            nodeBeingVisited = Ns.dfsParent();
+    prepareZeroBGraph();
 
-        }
+    mSpanningTreeBuilt = true;
 
+    if (!rebuildSpanningTreeFromBasis() || !findTreeX()) {
+        // The previous basis is not a feasible spanning tree any more.
+        return solve();
     }
 
-#ifdef UNIT_TESTS_DEBUG_PRINT
-    {
-        if (astNextItsaved != invalidNodeInST) {
-            auto& AstNext =dynamic_cast<NSSpanningTreeNode&>(
-                                                        *(*(astNextItsaved)));
-            auto& AgNext  =dynamic_cast<NetworkSimplexNode&>(
-                                                  AstNext.IGBackwardLinkRef());
-            cerr << "AgNext:" << AgNext.mDebugId << "\n";
+    findInitialY();
+    findInitialZ();
+    while(pivot()){;}
+    anchorY();
+
+    return true;
+}
+
+
+void NetworkSimplex::releaseSpanningTree()
+{
+    if (mSpanningTreeBuilt) {
+
+        auto nPair = mG.nodes();
+        for (auto nit = nPair.first; nit != nPair.second; nit++) {
+            auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
+            if (Ng.IGForwardLinksSize() > 0) {
+                Ng.popIGForwardLink();
+            }
         }
-        else {
-            cerr << "AgNext: (Null)\n";
+
+        auto ePair = mG.edges();
+        for (auto eit = ePair.first; eit != ePair.second; eit++) {
+            auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+            if (Eg.IGForwardLinksSize() > 0) {
+                Eg.popIGForwardLink();
+            }
         }
+
+        mSpanningTree = Graph();
+        mSpanningTreeBuilt = false;
     }
-#endif
 
-    if (nodePrevThread != invalidNodeInST) {
+    mNegativeZEdges.clear();
+    mPricingCursor = mNegativeZEdges.end();
+    mArtificialEdges.clear();
+}
 
-        auto& Ns = dynamic_cast<NSSpanningTreeNode&>(*(*nodePrevThread));
 
-        Ns.mThreadNext = astNextItsaved;
+bool NetworkSimplex::rebuildSpanningTreeFromBasis()
+{
+    size_t numBasisEdges = 0;
+    auto ePair = mG.edges();
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        if (Eg.mInBasis) {
+            numBasisEdges++;
+        }
+    }
+    if (numBasisEdges != mG.numNodes() - 1) {
+        return false;
+    }
+
+    auto nPair = mG.nodes();
+    for (auto nit = nPair.first; nit != nPair.second; nit++) {
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
+        auto np = make_unique<NSSpanningTreeNode>();
+        auto& Nst = downcast<NSSpanningTreeNode>(
+                                         mSpanningTree.addNode(std::move(np)));
+        Nst.pushIGBackwardLink(Ng.backIt());
+        Ng.pushIGForwardLink(Nst.backIt());
+    }
 
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        if (Eg.mInBasis) {
+            createSpanningTreeEdge(Eg);
+        }
     }
 
-    if (astNextItsaved != invalidNodeInST) {
+    // |V|-1 edges form a spanning tree if they connect all the nodes.
+    mNsGeneration++;
+    list<node_list_it_t> nodesToBeChecked;
+    auto& Rst = downcast<NSSpanningTreeNode>(
+                                          *(*(mSpanningTree.nodes().first)));
+    Rst.mNsGeneration = mNsGeneration;
+    nodesToBeChecked.push_back(Rst.backIt());
+    size_t numReached = 1;
 
-        auto& AstNext = dynamic_cast<NSSpanningTreeNode&>(*(*astNextItsaved));
+    while (nodesToBeChecked.size() > 0) {
 
-        AstNext.mThreadPrev = nodePrevThread;
+        auto nit = *(nodesToBeChecked.rbegin());
+        nodesToBeChecked.pop_back();
+        auto& Nst = downcast<NSSpanningTreeNode>(*(*nit));
 
+        auto iPair = Nst.incidentEdges();
+        for (auto iit = iPair.first; iit != iPair.second; iit++) {
+            auto& Est = downcast<NSSpanningTreeEdge>(*(*(*iit)));
+            auto& Ast = downcast<NSSpanningTreeNode>(
+                                                       Est.adjacentNode(Nst));
+            if (Ast.mNsGeneration < mNsGeneration) {
+                Ast.mNsGeneration = mNsGeneration;
+                nodesToBeChecked.push_front(Ast.backIt());
+                numReached++;
+            }
+        }
     }
 
-    createSpanningTreeEdge(Eenter);
-
-    Rst.mPrec  = Eenter.IGForwardLink();
+    if (numReached != mG.numNodes()) {
+        return false;
+    }
 
+    createInitialInternalStructureForSpanningTree();
 
+    return true;
 }
 
 
-void NetworkSimplex::restoreOriginalProblem() {
-
-    auto& Ag  = dynamic_cast<NetworkSimplexNode&>(*(*mArtificialNodeIt));
-    auto& Ast = dynamic_cast<NSSpanningTreeNode&>(Ag.IGForwardLinkRef());
-
-    mG.removeNode(Ag);
-    mSpanningTree.removeNode(Ast);
+bool NetworkSimplex::findTreeX()
+{
+    // Nodes in the DFS pre-order from the root.
+    // The position is kept in the utility of the spanning tree node.
+    auto& Rg  = downcast<NetworkSimplexNode>(*(*mRootIt));
+    auto& Rst = downcast<NSSpanningTreeNode>(Rg.IGForwardLinkRef());
+    vector<node_list_it_t> order;
+    order.reserve(mG.numNodes());
+    mNsGeneration++;
+    collectSpanningTreeNodes(Rst, mSpanningTree.edges().second, order);
+
+    vector<long> residuals;
+    residuals.reserve(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        auto& Ng  = downcast<NetworkSimplexNode>(*(*(order[i])));
+        auto& Nst = downcast<NSSpanningTreeNode>(Ng.IGForwardLinkRef());
+        Nst.pushUtility(i);
+        residuals.push_back(-1 * Ng.mB);
+    }
 
     auto ePair = mG.edges();
     for (auto eit = ePair.first; eit != ePair.second; eit++) {
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
-        Eg.mC = Eg.mCreal;
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        Eg.mX = 0;
     }
 
-    createInitialInternalStructureForSpanningTree();
-}
+    bool feasible = true;
+    for (size_t i = order.size() - 1; i > 0; i--) {
 
+        auto& Ng  = downcast<NetworkSimplexNode>(*(*(order[i])));
+        auto& Nst = downcast<NSSpanningTreeNode>(Ng.IGForwardLinkRef());
+        auto& Est = downcast<NSSpanningTreeEdge>(*(*(Nst.mPrec)));
+        auto& Ast = downcast<NSSpanningTreeNode>(Est.adjacentNode(Nst));
+        auto& Eg  = downcast<NetworkSimplexEdge>(Est.IGBackwardLinkRef());
+        auto  parentPos = Ast.utility();
 
-bool NetworkSimplex::areAllBZero()
-{
-    auto nPair = mG.nodes();
-    for(auto nit = nPair.first; nit != nPair.second; nit++) {
-        auto& Ng = dynamic_cast<NetworkSimplexNode&>(*(*nit));
-        if (Ng.mB != 0) {
-            return false;
+        if (Eg.incidentNodeDst().backIt() == order[i]) {
+            // Parent ====> Node: x contributes to the node positively.
+            Eg.mX = residuals[i];
+            residuals[parentPos] += Eg.mX;
+        }
+        else {
+            // Node ====> Parent: x contributes to the node negatively.
+            Eg.mX = -1 * residuals[i];
+            residuals[parentPos] -= Eg.mX;
+        }
+
+        if (Eg.mX < 0) {
+            feasible = false;
         }
     }
-    return true;
+
+    mSpanningTree.popUtilityFromNodes();
+
+    return feasible;
 }
 
 
-bool NetworkSimplex::solve()
+bool NetworkSimplex::solveFromScratch()
 {
     if (mG.numNodes() == 0) {
         return true;
     }
 
     if (mG.numNodes() == 1) {
-        auto& N = dynamic_cast<NetworkSimplexNode&>(*(*(mG.nodes().first)));
+        auto& N = downcast<NetworkSimplexNode>(*(*(mG.nodes().first)));
         N.mY = 0;
         return true;
     }
 
+    auto ePair = mG.edges();
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        Eg.mInBasis = false;
+    }
+    mSpanningTreeBuilt = true;
+
     if (mG.numEdges() == mG.numNodes() -1) {
         bool res = makeTrivialSolution();
 #ifdef UNIT_TESTS_DEBUG_PRINT
@@ -992,6 +1312,17 @@ bool NetworkSimplex::solve()
         return res;
     }
 
+    if (mInitialTree == STRONGLY_FEASIBLE_TREE) {
+        return solveFromStronglyFeasibleTree();
+    }
+
+    if (mInitialTree == FEASIBLE_TREE) {
+        prepareZeroBGraph();
+        if (findDualFeasibleY() && makeTightSpanningTree()) {
+            return solveFromFeasibleTree();
+        }
+    }
+
     if (areAllBZero()) {
         prepareZeroBGraph();
         makeInitialZeroBSpanningTree();
@@ -1004,6 +1335,7 @@ bool NetworkSimplex::solve()
         printDebug();
 #endif
         while(pivot()){;}
+        anchorY();
 
 #ifdef UNIT_TESTS_DEBUG_PRINT
         cerr << "All zero, after pivotting.\n";
@@ -1012,7 +1344,7 @@ bool NetworkSimplex::solve()
 
     }
     else {
-        makeAuxGraph();
+        makeAuxGraph(false);
 
         makeInitialAuxSpanningTree();
 
@@ -1026,25 +1358,27 @@ bool NetworkSimplex::solve()
 #endif
         while(pivot()){;}
       
-        long numArtificialBasis = 0;
         for (auto eit : mArtificialEdges) {
-            auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
-            if (Eg.mInBasis) {
-                if (Eg.mX != 0) {
-                    return false;
-                }
-                else {
-                    numArtificialBasis++;
-                }
+            auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+            if (Eg.mInBasis && Eg.mX != 0) {
+                // Remove the artificial node and edges from mG.
+                auto& Ag = downcast<NetworkSimplexNode>(
+                                                       *(*mArtificialNodeIt));
+                mG.removeNode(Ag);
+                mArtificialEdges.clear();
+                return false;
             }
         }
-        if (numArtificialBasis != 1) {
-            return false;
-        }
+
+        // Depending on the pricing, more than one artificial edge may
+        // remain in the optimum basis with zero flow.
+        replaceDegenerateArtificialBasisEdges(false);
 
         restoreOriginalProblem();
 
         mNegativeZEdges.clear();
+        mPricingCursor = mNegativeZEdges.end();
+        mEdgeCursor    = mG.edges().second;
 
         findInitialY();
         findInitialZ();
@@ -1052,14 +1386,377 @@ bool NetworkSimplex::solve()
         printDebug();
 #endif
         while(pivot()){;}
+        anchorY();
+
+    }
+
+    return true;
+}
+
 
+bool NetworkSimplex::solveFromStronglyFeasibleTree()
+{
+    mStronglyFeasible = true;
+
+    makeAuxGraph(true);
+    makeInitialStronglyFeasibleSpanningTree();
+    createInitialInternalStructureForSpanningTree();
+
+    findInitialAuxX();
+    findInitialY();
+    findInitialZ();
+    while(pivot()){;}
+
+    for (auto eit : mArtificialEdges) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        if (Eg.mX != 0) {
+            // Remove the artificial node and edges from mG.
+            auto& Ag = downcast<NetworkSimplexNode>(*(*mArtificialNodeIt));
+            mG.removeNode(Ag);
+            mArtificialEdges.clear();
+            mStronglyFeasible = false;
+            return false;
+        }
+    }
 
+    // Second phase on the real costs from the same tree. The artificial
+    // edges keep zero X as they can not enter the basis.
+    auto ePair = mG.edges();
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        Eg.mC = Eg.mArtificial ? 0 : Eg.mCreal;
     }
+    mArtificialEdgesFixed = true;
+
+    mNegativeZEdges.clear();
+    mPricingCursor = mNegativeZEdges.end();
+    mEdgeCursor    = mG.edges().second;
+
+    findInitialY();
+    findInitialZ();
+    while(pivot()){;}
+
+    mStronglyFeasible = false;
+    replaceDegenerateArtificialBasisEdges(true);
+    restoreOriginalProblem();
+    mArtificialEdgesFixed = false;
+    mEdgeCursor           = mG.edges().second;
+    anchorY();
 
     return true;
 }
 
 
+bool NetworkSimplex::findDualFeasibleY()
+{
+    // Y is the shortest distance from a virtual source that has an edge of
+    // zero cost to every node. It is found in a topological order, where
+    // the number of unprocessed in-edges is kept in the utility.
+    vector<node_list_it_t> sources;
+    auto nPair = mG.nodes();
+    for (auto nit = nPair.first; nit != nPair.second; nit++) {
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
+        Ng.mY = 0;
+        Ng.pushUtility(Ng.degreeIn());
+        if (Ng.degreeIn() == 0) {
+            sources.push_back(nit);
+        }
+    }
+
+    size_t numProcessed = 0;
+    while (!sources.empty()) {
+
+        auto& Ng = downcast<NetworkSimplexNode>(*(*(sources.back())));
+        sources.pop_back();
+        numProcessed++;
+
+        auto iPairOut = Ng.incidentEdgesOut();
+        for (auto iit = iPairOut.first; iit != iPairOut.second; iit++) {
+            auto& Eg = downcast<NetworkSimplexEdge>(*(*(*iit)));
+            auto& Ag = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
+            if (Ng.mY + Eg.mC < Ag.mY) {
+                Ag.mY = Ng.mY + Eg.mC;
+            }
+            Ag.setUtility(Ag.utility() - 1);
+            if (Ag.utility() == 0) {
+                sources.push_back(Ag.backIt());
+            }
+        }
+    }
+
+    mG.popUtilityFromNodes();
+
+    if (numProcessed == mG.numNodes()) {
+        return true;
+    }
+
+    // The network has a directed cycle. Y = 0 is dual feasible if all the
+    // costs are non-negative.
+    auto ePair = mG.edges();
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        if (Eg.mC < 0) {
+            return false;
+        }
+    }
+    for (auto nit = nPair.first; nit != nPair.second; nit++) {
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
+        Ng.mY = 0;
+    }
+    return true;
+}
+
+
+bool NetworkSimplex::makeTightSpanningTree()
+{
+    // The nodes not in the tree yet have the actual Y = mY + offset, and
+    // they are shifted together by changing offset. The tree nodes have
+    // their actual Y in mY. The utility is 1 for the tree nodes.
+    //
+    // The candidate edges between the tree and the rest are kept in two
+    // heaps with the keys independent of offset, one for the edges from
+    // the tree, whose Z is (key - offset), and the other for the edges 
+    // to the tree, whose Z is (key + offset). Ties are broken by the 
+    // perturbation, which is also the index into edges.
+    using heapEntry = pair<long, long>;
+    using heap_t    = priority_queue<heapEntry,
+                                     vector<heapEntry>,
+                                     greater<heapEntry> >;
+    heap_t heapFromTree;
+    heap_t heapToTree;
+    long   offset = 0;
+
+    vector<edge_list_it_t> edges;
+    edges.reserve(mG.numEdges());
+    auto ePair = mG.edges();
+    for (auto eit = ePair.first; eit != ePair.second; eit++) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        Eg.mInBasis = false;
+        edges.push_back(eit);
+    }
+
+    mG.pushDefaultUtilityToNodes();
+
+    auto addToTree = [&](NetworkSimplexNode& Ng) {
+
+        Ng.mY += offset;
+        Ng.setUtility(1);
+
+        auto iPairOut = Ng.incidentEdgesOut();
+        for (auto iit = iPairOut.first; iit != iPairOut.second; iit++) {
+            auto& Eg = downcast<NetworkSimplexEdge>(*(*(*iit)));
+            auto& Ag = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
+            if (Ag.utility() == 0) {
+                heapFromTree.push(heapEntry(Eg.mC - Ag.mY + Ng.mY,
+                                            Eg.mCperturbation));
+            }
+        }
+
+        auto iPairIn = Ng.incidentEdgesIn();
+        for (auto iit = iPairIn.first; iit != iPairIn.second; iit++) {
+            auto& Eg = downcast<NetworkSimplexEdge>(*(*(*iit)));
+            auto& Ag = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+            if (Ag.utility() == 0) {
+                heapToTree.push(heapEntry(Eg.mC - Ng.mY + Ag.mY,
+                                          Eg.mCperturbation));
+            }
+        }
+    };
+
+    // Removes the entries whose both incident nodes are in the tree.
+    auto discardInternal = [&](heap_t& h, bool fromTree) {
+        while (!h.empty()) {
+            auto& Eg = downcast<NetworkSimplexEdge>(
+                                                *(*(edges[h.top().second])));
+            auto& Ag = downcast<NetworkSimplexNode>(
+                            fromTree?Eg.incidentNodeDst():Eg.incidentNodeSrc());
+            if (Ag.utility() == 0) {
+                break;
+            }
+            h.pop();
+        }
+    };
+
+    addToTree(downcast<NetworkSimplexNode>(*(*(mG.nodes().first))));
+    size_t numTreeNodes = 1;
+
+    while (numTreeNodes < mG.numNodes()) {
+
+        discardInternal(heapFromTree, true);
+        discardInternal(heapToTree,   false);
+
+        if (heapFromTree.empty() && heapToTree.empty()) {
+            break;
+        }
+
+        bool fromTree;
+        if (heapToTree.empty()) {
+            fromTree = true;
+        }
+        else if (heapFromTree.empty()) {
+            fromTree = false;
+        }
+        else {
+            fromTree = heapEntry(heapFromTree.top().first - offset,
+                                 heapFromTree.top().second) <
+                       heapEntry(heapToTree.top().first + offset,
+                                 heapToTree.top().second);
+        }
+
+        // Shift the nodes not in the tree so that the edge gets tight.
+        heapEntry top;
+        if (fromTree) {
+            top    = heapFromTree.top();
+            heapFromTree.pop();
+            offset = top.first;
+        }
+        else {
+            top    = heapToTree.top();
+            heapToTree.pop();
+            offset = -1 * top.first;
+        }
+
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*(edges[top.second])));
+        Eg.mInBasis = true;
+        addToTree(downcast<NetworkSimplexNode>(
+                          fromTree?Eg.incidentNodeDst():Eg.incidentNodeSrc()));
+        numTreeNodes++;
+    }
+
+    mG.popUtilityFromNodes();
+
+    if (numTreeNodes < mG.numNodes()) {
+        for (auto eit : edges) {
+            auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+            Eg.mInBasis = false;
+        }
+        return false;
+    }
+    return true;
+}
+
+
+bool NetworkSimplex::solveFromFeasibleTree()
+{
+    mArtificialNodeIt = mG.nodes().second;
+
+    if (!rebuildSpanningTreeFromBasis()) {
+        return false;
+    }
+
+    // The tree is dual feasible but not necessarily primal feasible.
+    // Negative X found here are what the dual pivots below remove, and the
+    // result of findTreeX() is not used.
+    findTreeX();
+    findInitialY();
+    findInitialZ();
+
+    mDegenerateDualPivots = 0;
+    bool feasible = true;
+    while(dualPivot(feasible)){;}
+    if (!feasible) {
+        return false;
+    }
+
+    // All Z are non-negative, and this is normally a no-op.
+    while(pivot()){;}
+    anchorY();
+
+    return true;
+}
+
+
+bool NetworkSimplex::dualPivot(bool& feasible)
+{
+    auto Eleave = findDualLeavingEdge();
+    if (Eleave == nullptr) {
+        return false;
+    }
+
+    findSubtree(*Eleave, mSideNodes);
+    findCutSet(mSideNodes, mCut);
+
+    auto Eenter = findDualEnteringEdge(*Eleave, mCut);
+    if (Eenter == nullptr) {
+        // The flow on Eleave can not be made non-negative.
+        feasible = false;
+        return false;
+    }
+    mNumPivots++;
+    if (Eenter->mZ == 0) {
+        mDegenerateDualPivots++;
+    }
+    else {
+        mDegenerateDualPivots = 0;
+    }
+
+    findCycle(*Eenter, mCycle);
+
+    updateX(mCycle, *Eenter, *Eleave);
+    updateY(mSideNodes, *Eenter);
+    updateZ(mCut);
+    updateSpanningTree(*Eenter, *Eleave);
+
+    return true;
+}
+
+
+NetworkSimplexEdge* NetworkSimplex::findDualLeavingEdge()
+{
+    auto ePair = mG.edges();
+    if (mDegenerateDualPivots >= kMaxDegenerateDualPivots) {
+        // Bland's rule. The perturbation is the position in the edges.
+        for (auto eit = ePair.first; eit != ePair.second; eit++) {
+            auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+            if (Eg.mInBasis && Eg.mX < 0) {
+                return &Eg;
+            }
+        }
+        return nullptr;
+    }
+    for (size_t i = 0; i < mG.numEdges(); i++) {
+        if (mEdgeCursor == ePair.second) {
+            mEdgeCursor = ePair.first;
+        }
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*mEdgeCursor));
+        mEdgeCursor++;
+        if (Eg.mInBasis && Eg.mX < 0) {
+            return &Eg;
+        }
+    }
+    return nullptr;
+}
+
+
+NetworkSimplexEdge* NetworkSimplex::findDualEnteringEdge(
+    NetworkSimplexEdge&     Eleave,
+    vector<edge_list_it_t>& cut
+) {
+    auto& Nld  = downcast<NetworkSimplexNode>(Eleave.incidentNodeDst());
+    auto& Nstld= downcast<NSSpanningTreeNode>(Nld.IGForwardLinkRef());
+    bool leaveIntoSubtree = isInSubtree(Nstld);
+
+    NetworkSimplexEdge* Ebest = nullptr;
+    for (auto eit : cut) {
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
+        if (Eg.mInBasis) {
+            continue;
+        }
+        auto& Nd  = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
+        auto& Nstd= downcast<NSSpanningTreeNode>(Nd.IGForwardLinkRef());
+        bool intoSubtree = isInSubtree(Nstd);
+        if (intoSubtree == leaveIntoSubtree) {
+            continue;
+        }
+        if ( Ebest == nullptr || Eg.mZ < Ebest->mZ ||
+            (Eg.mZ == Ebest->mZ && Eg.mCperturbation<Ebest->mCperturbation)) {
+            Ebest = &Eg;
+        }
+    }
+    return Ebest;
+}
+
+
 bool NetworkSimplex::checkValidity() {
 
     Undirected::ConnectedDecomposer cd;
@@ -1073,7 +1770,7 @@ bool NetworkSimplex::checkValidity() {
     long totalB = 0;
     auto nPair = mG.nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++ ) {
-        auto& N = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+        auto& N = downcast<NetworkSimplexNode>(*(*nit));
         totalB += N.mB;
     }
     if (totalB != 0) {
@@ -1082,7 +1779,7 @@ bool NetworkSimplex::checkValidity() {
 
 //    auto ePair = mG.edges();
 //    for (auto eit = ePair.first; eit != ePair.second; eit++ ) {
-//        auto& E = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+//        auto& E = downcast<NetworkSimplexEdge>(*(*eit));
 //        if (E.mCreal < 0) {
 //            return false;
 //        }
@@ -1094,114 +1791,92 @@ bool NetworkSimplex::checkValidity() {
 
 bool NetworkSimplex::makeTrivialSolution() {
 
-    // Find X values with simultaneous equations solver.
-    TotUnimodSimulEqsSolver ts(mG.numNodes()-1);
-
+    // The edges form a spanning tree, and the flow conservation equations
+    // have exactly one solution. It is found by a DFS from the root that
+    // determines Y in pre-order, followed by the leaf elimination of X in
+    // the reverse order, i.e., the flow on the parent edge of a node is
+    // determined by its supply/demand and the flows on its child edges.
     auto nPair = mG.nodes();
-    size_t index = 0;
-    for (auto nit = nPair.first; nit != nPair.second; nit++) {
-        auto& Ng = dynamic_cast<NetworkSimplexNode&>(*(*nit));
-
-
-        if (nit != nPair.first) {      
-            ts.setRHS(index, -1 * Ng.mB);
-            Ng.pushUtility(index++);
-        }
-        else {
-            Ng.pushUtility(-1);// Dummy value
-        }
-    }
-
     auto ePair = mG.edges();
-    index = 0;
-    for (auto eit = ePair.first; eit != ePair.second; eit++) {
-
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
-        auto& Ns = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-        if (Ns.backIt() != nPair.first) {
-            ts.setCoefficient(Ns.utility(), index, -1);
-        }
-
-        auto& Nd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
-        if (Nd.backIt() != nPair.first) {
-            ts.setCoefficient(Nd.utility(), index, 1);
-        }
-        Eg.pushUtility(index++);
 
-    }
-
-    ts.solve();
-
-    for (auto eit = ePair.first; eit != ePair.second; eit++) {
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
-        Eg.mX = ts.getSolution(Eg.utility());
-        if (Eg.mX < 0) {
-            return false;
-        }
-    }
-
-    mG.popUtilityFromNodes();
-    mG.popUtilityFromEdges();
-
-    // Find Y values with DFS
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
-        auto& Ng = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
         auto np = make_unique<NSSpanningTreeNode>();
-        auto& Nst = dynamic_cast<NSSpanningTreeNode&>(
+        auto& Nst = downcast<NSSpanningTreeNode>(
                                          mSpanningTree.addNode(std::move(np)));
         Nst.pushIGBackwardLink(Ng.backIt());
         Ng.pushIGForwardLink(Nst.backIt());
+        Nst.pushUtility(0);
 
         // Following fields are not used.
-        Nst.mThreadNext = mSpanningTree.nodes().second;
-        Nst.mThreadPrev = mSpanningTree.nodes().second;
         Nst.mPrec       = mSpanningTree.edges().second;
-        Nst.mDepth      = 0;
+        Nst.mSize       = 1;
 
     }
 
     for (auto eit = ePair.first; eit != ePair.second; eit++) {
-        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*eit));
         createSpanningTreeEdge(Eg);
     }
 
     auto invalidNodeInST = mSpanningTree.nodes().second;
 
-    // From the root, create depth, prec, and thread structures.
-    auto& Rg = dynamic_cast<NetworkSimplexNode&>(*(*(mG.nodes().first)));
-    auto& Rs = dynamic_cast<NSSpanningTreeNode&>(Rg.IGForwardLinkRef());
+    // Nodes in the DFS pre-order, their parent edges and the positions of
+    // their parents in the order. The position is kept in the utility of
+    // the spanning tree node.
+    vector<node_list_it_t> order;
+    vector<edge_list_it_t> parentEdges;
+    vector<size_t>         parentPositions;
+    order.reserve(mG.numNodes());
+    parentEdges.reserve(mG.numNodes());
+    parentPositions.reserve(mG.numNodes());
+
+    auto& Rg = downcast<NetworkSimplexNode>(*(*(nPair.first)));
+    auto& Rs = downcast<NSSpanningTreeNode>(Rg.IGForwardLinkRef());
 
     mNsGeneration++;
 
     Rs.initForDFS(mNsGeneration, invalidNodeInST);
     Rg.mY = 0;
+    order.push_back(Rg.backIt());
+    parentEdges.push_back(ePair.second);
+    parentPositions.push_back(0);
 
     auto nodeBeingVisited = Rs.backIt();
+    bool spanning = true;
 
     while(nodeBeingVisited != invalidNodeInST) {
 
-        auto& Ns = dynamic_cast<NSSpanningTreeNode&>(*(*(nodeBeingVisited)));
-        auto& Ng = dynamic_cast<NetworkSimplexNode&>(Ns.IGBackwardLinkRef());
+        auto& Ns = downcast<NSSpanningTreeNode>(*(*(nodeBeingVisited)));
+        auto& Ng = downcast<NetworkSimplexNode>(Ns.IGBackwardLinkRef());
                                                       
         if (Ns.hasNextChild()) {
 
             auto& Es = Ns.nextChild();
-            auto& Eg = dynamic_cast<NetworkSimplexEdge&>(
+            auto& Eg = downcast<NetworkSimplexEdge>(
                                                        Es.IGBackwardLinkRef());
-            auto& As = dynamic_cast<NSSpanningTreeNode&>(Es.adjacentNode(Ns));
+            auto& As = downcast<NSSpanningTreeNode>(Es.adjacentNode(Ns));
+            auto& Ag = downcast<NetworkSimplexNode>(
+                                                       As.IGBackwardLinkRef());
+            if (As.mNsGeneration == mNsGeneration) {
+                // Reached a visited node again. The edges form a cycle.
+                spanning = false;
+                break;
+            }
                                                           
             if (Eg.incidentNodeSrc().backIt() == Ng.backIt()) {
-                // Discovered(Ng) ====> New (Nd)
-                auto& Nd = dynamic_cast<NetworkSimplexNode&>(
-                                                         Eg.incidentNodeDst());
-                Nd.mY = Ng.mY + Eg.mCreal;
+                // Discovered(Ng) ====> New (Ag)
+                Ag.mY = Ng.mY + Eg.mCreal;
             }
             else {
-                // New (Ns) ====> Discovered(Ng)
-                auto& Ns = dynamic_cast<NetworkSimplexNode&>(
-                                                         Eg.incidentNodeSrc());
-                Ns.mY = Ng.mY - Eg.mCreal;
+                // New (Ag) ====> Discovered(Ng)
+                Ag.mY = Ng.mY - Eg.mCreal;
             }
+            As.setUtility(order.size());
+            order.push_back(Ag.backIt());
+            parentEdges.push_back(Eg.backIt());
+            parentPositions.push_back(Ns.utility());
+
             As.initForDFS(mNsGeneration, Ns.backIt());
             nodeBeingVisited = As.backIt();
         }
@@ -1211,30 +1886,69 @@ bool NetworkSimplex::makeTrivialSolution() {
         }
 
     }
-    return true;
+
+    mSpanningTree.popUtilityFromNodes();
+
+    if (!spanning || order.size() != mG.numNodes()) {
+        // The edges do not span the nodes. There is a cycle and the
+        // equations are singular.
+        return false;
+    }
+
+    // residuals[i]: -b of the i-th node minus the flow contributions of
+    // the child edges determined so far.
+    vector<long> residuals;
+    residuals.reserve(order.size());
+    for (auto nit : order) {
+        auto& Ng = downcast<NetworkSimplexNode>(*(*nit));
+        residuals.push_back(-1 * Ng.mB);
+    }
+
+    bool feasible = true;
+    for (size_t i = order.size() - 1; i > 0; i--) {
+
+        auto& Eg = downcast<NetworkSimplexEdge>(*(*(parentEdges[i])));
+
+        if (Eg.incidentNodeDst().backIt() == order[i]) {
+            // Parent ====> Node: x contributes to the node positively.
+            Eg.mX = residuals[i];
+            residuals[parentPositions[i]] += Eg.mX;
+        }
+        else {
+            // Node ====> Parent: x contributes to the node negatively.
+            Eg.mX = -1 * residuals[i];
+            residuals[parentPositions[i]] -= Eg.mX;
+        }
+
+        if (Eg.mX < 0) {
+            feasible = false;
+        }
+    }
+
+    return feasible;
 }
 
 #ifdef UNIT_TESTS
 void NetworkSimplex::printDebug()
 {
-    cerr << "ID\t Type\tB\tY\tGen\tDepth\tPrec\tPrev\tNext\n";
+    cerr << "ID\t Type\tB\tY\tGen\tSize\tPrec\n";
     for (auto nit = mG.nodes().first; nit != mG.nodes().second; nit++) {
-        auto& N = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+        auto& N = downcast<NetworkSimplexNode>(*(*nit));
         printDebugNode(N);
     }
     cerr << "\n\n";
     cerr << "(ID,ID)\tmC\tmCreal\tmCpert\tmX\tmZ\tType\n";
     for (auto eit = mG.edges().first; eit != mG.edges().second; eit++) {
-        auto& E = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+        auto& E = downcast<NetworkSimplexEdge>(*(*eit));
         printDebugEdge(E);
     }
     cerr << "\n\n";
 
     cerr << "NegativeZEdges: ";
     for (auto eit : mNegativeZEdges) {
-        auto& Eg  = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
-        auto& Ngs = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-        auto& Ngd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
+        auto& Eg  = downcast<NetworkSimplexEdge>(*(*eit));
+        auto& Ngs = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+        auto& Ngd = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
         cerr << "(" << Ngs.mDebugId << "," << Ngd.mDebugId << ") ";
     }
     cerr << "\n";
@@ -1243,8 +1957,8 @@ void NetworkSimplex::printDebug()
 
 void NetworkSimplex::printDebugEdge(NetworkSimplexEdge& Eg)
 {
-    auto& Ngs = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
-    auto& Ngd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
+    auto& Ngs = downcast<NetworkSimplexNode>(Eg.incidentNodeSrc());
+    auto& Ngd = downcast<NetworkSimplexNode>(Eg.incidentNodeDst());
 
     cerr << "(" << Ngs.mDebugId << "," << Ngd.mDebugId << ")\t";
     cerr << Eg.mC << "\t";
@@ -1266,7 +1980,7 @@ void NetworkSimplex::printDebugNode(NetworkSimplexNode& Ng)
 {
     if (Ng.IGForwardLinksSize()==1) {
 
-        auto& Nst = dynamic_cast<NSSpanningTreeNode&>(Ng.IGForwardLinkRef());
+        auto& Nst = downcast<NSSpanningTreeNode>(Ng.IGForwardLinkRef());
         cerr << Ng.mDebugId << "\t";
         if (mRootIt == Ng.backIt()) {
             cerr << "R";
@@ -1278,35 +1992,14 @@ void NetworkSimplex::printDebugNode(NetworkSimplexNode& Ng)
         cerr << Ng.mB << "\t";
         cerr << Ng.mY << "\t";
         cerr << Nst.mNsGeneration << "\t";
-        cerr << Nst.mDepth << "\t";
+        cerr << Nst.mSize << "\t";
         if (Nst.mPrec != mSpanningTree.edges().second){
-            auto& Est = dynamic_cast<NSSpanningTreeEdge&>(*(*(Nst.mPrec)));
-            auto& Ast = dynamic_cast<NSSpanningTreeNode&>(
+            auto& Est = downcast<NSSpanningTreeEdge>(*(*(Nst.mPrec)));
+            auto& Ast = downcast<NSSpanningTreeNode>(
                                                        Est.adjacentNode(Nst));
-            auto& Ag  = dynamic_cast<NetworkSimplexNode&>(
+            auto& Ag  = downcast<NetworkSimplexNode>(
                                                       Ast.IGBackwardLinkRef());
-            cerr << Ag.mDebugId << "\t";
-        }
-        else {
-            cerr << "N/A\t";
-        }
-        if (Nst.mThreadPrev != mSpanningTree.nodes().second) {
-            auto& Pst = dynamic_cast<NSSpanningTreeNode&>(
-                                                        *(*(Nst.mThreadPrev)));
-            auto& Pg  = dynamic_cast<NetworkSimplexNode&>(
-                                                      Pst.IGBackwardLinkRef());
-            cerr << Pg.mDebugId << "\t";
-        }
-        else {
-            cerr << "N/A\t";
-        }
-
-        if (Nst.mThreadNext != mSpanningTree.nodes().second) {
-            auto& Pst = dynamic_cast<NSSpanningTreeNode&>(
-                                                        *(*(Nst.mThreadNext)));
-            auto& Pg  = dynamic_cast<NetworkSimplexNode&>(
-                                                      Pst.IGBackwardLinkRef());
-            cerr << Pg.mDebugId << "\n";
+            cerr << Ag.mDebugId << "\n";
         }
         else {
             cerr << "N/A\n";
@@ -1326,8 +2019,6 @@ void NetworkSimplex::printDebugNode(NetworkSimplexNode& Ng)
         cerr << Ng.mY << "\t";
         cerr << "N/A\t";
         cerr << "N/A\t";
-        cerr << "N/A\t";
-        cerr << "N/A\t";
         cerr << "N/A\n";
     }
 }
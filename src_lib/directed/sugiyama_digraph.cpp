@@ -18,9 +18,9 @@ void SugiyamaDiGraph::generateFromAcyclicOrdering(
 
     for(auto nit : ao) {
 
-        auto& Norg = dynamic_cast<DiNode&>(*(*nit));
+        auto& Norg = downcast<DiNode>(*(*nit));
         auto np    = make_unique<SugiyamaDiNode>();
-        auto& Nsug = dynamic_cast<SugiyamaDiNode&>(addNode(std::move(np)));
+        auto& Nsug = downcast<SugiyamaDiNode>(addNode(std::move(np)));
         // Temporarily assign the acyclic number to rank.
         Nsug.mRank = index;
 
@@ -32,17 +32,17 @@ void SugiyamaDiGraph::generateFromAcyclicOrdering(
 
     for (auto eit = mG.edges().first; eit != mG.edges().second; eit++) {
 
-        auto& Eorg    = dynamic_cast<DiEdge&>(*(*(eit)));
-        auto& NorgSrc = dynamic_cast<DiNode&>(Eorg.incidentNodeSrc());
-        auto& NorgDst = dynamic_cast<DiNode&>(Eorg.incidentNodeDst());
-        auto& NsugSrc = dynamic_cast<SugiyamaDiNode&>(
+        auto& Eorg    = downcast<DiEdge>(*(*(eit)));
+        auto& NorgSrc = downcast<DiNode>(Eorg.incidentNodeSrc());
+        auto& NorgDst = downcast<DiNode>(Eorg.incidentNodeDst());
+        auto& NsugSrc = downcast<SugiyamaDiNode>(
                                                    NorgSrc.IGForwardLinkRef());
-        auto& NsugDst = dynamic_cast<SugiyamaDiNode&>(
+        auto& NsugDst = downcast<SugiyamaDiNode>(
                                                    NorgDst.IGForwardLinkRef());
         auto  ep = make_unique<SugiyamaDiEdge>();
 
         bool flipped = NsugSrc.mRank > NsugDst.mRank;
-        auto& Esug = dynamic_cast<SugiyamaDiEdge&>(addEdge(std::move(ep), 
+        auto& Esug = downcast<SugiyamaDiEdge>(addEdge(std::move(ep), 
                              flipped?NsugDst:NsugSrc,flipped?NsugSrc:NsugDst));
         Esug.mFlipped = flipped;
 
@@ -61,7 +61,7 @@ SugiyamaDiGraph::rankNodesAndAddVirtualNodes(
     long index = 0;
     for (auto& rank : ranks) {    
         for (auto nit : rank) {
-            auto& N = dynamic_cast<SugiyamaDiNode&>(*(*nit));
+            auto& N = downcast<SugiyamaDiNode>(*(*nit));
             N.mRank = index;
         }
         index++;
@@ -74,13 +74,13 @@ SugiyamaDiGraph::rankNodesAndAddVirtualNodes(
 //cerr << "rankNodesAndAddVirtualNodes() 2\n";
     for (auto eit : edgesSplit) {
 
-        auto& E = dynamic_cast<SugiyamaDiEdge&>(*(*eit));
-        auto& Nsrc = dynamic_cast<SugiyamaDiNode&>(E.incidentNodeSrc());
-        auto& Ndst = dynamic_cast<SugiyamaDiNode&>(E.incidentNodeDst());
+        auto& E = downcast<SugiyamaDiEdge>(*(*eit));
+        auto& Nsrc = downcast<SugiyamaDiNode>(E.incidentNodeSrc());
+        auto& Ndst = downcast<SugiyamaDiNode>(E.incidentNodeDst());
         long length = Ndst.mRank - Nsrc.mRank;
                                     
         if (length > 1) {
-            auto& Eorg = dynamic_cast<DiEdge&>(E.IGBackwardLinkRef());
+            auto& Eorg = downcast<DiEdge>(E.IGBackwardLinkRef());
 
             long rank   = Nsrc.mRank + 1;
 
@@ -89,16 +89,16 @@ SugiyamaDiGraph::rankNodesAndAddVirtualNodes(
 
             for (long i = 0; i < length -1 ; i++) {
 
-                auto& Vsrc = dynamic_cast<SugiyamaDiNode&>(*(*prevNit));
+                auto& Vsrc = downcast<SugiyamaDiNode>(*(*prevNit));
                 auto  np   = make_unique<SugiyamaDiNode>();
-                auto& Vdst = dynamic_cast<SugiyamaDiNode&>(
+                auto& Vdst = downcast<SugiyamaDiNode>(
                                                        addNode(std::move(np)));
                 Vdst.mRank    = rank;
                 Vdst.mVirtual = true;
                 Vdst.pushIGBackwardLink(mG.nodes().second);
 
                 auto  ep   = make_unique<SugiyamaDiEdge>();
-                auto& Enew = dynamic_cast<SugiyamaDiEdge&>(addEdge(
+                auto& Enew = downcast<SugiyamaDiEdge>(addEdge(
                                                    std::move(ep), Vsrc, Vdst));
                 Enew.pushIGBackwardLink(Eorg.backIt());
                 if (i == 0 && !(E.mFlipped)) {
@@ -106,7 +106,7 @@ SugiyamaDiGraph::rankNodesAndAddVirtualNodes(
                 }
                 Enew.mFlipped = E.mFlipped;
                 if (i!=0) {
-                    auto& Eprev = dynamic_cast<SugiyamaDiEdge&>(*(*prevEit));
+                    auto& Eprev = downcast<SugiyamaDiEdge>(*(*prevEit));
                                                                   
                     Eprev.setChainNdst(Enew.backIt());
                     Enew.setChainNsrc(prevEit);
@@ -117,16 +117,16 @@ SugiyamaDiGraph::rankNodesAndAddVirtualNodes(
                 rank++;
             }
 
-            auto& Vsrc = dynamic_cast<SugiyamaDiNode&>(*(*prevNit));
+            auto& Vsrc = downcast<SugiyamaDiNode>(*(*prevNit));
             auto  ep   = make_unique<SugiyamaDiEdge>();
-            auto& Enew = dynamic_cast<SugiyamaDiEdge&>(addEdge(
+            auto& Enew = downcast<SugiyamaDiEdge>(addEdge(
                                                    std::move(ep), Vsrc, Ndst));
             Enew.pushIGBackwardLink(Eorg.backIt());
             if (E.mFlipped) {
                 Eorg.setIGForwardLink(Enew.backIt());
             }
             Enew.mFlipped = E.mFlipped;
-            auto& Eprev = dynamic_cast<SugiyamaDiEdge&>(*(*prevEit));
+            auto& Eprev = downcast<SugiyamaDiEdge>(*(*prevEit));
             Eprev.setChainNdst(Enew.backIt());
             Enew.setChainNsrc(prevEit);
 
@@ -144,7 +144,7 @@ SugiyamaDiGraph::rankNodesAndAddVirtualNodes(
 //cerr << "rankNodesAndAddVirtualNodes() 4\n";
     for (auto nit = nodes().first; nit != nodes().second; nit++) {
 //cerr << "rankNodesAndAddVirtualNodes() 4.1\n";
-        auto& N = dynamic_cast<SugiyamaDiNode&>(*(*nit));
+        auto& N = downcast<SugiyamaDiNode>(*(*nit));
 //cerr << "rankNodesAndAddVirtualNodes() 4.2\n";
         newRanks[N.mRank].push_back(nit);
 //cerr << "rankNodesAndAddVirtualNodes() 4.3\n";
@@ -161,14 +161,14 @@ void SugiyamaDiGraph::setPositionsForEachRank(
     for (auto& rank : ranks) {
         long index = 0;
         for (auto nit : rank) {
-            auto& N = dynamic_cast<SugiyamaDiNode&>(*(*nit));
+            auto& N = downcast<SugiyamaDiNode>(*(*nit));
             N.mPos = index++;
         }
     }
 
     for (auto nit = nodes().first; nit != nodes().second; nit++) {
 
-        auto& N = dynamic_cast<SugiyamaDiNode&>(*(*nit));
+        auto& N = downcast<SugiyamaDiNode>(*(*nit));
 
         vector<edge_list_it_t> incidenceIn(N.incidentEdgesIn().first,
                                            N.incidentEdgesIn().second);
@@ -189,20 +189,20 @@ void SugiyamaDiGraph::setPositionsForEachRank(
 
 bool SugiyamaDiGraph::nodeCompDst(edge_list_it_t it1, edge_list_it_t it2)
 {
-    auto& E1 = dynamic_cast<SugiyamaDiEdge&>(*(*it1));
-    auto& E2 = dynamic_cast<SugiyamaDiEdge&>(*(*it2));
-    auto& N1 = dynamic_cast<SugiyamaDiNode&>(E1.incidentNodeDst());
-    auto& N2 = dynamic_cast<SugiyamaDiNode&>(E2.incidentNodeDst());
+    auto& E1 = downcast<SugiyamaDiEdge>(*(*it1));
+    auto& E2 = downcast<SugiyamaDiEdge>(*(*it2));
+    auto& N1 = downcast<SugiyamaDiNode>(E1.incidentNodeDst());
+    auto& N2 = downcast<SugiyamaDiNode>(E2.incidentNodeDst());
     return N1.mPos > N2.mPos;
 }
 
 
 bool SugiyamaDiGraph::nodeCompSrc(edge_list_it_t it1, edge_list_it_t it2)
 {
-    auto& E1 = dynamic_cast<SugiyamaDiEdge&>(*(*it1));
-    auto& E2 = dynamic_cast<SugiyamaDiEdge&>(*(*it2));
-    auto& N1 = dynamic_cast<SugiyamaDiNode&>(E1.incidentNodeSrc());
-    auto& N2 = dynamic_cast<SugiyamaDiNode&>(E2.incidentNodeSrc());
+    auto& E1 = downcast<SugiyamaDiEdge>(*(*it1));
+    auto& E2 = downcast<SugiyamaDiEdge>(*(*it2));
+    auto& N1 = downcast<SugiyamaDiNode>(E1.incidentNodeSrc());
+    auto& N2 = downcast<SugiyamaDiNode>(E2.incidentNodeSrc());
     return N1.mPos < N2.mPos;
 }
 
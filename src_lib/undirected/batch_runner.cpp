@@ -0,0 +1,224 @@
+#include "undirected/batch_runner.hpp"
+#include "undirected/parallel_for.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <limits>
+
+/**
+ * @file undirected/batch_runner.cpp
+ *
+ * @brief implementation of BatchRunner.
+ */
+
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+const string BatchRunner::GRAPH_END = "GRAPH_END";
+
+
+bool BatchRunner::readSpec(istream& is, string& spec)
+{
+    spec.clear();
+    bool nonBlank = false;
+    string line;
+    while (getline(is, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+        if (line == GRAPH_END) {
+            return true;
+        }
+        if (line.find_first_not_of(" \t") != string::npos) {
+            nonBlank = true;
+        }
+        spec += line;
+        spec += '\n';
+    }
+    // The terminator of the last specification can be omitted.
+    return nonBlank;
+}
+
+
+size_t BatchRunner::run(istream& is, ostream& os, const string& streamName)
+{
+    // The number of the specifications is not known in advance.
+    size_t numThreads = numWorkerThreads(
+                               mNumThreads, numeric_limits<size_t>::max());
+
+    size_t maxInFlight = mMaxInFlight;
+    if (maxInFlight == 0) {
+        maxInFlight = kDefaultInFlightPerThread * numThreads;
+    }
+
+    // mutexIn guards the input stream and nextRead.
+    // mutexOut guards the rest.
+    mutex              mutexIn;
+    mutex              mutexOut;
+    condition_variable slotAvailable;
+    size_t             nextRead    = 0;
+    size_t             numReserved = 0;
+    size_t             nextWrite   = 0;
+    size_t             numFailed   = 0;
+    bool               endOfInput  = false;
+    map<size_t, string> completed;
+
+    auto worker = [&]() {
+
+        while (true) {
+
+            {
+                unique_lock<mutex> lock(mutexOut);
+                slotAvailable.wait(lock, [&]{
+                    return endOfInput ||
+                           numReserved - nextWrite < maxInFlight;
+                });
+                if (endOfInput) {
+                    return;
+                }
+                numReserved++;
+            }
+
+            string spec;
+            size_t index;
+            {
+                lock_guard<mutex> lock(mutexIn);
+                if (!readSpec(is, spec)) {
+                    lock_guard<mutex> lockOut(mutexOut);
+                    numReserved--;
+                    endOfInput = true;
+                    slotAvailable.notify_all();
+                    return;
+                }
+                index = nextRead++;
+            }
+
+            string        name = streamName + ":" + to_string(index + 1);
+            ostringstream result;
+            bool          failed = false;
+            try {
+                istringstream specStream(spec);
+                mProcessor(specStream, result, name.c_str());
+            }
+            catch (const exception& e) {
+                failed = true;
+                result.str("");
+                result << "# ERROR: " << e.what() << "\n";
+                cerr << name << ": " << e.what() << "\n";
+            }
+            catch (...) {
+                failed = true;
+                result.str("");
+                result << "# ERROR: unknown\n";
+                cerr << name << ": unknown error\n";
+            }
+
+            {
+                lock_guard<mutex> lock(mutexOut);
+                if (failed) {
+                    numFailed++;
+                }
+                completed[index] = result.str();
+                bool written = false;
+                for (auto cit = completed.find(nextWrite);
+                     cit != completed.end();
+                     cit = completed.find(nextWrite)) {
+                    auto& out = cit->second;
+                    os << out;
+                    if (!out.empty() && out[out.size() - 1] != '\n') {
+                        os << "\n";
+                    }
+                    os << GRAPH_END << "\n";
+                    completed.erase(cit);
+                    nextWrite++;
+                    written = true;
+                }
+                if (written) {
+                    os.flush();
+                    slotAvailable.notify_all();
+                }
+            }
+        }
+    };
+
+    // If a worker fails, the others are stopped at their next
+    // specification, and the exception is rethrown after all of them have
+    // been joined.
+    parallelFor(numThreads, [&](size_t) {
+        try {
+            worker();
+        }
+        catch (...) {
+            lock_guard<mutex> lock(mutexOut);
+            endOfInput = true;
+            slotAvailable.notify_all();
+            throw;
+        }
+    });
+    return numFailed;
+}
+
+
+int BatchRunner::runFromCommandLine(
+    int         argc,
+    char*       argv[],
+    processor_t processor
+) {
+    size_t numThreads = 0;
+    int    i          = 0;
+    if (i + 1 < argc && string(argv[i]) == "-j") {
+        try {
+            numThreads = stoul(argv[i + 1]);
+        }
+        catch (const exception&) {
+            return 1;
+        }
+        i += 2;
+    }
+    if (argc - i > 1) {
+        return 1;
+    }
+
+    BatchRunner runner(processor);
+    runner.setNumThreads(numThreads);
+
+    size_t numFailed;
+    if (argc - i == 1) {
+        ifstream is(argv[i]);
+        if (!is) {
+            cerr << "Cannot open: " << argv[i] << "\n";
+            return 1;
+        }
+        numFailed = runner.run(is, cout, argv[i]);
+    }
+    else {
+        numFailed = runner.run(cin, cout, "<stdin>");
+    }
+    return (numFailed > 0) ? 2 : 0;
+}
+
+
+void BatchRunner::printUsage(ostream& os, const char* toolName)
+{
+    os << "    Batch mode : " << toolName
+       << " -b [-j num_threads] [input_file]\n";
+    os << "        Reads the input specifications separated by '"
+       << GRAPH_END << "' lines\n";
+    os << "        from input_file or stdin, processes them in parallel, and\n";
+    os << "        writes the outputs separated by '" << GRAPH_END
+       << "' lines to stdout\n";
+    os << "        in the input order.\n";
+    os << "\n";
+}
+
+
+}// namespace Undirected
+
+}// namespace Wailea
@@ -1,4 +1,5 @@
 #include "undirected/bctree.hpp"
+#include "undirected/static_dfs.hpp"
 
 namespace Wailea {
 
@@ -19,7 +20,7 @@ vector<node_list_it_t> BCTree::cutVertexNodes()
     auto itPair = nodes();
     for (auto it = itPair.first; it != itPair.second; it++) {
 
-        BCTreeNode& n = dynamic_cast<BCTreeNode&>(*(*it));
+        BCTreeNode& n = downcast<BCTreeNode>(*(*it));
         if (n.type() == BCTreeNode::CutVertexType) {
             vec.push_back(it);
         }
@@ -37,7 +38,7 @@ vector<node_list_it_t> BCTree::blockNodes()
     auto itPair = nodes();
     for (auto it = itPair.first; it != itPair.second; it++) {
 
-        BCTreeNode& n = dynamic_cast<BCTreeNode&>(*(*it));
+        BCTreeNode& n = downcast<BCTreeNode>(*(*it));
         if (n.type() == BCTreeNode::BlockType) {
             vec.push_back(it);
         }
@@ -53,7 +54,7 @@ vector<node_list_it_t> Block::cutVertices() {
     vector<node_list_it_t> cvs;
     auto itPair = nodes();
     for (auto it = itPair.first;it != itPair.second; it++) {
-        auto& n = dynamic_cast<BlockNode&>(*(*it));
+        auto& n = downcast<BlockNode>(*(*it));
         if (n.type() == BlockNode::CutVertexType) {
             cvs.push_back(it);
         }
@@ -78,13 +79,19 @@ BCTree BiconnectedDecomposer::decompose(Graph& g, Node& s)
     }
     else {
 
+        ElementArena arena;
         DFSGraph<Graph,BCDFSNode,BCDFSEdge> gCopy;
-        auto sCopy = copyInputGraph(g, gCopy, s.backIt());
+        node_list_it_t sCopy;
+        {
+            ElementArena::Scope scope(arena);
+            sCopy = copyInputGraph(g, gCopy, s.backIt());
+        }
         BCTree     bcTree(g); 
         BCStrategy strategy(sCopy, bcTree);
-        DFSExplorer<Graph,BCDFSNode,BCDFSEdge> mExplorer(gCopy,strategy);
+        StaticDFSExplorer<Graph,BCDFSNode,BCDFSEdge,BCStrategy>
+                                                  mExplorer(gCopy,strategy);
         mExplorer.reset(gCopy);
-        mExplorer.run(dynamic_cast<DFSNode<Graph,BCDFSNode,BCDFSEdge>&>
+        mExplorer.run(downcast<DFSNode<Graph,BCDFSNode,BCDFSEdge>>
                                                                (*(*sCopy)));
         return bcTree; // rvo
 
@@ -110,7 +117,7 @@ BCTree BiconnectedDecomposer::processSingleIsolatedVertex(Graph& g, Node& n)
 {
     BCTree bcTree(g);
     auto  bp    = make_unique<Block>();
-    auto& tn    = dynamic_cast<BCTreeNode&>(
+    auto& tn    = downcast<BCTreeNode>(
                           bcTree.addNode(make_unique<BCTreeNode>(move(bp))) );
     auto& block = tn.block();
     block.setBackTreeNode(tn.backIt());
@@ -160,7 +167,7 @@ node_list_it_t BiconnectedDecomposer::copyInputGraph(
 
 void BiconnectedDecomposer::BCStrategy::enterNode(DNode& n) noexcept
 {
-//    NumNode& NN = dynamic_cast<NumNode&>(*(*(n.mOriginal)));
+//    NumNode& NN = downcast<NumNode>(*(*(n.mOriginal)));
 //    cerr << "enterNode: " << NN.num() << " mNum: ";
 
     mI++;
@@ -170,18 +177,18 @@ void BiconnectedDecomposer::BCStrategy::enterNode(DNode& n) noexcept
 }
 
 void BiconnectedDecomposer::BCStrategy::leaveNode(DNode& n) noexcept {
-//    NumNode& NN = dynamic_cast<NumNode&>(*(*(n.mOriginal)));
+//    NumNode& NN = downcast<NumNode>(*(*(n.mOriginal)));
 //    cerr << "leaveNode: " << NN.num() << "\n";
 }
 
 void BiconnectedDecomposer::BCStrategy::processFrond(DNode& n, DEdge& c)
 {
-//    auto& NN = dynamic_cast<NumNode&>(*(*(n.mOriginal)));
-//    auto& DA = dynamic_cast<DNode&>(c.adjacentNode(n));
-//    auto& NN2 = dynamic_cast<NumNode&>(*(*(DA.mOriginal)));
+//    auto& NN = downcast<NumNode>(*(*(n.mOriginal)));
+//    auto& DA = downcast<DNode>(c.adjacentNode(n));
+//    auto& NN2 = downcast<NumNode>(*(*(DA.mOriginal)));
 //    cerr << "processFrond: (" << NN.num() << "," << NN2.num() << ") lowPt: ";
 
-    auto& adj = dynamic_cast<DNode&>(c.adjacentNode(n));        
+    auto& adj = downcast<DNode>(c.adjacentNode(n));        
     mStack.push_back(c.backIt());
     n.mLowPt = std::min(n.mLowPt, adj.mNum);
 //    cerr << n.mLowPt << "\n";
@@ -190,9 +197,9 @@ void BiconnectedDecomposer::BCStrategy::processFrond(DNode& n, DEdge& c)
 
 void BiconnectedDecomposer::BCStrategy::beforeVisitingChild(DNode& n, DEdge& c)
 {
-//    auto& NN = dynamic_cast<NumNode&>(*(*(n.mOriginal)));
-//    auto& DA = dynamic_cast<DNode&>(c.adjacentNode(n));
-//    auto& NN2 = dynamic_cast<NumNode&>(*(*(DA.mOriginal)));
+//    auto& NN = downcast<NumNode>(*(*(n.mOriginal)));
+//    auto& DA = downcast<DNode>(c.adjacentNode(n));
+//    auto& NN2 = downcast<NumNode>(*(*(DA.mOriginal)));
 //    cerr << "beforeVisitingChild: (" << NN.num() << "," << NN2.num() << ")\n";
 
     mStack.push_back(c.backIt());
@@ -201,12 +208,12 @@ void BiconnectedDecomposer::BCStrategy::beforeVisitingChild(DNode& n, DEdge& c)
 
 void BiconnectedDecomposer::BCStrategy::afterVisitingChild(DNode& n, DEdge& c)
 {
-//    auto& NN = dynamic_cast<NumNode&>(*(*(n.mOriginal)));
-//    auto& DA = dynamic_cast<DNode&>(c.adjacentNode(n));
-//    auto& NN2 = dynamic_cast<NumNode&>(*(*(DA.mOriginal)));
+//    auto& NN = downcast<NumNode>(*(*(n.mOriginal)));
+//    auto& DA = downcast<DNode>(c.adjacentNode(n));
+//    auto& NN2 = downcast<NumNode>(*(*(DA.mOriginal)));
 //    cerr << "afterVisitingChild: (" << NN.num() << "," << NN2.num() << ") lowPt: ";
 
-    auto& adj = dynamic_cast<DNode&>(c.adjacentNode(n));
+    auto& adj = downcast<DNode>(c.adjacentNode(n));
     n.mLowPt = std::min(n.mLowPt,adj.mLowPt);
 //    cerr << n.mLowPt << "\n";
     if (adj.mLowPt >= n.mNum) {
@@ -257,7 +264,7 @@ void BiconnectedDecomposer::BCStrategy::processNewlyFoundBlock(
     }
     auto bp = make_unique<Block>();
     auto& tn = mBCTree.addNode(make_unique<BCTreeNode>(move(bp)));
-    fillBlockAndConnectBCTreeNodes(dynamic_cast<BCTreeNode&>(tn),blockEdges);
+    fillBlockAndConnectBCTreeNodes(downcast<BCTreeNode>(tn),blockEdges);
 }
 
 
@@ -270,7 +277,7 @@ void BiconnectedDecomposer::BCStrategy::fillBlockAndConnectBCTreeNodes(
     vector<node_list_it_t> nCopy = gCopy.edgeInducedNodes(eCopy);
     vector<pair<node_list_it_t,node_ptr_t>> nodePairs;
     for (auto nit : nCopy) {
-        auto& n = dynamic_cast<BCDFSNode&>(*(*nit));
+        auto& n = downcast<BCDFSNode>(*(*nit));
         if (n.mCutVertex) {
             auto np = make_unique<BlockNode>(n.IGBackwardLink(),
                                                      BlockNode::CutVertexType);
@@ -289,7 +296,7 @@ void BiconnectedDecomposer::BCStrategy::fillBlockAndConnectBCTreeNodes(
     }
     vector<pair<edge_list_it_t,edge_ptr_t>> edgePairs;       
     for (auto eit : eCopy) {
-        auto& e = dynamic_cast<BCDFSEdge&>(*(*eit));
+        auto& e = downcast<BCDFSEdge>(*(*eit));
         auto ep = make_unique<BlockEdge>(e.IGBackwardLink());
         edgePairs.push_back(make_pair(eit,std::move(ep)));
     }
@@ -297,7 +304,7 @@ void BiconnectedDecomposer::BCStrategy::fillBlockAndConnectBCTreeNodes(
     // Patch up BCTreeEdge's iterator.
     auto bnPair = block.nodes();
     for (auto bnit = bnPair.first ; bnit != bnPair.second ; bnit++) {
-        auto&  n = dynamic_cast<BlockNode&>(*(*bnit));
+        auto&  n = downcast<BlockNode>(*(*bnit));
         if (n.type()==BlockNode::CutVertexType) {
             auto&  e = n.treeEdge();
             e.setCutVertexInBlock(n.backIt());
@@ -311,7 +318,7 @@ void BiconnectedDecomposer::BCStrategy::fillBlockAndConnectBCTreeNodes(
     auto bePair = block.edges();
     for (auto beit = bePair.first ; beit != bePair.second ; beit++) {
 
-        auto&  e = dynamic_cast<BlockEdge&>(*(*beit));
+        auto&  e = downcast<BlockEdge>(*(*beit));
         e.IGBackwardLinkRef().setIGForwardLink(beit);
     }
 }
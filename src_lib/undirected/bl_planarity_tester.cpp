@@ -19,6 +19,24 @@ namespace Undirected {
 using namespace std;
 
 
+BLPlanarityTester::BLPlanarityTester(){;}
+
+
+BLPlanarityTester::~BLPlanarityTester(){;}
+
+
+BLTree& BLPlanarityTester::resetPQTree()
+{
+    if (mPQTree == nullptr) {
+        mPQTree = make_unique<BLTree>();
+    }
+    else {
+        mPQTree->clear();
+    }
+    return *mPQTree;
+}
+
+
 bool BLPlanarityTester::isPlanar(
     Graph&                  g,
     vector<node_list_it_t>& stOrder
@@ -29,25 +47,30 @@ bool BLPlanarityTester::isPlanar(
         return true;
     }
 
-    BLGraph                graphCopy;
-    vector<node_list_it_t> stOrderCopy;
+    ElementArena            arena;
+    BLGraph                 graphCopy;
+    vector<node_list_it_t>& stOrderCopy = mStOrderCopy;
 
-    copyInputGraph(g, stOrder, graphCopy, stOrderCopy);
+    {
+        ElementArena::Scope scope(arena);
+        copyInputGraph(g, stOrder, graphCopy, stOrderCopy);
+    }
 
-    BLTree         pqTree;
+    BLTree&        pqTree = resetPQTree();
     node_list_it_t attachmentNode = pqTree.makePAttachment();
 
+    vector<node_list_it_t>& pertinentLeaves = mPertinentLeaves;
+
     size_t index = 0;
 
     for (auto nit : stOrderCopy ) {
-        auto& N = dynamic_cast<BLGraphNode&>(*(*nit));
+        auto& N = downcast<BLGraphNode>(*(*nit));
 
         if (index > 0) {
 
             pqTree.initializeForOneIteration();
 
-            vector<node_list_it_t> pertinentLeaves =
-                                    fromGraphEdgesToPQLeaves(N.mIncomingEdges);
+            fromGraphEdgesToPQLeaves(N.mIncomingEdges, pertinentLeaves);
 
             node_list_it_t pertinentRoot;
             node_list_it_t virtualRoot =pqTree.nil();
@@ -98,21 +121,26 @@ bool BLPlanarityTester::isPlanarOldAlg(
     size_t&                 index
 ) {
 
-    BLGraph                graphCopy;
-    vector<node_list_it_t> stOrderCopy;
+    ElementArena            arena;
+    BLGraph                 graphCopy;
+    vector<node_list_it_t>& stOrderCopy = mStOrderCopy;
 
-    copyInputGraph(g, stOrder, graphCopy, stOrderCopy);
+    {
+        ElementArena::Scope scope(arena);
+        copyInputGraph(g, stOrder, graphCopy, stOrderCopy);
+    }
 
-    BLTree         pqTree;
+    BLTree&        pqTree = resetPQTree();
     node_list_it_t attachmentNode = pqTree.makePAttachment();
 
+    vector<node_list_it_t>& pertinentLeaves = mPertinentLeaves;
+
     index = 0;
     for (auto nit : stOrderCopy ) {
-        auto& N = dynamic_cast<BLGraphNode&>(*(*nit));
+        auto& N = downcast<BLGraphNode>(*(*nit));
         if (index > 0) {
             pqTree.initializeForOneIteration();
-            vector<node_list_it_t> pertinentLeaves =
-                                    fromGraphEdgesToPQLeaves(N.mIncomingEdges);
+            fromGraphEdgesToPQLeaves(N.mIncomingEdges, pertinentLeaves);
             node_list_it_t pertinentRoot;
             node_list_it_t virtualRoot =pqTree.nil();
             bool result = bubbleUp(pqTree, pertinentLeaves, virtualRoot);
@@ -150,9 +178,13 @@ bool BLPlanarityTester::findEmbedding(
     if (g.numNodes() <= 3) {
         return true;
     }
-    BLGraph                graphCopy;
-    vector<node_list_it_t> stOrderCopy;
-    copyInputGraph(g, stOrder, graphCopy, stOrderCopy);
+    ElementArena            arena;
+    BLGraph                 graphCopy;
+    vector<node_list_it_t>& stOrderCopy = mStOrderCopy;
+    {
+        ElementArena::Scope scope(arena);
+        copyInputGraph(g, stOrder, graphCopy, stOrderCopy);
+    }
     bool result;
     result = findEmbeddingFirstPass(graphCopy, stOrderCopy);
     if (!result) {
@@ -183,32 +215,32 @@ bool BLPlanarityTester::findEmbeddingFirstPass(
     cerr <<       "=========          FIRST PASS          ===========\n";
     cerr <<       "==================================================\n";
 #endif
-    BLTree                 pqTree;
+    BLTree&                pqTree = resetPQTree();
     pqTree.setCollectingEdges();
     node_list_it_t attachmentNode = pqTree.makePAttachment();
     size_t index = 0;
 
     for (auto nit : stOrderCopy ) {
-        auto& N = dynamic_cast<BLGraphNode&>(*(*nit));
+        auto& N = downcast<BLGraphNode>(*(*nit));
 #ifdef UNIT_TESTS2
         {     
             cerr << "\n\n\n==================================================\n";
             cerr <<       "=========        Iteration: " << index + 1 << "        ===========\n";
             cerr <<       "==================================================\n";
-            auto& GN = dynamic_cast<NumNode&>(N.IGBackwardLinkRef());
+            auto& GN = downcast<NumNode>(N.IGBackwardLinkRef());
 
             cerr << "[" << GN.num() << "] In:[";
             for (auto eit : N.mIncomingEdges) {
-                auto& GE = dynamic_cast<BLGraphEdge&>(*(*eit));
-                auto& BA = dynamic_cast<BLGraphNode&>(GE.adjacentNode(N));
-                auto& GA = dynamic_cast<NumNode&>(BA.IGBackwardLinkRef());
+                auto& GE = downcast<BLGraphEdge>(*(*eit));
+                auto& BA = downcast<BLGraphNode>(GE.adjacentNode(N));
+                auto& GA = downcast<NumNode>(BA.IGBackwardLinkRef());
             cerr << GA.num() << ",";
             }
             cerr << "] Out:[";
             for (auto eit : N.mOutgoingEdges) {
-                auto& GE = dynamic_cast<BLGraphEdge&>(*(*eit));
-                auto& BA = dynamic_cast<BLGraphNode&>(GE.adjacentNode(N));
-                auto& GA = dynamic_cast<NumNode&>(BA.IGBackwardLinkRef());
+                auto& GE = downcast<BLGraphEdge>(*(*eit));
+                auto& BA = downcast<BLGraphNode>(GE.adjacentNode(N));
+                auto& GA = downcast<NumNode>(BA.IGBackwardLinkRef());
                 cerr << GA.num() << ",";
             }
             cerr << "]\n";
@@ -216,8 +248,8 @@ bool BLPlanarityTester::findEmbeddingFirstPass(
 #endif
         if (index > 0) {
             pqTree.initializeForOneIteration();
-            vector<node_list_it_t> pertinentLeaves =
-                                    fromGraphEdgesToPQLeaves(N.mIncomingEdges);
+            vector<node_list_it_t>& pertinentLeaves = mPertinentLeaves;
+            fromGraphEdgesToPQLeaves(N.mIncomingEdges, pertinentLeaves);
 
             node_list_it_t pertinentRoot;
             node_list_it_t virtualRoot = pqTree.nil();
@@ -263,13 +295,13 @@ bool BLPlanarityTester::findEmbeddingFirstPass(
 #ifdef UNIT_TESTS2
         {     
             cerr << "Collected Edges: ";
-            auto& GN = dynamic_cast<NumNode&>(N.IGBackwardLinkRef());
+            auto& GN = downcast<NumNode>(N.IGBackwardLinkRef());
 
             cerr << "[" << GN.num() << "] In:[";
             for (auto eit : N.mIncomingEdgesOrdered) {
-                auto& GE = dynamic_cast<BLGraphEdge&>(*(*eit));
-                auto& BA = dynamic_cast<BLGraphNode&>(GE.adjacentNode(N));
-                auto& GA = dynamic_cast<NumNode&>(BA.IGBackwardLinkRef());
+                auto& GE = downcast<BLGraphEdge>(*(*eit));
+                auto& BA = downcast<BLGraphNode>(GE.adjacentNode(N));
+                auto& GA = downcast<NumNode>(BA.IGBackwardLinkRef());
                 cerr << GA.num() << ",";
             }
             cerr << "]\n";
@@ -294,7 +326,7 @@ bool BLPlanarityTester::findEmbeddingSecondPass(
     cerr <<       "=========          SECOND PASS         ===========\n";
     cerr <<       "==================================================\n";
 #endif
-    BLTree                 pqTree;
+    BLTree&                pqTree = resetPQTree();
     pqTree.setCollectingEdges();
     // In the second pass, it keeps track of the orientation of all the Q-nodes
 
@@ -303,7 +335,7 @@ bool BLPlanarityTester::findEmbeddingSecondPass(
     size_t index = 0;
 
     for (auto nItIt=stOrderCopy.rbegin(); nItIt!=stOrderCopy.rend(); nItIt++) {
-        auto& N = dynamic_cast<BLGraphNode&>(*(*(*(nItIt))));
+        auto& N = downcast<BLGraphNode>(*(*(*(nItIt))));
 #ifdef UNIT_TESTS2
         {     
             cerr << "\n\n\n================================================\n";
@@ -311,20 +343,20 @@ bool BLPlanarityTester::findEmbeddingSecondPass(
                  << "        ===========\n";
             cerr <<       "================================================\n";
 
-            auto& GN = dynamic_cast<NumNode&>(N.IGBackwardLinkRef());
+            auto& GN = downcast<NumNode>(N.IGBackwardLinkRef());
 
             cerr << "[" << GN.num() << "] InOrdered:[";
             for (auto eit : N.mIncomingEdgesOrdered) {
-                auto& GE = dynamic_cast<BLGraphEdge&>(*(*eit));
-                auto& BA = dynamic_cast<BLGraphNode&>(GE.adjacentNode(N));
-                auto& GA = dynamic_cast<NumNode&>(BA.IGBackwardLinkRef());
+                auto& GE = downcast<BLGraphEdge>(*(*eit));
+                auto& BA = downcast<BLGraphNode>(GE.adjacentNode(N));
+                auto& GA = downcast<NumNode>(BA.IGBackwardLinkRef());
             cerr << GA.num() << ",";
             }
             cerr << "] Out:[";
             for (auto eit : N.mOutgoingEdges) {
-                auto& GE = dynamic_cast<BLGraphEdge&>(*(*eit));
-                auto& BA = dynamic_cast<BLGraphNode&>(GE.adjacentNode(N));
-                auto& GA = dynamic_cast<NumNode&>(BA.IGBackwardLinkRef());
+                auto& GE = downcast<BLGraphEdge>(*(*eit));
+                auto& BA = downcast<BLGraphNode>(GE.adjacentNode(N));
+                auto& GA = downcast<NumNode>(BA.IGBackwardLinkRef());
                 cerr << GA.num() << ",";
             }
             cerr << "]\n";
@@ -333,8 +365,8 @@ bool BLPlanarityTester::findEmbeddingSecondPass(
 
         if (index > 0) {
             pqTree.initializeForOneIteration();
-            vector<node_list_it_t> pertinentLeaves =
-                                    fromGraphEdgesToPQLeaves(N.mOutgoingEdges);
+            vector<node_list_it_t>& pertinentLeaves = mPertinentLeaves;
+            fromGraphEdgesToPQLeaves(N.mOutgoingEdges, pertinentLeaves);
             node_list_it_t pertinentRoot;
             node_list_it_t virtualRoot = pqTree.nil();
             bool result = bubbleUp(pqTree, pertinentLeaves, virtualRoot);
@@ -382,13 +414,13 @@ bool BLPlanarityTester::findEmbeddingSecondPass(
 #ifdef UNIT_TESTS2
         {     
             cerr << "Collected Edges: ";
-            auto& GN = dynamic_cast<NumNode&>(N.IGBackwardLinkRef());
+            auto& GN = downcast<NumNode>(N.IGBackwardLinkRef());
 
             cerr << "[" << GN.num() << "] Out:[";
             for (auto eit : N.mOutgoingEdgesOrdered) {
-                auto& GE = dynamic_cast<BLGraphEdge&>(*(*eit));
-                auto& BA = dynamic_cast<BLGraphNode&>(GE.adjacentNode(N));
-                auto& GA = dynamic_cast<NumNode&>(BA.IGBackwardLinkRef());
+                auto& GE = downcast<BLGraphEdge>(*(*eit));
+                auto& BA = downcast<BLGraphNode>(GE.adjacentNode(N));
+                auto& GA = downcast<NumNode>(BA.IGBackwardLinkRef());
                 cerr << GA.num() << ",";
             }
             cerr << "]\n";
@@ -445,30 +477,30 @@ bool BLPlanarityTester::findEmbeddingSecondPass(
 #ifdef UNIT_TESTS2
     cerr << "mOrientInNorm: ";
     for (auto a : mOrientInNorm) {
-        auto& BN = dynamic_cast<BLGraphNode&>(*(*a));
-        auto& GN = dynamic_cast<NumNode&>(BN.IGBackwardLinkRef());
+        auto& BN = downcast<BLGraphNode>(*(*a));
+        auto& GN = downcast<NumNode>(BN.IGBackwardLinkRef());
         cerr << GN.num() << ", ";
     }
     cerr << "\n";
     cerr << "mOrientInReversed: ";
     for (auto a : mOrientInReversed) {
-        auto& BN = dynamic_cast<BLGraphNode&>(*(*a));
-        auto& GN = dynamic_cast<NumNode&>(BN.IGBackwardLinkRef());
+        auto& BN = downcast<BLGraphNode>(*(*a));
+        auto& GN = downcast<NumNode>(BN.IGBackwardLinkRef());
         cerr << GN.num() << ", ";
     }
     cerr << "\n";
 
     cerr << "mOrientOutNorm: ";
     for (auto a : mOrientOutNorm) {
-        auto& BN = dynamic_cast<BLGraphNode&>(*(*a));
-        auto& GN = dynamic_cast<NumNode&>(BN.IGBackwardLinkRef());
+        auto& BN = downcast<BLGraphNode>(*(*a));
+        auto& GN = downcast<NumNode>(BN.IGBackwardLinkRef());
         cerr << GN.num() << ", ";
     }
     cerr << "\n";
     cerr << "mOrientOutReversed: ";
     for (auto a : mOrientOutReversed) {
-        auto& BN = dynamic_cast<BLGraphNode&>(*(*a));
-        auto& GN = dynamic_cast<NumNode&>(BN.IGBackwardLinkRef());
+        auto& BN = downcast<BLGraphNode>(*(*a));
+        auto& GN = downcast<NumNode>(BN.IGBackwardLinkRef());
         cerr << GN.num() << ", ";
     }
     cerr << "\n";
@@ -482,17 +514,17 @@ void BLPlanarityTester::rearrangeIncidentEdges(
     BLGraph&  graphCopy
 ) {
     for (auto nit : mOrientInReversed) {
-        auto& N = dynamic_cast<BLGraphNode&>(*(*nit));
+        auto& N = downcast<BLGraphNode>(*(*nit));
         N.mIncomingEdgesInReverse = true;
     }
     for (auto nit : mOrientOutReversed) {
-        auto& N = dynamic_cast<BLGraphNode&>(*(*nit));
+        auto& N = downcast<BLGraphNode>(*(*nit));
         N.mOutgoingEdgesInReverse = true;
     }
     for (auto nit = graphCopy.nodes().first;
                                       nit != graphCopy.nodes().second; nit++) {
-        auto& NCopy = dynamic_cast<BLGraphNode&>(*(*nit));
-        auto& NOrg  = dynamic_cast<Node&>(NCopy.IGBackwardLinkRef());
+        auto& NCopy = downcast<BLGraphNode>(*(*nit));
+        auto& NOrg  = downcast<Node>(NCopy.IGBackwardLinkRef());
         vector<edge_list_it_t> rearrangedEdges;
         // Concatenate mIncomingEdgesOrdered and mOutgoingEdgesOrdered
         // into rearrangedEdges. Note that one of them must be in reversed 
@@ -501,7 +533,7 @@ void BLPlanarityTester::rearrangeIncidentEdges(
         if (NCopy.mIncomingEdgesInReverse) {
             for (auto eit = NCopy.mIncomingEdgesOrdered.rbegin();
                            eit != NCopy.mIncomingEdgesOrdered.rend(); eit++) {
-                auto& ECopy = dynamic_cast<BLGraphEdge&>(*(*(*(eit))));
+                auto& ECopy = downcast<BLGraphEdge>(*(*(*(eit))));
                 rearrangedEdges.push_back(ECopy.IGBackwardLink());
             }
 
@@ -509,21 +541,21 @@ void BLPlanarityTester::rearrangeIncidentEdges(
         else {        
             for (auto eit = NCopy.mIncomingEdgesOrdered.begin();
                            eit != NCopy.mIncomingEdgesOrdered.end(); eit++) {
-                auto& ECopy = dynamic_cast<BLGraphEdge&>(*(*(*(eit))));
+                auto& ECopy = downcast<BLGraphEdge>(*(*(*(eit))));
                 rearrangedEdges.push_back(ECopy.IGBackwardLink());
             }
         }
         if (!NCopy.mOutgoingEdgesInReverse) {
             for (auto eit = NCopy.mOutgoingEdgesOrdered.rbegin();
                            eit != NCopy.mOutgoingEdgesOrdered.rend(); eit++) {
-                auto& ECopy = dynamic_cast<BLGraphEdge&>(*(*(*(eit))));
+                auto& ECopy = downcast<BLGraphEdge>(*(*(*(eit))));
                 rearrangedEdges.push_back(ECopy.IGBackwardLink());
             }
         }
         else {        
             for (auto eit = NCopy.mOutgoingEdgesOrdered.begin();
                            eit != NCopy.mOutgoingEdgesOrdered.end(); eit++) {
-                auto& ECopy = dynamic_cast<BLGraphEdge&>(*(*(*(eit))));
+                auto& ECopy = downcast<BLGraphEdge>(*(*(*(eit))));
                 rearrangedEdges.push_back(ECopy.IGBackwardLink());
             }
         }
@@ -539,16 +571,15 @@ void BLPlanarityTester::copyInputGraph(
     vector<node_list_it_t>& stOrderDst
 ) {
 
-    vector<pair<node_list_it_t,node_ptr_t>> nodePairs;
-    vector<pair<edge_list_it_t,edge_ptr_t>> edgePairs;
+    auto& nodePairs = mNodePairs;
+    auto& edgePairs = mEdgePairs;
+    nodePairs.clear();
+    edgePairs.clear();
+    nodePairs.reserve(stOrderSrc.size());
+    edgePairs.reserve(src.numEdges());
 
     stOrderDst.clear();
-    for (size_t st = 0; st < stOrderSrc.size() ; st++) {
-
-        node_list_it_t tmpIt;
-        stOrderDst.push_back(tmpIt);
-
-    }
+    stOrderDst.resize(stOrderSrc.size());
 
     size_t stNum = 0;
     for (auto nItIt = stOrderSrc.begin(); nItIt != stOrderSrc.end(); nItIt++) {
@@ -573,12 +604,12 @@ void BLPlanarityTester::copyInputGraph(
 
     for (auto nit = dst.nodes().first; nit != dst.nodes().second; nit++) {
 
-        auto& n = dynamic_cast<BLGraphNode&>(*(*nit));
+        auto& n = downcast<BLGraphNode>(*(*nit));
         stOrderDst[n.mStNumber] = nit;
         for (auto iit = n.incidentEdges().first;
                                       iit != n.incidentEdges().second; iit++) {
-            auto& e = dynamic_cast<BLGraphEdge&>(*(*(*iit)));
-            auto& a = dynamic_cast<BLGraphNode&>(e.adjacentNode(n));
+            auto& e = downcast<BLGraphEdge>(*(*(*iit)));
+            auto& a = downcast<BLGraphNode>(e.adjacentNode(n));
             if (n.mStNumber < a.mStNumber) {
                 n.mOutgoingEdges.push_back(e.backIt());
             }
@@ -592,6 +623,9 @@ void BLPlanarityTester::copyInputGraph(
 
     dst.mOriginal = &src;
 
+    // The elements have been moved to dst.
+    nodePairs.clear();
+    edgePairs.clear();
 }
 
 
@@ -608,16 +642,25 @@ vector<node_list_it_t> BLPlanarityTester::fromGraphEdgesToPQLeaves(
     list<edge_list_it_t>& edgeList
 ) {
     vector<node_list_it_t> leaves;
+    fromGraphEdgesToPQLeaves(edgeList, leaves);
+    return leaves; // rvo
+}
+
+
+void BLPlanarityTester::fromGraphEdgesToPQLeaves(
+    list<edge_list_it_t>&   edgeList,
+    vector<node_list_it_t>& leaves
+) {
+    leaves.clear();
     for(auto eit : edgeList) {
-        auto& e = dynamic_cast<BLGraphEdge&>(*(*eit));
-        //auto& GN1 = dynamic_cast<BLGraphNode&>(e.incidentNode1());
-        //auto& GN2 = dynamic_cast<BLGraphNode&>(e.incidentNode2());
-        //auto& N1 = dynamic_cast<NumNode&>(GN1.IGBackwardLinkRef());
-        //auto& N2 = dynamic_cast<NumNode&>(GN2.IGBackwardLinkRef());
+        auto& e = downcast<BLGraphEdge>(*(*eit));
+        //auto& GN1 = downcast<BLGraphNode>(e.incidentNode1());
+        //auto& GN2 = downcast<BLGraphNode>(e.incidentNode2());
+        //auto& N1 = downcast<NumNode>(GN1.IGBackwardLinkRef());
+        //auto& N2 = downcast<NumNode>(GN2.IGBackwardLinkRef());
         //cerr << "Edge: [" << N1.num() << "," << N2.num() << "]\n";
         leaves.push_back(e.mPQLeaf);
     }
-    return leaves; // rvo
 }
 
 
@@ -885,8 +928,7 @@ node_list_it_t BLPlanarityTester::makeVirtualRootAndPutOrphansUnder(
     auto& X =  pqTree.toNodeRef(xIt);
 
     // Make a virtual root.
-    auto  vpp  = make_unique<BLTreeNode>(pqTree);
-    auto& VP   = dynamic_cast<BLTreeNode&>(pqTree.addNode(std::move(vpp)));
+    auto& VP   = pqTree.toNodeRef(pqTree.newNode());
 
     VP.mNodeType = BLTreeNode::VirtualRootType;
     VP.mGeneration = pqTree.mGeneration;
@@ -1023,6 +1065,18 @@ bool BLPlanarityTester::applyTemplates(
             {
                 return false;
             }
+
+            // The pertinent leaves at both ends of a complementarily
+            // doubly partial node are consecutive only around the tree
+            // root, whose frontier is cyclic. Under any other node, they
+            // are separated by the leaves of the rest of the tree.
+            if (!pqTree.isNil(pqTree.CDPartialRoot())) {
+                auto& R = pqTree.toNodeRef(pertinentRoot);
+                if (!pqTree.isNil(R.mParent) ||
+                    R.mNodeType == BLTreeNode::VirtualRootType) {
+                    return false;
+                }
+            }
         }
     }
     return true;
@@ -1583,7 +1637,7 @@ void BLPlanarityTester::removePertinentNodesAndDescendants(
 
         }
 
-        pqTree.removeNode(C);
+        pqTree.releaseNode(C);
     }
 }
 
@@ -26,8 +26,7 @@ using namespace std;
  */
 node_list_it_t BLTree::makePNode(list<node_list_it_t>& children)
 {
-    auto  np  = make_unique<BLTreeNode>(*this);
-    auto  nIt = addNode(std::move(np)).backIt();
+    auto  nIt = newNode();
     auto& N   = toNodeRef(nIt);
 
     N.mNodeType      = BLTreeNode::PType;
@@ -52,8 +51,7 @@ node_list_it_t BLTree::makePNode(list<node_list_it_t>& children)
 
 node_list_it_t BLTree::makeQNode()
 {
-    auto  np  = make_unique<BLTreeNode>(*this);
-    auto  nIt = addNode(std::move(np)).backIt();
+    auto  nIt = newNode();
     auto& N   = toNodeRef(nIt);
 
     N.mNodeType      = BLTreeNode::QType;
@@ -207,7 +205,7 @@ node_list_it_t BLTree::bringUpOnlyChildOfPNodeAndRemove(BLTreeNode& X)
     }
     X.discardOldFullLink();
     X.clearFullChildren();
-    removeNode(X);
+    releaseNode(X);
 
     return C.backIt();
 }
@@ -220,7 +218,7 @@ void BLTree::fanOutLeavesFromAttachment(
 ) {
     BLTreeNode& A = toNodeRef(aIt);
     if (edgeList.size()==1) {
-        auto& E = dynamic_cast<BLGraphEdge&>(*(*(*edgeList.begin())));
+        auto& E = downcast<BLGraphEdge>(*(*(*edgeList.begin())));
 
         A.mNodeType  = BLTreeNode::LType;
         A.mGraphEdge = E.backIt();
@@ -230,10 +228,9 @@ void BLTree::fanOutLeavesFromAttachment(
     else {
         for(auto eIt : edgeList) {
 
-            auto& E = dynamic_cast<BLGraphEdge&>(*(*eIt));
+            auto& E = downcast<BLGraphEdge>(*(*eIt));
 
-            auto  np  = make_unique<BLTreeNode>(*this);
-            auto  nIt = addNode(std::move(np)).backIt();
+            auto  nIt = newNode();
             auto& N   = toNodeRef(nIt);
 
             N.mNodeType  = BLTreeNode::LType;
@@ -255,7 +252,7 @@ void BLTree::fanOutLeavesFromQAttachment(
 
     BLTreeNode& A = toNodeRef(aIt);
     if (edgeList.size()==1) {
-        auto& E = dynamic_cast<BLGraphEdge&>(*(*(*edgeList.begin())));
+        auto& E = downcast<BLGraphEdge>(*(*(*edgeList.begin())));
 
         A.mNodeType  = BLTreeNode::LType;
         A.mGraphEdge = E.backIt();
@@ -270,10 +267,9 @@ void BLTree::fanOutLeavesFromQAttachment(
         node_list_it_t prevIt = nil();
         for(auto eIt : edgeList) {
 
-            auto& E = dynamic_cast<BLGraphEdge&>(*(*eIt));
+            auto& E = downcast<BLGraphEdge>(*(*eIt));
 
-            auto  np  = make_unique<BLTreeNode>(*this);
-            auto  nIt = addNode(std::move(np)).backIt();
+            auto  nIt = newNode();
             auto& N   = toNodeRef(nIt);
 
             N.mNodeType  = BLTreeNode::LType;
@@ -368,7 +364,7 @@ bool BLTree::templateP1(BLTreeNode& X, reductionType reduction)
 
         for (auto cit : X.mFullChildren) {
 
-            auto& C = dynamic_cast<BLTreeNode&>(*(*cit));
+            auto& C = downcast<BLTreeNode>(*(*cit));
 
             X.mCollectedEdges.splice( X.mCollectedEdges.end(), 
                                       C.mCollectedEdges        );
@@ -427,7 +423,7 @@ bool BLTree::templateP2(BLTreeNode& X, node_list_it_t& pertinentRootIt)
     if (mCollectingEdges) {
 
         for (auto cit : fullChildren) {
-            auto& C = dynamic_cast<BLTreeNode&>(*(*cit));
+            auto& C = downcast<BLTreeNode>(*(*cit));
 
             pertinentRoot.mCollectedEdges.splice( 
                                  pertinentRoot.mCollectedEdges.end(), 
@@ -652,7 +648,7 @@ bool BLTree::templateP3(BLTreeNode& X, bool& earlyOut)
 
             for (auto cit : fullChildren) {
 
-                auto& C = dynamic_cast<BLTreeNode&>(*(*cit));
+                auto& C = downcast<BLTreeNode>(*(*cit));
 
                 SP.mCollectedEdges.splice( SP.mCollectedEdges.end(), 
                                            C.mCollectedEdges        );
@@ -681,7 +677,7 @@ bool BLTree::templateP3(BLTreeNode& X, bool& earlyOut)
 
             for (auto cit : fullChildren) {
 
-                auto& C = dynamic_cast<BLTreeNode&>(*(*cit));
+                auto& C = downcast<BLTreeNode>(*(*cit));
 
                 X.mCollectedEdges.splice( X.mCollectedEdges.end(), 
                                           C.mCollectedEdges        );
@@ -781,7 +777,7 @@ void BLTree::collectGraphEdgesP4 (
                   rcit != fullChildren.rend();
                   rcit++                        ) {
 
-            auto& C = dynamic_cast< BLTreeNode& >( *(*(*rcit)) );
+            auto& C = downcast< BLTreeNode>( *(*(*rcit)) );
 
             X.mCollectedEdges.splice( X.mCollectedEdges.begin(),
                                       C.mCollectedEdges        );
@@ -795,7 +791,7 @@ void BLTree::collectGraphEdgesP4 (
                    cit != fullChildren.end();
                    cit++                    ) {
 
-            auto& C = dynamic_cast< BLTreeNode& >( *(*(*cit)) );
+            auto& C = downcast< BLTreeNode>( *(*(*cit)) );
 
             X.mCollectedEdges.splice( X.mCollectedEdges.end(),
                                       C.mCollectedEdges      );
@@ -1078,7 +1074,7 @@ void BLTree::collectGraphEdgesP5 (
         for (auto rcit  = fullChildren.rbegin();
                   rcit != fullChildren.rend();
                   rcit++                        ) {
-            auto& C = dynamic_cast< BLTreeNode& >( *(*(*rcit)) );
+            auto& C = downcast< BLTreeNode>( *(*(*rcit)) );
 
             X.mCollectedEdges.splice( X.mCollectedEdges.begin(),
                                       C.mCollectedEdges        );
@@ -1090,7 +1086,7 @@ void BLTree::collectGraphEdgesP5 (
         for ( auto cit  = fullChildren.begin();
                    cit != fullChildren.end();
                    cit++                    ) {
-            auto& C = dynamic_cast< BLTreeNode& >( *(*(*cit)) );
+            auto& C = downcast< BLTreeNode>( *(*(*cit)) );
 
             X.mCollectedEdges.splice( X.mCollectedEdges.end(),
                                       C.mCollectedEdges      );
@@ -1187,7 +1183,7 @@ void BLTree::collectGraphEdgesP6Step1(
                   rcit != fullChildren.rend();
                   rcit++                        ) {
 
-            auto& C = dynamic_cast< BLTreeNode& >( *(*(*rcit)) );
+            auto& C = downcast< BLTreeNode>( *(*(*rcit)) );
 
             X.mCollectedEdges.splice( X.mCollectedEdges.begin(),
                                       C.mCollectedEdges        );
@@ -1201,7 +1197,7 @@ void BLTree::collectGraphEdgesP6Step1(
                    cit != fullChildren.end();
                    cit++                    ) {
 
-            auto& C = dynamic_cast< BLTreeNode& >( *(*(*cit)) );
+            auto& C = downcast< BLTreeNode>( *(*(*cit)) );
 
             X.mCollectedEdges.splice( X.mCollectedEdges.end(),
                                       C.mCollectedEdges      );
@@ -1407,7 +1403,7 @@ void BLTree::concatenateOneSinglyPartialToTheOther(
 
     Absorbed.clearFullChildren();
 
-    removeNode(Absorbed);
+    releaseNode(Absorbed);
 
 }
 
@@ -1617,7 +1613,7 @@ void BLTree::collectGraphEdgesP7Step1(
                   rcit != fullChildren.rend();
                   rcit++                        ) {
 
-            auto& C = dynamic_cast< BLTreeNode& >( *(*(*rcit)) );
+            auto& C = downcast< BLTreeNode>( *(*(*rcit)) );
 
             X.mCollectedEdges.splice( X.mCollectedEdges.begin(),
                                       C.mCollectedEdges        );
@@ -1631,7 +1627,7 @@ void BLTree::collectGraphEdgesP7Step1(
                    cit != fullChildren.end();
                    cit++                    ) {
 
-            auto& C = dynamic_cast< BLTreeNode& >( *(*(*cit)) );
+            auto& C = downcast< BLTreeNode>( *(*(*cit)) );
 
             X.mCollectedEdges.splice( X.mCollectedEdges.end(),
                                       C.mCollectedEdges      );
@@ -1840,7 +1836,7 @@ bool BLTree::templateP8(BLTreeNode& X, reductionType reduction, bool& earlyOut)
         X.mCollectedEdgesSide2.clear();
 
         for (auto cit : X.mFullChildren) {
-            auto& C = dynamic_cast<BLTreeNode&>(*(*cit));
+            auto& C = downcast<BLTreeNode>(*(*cit));
 
             X.mCollectedEdges.splice( X.mCollectedEdges.end(), 
                                       C.mCollectedEdges       );
@@ -2439,7 +2435,7 @@ void BLTree::flattenSinglyPartialChildToQNode(
 
     C.discardOldFullLink();
     C.clearFullChildren();
-    removeNode(C);
+    releaseNode(C);
 
 }
 
@@ -2587,7 +2583,7 @@ void BLTree::flattenSinglyPartialChildToQNodePreservingOrientation(
 
     SP.discardOldFullLink();
     SP.clearFullChildren();
-    removeNode(SP);
+    releaseNode(SP);
 
 }
 
@@ -3485,11 +3481,11 @@ node_list_it_t BLTree::findRoot()
 void BLTree::printEdgeList(list<edge_list_it_t>& edgeList)
 {
     for(auto eit : edgeList) {
-        auto& e = dynamic_cast<BLGraphEdge&>(*(*eit));
-        auto& GN1 = dynamic_cast<BLGraphNode&>(e.incidentNode1());
-        auto& GN2 = dynamic_cast<BLGraphNode&>(e.incidentNode2());
-        auto& N1 = dynamic_cast<NumNode&>(GN1.IGBackwardLinkRef());
-        auto& N2 = dynamic_cast<NumNode&>(GN2.IGBackwardLinkRef());
+        auto& e = downcast<BLGraphEdge>(*(*eit));
+        auto& GN1 = downcast<BLGraphNode>(e.incidentNode1());
+        auto& GN2 = downcast<BLGraphNode>(e.incidentNode2());
+        auto& N1 = downcast<NumNode>(GN1.IGBackwardLinkRef());
+        auto& N2 = downcast<NumNode>(GN2.IGBackwardLinkRef());
         cerr << "Edge: [" << N1.num() << "," << N2.num() << "]\n";
     }
 }
@@ -3551,10 +3547,10 @@ void BLTree::printTree(ostream& os, node_list_it_t pr) {
             for (auto cIt : N.mChildren) {            
                 auto& C = toNodeRef(cIt);
                 if (C.mNodeType == BLTreeNode::LType) {
-                    auto& E = dynamic_cast<BLGraphEdge&>(*(*(C.mGraphEdge)));
-                    auto& EOrg = dynamic_cast<Edge&>(E.IGBackwardLinkRef());
-                    auto& N1 = dynamic_cast<NumNode&>(EOrg.incidentNode1());
-                    auto& N2 = dynamic_cast<NumNode&>(EOrg.incidentNode2());
+                    auto& E = downcast<BLGraphEdge>(*(*(C.mGraphEdge)));
+                    auto& EOrg = downcast<Edge>(E.IGBackwardLinkRef());
+                    auto& N1 = downcast<NumNode>(EOrg.incidentNode1());
+                    auto& N2 = downcast<NumNode>(EOrg.incidentNode2());
                     os << "L" << C.mNodeNum;
                     if (C.mGeneration == mGeneration && !C.isEmpty()) {
                         os << "*";
@@ -3570,26 +3566,26 @@ void BLTree::printTree(ostream& os, node_list_it_t pr) {
                          C.mAssumedOrientOutReversed.size()>0) {
                         os << " AFI:[";
                         for (auto nit : C.mAssumedOrientInNorm) {
-                            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-                            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+                            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+                            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
                             os << NOrg.num() << ",";
                         }
                         os << "]  ABI:[";
                         for (auto nit : C.mAssumedOrientInReversed) {
-                            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-                            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+                            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+                            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
                             os << NOrg.num() << ",";
                         }
                         os << "]  AFO:[";
                         for (auto nit : C.mAssumedOrientOutNorm) {
-                            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-                            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+                            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+                            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
                             os << NOrg.num() << ",";
                         }
                         os << "]  ABO:[";
                         for (auto nit : C.mAssumedOrientOutReversed) {
-                             auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-                             auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+                             auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+                             auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
                              os << NOrg.num() << ",";
                         }
                         os << "], ";
@@ -3641,10 +3637,10 @@ void BLTree::printTree(ostream& os, node_list_it_t pr) {
                     natural = false;
                 }
                 if (C.mNodeType == BLTreeNode::LType) {
-                    auto& E = dynamic_cast<BLGraphEdge&>(*(*(C.mGraphEdge)));
-                    auto& EOrg = dynamic_cast<Edge&>(E.IGBackwardLinkRef());
-                    auto& N1 = dynamic_cast<NumNode&>(EOrg.incidentNode1());
-                    auto& N2 = dynamic_cast<NumNode&>(EOrg.incidentNode2());
+                    auto& E = downcast<BLGraphEdge>(*(*(C.mGraphEdge)));
+                    auto& EOrg = downcast<Edge>(E.IGBackwardLinkRef());
+                    auto& N1 = downcast<NumNode>(EOrg.incidentNode1());
+                    auto& N2 = downcast<NumNode>(EOrg.incidentNode2());
                     os << "L" << C.mNodeNum;
                     if (C.mGeneration == mGeneration && !C.isEmpty()) {
                         os << "*";
@@ -3666,26 +3662,26 @@ void BLTree::printTree(ostream& os, node_list_it_t pr) {
                          C.mAssumedOrientOutReversed.size()>0) {
                         os << " AFI:[";
                         for (auto nit : C.mAssumedOrientInNorm) {
-                            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-                            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+                            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+                            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
                             os << NOrg.num() << ",";
                         }
                         os << "]  ABI:[";
                         for (auto nit : C.mAssumedOrientInReversed) {
-                            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-                            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+                            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+                            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
                             os << NOrg.num() << ",";
                         }
                         os << "]  AFO:[";
                         for (auto nit : C.mAssumedOrientOutNorm) {
-                            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-                            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+                            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+                            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
                             os << NOrg.num() << ",";
                         }
                         os << "]  ABO:[";
                         for (auto nit : C.mAssumedOrientOutReversed) {
-                             auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-                             auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+                             auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+                             auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
                              os << NOrg.num() << ",";
                         }
                         os << "], ";
@@ -3730,51 +3726,51 @@ void BLTree::printTree(ostream& os, node_list_it_t pr) {
         }
         os << "]  FI:[";
         for (auto nit : N.mOrientInNorm) {
-            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
             os << NOrg.num() << ",";
         }
         os << "]  BI:[";
         for (auto nit : N.mOrientInReversed) {
-            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
             os << NOrg.num() << ",";
         }
         os << "]  FO:[";
         for (auto nit : N.mOrientOutNorm) {
-            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
             os << NOrg.num() << ",";
         }
         os << "]  BO:[";
         for (auto nit : N.mOrientOutReversed) {
-            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
             os << NOrg.num() << ",";
         }
 
         os << "]  AFI:[";
         for (auto nit : N.mAssumedOrientInNorm) {
-            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
             os << NOrg.num() << ",";
         }
         os << "]  ABI:[";
         for (auto nit : N.mAssumedOrientInReversed) {
-            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
             os << NOrg.num() << ",";
         }
         os << "]  AFO:[";
         for (auto nit : N.mAssumedOrientOutNorm) {
-            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
             os << NOrg.num() << ",";
         }
         os << "]  ABO:[";
         for (auto nit : N.mAssumedOrientOutReversed) {
-            auto& NCopy = dynamic_cast<BLGraphNode&>(*(*(nit)));
-            auto& NOrg  = dynamic_cast<NumNode&>(NCopy.IGBackwardLinkRef());
+            auto& NCopy = downcast<BLGraphNode>(*(*(nit)));
+            auto& NOrg  = downcast<NumNode>(NCopy.IGBackwardLinkRef());
             os << NOrg.num() << ",";
         }
         os << "]\n";
@@ -0,0 +1,157 @@
+#include "undirected/compact_graph.hpp"
+
+/**
+ * @file undirected/compact_graph.cpp
+ *
+ * @brief implementation of non-inline methods of CompactGraph.
+ */
+
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+void CompactGraph::build(Graph& g)
+{
+    clear();
+
+    mOriginalNodes.reserve(g.numNodes());
+    mOriginalEdges.reserve(g.numEdges());
+    mEdgeNode1.reserve(g.numEdges());
+    mEdgeNode2.reserve(g.numEdges());
+    mIncidenceOffsets.reserve(g.numNodes() + 1);
+    mIncidence.reserve(g.numEdges() * 2);
+
+    cg_index_t index = 0;
+    for (auto nit = g.nodes().first; nit != g.nodes().second; nit++) {
+        auto& N = *(*nit);
+        N.pushUtility(index++);
+        mOriginalNodes.push_back(nit);
+    }
+
+    index = 0;
+    for (auto eit = g.edges().first; eit != g.edges().second; eit++) {
+        auto& E = *(*eit);
+        E.pushUtility(index++);
+        mEdgeNode1.push_back(cg_index_t(E.incidentNode1().utility()));
+        mEdgeNode2.push_back(cg_index_t(E.incidentNode2().utility()));
+        mOriginalEdges.push_back(eit);
+    }
+
+    for (auto nit = g.nodes().first; nit != g.nodes().second; nit++) {
+        auto& N = *(*nit);
+        mIncidenceOffsets.push_back(cg_index_t(mIncidence.size()));
+        for (auto iit  = N.incidentEdges().first;
+                  iit != N.incidentEdges().second; iit++) {
+            auto& E = *(*(*iit));
+            mIncidence.push_back(cg_index_t(E.utility()));
+        }
+    }
+    mIncidenceOffsets.push_back(cg_index_t(mIncidence.size()));
+
+    g.popUtilityFromNodes();
+    g.popUtilityFromEdges();
+}
+
+
+void CompactGraph::build(
+    size_t                                    numNodes,
+    const vector<pair<cg_index_t,cg_index_t>>& edges
+) {
+    for (auto& p : edges) {
+        if (p.first >= numNodes || p.second >= numNodes) {
+            throw std::invalid_argument(Constants::kExceptionNodeNotInGraph);
+        }
+    }
+
+    clear();
+
+    mEdgeNode1.reserve(edges.size());
+    mEdgeNode2.reserve(edges.size());
+    for (auto& p : edges) {
+        mEdgeNode1.push_back(p.first);
+        mEdgeNode2.push_back(p.second);
+    }
+
+    buildIncidenceFromEdges(numNodes);
+}
+
+
+void CompactGraph::buildIncidenceFromEdges(size_t numNodes)
+{
+    // Counting sort of the edge ends by node index.
+    mIncidenceOffsets.assign(numNodes + 1, 0);
+    for (size_t e = 0; e < mEdgeNode1.size(); e++) {
+        mIncidenceOffsets[mEdgeNode1[e] + 1]++;
+        mIncidenceOffsets[mEdgeNode2[e] + 1]++;
+    }
+    for (size_t n = 0; n < numNodes; n++) {
+        mIncidenceOffsets[n + 1] += mIncidenceOffsets[n];
+    }
+
+    mIncidence.resize(mEdgeNode1.size() * 2);
+    vector<cg_index_t> fill(mIncidenceOffsets.begin(),
+                            mIncidenceOffsets.end() - 1);
+    for (size_t e = 0; e < mEdgeNode1.size(); e++) {
+        mIncidence[fill[mEdgeNode1[e]]++] = cg_index_t(e);
+        mIncidence[fill[mEdgeNode2[e]]++] = cg_index_t(e);
+    }
+}
+
+
+void CompactGraph::copyToGraph(
+    Graph&                  g,
+    vector<node_list_it_t>& nodeMap,
+    vector<edge_list_it_t>& edgeMap
+) const {
+
+    if (g.numNodes() > 0 || g.numEdges() > 0) {
+        throw std::invalid_argument(Constants::kExceptionNotEmpty);
+    }
+
+    nodeMap.clear();
+    edgeMap.clear();
+    nodeMap.reserve(numNodes());
+    edgeMap.reserve(numEdges());
+
+    for (size_t n = 0; n < numNodes(); n++) {
+        auto& N = g.addNode(make_unique<Node>());
+        nodeMap.push_back(N.backIt());
+    }
+
+    for (size_t e = 0; e < numEdges(); e++) {
+        auto& N1 = *(*(nodeMap[mEdgeNode1[e]]));
+        auto& N2 = *(*(nodeMap[mEdgeNode2[e]]));
+        auto& E  = g.addEdge(make_unique<Edge>(), N1, N2);
+        edgeMap.push_back(E.backIt());
+    }
+
+    // Restore the incidence ordering.
+    for (cg_index_t n = 0; n < numNodes(); n++) {
+        auto& N = *(*(nodeMap[n]));
+        vector<edge_list_it_t> ordered;
+        ordered.reserve(degree(n));
+        for (auto p = incidentEdges(n).first;
+                                           p != incidentEdges(n).second; p++) {
+            ordered.push_back(edgeMap[*p]);
+        }
+        N.reorderIncidence(std::move(ordered));
+    }
+}
+
+
+void CompactGraph::clear() noexcept
+{
+    mIncidenceOffsets.clear();
+    mIncidence.clear();
+    mEdgeNode1.clear();
+    mEdgeNode2.clear();
+    mOriginalNodes.clear();
+    mOriginalEdges.clear();
+}
+
+
+}// namespace Undirected
+
+}// namespace Wailea
@@ -66,6 +66,56 @@ void ConnectedDecomposer::decompose(
 
 }
 
+
+void ConnectedDecomposer::decompose(
+    const CompactGraph& g,
+    vector<vector<cg_index_t> >& nodeSets,
+    vector<vector<cg_index_t> >& edgeSets
+) {
+    nodeSets.clear();
+    edgeSets.clear();
+
+    vector<bool>       nodeVisited(g.numNodes(), false);
+    vector<bool>       edgeVisited(g.numEdges(), false);
+    vector<cg_index_t> BFSQueue;
+    BFSQueue.reserve(g.numNodes());
+
+    for (cg_index_t n = 0; n < g.numNodes(); n++) {
+
+        if (!nodeVisited[n]) {
+
+            vector<cg_index_t> nodes;
+            vector<cg_index_t> edges;
+            BFSQueue.clear();
+            BFSQueue.push_back(n);
+            nodeVisited[n] = true;
+
+            for (size_t head = 0; head < BFSQueue.size(); head++) {
+
+                auto n2 = BFSQueue[head];
+                nodes.push_back(n2);
+
+                for (auto p  = g.incidentEdges(n2).first;
+                          p != g.incidentEdges(n2).second; p++) {
+                    auto e = *p;
+                    if (!edgeVisited[e]) {
+                        edgeVisited[e] = true;
+                        edges.push_back(e);
+                    }
+                    auto a = g.adjacentNode(e, n2);
+                    if (!nodeVisited[a]) {
+                        nodeVisited[a] = true;
+                        BFSQueue.push_back(a);
+                    }
+                }
+            }
+
+            nodeSets.push_back(std::move(nodes));
+            edgeSets.push_back(std::move(edges));
+        }
+    }
+}
+
 }// namespace Undirected
 
 }// namespace Wailea
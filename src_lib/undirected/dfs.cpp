@@ -28,12 +28,12 @@ void DFSExplorer<BASE_GRAPH,BASE_NODE,BASE_EDGE>::reset(
 
     auto nodeItPair = g.nodes();
     for (auto nit = nodeItPair.first; nit != nodeItPair.second; nit++) {
-        dynamic_cast<DNode&>(*(*nit)).resetForDFS();
+        downcast<DNode>(*(*nit)).resetForDFS();
     }
 
     auto edgeItPair = g.edges();
     for (auto eit = edgeItPair.first; eit != edgeItPair.second; eit++) {
-        dynamic_cast<DEdge&>(*(*eit)).resetForDFS();
+        downcast<DEdge>(*(*eit)).resetForDFS();
     }
 
 }
@@ -51,7 +51,7 @@ void DFSExplorer<BASE_GRAPH,BASE_NODE,BASE_EDGE>::run(DNode& st) noexcept
 template <class BASE_GRAPH, class BASE_NODE, class BASE_EDGE>
 bool DFSExplorer<BASE_GRAPH,BASE_NODE,BASE_EDGE>::oneStep()
 {
-    DNode& currentNode = dynamic_cast<DNode&>(*(*mCurrentNodeIt));
+    DNode& currentNode = downcast<DNode>(*(*mCurrentNodeIt));
     if ( !currentNode.isVisited() ) {
 
          // It has just entered this node.
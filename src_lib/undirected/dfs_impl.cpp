@@ -6,7 +6,6 @@
 
 #include "undirected/bctree.hpp"
 #include "undirected/spqr_dfs_elements.hpp"
-#include "undirected/spqr_proc4.hpp"
 #include "undirected/st_numbering.hpp"
 #include "undirected/tree_path_finder.hpp"
 
@@ -74,28 +73,6 @@ template class DFSEdge    <Graph,
                            SPQR_DFS_Node,
                            SPQR_DFS_Edge  >;
 
-// Used by undirected/spqr_proc4.hpp
-template class DFSExplorer<Graph, 
-                           SPQR_PROC4_Node,
-                           SPQR_PROC4_Edge  >;
-
-template class DFSStrategy<Graph,
-                           SPQR_PROC4_Node,
-                           SPQR_PROC4_Edge  >;
-
-template class DFSGraph   <Graph,
-                           SPQR_PROC4_Node,
-                           SPQR_PROC4_Edge  >;
-
-template class DFSNode    <Graph,
-                           SPQR_PROC4_Node,
-                           SPQR_PROC4_Edge  >;
-
-template class DFSEdge    <Graph,
-                           SPQR_PROC4_Node,
-                           SPQR_PROC4_Edge  >;
-
-
 // Used by undirected/st_numbering.hpp
 template class DFSExplorer<Graph, 
                            ST_DFS_Node,
@@ -0,0 +1,308 @@
+#include "undirected/element_pool.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * @file undirected/element_pool.cpp
+ *
+ * @brief implementation of ElementPool.
+ */
+
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+namespace {
+
+/** @brief header of a free block. It overlays the first bytes of the block.
+ */
+struct FreeBlock {
+    FreeBlock* mNext;
+};
+
+
+/** @brief header at the beginning of a chunk. It takes kGranularity bytes.
+ */
+struct ChunkHeader {
+    ElementArena* mOwner; // nullptr for the chunks of the free lists.
+};
+
+
+/** @brief allocates a chunk aligned at kChunkSize and sets its owner.
+ */
+char* allocateChunk(ElementArena* owner)
+{
+    void* p = nullptr;
+    if (posix_memalign(&p, ElementPool::kChunkSize, ElementPool::kChunkSize)
+                                                                       != 0) {
+        throw bad_alloc();
+    }
+    reinterpret_cast<ChunkHeader*>(p)->mOwner = owner;
+    return static_cast<char*>(p);
+}
+
+
+/** @brief returns the header of the chunk the block is in.
+ */
+inline ChunkHeader* chunkHeader(void* p)
+{
+    auto addr = reinterpret_cast<uintptr_t>(p);
+    return reinterpret_cast<ChunkHeader*>(
+                              addr & ~uintptr_t(ElementPool::kChunkSize - 1));
+}
+
+
+/** @brief arena of the innermost ElementArena::Scope on this thread.
+ */
+thread_local ElementArena* tArena = nullptr;
+
+
+/** @brief process-wide store of the free blocks handed over by the exiting
+ *         threads.
+ *         It is never destroyed so that the blocks freed during the static
+ *         destruction can still be returned.
+ */
+class Depot {
+
+  public:
+
+    Depot():mNumChunks(0) {
+        for (size_t i = 0; i < ElementPool::kNumClasses; i++) {
+            mFree[i] = nullptr;
+        }
+    }
+
+    /** @brief pushes the list of the free blocks from head to last.
+     *         The caller must hold mMutex.
+     */
+    void push(size_t sc, FreeBlock* head, FreeBlock* last) {
+        last->mNext = mFree[sc];
+        mFree[sc]   = head;
+    }
+
+    mutex          mMutex;
+    FreeBlock*     mFree[ElementPool::kNumClasses];
+    atomic<size_t> mNumChunks;
+};
+
+
+Depot& depot()
+{
+    static Depot* d = new Depot();
+    return *d;
+}
+
+
+/** @brief set when the ThreadCache of this thread has been destroyed at the
+ *         thread exit. The blocks freed after that, e.g., by the destructors
+ *         of static objects, go directly to the depot.
+ */
+thread_local bool tCacheDestroyed = false;
+
+
+/** @brief per-thread free lists.
+ */
+class ThreadCache {
+
+  public:
+
+    ThreadCache() {
+        for (size_t i = 0; i < ElementPool::kNumClasses; i++) {
+            mFree[i] = nullptr;
+        }
+    }
+
+    /** @brief hands over all the free blocks to the depot.
+     */
+    ~ThreadCache() {
+        auto& d = depot();
+        lock_guard<mutex> lock(d.mMutex);
+        for (size_t i = 0; i < ElementPool::kNumClasses; i++) {
+            if (mFree[i] == nullptr) {
+                continue;
+            }
+            FreeBlock* last = mFree[i];
+            while (last->mNext != nullptr) {
+                last = last->mNext;
+            }
+            d.push(i, mFree[i], last);
+            mFree[i] = nullptr;
+        }
+        tCacheDestroyed = true;
+    }
+
+    /** @brief refills the free list of the given size class from the
+     *         depot, or from a new chunk if the depot is empty.
+     */
+    void refill(size_t sc) {
+
+        auto& d = depot();
+        {
+            lock_guard<mutex> lock(d.mMutex);
+            if (d.mFree[sc] != nullptr) {
+                mFree[sc]   = d.mFree[sc];
+                d.mFree[sc] = nullptr;
+                return;
+            }
+        }
+        mFree[sc] = carveChunk(sc);
+    }
+
+    /** @brief allocates a new chunk and returns the list of the blocks
+     *         of the given size class in it in the ascending order of the
+     *         address. The blocks start after the chunk header.
+     */
+    static FreeBlock* carveChunk(size_t sc) {
+
+        size_t blockSize = (sc + 1) * ElementPool::kGranularity;
+        size_t numBlocks = (ElementPool::kChunkSize - ElementPool::kGranularity)
+                                                                  / blockSize;
+        char*  chunk     = allocateChunk(nullptr) + ElementPool::kGranularity;
+        depot().mNumChunks++;
+
+        FreeBlock* head = nullptr;
+        for (size_t i = numBlocks; i > 0; i--) {
+            auto b   = reinterpret_cast<FreeBlock*>(chunk + (i-1) * blockSize);
+            b->mNext = head;
+            head     = b;
+        }
+        return head;
+    }
+
+    FreeBlock* mFree[ElementPool::kNumClasses];
+};
+
+
+thread_local ThreadCache tCache;
+
+} // namespace
+
+
+void* ElementPool::allocate(size_t size)
+{
+    if (size == 0) {
+        size = 1;
+    }
+    if (size > kMaxPooledSize) {
+        return ::operator new(size);
+    }
+
+    size_t sc = sizeClass(size);
+
+    if (tArena != nullptr) {
+        return tArena->allocate((sc + 1) * kGranularity);
+    }
+
+    if (tCacheDestroyed) {
+        auto& d = depot();
+        {
+            lock_guard<mutex> lock(d.mMutex);
+            if (d.mFree[sc] != nullptr) {
+                FreeBlock* b = d.mFree[sc];
+                d.mFree[sc]  = b->mNext;
+                return b;
+            }
+        }
+        FreeBlock* head = ThreadCache::carveChunk(sc);
+        FreeBlock* last = head;
+        while (last->mNext != nullptr) {
+            last = last->mNext;
+        }
+        lock_guard<mutex> lock(d.mMutex);
+        if (head != last) {
+            d.push(sc, head->mNext, last);
+        }
+        return head;
+    }
+
+    if (tCache.mFree[sc] == nullptr) {
+        tCache.refill(sc);
+    }
+    FreeBlock* b = tCache.mFree[sc];
+    tCache.mFree[sc] = b->mNext;
+    return b;
+}
+
+
+void ElementPool::deallocate(void* p, size_t size) noexcept
+{
+    if (p == nullptr) {
+        return;
+    }
+    if (size == 0) {
+        size = 1;
+    }
+    if (size > kMaxPooledSize) {
+        ::operator delete(p);
+        return;
+    }
+
+    if (chunkHeader(p)->mOwner != nullptr) {
+        // The arena releases it with the chunk.
+        return;
+    }
+
+    size_t sc = sizeClass(size);
+    auto   b  = static_cast<FreeBlock*>(p);
+
+    if (tCacheDestroyed) {
+        auto& d = depot();
+        lock_guard<mutex> lock(d.mMutex);
+        d.push(sc, b, b);
+        return;
+    }
+
+    b->mNext = tCache.mFree[sc];
+    tCache.mFree[sc] = b;
+}
+
+
+size_t ElementPool::numChunks() noexcept
+{
+    return depot().mNumChunks;
+}
+
+
+ElementArena::~ElementArena()
+{
+    for (auto chunk : mChunks) {
+        free(chunk);
+    }
+}
+
+
+void* ElementArena::allocate(size_t size)
+{
+    if (mCur == nullptr || size_t(mEnd - mCur) < size) {
+        mChunks.reserve(mChunks.size() + 1);
+        char* chunk = allocateChunk(this);
+        mChunks.push_back(chunk);
+        mCur = chunk + ElementPool::kGranularity;
+        mEnd = chunk + ElementPool::kChunkSize;
+    }
+    void* p = mCur;
+    mCur += size;
+    return p;
+}
+
+
+ElementArena::Scope::Scope(ElementArena& arena):mPrevious(tArena)
+{
+    tArena = &arena;
+}
+
+
+ElementArena::Scope::~Scope()
+{
+    tArena = mPrevious;
+}
+
+
+}// namespace Undirected
+
+}// namespace Wailea
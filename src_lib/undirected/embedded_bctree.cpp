@@ -1,6 +1,10 @@
 #include "undirected/embedded_bctree.hpp"
 #include "undirected/st_numbering.hpp"
 #include "undirected/bl_planarity_tester.hpp"
+#include "undirected/parallel_for.hpp"
+
+#include <algorithm>
+#include <atomic>
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -20,14 +24,14 @@ EmbeddedBCTree::EmbeddedBCTree(BCTree& tree):mTree(&tree)
     vector<pair<edge_list_it_t, edge_ptr_t> > edgePairs;
     auto nitPair = tree.nodes();
     for (auto nit = nitPair.first; nit != nitPair.second; nit++) {
-        auto& N = dynamic_cast<BCTreeNode&>(*(*nit));
+        auto& N = downcast<BCTreeNode>(*(*nit));
         auto np = make_unique<EmbeddedBCTreeNode>(N);
         nodePairs.push_back(make_pair(nit,std::move(np)));
     }
 
     auto eitPair = tree.edges();
     for (auto eit = eitPair.first; eit != eitPair.second; eit++) {
-        auto& E = dynamic_cast<BCTreeEdge&>(*(*eit));
+        auto& E = downcast<BCTreeEdge>(*(*eit));
         auto ep = make_unique<EmbeddedBCTreeEdge>(E);
         edgePairs.push_back(make_pair(eit,std::move(ep)));
     }
@@ -36,64 +40,78 @@ EmbeddedBCTree::EmbeddedBCTree(BCTree& tree):mTree(&tree)
 
     nitPair = nodes();
     for (auto nit = nitPair.first; nit != nitPair.second; nit++) {
-        auto& EBCN = dynamic_cast<EmbeddedBCTreeNode&>(*(*nit));
-        auto&  BCN = dynamic_cast<BCTreeNode&>(EBCN.IGBackwardLinkRef());
+        auto& EBCN = downcast<EmbeddedBCTreeNode>(*(*nit));
+        auto&  BCN = downcast<BCTreeNode>(EBCN.IGBackwardLinkRef());
         BCN.pushIGForwardLink(nit);
     }
 
     eitPair = edges();
     for (auto eit = eitPair.first; eit != eitPair.second; eit++) {
-        auto& EBCE = dynamic_cast<EmbeddedBCTreeEdge&>(*(*eit));
-        auto&  BCE = dynamic_cast<BCTreeEdge&>(EBCE.IGBackwardLinkRef());
+        auto& EBCE = downcast<EmbeddedBCTreeEdge>(*(*eit));
+        auto&  BCE = downcast<BCTreeEdge>(EBCE.IGBackwardLinkRef());
         BCE.pushIGForwardLink(eit);
     }
 };
 
 
-void EmbeddedBCTree::makeDefaultEmbedding()
+void EmbeddedBCTree::makeDefaultEmbedding(size_t numThreads)
 {
     // temporary mapping from BlockNode to EmbeddedNode
     vector<node_list_it_t> indexedNewNodes;
 
-    // make an embedding and a dual graph for each block.        
+    vector<node_list_it_t> blockNodes;
     for (auto nit = nodes().first; nit != nodes().second; nit++) {
-
-        auto& ETN = dynamic_cast<EmbeddedBCTreeNode&>(*(*nit));
+        auto& ETN = downcast<EmbeddedBCTreeNode>(*(*nit));
         if (ETN.type() == BCTreeNode::BlockType) {
+            blockNodes.push_back(nit);
+        }
+    }
 
-            auto& TN  = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
-            auto& B   = TN.block();
-
-            if (B.numNodes() > 2) {
-
-                auto beit = B.edges().first;
-                auto& BE = *(*beit);
-                auto& N1 = BE.incidentNode1();
-                auto& N2 = BE.incidentNode2();
-
-                vector<node_list_it_t> stNumbering;
-
-                STNumbering stMaker;
-                stNumbering = stMaker.getBipolarOrientation(B, N1, N2);
-
-                BLPlanarityTester blMaker;
-                blMaker.findEmbedding(B, stNumbering);
+    numThreads = numWorkerThreads(numThreads, blockNodes.size());
 
+    // make an embedding and a dual graph for each block.        
+    if (numThreads == 1) {
+        for (auto nit : blockNodes) {
+            embedBlock(downcast<EmbeddedBCTreeNode>(*(*nit)));
+        }
+    }
+    else {
+        // Start the biggest blocks first so that the threads finish at
+        // around the same time.
+        vector<pair<size_t, node_list_it_t>> sortedBlocks;
+        for (auto nit : blockNodes) {
+            auto& ETN = downcast<EmbeddedBCTreeNode>(*(*nit));
+            auto& B   = downcast<BCTreeNode>(ETN.IGBackwardLinkRef()).block();
+            sortedBlocks.push_back(make_pair(B.numEdges(), nit));
+        }
+        std::stable_sort(sortedBlocks.begin(), sortedBlocks.end(),
+            [](const pair<size_t, node_list_it_t>& a,
+               const pair<size_t, node_list_it_t>& b) {
+                return a.first > b.first;
+            });
+
+        std::atomic<size_t> nextBlock(0);
+        parallelFor(numThreads, [&](size_t) {
+            for (size_t i = nextBlock++; i < sortedBlocks.size();
+                                                            i = nextBlock++) {
+                embedBlock(downcast<EmbeddedBCTreeNode>(
+                                               *(*(sortedBlocks[i].second))));
             }
+        });
+    }
 
-            PlanarDualGraphMaker dualMaker;
-            dualMaker.makeDualGraph(B, ETN.embeddedGraph(), ETN.dualGraph());
+    // Link Block and EmbeddedGraph
+    for (auto nit : blockNodes) {
 
-            // Link Block and EmbeddedGraph
-            auto enPair = ETN.embeddedGraph().nodes();
-            for (auto enit = enPair.first; enit != enPair.second; enit++) {
+        auto& ETN    = downcast<EmbeddedBCTreeNode>(*(*nit));
+        auto  enPair = ETN.embeddedGraph().nodes();
+        for (auto enit = enPair.first; enit != enPair.second; enit++) {
                                       
-                auto& EN = dynamic_cast<EmbeddedNode&>(*(*enit));
-                auto& BN = dynamic_cast<BlockNode&>(EN.IGBackwardLinkRef());
+            auto& EN = downcast<EmbeddedNode>(*(*enit));
+            auto& BN = downcast<BlockNode>(EN.IGBackwardLinkRef());
 
-                BN.pushUtility(indexedNewNodes.size());
-                indexedNewNodes.push_back(enit);
-            }
+            BN.pushUtility(indexedNewNodes.size());
+            indexedNewNodes.push_back(enit);
         }
     }
 
@@ -101,18 +119,18 @@ void EmbeddedBCTree::makeDefaultEmbedding()
     // make a default unification face group for each cut vertex.
     for (auto nit = nodes().first; nit != nodes().second; nit++) {
 
-        auto& ETN = dynamic_cast<EmbeddedBCTreeNode&>(*(*nit));
+        auto& ETN = downcast<EmbeddedBCTreeNode>(*(*nit));
         if (ETN.type() == BCTreeNode::CutVertexType) {                
             UnificationGroup UG;
             auto ePair = ETN.incidentEdges();
             for (auto eit = ePair.first; eit != ePair.second; eit++) { 
-                auto& ETE      = dynamic_cast<EmbeddedBCTreeEdge&>(*(*(*eit)));
-                auto& TE       = dynamic_cast<BCTreeEdge&>(
+                auto& ETE      = downcast<EmbeddedBCTreeEdge>(*(*(*eit)));
+                auto& TE       = downcast<BCTreeEdge>(
                                                       ETE.IGBackwardLinkRef());
                 auto& BN       = TE.cutVertexInBlock();
-                auto& ETNblock = dynamic_cast<EmbeddedBCTreeNode&>(
+                auto& ETNblock = downcast<EmbeddedBCTreeNode>(
                                                         ETE.adjacentNode(ETN));
-                auto& CV = dynamic_cast<EmbeddedNode&>(
+                auto& CV = downcast<EmbeddedNode>(
                                            *(*(indexedNewNodes[BN.utility()])));
                 edge_list_it_t eCWIt, eCCWIt;
                 auto fit = findBiggestFace(CV, eCWIt, eCCWIt);
@@ -127,13 +145,13 @@ void EmbeddedBCTree::makeDefaultEmbedding()
     // Pop the utility values used above.
     for (auto nit = nodes().first; nit != nodes().second; nit++) {
 
-        auto& ETN = dynamic_cast<EmbeddedBCTreeNode&>(*(*nit));
+        auto& ETN = downcast<EmbeddedBCTreeNode>(*(*nit));
         if (ETN.type() == BCTreeNode::CutVertexType) {                
             UnificationGroup UG;
             auto ePair = ETN.incidentEdges();
             for (auto eit = ePair.first; eit != ePair.second; eit++) { 
-                auto& ETE      = dynamic_cast<EmbeddedBCTreeEdge&>(*(*(*eit)));
-                auto& TE       = dynamic_cast<BCTreeEdge&>(
+                auto& ETE      = downcast<EmbeddedBCTreeEdge>(*(*(*eit)));
+                auto& TE       = downcast<BCTreeEdge>(
                                                       ETE.IGBackwardLinkRef());
                 auto& BN       = TE.cutVertexInBlock();
                 BN.popUtility();
@@ -143,6 +161,33 @@ void EmbeddedBCTree::makeDefaultEmbedding()
 }
 
 
+void EmbeddedBCTree::embedBlock(EmbeddedBCTreeNode& ETN)
+{
+    auto& TN  = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
+    auto& B   = TN.block();
+
+    if (B.numNodes() > 2) {
+
+        auto beit = B.edges().first;
+        auto& BE = *(*beit);
+        auto& N1 = BE.incidentNode1();
+        auto& N2 = BE.incidentNode2();
+
+        vector<node_list_it_t> stNumbering;
+
+        STNumbering stMaker;
+        stNumbering = stMaker.getBipolarOrientation(B, N1, N2);
+
+        BLPlanarityTester blMaker;
+        blMaker.findEmbedding(B, stNumbering);
+
+    }
+
+    PlanarDualGraphMaker dualMaker;
+    dualMaker.makeDualGraph(B, ETN.embeddedGraph(), ETN.dualGraph());
+}
+
+
 /** @brief finds a biggest face incident to the given EmbeddedNode
  *  
  *  @param TN      (in): EmbeddedNode.
@@ -165,11 +210,11 @@ node_list_it_t EmbeddedBCTree::findBiggestFace(
 
     for (auto eit = ePair.first; eit != ePair.second; eit++) {
 
-        auto& EE = dynamic_cast<EmbeddedEdge&>(*(*(*eit)));
-        auto& DE = dynamic_cast<DualEdge&>(*(*(EE.mDualEdge)));
+        auto& EE = downcast<EmbeddedEdge>(*(*(*eit)));
+        auto& DE = downcast<DualEdge>(*(*(EE.mDualEdge)));
 
-        auto& F1 = dynamic_cast<EmbeddedFace&>(DE.incidentNode1());
-        auto& F2 = dynamic_cast<EmbeddedFace&>(DE.incidentNode2());
+        auto& F1 = downcast<EmbeddedFace>(DE.incidentNode1());
+        auto& F2 = downcast<EmbeddedFace>(DE.incidentNode2());
 
         if (maxDeg < F1.degree()) {
             maxDeg = F1.degree();
@@ -267,11 +312,11 @@ void EmbeddedBCTree::findGeometricEmbedding(
     // so that they are addressable from EmbeddedBCTreeNodes.
     for (auto nit = nodes().first; nit != nodes().second; nit++) {
 
-        auto& TN = dynamic_cast<EmbeddedBCTreeNode&>(*(*nit));
+        auto& TN = downcast<EmbeddedBCTreeNode>(*(*nit));
 
         if (TN.type() == BCTreeNode::BlockType){
             auto  expNp = make_unique<ExplorationNode>(TN);
-            auto& expN  = dynamic_cast<ExplorationNode&>(
+            auto& expN  = downcast<ExplorationNode>(
                                            mExpTree.addNode(std::move(expNp)));
             TN.pushUtility(ExpNodes.size());
             ExpNodes.push_back(expN.backIt());
@@ -279,7 +324,7 @@ void EmbeddedBCTree::findGeometricEmbedding(
         }
     }
     for (auto nit = nodes().first; nit != nodes().second; nit++) {
-        auto& TN = dynamic_cast<EmbeddedBCTreeNode&>(*(*nit));
+        auto& TN = downcast<EmbeddedBCTreeNode>(*(*nit));
         if (TN.type() == BCTreeNode::CutVertexType) {
 
             // Make back reference to unification face.
@@ -306,7 +351,7 @@ void EmbeddedBCTree::findGeometricEmbedding(
     Q.push_back(rootBlock);
     Qsize++;
 
-    auto& ETNR = dynamic_cast<EmbeddedBCTreeNode&>(*(*rootBlock));
+    auto& ETNR = downcast<EmbeddedBCTreeNode>(*(*rootBlock));
     ETNR.setOrientation(rootOuterFace, rootTopNode);
     mExpTree.setRoot(ExpNodes[ETNR.utility()]);
 
@@ -349,9 +394,9 @@ void EmbeddedBCTree::findGeometricEmbedding(
         Q.pop_front();
         Qsize--;
 
-        auto& ETN    = dynamic_cast<EmbeddedBCTreeNode&>(*(*nit));
+        auto& ETN    = downcast<EmbeddedBCTreeNode>(*(*nit));
 
-        auto& EXPN1  = dynamic_cast<ExplorationNode&>(
+        auto& EXPN1  = downcast<ExplorationNode>(
                                                 *(*(ExpNodes[ETN.utility()])));
 
         auto& UFrefs = ETN.unexploredFaces();
@@ -375,7 +420,7 @@ void EmbeddedBCTree::findGeometricEmbedding(
 
                     Qsize++;
 
-                    auto& EXPN2 = dynamic_cast<ExplorationNode&>(
+                    auto& EXPN2 = downcast<ExplorationNode>(
                                        *(*(ExpNodes[UF.treeNode().utility()])));
 
                     auto  expEp = make_unique<ExplorationEdge>();
@@ -394,7 +439,7 @@ void EmbeddedBCTree::findGeometricEmbedding(
 
     // Pop utility value from the nodes
     for (auto nit = nodes().first; nit != nodes().second; nit++) {
-        auto& TN = dynamic_cast<EmbeddedBCTreeNode&>(*(*nit));
+        auto& TN = downcast<EmbeddedBCTreeNode>(*(*nit));
         if (TN.type() == BCTreeNode::BlockType){
             TN.popUtility();
         }
@@ -403,8 +448,8 @@ void EmbeddedBCTree::findGeometricEmbedding(
     pushDefaultIGForwardLinkToNodes();
     auto nitPair = mExpTree.nodes();
     for (auto nit = nitPair.first; nit != nitPair.second; nit++) {
-        auto& expN  = dynamic_cast<ExplorationNode&>(*(*nit));
-        auto& EBCTN = dynamic_cast<EmbeddedBCTreeNode&>(
+        auto& expN  = downcast<ExplorationNode>(*(*nit));
+        auto& EBCTN = downcast<EmbeddedBCTreeNode>(
                                                      expN.IGBackwardLinkRef());
         EBCTN.setIGForwardLink(nit);
     }
@@ -422,18 +467,18 @@ void EmbeddedBCTree::findGeometricEmbedding(
         return;
     }
 
-    auto& N = dynamic_cast<EmbeddedBCTreeNode&>(*(*rootBlock));
+    auto& N = downcast<EmbeddedBCTreeNode>(*(*rootBlock));
     if ( N.dualGraph().numEdges() == 0) {
         findGeometricEmbedding(
                  rootBlock, rootOuterFace, N.embeddedGraph().nodes().first);
     }
     else {
-        auto& F    = dynamic_cast<EmbeddedFace&>(*(*rootOuterFace));
+        auto& F    = downcast<EmbeddedFace>(*(*rootOuterFace));
         /* pick the first dual edge */
-        auto& DE   = dynamic_cast<DualEdge&>(*(*(*(F.incidentEdges().first))));
-        auto& EE   = dynamic_cast<EmbeddedEdge&>(*(*(DE.mEmbeddedEdge)));
-        auto& EN1  = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-        auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
+        auto& DE   = downcast<DualEdge>(*(*(*(F.incidentEdges().first))));
+        auto& EE   = downcast<EmbeddedEdge>(*(*(DE.mEmbeddedEdge)));
+        auto& EN1  = downcast<EmbeddedNode>(EE.incidentNode1());
+        auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
         if (BN1.type()==BlockNode::OrdinaryNodeType) {
             /* pick node 1 as the top node */
             findGeometricEmbedding(
@@ -458,12 +503,12 @@ void EmbeddedBCTree::findGeometricEmbedding(
         return;
     }
 
-    auto& N = dynamic_cast<EmbeddedBCTreeNode&>(*(*rootBlock));
+    auto& N = downcast<EmbeddedBCTreeNode>(*(*rootBlock));
 
     if ( N.dualGraph().numNodes() == 0) {
 
         auto  expNp = make_unique<ExplorationNode>(N);
-        auto& expN  = dynamic_cast<ExplorationNode&>(
+        auto& expN  = downcast<ExplorationNode>(
                                            mExpTree.addNode(std::move(expNp)));
         mExpTree.setRoot(expN.backIt());
         return;
@@ -474,17 +519,17 @@ void EmbeddedBCTree::findGeometricEmbedding(
     node_list_it_t maxIt;
     size_t         maxNum = 0;
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*nit));
+        auto& F = downcast<EmbeddedFace>(*(*nit));
 
         size_t numOrdinaryNodes=0;
         auto cycleBit = F.mCycleHalfEdgesOn1.begin();
         for (auto cycleFit = F.mCycleEdges.begin();
                      cycleFit != F.mCycleEdges.end(); cycleFit++, cycleBit++) {
-            auto& EE = dynamic_cast<EmbeddedEdge&>(*(*(*cycleFit)));
+            auto& EE = downcast<EmbeddedEdge>(*(*(*cycleFit)));
             auto enit = (*cycleBit)?
                                 EE.mHalfEdge1.mSrcNode:EE.mHalfEdge2.mSrcNode;
-            auto& EN = dynamic_cast<EmbeddedNode&>(*(*enit));
-            auto& BN = dynamic_cast<BlockNode&>(EN.IGBackwardLinkRef());
+            auto& EN = downcast<EmbeddedNode>(*(*enit));
+            auto& BN = downcast<BlockNode>(EN.IGBackwardLinkRef());
             if (BN.type()==BlockNode::OrdinaryNodeType) {
                 numOrdinaryNodes++;
             }
@@ -517,11 +562,11 @@ void EmbeddedBCTree::findGeometricEmbedding()
 
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 
-        auto& N = dynamic_cast<EmbeddedBCTreeNode&>(*(*nit));
+        auto& N = downcast<EmbeddedBCTreeNode>(*(*nit));
 
         if (N.type() == BCTreeNode::BlockType) {
 
-            auto& BN = dynamic_cast<BCTreeNode&>(N.IGBackwardLinkRef());
+            auto& BN = downcast<BCTreeNode>(N.IGBackwardLinkRef());
             auto& B  = BN.block();
 
             size_t cost = B.numNodes()*3 + B.numEdges();
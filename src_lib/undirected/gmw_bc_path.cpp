@@ -30,7 +30,7 @@ void GMWBCPath::processConnectedGraph(node_list_it_t n1It, node_list_it_t n2It)
     // First check for cut vertices.
     vector<node_list_it_t> cutVertices = mBCTree.cutVertexNodes();
     for (auto nit : cutVertices) {
-        auto& TN = dynamic_cast<BCTreeNode&>(*(*nit));
+        auto& TN = downcast<BCTreeNode>(*(*nit));
         if (TN.IGBackwardLink()==n1It) {
             mTNIt1 = TN.backIt();
         }
@@ -48,12 +48,12 @@ void GMWBCPath::processConnectedGraph(node_list_it_t n1It, node_list_it_t n2It)
     // Check for block nodes.
     vector<node_list_it_t> blockVertices = mBCTree.blockNodes();
     for (auto nit : blockVertices) {
-        auto& TN = dynamic_cast<BCTreeNode&>(*(*nit));
+        auto& TN = downcast<BCTreeNode>(*(*nit));
         auto& Block = TN.block();
 
         for (auto bit = Block.nodes().first; 
                                       bit !=Block.nodes().second; bit++ ) {
-            auto& BN = dynamic_cast<BlockNode&>(*(*bit));
+            auto& BN = downcast<BlockNode>(*(*bit));
             if (mTNIt1 == mBCTree.nodes().second &&
                                               BN.IGBackwardLink() == n1It) {
                 mTNIt1  = TN.backIt();
@@ -76,8 +76,8 @@ void GMWBCPath::processConnectedGraph(node_list_it_t n1It, node_list_it_t n2It)
     }
     else {
 
-        auto& TN1 = dynamic_cast<BCTreeNode&>(*(*mTNIt1));
-        auto& TN2 = dynamic_cast<BCTreeNode&>(*(*mTNIt2));
+        auto& TN1 = downcast<BCTreeNode>(*(*mTNIt1));
+        auto& TN2 = downcast<BCTreeNode>(*(*mTNIt2));
 
         TreePathFinder finder;
         list<edge_list_it_t> bcPathEdges;
@@ -86,7 +86,7 @@ void GMWBCPath::processConnectedGraph(node_list_it_t n1It, node_list_it_t n2It)
 
         if (TN1.type() == BCTreeNode::BlockType) {
 
-            auto& E  = dynamic_cast<BCTreeEdge&>(*(*(*(bcPathEdges.begin()))));
+            auto& E  = downcast<BCTreeEdge>(*(*(*(bcPathEdges.begin()))));
             auto& BN = E.cutVertexInBlock();
             mBNIt12  = BN.backIt();
 
@@ -96,7 +96,7 @@ void GMWBCPath::processConnectedGraph(node_list_it_t n1It, node_list_it_t n2It)
 
         if (TN2.type() == BCTreeNode::BlockType) {
 
-            auto& E  =dynamic_cast<BCTreeEdge&>(*(*(*(bcPathEdges.rbegin()))));
+            auto& E  =downcast<BCTreeEdge>(*(*(*(bcPathEdges.rbegin()))));
             auto& BN = E.cutVertexInBlock();
             mBNIt21  = BN.backIt();
 
@@ -130,7 +130,7 @@ Block& GMWBCPath::getSingleBlock(
 
     n1It = mBNIt11;
     n2It = mBNIt22;
-    auto& TN = dynamic_cast<BCTreeNode&>(*(*mTNIt1));
+    auto& TN = downcast<BCTreeNode>(*(*mTNIt1));
     return TN.block();
 
 }
@@ -143,7 +143,7 @@ Block& GMWBCPath::getBlock1(
 
     n1It = mBNIt11;
     cvIt = mBNIt12;
-    auto& TN = dynamic_cast<BCTreeNode&>(*(*mTNIt1));
+    auto& TN = downcast<BCTreeNode>(*(*mTNIt1));
     return TN.block();
 
 }
@@ -156,7 +156,7 @@ Block& GMWBCPath::getBlock2(
 
     n1It = mBNIt21;
     cvIt = mBNIt22;
-    auto& TN = dynamic_cast<BCTreeNode&>(*(*mTNIt2));
+    auto& TN = downcast<BCTreeNode>(*(*mTNIt2));
     return TN.block();
 
 }
@@ -94,9 +94,9 @@ void GMWEdgeInserter::processBlock(
             BlockSkel.mSkelEit2
         );
         for (auto seit : skelEdges) {
-            auto& SE = dynamic_cast<GMWSkeletonEdge&>(*(*seit)); 
+            auto& SE = downcast<GMWSkeletonEdge>(*(*seit)); 
             if (!SE.mVirtual) {
-                auto& BE = dynamic_cast<BlockEdge&>(SE.IGBackwardLinkRef());
+                auto& BE = downcast<BlockEdge>(SE.IGBackwardLinkRef());
                 mInsertionPath.push_back(BE.IGBackwardLink());
             }
         }
@@ -18,7 +18,7 @@ void GMWSkeleton::generateSkeleton()
 {
 
     auto& aNode = *(*(*(mBlockNodes.begin())));
-    auto& B = dynamic_cast<Block&>(aNode.graph());
+    auto& B = downcast<Block>(aNode.graph());
     vector<edge_list_it_t> blockEdges = B.nodeInducedEdges(mBlockNodes);
 
     vector<pair<node_list_it_t,node_ptr_t>> nodePairs;
@@ -36,7 +36,7 @@ void GMWSkeleton::generateSkeleton()
 
         bool skipping = false;
 
-        auto& BE = dynamic_cast<BlockEdge&>(*(*eit));
+        auto& BE = downcast<BlockEdge>(*(*eit));
         auto  nit1 = BE.incidentNode1().backIt();
         auto  nit2 = BE.incidentNode2().backIt();
      
@@ -77,7 +77,7 @@ void GMWSkeleton::generateSkeleton()
 
     for (auto nit=mSkel->nodes().first; nit!=mSkel->nodes().second; nit++) {
 
-        auto &SN = dynamic_cast<GMWSkeletonNode&>(*(*nit));
+        auto &SN = downcast<GMWSkeletonNode>(*(*nit));
 
         if (SN.IGBackwardLink() == mBlockNit11) {
 
@@ -170,8 +170,8 @@ void GMWSkeletonGenerator::processBlock(
     node_list_it_t tnit1;
     node_list_it_t tnit2;
     findTreeNodesFromBlockNodes(spqrTree, bnit1, bnit2, tnit1, tnit2);
-    auto& TN1 = dynamic_cast<SPQRTreeNode&>(*(*tnit1));
-    auto& TN2 = dynamic_cast<SPQRTreeNode&>(*(*tnit2));
+    auto& TN1 = downcast<SPQRTreeNode>(*(*tnit1));
+    auto& TN2 = downcast<SPQRTreeNode>(*(*tnit2));
     // Find a path from N1 to N2 on the tree.
     TreePathFinder finder;
 
@@ -209,7 +209,7 @@ void GMWSkeletonGenerator::processBlock(
         list<edge_list_it_t>::iterator eItIt = spqrPathEdges.begin();
         for (auto nit : spqrPathNodes) {
 
-            auto& TN = dynamic_cast<SPQRTreeNode&>(*(*nit));
+            auto& TN = downcast<SPQRTreeNode>(*(*nit));
             
             if (TN.type() == SPQRTreeNode::RType) {
 
@@ -219,7 +219,7 @@ void GMWSkeletonGenerator::processBlock(
                     GMWSkeleton skel;
                     skel.mType  = GMWSkeleton::END1_NODE_END2_EDGE;
                     skel.mBlockNit11 = bnit1;
-                    auto& TE2  = dynamic_cast<SPQRTreeEdge&>(*(*(*eItIt)));
+                    auto& TE2  = downcast<SPQRTreeEdge>(*(*(*eItIt)));
                     edge_list_it_t ve2It;
                     if (TE2.incidentNode1().backIt()== nit) {
                         ve2It = TE2.virtualEdge1();
@@ -227,10 +227,10 @@ void GMWSkeletonGenerator::processBlock(
                     else {
                         ve2It = TE2.virtualEdge2();
                     }
-                    auto& VE2 = dynamic_cast<Edge&>(*(*ve2It));
-                    auto& CN2_1 = dynamic_cast<SPQRComponentNode&>(
+                    auto& VE2 = downcast<Edge>(*(*ve2It));
+                    auto& CN2_1 = downcast<SPQRComponentNode>(
                                                          VE2.incidentNode1());
-                    auto& CN2_2 = dynamic_cast<SPQRComponentNode&>(
+                    auto& CN2_2 = downcast<SPQRComponentNode>(
                                                          VE2.incidentNode2());
                     skel.mBlockNit21 = CN2_1.IGBackwardLink();
                     skel.mBlockNit22 = CN2_2.IGBackwardLink();
@@ -248,7 +248,7 @@ void GMWSkeletonGenerator::processBlock(
                     GMWSkeleton skel;
                     skel.mType  = GMWSkeleton::END1_EDGE_END2_NODE;
 
-                    auto& TE1  = dynamic_cast<SPQRTreeEdge&>(*(*(*eItIt)));
+                    auto& TE1  = downcast<SPQRTreeEdge>(*(*(*eItIt)));
                     edge_list_it_t ve1It;
                     if (TE1.incidentNode1().backIt()== nit) {
                         ve1It = TE1.virtualEdge1();
@@ -256,10 +256,10 @@ void GMWSkeletonGenerator::processBlock(
                     else {
                         ve1It = TE1.virtualEdge2();
                     }
-                    auto& VE1 = dynamic_cast<Edge&>(*(*ve1It));
-                    auto& CN1_1 = dynamic_cast<SPQRComponentNode&>(
+                    auto& VE1 = downcast<Edge>(*(*ve1It));
+                    auto& CN1_1 = downcast<SPQRComponentNode>(
                                                          VE1.incidentNode1());
-                    auto& CN1_2 = dynamic_cast<SPQRComponentNode&>(
+                    auto& CN1_2 = downcast<SPQRComponentNode>(
                                                          VE1.incidentNode2());
                     skel.mBlockNit11 = CN1_1.IGBackwardLink();
                     skel.mBlockNit12 = CN1_2.IGBackwardLink();
@@ -278,7 +278,7 @@ void GMWSkeletonGenerator::processBlock(
                     GMWSkeleton skel;
                     skel.mType  = GMWSkeleton::END1_EDGE_END2_EDGE;
 
-                    auto& TE1  = dynamic_cast<SPQRTreeEdge&>(*(*(*eItIt)));
+                    auto& TE1  = downcast<SPQRTreeEdge>(*(*(*eItIt)));
                     edge_list_it_t ve1It;
                     if (TE1.incidentNode1().backIt()== nit) {
                         ve1It = TE1.virtualEdge1();
@@ -286,16 +286,16 @@ void GMWSkeletonGenerator::processBlock(
                     else {
                         ve1It = TE1.virtualEdge2();
                     }
-                    auto& VE1 = dynamic_cast<Edge&>(*(*ve1It));
-                    auto& CN1_1 = dynamic_cast<SPQRComponentNode&>(
+                    auto& VE1 = downcast<Edge>(*(*ve1It));
+                    auto& CN1_1 = downcast<SPQRComponentNode>(
                                                          VE1.incidentNode1());
-                    auto& CN1_2 = dynamic_cast<SPQRComponentNode&>(
+                    auto& CN1_2 = downcast<SPQRComponentNode>(
                                                          VE1.incidentNode2());
                     skel.mBlockNit11 = CN1_1.IGBackwardLink();
                     skel.mBlockNit12 = CN1_2.IGBackwardLink();
     
                     eItIt++;
-                    auto& TE2  = dynamic_cast<SPQRTreeEdge&>(*(*(*eItIt)));
+                    auto& TE2  = downcast<SPQRTreeEdge>(*(*(*eItIt)));
                     edge_list_it_t ve2It;
                     if (TE2.incidentNode1().backIt()== nit) {
                         ve2It = TE2.virtualEdge1();
@@ -303,10 +303,10 @@ void GMWSkeletonGenerator::processBlock(
                     else {
                         ve2It = TE2.virtualEdge2();
                     }
-                    auto& VE2 = dynamic_cast<Edge&>(*(*ve2It));
-                    auto& CN2_1 = dynamic_cast<SPQRComponentNode&>(
+                    auto& VE2 = downcast<Edge>(*(*ve2It));
+                    auto& CN2_1 = downcast<SPQRComponentNode>(
                                                          VE2.incidentNode1());
-                    auto& CN2_2 = dynamic_cast<SPQRComponentNode&>(
+                    auto& CN2_2 = downcast<SPQRComponentNode>(
                                                          VE2.incidentNode2());
                     skel.mBlockNit21 = CN2_1.IGBackwardLink();
                     skel.mBlockNit22 = CN2_2.IGBackwardLink();
@@ -345,13 +345,13 @@ void GMWSkeletonGenerator::findTreeNodesFromBlockNodes(
 
     for (auto tnit = T.nodes().first; tnit != T.nodes().second; tnit++) {
 
-        auto& TN = dynamic_cast<SPQRTreeNode&>(*(*(tnit)));
+        auto& TN = downcast<SPQRTreeNode>(*(*(tnit)));
 
         auto& C = TN.component();
 
         for (auto cnit = C.nodes().first; cnit != C.nodes().second; cnit++ ) {
 
-            auto& CN = dynamic_cast<SPQRComponentNode&>(*(*cnit));
+            auto& CN = downcast<SPQRComponentNode>(*(*cnit));
 
             if (CN.IGBackwardLink() == bnit1) {
                 tnit1 = tnit;
@@ -377,7 +377,7 @@ void GMWSkeletonGenerator::findMinimalTreePath(
 
     for (auto tnit : treePathNodes) {
 
-        auto& TN = dynamic_cast<SPQRTreeNode&>(*(*(tnit)));
+        auto& TN = downcast<SPQRTreeNode>(*(*(tnit)));
 
         auto& C = TN.component();
 
@@ -386,7 +386,7 @@ void GMWSkeletonGenerator::findMinimalTreePath(
 
         for (auto cnit = C.nodes().first; cnit != C.nodes().second; cnit++ ) {
 
-            auto& CN = dynamic_cast<SPQRComponentNode&>(*(*cnit));
+            auto& CN = downcast<SPQRComponentNode>(*(*cnit));
 
             if (CN.IGBackwardLink() == bnit1) {
 
@@ -443,13 +443,13 @@ vector<node_list_it_t> GMWSkeletonGenerator::fromTreeNodesToSkeletonNodes(
 
     for (auto tnit : treeNodes) {
 
-        auto& TN = dynamic_cast<SPQRTreeNode&>(*(*tnit));
+        auto& TN = downcast<SPQRTreeNode>(*(*tnit));
         auto& C  = TN.component();
 
         for (auto cnit = C.nodes().first; cnit != C.nodes().second; cnit++ ) {
 
-            auto& CN = dynamic_cast<SPQRComponentNode&>(*(*cnit));
-            auto& BN = dynamic_cast<BlockNode&>(CN.IGBackwardLinkRef());
+            auto& CN = downcast<SPQRComponentNode>(*(*cnit));
+            auto& BN = downcast<BlockNode>(CN.IGBackwardLinkRef());
             BN.pushUtility(0);
 
         }
@@ -457,13 +457,13 @@ vector<node_list_it_t> GMWSkeletonGenerator::fromTreeNodesToSkeletonNodes(
 
     for (auto tnit : treeNodes) {
 
-        auto& TN = dynamic_cast<SPQRTreeNode&>(*(*tnit));
+        auto& TN = downcast<SPQRTreeNode>(*(*tnit));
         auto& C  = TN.component();
 
         for (auto cnit = C.nodes().first; cnit != C.nodes().second; cnit++ ) {
 
-            auto& CN = dynamic_cast<SPQRComponentNode&>(*(*cnit));
-            auto& BN = dynamic_cast<BlockNode&>(CN.IGBackwardLinkRef());
+            auto& CN = downcast<SPQRComponentNode>(*(*cnit));
+            auto& BN = downcast<BlockNode>(CN.IGBackwardLinkRef());
             if (BN.utility() == 0) {
                 BN.setUtility(1);
                 blockNodes.push_back(BN.backIt());
@@ -473,13 +473,13 @@ vector<node_list_it_t> GMWSkeletonGenerator::fromTreeNodesToSkeletonNodes(
 
     for (auto tnit : treeNodes) {
 
-        auto& TN = dynamic_cast<SPQRTreeNode&>(*(*tnit));
+        auto& TN = downcast<SPQRTreeNode>(*(*tnit));
         auto& C  = TN.component();
 
         for (auto cnit = C.nodes().first; cnit != C.nodes().second; cnit++ ) {
 
-            auto& CN = dynamic_cast<SPQRComponentNode&>(*(*cnit));
-            auto& BN = dynamic_cast<BlockNode&>(CN.IGBackwardLinkRef());
+            auto& CN = downcast<SPQRComponentNode>(*(*cnit));
+            auto& BN = downcast<BlockNode>(CN.IGBackwardLinkRef());
             BN.popUtility();
 
         }
@@ -506,17 +506,17 @@ bool GMWSkeletonGenerator::isVirtualEdge(
     node_list_it_t bnit1,
     node_list_it_t bnit2
 ) {
-    auto& TN = dynamic_cast<SPQRTreeNode&>(*(*tnit));
+    auto& TN = downcast<SPQRTreeNode>(*(*tnit));
     auto& C  = TN.component();
 
     for (auto ceit = C.edges().first; ceit != C.edges().second; ceit++ ) {
 
-        auto& CE  = dynamic_cast<SPQRComponentEdge&>(*(*ceit));
+        auto& CE  = downcast<SPQRComponentEdge>(*(*ceit));
         if (CE.type()==SPQRComponentEdge::VirtualType) {
-            auto& CN1 = dynamic_cast<SPQRComponentNode&>(CE.incidentNode1());
-            auto& BN1 = dynamic_cast<BlockNode&>(CN1.IGBackwardLinkRef());
-            auto& CN2 = dynamic_cast<SPQRComponentNode&>(CE.incidentNode2());
-            auto& BN2 = dynamic_cast<BlockNode&>(CN2.IGBackwardLinkRef());         
+            auto& CN1 = downcast<SPQRComponentNode>(CE.incidentNode1());
+            auto& BN1 = downcast<BlockNode>(CN1.IGBackwardLinkRef());
+            auto& CN2 = downcast<SPQRComponentNode>(CE.incidentNode2());
+            auto& BN2 = downcast<BlockNode>(CN2.IGBackwardLinkRef());         
             if ( (BN1.backIt() == bnit1 && BN2.backIt() == bnit2)||
                  (BN1.backIt() == bnit2 && BN2.backIt() == bnit1)  ) {
                 return true;
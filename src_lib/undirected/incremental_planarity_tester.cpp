@@ -0,0 +1,280 @@
+#include "undirected/incremental_planarity_tester.hpp"
+#include "undirected/spqr_decomposer.hpp"
+
+#include <limits>
+
+/**
+ * @file undirected/incremental_planarity_tester.cpp
+ *
+ * @brief online planarity test on a face-labeled embedding.
+ */
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+/** @brief face label of a side not labeled yet */
+static const size_t kNoFace = std::numeric_limits<size_t>::max();
+
+
+void IncrementalPlanarityTester::initialize(
+    Graph&                  g,
+    vector<node_list_it_t>& stOrder
+) {
+    mStOrder      = stOrder;
+    mNumFullTests = 0;
+    mEmbedded     = false;
+    mTriconnected = false;
+
+    mG = &g;
+    mEdges.clear();
+    for (auto eit = g.edges().first; eit != g.edges().second; eit++) {
+        auto& E = *(*eit);
+        E.pushUtility(mEdges.size());
+        mEdges.push_back(&E);
+    }
+    if (!embed()) {
+        cleanUp();
+        throw std::invalid_argument(
+                     ConstantsIncrementalPlanarityTester::kExceptionNotPlanar);
+    }
+}
+
+
+bool IncrementalPlanarityTester::insertEdgeIfPlanar(
+    edge_ptr_t&& e,
+    Node&        n1,
+    Node&        n2
+) {
+    if (mEmbedded) {
+        if (insertEdgeIntoCommonFace(e, n1, n2)) {
+            return true;
+        }
+        if (mTriconnected) {
+            // The embedding is unique, and n1 and n2 do not share a face.
+            return false;
+        }
+    }
+
+    mNumFullTests++;
+    auto& E = mG->addEdge(std::move(e), n1, n2);
+    E.pushUtility(mEdges.size());
+    mEdges.push_back(&E);
+    if (!embed()) {
+        // The embedding of the graph without E is kept.
+        mEdges.pop_back();
+        E.popUtility();
+        e = mG->removeEdge(E);
+        return false;
+    }
+    return true;
+}
+
+
+bool IncrementalPlanarityTester::insertEdgeIntoCommonFace(
+    edge_ptr_t& e,
+    Node&       n1,
+    Node&       n2
+) {
+    // Find a face that has both n1 and n2 on it.
+    mStamp++;
+    for (auto iit  = n1.incidentEdges().first;
+              iit != n1.incidentEdges().second; iit++) {
+        mFaceStamps[mFaces[halfEdge(*(*(*iit)), n1)]] = mStamp;
+    }
+
+    size_t face = kNoFace;
+    size_t h2   = 0;
+    for (auto iit  = n2.incidentEdges().first;
+              iit != n2.incidentEdges().second; iit++) {
+        size_t h = halfEdge(*(*(*iit)), n2);
+        if (mFaceStamps[mFaces[h]] == mStamp) {
+            face = mFaces[h];
+            h2   = h;
+            break;
+        }
+    }
+
+    if (face == kNoFace) {
+        return false;
+    }
+
+    size_t h1 = 0;
+    for (auto iit  = n1.incidentEdges().first;
+              iit != n1.incidentEdges().second; iit++) {
+        size_t h = halfEdge(*(*(*iit)), n1);
+        if (mFaces[h] == face) {
+            h1 = h;
+            break;
+        }
+    }
+
+    auto& E = mG->addEdge(std::move(e), n1, n2);
+    E.pushUtility(mEdges.size());
+    mEdges.push_back(&E);
+    mFaces.push_back(face);
+    mFaces.push_back(face);
+    mNext.resize(mFaces.size());
+    mPrev.resize(mFaces.size());
+
+    // The side of the face that goes out of a node through h follows the
+    // one that comes in before h in the rotation. The new edge is put
+    // between them at n1 and at n2.
+    insertIntoRotation(2 * E.utility(),     h1);
+    insertIntoRotation(2 * E.utility() + 1, h2);
+    splitFace(E);
+    return true;
+}
+
+
+void IncrementalPlanarityTester::insertIntoRotation(size_t h, size_t hNext)
+{
+    size_t hPrev  = mPrev[hNext];
+    mNext[hPrev]  = h;
+    mPrev[h]      = hPrev;
+    mNext[h]      = hNext;
+    mPrev[hNext]  = h;
+}
+
+
+void IncrementalPlanarityTester::cleanUp()
+{
+    for (auto* E : mEdges) {
+        E->popUtility();
+    }
+    mEdges.clear();
+    mFaces.clear();
+    mNext.clear();
+    mPrev.clear();
+    mFaceStamps.clear();
+    mNumFaces     = 0;
+    mEmbedded     = false;
+    mTriconnected = false;
+    mG            = nullptr;
+}
+
+
+bool IncrementalPlanarityTester::embed()
+{
+    // findEmbedding() rearranges the incident edges of the nodes. The
+    // embedding is taken into mNext and mPrev, and the original order is
+    // put back.
+    vector<vector<edge_list_it_t>> incidences;
+    incidences.reserve(mG->numNodes());
+    for (auto nit = mG->nodes().first; nit != mG->nodes().second; nit++) {
+        auto& N = *(*nit);
+        vector<edge_list_it_t> edges;
+        edges.reserve(N.degree());
+        for (auto iit  = N.incidentEdges().first;
+                  iit != N.incidentEdges().second; iit++) {
+            edges.push_back(*iit);
+        }
+        incidences.push_back(std::move(edges));
+    }
+
+    bool planar = mTester.findEmbedding(*mG, mStOrder);
+    if (!planar) {
+        size_t index = 0;
+        for (auto nit = mG->nodes().first; nit != mG->nodes().second; nit++) {
+            (*(*nit)).reorderIncidence(std::move(incidences[index++]));
+        }
+        return false;
+    }
+
+    mEmbedded     = false;
+    mTriconnected = false;
+
+    mNext.assign(2 * mEdges.size(), 0);
+    mPrev.assign(2 * mEdges.size(), 0);
+    size_t index = 0;
+    for (auto nit = mG->nodes().first; nit != mG->nodes().second; nit++) {
+        auto&  N      = *(*nit);
+        auto   iit    = N.incidentEdges().first;
+        size_t hFirst = halfEdge(*(*(*iit)), N);
+        size_t hPrev  = hFirst;
+        for (iit++; iit != N.incidentEdges().second; iit++) {
+            size_t h = halfEdge(*(*(*iit)), N);
+            mNext[hPrev] = h;
+            mPrev[h]     = hPrev;
+            hPrev        = h;
+        }
+        mNext[hPrev]  = hFirst;
+        mPrev[hFirst] = hPrev;
+        N.reorderIncidence(std::move(incidences[index++]));
+    }
+    labelAllFaces();
+
+    // The rotations are a planar embedding only if Euler's formula holds
+    // for the faces found.
+    if (mG->numNodes() + mNumFaces != mEdges.size() + 2) {
+        return true;
+    }
+    mEmbedded = true;
+
+    // The graph is triconnected if its SPQR tree is a single R node.
+    // The decomposer pushes a utility and a forward link to each edge of
+    // the graph, and they are popped here.
+    if (mG->numNodes() >= 4) {
+        SPQRDecomposer decomposer;
+        {
+            SPQRTree spqrTree = decomposer.decompose(
+                                             *mG, *(*(mG->nodes().first)));
+            mTriconnected = (spqrTree.numNodes() == 1 &&
+                             spqrTree.RTypeNodes().size() == 1);
+        }
+        for (auto* E : mEdges) {
+            E->popUtility();
+            E->popIGForwardLink();
+        }
+    }
+    return true;
+}
+
+
+void IncrementalPlanarityTester::labelAllFaces()
+{
+    mFaces.assign(2 * mEdges.size(), kNoFace);
+    mNumFaces = 0;
+    for (size_t h = 0; h < mFaces.size(); h++) {
+        if (mFaces[h] != kNoFace) {
+            continue;
+        }
+        size_t hCur = h;
+        do {
+            mFaces[hCur] = mNumFaces;
+            hCur = nextHalfEdge(hCur);
+        } while (hCur != h);
+        mNumFaces++;
+    }
+    mFaceStamps.assign(mNumFaces, 0);
+    mStamp = 0;
+}
+
+
+void IncrementalPlanarityTester::splitFace(Edge& e)
+{
+    // Walk the two new faces alternately from the two sides of e, and
+    // give a new label to the one that ends first.
+    size_t h1 = 2 * e.utility();
+    size_t h2 = h1 + 1;
+    size_t c1 = nextHalfEdge(h1);
+    size_t c2 = nextHalfEdge(h2);
+    while (c1 != h1 && c2 != h2) {
+        c1 = nextHalfEdge(c1);
+        c2 = nextHalfEdge(c2);
+    }
+
+    size_t hStart = (c1 == h1) ? h1 : h2;
+    size_t hCur   = hStart;
+    do {
+        mFaces[hCur] = mNumFaces;
+        hCur = nextHalfEdge(hCur);
+    } while (hCur != hStart);
+    mNumFaces++;
+    mFaceStamps.push_back(0);
+}
+
+}// namespace Undirected
+
+}// namespace Wailea
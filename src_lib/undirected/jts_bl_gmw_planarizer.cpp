@@ -4,6 +4,8 @@
 #include "undirected/jts_planarizer.hpp"
 #include "undirected/gmw_edge_inserter.hpp"
 #include "undirected/bl_planarity_tester.hpp"
+#include "undirected/incremental_planarity_tester.hpp"
+#include "undirected/parallel_for.hpp"
 
 /**
  * @file undirected/jts_bl_gmw_planarizer.cpp
@@ -85,24 +87,32 @@ void JTS_BL_GMW_Planarizer::planarizeConnectedGraph(
     BCTree bcTree = decomposer.decompose(G);
 
     // Planarize all the blocks
-    vector<PlanarizableGraph> planarizedBlocks;
-
+    vector<node_list_it_t> blockNodes;
     for (auto tnit = bcTree.nodes().first; 
                                        tnit != bcTree.nodes().second; tnit++) {
-        auto& TN = dynamic_cast<BCTreeNode&>(*(*tnit));
-
+        auto& TN = downcast<BCTreeNode>(*(*tnit));
         if (TN.type() == BCTreeNode::BlockType) {
-            PlanarizableGraph planarizedBlock;
-            planarizeBiconnectedGraph(TN.block(), planarizedBlock);
-            planarizedBlocks.push_back(std::move(planarizedBlock));
+            blockNodes.push_back(tnit);
         }
     }
+    vector<PlanarizableGraph> planarizedBlocks(blockNodes.size());
+
+    // Each block is an independent graph, and the worker threads only
+    // touch the block and its planarized copy.
+    size_t numThreads = numWorkerThreads(mNumBlockThreads, blockNodes.size());
+    parallelFor(numThreads, [&](size_t t) {
+        for (size_t i = t; i < blockNodes.size(); i += numThreads) {
+            auto& TN = downcast<BCTreeNode>(*(*blockNodes[i]));
+            planarizeBiconnectedGraph(TN.block(), planarizedBlocks[i]);
+        }
+    });
+
     // Fill planarizedG with non-virtual nodes.
     for (auto gnit = G.nodes().first; gnit != G.nodes().second; gnit++) {
 
         auto& GN   = *(*gnit);
         auto  plnp = make_unique<PlanarizableNode>();
-        auto& PLN  = dynamic_cast<PlanarizableNode&>(
+        auto& PLN  = downcast<PlanarizableNode>(
                                          planarizedG.addNode(std::move(plnp)));
 
         PLN.pushIGBackwardLink(gnit);
@@ -115,11 +125,11 @@ void JTS_BL_GMW_Planarizer::planarizeConnectedGraph(
         for (auto snit = planarizedBlock.nodes().first; 
                               snit != planarizedBlock.nodes().second; snit++) {
 
-            auto& SN = dynamic_cast<PlanarizableNode&>(*(*snit));
+            auto& SN = downcast<PlanarizableNode>(*(*snit));
 
             if (SN.isVirtual()) {
                 auto  plnp = make_unique<PlanarizableNode>();
-                auto& PLN  = dynamic_cast<PlanarizableNode&>(
+                auto& PLN  = downcast<PlanarizableNode>(
                                          planarizedG.addNode(std::move(plnp)));
                 PLN.pushIGBackwardLink(snit);
                 PLN.setVirtual(true);
@@ -132,19 +142,19 @@ void JTS_BL_GMW_Planarizer::planarizeConnectedGraph(
         for (auto seit = planarizedBlock.edges().first; 
                               seit != planarizedBlock.edges().second; seit++) {
 
-            auto& SE  = dynamic_cast<PlanarizableEdge&>(*(*seit));
-            auto& SN1 = dynamic_cast<PlanarizableNode&>(SE.incidentNode1());
-            auto& SN2 = dynamic_cast<PlanarizableNode&>(SE.incidentNode2());
+            auto& SE  = downcast<PlanarizableEdge>(*(*seit));
+            auto& SN1 = downcast<PlanarizableNode>(SE.incidentNode1());
+            auto& SN2 = downcast<PlanarizableNode>(SE.incidentNode2());
 
             auto& PLN1 = findNodeInPlanarizedG(SN1);
             auto& PLN2 = findNodeInPlanarizedG(SN2);
 
             auto  plep = make_unique<PlanarizableEdge>();
-            auto& PLE  = dynamic_cast<PlanarizableEdge&>(
+            auto& PLE  = downcast<PlanarizableEdge>(
                              planarizedG.addEdge(std::move(plep), PLN1, PLN2));
 
-            auto& BE = dynamic_cast<BlockEdge&>(SE.IGBackwardLinkRef());
-            auto& GE = dynamic_cast<Edge&>(BE.IGBackwardLinkRef());
+            auto& BE = downcast<BlockEdge>(SE.IGBackwardLinkRef());
+            auto& GE = downcast<Edge>(BE.IGBackwardLinkRef());
 
             GE.pushIGForwardLink(PLE.backIt());
             PLE.pushIGBackwardLink(GE.backIt());
@@ -157,17 +167,17 @@ void JTS_BL_GMW_Planarizer::planarizeConnectedGraph(
         for (auto seit = planarizedBlock.edges().first; 
                               seit != planarizedBlock.edges().second; seit++) {
 
-            auto& SE  = dynamic_cast<PlanarizableEdge&>(*(*seit));
+            auto& SE  = downcast<PlanarizableEdge>(*(*seit));
 
-            auto& PLE = dynamic_cast<PlanarizableEdge&>(
+            auto& PLE = downcast<PlanarizableEdge>(
                                                        SE.IGBackwardLinkRef());
 
             if (!SE.isTerminalN1()){
 
                 if (SE.chainN1() != planarizedBlock.edges().second) {
-                    auto& SChainN1 = dynamic_cast<PlanarizableEdge&>(
+                    auto& SChainN1 = downcast<PlanarizableEdge>(
                                                            *(*(SE.chainN1())));
-                    auto& PLChainN1 = dynamic_cast<PlanarizableEdge&>(
+                    auto& PLChainN1 = downcast<PlanarizableEdge>(
                                                  SChainN1.IGBackwardLinkRef());
                     PLE.setChainN1(PLChainN1.backIt());
                 }
@@ -178,10 +188,10 @@ void JTS_BL_GMW_Planarizer::planarizeConnectedGraph(
 
                 if (SE.chainN2() != planarizedBlock.edges().second) {
 
-                    auto& SChainN2 = dynamic_cast<PlanarizableEdge&>(
+                    auto& SChainN2 = downcast<PlanarizableEdge>(
                                                            *(*(SE.chainN2())));
 
-                    auto& PLChainN2 = dynamic_cast<PlanarizableEdge&>(
+                    auto& PLChainN2 = downcast<PlanarizableEdge>(
                                                  SChainN2.IGBackwardLinkRef());
 
                     PLE.setChainN2(PLChainN2.backIt());
@@ -198,7 +208,7 @@ void JTS_BL_GMW_Planarizer::planarizeConnectedGraph(
     // Cleanup the inter-graph links in planarizedG
     for(auto plnit = planarizedG.nodes().first;
                                 plnit != planarizedG.nodes().second; plnit++) {
-        auto& PLN = dynamic_cast<PlanarizableNode&>(*(*plnit));
+        auto& PLN = downcast<PlanarizableNode>(*(*plnit));
         if(PLN.isVirtual()){
             PLN.setIGBackwardLink(planarizedG.nodes().second);
         }
@@ -207,7 +217,7 @@ void JTS_BL_GMW_Planarizer::planarizeConnectedGraph(
     // Cleanup the inter-graph links in G
     for(auto gnit = G.nodes().first; gnit != G.nodes().second; gnit++) {
 
-        auto& GN = dynamic_cast<Node&>(*(*gnit));
+        auto& GN = downcast<Node>(*(*gnit));
 
         auto lit = GN.popIGForwardLink();
 
@@ -219,7 +229,7 @@ void JTS_BL_GMW_Planarizer::planarizeConnectedGraph(
 
     for(auto geit = G.edges().first; geit != G.edges().second; geit++) {
                                 
-        auto& GE = dynamic_cast<Edge&>(*(*geit));
+        auto& GE = downcast<Edge>(*(*geit));
         auto lit = GE.popIGForwardLink();
         GE.setIGForwardLink(lit);
     }
@@ -232,9 +242,9 @@ void JTS_BL_GMW_Planarizer::planarizeConnectedGraph(
 PlanarizableEdge& JTS_BL_GMW_Planarizer::findEdgeInPlanarizedG(
     PlanarizableEdge& E
 ) {
-    auto& BE = dynamic_cast<BlockEdge&>(E.IGBackwardLinkRef());
-    auto& GE = dynamic_cast<Edge&>(BE.IGBackwardLinkRef());
-    return dynamic_cast<PlanarizableEdge&>(GE.IGForwardLinkRef());
+    auto& BE = downcast<BlockEdge>(E.IGBackwardLinkRef());
+    auto& GE = downcast<Edge>(BE.IGBackwardLinkRef());
+    return downcast<PlanarizableEdge>(GE.IGForwardLinkRef());
 }
 
 
@@ -244,13 +254,13 @@ PlanarizableNode& JTS_BL_GMW_Planarizer::findNodeInPlanarizedG(
     PlanarizableNode& N
 ) {
     if (N.isVirtual()) {
-        return dynamic_cast<PlanarizableNode&>(N.IGForwardLinkRef());
+        return downcast<PlanarizableNode>(N.IGForwardLinkRef());
     }
     else {
         // BN is a BlockNode in the Block
-        auto& BN = dynamic_cast<BlockNode&>(N.IGBackwardLinkRef());
-        auto& GN = dynamic_cast<Node&>(BN.IGBackwardLinkRef());
-        return dynamic_cast<PlanarizableNode&>(GN.IGForwardLinkRef());
+        auto& BN = downcast<BlockNode>(N.IGBackwardLinkRef());
+        auto& GN = downcast<Node>(BN.IGBackwardLinkRef());
+        return downcast<PlanarizableNode>(GN.IGForwardLinkRef());
     }
 }
 
@@ -284,9 +294,9 @@ void JTS_BL_GMW_Planarizer::findPlanarSubgraph(
     vector<node_list_it_t> stOrder;
     auto bnit = G.nodes().first;
     if (G.numNodes() >=2) {
-        auto& S = dynamic_cast<Node&>(*(*(bnit)));
+        auto& S = downcast<Node>(*(*(bnit)));
         bnit++;
-        auto& T = dynamic_cast<Node&>(*(*(bnit)));
+        auto& T = downcast<Node>(*(*(bnit)));
         stOrder = st.getBipolarOrientation(G, S, T);
     }
     else if (G.numNodes() == 2) {
@@ -327,49 +337,47 @@ void JTS_BL_GMW_Planarizer::maximalizePlanarSubgraph(
 
     // Recreate st-ordering on the biconnected planar-subgraph.
     auto bnit = G.nodes().first;
-    auto& S = dynamic_cast<Node&>(*(*(bnit))).IGForwardLinkRef();
+    auto& S = downcast<Node>(*(*(bnit))).IGForwardLinkRef();
     bnit++;
-    auto& T = dynamic_cast<Node&>(*(*(bnit))).IGForwardLinkRef();
+    auto& T = downcast<Node>(*(*(bnit))).IGForwardLinkRef();
     STNumbering st;
     vector<node_list_it_t> stOrder = st.getBipolarOrientation(
                                                          planarSubgraph, S, T);
 
-    // For each removed edge, try inserting.
-    vector<edge_list_it_t> removedEdgesUpdated;
+    // Try inserting the removed edges in the original order with the
+    // online planarity test.
+    // Once planarSubgraph has 3|V|-6 edges, it is maximal planar and no
+    // further test is necessary.
+    vector<edge_list_it_t>     removedEdgesUpdated;
+    IncrementalPlanarityTester tester;
+    tester.initialize(planarSubgraph, stOrder);
+    size_t maxNumEdges = 3 * planarSubgraph.numNodes() - 6;
 
     for (auto eit : removedEdges) {
 
-        auto& Eorg  = dynamic_cast<Edge&>(*(*eit));
-        auto& N1org = Eorg.incidentNode1();
-        auto& N2org = Eorg.incidentNode2();
-        auto& N1new = dynamic_cast<PlanarizableNode&>(
-                                                     N1org.IGForwardLinkRef());
-        auto& N2new = dynamic_cast<PlanarizableNode&>(
-                                                     N2org.IGForwardLinkRef());
-        auto  ep    = make_unique<PlanarizableEdge>();
-        auto& Etry  = dynamic_cast<PlanarizableEdge&>(
-                               planarSubgraph.addEdge(move(ep), N1new, N2new));
-
-        BLPlanarityTester bl;
-
-        bool isPlanar = bl.isPlanar(planarSubgraph, stOrder);
+        if (planarSubgraph.numEdges() >= maxNumEdges) {
+            removedEdgesUpdated.push_back(eit);
+            continue;
+        }
 
-        if (isPlanar) {
+        auto& Eorg  = downcast<Edge>(*(*eit));
+        auto& N1new = downcast<PlanarizableNode>(
+                                       Eorg.incidentNode1().IGForwardLinkRef());
+        auto& N2new = downcast<PlanarizableNode>(
+                                       Eorg.incidentNode2().IGForwardLinkRef());
+        auto  ep    = make_unique<PlanarizableEdge>();
+        auto& Etry  = *ep;
 
-            // Insersion successful.
-            // Make Etry a proper edge in planarSubgraph.
+        if (tester.insertEdgeIfPlanar(std::move(ep), N1new, N2new)) {
             Etry.pushIGBackwardLink(eit);
             Eorg.setIGForwardLink(Etry.backIt());
             Eorg.setUtility(JTSPlanarizer::kForwardTypeInPlanarSubgraph);
         }
         else {
-
-            // Insersion unsucessful. Remove the tried edge from planarSubgraph
-            planarSubgraph.removeEdge(Etry);
             removedEdgesUpdated.push_back(eit);
         }
-
     }
+    tester.cleanUp();
 
     removedEdges = std::move(removedEdgesUpdated);
 
@@ -383,16 +391,32 @@ void JTS_BL_GMW_Planarizer::reinsertRemovedEdges(
 ) {
 
     for (auto eit2 = planarSubgraph.edges().first; eit2 != planarSubgraph.edges().second; eit2++) {
-        auto& E  = dynamic_cast<PlanarizableEdge&>(*(*eit2));
+        auto& E  = downcast<PlanarizableEdge>(*(*eit2));
         E.mChainN1 = planarSubgraph.edges().second;
         E.mChainN2 = planarSubgraph.edges().second;
     }
 
+    if (mInsertionMode == SPECULATIVE_BATCH && removedEdges.size() > 1 &&
+        planarSubgraph.numNodes() >= 3                                    ) {
+
+        // The planarity test of the batch requires planarSubgraph to be
+        // biconnected.
+        BiconnectedDecomposer bd;
+        BCTree tree = bd.decompose(planarSubgraph);
+
+        if (tree.blockNodes().size()    == 1 &&
+            tree.cutVertexNodes().size() == 0   ) {
+
+            reinsertRemovedEdgesSpeculatively(planarSubgraph, removedEdges);
+            return;
+        }
+    }
+
     for (auto eit : removedEdges) {
-        auto& E  = dynamic_cast<Edge&>(*(*eit));
-        auto& N1 = dynamic_cast<PlanarizableNode&>(
+        auto& E  = downcast<Edge>(*(*eit));
+        auto& N1 = downcast<PlanarizableNode>(
                                          E.incidentNode1().IGForwardLinkRef());
-        auto& N2 = dynamic_cast<PlanarizableNode&>(
+        auto& N2 = downcast<PlanarizableNode>(
                                          E.incidentNode2().IGForwardLinkRef());
         GMWEdgeInserter inserter;
         inserter.findInsertionPath(planarSubgraph, N1, N2);
@@ -403,6 +427,227 @@ void JTS_BL_GMW_Planarizer::reinsertRemovedEdges(
     }
 }
 
+
+void JTS_BL_GMW_Planarizer::reinsertRemovedEdgesSpeculatively(
+    PlanarizableGraph&      planarSubgraph,
+    vector<edge_list_it_t>& removedEdges
+) {
+    vector<edge_list_it_t> pending = removedEdges;
+
+    while (pending.size() > 0) {
+
+        size_t batchEnd = std::min(mBatchSize, pending.size());
+
+        // Number the nodes of planarSubgraph for the snapshots.
+        vector<node_list_it_t> nodeIts;
+        for (auto nit  = planarSubgraph.nodes().first;
+                  nit != planarSubgraph.nodes().second; nit++) {
+            (*nit)->pushUtility(nodeIts.size());
+            nodeIts.push_back(nit);
+        }
+
+        vector<list<edge_list_it_t>> paths = findInsertionPathsInParallel(
+                               planarSubgraph, nodeIts, pending, 0, batchEnd);
+
+        // Pick the candidates whose crossed edges are disjoint from those
+        // of the preceding candidates.
+        // The utility of a crossed edge is the 1-based candidate index.
+        planarSubgraph.pushDefaultUtilityToEdges();
+
+        vector<size_t>                      candidates;
+        vector<pair<size_t,size_t>>         endPoints;
+        vector<const list<edge_list_it_t>*> candidatePaths;
+
+        for (size_t i = 0; i < batchEnd; i++) {
+
+            bool disjoint = true;
+            for (auto eit : paths[i]) {
+                if ((*eit)->utility() != 0) {
+                    disjoint = false;
+                    break;
+                }
+            }
+            if (!disjoint) {
+                continue;
+            }
+            for (auto eit : paths[i]) {
+                (*eit)->setUtility(candidates.size() + 1);
+            }
+            auto& Eorg = downcast<Edge>(*(*pending[i]));
+            endPoints.push_back(make_pair(
+                            Eorg.incidentNode1().IGForwardLinkRef().utility(),
+                            Eorg.incidentNode2().IGForwardLinkRef().utility()));
+            candidatePaths.push_back(&(paths[i]));
+            candidates.push_back(i);
+        }
+
+        // Find the longest prefix of the candidates that can be inserted
+        // together. The first one alone is always planar.
+        size_t numInserted = candidates.size();
+        if (numInserted > 1 && !isPlanarWithInsertions(
+                 planarSubgraph, endPoints, candidatePaths, numInserted)) {
+
+            size_t low  = 1;
+            size_t high = numInserted - 1;
+            while (low < high) {
+                size_t mid = (low + high + 1) / 2;
+                if (isPlanarWithInsertions(
+                           planarSubgraph, endPoints, candidatePaths, mid)) {
+                    low  = mid;
+                }
+                else {
+                    high = mid - 1;
+                }
+            }
+            numInserted = low;
+        }
+
+        planarSubgraph.popUtilityFromEdges();
+        planarSubgraph.popUtilityFromNodes();
+
+        // Insert the prefix. The paths do not share edges, and hence
+        // splitting the edges on one path does not invalidate the others.
+        vector<bool> inserted(batchEnd, false);
+        for (size_t j = 0; j < numInserted; j++) {
+
+            size_t i   = candidates[j];
+            auto   eit = pending[i];
+            auto&  E   = downcast<Edge>(*(*eit));
+            auto&  N1  = downcast<PlanarizableNode>(
+                                         E.incidentNode1().IGForwardLinkRef());
+            auto&  N2  = downcast<PlanarizableNode>(
+                                         E.incidentNode2().IGForwardLinkRef());
+            vector<edge_ptr_t> splitEdges =
+                              planarSubgraph.insertEdge(paths[i], N1, N2, eit);
+            splitEdges.clear();
+            inserted[i] = true;
+        }
+
+        // Retry the rest in the next round in the original order.
+        vector<edge_list_it_t> pendingUpdated;
+        for (size_t i = 0; i < batchEnd; i++) {
+            if (!inserted[i]) {
+                pendingUpdated.push_back(pending[i]);
+            }
+        }
+        pendingUpdated.insert(pendingUpdated.end(),
+                                          pending.begin() + batchEnd, pending.end());
+        pending = std::move(pendingUpdated);
+    }
+}
+
+
+vector<list<edge_list_it_t>>
+JTS_BL_GMW_Planarizer::findInsertionPathsInParallel(
+    PlanarizableGraph&      planarSubgraph,
+    vector<node_list_it_t>& nodeIts,
+    vector<edge_list_it_t>& removedEdges,
+    size_t                  begin,
+    size_t                  end
+) {
+    size_t numThreads = numWorkerThreads(mNumThreads, end - begin);
+
+    vector<list<edge_list_it_t>> paths(end - begin);
+
+    // The worker threads only read planarSubgraph and G. Each of them
+    // makes its own snapshot, as GMWEdgeInserter modifies the inter-graph
+    // links and the utility values of the input graph.
+    parallelFor(numThreads, [&](size_t t) {
+
+        Graph                  snapshot;
+        vector<node_list_it_t> snapshotNodeIts;
+
+        for (size_t i = 0; i < nodeIts.size(); i++) {
+            auto& SN = snapshot.addNode(make_unique<Node>());
+            snapshotNodeIts.push_back(SN.backIt());
+        }
+        for (auto eit  = planarSubgraph.edges().first;
+                  eit != planarSubgraph.edges().second; eit++) {
+            auto& E   = *(*eit);
+            auto& SN1 = *(*snapshotNodeIts[E.incidentNode1().utility()]);
+            auto& SN2 = *(*snapshotNodeIts[E.incidentNode2().utility()]);
+            auto& SE  = snapshot.addEdge(make_unique<Edge>(), SN1, SN2);
+            SE.pushIGBackwardLink(eit);
+        }
+
+        for (size_t i = begin + t; i < end; i += numThreads) {
+
+            auto& Eorg = *(*removedEdges[i]);
+            auto& SN1  = *(*snapshotNodeIts[
+                         Eorg.incidentNode1().IGForwardLinkRef().utility()]);
+            auto& SN2  = *(*snapshotNodeIts[
+                         Eorg.incidentNode2().IGForwardLinkRef().utility()]);
+
+            GMWEdgeInserter inserter;
+            inserter.findInsertionPath(snapshot, SN1, SN2);
+            for (auto seit : inserter.getPath()) {
+                paths[i - begin].push_back((*seit)->IGBackwardLink());
+            }
+        }
+    });
+
+    return paths;
+}
+
+
+bool JTS_BL_GMW_Planarizer::isPlanarWithInsertions(
+    PlanarizableGraph&                   planarSubgraph,
+    vector<pair<size_t,size_t>>&         endPoints,
+    vector<const list<edge_list_it_t>*>& paths,
+    size_t                               numInsertions
+) {
+    Graph                  T;
+    vector<node_list_it_t> tNodeIts;
+
+    for (auto nit  = planarSubgraph.nodes().first;
+              nit != planarSubgraph.nodes().second; nit++) {
+        auto& TN = T.addNode(make_unique<Node>());
+        tNodeIts.push_back(TN.backIt());
+    }
+
+    // The edges that are not crossed.
+    for (auto eit  = planarSubgraph.edges().first;
+              eit != planarSubgraph.edges().second; eit++) {
+        auto& E = *(*eit);
+        if (E.utility() >= 1 && E.utility() <= numInsertions) {
+            continue;
+        }
+        T.addEdge(make_unique<Edge>(),
+                  *(*tNodeIts[E.incidentNode1().utility()]),
+                  *(*tNodeIts[E.incidentNode2().utility()]));
+    }
+
+    // The crossed edges are split by the virtual nodes, which are chained
+    // from N1 to N2 of each insertion.
+    for (size_t i = 0; i < numInsertions; i++) {
+
+        Node* prev = &(*(*tNodeIts[endPoints[i].first]));
+
+        for (auto eit : *(paths[i])) {
+            auto& E = *(*eit);
+            auto& V = T.addNode(make_unique<Node>());
+            T.addEdge(make_unique<Edge>(),
+                      *(*tNodeIts[E.incidentNode1().utility()]), V);
+            T.addEdge(make_unique<Edge>(),
+                      V, *(*tNodeIts[E.incidentNode2().utility()]));
+            T.addEdge(make_unique<Edge>(), *prev, V);
+            prev = &V;
+        }
+        T.addEdge(make_unique<Edge>(),
+                  *prev, *(*tNodeIts[endPoints[i].second]));
+    }
+
+    auto  tnit = T.nodes().first;
+    auto& S    = *(*tnit);
+    tnit++;
+    auto& D    = *(*tnit);
+
+    STNumbering            st;
+    vector<node_list_it_t> stOrder = st.getBipolarOrientation(T, S, D);
+    BLPlanarityTester      bl;
+    return bl.isPlanar(T, stOrder);
+}
+
 }// namespace Undirected
 
 }// namespace Wailea
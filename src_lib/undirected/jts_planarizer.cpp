@@ -53,6 +53,7 @@ void JTSPlanarizer::findUpwardPlanarSingleSourceSubgraph(
     vector<edge_list_it_t>& removedEdges
 ) {
 
+    ElementArena           arena;
     JTSGraph               graphCopy;
     vector<node_list_it_t> stOrderCopy;
     JTSTree                pqTree;
@@ -64,7 +65,10 @@ void JTSPlanarizer::findUpwardPlanarSingleSourceSubgraph(
         return;
     }
 
-    copyInputGraph(g, stOrder, graphCopy, stOrderCopy, pqTree);
+    {
+        ElementArena::Scope scope(arena);
+        copyInputGraph(g, stOrder, graphCopy, stOrderCopy, pqTree);
+    }
 
     node_list_it_t attachmentNode = pqTree.makeInitialAttachmentP();
 
@@ -72,7 +76,7 @@ void JTSPlanarizer::findUpwardPlanarSingleSourceSubgraph(
 
     for (auto nit : stOrderCopy ) {
 
-        auto& n = dynamic_cast<JTSGraphNode&>(*(*nit));
+        auto& n = downcast<JTSGraphNode>(*(*nit));
 
 //cerr << "\n\nIteration: " << index << "\n";
 
@@ -181,12 +185,12 @@ void JTSPlanarizer::copyInputGraph(
 
     for (auto nit = dst.nodes().first; nit != dst.nodes().second; nit++) {
 
-        auto& n = dynamic_cast<JTSGraphNode&>(*(*nit));
+        auto& n = downcast<JTSGraphNode>(*(*nit));
         stOrderDst[n.mStNumber] = nit;
         for (auto iit = n.incidentEdges().first;
                                       iit != n.incidentEdges().second; iit++) {
-            auto& e = dynamic_cast<JTSGraphEdge&>(*(*(*iit)));
-            auto& a = dynamic_cast<JTSGraphNode&>(e.adjacentNode(n));
+            auto& e = downcast<JTSGraphEdge>(*(*(*iit)));
+            auto& a = downcast<JTSGraphNode>(e.adjacentNode(n));
             if (n.mStNumber < a.mStNumber) {
                 n.mOutgoingEdges.push_back(e.backIt());
             }
@@ -209,7 +213,7 @@ vector<node_list_it_t> JTSPlanarizer::fromGraphEdgesToPQLeaves(
 
     for(auto eit : edgeList) {
 
-        auto& e = dynamic_cast<JTSGraphEdge&>(*(*eit));
+        auto& e = downcast<JTSGraphEdge>(*(*eit));
 
         if (!e.mRemoved) {
 
@@ -348,7 +352,7 @@ void JTSPlanarizer::removeNonconsecutiveNodes(
 
     for (auto eIt : graphEdges) {
 
-        auto& E = dynamic_cast<JTSGraphEdge&>(*(*eIt));
+        auto& E = downcast<JTSGraphEdge>(*(*eIt));
 
         if (!E.mRemoved) {
 
@@ -614,13 +618,13 @@ void JTSPlanarizer::makePlanarSubgraphAndRemovedEdges(
 
     auto nitPair = internalGraph.nodes();
     for (auto nit = nitPair.first; nit != nitPair.second; nit++) {
-        auto& N = dynamic_cast<JTSGraphNode&>(*(*nit));
+        auto& N = downcast<JTSGraphNode>(*(*nit));
         nodeList.push_back(N.IGBackwardLink());
     }
 
     auto eitPair = internalGraph.edges();
     for (auto eit = eitPair.first; eit != eitPair.second; eit++) {
-        auto& E = dynamic_cast<JTSGraphEdge&>(*(*eit));
+        auto& E = downcast<JTSGraphEdge>(*(*eit));
         if (E.mRemoved) {
             removedEdges.push_back(E.IGBackwardLink());
             E.IGBackwardLinkRef().pushUtility(kForwardTypeRemoved);
@@ -653,7 +657,7 @@ void JTSPlanarizer::handlek0tok4(
 
     auto eitPair = originalGraph.edges();
     for (auto eit = eitPair.first; eit != eitPair.second; eit++) {
-        auto& E = dynamic_cast<Edge&>(*(*eit));
+        auto& E = downcast<Edge>(*(*eit));
         E.pushUtility(kForwardTypeInPlanarSubgraph);
         edgeList.push_back(eit);
     }
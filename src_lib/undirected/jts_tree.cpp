@@ -93,7 +93,7 @@ void JTSTree::transferContentsOfOnlyChildAndRemove(JTSTreeNode& X)
     X.mPartialChild2          = C.mPartialChild2;
     X.mCDPartialChild         = C.mCDPartialChild;
     if (X.mNodeType == JTSTreeNode::LType) {
-        auto& E = dynamic_cast<JTSGraphEdge&>(*(*(X.mGraphEdge)));
+        auto& E = downcast<JTSGraphEdge>(*(*(X.mGraphEdge)));
         E.mPQLeaf = X.backIt();
     }
     removeNode(C);
@@ -1220,7 +1220,7 @@ void JTSTree::fanOutLeavesFromAttachment(
     list<edge_list_it_t>& edgeList
 ) {
     if (edgeList.size()==1) {
-        auto& E = dynamic_cast<JTSGraphEdge&>(*(*(*edgeList.begin())));
+        auto& E = downcast<JTSGraphEdge>(*(*(*edgeList.begin())));
 
         A.mNodeType  = JTSTreeNode::LType;
         A.mGraphEdge = E.backIt();
@@ -1231,7 +1231,7 @@ void JTSTree::fanOutLeavesFromAttachment(
     else {
         for(auto eIt : edgeList) {
 
-            auto& E = dynamic_cast<JTSGraphEdge&>(*(*eIt));
+            auto& E = downcast<JTSGraphEdge>(*(*eIt));
 
             auto  np  = make_unique<JTSTreeNode>(*this);
             auto  nIt = addNode(std::move(np)).backIt();
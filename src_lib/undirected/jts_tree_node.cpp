@@ -1024,10 +1024,10 @@ void JTSTreeNode::printNode(JTSTree& tree, ostream& os) {
     os << this->mNodeNum ;
 
     if (mNodeType==LType) {
-        auto& E = dynamic_cast<JTSGraphEdge&>(*(*(mGraphEdge)));
-        auto& OE = dynamic_cast<Edge&>(E.IGBackwardLinkRef());
-        auto& N1 = dynamic_cast<NumNode&>(OE.incidentNode1());
-        auto& N2 = dynamic_cast<NumNode&>(OE.incidentNode2());
+        auto& E = downcast<JTSGraphEdge>(*(*(mGraphEdge)));
+        auto& OE = downcast<Edge>(E.IGBackwardLinkRef());
+        auto& N1 = downcast<NumNode>(OE.incidentNode1());
+        auto& N2 = downcast<NumNode>(OE.incidentNode2());
         os << " {" << N1.num() << "," << N2.num() << "}";
         if (E.mPQLeaf != backIt()) {
             os << "    Graph Edge's mPQLeaf does not match!\n";
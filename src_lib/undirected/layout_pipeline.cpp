@@ -0,0 +1,213 @@
+#include "undirected/layout_pipeline.hpp"
+#include "undirected/bctree.hpp"
+#include "undirected/embedded_bctree.hpp"
+#include "undirected/planar_dual_graph_maker.hpp"
+#include "undirected/jts_bl_gmw_planarizer.hpp"
+
+/**
+ * @file undirected/layout_pipeline.cpp
+ *
+ * @brief implementation of LayoutPipeline.
+ */
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+
+void LayoutPipeline::layout(VRRectLabelGraph& G, VRRectLabelGraph& LG)
+{
+    layout(G, LG, G.nodes().second);
+}
+
+
+void LayoutPipeline::layout(
+    VRRectLabelGraph& G,
+    VRRectLabelGraph& LG,
+    node_list_it_t    topNode
+) {
+    if (LG.numNodes() > 0) {
+        throw std::invalid_argument(Constants::kExceptionNotEmpty);
+    }
+    LG.setHorizontalGap(G.horizontalGap());
+    LG.setVerticalGap(G.verticalGap());
+
+    if (G.numNodes() > 0) {
+        PlanarizableGraph      PG;
+        JTS_BL_GMW_Planarizer  planarizer;
+        planarizer.setNumBlockThreads(mNumThreads);
+        planarizer.planarizeConnectedGraph(G, PG);
+        copyPlanarizedGraph(G, PG, LG);
+    }
+
+    BiconnectedDecomposer decomposer;
+    BCTree                bcTree = decomposer.decompose(LG);
+    EmbeddedBCTree        ebcTree(bcTree);
+    ebcTree.makeDefaultEmbedding(mNumThreads);
+
+    // Find the largest block that contains the top node.
+    node_list_it_t rootBlock = ebcTree.nodes().second;
+    node_list_it_t rootTop;
+    if (topNode != G.nodes().second) {
+        auto   LNtopIt = (*topNode)->IGForwardLink();
+        size_t maxCost = 0;
+        for (auto tnit = ebcTree.nodes().first;
+                                      tnit != ebcTree.nodes().second; tnit++) {
+            auto& ETN = downcast<EmbeddedBCTreeNode>(*(*tnit));
+            if (ETN.type() != BCTreeNode::BlockType) {
+                continue;
+            }
+            auto& B    = downcast<BCTreeNode>(ETN.IGBackwardLinkRef()).block();
+            auto  cost = B.numNodes() * 3 + B.numEdges();
+            auto& EG   = ETN.embeddedGraph();
+            for (auto enit = EG.nodes().first; enit != EG.nodes().second;
+                                                                     enit++) {
+                auto& BN = downcast<BlockNode>((*enit)->IGBackwardLinkRef());
+                if (BN.IGBackwardLink() == LNtopIt && maxCost < cost) {
+                    maxCost   = cost;
+                    rootBlock = tnit;
+                    rootTop   = enit;
+                }
+            }
+        }
+    }
+
+    if (rootBlock == ebcTree.nodes().second) {
+        ebcTree.findGeometricEmbedding();
+    }
+    else if (downcast<EmbeddedBCTreeNode>(*(*rootBlock)).dualGraph().
+                                                            numEdges() == 0) {
+        ebcTree.findGeometricEmbedding(rootBlock);
+    }
+    else {
+        // Pick the biggest face incident to the top node as the outer face.
+        auto&          EN     = downcast<EmbeddedNode>(*(*rootTop));
+        size_t         maxDeg = 0;
+        node_list_it_t outerFace;
+        for (auto iit = EN.incidentEdges().first;
+                                      iit != EN.incidentEdges().second; iit++) {
+            auto& EE = downcast<EmbeddedEdge>(*(*(*iit)));
+            auto& DE = downcast<DualEdge>(*(*(EE.mDualEdge)));
+            for (auto* F : { &DE.incidentNode1(), &DE.incidentNode2() }) {
+                if (maxDeg < F->degree()) {
+                    maxDeg    = F->degree();
+                    outerFace = F->backIt();
+                }
+            }
+        }
+        ebcTree.findGeometricEmbedding(rootBlock, outerFace, rootTop);
+    }
+
+    VisRepFinder finder(ebcTree);
+    if (mNumThreads != 1) {
+        finder.setExecutionMode(VisRepFinder::PARALLEL, mNumThreads);
+    }
+    finder.find();
+}
+
+
+void LayoutPipeline::copyPlanarizedGraph(
+    VRRectLabelGraph&  G,
+    PlanarizableGraph& PG,
+    VRRectLabelGraph&  LG
+) {
+    for (auto pnit = PG.nodes().first; pnit != PG.nodes().second; pnit++) {
+
+        auto& PN = downcast<PlanarizableNode>(*(*pnit));
+        if (PN.isVirtual()) {
+            auto  lnp = make_unique<VRRectLabelNode>(
+                            G.horizontalGap() * 2.0, G.verticalGap() * 2.0);
+            auto& LN  = downcast<VRRectLabelNode>(LG.addNode(std::move(lnp)));
+            LN.setVirtual(true);
+            LN.pushIGBackwardLink(G.nodes().second);
+            PN.pushIGForwardLink(LN.backIt());
+        }
+        else {
+            auto& GN  = downcast<VRRectLabelNode>(PN.IGBackwardLinkRef());
+            auto  lnp = make_unique<VRRectLabelNode>(GN.width(), GN.height());
+            auto& LN  = downcast<VRRectLabelNode>(LG.addNode(std::move(lnp)));
+            LN.setVirtual(false);
+            LN.pushIGBackwardLink(GN.backIt());
+            GN.setIGForwardLink(LN.backIt());
+            PN.pushIGForwardLink(LN.backIt());
+        }
+    }
+
+    // Walk each chain from the terminal for node 1 of the original edge.
+    vector<node_list_it_t> chainNodes;
+    for (auto peit = PG.edges().first; peit != PG.edges().second; peit++) {
+
+        auto& PE  = downcast<PlanarizableEdge>(*(*peit));
+        auto& GE  = downcast<VRRectLabelEdge>(PE.IGBackwardLinkRef());
+        auto  GN1 = GE.incidentNode1().backIt();
+
+        auto isTerminalFor = [&](Node& N) {
+            auto& PN = downcast<PlanarizableNode>(N);
+            return !PN.isVirtual() && PN.IGBackwardLink() == GN1;
+        };
+
+        node_list_it_t cur;
+        if (PE.isTerminalN1() && isTerminalFor(PE.incidentNode1())) {
+            cur = PE.incidentNode1().backIt();
+        }
+        else if (PE.isTerminalN2() && isTerminalFor(PE.incidentNode2())) {
+            cur = PE.incidentNode2().backIt();
+        }
+        else {
+            continue;
+        }
+
+        chainNodes.clear();
+        chainNodes.push_back(cur);
+        auto seit = peit;
+        while (true) {
+            auto& SE     = downcast<PlanarizableEdge>(*(*seit));
+            bool  fromN1 = (SE.incidentNode1().backIt() == cur);
+            cur = SE.adjacentNode(*(*cur)).backIt();
+            chainNodes.push_back(cur);
+            if (fromN1 ? SE.isTerminalN2() : SE.isTerminalN1()) {
+                break;
+            }
+            seit = fromN1 ? SE.chainN2() : SE.chainN1();
+        }
+
+        size_t numEdges = chainNodes.size() - 1;
+        size_t middle   = (numEdges - 1) / 2;
+        auto   prevIt   = LG.edges().second;
+        for (size_t i = 0; i < numEdges; i++) {
+
+            auto& LN1 = downcast<VRRectLabelNode>(
+                                          (*chainNodes[i])->IGForwardLinkRef());
+            auto& LN2 = downcast<VRRectLabelNode>(
+                                        (*chainNodes[i+1])->IGForwardLinkRef());
+            auto  lep = make_unique<VRRectLabelEdge>();
+            auto& LE  = downcast<VRRectLabelEdge>(
+                                     LG.addEdge(std::move(lep), LN1, LN2));
+            if (i == 0) {
+                LE.setLabelNode1Side(
+                       GE.typeNode1(), GE.widthNode1(), GE.heightNode1());
+                GE.setIGForwardLink(LE.backIt());
+            }
+            if (i == middle) {
+                LE.setLabelMiddle(
+                       GE.typeMiddle(), GE.widthMiddle(), GE.heightMiddle());
+            }
+            if (i == numEdges - 1) {
+                LE.setLabelNode2Side(
+                       GE.typeNode2(), GE.widthNode2(), GE.heightNode2());
+            }
+            LE.pushIGBackwardLink(GE.backIt());
+            if (prevIt != LG.edges().second) {
+                downcast<VRRectLabelEdge>(*(*prevIt)).setChainN2(LE.backIt());
+                LE.setChainN1(prevIt);
+            }
+            prevIt = LE.backIt();
+        }
+    }
+}
+
+
+}// namespace Undirected
+
+}// namespace Wailea
@@ -65,7 +65,7 @@ void PlanarDualGraphMaker::copyInputGraph(
 
     for (auto eit = emb.edges().first; eit != emb.edges().second; eit++) {
 
-        auto& E  = dynamic_cast<EmbeddedEdge&>(*(*eit));
+        auto& E  = downcast<EmbeddedEdge>(*(*eit));
         auto& N1 = E.incidentNode1();
         auto& N2 = E.incidentNode2();
 
@@ -93,7 +93,7 @@ list<node_list_it_t> PlanarDualGraphMaker::initializeUnprocessedQueues(
 
     for (auto nit = emb.nodes().first; nit != emb.nodes().second; nit++) {
 
-        auto& N = dynamic_cast<EmbeddedNode&>(*(*nit));
+        auto& N = downcast<EmbeddedNode>(*(*nit));
 
 
         /** Place the node into 'pending' queue.
@@ -110,7 +110,7 @@ list<node_list_it_t> PlanarDualGraphMaker::initializeUnprocessedQueues(
             for (auto eit = N.incidentEdges().first;
                                      eit != N.incidentEdges().second; eit++) {
 
-                auto& E   = dynamic_cast<EmbeddedEdge&>(*(*(*eit)));
+                auto& E   = downcast<EmbeddedEdge>(*(*(*eit)));
 
                 auto& he1 = E.mHalfEdge1;
                 auto& he2 = E.mHalfEdge2;
@@ -144,17 +144,17 @@ void PlanarDualGraphMaker::findFaces(
     while (nodesPending.size() > 0) {
 
         // Find an unprocessed node.
-        auto& N = dynamic_cast<EmbeddedNode&>(*(*(*(nodesPending.begin()))));
+        auto& N = downcast<EmbeddedNode>(*(*(*(nodesPending.begin()))));
 
         while (N.mEdgesPending.size() > 0 ) {
 
 
             // Find an unprocessed halfedge
 
-            auto& E   = dynamic_cast<EmbeddedEdge&>(
+            auto& E   = downcast<EmbeddedEdge>(
                                             *(*(*(N.mEdgesPending.begin()))));
 
-            auto& AN  = dynamic_cast<EmbeddedNode&>(E.adjacentNode(N));
+            auto& AN  = downcast<EmbeddedNode>(E.adjacentNode(N));
 
             /** The initial edge with adjacent nodes look like the following:
              *
@@ -192,11 +192,11 @@ void PlanarDualGraphMaker::findFaces(
             // Explore the half edges and form a face cycle
             while (sit != N.backIt()) {
 
-                auto& S  = dynamic_cast<EmbeddedNode&>(*(*sit));
-                auto& E  = dynamic_cast<EmbeddedEdge&>(*(*eit));
+                auto& S  = downcast<EmbeddedNode>(*(*sit));
+                auto& E  = downcast<EmbeddedEdge>(*(*eit));
 #ifdef UNIT_TESTS
                 if (nodeMap.find(&S)!=nodeMap.end()) {
-                    auto& N = dynamic_cast<NumNode&>(S.IGBackwardLinkRef());
+                    auto& N = downcast<NumNode>(S.IGBackwardLinkRef());
                     cerr << "!!! ERROR: Duplicate node [" << N.num()
                          << "] found during dual graph generation. !!!\n";
 //                    mDupFound = true;
@@ -242,7 +242,7 @@ void PlanarDualGraphMaker::makeOneFace(
     list<edge_list_it_t>&& cycleEdges,
     list<bool>&&           cycleHalfEdgesOn1
 ) {
-    auto& F = dynamic_cast<EmbeddedFace&>(
+    auto& F = downcast<EmbeddedFace>(
                                     dual.addNode(make_unique<EmbeddedFace>()));
 
     auto ceIt       = cycleEdges.begin();
@@ -252,13 +252,13 @@ void PlanarDualGraphMaker::makeOneFace(
 
     for (; ceIt != cycleEdges.end(); ceIt++,cheIt++) {
 
-        auto& E  = dynamic_cast<EmbeddedEdge&>(*(*(*ceIt)));
+        auto& E  = downcast<EmbeddedEdge>(*(*(*ceIt)));
         auto& HE = (*cheIt)?E.mHalfEdge1:E.mHalfEdge2;
         HE.mEmbeddedFace = F.backIt();
 
         if (ceIt != cycleEdges.begin()) {
 
-            auto& Eprev = dynamic_cast<EmbeddedEdge&>(*(*(*ceItPrev)));
+            auto& Eprev = downcast<EmbeddedEdge>(*(*(*ceItPrev)));
             auto& HEprev = (*cheItPrev)?Eprev.mHalfEdge1:Eprev.mHalfEdge2;
 
             HE.mPrevEdge = Eprev.backIt();
@@ -273,9 +273,9 @@ void PlanarDualGraphMaker::makeOneFace(
 
     ceIt  = cycleEdges.begin();
     cheIt = cycleHalfEdgesOn1.begin();
-    auto& E  = dynamic_cast<EmbeddedEdge&>(*(*(*ceIt)));
+    auto& E  = downcast<EmbeddedEdge>(*(*(*ceIt)));
     auto& HE = (*cheIt)?E.mHalfEdge1:E.mHalfEdge2;
-    auto& Eprev = dynamic_cast<EmbeddedEdge&>(*(*(*ceItPrev)));
+    auto& Eprev = downcast<EmbeddedEdge>(*(*(*ceItPrev)));
     auto& HEprev = (*cheItPrev)?Eprev.mHalfEdge1:Eprev.mHalfEdge2;
 
     HE.mPrevEdge = Eprev.backIt();
@@ -296,8 +296,8 @@ void PlanarDualGraphMaker::findNextHalfEdge(
     node_list_it_t&  dit    // (io): destination node pointer
 ) {
 
-    auto& E  = dynamic_cast<EmbeddedEdge&>(*(*eit));
-    auto& D  = dynamic_cast<EmbeddedNode&>(*(*dit));
+    auto& E  = downcast<EmbeddedEdge>(*(*eit));
+    auto& D  = downcast<EmbeddedNode>(*(*dit));
 
     node_incidence_it_t iit;
 
@@ -318,9 +318,9 @@ void PlanarDualGraphMaker::findNextHalfEdge(
 
     auto& Snext = D;
 
-    auto& Enext = dynamic_cast<EmbeddedEdge&>(*(*(*(iit))));
+    auto& Enext = downcast<EmbeddedEdge>(*(*(*(iit))));
 
-    auto& Dnext = dynamic_cast<EmbeddedNode&>(Enext.adjacentNode(Snext));
+    auto& Dnext = downcast<EmbeddedNode>(Enext.adjacentNode(Snext));
 
     HEOn1 = Enext.mHalfEdge1.mSrcNode == Snext.backIt();
 
@@ -341,13 +341,13 @@ void PlanarDualGraphMaker::findDualEdges(
      */
     for (auto eIt = emb.edges().first; eIt != emb.edges().second; eIt++) {
 
-        auto& E   = dynamic_cast<EmbeddedEdge&>(*(*eIt));
+        auto& E   = downcast<EmbeddedEdge>(*(*eIt));
         auto& HE1 = E.mHalfEdge1;
         auto& HE2 = E.mHalfEdge2;
-        auto& F1  = dynamic_cast<EmbeddedFace&>(*(*HE1.mEmbeddedFace));
-        auto& F2  = dynamic_cast<EmbeddedFace&>(*(*HE2.mEmbeddedFace));
+        auto& F1  = downcast<EmbeddedFace>(*(*HE1.mEmbeddedFace));
+        auto& F2  = downcast<EmbeddedFace>(*(*HE2.mEmbeddedFace));
 
-        auto& DE  = dynamic_cast<DualEdge&>(
+        auto& DE  = downcast<DualEdge>(
                      dual.addEdge(make_unique<DualEdge>(), F1, F2));
         E.mDualEdge = DE.backIt();
         DE.mEmbeddedEdge = E.backIt();
@@ -360,13 +360,13 @@ void PlanarDualGraphMaker::findDualEdges(
      */
     for (auto fIt = dual.nodes().first; fIt != dual.nodes().second; fIt++) {
 
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*fIt));
+        auto& F = downcast<EmbeddedFace>(*(*fIt));
 
         list<edge_list_it_t> orderedDualEdges;
 
         for (auto eIt : F.mCycleEdges) {
 
-            auto& E = dynamic_cast<EmbeddedEdge&>(*(*eIt));
+            auto& E = downcast<EmbeddedEdge>(*(*eIt));
             orderedDualEdges.push_back(E.mDualEdge);
 
         }
@@ -383,12 +383,12 @@ void PlanarDualGraphMaker::makeForwardLinks(
 ) {
 
     for (auto nit = emb.nodes().first; nit != emb.nodes().second; nit++) {
-        auto& N = dynamic_cast<EmbeddedNode&>(*(*nit));
+        auto& N = downcast<EmbeddedNode>(*(*nit));
         N.IGBackwardLinkRef().pushIGForwardLink(nit);
     }
 
     for (auto eit = emb.edges().first; eit != emb.edges().second; eit++) {
-        auto& EE = dynamic_cast<EmbeddedEdge&>(*(*eit));
+        auto& EE = downcast<EmbeddedEdge>(*(*eit));
         EE.IGBackwardLinkRef().pushIGForwardLink(eit);
     }
 
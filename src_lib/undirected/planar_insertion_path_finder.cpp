@@ -64,18 +64,18 @@ list<edge_list_it_t> PlanarInsertionPathFinder::findInsertionPath(
 
 //    for (auto tmpIt1 = mGemb.nodes().first; 
 //                                tmpIt1 != mGemb.nodes().second;tmpIt1++ ) {
-//        auto& N  = dynamic_cast<EmbeddedNode&>(*(*tmpIt1));
-//        auto& SN = dynamic_cast<GMWSkeletonNode&>(*(*(N.IGBackwardLink())));
-//        auto& BN = dynamic_cast<BlockNode&>(*(*(SN.IGBackwardLink())));
-//        auto& ON = dynamic_cast<NumNode&>(*(*(BN.IGBackwardLink())));
+//        auto& N  = downcast<EmbeddedNode>(*(*tmpIt1));
+//        auto& SN = downcast<GMWSkeletonNode>(*(*(N.IGBackwardLink())));
+//        auto& BN = downcast<BlockNode>(*(*(SN.IGBackwardLink())));
+//        auto& ON = downcast<NumNode>(*(*(BN.IGBackwardLink())));
 //        cerr << "N: " << ON.num() << ": ";
 //        for (auto tmpIt2 = N.incidentEdges().first ;
 //                   tmpIt2 != N.incidentEdges().second; tmpIt2++) {
-//            auto& E = dynamic_cast<EmbeddedEdge&>(*(**(tmpIt2)));
-//            auto& AN = dynamic_cast<EmbeddedNode&>(E.adjacentNode(N));
-//            auto& SAN = dynamic_cast<GMWSkeletonNode&>(*(*(AN.IGBackwardLink())));
-//            auto& BAN = dynamic_cast<BlockNode&>(*(*(SAN.IGBackwardLink())));
-//            auto& OAN = dynamic_cast<NumNode&>(*(*(BAN.IGBackwardLink())));
+//            auto& E = downcast<EmbeddedEdge>(*(**(tmpIt2)));
+//            auto& AN = downcast<EmbeddedNode>(E.adjacentNode(N));
+//            auto& SAN = downcast<GMWSkeletonNode>(*(*(AN.IGBackwardLink())));
+//            auto& BAN = downcast<BlockNode>(*(*(SAN.IGBackwardLink())));
+//            auto& OAN = downcast<NumNode>(*(*(BAN.IGBackwardLink())));
 //            cerr << "AN: " << OAN.num() << " ";
 //        }
 //        cerr << "\n";
@@ -87,7 +87,7 @@ list<edge_list_it_t> PlanarInsertionPathFinder::findInsertionPath(
     if (nIt1 != mG.nodes().second|| nIt2 != mG.nodes().second) {
         for (auto nit = mGemb.nodes().first;
                                         nit != mGemb.nodes().second; nit++ ) {
-            auto& EN = dynamic_cast<EmbeddedNode&>(*(*nit));
+            auto& EN = downcast<EmbeddedNode>(*(*nit));
             if (EN.IGBackwardLink() == nIt1) {
                 NembIt1 = nit;
             }
@@ -102,7 +102,7 @@ list<edge_list_it_t> PlanarInsertionPathFinder::findInsertionPath(
     if (eIt1 != mG.edges().second|| eIt2 != mG.edges().second) {
         for (auto eit = mGemb.edges().first;
                                          eit != mGemb.edges().second; eit++ ) {
-            auto& EE = dynamic_cast<EmbeddedEdge&>(*(*eit));
+            auto& EE = downcast<EmbeddedEdge>(*(*eit));
             if (EE.IGBackwardLink() == eIt1) {
                 EembIt1 = eit;
             }
@@ -144,17 +144,17 @@ list<edge_list_it_t> PlanarInsertionPathFinder::performDijkstra(
     edge_list_it_t nullIt = mGdual.edges().second;
     for (auto nit = mGdual.nodes().first;
                                         nit != mGdual.nodes().second; nit++ ) {
-        auto& N = dynamic_cast<EmbeddedFace&>(*(*nit));
+        auto& N = downcast<EmbeddedFace>(*(*nit));
 
         distances.push_back(std::numeric_limits<utility_t>::max());
         backPointers.push_back(nullIt);
         N.pushUtility(index++);
 //        cerr << "F"  << N.utility() << ": [";
 //        for (auto tit : N.mCycleEdges) {
-//            auto& E = dynamic_cast<EmbeddedEdge&>(*(*tit));
-//            auto& OE = dynamic_cast<Edge&>(*(*(E.mOriginal)));
-//            auto& N1 = dynamic_cast<NumNode&>(OE.incidentNode1());
-//            auto& N2 = dynamic_cast<NumNode&>(OE.incidentNode2());
+//            auto& E = downcast<EmbeddedEdge>(*(*tit));
+//            auto& OE = downcast<Edge>(*(*(E.mOriginal)));
+//            auto& N1 = downcast<NumNode>(OE.incidentNode1());
+//            auto& N2 = downcast<NumNode>(OE.incidentNode2());
 //            cerr << "{" << N1.num() << "," << N2.num() << "} ";
 //        }
 //        cerr << "]\n";        
@@ -164,7 +164,7 @@ list<edge_list_it_t> PlanarInsertionPathFinder::performDijkstra(
     list<node_list_it_t> Q;
     for (auto fit : faces1) {
 
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& F = downcast<EmbeddedFace>(*(*fit));
 //        cerr << "init: " << F.utility() << "\n";
         distances[F.utility()] = 0;
         Q.push_back(fit);
@@ -173,7 +173,7 @@ list<edge_list_it_t> PlanarInsertionPathFinder::performDijkstra(
 
     while (Q.size()>0) {
 
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*(*(Q.begin()))));
+        auto& F = downcast<EmbeddedFace>(*(*(*(Q.begin()))));
 //        cerr << "loop F: " << F.utility() << " dist: "
 //                           << distances[F.utility()] << "\n";
 
@@ -181,12 +181,12 @@ list<edge_list_it_t> PlanarInsertionPathFinder::performDijkstra(
 
         for (auto deit = F.incidentEdges().first; 
                                    deit != F.incidentEdges().second; deit++ ) {
-            auto& DE = dynamic_cast<DualEdge&>(*(*(*deit)));
-            auto& AF = dynamic_cast<EmbeddedFace&>(DE.adjacentNode(F));
+            auto& DE = downcast<DualEdge>(*(*(*deit)));
+            auto& AF = downcast<EmbeddedFace>(DE.adjacentNode(F));
 
-//            auto& OE = dynamic_cast<Edge&>(*(*(DE.mOriginal)));
-//            auto& N1 = dynamic_cast<NumNode&>(OE.incidentNode1());
-//            auto& N2 = dynamic_cast<NumNode&>(OE.incidentNode2());
+//            auto& OE = downcast<Edge>(*(*(DE.mOriginal)));
+//            auto& N1 = downcast<NumNode>(OE.incidentNode1());
+//            auto& N2 = downcast<NumNode>(OE.incidentNode2());
 //            cerr << "{" << N1.num() << "," << N2.num() << "} ";
 
 //            cerr << "AF: " << AF.utility() << " dist: "
@@ -216,7 +216,7 @@ list<edge_list_it_t> PlanarInsertionPathFinder::performDijkstra(
 
     for (auto fit : faces2) {
 
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& F = downcast<EmbeddedFace>(*(*fit));
 //        cerr << "m: " << F.utility() << "\n";
 //        cerr << "cur_min: " << cur_min << "\n";
 //        cerr << "distance: " << distances[F.utility()] << "\n";
@@ -234,16 +234,16 @@ list<edge_list_it_t> PlanarInsertionPathFinder::performDijkstra(
     // using backPointers.
     while (cur_eit != nullIt) {
 
-        auto& F  = dynamic_cast<EmbeddedFace&>(*(*cur_fit));
+        auto& F  = downcast<EmbeddedFace>(*(*cur_fit));
 //cerr << "f: " << F.utility() ;
-        auto& DE = dynamic_cast<DualEdge&>(*(*cur_eit));
-        auto& AF = dynamic_cast<EmbeddedFace&>(DE.adjacentNode(F));
+        auto& DE = downcast<DualEdge>(*(*cur_eit));
+        auto& AF = downcast<EmbeddedFace>(DE.adjacentNode(F));
 //cerr << " af: " << AF.utility();
         crossingEdges.push_front(DE.IGBackwardLink());
 
-//        auto& OE = dynamic_cast<Edge&>(*(*(DE.mOriginal)));
-//        auto& N1 = dynamic_cast<NumNode&>(OE.incidentNode1());
-//        auto& N2 = dynamic_cast<NumNode&>(OE.incidentNode2());
+//        auto& OE = downcast<Edge>(*(*(DE.mOriginal)));
+//        auto& N1 = downcast<NumNode>(OE.incidentNode1());
+//        auto& N2 = downcast<NumNode>(OE.incidentNode2());
 //        cerr << "{" << N1.num() << "," << N2.num() << "}\n";
 
         cur_fit = AF.backIt();
@@ -263,11 +263,11 @@ vector<node_list_it_t> PlanarInsertionPathFinder::incidentFaces(
 ) {
     vector<node_list_it_t> faces;
 
-    auto& Nemb = dynamic_cast<EmbeddedNode&>(*(*nit));
+    auto& Nemb = downcast<EmbeddedNode>(*(*nit));
 
     for (auto eit = Nemb.incidentEdges().first;
                                   eit != Nemb.incidentEdges().second; eit++) {
-        auto& Eemb = dynamic_cast<EmbeddedEdge&>(*(*(*eit)));
+        auto& Eemb = downcast<EmbeddedEdge>(*(*(*eit)));
         if (Eemb.mHalfEdge1.mSrcNode == nit) {
             faces.push_back(Eemb.mHalfEdge1.mEmbeddedFace);
         }
@@ -286,7 +286,7 @@ vector<node_list_it_t> PlanarInsertionPathFinder::incidentFaces(
 
     vector<node_list_it_t> faces;
 
-    auto& Eemb = dynamic_cast<EmbeddedEdge&>(*(*eit));
+    auto& Eemb = downcast<EmbeddedEdge>(*(*eit));
     faces.push_back(Eemb.mHalfEdge1.mEmbeddedFace);
     faces.push_back(Eemb.mHalfEdge2.mEmbeddedFace);
 
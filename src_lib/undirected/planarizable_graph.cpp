@@ -52,12 +52,12 @@ void PlanarizableGraph::createFrom(
     g.copySubgraph(nodePairs, edgePairs, *this);
 
     for (auto nit = nodes().first; nit != nodes().second; nit++) {
-        auto& PN = dynamic_cast<PlanarizableNode&>(*(*nit));
+        auto& PN = downcast<PlanarizableNode>(*(*nit));
         PN.IGBackwardLinkRef().pushIGForwardLink(nit);
     }
 
     for (auto eit = edges().first; eit != edges().second; eit++) {
-        auto& PE = dynamic_cast<PlanarizableEdge&>(*(*eit));
+        auto& PE = downcast<PlanarizableEdge>(*(*eit));
         PE.IGBackwardLinkRef().pushIGForwardLink(eit);
     }
 }
@@ -72,8 +72,8 @@ vector<edge_list_it_t> PlanarizableGraph::findConsecutiveChains(
     prevIit--;// last element.
     for (auto iit = N.incidentEdges().first; 
                                       iit != N.incidentEdges().second; iit++) {
-        auto&Eprev = dynamic_cast<PlanarizableEdge&>(*(*(*prevIit)));
-        auto&Ecur  = dynamic_cast<PlanarizableEdge&>(*(*(*iit)));
+        auto&Eprev = downcast<PlanarizableEdge>(*(*(*prevIit)));
+        auto&Ecur  = downcast<PlanarizableEdge>(*(*(*iit)));
         if (!Ecur.isTerminalN1() && Ecur.chainN1()==Eprev.backIt()) {
             edgePairs.push_back(*prevIit);
             edgePairs.push_back(*iit);
@@ -97,9 +97,9 @@ PlanarizableGraph::mergeTwoEdges(
 
     Edge& Eorg = E1.IGBackwardLinkRef();
 
-    auto& N1   = dynamic_cast<PlanarizableNode&>(E1.adjacentNode(N));
+    auto& N1   = downcast<PlanarizableNode>(E1.adjacentNode(N));
 
-    auto& N2   = dynamic_cast<PlanarizableNode&>(E2.adjacentNode(N));
+    auto& N2   = downcast<PlanarizableNode>(E2.adjacentNode(N));
 
     auto  pos1 = (E1.incidentNode1().backIt()==N1.backIt())?
                   E1.incidentBackItNode1():E1.incidentBackItNode2();
@@ -122,7 +122,7 @@ PlanarizableGraph::mergeTwoEdges(
 
     if (E1.incidentNode1().backIt()==N1.backIt() && !E1.isTerminalN1()) {
         E1oppIt = E1.chainN1();
-        auto& E1opp = dynamic_cast<PlanarizableEdge&>(*(*E1oppIt));
+        auto& E1opp = downcast<PlanarizableEdge>(*(*E1oppIt));
         if (!E1opp.isTerminalN1() && E1opp.chainN1()==E1.backIt()) {
             shouldUpdateN1OfE1opp = true;
         }
@@ -132,7 +132,7 @@ PlanarizableGraph::mergeTwoEdges(
     }  
     else if (E1.incidentNode2().backIt()==N1.backIt() && !E1.isTerminalN2()) {
         E1oppIt = E1.chainN2();
-        auto& E1opp = dynamic_cast<PlanarizableEdge&>(*(*E1oppIt));
+        auto& E1opp = downcast<PlanarizableEdge>(*(*E1oppIt));
         if (!E1opp.isTerminalN1() && E1opp.chainN1()==E1.backIt()) {
             shouldUpdateN1OfE1opp = true;
         }
@@ -143,7 +143,7 @@ PlanarizableGraph::mergeTwoEdges(
 
     if (E2.incidentNode1().backIt()==N2.backIt() && !E2.isTerminalN1()) {
         E2oppIt = E2.chainN1();
-        auto& E2opp = dynamic_cast<PlanarizableEdge&>(*(*E2oppIt));
+        auto& E2opp = downcast<PlanarizableEdge>(*(*E2oppIt));
         if (!E2opp.isTerminalN1() && E2opp.chainN1()==E2.backIt()) {
             shouldUpdateN1OfE2opp = true;
         }
@@ -153,7 +153,7 @@ PlanarizableGraph::mergeTwoEdges(
     }  
     else if (E2.incidentNode2().backIt()==N2.backIt() && !E2.isTerminalN2()) {
         E2oppIt = E2.chainN2();
-        auto& E2opp = dynamic_cast<PlanarizableEdge&>(*(*E2oppIt));
+        auto& E2opp = downcast<PlanarizableEdge>(*(*E2oppIt));
         if (!E2opp.isTerminalN1() && E2opp.chainN1()==E2.backIt()) {
             shouldUpdateN1OfE2opp = true;
         }
@@ -163,7 +163,7 @@ PlanarizableGraph::mergeTwoEdges(
     }
 
     auto  ep   = make_unique<PlanarizableEdge>();
-    auto& Enew = dynamic_cast<PlanarizableEdge&>(
+    auto& Enew = downcast<PlanarizableEdge>(
                                   addEdge(std::move(ep), N1, N2, pos1, pos2));
 
     auto epE1 = removeEdge(E1);
@@ -176,7 +176,7 @@ PlanarizableGraph::mergeTwoEdges(
     }
 
     if (shouldUpdateN1OfE1opp||shouldUpdateN2OfE1opp) {
-        auto& E1opp = dynamic_cast<PlanarizableEdge&>(*(*E1oppIt));
+        auto& E1opp = downcast<PlanarizableEdge>(*(*E1oppIt));
         Enew.setChainN1(E1opp.backIt());
         if (shouldUpdateN1OfE1opp) {
             E1opp.setChainN1(Enew.backIt());
@@ -187,7 +187,7 @@ PlanarizableGraph::mergeTwoEdges(
     }
 
     if (shouldUpdateN1OfE2opp||shouldUpdateN2OfE2opp) {
-        auto& E2opp = dynamic_cast<PlanarizableEdge&>(*(*E2oppIt));
+        auto& E2opp = downcast<PlanarizableEdge>(*(*E2oppIt));
         Enew.setChainN2(E2opp.backIt());
         if (shouldUpdateN1OfE2opp) {
             E2opp.setChainN1(Enew.backIt());
@@ -207,13 +207,13 @@ PlanarizableGraph::removeUnnecessaryVirtualNodes()
     vector<node_list_it_t> nodesToBeRemoved;
 
     for (auto nit = nodes().first; nit != nodes().second; nit++) {
-        auto& N = dynamic_cast<PlanarizableNode&>(*(*nit));
+        auto& N = downcast<PlanarizableNode>(*(*nit));
         if (N.isVirtual()) {
             vector<edge_list_it_t> edgePairs = findConsecutiveChains(N);
             for (size_t index = 0; index < edgePairs.size(); index +=2) {
-                auto& E1 = dynamic_cast<PlanarizableEdge&>(
+                auto& E1 = downcast<PlanarizableEdge>(
                                                        *(*(edgePairs[index])));
-                auto& E2 = dynamic_cast<PlanarizableEdge&>(
+                auto& E2 = downcast<PlanarizableEdge>(
                                                      *(*(edgePairs[index+1])));
                 std::tuple<edge_ptr_t, edge_ptr_t, edge_list_it_t> tpl = 
                                                       mergeTwoEdges(N, E1, E2);
@@ -226,7 +226,7 @@ PlanarizableGraph::removeUnnecessaryVirtualNodes()
     }
 
     for (auto nit : nodesToBeRemoved) {
-        auto& N = dynamic_cast<PlanarizableNode&>(*(*nit));
+        auto& N = downcast<PlanarizableNode>(*(*nit));
         removeNode(N);
     }
     return edgeTuples;
@@ -269,9 +269,9 @@ void PlanarizableGraph::splitInsertionPath (
 ) {
     for (auto eit : insertionPath) {
 
-        auto& E  = dynamic_cast<PlanarizableEdge&>(*(*eit));
-        auto& N1 = dynamic_cast<PlanarizableNode&>(E.incidentNode1());
-        auto& N2 = dynamic_cast<PlanarizableNode&>(E.incidentNode2());
+        auto& E  = downcast<PlanarizableEdge>(*(*eit));
+        auto& N1 = downcast<PlanarizableNode>(E.incidentNode1());
+        auto& N2 = downcast<PlanarizableNode>(E.incidentNode2());
 
         // Check the chain and link structures and store them to flags.
         bool shouldUpdateChainN1OfEopp1        = false;
@@ -283,7 +283,7 @@ void PlanarizableGraph::splitInsertionPath (
 
         if (!E.mTerminalN1) {
 
-            auto& Eopp1 = dynamic_cast<PlanarizableEdge&>(*(*(E.mChainN1)));
+            auto& Eopp1 = downcast<PlanarizableEdge>(*(*(E.mChainN1)));
 
             if (!Eopp1.mTerminalN1 && Eopp1.mChainN1 == E.backIt()) {
 
@@ -296,7 +296,7 @@ void PlanarizableGraph::splitInsertionPath (
         }
 
         if (!E.mTerminalN2) {
-            auto& Eopp2 = dynamic_cast<PlanarizableEdge&>(*(*(E.mChainN2)));
+            auto& Eopp2 = downcast<PlanarizableEdge>(*(*(E.mChainN2)));
             if (!Eopp2.mTerminalN1 && Eopp2.mChainN1 == E.backIt()) {
                 shouldUpdateChainN1OfEopp2 = true;
             }
@@ -324,9 +324,9 @@ void PlanarizableGraph::splitInsertionPath (
         auto newTuple = splitEdge(
                E, removedE, move(ep1), move(ep2), move(np), nodes().second);
 
-        auto& Nnew  = dynamic_cast<PlanarizableNode&>(get<0>(newTuple));
-        auto& Enew1 = dynamic_cast<PlanarizableEdge&>(get<1>(newTuple));
-        auto& Enew2 = dynamic_cast<PlanarizableEdge&>(get<2>(newTuple));
+        auto& Nnew  = downcast<PlanarizableNode>(get<0>(newTuple));
+        auto& Enew1 = downcast<PlanarizableEdge>(get<1>(newTuple));
+        auto& Enew2 = downcast<PlanarizableEdge>(get<2>(newTuple));
 
         Nnew.mVirtual = true;
         Nnew.pushIGBackwardLink(nodes().second);
@@ -353,13 +353,13 @@ void PlanarizableGraph::splitInsertionPath (
         }
 
         if (shouldUpdateChainN1OfEopp1) {
-            auto& Eopp1 = dynamic_cast<PlanarizableEdge&>(*(*(E.mChainN1)));
+            auto& Eopp1 = downcast<PlanarizableEdge>(*(*(E.mChainN1)));
             Eopp1.mChainN1     = Enew1.backIt();
             Eopp1.mTerminalN1 = false;
         }
 
         if (shouldUpdateChainN2OfEopp1) {
-            auto& Eopp1 = dynamic_cast<PlanarizableEdge&>(*(*(E.mChainN1)));
+            auto& Eopp1 = downcast<PlanarizableEdge>(*(*(E.mChainN1)));
             Eopp1.mChainN2     = Enew1.backIt();
             Eopp1.mTerminalN2 = false;
         }
@@ -386,13 +386,13 @@ void PlanarizableGraph::splitInsertionPath (
         }
 
         if (shouldUpdateChainN1OfEopp2) {
-            auto& Eopp2 = dynamic_cast<PlanarizableEdge&>(*(*(E.mChainN2)));
+            auto& Eopp2 = downcast<PlanarizableEdge>(*(*(E.mChainN2)));
             Eopp2.mChainN1     = Enew2.backIt();
             Eopp2.mTerminalN1 = false;
         }
 
         if (shouldUpdateChainN2OfEopp2) {
-            auto& Eopp2 = dynamic_cast<PlanarizableEdge&>(*(*(E.mChainN2)));
+            auto& Eopp2 = downcast<PlanarizableEdge>(*(*(E.mChainN2)));
             Eopp2.mChainN2     = Enew2.backIt();
             Eopp2.mTerminalN2 = false;
         }
@@ -417,7 +417,7 @@ vector<edge_ptr_t> PlanarizableGraph::insertEdge (
     if (insertionPath.size() == 0) {
         // The edge can be inserted without breaking planarity.
         auto  ep   = make_unique<PlanarizableEdge>();
-        auto& Enew = dynamic_cast<PlanarizableEdge&>(addEdge(move(ep),N1,N2));
+        auto& Enew = downcast<PlanarizableEdge>(addEdge(move(ep),N1,N2));
         Enew.mChainN1    = edges().second;
         Enew.mTerminalN1 = true;
         Enew.mChainN2    = edges().second;
@@ -439,9 +439,9 @@ vector<edge_ptr_t> PlanarizableGraph::insertEdge (
     edge_list_it_t         prevIt;
     for (size_t i = 0; i <= newNodes.size() ; i++) {
         if (i == 0) {
-            auto& Ni_2 = dynamic_cast<PlanarizableNode&>(*(*(newNodes[i])));
+            auto& Ni_2 = downcast<PlanarizableNode>(*(*(newNodes[i])));
             auto  ep   = make_unique<PlanarizableEdge>();
-            auto& Enew = dynamic_cast<PlanarizableEdge&>(
+            auto& Enew = downcast<PlanarizableEdge>(
                                                   addEdge(move(ep), N1, Ni_2));
             Enew.mChainN1    = edges().second;
             Enew.mTerminalN1 = true;
@@ -454,11 +454,11 @@ vector<edge_ptr_t> PlanarizableGraph::insertEdge (
             prevIt = Enew.backIt();
         }
         else if (i < newNodes.size()) {
-            auto& Ni_1  = dynamic_cast<PlanarizableNode&>(*(*(newNodes[i-1])));
-            auto& Ni_2  = dynamic_cast<PlanarizableNode&>(*(*(newNodes[i])));
-            auto& Eprev = dynamic_cast<PlanarizableEdge&>(*(*prevIt));
+            auto& Ni_1  = downcast<PlanarizableNode>(*(*(newNodes[i-1])));
+            auto& Ni_2  = downcast<PlanarizableNode>(*(*(newNodes[i])));
+            auto& Eprev = downcast<PlanarizableEdge>(*(*prevIt));
             auto  ep    = make_unique<PlanarizableEdge>();
-            auto& Enew  = dynamic_cast<PlanarizableEdge&>(
+            auto& Enew  = downcast<PlanarizableEdge>(
                                                 addEdge(move(ep), Ni_1, Ni_2));
             Eprev.mChainN2    = Enew.backIt();
             Eprev.mTerminalN2 = false;
@@ -470,10 +470,10 @@ vector<edge_ptr_t> PlanarizableGraph::insertEdge (
             prevIt = Enew.backIt();
         }
         else /*if (i == newNodes.size())*/{
-            auto& Ni_1  = dynamic_cast<PlanarizableNode&>(*(*(newNodes[i-1])));
-            auto& Eprev = dynamic_cast<PlanarizableEdge&>(*(*prevIt));
+            auto& Ni_1  = downcast<PlanarizableNode>(*(*(newNodes[i-1])));
+            auto& Eprev = downcast<PlanarizableEdge>(*(*prevIt));
             auto  ep    = make_unique<PlanarizableEdge>();
-            auto& Enew  = dynamic_cast<PlanarizableEdge&>(
+            auto& Enew  = downcast<PlanarizableEdge>(
                                                   addEdge(move(ep), Ni_1, N2));
             Eprev.mChainN2    = Enew.backIt();
             Eprev.mTerminalN2 = false;
@@ -5,6 +5,7 @@
 #include <exception>
 
 #include "undirected/spqr_decomposer.hpp"
+#include "undirected/static_dfs.hpp"
 
 
 /**
@@ -31,76 +32,63 @@ using namespace std;
 
 SPQRTree SPQRDecomposer::decompose(Graph& g, Node& s)
 {
-    DFSGraph<Graph,SPQR_DFS_Node,SPQR_DFS_Edge> gCopy;
-    auto sCopy = copyInputGraph(g, gCopy, s.backIt());
-
-    {
-        SPQRStrategyProc1 strategy1;
-        DFSExplorer<Graph,SPQR_DFS_Node,SPQR_DFS_Edge> 
-                                                 mExplorer1(gCopy,strategy1);
-        mExplorer1.reset(gCopy);
-        mExplorer1.run(dynamic_cast<
-                             DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>&>
-                                                                  (*(*sCopy)));
-    }
-    sortAdjacency(gCopy);
-    {
-        SPQRStrategyProc2 strategy2;
-        DFSExplorer<Graph,SPQR_DFS_Node,SPQR_DFS_Edge> 
-                                                 mExplorer2(gCopy,strategy2);
-        strategy2.prepareNodesForDFS(gCopy);
-        mExplorer2.reset(gCopy);
-        mExplorer2.run(dynamic_cast<
-                         DFSNode<Graph, SPQR_DFS_Node,SPQR_DFS_Edge>&>
-                                                                  (*(*sCopy)));
-    }
-    // Find the initial separation components and form a tree.
-
     SPQRTree     spqrTree(g);
     {
-
-        SPQRStrategyProc3 strategy3(gCopy, spqrTree);
-
-        DFSExplorer<Graph,SPQR_DFS_Node,SPQR_DFS_Edge> 
-                                                 mExplorer3(gCopy,strategy3);
-
-        strategy3.prepareNodesAndEdges(gCopy);
-
-        mExplorer3.reset(gCopy);
-
-        mExplorer3.run(dynamic_cast<
-                        DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>&>
-                                                                  (*(*sCopy)));
-
+        // The working copy is released once the components are found.
+        // The components link back to g, not to gCopy.
+        ElementArena arena;
+        DFSGraph<Graph,SPQR_DFS_Node,SPQR_DFS_Edge> gCopy;
+        node_list_it_t sCopy;
+        {
+            ElementArena::Scope scope(arena);
+            sCopy = copyInputGraph(g, gCopy, s.backIt());
+        }
+        auto& sNode = downcast<DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>>
+                                                                   (*(*sCopy));
+        {
+            SPQRStrategyProc1 strategy1;
+            StaticDFSExplorer<Graph,SPQR_DFS_Node,SPQR_DFS_Edge,
+                              SPQRStrategyProc1> mExplorer1(gCopy,strategy1);
+            mExplorer1.reset(gCopy);
+            mExplorer1.run(sNode);
+        }
+        sortAdjacency(gCopy);
+        {
+            SPQRStrategyProc2 strategy2;
+            StaticDFSExplorer<Graph,SPQR_DFS_Node,SPQR_DFS_Edge,
+                              SPQRStrategyProc2> mExplorer2(gCopy,strategy2);
+            strategy2.prepareNodesForDFS(gCopy);
+            mExplorer2.reset(gCopy);
+            mExplorer2.run(sNode);
+        }
+        // Find the initial separation components and form a tree.
+        {
+            SPQRStrategyProc3 strategy3(gCopy, spqrTree);
+            StaticDFSExplorer<Graph,SPQR_DFS_Node,SPQR_DFS_Edge,
+                              SPQRStrategyProc3> mExplorer3(gCopy,strategy3);
+            strategy3.prepareNodesAndEdges(gCopy);
+            mExplorer3.reset(gCopy);
+            mExplorer3.run(sNode);
+        }
     }
 
     spqrTree.determineTypes();
 
-
     // Merging adjacent S and P nodes.
-    {
-        SPQRStrategyProc4 strategy4(spqrTree);
-        DFSGraph<Graph, SPQR_PROC4_Node, SPQR_PROC4_Edge> tCopy;
-        copySPQRTree(spqrTree, tCopy);
-        auto nit =  tCopy.nodes().first;
-        DFSExplorer<Graph, SPQR_PROC4_Node, SPQR_PROC4_Edge> 
-                                                 mExplorer4(tCopy, strategy4);
-        mExplorer4.reset(tCopy);
-        mExplorer4.run(dynamic_cast<
-                  DFSNode<Graph, SPQR_PROC4_Node, SPQR_PROC4_Edge>&>(*(*nit)));
-    }
+    mergeSPNodes(spqrTree);
+
     // Making forward links for the edges in the original graph.
     {
         auto tnPair = spqrTree.nodes();
         for (auto tnit = tnPair.first; tnit != tnPair.second; tnit++) {
-            auto& TN = dynamic_cast<SPQRTreeNode&>(*(*tnit));
+            auto& TN = downcast<SPQRTreeNode>(*(*tnit));
             auto& C  = TN.component();
             utility_t edgeType = (TN.type()==SPQRTreeNode::PType)?
                                      SPQRTree::kForwardEdgeTypeSeparatingEdge:
                                      SPQRTree::kForwardEdgeTypeOrdinaryEdge;
             auto cePair = C.edges();
             for (auto ceit = cePair.first; ceit != cePair.second; ceit++) {
-                auto& CE = dynamic_cast<SPQRComponentEdge&>(*(*ceit));
+                auto& CE = downcast<SPQRComponentEdge>(*(*ceit));
                 if (CE.type() == SPQRComponentEdge::OrdinaryType) {
                     CE.IGBackwardLinkRef().pushIGForwardLink(ceit);
                     CE.IGBackwardLinkRef().pushUtility(edgeType);
@@ -119,6 +107,8 @@ node_list_it_t SPQRDecomposer::copyInputGraph(
 ){
     vector<pair<node_list_it_t,node_ptr_t>> nodePairs;
     vector<pair<edge_list_it_t,edge_ptr_t>> edgePairs;
+    nodePairs.reserve(src.numNodes());
+    edgePairs.reserve(src.numEdges());
     Node* startNodeCopyGraph;
     auto nitPair = src.nodes();
     for (auto nit = nitPair.first; nit != nitPair.second; nit++) {
@@ -142,8 +132,8 @@ node_list_it_t SPQRDecomposer::copyInputGraph(
 
 void SPQRDecomposer::calculatePhi(SPQR_DFS_Edge&e)
 {
-    SPQR_DFS_Node& n1 = dynamic_cast<SPQR_DFS_Node&>(e.incidentNode1());
-    SPQR_DFS_Node& n2 = dynamic_cast<SPQR_DFS_Node&>(e.incidentNode2());
+    SPQR_DFS_Node& n1 = downcast<SPQR_DFS_Node>(e.incidentNode1());
+    SPQR_DFS_Node& n2 = downcast<SPQR_DFS_Node>(e.incidentNode2());
     if (e.mType == SPQR_DFS_Edge::TreeArcType) {
         if (n1.mNum < n2.mNum) {
             // n1->n2
@@ -179,108 +169,127 @@ void SPQRDecomposer::calculatePhi(SPQR_DFS_Edge&e)
 
 void SPQRDecomposer::sortAdjacency(Graph& g)
 {
-    vector<vector<edge_list_it_t>> bucket;
-    bucket.reserve(g.numNodes()*3+1);
-    for (size_t i = 0; i < g.numNodes() * 3 + 1; i++) {
-        vector<edge_list_it_t> e;
-        bucket.push_back(e);
-    }
+    // Counting sort of the edges by mPhi into one flat array.
+    const size_t numBuckets = g.numNodes() * 3 + 2;
+    vector<size_t> bucketStart(numBuckets, 0);
     for (auto eit = g.edges().first; eit != g.edges().second; eit++) {
-        SPQR_DFS_Edge& e = dynamic_cast<SPQR_DFS_Edge&>(*(*eit));
+        SPQR_DFS_Edge& e = downcast<SPQR_DFS_Edge>(*(*eit));
         calculatePhi(e);
-        bucket[e.mPhi].push_back(e.backIt());
+        bucketStart[e.mPhi + 1]++;
     }
+    for (size_t i = 1; i < numBuckets; i++) {
+        bucketStart[i] += bucketStart[i-1];
+    }
+    vector<edge_list_it_t> sorted(g.numEdges());
+    for (auto eit = g.edges().first; eit != g.edges().second; eit++) {
+        SPQR_DFS_Edge& e = downcast<SPQR_DFS_Edge>(*(*eit));
+        sorted[bucketStart[e.mPhi]++] = eit;
+    }
+
     for (auto nit = g.nodes().first; nit != g.nodes().second; nit++) {
-        SPQR_DFS_Node& n = dynamic_cast<SPQR_DFS_Node&>(*(*nit));
+        SPQR_DFS_Node& n = downcast<SPQR_DFS_Node>(*(*nit));
         n.mOrderedAdjacencyType1.clear();
-        n.mOrderedAdjacencyType1Back.clear();
         n.mOrderedAdjacencyType2.clear();
-        n.mOrderedAdjacencyType2Back.clear();
+        n.mOrderedAdjacencyType1.reserve(n.degree());
+        n.mOrderedAdjacencyType2.reserve(n.degree());
     }
-    for (auto& innerVec : bucket) {
-        for (auto eit : innerVec) {
-            SPQR_DFS_Edge& e  = dynamic_cast<SPQR_DFS_Edge&>(*(*eit));
-            SPQR_DFS_Node& n1 = dynamic_cast<SPQR_DFS_Node&>(
-                                                            e.incidentNode1());
-            SPQR_DFS_Node& n2 = dynamic_cast<SPQR_DFS_Node&>(
-                                                            e.incidentNode2());
-            if (e.mType == SPQR_DFS_Edge::TreeArcType) {
-                n1.mOrderedAdjacencyType1.push_back(e.backIt());
-                n2.mOrderedAdjacencyType1.push_back(e.backIt());
-                n1.mOrderedAdjacencyType2.push_back(e.backIt());
-                n2.mOrderedAdjacencyType2.push_back(e.backIt());
-            }
-            else { // e.type() == SPQR_DFS_Node::FrondType
-                n1.mOrderedAdjacencyType1Back.push_back(e.backIt());
-                n2.mOrderedAdjacencyType1Back.push_back(e.backIt());
-                if (n1.mNum < n2.mNum) {
-                    n1.mOrderedAdjacencyType2Back.push_back(e.backIt());
-                    n2.mOrderedAdjacencyType2.push_back(e.backIt());
-                }
-                else { // n1.mNum > n2.mNum
-                    n2.mOrderedAdjacencyType2Back.push_back(e.backIt());
-                    n1.mOrderedAdjacencyType2.push_back(e.backIt());
-                }
-            }
+
+    // 1st pass: the tree arcs at both ends, and the fronds at the
+    // higher-numbered end for Type2.
+    for (auto eit : sorted) {
+        SPQR_DFS_Edge& e  = downcast<SPQR_DFS_Edge>(*(*eit));
+        SPQR_DFS_Node& n1 = downcast<SPQR_DFS_Node>(e.incidentNode1());
+        SPQR_DFS_Node& n2 = downcast<SPQR_DFS_Node>(e.incidentNode2());
+        if (e.mType == SPQR_DFS_Edge::TreeArcType) {
+            n1.mOrderedAdjacencyType1.push_back(eit);
+            n2.mOrderedAdjacencyType1.push_back(eit);
+            n1.mOrderedAdjacencyType2.push_back(eit);
+            n2.mOrderedAdjacencyType2.push_back(eit);
+        }
+        else if (n1.mNum < n2.mNum) {
+            n2.mOrderedAdjacencyType2.push_back(eit);
+        }
+        else {
+            n1.mOrderedAdjacencyType2.push_back(eit);
         }
     }
-    for (auto nit = g.nodes().first; nit != g.nodes().second; nit++) {
-        SPQR_DFS_Node& n = dynamic_cast<SPQR_DFS_Node&>(*(*nit));
-        n.mOrderedAdjacencyType1.insert(
-                                   std::end(n.mOrderedAdjacencyType1), 
-                                   std::begin(n.mOrderedAdjacencyType1Back),
-                                   std::end(n.mOrderedAdjacencyType1Back)   );
-        n.mOrderedAdjacencyType2.insert(
-                                   std::end(n.mOrderedAdjacencyType2), 
-                                   std::begin(n.mOrderedAdjacencyType2Back),
-                                   std::end(n.mOrderedAdjacencyType2Back)   );
-        n.mOrderedAdjacencyType1Back.clear();
-        n.mOrderedAdjacencyType2Back.clear();
+
+    // 2nd pass: the rest of the fronds are appended in the same order.
+    for (auto eit : sorted) {
+        SPQR_DFS_Edge& e  = downcast<SPQR_DFS_Edge>(*(*eit));
+        if (e.mType == SPQR_DFS_Edge::TreeArcType) {
+            continue;
+        }
+        SPQR_DFS_Node& n1 = downcast<SPQR_DFS_Node>(e.incidentNode1());
+        SPQR_DFS_Node& n2 = downcast<SPQR_DFS_Node>(e.incidentNode2());
+        n1.mOrderedAdjacencyType1.push_back(eit);
+        n2.mOrderedAdjacencyType1.push_back(eit);
+        if (n1.mNum < n2.mNum) {
+            n1.mOrderedAdjacencyType2.push_back(eit);
+        }
+        else {
+            n2.mOrderedAdjacencyType2.push_back(eit);
+        }
     }
 }
 
 
-SPQR_PROC4_Node::type SPQRDecomposer::convertNodeType(node_list_it_t nit)
+void SPQRDecomposer::mergeSPNodes(SPQRTree& tree)
 {
-    SPQRTreeNode& tn = dynamic_cast<SPQRTreeNode&>(*(*nit));
-    switch (tn.type()) {
-      case SPQRTreeNode::RType:
-          return SPQR_PROC4_Node::RType;
-
-      case SPQRTreeNode::SType:
-          return SPQR_PROC4_Node::SType;
-
-      case SPQRTreeNode::PType:
-          return SPQR_PROC4_Node::PType;
-
-      default:
-          return SPQR_PROC4_Node::Unknown;
-
+    if (tree.numNodes() == 0) {
+        return;
     }
-    return SPQR_PROC4_Node::Unknown;
-}
 
-
-void SPQRDecomposer::copySPQRTree(SPQRTree& tree, Graph& copiedGraph)
-{
-    vector<pair<node_list_it_t,node_ptr_t>> nodePairs;
-    vector<pair<edge_list_it_t,edge_ptr_t>> edgePairs;
-    auto nitPair = tree.nodes();
-    for (auto nit = nitPair.first; nit != nitPair.second; nit++) {
-        auto np = make_unique<DFSNode<
-                                  Graph, SPQR_PROC4_Node, SPQR_PROC4_Edge>>();
-        np->pushIGBackwardLink(nit);
-        np->mType = convertNodeType(nit);
-        nodePairs.push_back(make_pair(nit,std::move(np)));
+    // Take the tree edges in the DFS order from the first tree node
+    // before the tree is modified by the merges.
+    struct TreeArc {
+        edge_list_it_t          mEdge;
+        node_list_it_t          mChild;
+        enum SPQRTreeNode::type mParentType;
+        enum SPQRTreeNode::type mChildType;
+    };
+    vector<TreeArc> arcs;
+    arcs.reserve(tree.numEdges());
+
+    // Stack of (node, edge to the parent, next incident edge).
+    struct Frame {
+        SPQRTreeNode*           mNode;
+        edge_list_it_t          mParentEdge;
+        node_incidence_it_t     mNext;
+    };
+    vector<Frame> stack;
+    auto& root = downcast<SPQRTreeNode>(*(*(tree.nodes().first)));
+    stack.push_back({&root, tree.edges().second,
+                                               root.incidentEdges().first});
+    while (!stack.empty()) {
+        Frame& f = stack.back();
+        if (f.mNext == f.mNode->incidentEdges().second) {
+            stack.pop_back();
+            continue;
+        }
+        auto eit = *(f.mNext);
+        f.mNext++;
+        if (eit == f.mParentEdge) {
+            continue;
+        }
+        auto& child = downcast<SPQRTreeNode>(
+                                          (*(*eit)).adjacentNode(*f.mNode));
+        arcs.push_back({eit, child.backIt(), f.mNode->type(), child.type()});
+        stack.push_back({&child, eit, child.incidentEdges().first});
     }
-    auto eitPair = tree.edges();
-    for (auto eit = eitPair.first; eit != eitPair.second; eit++) {
-        auto ep = make_unique<DFSEdge<
-                                  Graph, SPQR_PROC4_Node, SPQR_PROC4_Edge>>();
-        ep->pushIGBackwardLink(eit);
-        edgePairs.push_back(make_pair(eit,std::move(ep)));
+
+    // The merges relink the tree edges of the removed child to the
+    // surviving parent, and the types do not change by the merges.
+    for (auto& a : arcs) {
+        if ( a.mParentType == SPQRTreeNode::SType &&
+             a.mChildType  == SPQRTreeNode::SType    ) {
+            tree.mergeTwoNodesS(a.mEdge, a.mChild);
+        }
+        else if ( a.mParentType == SPQRTreeNode::PType &&
+                  a.mChildType  == SPQRTreeNode::PType    ) {
+            tree.mergeTwoNodesP(a.mEdge, a.mChild);
+        }
     }
-    tree.copySubgraph(nodePairs, edgePairs, copiedGraph);
 }
 
 
@@ -41,7 +41,7 @@ void SPQRStrategyProc1::enterNode(DNode& v) noexcept
 
 void SPQRStrategyProc1::processFrond(DNode& v,DEdge& vw) noexcept
 {
-    auto& w = dynamic_cast<DNode&>(vw.adjacentNode(v));
+    auto& w = downcast<DNode>(vw.adjacentNode(v));
 
     vw.mType   = SPQR_DFS_Edge::FrondType;
 
@@ -68,7 +68,7 @@ void SPQRStrategyProc1::beforeVisitingChild(DNode& v, DEdge& vw) noexcept
 void SPQRStrategyProc1::afterVisitingChild(DNode& v, DEdge& vw) noexcept
 {
 
-    auto& w = dynamic_cast<DNode&>(vw.adjacentNode(v));
+    auto& w = downcast<DNode>(vw.adjacentNode(v));
 
     if (w.mLowPt1 < v.mLowPt1) {
 
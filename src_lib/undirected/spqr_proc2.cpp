@@ -36,9 +36,10 @@ void SPQRStrategyProc2::prepareNodesForDFS(Graph &g) noexcept
     auto itPairs = g.nodes();
     for (auto it = itPairs.first; it != itPairs.second; it++) {
 
-        SPQR_DFS_Node& n = dynamic_cast<SPQR_DFS_Node&>(*(*it));
+        SPQR_DFS_Node& n = downcast<SPQR_DFS_Node>(*(*it));
         n.reorderIncidence(move(n.mOrderedAdjacencyType1));
         n.mOrderedAdjacencyType1.clear();
+        n.mOrderedAdjacencyType1.shrink_to_fit();
 	n.mHighPoints.clear();
 	n.mHighPointReferences.clear();
 	n.mHighPointIterators.clear();
@@ -62,7 +63,7 @@ void SPQRStrategyProc2::enterNode(DNode& v) noexcept
 
 void SPQRStrategyProc2::processFrond(DNode& v,DEdge& vw)
 {
-    auto& w = dynamic_cast<DNode&>(vw.adjacentNode(v));
+    auto& w = downcast<DNode>(vw.adjacentNode(v));
 
     auto it = w.mHighPoints.insert(w.mHighPoints.end(),v.backIt());
     v.mHighPointIterators.push_back(it);
@@ -84,7 +85,7 @@ void SPQRStrategyProc2::processFrond(DNode& v,DEdge& vw)
 
 void SPQRStrategyProc2::afterVisitingChild(DNode& v, DEdge& vw) noexcept
 {
-    auto& w = dynamic_cast<DNode&>(vw.adjacentNode(v));
+    auto& w = downcast<DNode>(vw.adjacentNode(v));
 
     mV--;
     if (w.mLowPt1 < v.mLowPt1) {
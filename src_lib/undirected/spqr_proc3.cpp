@@ -30,16 +30,17 @@ noexcept
     auto nitPairs = g.nodes();
     for (auto nit = nitPairs.first; nit != nitPairs.second; nit++) {
 
-        SPQR_DFS_Node& n = dynamic_cast<SPQR_DFS_Node&>(*(*nit));
+        SPQR_DFS_Node& n = downcast<SPQR_DFS_Node>(*(*nit));
         n.reorderIncidence(move(n.mOrderedAdjacencyType2));
         n.mOrderedAdjacencyType2.clear();
+        n.mOrderedAdjacencyType2.shrink_to_fit();
 
     }
 
     auto eitPairs = g.edges();
     for (auto eit = eitPairs.first; eit != eitPairs.second; eit++) {
 
-        SPQR_DFS_Edge& e = dynamic_cast<SPQR_DFS_Edge&>(*(*eit));
+        SPQR_DFS_Edge& e = downcast<SPQR_DFS_Edge>(*(*eit));
         e.mStartPath = false;
         e.mIsVirtual = false;
     }
@@ -61,7 +62,7 @@ void SPQRStrategyProc3::createNodeMap(Graph &g)
     }
 
     for (auto nit = g.nodes().first; nit != g.nodes().second; nit++) {
-        SPQR_DFS_Node& n = dynamic_cast<SPQR_DFS_Node&>(*(*nit));
+        SPQR_DFS_Node& n = downcast<SPQR_DFS_Node>(*(*nit));
         mNMap[n.mNum].mIt = n.backIt();
         mNMap[n.mNum].mRemoved = false;
     }
@@ -80,7 +81,7 @@ void SPQRStrategyProc3::leaveNode(DNode& v)
 void SPQRStrategyProc3::processFrond(DNode& v,DEdge& vw)
 {
 
-    DNode& w = dynamic_cast<DNode&>(vw.adjacentNode(v));
+    DNode& w = downcast<DNode>(vw.adjacentNode(v));
     if (!mOutgoingPath) {
 
        mTStack.updateForFrond(v.mNum, w.mNum);
@@ -93,7 +94,7 @@ void SPQRStrategyProc3::processFrond(DNode& v,DEdge& vw)
 void SPQRStrategyProc3::beforeVisitingChild(DNode& v,DEdge& vw)
                                                           
 {
-    DNode& w = dynamic_cast<DNode&>(vw.adjacentNode(v));
+    DNode& w = downcast<DNode>(vw.adjacentNode(v));
 
     if (!mOutgoingPath) {
 
@@ -122,7 +123,7 @@ void SPQRStrategyProc3::afterVisitingChild(DNode& v,DEdge& vw)
 
     mHasNewHighPt = false;
 
-    DEdge& vwNew = dynamic_cast<DEdge&>(checkForType2s(v,vw));
+    DEdge& vwNew = downcast<DEdge>(checkForType2s(v,vw));
 
     checkForType1(v,vwNew);
 
@@ -134,7 +135,7 @@ void SPQRStrategyProc3::afterVisitingChild(DNode& v,DEdge& vw)
 
     if (v.mHighPoints.size()>0) {
 
-        DNode& h = dynamic_cast<DNode&>(*(*(*(v.mHighPoints.begin()))));
+        DNode& h = downcast<DNode>(*(*(*(v.mHighPoints.begin()))));
 
         mTStack.popUntilHigherH(v.mNum, h.mNum);
     }
@@ -149,9 +150,9 @@ void SPQRStrategyProc3::checkForType1(DNode& v, DEdge& vw)
         return;
     }
 
-    DNode& w           = dynamic_cast<DNode&>(vw.adjacentNode(v));
+    DNode& w           = downcast<DNode>(vw.adjacentNode(v));
     Edge&  vParentEdge = *(*(v.mParentEdge));
-    DNode& vParent     = dynamic_cast<DNode&>(vParentEdge.adjacentNode(v));
+    DNode& vParent     = downcast<DNode>(vParentEdge.adjacentNode(v));
 
     if( !( w.mLowPt2 >= v.mNum && w.mLowPt1 < v.mNum   && 
            (vParent.mNum != 1 || v.isThereUnexplored())   ) ) {
@@ -159,7 +160,7 @@ void SPQRStrategyProc3::checkForType1(DNode& v, DEdge& vw)
     }
     DNode& b = v;
     DNode& bParent = vParent;
-    DNode& a = dynamic_cast<DNode&>(*(*(mNMap[w.mLowPt1].mIt)));
+    DNode& a = downcast<DNode>(*(*(mNMap[w.mLowPt1].mIt)));
 
     // Those two become valid only if mHasNewHighPt becomes true below.
     mHighPtOf    = a.backIt();
@@ -169,9 +170,9 @@ void SPQRStrategyProc3::checkForType1(DNode& v, DEdge& vw)
 
     while (mEStack.size()>0) {
 
-        DEdge& xy = dynamic_cast<DEdge&>(*(*(*(mEStack.rbegin()))));
-        DNode& x  = dynamic_cast<DNode&>(xy.incidentNode1());
-        DNode& y  = dynamic_cast<DNode&>(xy.incidentNode2());
+        DEdge& xy = downcast<DEdge>(*(*(*(mEStack.rbegin()))));
+        DNode& x  = downcast<DNode>(xy.incidentNode1());
+        DNode& y  = downcast<DNode>(xy.incidentNode2());
 
         if (!( ( w.mNum <= x.mNum && x.mNum < w.mNum + w.mNd )||
                ( w.mNum <= y.mNum && y.mNum < w.mNum + w.mNd )  ) ) {
@@ -187,7 +188,7 @@ void SPQRStrategyProc3::checkForType1(DNode& v, DEdge& vw)
 
     if (bParent.mNum == a.mNum) {
 
-        DEdge& edgeAB = dynamic_cast<DEdge&>(vParentEdge);
+        DEdge& edgeAB = downcast<DEdge>(vParentEdge);
 
         if (edgeAB.mIsVirtual) {
 
@@ -220,7 +221,7 @@ void SPQRStrategyProc3::checkForType1(DNode& v, DEdge& vw)
             // Make the existing (a,b) in G virtual. Make a new real edge 
             // and pass it to the separating pair.
             edge_ptr_t newRealEdgeABPtr = make_unique<DEdge>();
-            DEdge& newRealEdgeAB = dynamic_cast<DEdge&>(
+            DEdge& newRealEdgeAB = downcast<DEdge>(
                                    mG.addEdge(move(newRealEdgeABPtr), a, b));
 
             newRealEdgeAB.mType = SPQR_DFS_Edge::TreeArcType;
@@ -259,11 +260,11 @@ void SPQRStrategyProc3::checkForType1(DNode& v, DEdge& vw)
         edge_list_it_t edgeABIt = mG.edges().second;
 
         if (mEStack.size() > 0) {
-            DEdge& xy =  dynamic_cast<DEdge&>(*(*(*(mEStack.rbegin()))));
+            DEdge& xy =  downcast<DEdge>(*(*(*(mEStack.rbegin()))));
 
-            DNode& x = dynamic_cast<DNode&>(xy.incidentNode1());
+            DNode& x = downcast<DNode>(xy.incidentNode1());
 
-            DNode& y = dynamic_cast<DNode&>(xy.incidentNode2());
+            DNode& y = downcast<DNode>(xy.incidentNode2());
 
             if ( (x.mNum == a.mNum && y.mNum == b.mNum) ||
                  (y.mNum == a.mNum && x.mNum == b.mNum)   ) {
@@ -288,7 +289,7 @@ void SPQRStrategyProc3::checkForType1(DNode& v, DEdge& vw)
                                                  newTreeNodeIt,
                                                  virtualEdgeInTreeNodeIt );
 
-        DEdge& newEdgeBA = dynamic_cast<DEdge&>(*(*createAndAddDEdgeNextTo(
+        DEdge& newEdgeBA = downcast<DEdge>(*(*createAndAddDEdgeNextTo(
                                                  mG,
                                                  b,
                                                  a,
@@ -326,10 +327,10 @@ Edge& SPQRStrategyProc3::checkForType2s(DNode& v, DEdge& vwOriginal)
 
     while ( true  ) {
 
-        DEdge& vw          = dynamic_cast<DEdge&>(*(*currentEdgeIt));
-        DNode& w           = dynamic_cast<DNode&>( vw.adjacentNode(v) );
-        DEdge& wx          = dynamic_cast<DEdge&>( w.adjacentEdge(vw) );
-        DNode& x           = dynamic_cast<DNode&>( wx.adjacentNode(w) );
+        DEdge& vw          = downcast<DEdge>(*(*currentEdgeIt));
+        DNode& w           = downcast<DNode>( vw.adjacentNode(v) );
+        DEdge& wx          = downcast<DEdge>( w.adjacentEdge(vw) );
+        DNode& x           = downcast<DNode>( wx.adjacentNode(w) );
         if(!(mTStack.a() == v.mNum||(w.degree() == 2 && w.mNum < x.mNum))) {
             break;
         }
@@ -344,7 +345,7 @@ Edge& SPQRStrategyProc3::checkForType2s(DNode& v, DEdge& vwOriginal)
             currentEdgeIt = processSeparationComponentByHAB(v, vw);
         }
     }
-    return dynamic_cast<DEdge&>(*(*currentEdgeIt));
+    return downcast<DEdge>(*(*currentEdgeIt));
 }
 
 
@@ -360,9 +361,9 @@ bool SPQRStrategyProc3::popInvalidTStackElements(size_t vNum)
                 isTStackUpdated = true;
             }
             else {
-                DNode& b = dynamic_cast<DNode&>(*(*(mNMap[mTStack.b()].mIt)));
+                DNode& b = downcast<DNode>(*(*(mNMap[mTStack.b()].mIt)));
                 Edge&  bParentEdge = *(*b.mParentEdge);
-                DNode& bParent = dynamic_cast<DNode&>(
+                DNode& bParent = downcast<DNode>(
                                                  bParentEdge.adjacentNode(b));
                 if (bParent.mNum == mTStack.a()) {
                     mTStack.pop();
@@ -394,7 +395,7 @@ edge_list_it_t SPQRStrategyProc3::processUpwardTriangle(
     edge_list_it_t edgeXVIt = mG.edges().second;
     if (mEStack.size()>0) {
 
-        DEdge& e = dynamic_cast<DEdge&>(*(*(*(mEStack.rbegin()))));
+        DEdge& e = downcast<DEdge>(*(*(*(mEStack.rbegin()))));
         if (((&(e.incidentNode1()) == &v)&&(&(e.incidentNode2()) == &x))||
             ((&(e.incidentNode1()) == &x)&&(&(e.incidentNode2()) == &v)) ){
             edgeXVIt = e.backIt();
@@ -416,7 +417,7 @@ edge_list_it_t SPQRStrategyProc3::processUpwardTriangle(
                                              newTreeNodeIt,
                                              virtualEdgeInTreeNodeIt );
                                      
-    DEdge& newEdgeXV = dynamic_cast<DEdge&>(*(*createAndAddDEdgeNextTo(
+    DEdge& newEdgeXV = downcast<DEdge>(*(*createAndAddDEdgeNextTo(
                                                  mG,
                                                  v,
                                                  x,
@@ -448,12 +449,12 @@ edge_list_it_t SPQRStrategyProc3::processSeparationComponentByHAB(
     edge_list_it_t edgeABIt = mG.edges().second;
 
     DNode& a = v;
-    DNode& b = dynamic_cast<DNode&>(*(*(mNMap[mTStack.b()].mIt)));
+    DNode& b = downcast<DNode>(*(*(mNMap[mTStack.b()].mIt)));
 
     while (mEStack.size()>0) {
-        DEdge& e = dynamic_cast<DEdge&>(*(*(*(mEStack.rbegin()))));
-        DNode& n1 = dynamic_cast<DNode&>(e.incidentNode1());
-        DNode& n2 = dynamic_cast<DNode&>(e.incidentNode2());
+        DEdge& e = downcast<DEdge>(*(*(*(mEStack.rbegin()))));
+        DNode& n1 = downcast<DNode>(e.incidentNode1());
+        DNode& n2 = downcast<DNode>(e.incidentNode2());
 
         if (!( a.mNum <= n1.mNum && n1.mNum <= mTStack.h() &&
                a.mNum <= n2.mNum && n2.mNum <= mTStack.h()   )) {
@@ -484,7 +485,7 @@ edge_list_it_t SPQRStrategyProc3::processSeparationComponentByHAB(
                                              newTreeNodeIt,
                                              virtualEdgeInTreeNodeIt );
                                      
-    DEdge& newEdgeAB = dynamic_cast<DEdge&>(*(*createAndAddDEdgeNextTo(
+    DEdge& newEdgeAB = downcast<DEdge>(*(*createAndAddDEdgeNextTo(
                                                  mG,
                                                  a,
                                                  b,
@@ -510,9 +511,9 @@ edge_list_it_t SPQRStrategyProc3::processSeparationComponentByHAB(
 void SPQRStrategyProc3::printEStack(){
     cerr << "ESTACK[";
     for (auto eit : mEStack) {
-        DEdge& e = dynamic_cast<DEdge&>(*(*(eit)));
-        DNode& n1 = dynamic_cast<DNode&>(e.incidentNode1());
-        DNode& n2 = dynamic_cast<DNode&>(e.incidentNode2());
+        DEdge& e = downcast<DEdge>(*(*(eit)));
+        DNode& n1 = downcast<DNode>(e.incidentNode1());
+        DNode& n2 = downcast<DNode>(e.incidentNode2());
         cerr << "(" << n1.mNum << "," << n2.mNum << ") ";
     }
     cerr << "]\n";
@@ -522,9 +523,9 @@ void SPQRStrategyProc3::printEStack(){
 void SPQRStrategyProc3::removeSubgraph(vector<edge_list_it_t>& edges)
 {
     for (auto eIt : edges) {    
-        DEdge& e = dynamic_cast<DEdge&>(*(*eIt)); 
-        DNode& n1 = dynamic_cast<DNode&>(e.incidentNode1());
-        DNode& n2 = dynamic_cast<DNode&>(e.incidentNode2());
+        DEdge& e = downcast<DEdge>(*(*eIt)); 
+        DNode& n1 = downcast<DNode>(e.incidentNode1());
+        DNode& n2 = downcast<DNode>(e.incidentNode2());
         mG.removeEdge(e);
         if (n1.degree() == 0) {
             mNMap[n1.mNum].mRemoved = true;
@@ -546,7 +547,7 @@ void SPQRStrategyProc3::removeHighPoints(DNode& n)
     size_t j =  n.mHighPointIterators.size();
     for (size_t i = 0; i < j ; i++) {
         if (mNMap[n.mHighPointReferences[i]].mRemoved == false) {
-            DNode& v = dynamic_cast<DNode&>(
+            DNode& v = downcast<DNode>(
                                 *(*(mNMap[n.mHighPointReferences[i]].mIt)));
             if (mHasNewHighPt && v.backIt() == mHighPtOf) {
 
@@ -554,7 +555,7 @@ void SPQRStrategyProc3::removeHighPoints(DNode& n)
                 auto hit1 = n.mHighPointIterators[i];
                 hit1++;
                 auto hit2 = v.mHighPoints.insert(hit1, mNewHighPtIt);
-                DNode& newHighPt = dynamic_cast<DNode&>(*(*mNewHighPtIt));
+                DNode& newHighPt = downcast<DNode>(*(*mNewHighPtIt));
                 newHighPt.mHighPointReferences.push_back(v.mNum);
                 newHighPt.mHighPointIterators.push_back(hit2);
                 mHasNewHighPt = false;
@@ -580,7 +581,7 @@ void SPQRStrategyProc3::preadvance(DNode& v, DEdge& vw)
     }
     it++;
     for (; it != v.incidentEdges().second; it++) {
-        DEdge& e = dynamic_cast<DEdge&>(*(*(*it)));
+        DEdge& e = downcast<DEdge>(*(*(*it)));
         if (!e.isVisited()) {
             break;
         }
@@ -628,7 +629,7 @@ edge_list_it_t SPQRStrategyProc3::createAndAddDEdgeNextTo(
     }
 
     edge_ptr_t eNewPtr = make_unique<DEdge>();
-    DEdge& eNew = dynamic_cast<DEdge&>(
+    DEdge& eNew = downcast<DEdge>(
                                 g.addEdge(move(eNewPtr), n1, n2, n1It, n2It));
     eNew.mIsVirtual = true;
     eNew.mType    = t;
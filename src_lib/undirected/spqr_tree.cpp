@@ -3,6 +3,8 @@
 #include <list>
 #include <vector>
 #include <exception>
+#include <algorithm>
+#include <unordered_map>
 
 #include "undirected/spqr_tree.hpp"
 
@@ -31,7 +33,7 @@ vector<node_list_it_t> SPQRTree::RTypeNodes()
     vector<node_list_it_t> sameTypeList;
 
     for (auto nit  = nodes().first; nit != nodes().second; nit++ ) {
-        SPQRTreeNode& n = dynamic_cast<SPQRTreeNode&>(*(*nit));
+        SPQRTreeNode& n = downcast<SPQRTreeNode>(*(*nit));
         if (n.type() == SPQRTreeNode::RType) {
             sameTypeList.push_back(nit);
         }
@@ -45,7 +47,7 @@ vector<node_list_it_t> SPQRTree::STypeNodes()
     vector<node_list_it_t> sameTypeList;
 
     for (auto nit  = nodes().first; nit != nodes().second; nit++ ) {
-        SPQRTreeNode& n = dynamic_cast<SPQRTreeNode&>(*(*nit));
+        SPQRTreeNode& n = downcast<SPQRTreeNode>(*(*nit));
         if (n.type() == SPQRTreeNode::SType) {
             sameTypeList.push_back(nit);
         }
@@ -59,7 +61,7 @@ vector<node_list_it_t> SPQRTree::PTypeNodes()
     vector<node_list_it_t> sameTypeList;
 
     for (auto nit  = nodes().first; nit != nodes().second; nit++ ) {
-        SPQRTreeNode& n = dynamic_cast<SPQRTreeNode&>(*(*nit));
+        SPQRTreeNode& n = downcast<SPQRTreeNode>(*(*nit));
         if (n.type() == SPQRTreeNode::PType) {
             sameTypeList.push_back(nit);
         }
@@ -71,7 +73,7 @@ vector<node_list_it_t> SPQRTree::PTypeNodes()
 void SPQRTree::determineTypes()
 {
     for (auto nit  = nodes().first; nit != nodes().second; nit++ ) {
-        auto& n = dynamic_cast<SPQRTreeNode&>(*(*nit));
+        auto& n = downcast<SPQRTreeNode>(*(*nit));
         auto& c = n.component();
         if (c.numNodes() == 2) {
             n.setType(SPQRTreeNode::PType);
@@ -100,9 +102,9 @@ void SPQRTree::determineTypes()
 void SPQRTree::mergeTwoNodesS(
                    edge_list_it_t treeEdgeIt, node_list_it_t nodeToBeRemovedIt)
 {
-    auto& treeEdge = dynamic_cast<SPQRTreeEdge&>(*(*treeEdgeIt));
-    auto& n1  = dynamic_cast<SPQRTreeNode&>(treeEdge.incidentNode1());
-    auto& n2  = dynamic_cast<SPQRTreeNode&>(treeEdge.incidentNode2());
+    auto& treeEdge = downcast<SPQRTreeEdge>(*(*treeEdgeIt));
+    auto& n1  = downcast<SPQRTreeNode>(treeEdge.incidentNode1());
+    auto& n2  = downcast<SPQRTreeNode>(treeEdge.incidentNode2());
 
     node_list_it_t nodeRemovedIt;
     node_list_it_t nodeExpandedIt;
@@ -122,20 +124,20 @@ void SPQRTree::mergeTwoNodesS(
         virtualEdgeEIt = (*treeEdge.virtualEdge1())->backIt();
 
     }
-    auto& nodeRemoved  = dynamic_cast<SPQRTreeNode&>(*(*nodeRemovedIt));
-    auto& nodeExpanded = dynamic_cast<SPQRTreeNode&>(*(*nodeExpandedIt));
+    auto& nodeRemoved  = downcast<SPQRTreeNode>(*(*nodeRemovedIt));
+    auto& nodeExpanded = downcast<SPQRTreeNode>(*(*nodeExpandedIt));
     auto& componentRemoved  = nodeRemoved.component();
     auto& componentExpanded = nodeExpanded.component();
-    auto& virtualEdgeR = dynamic_cast<SPQRComponentEdge&>(*(*virtualEdgeRIt));
-    auto& virtualEdgeE = dynamic_cast<SPQRComponentEdge&>(*(*virtualEdgeEIt));
+    auto& virtualEdgeR = downcast<SPQRComponentEdge>(*(*virtualEdgeRIt));
+    auto& virtualEdgeE = downcast<SPQRComponentEdge>(*(*virtualEdgeEIt));
     removeEdge(treeEdge);
-    auto& node1R = dynamic_cast<SPQRComponentNode&>(
+    auto& node1R = downcast<SPQRComponentNode>(
                                                 virtualEdgeR.incidentNode1());
-    auto& node2R = dynamic_cast<SPQRComponentNode&>(
+    auto& node2R = downcast<SPQRComponentNode>(
                                                 virtualEdgeR.incidentNode2());
-    auto& node1Eprep = dynamic_cast<SPQRComponentNode&>(
+    auto& node1Eprep = downcast<SPQRComponentNode>(
                                                 virtualEdgeE.incidentNode1());
-    auto& node2Eprep = dynamic_cast<SPQRComponentNode&>(
+    auto& node2Eprep = downcast<SPQRComponentNode>(
                                                 virtualEdgeE.incidentNode2());
     node_list_it_t node1EIt;
     node_list_it_t node2EIt;
@@ -148,8 +150,8 @@ void SPQRTree::mergeTwoNodesS(
         node1EIt = node2Eprep.backIt();
         node2EIt = node1Eprep.backIt();
     }
-    auto& node1E = dynamic_cast<SPQRComponentNode&>(*(*node1EIt));
-    auto& node2E = dynamic_cast<SPQRComponentNode&>(*(*node2EIt));
+    auto& node1E = downcast<SPQRComponentNode>(*(*node1EIt));
+    auto& node2E = downcast<SPQRComponentNode>(*(*node2EIt));
     componentRemoved.removeEdge(virtualEdgeR);
     componentExpanded.removeEdge(virtualEdgeE);
     vector<edge_list_it_t> edgesMerged;
@@ -160,20 +162,20 @@ void SPQRTree::mergeTwoNodesS(
     componentRemoved.moveEdgeInducedSubgraph(edgesMerged, componentExpanded);
 
     // Find the two end edges in (former) compRemoved.
-    auto& edge1R = dynamic_cast<SPQRComponentEdge&>(
+    auto& edge1R = downcast<SPQRComponentEdge>(
                                        *(*(*(node1R.incidentEdges().first))));
-    auto& edge2R = dynamic_cast<SPQRComponentEdge&>(
+    auto& edge2R = downcast<SPQRComponentEdge>(
                                        *(*(*(node2R.incidentEdges().first))));
 
-    auto& edge1E = dynamic_cast<SPQRComponentEdge&>(
+    auto& edge1E = downcast<SPQRComponentEdge>(
                                        *(*(*(node1E.incidentEdges().first))));
-    auto& edge2E = dynamic_cast<SPQRComponentEdge&>(
+    auto& edge2E = downcast<SPQRComponentEdge>(
                                        *(*(*(node2E.incidentEdges().first))));
 
-    auto& theOtherNodeEdge1R = dynamic_cast<SPQRComponentNode&>(
+    auto& theOtherNodeEdge1R = downcast<SPQRComponentNode>(
                                                   edge1R.adjacentNode(node1R));
 
-    auto& theOtherNodeEdge2R = dynamic_cast<SPQRComponentNode&>(
+    auto& theOtherNodeEdge2R = downcast<SPQRComponentNode>(
                                                   edge2R.adjacentNode(node2R));
     // Link the end edges of the cR path to the nodes in cE.
     componentExpanded.moveEdge(edge1R, node1E, theOtherNodeEdge1R);
@@ -184,7 +186,7 @@ void SPQRTree::mergeTwoNodesS(
     auto prevEit = edge1E.backIt();
     auto thisEit = edge1R.backIt();
     while (thisEit != edge2E.backIt()) {
-        auto& edgeThisSide = dynamic_cast<SPQRComponentEdge&>(*(*thisEit));
+        auto& edgeThisSide = downcast<SPQRComponentEdge>(*(*thisEit));
         if (edgeThisSide.type() == SPQRComponentEdge::VirtualType) {
             auto& edgeThatSide     = edgeThisSide.pairVirtualEdge();
             edgeThatSide.setVirtualPair(nodeExpanded.backIt(),
@@ -206,8 +208,8 @@ void SPQRTree::mergeTwoNodesS(
 void SPQRTree::relinkTreeEdge(SPQRTreeEdge& e, SPQRTreeNode& nodeFrom,
                      SPQRTreeNode& nodeTo, SPQRComponentEdge& newVirtualEdge)
 {
-    auto& n1 = dynamic_cast<SPQRTreeNode&>(e.incidentNode1());
-    auto& n2 = dynamic_cast<SPQRTreeNode&>(e.incidentNode2());
+    auto& n1 = downcast<SPQRTreeNode>(e.incidentNode1());
+    auto& n2 = downcast<SPQRTreeNode>(e.incidentNode2());
     if (n1.backIt() == nodeFrom.backIt()) {
         moveEdge(e, nodeTo, n2);
         e.setVirtualEdge1(newVirtualEdge.backIt());
@@ -249,9 +251,9 @@ void SPQRTree::mergeTwoNodesP(
                    edge_list_it_t treeEdgeIt, node_list_it_t nodeToBeRemovedIt)
 {
 
-    auto& treeEdge = dynamic_cast<SPQRTreeEdge&>(*(*treeEdgeIt));
-    auto& n1  = dynamic_cast<SPQRTreeNode&>(treeEdge.incidentNode1());
-    auto& n2  = dynamic_cast<SPQRTreeNode&>(treeEdge.incidentNode2());
+    auto& treeEdge = downcast<SPQRTreeEdge>(*(*treeEdgeIt));
+    auto& n1  = downcast<SPQRTreeNode>(treeEdge.incidentNode1());
+    auto& n2  = downcast<SPQRTreeNode>(treeEdge.incidentNode2());
 
     node_list_it_t nodeRemovedIt;
     node_list_it_t nodeExpandedIt;
@@ -275,25 +277,25 @@ void SPQRTree::mergeTwoNodesP(
 
     }
 
-    auto& nodeRemoved  = dynamic_cast<SPQRTreeNode&>(*(*nodeRemovedIt));
-    auto& nodeExpanded = dynamic_cast<SPQRTreeNode&>(*(*nodeExpandedIt));
+    auto& nodeRemoved  = downcast<SPQRTreeNode>(*(*nodeRemovedIt));
+    auto& nodeExpanded = downcast<SPQRTreeNode>(*(*nodeExpandedIt));
     auto& componentRemoved  = nodeRemoved.component();
     auto& componentExpanded = nodeExpanded.component();
-    auto& virtualEdgeR = dynamic_cast<SPQRComponentEdge&>(*(*virtualEdgeRIt));
-    auto& virtualEdgeE = dynamic_cast<SPQRComponentEdge&>(*(*virtualEdgeEIt));
+    auto& virtualEdgeR = downcast<SPQRComponentEdge>(*(*virtualEdgeRIt));
+    auto& virtualEdgeE = downcast<SPQRComponentEdge>(*(*virtualEdgeEIt));
 
     removeEdge(treeEdge);
 
-    auto& node1R = dynamic_cast<SPQRComponentNode&>(
+    auto& node1R = downcast<SPQRComponentNode>(
                                                 virtualEdgeR.incidentNode1());
 
-    auto& node2R = dynamic_cast<SPQRComponentNode&>(
+    auto& node2R = downcast<SPQRComponentNode>(
                                                 virtualEdgeR.incidentNode2());
 
-    auto& node1Eprep = dynamic_cast<SPQRComponentNode&>(
+    auto& node1Eprep = downcast<SPQRComponentNode>(
                                                 virtualEdgeE.incidentNode1());
 
-    auto& node2Eprep = dynamic_cast<SPQRComponentNode&>(
+    auto& node2Eprep = downcast<SPQRComponentNode>(
                                                 virtualEdgeE.incidentNode2());
 
     node_list_it_t node1EIt;
@@ -310,8 +312,8 @@ void SPQRTree::mergeTwoNodesP(
         node2EIt = node1Eprep.backIt();
     }
 
-    auto& node1E = dynamic_cast<SPQRComponentNode&>(*(*node1EIt));
-    auto& node2E = dynamic_cast<SPQRComponentNode&>(*(*node2EIt));
+    auto& node1E = downcast<SPQRComponentNode>(*(*node1EIt));
+    auto& node2E = downcast<SPQRComponentNode>(*(*node2EIt));
 
     componentRemoved.removeEdge(virtualEdgeR);
 
@@ -337,7 +339,7 @@ void SPQRTree::mergeTwoNodesP(
 
     for (auto eit :node1RincidentEdgesCopy) {
 
-        auto& movedEdge = dynamic_cast<SPQRComponentEdge&>(*(*eit));
+        auto& movedEdge = downcast<SPQRComponentEdge>(*(*eit));
 
         auto& nodeA = movedEdge.incidentNode1();
 
@@ -393,7 +395,7 @@ void SPQRTree::makeFinalTreeNodeAndComponent(
 
     auto  treeNode1Ptr = make_unique<SPQRTreeNode>();
     auto& treeNode1 =
-            dynamic_cast<SPQRTreeNode&>(addNode(move(treeNode1Ptr)));
+            downcast<SPQRTreeNode>(addNode(move(treeNode1Ptr)));
     auto& comp1        = treeNode1.component();
     treeNode1.linkComponent();
 
@@ -402,14 +404,14 @@ void SPQRTree::makeFinalTreeNodeAndComponent(
 
     for (auto nit : nodesInGToBeCopied) {
 
-        SPQR_DFS_Node& n = dynamic_cast<SPQR_DFS_Node&>(*(*nit));
+        SPQR_DFS_Node& n = downcast<SPQR_DFS_Node>(*(*nit));
         auto newNodePtr = make_unique<SPQRComponentNode>(n.IGBackwardLink());
         nodePairs.push_back(make_pair(nit,move(newNodePtr)));
 
     }
 
     for (auto eit : edgesInGToBeCopied) {
-        SPQR_DFS_Edge& e = dynamic_cast<SPQR_DFS_Edge&>(*(*eit));
+        SPQR_DFS_Edge& e = downcast<SPQR_DFS_Edge>(*(*eit));
 
         if (e.mIsVirtual) {
             edgePairs.push_back(make_pair(eit,
@@ -485,7 +487,7 @@ void SPQRTree::makeNewNodesEdgesAndComponents(
                                      = G.edgeInducedNodes(edgesInGToBeCopied);
     auto  treeNode1Ptr = make_unique<SPQRTreeNode>();
     auto& treeNode1 =
-            dynamic_cast<SPQRTreeNode&>(addNode(move(treeNode1Ptr)));
+            downcast<SPQRTreeNode>(addNode(move(treeNode1Ptr)));
     auto& comp1        = treeNode1.component();
     treeNode1.linkComponent();
 
@@ -496,7 +498,7 @@ void SPQRTree::makeNewNodesEdgesAndComponents(
     patchUpVirtualEdges(treeNode1);
     auto  virtualEdgeABInComp1Ptr
                            = make_unique<SPQRComponentEdge>(G.edges().second);
-    auto& virtualEdgeABInComp1 = dynamic_cast<SPQRComponentEdge&>(
+    auto& virtualEdgeABInComp1 = downcast<SPQRComponentEdge>(
                             comp1.addEdge( move(virtualEdgeABInComp1Ptr),
                             *(*nodeAInComp1It),
                             *(*nodeBInComp1It)                              ));
@@ -504,11 +506,11 @@ void SPQRTree::makeNewNodesEdgesAndComponents(
 
         auto  treeNode2Ptr = make_unique<SPQRTreeNode>();
         auto& treeNode2 =
-                dynamic_cast<SPQRTreeNode&>(addNode(move(treeNode2Ptr)));
+                downcast<SPQRTreeNode>(addNode(move(treeNode2Ptr)));
         auto& comp2        = treeNode2.component();
         treeNode2.linkComponent();
 
-        auto& virtualEdgeABInComp3 = dynamic_cast<SPQRComponentEdge&>(
+        auto& virtualEdgeABInComp3 = downcast<SPQRComponentEdge>(
                                                   *(*virtualEdgeABInComp3It));
 
         vector<edge_list_it_t> edgesInGextra;
@@ -523,21 +525,21 @@ void SPQRTree::makeNewNodesEdgesAndComponents(
 
         auto  virtualEdge1InComp2Ptr
                            = make_unique<SPQRComponentEdge>(G.edges().second);
-        auto& virtualEdge1InComp2 = dynamic_cast<SPQRComponentEdge&>(
+        auto& virtualEdge1InComp2 = downcast<SPQRComponentEdge>(
                             comp2.addEdge( move(virtualEdge1InComp2Ptr),
                             *(*nodeAInComp2It),
                             *(*nodeBInComp2It)                              ));
 
         auto  virtualEdge2InComp2Ptr
                            = make_unique<SPQRComponentEdge>(G.edges().second);
-        auto& virtualEdge2InComp2 = dynamic_cast<SPQRComponentEdge&>(
+        auto& virtualEdge2InComp2 = downcast<SPQRComponentEdge>(
                             comp2.addEdge( move(virtualEdge2InComp2Ptr),
                             *(*nodeAInComp2It),
                             *(*nodeBInComp2It)                              ));
 
         auto  virtualEdge3InComp2Ptr
                            = make_unique<SPQRComponentEdge>(G.edges().second);
-        auto& virtualEdge3InComp2 = dynamic_cast<SPQRComponentEdge&>(
+        auto& virtualEdge3InComp2 = downcast<SPQRComponentEdge>(
                             comp2.addEdge( move(virtualEdge3InComp2Ptr),
                             *(*nodeAInComp2It),
                             *(*nodeBInComp2It)                              ));
@@ -578,7 +580,7 @@ void SPQRTree::makeNewNodesEdgesAndComponents(
 
         auto  treeNode2Ptr = make_unique<SPQRTreeNode>();
         auto& treeNode2 =
-                dynamic_cast<SPQRTreeNode&>(addNode(move(treeNode2Ptr)));
+                downcast<SPQRTreeNode>(addNode(move(treeNode2Ptr)));
         auto& comp2        = treeNode2.component();
         treeNode2.linkComponent();
         vector<edge_list_it_t> edgesInGextra;
@@ -595,14 +597,14 @@ void SPQRTree::makeNewNodesEdgesAndComponents(
 
         auto  virtualEdge1InComp2Ptr
                            = make_unique<SPQRComponentEdge>(G.edges().second);
-        auto& virtualEdge1InComp2 = dynamic_cast<SPQRComponentEdge&>(
+        auto& virtualEdge1InComp2 = downcast<SPQRComponentEdge>(
                             comp2.addEdge( move(virtualEdge1InComp2Ptr),
                             *(*nodeAInComp2It),
                             *(*nodeBInComp2It)                              ));
 
         auto  virtualEdge2InComp2Ptr
                            = make_unique<SPQRComponentEdge>(G.edges().second);
-        auto& virtualEdge2InComp2 = dynamic_cast<SPQRComponentEdge&>(
+        auto& virtualEdge2InComp2 = downcast<SPQRComponentEdge>(
                             comp2.addEdge( move(virtualEdge2InComp2Ptr),
                             *(*nodeAInComp2It),
                             *(*nodeBInComp2It)                              ));
@@ -650,7 +652,7 @@ void SPQRTree::fillInComponent(
 
     for (auto nit : nodesInGToBeCopied) {
 
-        SPQR_DFS_Node& n = dynamic_cast<SPQR_DFS_Node&>(*(*nit));
+        SPQR_DFS_Node& n = downcast<SPQR_DFS_Node>(*(*nit));
         auto newNodePtr = make_unique<SPQRComponentNode>(n.IGBackwardLink());
         nodePairs.push_back(make_pair(nit,move(newNodePtr)));
 
@@ -658,7 +660,7 @@ void SPQRTree::fillInComponent(
 
     for (auto eit : edgesInGToBeCopied) {
 
-        SPQR_DFS_Edge& e = dynamic_cast<SPQR_DFS_Edge&>(*(*eit));
+        SPQR_DFS_Edge& e = downcast<SPQR_DFS_Edge>(*(*eit));
 
         if (e.mIsVirtual) {
             edgePairs.push_back(make_pair(eit,
@@ -673,14 +675,14 @@ void SPQRTree::fillInComponent(
 
     }
 
-    SPQR_DFS_Node& nodeAInG = dynamic_cast<SPQR_DFS_Node&>(*(*nodeAInGIt));
-    SPQR_DFS_Node& nodeBInG = dynamic_cast<SPQR_DFS_Node&>(*(*nodeBInGIt));
+    SPQR_DFS_Node& nodeAInG = downcast<SPQR_DFS_Node>(*(*nodeAInGIt));
+    SPQR_DFS_Node& nodeBInG = downcast<SPQR_DFS_Node>(*(*nodeBInGIt));
 
     G.copySubgraph(nodePairs, edgePairs, comp);
 
     for (auto nit = comp.nodes().first ; nit != comp.nodes().second; nit++) {
 
-        SPQRComponentNode& n = dynamic_cast<SPQRComponentNode&>(*(*nit));
+        SPQRComponentNode& n = downcast<SPQRComponentNode>(*(*nit));
 
         if (n.IGBackwardLink() == nodeAInG.IGBackwardLink()) {
             nodeAInComp1It = n.backIt();
@@ -704,7 +706,7 @@ void SPQRTree::patchUpVirtualEdges(SPQRTreeNode& tnThisSide) {
     for (auto eit = compThisSide.edges().first ;
                                eit != compThisSide.edges().second; eit++) {
         SPQRComponentEdge& eThisSide 
-                                  = dynamic_cast<SPQRComponentEdge&>(*(*eit));
+                                  = downcast<SPQRComponentEdge>(*(*eit));
         if (eThisSide.type() == SPQRComponentEdge::VirtualType) {
             SPQRComponentEdge& eTheOtherSide = eThisSide.pairVirtualEdge();
             SPQRTreeNode& tnTheOtherSide = eThisSide.pairTreeNode();
@@ -721,6 +723,485 @@ void SPQRTree::patchUpVirtualEdges(SPQRTreeNode& tnThisSide) {
     }    
 }
 
+/** @brief returns the tree node whose component has the given node.
+ */
+static SPQRTreeNode& treeNodeOf(node_list_it_t cnit)
+{
+    return downcast<SPQRComponent>((*(*cnit)).graph()).SPQRTreeNode();
+}
+
+
+/** @brief returns the original node of the given component node.
+ */
+static inline const Node* originalOf(node_list_it_t cnit)
+{
+    return &(*(*((*(*cnit)).IGBackwardLink())));
+}
+
+
+/** @brief walks the cycle of the component of an S node.
+ *
+ *  @param  start   (in):  component node from which the walk starts.
+ *
+ *  @param  hasPrev (in):  true if the walk must not leave start through
+ *                         prevEit.
+ *
+ *  @param  prevEit (in):  the edge that is walked last if hasPrev is true.
+ *
+ *  @param  edges   (out): the edges in the order of the walk.
+ *
+ *  @param  from    (out): the node from which each edge is walked.
+ */
+static void walkCycle(
+    Node&                   start,
+    bool                    hasPrev,
+    edge_list_it_t          prevEit,
+    vector<edge_list_it_t>& edges,
+    vector<node_list_it_t>& from
+) {
+    size_t numEdges = start.graph().numEdges();
+    Node*  cur      = &start;
+    for (size_t i = 0; i < numEdges; i++) {
+        auto iit  = cur->incidentEdges().first;
+        auto next = *iit;
+        if ((hasPrev || i > 0) && next == prevEit) {
+            iit++;
+            next = *iit;
+        }
+        edges.push_back(next);
+        from.push_back(cur->backIt());
+        cur     = &((*(*next)).adjacentNode(*cur));
+        prevEit = next;
+    }
+}
+
+
+void SPQRTree::buildAllocations()
+{
+    if (mAllocationsBuilt) {
+        return;
+    }
+    for (auto tnit = nodes().first; tnit != nodes().second; tnit++) {
+        auto& C = downcast<SPQRTreeNode>(*(*tnit)).component();
+        for (auto cnit = C.nodes().first; cnit != C.nodes().second; cnit++) {
+            mAllocations[originalOf(cnit)].push_back(cnit);
+        }
+    }
+    mAllocationsBuilt = true;
+}
+
+
+node_list_it_t SPQRTree::componentNode(
+    SPQRTreeNode&  tn,
+    node_list_it_t orgNit
+) {
+    auto& locs = mAllocations[&(*(*orgNit))];
+    for (auto cnit : locs) {
+        if (&((*(*cnit)).graph()) == &(tn.component())) {
+            return cnit;
+        }
+    }
+    auto& CN = tn.component().addNode(make_unique<SPQRComponentNode>(orgNit));
+    locs.push_back(CN.backIt());
+    return CN.backIt();
+}
+
+
+SPQRTreeNode& SPQRTree::addTreeNode()
+{
+    auto& TN = downcast<SPQRTreeNode>(addNode(make_unique<SPQRTreeNode>()));
+    TN.linkComponent();
+    return TN;
+}
+
+
+void SPQRTree::removeTreeNode(SPQRTreeNode& tn)
+{
+    auto& C = tn.component();
+    for (auto cnit = C.nodes().first; cnit != C.nodes().second; cnit++) {
+        auto  lit  = mAllocations.find(originalOf(cnit));
+        auto& locs = lit->second;
+        for (size_t i = 0; i < locs.size(); i++) {
+            if (*(locs[i]) == *cnit) {
+                locs[i] = locs.back();
+                locs.pop_back();
+                break;
+            }
+        }
+        if (locs.empty()) {
+            mAllocations.erase(lit);
+        }
+    }
+    removeNode(tn);
+}
+
+
+void SPQRTree::addOrdinaryEdge(SPQRTreeNode& tn, edge_list_it_t orgEit)
+{
+    auto& E   = *(*orgEit);
+    auto  cn1 = componentNode(tn, E.incidentNode1().backIt());
+    auto  cn2 = componentNode(tn, E.incidentNode2().backIt());
+    auto& CE  = tn.component().addEdge(
+                    make_unique<SPQRComponentEdge>(orgEit), *(*cn1), *(*cn2));
+
+    utility_t edgeType = (tn.type()==SPQRTreeNode::PType)?
+                                     SPQRTree::kForwardEdgeTypeSeparatingEdge:
+                                     SPQRTree::kForwardEdgeTypeOrdinaryEdge;
+    if (E.IGForwardLinksSize() == 0) {
+        E.pushIGForwardLink(CE.backIt());
+    }
+    else {
+        E.setIGForwardLink(CE.backIt());
+    }
+    if (E.utilitySize() == 0) {
+        E.pushUtility(edgeType);
+    }
+    else {
+        E.setUtility(edgeType);
+    }
+}
+
+
+void SPQRTree::transferEdge(
+    SPQRComponentEdge& ce,
+    SPQRTreeNode&      nodeFrom,
+    SPQRTreeNode&      nodeTo
+) {
+    if (ce.type() == SPQRComponentEdge::OrdinaryType) {
+        addOrdinaryEdge(nodeTo, ce.IGBackwardLink());
+        return;
+    }
+    auto  cn1 = componentNode(nodeTo, ce.incidentNode1().IGBackwardLink());
+    auto  cn2 = componentNode(nodeTo, ce.incidentNode2().IGBackwardLink());
+    auto& PE  = ce.pairVirtualEdge();
+    auto& PT  = ce.pairTreeNode();
+    auto& TE  = ce.treeEdge();
+    auto& NE  = downcast<SPQRComponentEdge>(nodeTo.component().addEdge(
+                   make_unique<SPQRComponentEdge>(PE.backIt(), PT.backIt()),
+                   *(*cn1), *(*cn2)                                        ));
+    NE.setTreeEdge(TE.backIt());
+    PE.setVirtualPair(nodeTo.backIt(), NE.backIt());
+    relinkTreeEdge(TE, nodeFrom, nodeTo, NE);
+}
+
+
+void SPQRTree::addVirtualPair(
+    SPQRTreeNode&  tn1,
+    SPQRTreeNode&  tn2,
+    node_list_it_t orgNitA,
+    node_list_it_t orgNitB
+) {
+    auto  a1  = componentNode(tn1, orgNitA);
+    auto  b1  = componentNode(tn1, orgNitB);
+    auto  a2  = componentNode(tn2, orgNitA);
+    auto  b2  = componentNode(tn2, orgNitB);
+    auto& VE1 = downcast<SPQRComponentEdge>(tn1.component().addEdge(
+                   make_unique<SPQRComponentEdge>(mOriginal->edges().second),
+                   *(*a1), *(*b1)                                          ));
+    auto& VE2 = downcast<SPQRComponentEdge>(tn2.component().addEdge(
+                   make_unique<SPQRComponentEdge>(mOriginal->edges().second),
+                   *(*a2), *(*b2)                                          ));
+    VE1.setVirtualPair(tn2.backIt(), VE2.backIt());
+    VE2.setVirtualPair(tn1.backIt(), VE1.backIt());
+    auto& TE = addEdge(make_unique<SPQRTreeEdge>(VE1.backIt(), VE2.backIt()),
+                       tn1, tn2);
+    VE1.setTreeEdge(TE.backIt());
+    VE2.setTreeEdge(TE.backIt());
+}
+
+
+void SPQRTree::condenseEdges(
+    SPQRTreeNode&           nodeFrom,
+    SPQRTreeNode&           nodeTo,
+    vector<edge_list_it_t>& edges,
+    bool                    series,
+    node_list_it_t          orgNitA,
+    node_list_it_t          orgNitB
+) {
+    if (edges.size() == 0) {
+        return;
+    }
+    if (edges.size() == 1) {
+        auto& CE = downcast<SPQRComponentEdge>(*(*(edges[0])));
+        transferEdge(CE, nodeFrom, nodeTo);
+        return;
+    }
+    auto& TN = addTreeNode();
+    TN.setType(series ? SPQRTreeNode::SType : SPQRTreeNode::PType);
+    for (auto eit : edges) {
+        transferEdge(downcast<SPQRComponentEdge>(*(*eit)), nodeFrom, TN);
+    }
+    addVirtualPair(nodeTo, TN, orgNitA, orgNitB);
+}
+
+
+void SPQRTree::insertEdge(edge_list_it_t eit)
+{
+    buildAllocations();
+
+    auto& E    = *(*eit);
+    auto  uIt  = E.incidentNode1().backIt();
+    auto  vIt  = E.incidentNode2().backIt();
+    auto  uLoc = mAllocations.find(&(E.incidentNode1()));
+    auto  vLoc = mAllocations.find(&(E.incidentNode2()));
+    if (uLoc == mAllocations.end() || vLoc == mAllocations.end()) {
+        throw std::invalid_argument(Constants::kExceptionNodeNotInGraph);
+    }
+
+    // Tree nodes that have U, and those that have both U and V.
+    unordered_map<const Node*, node_list_it_t> uTreeNodes;
+    for (auto cnit : uLoc->second) {
+        uTreeNodes[&(treeNodeOf(cnit))] = cnit;
+    }
+    unordered_map<const Node*, node_list_it_t> vTreeNodes;
+    vector<pair<node_list_it_t, node_list_it_t>> common;
+    for (auto cnit : vLoc->second) {
+        auto& TN = treeNodeOf(cnit);
+        vTreeNodes[&TN] = cnit;
+        auto uit = uTreeNodes.find(&TN);
+        if (uit != uTreeNodes.end()) {
+            common.push_back(make_pair(uit->second, cnit));
+        }
+    }
+
+    if (common.size() > 0) {
+
+        for (auto& c : common) {
+            auto& TN = treeNodeOf(c.first);
+            if (TN.type() == SPQRTreeNode::PType) {
+                // {U,V} is the separation pair of this P node.
+                addOrdinaryEdge(TN, eit);
+                return;
+            }
+        }
+
+        // If U and V are in two tree nodes, they are linked with virtual
+        // edges {U,V}. Otherwise there may be a real edge {U,V}.
+        auto& TN = treeNodeOf(common[0].first);
+        auto& CU = *(*(common[0].first));
+        auto& CV = *(*(common[0].second));
+        auto  ceit = TN.component().edges().second;
+        for (auto iit  = CU.incidentEdges().first;
+                  iit != CU.incidentEdges().second; iit++) {
+            if (&((*(*(*iit))).adjacentNode(CU)) == &CV) {
+                ceit = *iit;
+                break;
+            }
+        }
+
+        if (ceit != TN.component().edges().second) {
+            // Put the existing edge and the new one in a new P node.
+            auto& CE  = downcast<SPQRComponentEdge>(*(*ceit));
+            auto& TNP = addTreeNode();
+            TNP.setType(SPQRTreeNode::PType);
+            transferEdge(CE, TN, TNP);
+            TN.component().removeEdge(CE);
+            addVirtualPair(TN, TNP, uIt, vIt);
+            addOrdinaryEdge(TNP, eit);
+        }
+        else if (TN.type() == SPQRTreeNode::RType) {
+            addOrdinaryEdge(TN, eit);
+        }
+        else {
+            // Split the cycle at U and V into two S nodes joined by a new
+            // P node.
+            vector<edge_list_it_t> edges;
+            vector<node_list_it_t> from;
+            walkCycle(CU, false, TN.component().edges().second, edges, from);
+            size_t k = 0;
+            while (&(*(*(from[k]))) != &CV) {
+                k++;
+            }
+            vector<edge_list_it_t> path1(edges.begin(), edges.begin() + k);
+            vector<edge_list_it_t> path2(edges.begin() + k, edges.end());
+            auto& TNP = addTreeNode();
+            TNP.setType(SPQRTreeNode::PType);
+            condenseEdges(TN, TNP, path1, true, uIt, vIt);
+            condenseEdges(TN, TNP, path2, true, uIt, vIt);
+            addOrdinaryEdge(TNP, eit);
+            removeTreeNode(TN);
+        }
+        return;
+    }
+
+    // Find the shortest tree path from a tree node that has U to one that
+    // has V by a breadth-first search.
+    unordered_map<const Node*, edge_list_it_t> reached;
+    vector<SPQRTreeNode*>                      queue;
+    for (auto cnit : uLoc->second) {
+        auto& TN = treeNodeOf(cnit);
+        reached[&TN] = edges().second;
+        queue.push_back(&TN);
+    }
+    SPQRTreeNode* target = nullptr;
+    for (size_t head = 0; head < queue.size() && target == nullptr; head++) {
+        auto& TN = *(queue[head]);
+        for (auto iit  = TN.incidentEdges().first;
+                  iit != TN.incidentEdges().second; iit++) {
+            auto& TA = downcast<SPQRTreeNode>((*(*(*iit))).adjacentNode(TN));
+            if (reached.find(&TA) != reached.end()) {
+                continue;
+            }
+            reached[&TA] = *iit;
+            if (vTreeNodes.find(&TA) != vTreeNodes.end()) {
+                target = &TA;
+                break;
+            }
+            queue.push_back(&TA);
+        }
+    }
+
+    vector<SPQRTreeNode*>  pathNodes;
+    vector<edge_list_it_t> pathEdges;
+    pathNodes.push_back(target);
+    while (reached[pathNodes.back()] != edges().second) {
+        auto teit = reached[pathNodes.back()];
+        pathEdges.push_back(teit);
+        pathNodes.push_back(&(downcast<SPQRTreeNode>(
+                           (*(*teit)).adjacentNode(*(pathNodes.back())))));
+    }
+    reverse(pathNodes.begin(), pathNodes.end());
+    reverse(pathEdges.begin(), pathEdges.end());
+
+    // Merge the tree nodes on the path into a new R node.
+    // The virtual edges between them are dropped, and the components are
+    // glued at their end nodes.
+    auto& TNR = addTreeNode();
+    TNR.setType(SPQRTreeNode::RType);
+    auto  cEnd = TNR.component().edges().second;
+    for (size_t i = 0; i < pathNodes.size(); i++) {
+
+        auto& TN    = *(pathNodes[i]);
+        auto& C     = TN.component();
+        auto  prevE = C.edges().second;
+        auto  nextE = C.edges().second;
+        if (i > 0) {
+            auto& TE = downcast<SPQRTreeEdge>(*(*(pathEdges[i-1])));
+            prevE = (&(TE.incidentNode1()) == &TN) ?
+                                      TE.virtualEdge1() : TE.virtualEdge2();
+        }
+        if (i < pathEdges.size()) {
+            auto& TE = downcast<SPQRTreeEdge>(*(*(pathEdges[i])));
+            nextE = (&(TE.incidentNode1()) == &TN) ?
+                                      TE.virtualEdge1() : TE.virtualEdge2();
+        }
+
+        if (TN.type() == SPQRTreeNode::RType) {
+
+            for (auto ceit = C.edges().first; ceit != C.edges().second;
+                                                                   ceit++) {
+                if (ceit != prevE && ceit != nextE) {
+                    transferEdge(
+                               downcast<SPQRComponentEdge>(*(*ceit)), TN, TNR);
+                }
+            }
+        }
+        else if (TN.type() == SPQRTreeNode::PType) {
+
+            // Only an inner node on the path can be a P node.
+            vector<edge_list_it_t> rest;
+            for (auto ceit = C.edges().first; ceit != C.edges().second;
+                                                                   ceit++) {
+                if (ceit != prevE && ceit != nextE) {
+                    rest.push_back(ceit);
+                }
+            }
+            auto cnit = C.nodes().first;
+            auto aIt  = (*(*cnit)).IGBackwardLink();
+            cnit++;
+            auto bIt  = (*(*cnit)).IGBackwardLink();
+            condenseEdges(TN, TNR, rest, false, aIt, bIt);
+        }
+        else {
+
+            // The cycle is split by the two marks, which are U or prevE at
+            // the start, and nextE or V at the end.
+            vector<edge_list_it_t> edges;
+            vector<node_list_it_t> from;
+            Node* start;
+            Node* end;
+            if (i == 0) {
+                start = &(*(*(uTreeNodes[&TN])));
+                end   = start;
+                walkCycle(*start, false, cEnd, edges, from);
+            }
+            else {
+                auto& PE = *(*prevE);
+                start = &(PE.incidentNode2());
+                end   = &(PE.incidentNode1());
+                walkCycle(*start, true, prevE, edges, from);
+                edges.pop_back();
+                from.pop_back();
+            }
+
+            size_t k = 0;
+            Node*  midA;
+            Node*  midB;
+            if (i == pathNodes.size() - 1) {
+                auto& CV = *(*(vTreeNodes[&TN]));
+                while (&(*(*(from[k]))) != &CV) {
+                    k++;
+                }
+                midA = &CV;
+                midB = &CV;
+            }
+            else {
+                while (edges[k] != nextE) {
+                    k++;
+                }
+                midA = &(*(*(from[k])));
+                midB = &((*(*nextE)).adjacentNode(*midA));
+            }
+            vector<edge_list_it_t> pathA(edges.begin(), edges.begin() + k);
+            vector<edge_list_it_t> pathB(
+                      edges.begin() + ((midA == midB) ? k : (k + 1)),
+                      edges.end());
+            condenseEdges(TN, TNR, pathA, true,
+                          start->IGBackwardLink(), midA->IGBackwardLink());
+            condenseEdges(TN, TNR, pathB, true,
+                          midB->IGBackwardLink(), end->IGBackwardLink());
+        }
+    }
+
+    addOrdinaryEdge(TNR, eit);
+
+    for (auto tnp : pathNodes) {
+        removeTreeNode(*tnp);
+    }
+}
+
+
+void SPQRTree::subdivideEdge(
+    edge_list_it_t eit,
+    edge_list_it_t eit1,
+    edge_list_it_t eit2
+) {
+    buildAllocations();
+
+    auto& E  = *(*eit);
+    auto& CE = downcast<SPQRComponentEdge>(*(*(E.IGForwardLink())));
+    auto& TN = treeNodeOf(CE.incidentNode1().backIt());
+    auto  aIt = E.incidentNode1().backIt();
+    auto  bIt = E.incidentNode2().backIt();
+
+    TN.component().removeEdge(CE);
+
+    if (TN.type() == SPQRTreeNode::SType) {
+        // The cycle gets longer.
+        addOrdinaryEdge(TN, eit1);
+        addOrdinaryEdge(TN, eit2);
+    }
+    else {
+        // Replace the edge with a virtual edge to a new triangle.
+        auto& TNS = addTreeNode();
+        TNS.setType(SPQRTreeNode::SType);
+        addVirtualPair(TN, TNS, aIt, bIt);
+        addOrdinaryEdge(TNS, eit1);
+        addOrdinaryEdge(TNS, eit2);
+    }
+}
+
+
 }// namespace Undirected
 
 }// namespace Wailea
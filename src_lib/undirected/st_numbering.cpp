@@ -20,6 +20,8 @@
  *        If the given graph G does not have {s,t}, then G + {s,t} must be
  *        biconnected.  
  *
+ *        Both of the DFS steps run on the arrays of CompactGraph. A Graph
+ *        is converted to CompactGraph first.
  */
 namespace Wailea {
 
@@ -28,284 +30,146 @@ namespace Undirected {
 using namespace std;
 
 
-/** @class STStrategyProc1
- *
- *  @brief the first DFS in which the palm-tree is formed and
- *         the pre, and low numbers  are calculated for each node.
- */
-class STStrategyProc1 : public DFSStrategy<Graph, ST_DFS_Node, ST_DFS_Edge> {
-
-  public:
-    STStrategyProc1():mI(0){;}
-    inline virtual ~STStrategyProc1(){;}
-
-    // The following 4 functions are the hook points to DFSExplorer
-    void enterNode(DNode& n) noexcept override;
-    void processFrond(DNode& n, DEdge& c) noexcept override;
-    void beforeVisitingChild(DNode& n, DEdge& c) noexcept override;
-    void afterVisitingChild(DNode& n, DEdge& c) noexcept override;
-
-  private:
-
-    /**  @brief the last number assigned to the node.
-    */
-    size_t  mI;
-
-#ifdef UNIT_TESTS
-  friend class STNumberingTests;
-#endif
-
-};
-
-
-void STStrategyProc1::enterNode(DNode& v) noexcept
-{
-    mI++;
-    v.mPre = mI;
-    v.mLow = mI;
-    
-
-    if (v.mPre == 1) {
-        v.mParentEdge = v.graph().edges().second;
-    }
-}
-
-
-void STStrategyProc1::processFrond(DNode& v,DEdge& vw) noexcept
-{
-    auto& w = dynamic_cast<DNode&>(vw.adjacentNode(v));
-
-    vw.mType   = ST_DFS_Edge::FrondType;
-
-    if (w.mPre < v.mLow) {
-        v.mLow = w.mPre;
-    }
-}
-
-
-void STStrategyProc1::beforeVisitingChild(DNode& v, DEdge& vw) noexcept
-{
-    vw.mType = ST_DFS_Edge::TreeArcType;
-}
-
-
-void STStrategyProc1::afterVisitingChild(DNode& v, DEdge& vw) noexcept
-{
-
-    auto& w = dynamic_cast<DNode&>(vw.adjacentNode(v));
-
-    if (w.mLow < v.mLow) {
-        v.mLow = w.mLow;
+vector<cg_index_t> STNumbering::getBipolarOrientation(
+    const CompactGraph& g,
+    cg_index_t          s,
+    cg_index_t          t
+) {
+    const cg_index_t kNone   = CompactGraph::kInvalidIndex;
+    size_t           numNodes = g.numNodes();
+
+    // Step 1. The palm tree from s with {s,t} as the first tree arc.
+    // The DFS stack holds each node on the path from s and the next
+    // incident edge of the node to explore.
+    vector<size_t>     pre(numNodes, 0);
+    vector<size_t>     low(numNodes, 0);
+    vector<cg_index_t> parent(numNodes, kNone);
+    vector<cg_index_t> preOrder;
+    vector<bool>       edgeVisited(g.numEdges(), false);
+    vector<pair<cg_index_t, const cg_index_t*>> stack;
+    preOrder.reserve(numNodes);
+    stack.reserve(numNodes);
+
+    auto enterNode = [&](cg_index_t v, cg_index_t p) {
+        preOrder.push_back(v);
+        pre[v]    = preOrder.size();
+        low[v]    = pre[v];
+        parent[v] = p;
+        stack.push_back(make_pair(v, g.incidentEdges(v).first));
+    };
+
+    enterNode(s, kNone);
+    for (auto iit  = g.incidentEdges(s).first;
+              iit != g.incidentEdges(s).second; iit++) {
+        if (g.adjacentNode(*iit, s) == t) {
+            edgeVisited[*iit] = true;
+            break;
+        }
     }
+    enterNode(t, s);
+
+    while (!stack.empty()) {
+
+        cg_index_t v = stack.back().first;
+
+        if (stack.back().second == g.incidentEdges(v).second) {
+            // Going back to the parent node.
+            stack.pop_back();
+            if (!stack.empty()) {
+                cg_index_t p = stack.back().first;
+                if (low[v] < low[p]) {
+                    low[p] = low[v];
+                }
+            }
+            continue;
+        }
 
-    w.mParentEdge = vw.backIt();
-}
-
-
-/** @class STStrategyProc2
- *
- *  @brief the second DFS in which the bipolar orientation list L is formed.
- */
-class STStrategyProc2 : public DFSStrategy<Graph, ST_DFS_Node, ST_DFS_Edge> {
-                    
-
-  public:
-    STStrategyProc2(){;}
-    inline virtual ~STStrategyProc2(){;}
-
-    void prepareNodesAndEdges(Graph &g, DNode& s, DNode&t);
-
-    // The following function is the hook points to DFSExplorer
-    void enterNode(DNode& n) noexcept override;
-
-    vector<node_list_it_t> getL() const;
-
-  private:
-
-    /** @brief create a map from mPre to the iterator to its node.
-     *
-     *  @param g (in): The input graph that has ST_DFS_Nodes with mPre set.
-     */
-    void createNodeMap(Graph &g);
-
-
-    /** @brief mapping from pre number to the node iterator.
-     */
-    vector<node_list_it_t> mNMap;
-
-
-    /**  @brief the bipolar orientation list.
-     */
-    list<node_list_it_t> mL;
-
-
-    /**  @brief the source node
-     */
-    node_list_it_t       mNodeS;
-
-
-    /**  @brief the destination node
-     */
-    node_list_it_t       mNodeT;
-
-
-#ifdef UNIT_TESTS
-  friend class STNumberingTests;
-#endif
-
-};
-
-
-void STStrategyProc2::prepareNodesAndEdges(Graph& g, DNode& s, DNode& t)
-{
-    mNodeS = s.backIt();
-    mNodeT = t.backIt();
-
-    s.mSignPlus = false;
-    s.mItForL = mL.insert(mL.end(),mNodeS);
-    t.mItForL = mL.insert(mL.end(),mNodeT);
-
-    createNodeMap(g);
-}
-
+        cg_index_t e = *(stack.back().second++);
+        if (edgeVisited[e]) {
+            continue;
+        }
+        edgeVisited[e] = true;
 
-void STStrategyProc2::enterNode(DNode& v) noexcept
-{
-    if (v.backIt()==mNodeS || v.backIt()==mNodeT) {
-        return;
+        cg_index_t w = g.adjacentNode(e, v);
+        if (pre[w] == 0) {
+            // Tree arc.
+            enterNode(w, v);
+        }
+        else if (pre[w] < low[v]) {
+            // Frond.
+            low[v] = pre[w];
+        }
     }
 
-    auto& pLow    = dynamic_cast<DNode&>(*(*mNMap[v.mLow]));
-    auto& vParent = dynamic_cast<DNode&>((*(v.mParentEdge))->adjacentNode(v));
-
-    if (pLow.mSignPlus) {
-
-        auto insersionPoint = vParent.mItForL;
-        insersionPoint++;
-        v.mItForL = mL.insert(insersionPoint, v.backIt());
-        vParent.mSignPlus = false;
-
+    // Step 2. The list L in the pre-order, which is the order in which
+    // the second DFS enters the nodes.
+    vector<bool>       signPlus(numNodes, false);
+    vector<cg_index_t> next(numNodes, kNone);
+    vector<cg_index_t> prev(numNodes, kNone);
+    next[s] = t;
+    prev[t] = s;
+
+    for (size_t i = 2; i < preOrder.size(); i++) {
+
+        cg_index_t v    = preOrder[i];
+        cg_index_t p    = parent[v];
+        cg_index_t pLow = preOrder[low[v] - 1];
+
+        if (signPlus[pLow]) {
+            // Insert v after p.
+            next[v] = next[p];
+            prev[v] = p;
+            if (next[p] != kNone) {
+                prev[next[p]] = v;
+            }
+            next[p] = v;
+            signPlus[p] = false;
+        }
+        else {
+            // Insert v before p.
+            prev[v] = prev[p];
+            next[v] = p;
+            if (prev[p] != kNone) {
+                next[prev[p]] = v;
+            }
+            prev[p] = v;
+            signPlus[p] = true;
+        }
     }
-    else {
-
-        v.mItForL = mL.insert(vParent.mItForL, v.backIt());
-        vParent.mSignPlus = true;
 
+    vector<cg_index_t> L;
+    L.reserve(preOrder.size());
+    for (cg_index_t v = s; v != kNone; v = next[v]) {
+        L.push_back(v);
     }
+    return L; // rvo
 }
 
 
-void STStrategyProc2::createNodeMap(Graph &g)
+vector<node_list_it_t> STNumbering::getBipolarOrientation(
+                                                  Graph& g, Node& s, Node& t)
 {
-    size_t numNodes = g.numNodes();
-    mNMap.reserve(numNodes+1);
-    node_list_it_t blankIt;
-    for (size_t i = 0; i < numNodes + 1; i++) {
-        mNMap.push_back(blankIt);
-    }
+    CompactGraph cg;
+    cg.build(g);
 
+    cg_index_t sIndex = 0;
+    cg_index_t tIndex = 0;
+    cg_index_t index  = 0;
     for (auto nit = g.nodes().first; nit != g.nodes().second; nit++) {
-        ST_DFS_Node& n = dynamic_cast<ST_DFS_Node&>(*(*nit));
-        mNMap[n.mPre] = n.backIt();
-    }
-}
-
-
-vector<node_list_it_t> STStrategyProc2::getL() const
-{
-    vector<node_list_it_t> vecReturned;
-    for (auto it = mL.begin(); it != mL.end(); it++) {
-        auto& n = dynamic_cast<DNode&>(*(*(*it)));
-        vecReturned.push_back(n.mOriginal);
-    }
-    return vecReturned; // rvo
-}
-
-
-void STNumbering::copyInputGraph(
-    Graph& src, Graph& dst,
-    node_list_it_t srcIt, node_list_it_t& srcCopyIt,
-    node_list_it_t dstIt, node_list_it_t& dstCopyIt )
-{
-    vector<pair<node_list_it_t,node_ptr_t>> nodePairs;
-    vector<pair<edge_list_it_t,edge_ptr_t>> edgePairs;
-
-    auto nitPair = src.nodes();
-    for (auto nit = nitPair.first; nit != nitPair.second; nit++) {
-        auto np = make_unique<DNode>();
-	np->mOriginal = nit;
-        nodePairs.push_back(make_pair(nit,std::move(np)));
-    }
-    auto eitPair = src.edges();
-    for (auto eit = eitPair.first; eit != eitPair.second; eit++) {
-        auto ep = make_unique<DEdge>();
-	ep->mOriginal = eit;
-	edgePairs.push_back(make_pair(eit,std::move(ep)));
-    }
-    src.copySubgraph(nodePairs, edgePairs, dst);
-
-    for (auto nit = dst.nodes().first; nit != dst.nodes().second; nit++) {
-        auto& n = dynamic_cast<DNode&>(*(*nit));
-                                                                    
-        if (n.mOriginal == srcIt) {
-            srcCopyIt = nit;
+        if (nit->get() == &s) {
+            sIndex = index;
         }
-        if (n.mOriginal == dstIt) {
-            dstCopyIt = nit;
+        if (nit->get() == &t) {
+            tIndex = index;
         }
+        index++;
     }
 
-    bool edgeSTFound = false;
-    DNode& srcCopy = dynamic_cast<DNode&>(*(*srcCopyIt));
-    DNode& dstCopy = dynamic_cast<DNode&>(*(*dstCopyIt));
-    for (auto iit = srcCopy.incidentEdges().first; 
-                               iit != srcCopy.incidentEdges().second; iit++) {
-        auto& e = dynamic_cast<DEdge&>(*(*(*iit)));
-        auto& vAdj = dynamic_cast<DNode&>(e.adjacentNode(srcCopy));
-        if (&vAdj == &dstCopy) {
-            // Move the edge {s,t} to the front of the incidence lists.
-            dst.moveEdge(e, srcCopy, srcCopy.incidentEdges().first,
-                            dstCopy, dstCopy.incidentEdges().first );
-            edgeSTFound = true;
-            break;
-
-        }
-    }
-    if (edgeSTFound == false) {
-        // Add {s,t} to the front of the incidence lists of s and t.
-        auto ep = make_unique<DEdge>();
-	ep->mOriginal = dst.edges().second;
-        dst.addEdge(std::move(ep), srcCopy, dstCopy,
-                srcCopy.incidentEdges().first, dstCopy.incidentEdges().first );
+    vector<node_list_it_t> vecReturned;
+    for (auto v : getBipolarOrientation(cg, sIndex, tIndex)) {
+        vecReturned.push_back(cg.originalNode(v));
     }
-}
-
-
-vector<node_list_it_t> STNumbering::getBipolarOrientation(
-                                                  Graph& g, Node& s, Node& t)
-{
-    DFSGraph<Graph,ST_DFS_Node,ST_DFS_Edge> gCopy;
-    node_list_it_t srcCopyIt;
-    node_list_it_t dstCopyIt;
-
-    copyInputGraph(g, gCopy, s.backIt(), srcCopyIt, t.backIt(), dstCopyIt);
-
-    auto& srcCopy = dynamic_cast<DNode&>(*(*srcCopyIt));
-    auto& dstCopy = dynamic_cast<DNode&>(*(*dstCopyIt));
-
-    STStrategyProc1 strategy1;
-    DFSExplorer<Graph,ST_DFS_Node,ST_DFS_Edge> mExplorer1(gCopy,strategy1);
-    mExplorer1.reset(gCopy);
-    mExplorer1.run(srcCopy);
-
-    STStrategyProc2 strategy2;
-    DFSExplorer<Graph,ST_DFS_Node,ST_DFS_Edge> mExplorer2(gCopy,strategy2);
-    strategy2.prepareNodesAndEdges(gCopy, srcCopy, dstCopy);
-    mExplorer2.reset(gCopy);
-    mExplorer2.run(srcCopy);
-
-    return strategy2.getL();
-
+    return vecReturned; // rvo
 }
 
 }// namespace Undirected
@@ -0,0 +1,261 @@
+#include "undirected/text_spec_reader.hpp"
+
+#include <cstring>
+#include <cctype>
+#include <cstdlib>
+#include <limits>
+#include <iterator>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+/**
+ * @file undirected/text_spec_reader.cpp
+ *
+ * @brief implementation of TextSpecReader.
+ */
+
+namespace Wailea {
+
+namespace Undirected {
+
+using namespace std;
+
+
+bool TextSpecReader::Token::equals(const string& s) const
+{
+    return s.size() == size() && memcmp(s.data(), mBegin, size()) == 0;
+}
+
+
+bool TextSpecReader::Token::toLong(long& val) const
+{
+    const char* p        = mBegin;
+    bool        negative = false;
+    if (p != mEnd && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p == mEnd) {
+        return false;
+    }
+
+    // Accumulate in the negative range, which is wider by one.
+    const long lowest = numeric_limits<long>::min();
+    long       v      = 0;
+    for (; p != mEnd; p++) {
+        unsigned digit = static_cast<unsigned char>(*p) - '0';
+        if (digit > 9) {
+            return false;
+        }
+        if (v < (lowest + static_cast<long>(digit)) / 10) {
+            return false;
+        }
+        v = v * 10 - static_cast<long>(digit);
+    }
+    if (!negative) {
+        if (v == lowest) {
+            return false;
+        }
+        v = -v;
+    }
+    val = v;
+    return true;
+}
+
+
+bool TextSpecReader::Token::toDouble(double& val) const
+{
+    // The token is not null-terminated. Numbers are short.
+    char buf[64];
+    if (size() == 0 || size() >= sizeof(buf)) {
+        return false;
+    }
+    memcpy(buf, mBegin, size());
+    buf[size()] = '\0';
+
+    char*  endp;
+    double v = strtod(buf, &endp);
+    if (endp != buf + size()) {
+        return false;
+    }
+    val = v;
+    return true;
+}
+
+
+TextSpecReader::~TextSpecReader()
+{
+    reset();
+}
+
+
+void TextSpecReader::reset()
+{
+    if (mMapped != nullptr) {
+        munmap(mMapped, mMappedSize);
+        mMapped     = nullptr;
+        mMappedSize = 0;
+    }
+    mBuffer.clear();
+    mBegin      = nullptr;
+    mEnd        = nullptr;
+    mPos        = nullptr;
+    mLineBegin  = nullptr;
+    mLineEnd    = nullptr;
+    mLineNumber = 0;
+    mTokens.clear();
+}
+
+
+bool TextSpecReader::open(const char* filename)
+{
+    reset();
+
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        size_t size = static_cast<size_t>(st.st_size);
+        void*  p    = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            madvise(p, size, MADV_SEQUENTIAL);
+#endif
+            ::close(fd);
+            mMapped     = p;
+            mMappedSize = size;
+            mBegin      = static_cast<const char*>(p);
+            mEnd        = mBegin + size;
+            mPos        = mBegin;
+            return true;
+        }
+    }
+
+    // Not a regular file, or it could not be mapped.
+    char    chunk[65536];
+    ssize_t n;
+    while ((n = ::read(fd, chunk, sizeof(chunk))) > 0) {
+        mBuffer.append(chunk, static_cast<size_t>(n));
+    }
+    ::close(fd);
+    if (n < 0) {
+        reset();
+        return false;
+    }
+    mBegin = mBuffer.data();
+    mEnd   = mBegin + mBuffer.size();
+    mPos   = mBegin;
+    return true;
+}
+
+
+void TextSpecReader::load(istream& is)
+{
+    reset();
+    mBuffer.assign(istreambuf_iterator<char>(is), istreambuf_iterator<char>());
+    mBegin = mBuffer.data();
+    mEnd   = mBegin + mBuffer.size();
+    mPos   = mBegin;
+}
+
+
+bool TextSpecReader::nextLine()
+{
+    mTokens.clear();
+    if (mPos == mEnd) {
+        return false;
+    }
+
+    mLineBegin = mPos;
+    auto nl = static_cast<const char*>(memchr(mPos, '\n', mEnd - mPos));
+    if (nl == nullptr) {
+        mLineEnd = mEnd;
+        mPos     = mEnd;
+    }
+    else {
+        mLineEnd = nl;
+        mPos     = nl + 1;
+    }
+    if (mLineEnd != mLineBegin && *(mLineEnd - 1) == '\r') {
+        mLineEnd--;
+    }
+    mLineNumber++;
+    return true;
+}
+
+
+bool TextSpecReader::startsWith(const string& s) const
+{
+    return s.size() <= lineSize() &&
+           memcmp(s.data(), mLineBegin, s.size()) == 0;
+}
+
+
+size_t TextSpecReader::split(char delim)
+{
+    mTokens.clear();
+    auto isDelim = [delim](char c) {
+        return c == delim || (delim == ' ' && c == '\t');
+    };
+    const char* p = mLineBegin;
+    while (p != mLineEnd) {
+        while (p != mLineEnd && isDelim(*p)) {
+            p++;
+        }
+        if (p == mLineEnd) {
+            break;
+        }
+        const char* b = p;
+        while (p != mLineEnd && !isDelim(*p)) {
+            p++;
+        }
+        mTokens.emplace_back(b, p);
+    }
+    return mTokens.size();
+}
+
+
+size_t TextSpecReader::countLines() const
+{
+    size_t      cnt = 0;
+    const char* p   = mPos;
+    while (p != mEnd) {
+        auto nl = static_cast<const char*>(memchr(p, '\n', mEnd - p));
+        cnt++;
+        if (nl == nullptr) {
+            break;
+        }
+        p = nl + 1;
+    }
+    return cnt;
+}
+
+
+size_t TextSpecReader::countSectionLines() const
+{
+    size_t      cnt = 0;
+    const char* p   = mPos;
+    while (p != mEnd) {
+        if (isalpha(static_cast<unsigned char>(*p))) {
+            break;
+        }
+        auto nl = static_cast<const char*>(memchr(p, '\n', mEnd - p));
+        cnt++;
+        if (nl == nullptr) {
+            break;
+        }
+        p = nl + 1;
+    }
+    return cnt;
+}
+
+
+}// namespace Undirected
+
+}// namespace Wailea
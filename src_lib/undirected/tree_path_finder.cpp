@@ -5,6 +5,7 @@
 #include <exception>
 
 #include "undirected/tree_path_finder.hpp"
+#include "undirected/static_dfs.hpp"
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -80,9 +81,9 @@ void TreePathFinderStrategy::enterNode(DNode& v) noexcept
         while (eit !=mTree.edges().second) {
 
             mEdges.push_front(eit);
-            auto& N     = dynamic_cast<DNode&>(*(*nit));
-            auto& E     = dynamic_cast<DEdge&>(*(*eit));
-            auto& Nprev = dynamic_cast<DNode&>(E.adjacentNode(N));
+            auto& N     = downcast<DNode>(*(*nit));
+            auto& E     = downcast<DEdge>(*(*eit));
+            auto& Nprev = downcast<DNode>(E.adjacentNode(N));
 
             eit = Nprev.mBackEdge;
             nit = Nprev.backIt();
@@ -100,7 +101,7 @@ void TreePathFinderStrategy::enterNode(DNode& v) noexcept
 
 void TreePathFinderStrategy::beforeVisitingChild(DNode& v, DEdge& vw) noexcept
 {
-    auto& W = dynamic_cast<TPF_DFS_Node&>(vw.adjacentNode(v));
+    auto& W = downcast<TPF_DFS_Node>(vw.adjacentNode(v));
     W.mBackEdge = vw.backIt();
 }
 
@@ -149,7 +150,7 @@ void TreePathFinder::copyInputGraph(
     Gorg.copySubgraph(nodePairs, edgePairs, Gcopy);
 
     for (auto nit = Gcopy.nodes().first; nit != Gcopy.nodes().second; nit++) {
-        auto& N = dynamic_cast<DNode&>(*(*nit));
+        auto& N = downcast<DNode>(*(*nit));
 
         N.mBackEdge = Gcopy.edges().second;
                                                                     
@@ -174,17 +175,22 @@ void TreePathFinder::findPath(
 
 ) {
 
+    ElementArena arena;
     DFSGraph<Graph,TPF_DFS_Node,TPF_DFS_Edge> Tcopy;
     node_list_it_t n1It;
     node_list_it_t n2It;
 
-    copyInputGraph(T, s.backIt(), t.backIt(), Tcopy, n1It, n2It);
+    {
+        ElementArena::Scope scope(arena);
+        copyInputGraph(T, s.backIt(), t.backIt(), Tcopy, n1It, n2It);
+    }
 
-    auto& N1copy = dynamic_cast<DNode&>(*(*n1It));
-    auto& N2copy = dynamic_cast<DNode&>(*(*n2It));
+    auto& N1copy = downcast<DNode>(*(*n1It));
+    auto& N2copy = downcast<DNode>(*(*n2It));
 
     TreePathFinderStrategy strategy(Tcopy);
-    DFSExplorer<Graph,TPF_DFS_Node,TPF_DFS_Edge> explorer(Tcopy, strategy);
+    StaticDFSExplorer<Graph,TPF_DFS_Node,TPF_DFS_Edge,TreePathFinderStrategy>
+                                                   explorer(Tcopy, strategy);
     strategy.setEndNode(N2copy);
     explorer.reset(Tcopy);
     explorer.run(N1copy);
@@ -193,7 +199,7 @@ void TreePathFinder::findPath(
     nodes.clear();
     for (auto nit : nodesCopy) {
 
-        auto& N = dynamic_cast<DNode&>(*(*nit));
+        auto& N = downcast<DNode>(*(*nit));
         nodes.push_back(N.IGBackwardLink());
 
     }
@@ -202,7 +208,7 @@ void TreePathFinder::findPath(
     edges.clear();
     for (auto eit : edgesCopy) {
 
-        auto& E = dynamic_cast<DEdge&>(*(*eit));
+        auto& E = downcast<DEdge>(*(*eit));
         edges.push_back(E.IGBackwardLink());
 
     }
@@ -17,18 +17,18 @@ void TreeSplitter::prepareTree(list<edge_list_it_t>& cutSet)
 {
     for (auto eItIt = mTree.edges().first; 
                                      eItIt != mTree.edges().second; eItIt++ ) {
-        auto& E = dynamic_cast<Edge&>(*(*eItIt));
+        auto& E = downcast<Edge>(*(*eItIt));
         E. pushUtility(0);
     }
 
     for (auto eit : cutSet) {
-        auto& E = dynamic_cast<Edge&>(*(*eit));
+        auto& E = downcast<Edge>(*(*eit));
         E.setUtility(1);
     }
 
     for (auto nItIt = mTree.nodes().first; 
                                       nItIt != mTree.nodes().second; nItIt++) {
-        auto& N = dynamic_cast<Node&>(*(*nItIt));
+        auto& N = downcast<Node>(*(*nItIt));
         N.pushUtility(0);
     }  
 }
@@ -44,7 +44,7 @@ list<node_list_it_t> TreeSplitter::findComponent(node_list_it_t startIt)
     while (Q.size() > 0) {
 
         auto qit = *(Q.rbegin());
-        auto& N = dynamic_cast<Node&>(*(*qit));
+        auto& N = downcast<Node>(*(*qit));
         Q.pop_back();
         nodesFound.push_back(qit);
 
@@ -52,7 +52,7 @@ list<node_list_it_t> TreeSplitter::findComponent(node_list_it_t startIt)
 
         for (auto eit = N.incidentEdges().first; 
                                      eit != N.incidentEdges().second; eit++ ) {
-            auto& E = dynamic_cast<Edge&>(*(*(*eit)));
+            auto& E = downcast<Edge>(*(*(*eit)));
             if (E.utility() == 0) {
                 auto& A = E.adjacentNode(N);
                 if (A.utility() == 0) {
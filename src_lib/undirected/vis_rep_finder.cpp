@@ -1,5 +1,10 @@
 #include "undirected/vis_rep_finder.hpp"
 #include "undirected/st_numbering.hpp"
+#include "undirected/parallel_for.hpp"
+
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 #ifdef UNIT_TESTS
 #include "gtest/gtest_prod.h"
@@ -24,10 +29,10 @@ void VisRepFinder::find()
     }
 
     auto& bcTree  = mEBCTree.bcTree();
-    auto& LG      = dynamic_cast<VRRectLabelGraph&>(bcTree.original());
+    auto& LG      = downcast<VRRectLabelGraph>(bcTree.original());
     if (LG.numNodes()==1 && LG.numEdges()==0) {
         // k1    
-        auto& N    = dynamic_cast<VRRectLabelNode&>(*(*(LG.nodes().first)));
+        auto& N    = downcast<VRRectLabelNode>(*(*(LG.nodes().first)));
         N.mY       =  N.height()/2.0;
         N.mXleft   =  N.width()/2.0;
         N.mXright  =  N.width()/2.0;
@@ -39,9 +44,18 @@ void VisRepFinder::find()
     
     prepare();
 
-    performPass1BottomUp();
+    if (mExecutionMode == PARALLEL) {
+
+        performPassInParallel(true);
+
+        performPassInParallel(false);
+    }
+    else {
 
-    performPass2TopDown();
+        performPass1BottomUp();
+
+        performPass2TopDown();
+    }
 
     findVRCoordinates();
 
@@ -65,7 +79,7 @@ void VisRepFinder::prepare()
 
     auto& bcTree     = mEBCTree.bcTree();
     auto& expTree    = mEBCTree.explorationTree();
-    auto& labelGraph = dynamic_cast<VRRectLabelGraph&>(bcTree.original());
+    auto& labelGraph = downcast<VRRectLabelGraph>(bcTree.original());
 
     mHGap = labelGraph.horizontalGap();
     mVGap = labelGraph.verticalGap();
@@ -73,9 +87,9 @@ void VisRepFinder::prepare()
     auto nPair = expTree.nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 
-        auto& expNode     = dynamic_cast<EmbeddedBCTree::ExplorationNode&>(
+        auto& expNode     = downcast<EmbeddedBCTree::ExplorationNode>(
                                                                       *(*nit));
-        auto& embTreeNode = dynamic_cast<EmbeddedBCTreeNode&>(
+        auto& embTreeNode = downcast<EmbeddedBCTreeNode>(
                                                   expNode.IGBackwardLinkRef());
 
         // Create an aux data for EmbeddedBCTree.
@@ -87,7 +101,7 @@ void VisRepFinder::prepare()
         for (auto enit = enPair.first; enit != enPair.second; enit++) {
 
             // Create an aux data for EmbeddedNode.
-            auto& EmbNode = dynamic_cast<EmbeddedNode&>(*(*enit));
+            auto& EmbNode = downcast<EmbeddedNode>(*(*enit));
             EmbNode.pushUtility(aux.mEGNodeAux.size());
             aux.mEGNodeAux.emplace_back();
 
@@ -97,7 +111,7 @@ void VisRepFinder::prepare()
         for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
 
             // Create an aux data for EmbeddedEdge.
-            auto& embEdge = dynamic_cast<EmbeddedEdge&>(*(*eeit));
+            auto& embEdge = downcast<EmbeddedEdge>(*(*eeit));
             embEdge.pushUtility(aux.mEGEdgeAux.size());
             aux.mEGEdgeAux.emplace_back();
 
@@ -107,7 +121,7 @@ void VisRepFinder::prepare()
         for (auto dfit = dfPair.first; dfit != dfPair.second; dfit++) {
 
             // Create an aux data for EmbeddedFace.
-            auto& face = dynamic_cast<EmbeddedFace&>(*(*dfit));
+            auto& face = downcast<EmbeddedFace>(*(*dfit));
             face.pushUtility(aux.mDGFaceAux.size());
             aux.mDGFaceAux.emplace_back();
 
@@ -117,7 +131,7 @@ void VisRepFinder::prepare()
         for (auto deit = dePair.first; deit != dePair.second; deit++) {
 
             // Create an aux data for DualEdge.
-            auto& dualEdge = dynamic_cast<DualEdge&>(*(*deit));
+            auto& dualEdge = downcast<DualEdge>(*(*deit));
             dualEdge.pushUtility(aux.mDGEdgeAux.size());
             aux.mDGEdgeAux.emplace_back();
 
@@ -134,33 +148,33 @@ void VisRepFinder::cleanUp()
     auto nPair = expTree.nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 
-        auto& expNode     = dynamic_cast<EmbeddedBCTree::ExplorationNode&>(
+        auto& expNode     = downcast<EmbeddedBCTree::ExplorationNode>(
                                                                       *(*nit));
-        auto& embTreeNode = dynamic_cast<EmbeddedBCTreeNode&>(
+        auto& embTreeNode = downcast<EmbeddedBCTreeNode>(
                                                   expNode.IGBackwardLinkRef());
         embTreeNode.popUtility();
 
         auto enPair = embTreeNode.embeddedGraph().nodes();
         for (auto enit = enPair.first; enit != enPair.second; enit++) {
-            auto& EmbNode = dynamic_cast<EmbeddedNode&>(*(*enit));
+            auto& EmbNode = downcast<EmbeddedNode>(*(*enit));
             EmbNode.popUtility();
         }
 
         auto eePair = embTreeNode.embeddedGraph().edges();
         for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
-            auto& embEdge = dynamic_cast<EmbeddedEdge&>(*(*eeit));
+            auto& embEdge = downcast<EmbeddedEdge>(*(*eeit));
             embEdge.popUtility();
         }
 
         auto dfPair = embTreeNode.dualGraph().nodes();
         for (auto dfit = dfPair.first; dfit != dfPair.second; dfit++) {
-            auto& face = dynamic_cast<EmbeddedFace&>(*(*dfit));
+            auto& face = downcast<EmbeddedFace>(*(*dfit));
             face.popUtility();
         }
 
         auto dePair = embTreeNode.dualGraph().edges();
         for (auto deit = dePair.first; deit != dePair.second; deit++) {
-            auto& dualEdge = dynamic_cast<DualEdge&>(*(*deit));
+            auto& dualEdge = downcast<DualEdge>(*(*deit));
             dualEdge.popUtility();
         }
     }
@@ -194,7 +208,7 @@ void VisRepFinder::performPass1BottomUp()
     for (auto nit = ExpTree.nodes().first; 
                                        nit != ExpTree.nodes().second; nit++) {
 
-        auto& expNode = dynamic_cast<EmbeddedBCTree::ExplorationNode&>(
+        auto& expNode = downcast<EmbeddedBCTree::ExplorationNode>(
                                                                       *(*nit));
 
 #ifdef UNIT_TESTS_XXX
@@ -226,7 +240,7 @@ void VisRepFinder::performPass1BottomUp()
         cerr << "Iteration: " << iteration++ << "\n";
 #endif
 
-        auto& expNode = dynamic_cast<EmbeddedBCTree::ExplorationNode&>(
+        auto& expNode = downcast<EmbeddedBCTree::ExplorationNode>(
                                                           *(*(*(Q.begin()))));
         Q.pop_front();
         Qsize--;    
@@ -238,9 +252,9 @@ void VisRepFinder::performPass1BottomUp()
         debugPrint(expNode, 4);
 #endif
         if (expNode.degreeIn()>0) {
-            auto& expEdge = dynamic_cast<EmbeddedBCTree::ExplorationEdge&>(
+            auto& expEdge = downcast<EmbeddedBCTree::ExplorationEdge>(
                                      *(*(*(expNode.incidentEdgesIn().first))));
-            auto& expParent = dynamic_cast<EmbeddedBCTree::ExplorationNode&>(
+            auto& expParent = downcast<EmbeddedBCTree::ExplorationNode>(
                                                 expEdge.adjacentNode(expNode));
             expParent.incrementNumChildrenProcessed();
 
@@ -267,7 +281,7 @@ void VisRepFinder::processOneTreeNodePass1(
     EmbeddedBCTree::ExplorationNode& expNode
 ) {
 
-    auto& embTreeNode = dynamic_cast<EmbeddedBCTreeNode&>(
+    auto& embTreeNode = downcast<EmbeddedBCTreeNode>(
                                                   expNode.IGBackwardLinkRef());
 
     node_list_it_t bottomNodeIt;
@@ -365,7 +379,7 @@ void VisRepFinder::findBottomNodeAndLeftMostFace(
 
     for (auto iit = iPair.first ; iit != iPair.second ; iit++) {
 
-        auto& embEdge = dynamic_cast<EmbeddedEdge&>(*(*(*iit)));
+        auto& embEdge = downcast<EmbeddedEdge>(*(*(*iit)));
 
         if (embEdge.mHalfEdge1.mDstNode==topNode.backIt()) {
             if (embEdge.mHalfEdge1.mEmbeddedFace==outerFace.backIt()) {
@@ -413,7 +427,7 @@ void VisRepFinder::orientEGandDG(
 
     if (embTreeNode.embeddedGraph().numNodes() >= 2) {
         auto& S   = embTreeNode.topNode();
-        auto& T   = dynamic_cast<EmbeddedNode&>(*(*bottomIt));
+        auto& T   = downcast<EmbeddedNode>(*(*bottomIt));
 
         // Generate ST-numbering
         STNumbering st;
@@ -433,16 +447,16 @@ void VisRepFinder::orientEGandDG(
 
     long index = 0;
     for (auto nit: tsOrdering) {
-        auto& embNode = dynamic_cast<EmbeddedNode&>(*(*nit));
+        auto& embNode = downcast<EmbeddedNode>(*(*nit));
         aux.mEGNodeAux[embNode.utility()].mSTNum = index++;
     }
     // Orient EmbeddedEdges and DualEdges based on ST-numbering.
     auto ePair = embTreeNode.embeddedGraph().edges();
     for (auto eit = ePair.first ; eit != ePair.second; eit++) {
 
-        auto& embEdge  = dynamic_cast<EmbeddedEdge&>(*(*eit));
-        auto& embNode1 = dynamic_cast<EmbeddedNode&>(embEdge.incidentNode1());
-        auto& embNode2 = dynamic_cast<EmbeddedNode&>(embEdge.incidentNode2());
+        auto& embEdge  = downcast<EmbeddedEdge>(*(*eit));
+        auto& embNode1 = downcast<EmbeddedNode>(embEdge.incidentNode1());
+        auto& embNode2 = downcast<EmbeddedNode>(embEdge.incidentNode2());
 
         if (aux.mEGNodeAux[embNode1.utility()].mSTNum >
                                   aux.mEGNodeAux[embNode2.utility()].mSTNum ) {
@@ -460,14 +474,14 @@ void VisRepFinder::orientEGandDG(
 
         }
 
-        auto& dualEdge  = dynamic_cast<DualEdge&>(*(*(embEdge.mDualEdge)));
+        auto& dualEdge  = downcast<DualEdge>(*(*(embEdge.mDualEdge)));
         auto dit = dualEdge.backIt();
         if (dit==stDualIt) {
             aux.mDGEdgeAux[dualEdge.utility()].mCountMeOut = true;
         }
 
-        auto& face1  = dynamic_cast<EmbeddedFace&>(dualEdge.incidentNode1());
-        auto& face2  = dynamic_cast<EmbeddedFace&>(dualEdge.incidentNode2());
+        auto& face1  = downcast<EmbeddedFace>(dualEdge.incidentNode1());
+        auto& face2  = downcast<EmbeddedFace>(dualEdge.incidentNode2());
         bool oriented1to2 = aux.mEGEdgeAux[embEdge.utility()].mOriented1to2;
 
         //     Node 1    ===               Node 2    ===
@@ -508,7 +522,7 @@ void VisRepFinder::orientEGandDG(
 
     // Setting the left and the right faces of each node.
     auto& topNode    = embTreeNode.topNode();
-    auto& bottomNode = dynamic_cast<EmbeddedNode&>(*(*bottomIt));
+    auto& bottomNode = downcast<EmbeddedNode>(*(*bottomIt));
     auto& outerFace  = embTreeNode.outerFace();
 
     aux.mEGNodeAux[topNode.utility()   ].mLeftFace  = outerFace.backIt();
@@ -519,7 +533,7 @@ void VisRepFinder::orientEGandDG(
     auto fPair = embTreeNode.dualGraph().nodes();
     for (auto fit = fPair.first ; fit != fPair.second; fit++) {
 
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& F = downcast<EmbeddedFace>(*(*fit));
         if (F.mCycleEdges.size()>1) {
             auto cit1 = F.mCycleEdges.begin();
             auto bit1 = F.mCycleHalfEdgesOn1.begin();
@@ -528,8 +542,8 @@ void VisRepFinder::orientEGandDG(
             cit2++;
             bit2++;
             for(; cit1 != F.mCycleEdges.end(); cit1++,bit1++) {
-                auto& EE1 = dynamic_cast<EmbeddedEdge&>(*(*(*cit1)));
-                auto& EE2 = dynamic_cast<EmbeddedEdge&>(*(*(*cit2)));
+                auto& EE1 = downcast<EmbeddedEdge>(*(*(*cit1)));
+                auto& EE2 = downcast<EmbeddedEdge>(*(*(*cit2)));
                 node_list_it_t nit_prev, nit_main, nit_next;
 
                 if (*bit1){
@@ -547,9 +561,9 @@ void VisRepFinder::orientEGandDG(
                     nit_next = EE2.mHalfEdge2.mDstNode;
                 }                
 
-                auto& Nprev = dynamic_cast<EmbeddedNode&>(*(*nit_prev));
-                auto& Nmain = dynamic_cast<EmbeddedNode&>(*(*nit_main));
-                auto& Nnext = dynamic_cast<EmbeddedNode&>(*(*nit_next));
+                auto& Nprev = downcast<EmbeddedNode>(*(*nit_prev));
+                auto& Nmain = downcast<EmbeddedNode>(*(*nit_main));
+                auto& Nnext = downcast<EmbeddedNode>(*(*nit_next));
                 auto& AuxPrev = aux.mEGNodeAux[Nprev.utility()];
                 auto& AuxMain = aux.mEGNodeAux[Nmain.utility()];
                 auto& AuxNext = aux.mEGNodeAux[Nnext.utility()];
@@ -581,21 +595,21 @@ void VisRepFinder::assignDefaultCosts(EmbeddedBCTreeNode& embTreeNode)
 
     auto nPair = embTreeNode.embeddedGraph().nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
-        auto& embNode  = dynamic_cast<EmbeddedNode&>(*(*nit));
+        auto& embNode  = downcast<EmbeddedNode>(*(*nit));
         auto& Naux     = aux.mEGNodeAux[embNode.utility()];
         Naux.reset();
     }
 
     auto eePair = embTreeNode.embeddedGraph().edges();
     for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
-        auto& embEdge = dynamic_cast<EmbeddedEdge&>(*(*eeit));
+        auto& embEdge = downcast<EmbeddedEdge>(*(*eeit));
         auto& EEaux   = aux.mEGEdgeAux[embEdge.utility()];
         EEaux.reset();
     }
 
     auto fPair = embTreeNode.dualGraph().nodes();
     for (auto fit = fPair.first; fit != fPair.second; fit++) {
-        auto& face = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& face = downcast<EmbeddedFace>(*(*fit));
         auto& Faux = aux.mDGFaceAux[face.utility()];
         Faux.reset();
 
@@ -603,7 +617,7 @@ void VisRepFinder::assignDefaultCosts(EmbeddedBCTreeNode& embTreeNode)
 
     auto dePair = embTreeNode.dualGraph().edges();
     for (auto deit = dePair.first; deit != dePair.second; deit++) {
-        auto& dualEdge = dynamic_cast<DualEdge&>(*(*deit));
+        auto& dualEdge = downcast<DualEdge>(*(*deit));
         auto& DEaux    = aux.mDGEdgeAux[dualEdge.utility()];
         DEaux.reset();
     }
@@ -890,8 +904,8 @@ enum VisRepFinder::absorbingType VisRepFinder::findAbsorbingType(
     auto& edgeCW  = blockEdgeCW (UF);
 
     auto& NodeCV  = UF.cutVertexInEG();
-    auto& NodeCCW = dynamic_cast<EmbeddedNode&>(edgeCCW.adjacentNode(NodeCV));
-    auto& NodeCW  = dynamic_cast<EmbeddedNode&>(edgeCW.adjacentNode(NodeCV));
+    auto& NodeCCW = downcast<EmbeddedNode>(edgeCCW.adjacentNode(NodeCV));
+    auto& NodeCW  = downcast<EmbeddedNode>(edgeCW.adjacentNode(NodeCV));
 
     auto& embTN   = UF.treeNode();
     auto& aux     = mAux[embTN.utility()];
@@ -970,7 +984,7 @@ DGEdgeAux& VisRepFinder::findAuxsDECW(UnificationFace& UF)
     auto& embTN = UF.treeNode();
     auto& aux   = mAux[embTN.utility()];
     auto& eeCW  = blockEdgeCW(UF);
-    auto& deCW  = dynamic_cast<DualEdge&>(*(*(eeCW.mDualEdge)));
+    auto& deCW  = downcast<DualEdge>(*(*(eeCW.mDualEdge)));
     return aux.mDGEdgeAux[deCW.utility()];
 }
 
@@ -980,7 +994,7 @@ DGEdgeAux& VisRepFinder::findAuxsDECCW(UnificationFace& UF)
     auto& embTN = UF.treeNode();
     auto& aux   = mAux[embTN.utility()];
     auto& eeCCW = blockEdgeCCW(UF);
-    auto& deCCW = dynamic_cast<DualEdge&>(*(*(eeCCW.mDualEdge)));
+    auto& deCCW = downcast<DualEdge>(*(*(eeCCW.mDualEdge)));
     return aux.mDGEdgeAux[deCCW.utility()];
 }
 
@@ -1081,10 +1095,10 @@ void VisRepFinder::handleNodeLabels(
     auto enPair = embTreeNode.embeddedGraph().nodes();
     for (auto enit = enPair.first; enit != enPair.second; enit++) {
 
-        auto& embNode   = dynamic_cast<EmbeddedNode&>(*(*enit));
-        auto& blockNode = dynamic_cast<BlockNode&>(
+        auto& embNode   = downcast<EmbeddedNode>(*(*enit));
+        auto& blockNode = downcast<BlockNode>(
                                                   embNode.IGBackwardLinkRef());
-        auto& labelNode = dynamic_cast<VRRectLabelNode&>(
+        auto& labelNode = downcast<VRRectLabelNode>(
                                                 blockNode.IGBackwardLinkRef());
         auto& embNodeAux= aux.mEGNodeAux[embNode.utility()];
 
@@ -1112,8 +1126,8 @@ void VisRepFinder::handleNodeLabels(
             coord_t upperWidth = (labelNode.width()+leftGap+rightGap)/
                                                             upperEdges.size();
             for (auto eit : upperEdges) {
-                auto& ee = dynamic_cast<EmbeddedEdge&>(*(*eit));
-                auto& de = dynamic_cast<DualEdge&>(*(*(ee.mDualEdge)));
+                auto& ee = downcast<EmbeddedEdge>(*(*eit));
+                auto& de = downcast<DualEdge>(*(*(ee.mDualEdge)));
                 auto& aux_de = aux.mDGEdgeAux[de.utility()];
                 aux_de.mWidthLabelShareLower = upperWidth;
             }
@@ -1124,8 +1138,8 @@ void VisRepFinder::handleNodeLabels(
             coord_t lowerWidth = (labelNode.width()+leftGap+rightGap)/
                                                             lowerEdges.size();
             for (auto eit : lowerEdges) {
-                auto& ee = dynamic_cast<EmbeddedEdge&>(*(*eit));
-                auto& de = dynamic_cast<DualEdge&>(*(*(ee.mDualEdge)));
+                auto& ee = downcast<EmbeddedEdge>(*(*eit));
+                auto& de = downcast<DualEdge>(*(*(ee.mDualEdge)));
                 auto& aux_de = aux.mDGEdgeAux[de.utility()];
                 aux_de.mWidthLabelShareUpper = lowerWidth;
             }
@@ -1147,8 +1161,8 @@ void VisRepFinder::findLeftAndRightGaps(
     bool facingLeftBoundary  = false;
 
     for (auto eit: upperEdges) {
-        auto& EE = dynamic_cast<EmbeddedEdge&>(*(*eit));
-        auto& DE = dynamic_cast<DualEdge&>(*(*(EE.mDualEdge)));
+        auto& EE = downcast<EmbeddedEdge>(*(*eit));
+        auto& DE = downcast<DualEdge>(*(*(EE.mDualEdge)));
         if ( (DE.incidentNode1().backIt()==outerFaceIt)||
              (DE.incidentNode2().backIt()==outerFaceIt)   ) {
             facingRightBoundary = true;
@@ -1159,8 +1173,8 @@ void VisRepFinder::findLeftAndRightGaps(
     }
 
     for (auto eit: lowerEdges) {
-        auto& EE = dynamic_cast<EmbeddedEdge&>(*(*eit));
-        auto& DE = dynamic_cast<DualEdge&>(*(*(EE.mDualEdge)));
+        auto& EE = downcast<EmbeddedEdge>(*(*eit));
+        auto& DE = downcast<DualEdge>(*(*(EE.mDualEdge)));
         if ( (DE.incidentNode1().backIt()==outerFaceIt)||
              (DE.incidentNode2().backIt()==outerFaceIt)   ) {
             facingRightBoundary = true;
@@ -1198,7 +1212,7 @@ void VisRepFinder::findUpperAndLowerEdges(
 
     auto iPair = embNode.incidentEdges();
     for (auto iit = iPair.first; iit != iPair.second; iit++) {
-        auto& embEdge = dynamic_cast<EmbeddedEdge&>(*(*(*iit)));
+        auto& embEdge = downcast<EmbeddedEdge>(*(*(*iit)));
         auto& adjNode = embEdge.adjacentNode(embNode);
         auto adjNodeAux = aux.mEGNodeAux[adjNode.utility()];
         if (embNodeAux.mSTNum < adjNodeAux.mSTNum) {
@@ -1219,18 +1233,18 @@ void VisRepFinder::handleEdgeLabels(EmbeddedBCTreeNode& embTN)
 
     for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
 
-        auto& embEdge   = dynamic_cast<EmbeddedEdge&>(*(*eeit));
-        auto& blockEdge = dynamic_cast<BlockEdge&>(
+        auto& embEdge   = downcast<EmbeddedEdge>(*(*eeit));
+        auto& blockEdge = downcast<BlockEdge>(
                                                   embEdge.IGBackwardLinkRef());
-        auto& labelEdge = dynamic_cast<VRRectLabelEdge&>(
+        auto& labelEdge = downcast<VRRectLabelEdge>(
                                                 blockEdge.IGBackwardLinkRef());
-        auto& dualEdge  = dynamic_cast<DualEdge&>(*(*(embEdge.mDualEdge)));
+        auto& dualEdge  = downcast<DualEdge>(*(*(embEdge.mDualEdge)));
 
         auto& aux_ee    = aux.mEGEdgeAux[embEdge.utility()];
         auto& aux_de    = aux.mDGEdgeAux[dualEdge.utility()];
 
-        auto& N1        = dynamic_cast<EmbeddedNode&>(embEdge.incidentNode1());
-        auto& N2        = dynamic_cast<EmbeddedNode&>(embEdge.incidentNode2());
+        auto& N1        = downcast<EmbeddedNode>(embEdge.incidentNode1());
+        auto& N2        = downcast<EmbeddedNode>(embEdge.incidentNode2());
         auto& aux_n1    = aux.mEGNodeAux[N1.utility()];
         auto& aux_n2    = aux.mEGNodeAux[N2.utility()];
 
@@ -1410,7 +1424,7 @@ void VisRepFinder::calculateCosts(
     auto enPair = embTreeNode.embeddedGraph().nodes();
     for (auto enit = enPair.first; enit != enPair.second; enit++) {
 
-        auto& en     = dynamic_cast<EmbeddedNode&>(*(*enit));
+        auto& en     = downcast<EmbeddedNode>(*(*enit));
         auto& aux_en = aux.mEGNodeAux[en.utility()];
 
         // The cost is the node label height.
@@ -1420,7 +1434,7 @@ void VisRepFinder::calculateCosts(
     auto eePair = embTreeNode.embeddedGraph().edges();
     for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
 
-        auto& ee     = dynamic_cast<EmbeddedEdge&>(*(*eeit));
+        auto& ee     = downcast<EmbeddedEdge>(*(*eeit));
         auto& aux_ee = aux.mEGEdgeAux[ee.utility()];
 
         aux_ee.mCost = max(
@@ -1437,7 +1451,7 @@ void VisRepFinder::calculateCosts(
     auto dePair = embTreeNode.dualGraph().edges();
     for (auto deit = dePair.first; deit != dePair.second; deit++) {
 
-        auto& de     = dynamic_cast<DualEdge&>(*(*deit));
+        auto& de     = downcast<DualEdge>(*(*deit));
         auto& aux_de = aux.mDGEdgeAux[de.utility()];
         
         auto childrenWidthLeft  = std::max(aux_de.mChildrenWidthUpperLeft,
@@ -1488,7 +1502,7 @@ void VisRepFinder::scheduleEG(
 
     auto nPair = embTreeNode.embeddedGraph().nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
-        auto& embNode    = dynamic_cast<EmbeddedNode&>(*(*nit));
+        auto& embNode    = downcast<EmbeddedNode>(*(*nit));
         auto& embNodeAux = aux.mEGNodeAux[embNode.utility()];
         embNodeAux.mEarlyStart = 0;
         embNodeAux.mNumOutgoingProcessed = 0;
@@ -1502,17 +1516,17 @@ void VisRepFinder::scheduleEG(
     Qsize++;
 
     while (Qsize >0) {
-        auto& embNode = dynamic_cast<EmbeddedNode&>(*(*(*(Q.begin()))));
+        auto& embNode = downcast<EmbeddedNode>(*(*(*(Q.begin()))));
         auto& embNodeAux = aux.mEGNodeAux[embNode.utility()];
 
         Q.pop_front();
         Qsize--;
 
         for (auto eit : embNodeAux.mEdgesIn) {
-            auto& embEdge    = dynamic_cast<EmbeddedEdge&>(*(*eit));
+            auto& embEdge    = downcast<EmbeddedEdge>(*(*eit));
             auto& embEdgeAux = aux.mEGEdgeAux[embEdge.utility()];
 
-            auto& adjNode    = dynamic_cast<EmbeddedNode&>(
+            auto& adjNode    = downcast<EmbeddedNode>(
                                                 embEdge.adjacentNode(embNode));
             auto& adjNodeAux = aux.mEGNodeAux[adjNode.utility()];
 
@@ -1546,11 +1560,11 @@ void VisRepFinder::scheduleDG(
     auto fPair = embTreeNode.dualGraph().nodes();
     for (auto fit = fPair.first; fit != fPair.second; fit++) {
 
-        auto& f     = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& f     = downcast<EmbeddedFace>(*(*fit));
         auto& aux_f = aux.mDGFaceAux[f.utility()];
 
         if (fit == rightIt) {
-            auto& st     = dynamic_cast<DualEdge&>(*(*stDualIt));
+            auto& st     = downcast<DualEdge>(*(*stDualIt));
             auto& aux_st = aux.mDGEdgeAux[st.utility()];
             aux_f.mEarlyStart = aux_st.mCost;
         }
@@ -1569,18 +1583,18 @@ void VisRepFinder::scheduleDG(
 
     while (Qsize >0) {
 
-        auto& f     = dynamic_cast<EmbeddedFace&>(*(*(*(Q.begin()))));
+        auto& f     = downcast<EmbeddedFace>(*(*(*(Q.begin()))));
         auto& aux_f = aux.mDGFaceAux[f.utility()];
         Q.pop_front();
         Qsize--;
 
         for (auto eit : aux_f.mEdgesOut) {
 
-            auto& de     = dynamic_cast<DualEdge&>(*(*eit));
+            auto& de     = downcast<DualEdge>(*(*eit));
             auto& aux_de = aux.mDGEdgeAux[de.utility()];
             if (!aux_de.mCountMeOut) {
 
-                auto& adjF        = dynamic_cast<EmbeddedFace&>(
+                auto& adjF        = downcast<EmbeddedFace>(
                                                            de.adjacentNode(f));
 
                 auto& aux_adjF    = aux.mDGFaceAux[adjF.utility()];
@@ -1616,7 +1630,7 @@ void VisRepFinder::assignCoordinates(
     auto nPair = embTreeNode.embeddedGraph().nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 
-        auto& en     = dynamic_cast<EmbeddedNode&>(*(*nit));
+        auto& en     = downcast<EmbeddedNode>(*(*nit));
         auto& aux_en = aux.mEGNodeAux[en.utility()];
         aux_en.mY    = aux_en.mEarlyStart;
 
@@ -1625,7 +1639,7 @@ void VisRepFinder::assignCoordinates(
     auto fPair = embTreeNode.dualGraph().nodes();
     for (auto fit = fPair.first; fit != fPair.second; fit++) {
 
-        auto& f     = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& f     = downcast<EmbeddedFace>(*(*fit));
         auto& aux_f = aux.mDGFaceAux[f.utility()];
         aux_f.mX    = aux_f.mEarlyStart;
 
@@ -1634,12 +1648,12 @@ void VisRepFinder::assignCoordinates(
     auto eePair = embTreeNode.embeddedGraph().edges();
     for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
 
-        auto& ee     = dynamic_cast<EmbeddedEdge&>(*(*eeit));
+        auto& ee     = downcast<EmbeddedEdge>(*(*eeit));
         auto& aux_ee = aux.mEGEdgeAux[ee.utility()];
-        auto& de     = dynamic_cast<DualEdge&>(*(*(ee.mDualEdge)));
+        auto& de     = downcast<DualEdge>(*(*(ee.mDualEdge)));
         auto& aux_de = aux.mDGEdgeAux[de.utility()];
-        auto& en1    = dynamic_cast<EmbeddedNode&>(ee.incidentNode1());
-        auto& en2    = dynamic_cast<EmbeddedNode&>(ee.incidentNode2());
+        auto& en1    = downcast<EmbeddedNode>(ee.incidentNode1());
+        auto& en2    = downcast<EmbeddedNode>(ee.incidentNode2());
                                                       
         node_list_it_t fLIt;
         node_list_it_t fRIt;
@@ -1657,9 +1671,9 @@ void VisRepFinder::assignCoordinates(
             fLIt = ee.mHalfEdge1.mEmbeddedFace;
         }
 
-        auto& fR     = dynamic_cast<EmbeddedFace&>(*(*fRIt));
+        auto& fR     = downcast<EmbeddedFace>(*(*fRIt));
         auto& aux_fR = aux.mDGFaceAux[fR.utility()];
-        auto& fL     = dynamic_cast<EmbeddedFace&>(*(*fLIt));
+        auto& fL     = downcast<EmbeddedFace>(*(*fLIt));
         auto& aux_fL = aux.mDGFaceAux[fL.utility()];
 
         auto Xfr = aux_fR.mEarlyStart - aux_de.mRightInset;
@@ -1677,7 +1691,7 @@ void VisRepFinder::assignCoordinates(
     auto& aux_oF = aux.mDGFaceAux[oF.utility()];
     auto& tN     = embTreeNode.topNode();
     auto& aux_tN = aux.mEGNodeAux[tN.utility()];
-    auto& bN     = dynamic_cast<EmbeddedNode&>(*(*bottomIt));
+    auto& bN     = downcast<EmbeddedNode>(*(*bottomIt));
     auto& aux_bN = aux.mEGNodeAux[bN.utility()];
 
     aux.mBlockWidth  = aux_oF.mEarlyStart + aux_oF.mCost;
@@ -1739,7 +1753,7 @@ void VisRepFinder::normalizeBlockCoordinates(
     auto nPair = embTreeNode.embeddedGraph().nodes();
     for (auto nit = nPair.first; nit != nPair.second; nit++) {
 
-        auto& embNode    = dynamic_cast<EmbeddedNode&>(*(*nit));
+        auto& embNode    = downcast<EmbeddedNode>(*(*nit));
         auto& embNodeAux = aux.mEGNodeAux[embNode.utility()];
         embNodeAux.mY += (aux.mYOffsetBlock);
 
@@ -1748,7 +1762,7 @@ void VisRepFinder::normalizeBlockCoordinates(
     auto eePair = embTreeNode.embeddedGraph().edges();
     for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
 
-        auto& embEdge    = dynamic_cast<EmbeddedEdge&>(*(*eeit));
+        auto& embEdge    = downcast<EmbeddedEdge>(*(*eeit));
         auto& embEdgeAux = aux.mEGEdgeAux[embEdge.utility()];
         embEdgeAux.mX += (aux.mXOffsetBlock);
 
@@ -1757,7 +1771,7 @@ void VisRepFinder::normalizeBlockCoordinates(
     auto fPair = embTreeNode.dualGraph().nodes();
     for (auto fit = fPair.first; fit != fPair.second; fit++) {
 
-        auto& f     = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& f     = downcast<EmbeddedFace>(*(*fit));
         auto& aux_f = aux.mDGFaceAux[f.utility()];
         aux_f.mX    += (aux.mXOffsetBlock);
 
@@ -1899,16 +1913,8 @@ void VisRepFinder::performPass2TopDown()
 //    cerr << "\n\nperformPass2TopDown() BEGIN\n";
     auto& expTree = mEBCTree.explorationTree();
     auto& expRoot   = expTree.root();
-    auto& embRoot   = dynamic_cast<EmbeddedBCTreeNode&>(
-                                                  expRoot.IGBackwardLinkRef());
-    auto& aux       = mAux[embRoot.utility()];
 
-    aux.mAnchorX1            = 0.0;
-    aux.mAnchorY1            = 0.0;
-    aux.mAnchorX2            = aux.mWidth;
-    aux.mAnchorY2            = aux.mHeight;
-    aux.mFlippedVertically   = false;
-    aux.mFlippedHorizontally = false;
+    setRootAnchor();
 
     list<node_list_it_t> Q;
     size_t               Qsize = 0;
@@ -1919,7 +1925,7 @@ void VisRepFinder::performPass2TopDown()
 
     while (Qsize > 0) {
 
-        auto& expNode = dynamic_cast<EmbeddedBCTree::ExplorationNode&>(
+        auto& expNode = downcast<EmbeddedBCTree::ExplorationNode>(
                                                           *(*(*(Q.begin()))));
         Q.pop_front();
         Qsize--;
@@ -1935,9 +1941,9 @@ void VisRepFinder::performPass2TopDown()
 #endif
         auto ePair = expNode.incidentEdgesOut();
         for (auto eit = ePair.first; eit != ePair.second; eit++) {
-            auto& expEdge = dynamic_cast<EmbeddedBCTree::ExplorationEdge&>(
+            auto& expEdge = downcast<EmbeddedBCTree::ExplorationEdge>(
                                                                    *(*(*eit)));
-            auto& adjNode = dynamic_cast<EmbeddedBCTree::ExplorationNode&>(
+            auto& adjNode = downcast<EmbeddedBCTree::ExplorationNode>(
                                                 expEdge.adjacentNode(expNode));
             Q.push_back(adjNode.backIt());
             Qsize++;
@@ -1948,6 +1954,129 @@ void VisRepFinder::performPass2TopDown()
 }
 
 
+/** @brief the root block is placed at the origin in the natural
+ *         orientation.
+ */
+void VisRepFinder::setRootAnchor()
+{
+    auto& expRoot   = mEBCTree.explorationTree().root();
+    auto& embRoot   = downcast<EmbeddedBCTreeNode>(
+                                                  expRoot.IGBackwardLinkRef());
+    auto& aux       = mAux[embRoot.utility()];
+
+    aux.mAnchorX1            = 0.0;
+    aux.mAnchorY1            = 0.0;
+    aux.mAnchorX2            = aux.mWidth;
+    aux.mAnchorY2            = aux.mHeight;
+    aux.mFlippedVertically   = false;
+    aux.mFlippedHorizontally = false;
+}
+
+
+void VisRepFinder::performPassInParallel(bool bottomUp)
+{
+    auto& expTree = mEBCTree.explorationTree();
+
+    if (!bottomUp) {
+        setRootAnchor();
+    }
+
+    size_t numThreads = numWorkerThreads(mNumThreads, expTree.numNodes());
+
+    using ExpNode = EmbeddedBCTree::ExplorationNode;
+    using ExpEdge = EmbeddedBCTree::ExplorationEdge;
+
+    // The following are guarded by m.
+    // numChildrenRemaining is indexed by the aux index of the tree node.
+    std::mutex              m;
+    std::condition_variable cv;
+    std::deque<ExpNode*>    ready;
+    vector<size_t>          numChildrenRemaining(mAux.size(), 0);
+    size_t                  numRemaining = expTree.numNodes();
+    exception_ptr           error;
+
+    if (bottomUp) {
+        for (auto nit = expTree.nodes().first;
+                                        nit != expTree.nodes().second; nit++) {
+            auto& expNode = downcast<ExpNode>(*(*nit));
+            auto& embTN   = downcast<EmbeddedBCTreeNode>(
+                                                  expNode.IGBackwardLinkRef());
+            numChildrenRemaining[embTN.utility()] = expNode.degreeOut();
+            if (expNode.degreeOut() == 0) {
+                ready.push_back(&expNode);
+            }
+        }
+    }
+    else {
+        ready.push_back(&(expTree.root()));
+    }
+
+    parallelFor(numThreads, [&](size_t) {
+
+        std::unique_lock<std::mutex> lock(m);
+
+        while (true) {
+
+            cv.wait(lock, [&]{
+                return !ready.empty() || numRemaining == 0 || error != nullptr;
+            });
+            if (numRemaining == 0 || error != nullptr) {
+                return;
+            }
+
+            auto& expNode = *(ready.front());
+            ready.pop_front();
+            lock.unlock();
+
+            try {
+                if (bottomUp) {
+                    processOneTreeNodePass1(expNode);
+                }
+                else {
+                    processOneTreeNodePass2(expNode);
+                }
+            }
+            catch (...) {
+                lock.lock();
+                error = current_exception();
+                cv.notify_all();
+                return;
+            }
+
+            lock.lock();
+            numRemaining--;
+
+            if (bottomUp) {
+                if (expNode.degreeIn() > 0) {
+                    auto& expEdge   = downcast<ExpEdge>(
+                                   *(*(*(expNode.incidentEdgesIn().first))));
+                    auto& expParent = downcast<ExpNode>(
+                                                expEdge.adjacentNode(expNode));
+                    auto& embParent = downcast<EmbeddedBCTreeNode>(
+                                                expParent.IGBackwardLinkRef());
+                    if (--numChildrenRemaining[embParent.utility()] == 0) {
+                        ready.push_back(&expParent);
+                    }
+                }
+            }
+            else {
+                auto ePair = expNode.incidentEdgesOut();
+                for (auto eit = ePair.first; eit != ePair.second; eit++) {
+                    auto& expEdge = downcast<ExpEdge>(*(*(*eit)));
+                    ready.push_back(&(downcast<ExpNode>(
+                                               expEdge.adjacentNode(expNode))));
+                }
+            }
+            cv.notify_all();
+        }
+    });
+
+    if (error != nullptr) {
+        rethrow_exception(error);
+    }
+}
+
+
 void VisRepFinder::processOneTreeNodePass2(
     EmbeddedBCTree::ExplorationNode& expNode
 ) {
@@ -1957,7 +2086,7 @@ void VisRepFinder::processOneTreeNodePass2(
 
 #ifdef UNIT_TESTS_XXX
     debugPrintTranslate(
-            dynamic_cast<EmbeddedBCTreeNode&>(expNode.IGBackwardLinkRef()), 4);
+            downcast<EmbeddedBCTreeNode>(expNode.IGBackwardLinkRef()), 4);
 #endif
 
     // Set AnchorX, AnchorY, mRorate180, and mFlipped of children
@@ -2607,13 +2736,13 @@ void VisRepFinder::translate(
 ) {
 //cerr  << "translate() BEGIN\n";
     auto& embTN = 
-                dynamic_cast<EmbeddedBCTreeNode&>(expNode.IGBackwardLinkRef());
+                downcast<EmbeddedBCTreeNode>(expNode.IGBackwardLinkRef());
     auto& aux   = mAux[embTN.utility()];
 
     // based on the anchor point.
     auto enPair = embTN.embeddedGraph().nodes();
     for (auto enit = enPair.first; enit != enPair.second; enit++) {
-        auto& en     = dynamic_cast<EmbeddedNode&>(*(*enit));
+        auto& en     = downcast<EmbeddedNode>(*(*enit));
         auto& aux_en = aux.mEGNodeAux[en.utility()];
 
         aux_en.mY += aux.mAnchorY1;
@@ -2621,7 +2750,7 @@ void VisRepFinder::translate(
 
     auto eePair = embTN.embeddedGraph().edges();
     for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
-        auto& ee     = dynamic_cast<EmbeddedEdge&>(*(*eeit));
+        auto& ee     = downcast<EmbeddedEdge>(*(*eeit));
         auto& aux_ee = aux.mEGEdgeAux[ee.utility()];
 
         aux_ee.mX += aux.mAnchorX1;
@@ -2629,7 +2758,7 @@ void VisRepFinder::translate(
 
     auto fPair = embTN.dualGraph().nodes();
     for (auto fit = fPair.first; fit != fPair.second; fit++) {
-        auto& f     = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& f     = downcast<EmbeddedFace>(*(*fit));
         auto& aux_f = aux.mDGFaceAux[f.utility()];
 
         aux_f.mX += aux.mAnchorX1;
@@ -2685,7 +2814,7 @@ void VisRepFinder::correctOrientations(
 ) {
 //    cerr << "correctOrientations() BEGIN\n";
     auto& embTN =
-                dynamic_cast<EmbeddedBCTreeNode&>(expNode.IGBackwardLinkRef());
+                downcast<EmbeddedBCTreeNode>(expNode.IGBackwardLinkRef());
 
     auto& aux   = mAux[embTN.utility()];
 
@@ -2696,7 +2825,7 @@ void VisRepFinder::correctOrientations(
 //cerr << "aux.mFlippedVertically\n";
         auto enPair = embTN.embeddedGraph().nodes();
         for (auto enit = enPair.first; enit != enPair.second; enit++) {
-            auto& en     = dynamic_cast<EmbeddedNode&>(*(*enit));
+            auto& en     = downcast<EmbeddedNode>(*(*enit));
             auto& aux_en = aux.mEGNodeAux[en.utility()];
 //            cerr << "aux_en.mY 1: " << aux_en.mY << "\n";
             aux_en.mY = aux.mAnchorY2 - (aux_en.mY - aux.mAnchorY1);
@@ -2708,7 +2837,7 @@ void VisRepFinder::correctOrientations(
 //cerr << "aux.mFlippedHorizontally\n";
         auto eePair = embTN.embeddedGraph().edges();
         for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
-            auto& ee     = dynamic_cast<EmbeddedEdge&>(*(*eeit));
+            auto& ee     = downcast<EmbeddedEdge>(*(*eeit));
             auto& aux_ee = aux.mEGEdgeAux[ee.utility()];
 
             aux_ee.mX = aux.mAnchorX2 - (aux_ee.mX - aux.mAnchorX1);
@@ -2717,7 +2846,7 @@ void VisRepFinder::correctOrientations(
 
         auto fPair = embTN.dualGraph().nodes();
         for (auto fit = fPair.first; fit != fPair.second; fit++) {
-            auto& f     = dynamic_cast<EmbeddedFace&>(*(*fit));
+            auto& f     = downcast<EmbeddedFace>(*(*fit));
             auto& aux_f = aux.mDGFaceAux[f.utility()];
 
             aux_f.mX = aux.mAnchorX2 - (aux_f.mX - aux.mAnchorX1);
@@ -2729,7 +2858,7 @@ void VisRepFinder::correctOrientations(
 //cerr << "Edge Flipped\n";
         auto eePair = embTN.embeddedGraph().edges();
         for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
-            auto& ee     = dynamic_cast<EmbeddedEdge&>(*(*eeit));
+            auto& ee     = downcast<EmbeddedEdge>(*(*eeit));
             auto& aux_ee = aux.mEGEdgeAux[ee.utility()];
             aux_ee.mFlipped = true;
         }
@@ -2821,11 +2950,11 @@ void VisRepFinder::findVRCoordinates()
 
     auto& expTree      = mEBCTree.explorationTree();
     auto& bcTree       = mEBCTree.bcTree();
-    auto& labelGraph   = dynamic_cast<VRRectLabelGraph&>(bcTree.original());
+    auto& labelGraph   = downcast<VRRectLabelGraph>(bcTree.original());
 
     auto& expRoot      = expTree.root();
     auto& embRoot      =
-                dynamic_cast<EmbeddedBCTreeNode&>(expRoot.IGBackwardLinkRef());
+                downcast<EmbeddedBCTreeNode>(expRoot.IGBackwardLinkRef());
     auto& aux          = mAux[embRoot.utility()];
 
     // Assign the width and height of VR.
@@ -2835,7 +2964,7 @@ void VisRepFinder::findVRCoordinates()
     // Reset the flag.
     auto lgnPair = labelGraph.nodes();
     for (auto nit = lgnPair.first; nit != lgnPair.second; nit++) {
-        auto& N = dynamic_cast<VRRectLabelNode&>(*(*nit));
+        auto& N = downcast<VRRectLabelNode>(*(*nit));
         N.mXset = false;
     }
 
@@ -2850,7 +2979,7 @@ void VisRepFinder::findVRCoordinates()
 
     while (Qsize > 0) {
 
-        auto& expNode = dynamic_cast<EmbeddedBCTree::ExplorationNode&>(
+        auto& expNode = downcast<EmbeddedBCTree::ExplorationNode>(
                                                           *(*(*(Q.begin()))));
         Q.pop_front();
         Qsize--;
@@ -2859,9 +2988,9 @@ void VisRepFinder::findVRCoordinates()
 
         auto ePair = expNode.incidentEdgesOut();
         for (auto eit = ePair.first; eit != ePair.second; eit++) {
-            auto& expEdge = dynamic_cast<EmbeddedBCTree::ExplorationEdge&>(
+            auto& expEdge = downcast<EmbeddedBCTree::ExplorationEdge>(
                                                                    *(*(*eit)));
-            auto& adjNode = dynamic_cast<EmbeddedBCTree::ExplorationNode&>(
+            auto& adjNode = downcast<EmbeddedBCTree::ExplorationNode>(
                                                 expEdge.adjacentNode(expNode));
             Q.push_back(adjNode.backIt());
             Qsize++;
@@ -2870,9 +2999,9 @@ void VisRepFinder::findVRCoordinates()
 
     auto lgePair = labelGraph.edges();
     for (auto eit = lgePair.first; eit != lgePair.second; eit++) {
-        auto& E  = dynamic_cast<VRRectLabelEdge&>(*(*eit));
-        auto& N1 = dynamic_cast<VRRectLabelNode&>(E.incidentNode1());
-        auto& N2 = dynamic_cast<VRRectLabelNode&>(E.incidentNode2());
+        auto& E  = downcast<VRRectLabelEdge>(*(*eit));
+        auto& N1 = downcast<VRRectLabelNode>(E.incidentNode1());
+        auto& N2 = downcast<VRRectLabelNode>(E.incidentNode2());
         E.mY1 = N1.mY;
         E.mY2 = N2.mY;
     }
@@ -2883,7 +3012,7 @@ void VisRepFinder::findVRCoordinatesOfTreeNode(
     EmbeddedBCTree::ExplorationNode& expNode
 ) {
     auto& embTN =
-                dynamic_cast<EmbeddedBCTreeNode&>(expNode.IGBackwardLinkRef());
+                downcast<EmbeddedBCTreeNode>(expNode.IGBackwardLinkRef());
     auto& aux       = mAux[embTN.utility()];
     auto& outerFace = embTN.outerFace();
 
@@ -2891,17 +3020,17 @@ void VisRepFinder::findVRCoordinatesOfTreeNode(
     // based on the anchor point and the orientation.
     auto enPair = embTN.embeddedGraph().nodes();
     for (auto enit = enPair.first; enit != enPair.second; enit++) {
-        auto& en     = dynamic_cast<EmbeddedNode&>(*(*enit));
+        auto& en     = downcast<EmbeddedNode>(*(*enit));
         auto& aux_en = aux.mEGNodeAux[en.utility()];
-        auto& bn = dynamic_cast<BlockNode&>(en.IGBackwardLinkRef());
-        auto& ln = dynamic_cast<VRRectLabelNode&>(bn.IGBackwardLinkRef());
+        auto& bn = downcast<BlockNode>(en.IGBackwardLinkRef());
+        auto& ln = downcast<VRRectLabelNode>(bn.IGBackwardLinkRef());
 
         ln.mY = aux.mFlippedVertically?
                     aux_en.mY - aux_en.mLabelHeight / 2.0:
                     aux_en.mY + aux_en.mLabelHeight / 2.0;
 
-        auto& fleft  = dynamic_cast<EmbeddedFace&>(*(*(aux_en.mLeftFace)));
-        auto& fright = dynamic_cast<EmbeddedFace&>(*(*(aux_en.mRightFace)));
+        auto& fleft  = downcast<EmbeddedFace>(*(*(aux_en.mLeftFace)));
+        auto& fright = downcast<EmbeddedFace>(*(*(aux_en.mRightFace)));
         auto& aux_fl = aux.mDGFaceAux[fleft.utility()];
         auto& aux_fr = aux.mDGFaceAux[fright.utility()];
 
@@ -2946,9 +3075,9 @@ void VisRepFinder::findVRCoordinatesOfTreeNode(
 
     auto eePair = embTN.embeddedGraph().edges();
     for (auto eeit = eePair.first; eeit != eePair.second; eeit++) {
-        auto& ee = dynamic_cast<EmbeddedEdge&>(*(*eeit));
-        auto& be = dynamic_cast<BlockEdge&>(ee.IGBackwardLinkRef());
-        auto& le = dynamic_cast<VRRectLabelEdge&>(be.IGBackwardLinkRef());
+        auto& ee = downcast<EmbeddedEdge>(*(*eeit));
+        auto& be = downcast<BlockEdge>(ee.IGBackwardLinkRef());
+        auto& le = downcast<VRRectLabelEdge>(be.IGBackwardLinkRef());
         auto& aux_ee = aux.mEGEdgeAux[ee.utility()];
 
         le.mX = aux_ee.mX;
@@ -2984,13 +3113,13 @@ std::ostream& EGNodeAux::debugPrint(std::ostream& os, size_t indent, long nodeNu
 
     for (auto e : mEdgesIn) {
 
-        auto& E  = dynamic_cast<EmbeddedEdge&>(*(*e));
-        auto& N1 = dynamic_cast<EmbeddedNode&>(E.incidentNode1());
-        auto& N2 = dynamic_cast<EmbeddedNode&>(E.incidentNode2());
-        auto& B1 = dynamic_cast<BlockNode&>(N1.IGBackwardLinkRef());
-        auto& B2 = dynamic_cast<BlockNode&>(N2.IGBackwardLinkRef());
-        auto& L1 = dynamic_cast<VRRectLabelNode&>(B1.IGBackwardLinkRef());
-        auto& L2 = dynamic_cast<VRRectLabelNode&>(B2.IGBackwardLinkRef());
+        auto& E  = downcast<EmbeddedEdge>(*(*e));
+        auto& N1 = downcast<EmbeddedNode>(E.incidentNode1());
+        auto& N2 = downcast<EmbeddedNode>(E.incidentNode2());
+        auto& B1 = downcast<BlockNode>(N1.IGBackwardLinkRef());
+        auto& B2 = downcast<BlockNode>(N2.IGBackwardLinkRef());
+        auto& L1 = downcast<VRRectLabelNode>(B1.IGBackwardLinkRef());
+        auto& L2 = downcast<VRRectLabelNode>(B2.IGBackwardLinkRef());
 
         os << "{" << ((L1.mDebugNum==nodeNum)?L2.mDebugNum:
                                               L1.mDebugNum) << ","
@@ -3002,13 +3131,13 @@ std::ostream& EGNodeAux::debugPrint(std::ostream& os, size_t indent, long nodeNu
     os << "mEdgesOut: ";
     for (auto e : mEdgesOut) {
 
-        auto& E  = dynamic_cast<EmbeddedEdge&>(*(*e));
-        auto& N1 = dynamic_cast<EmbeddedNode&>(E.incidentNode1());
-        auto& N2 = dynamic_cast<EmbeddedNode&>(E.incidentNode2());
-        auto& B1 = dynamic_cast<BlockNode&>(N1.IGBackwardLinkRef());
-        auto& B2 = dynamic_cast<BlockNode&>(N2.IGBackwardLinkRef());
-        auto& L1 = dynamic_cast<VRRectLabelNode&>(B1.IGBackwardLinkRef());
-        auto& L2 = dynamic_cast<VRRectLabelNode&>(B2.IGBackwardLinkRef());
+        auto& E  = downcast<EmbeddedEdge>(*(*e));
+        auto& N1 = downcast<EmbeddedNode>(E.incidentNode1());
+        auto& N2 = downcast<EmbeddedNode>(E.incidentNode2());
+        auto& B1 = downcast<BlockNode>(N1.IGBackwardLinkRef());
+        auto& B2 = downcast<BlockNode>(N2.IGBackwardLinkRef());
+        auto& L1 = downcast<VRRectLabelNode>(B1.IGBackwardLinkRef());
+        auto& L2 = downcast<VRRectLabelNode>(B2.IGBackwardLinkRef());
         os << "{" << ((L1.mDebugNum==nodeNum)?L1.mDebugNum:
                                               L2.mDebugNum) << ","
            <<        ((L1.mDebugNum==nodeNum)?L2.mDebugNum:
@@ -3055,9 +3184,9 @@ std::ostream& DGFaceAux::debugPrint(std::ostream& os, size_t indent, long nodeNu
     os << "mEdgesIn: ";
     for (auto e : mEdgesIn) {
 
-        auto& D  = dynamic_cast<DualEdge&>(*(*e));
-        auto& F1 = dynamic_cast<EmbeddedFace&>(D.incidentNode1());
-        auto& F2 = dynamic_cast<EmbeddedFace&>(D.incidentNode2());
+        auto& D  = downcast<DualEdge>(*(*e));
+        auto& F1 = downcast<EmbeddedFace>(D.incidentNode1());
+        auto& F2 = downcast<EmbeddedFace>(D.incidentNode2());
         os << "{" << ((F1.mDebugNum==nodeNum)?F2.mDebugNum:
                                               F1.mDebugNum) << ","
            <<        ((F1.mDebugNum==nodeNum)?F1.mDebugNum:
@@ -3067,9 +3196,9 @@ std::ostream& DGFaceAux::debugPrint(std::ostream& os, size_t indent, long nodeNu
     os << "mEdgesOut: ";
     for (auto e : mEdgesOut) {
 
-        auto& D  = dynamic_cast<DualEdge&>(*(*e));
-        auto& F1 = dynamic_cast<EmbeddedFace&>(D.incidentNode1());
-        auto& F2 = dynamic_cast<EmbeddedFace&>(D.incidentNode2());
+        auto& D  = downcast<DualEdge>(*(*e));
+        auto& F1 = downcast<EmbeddedFace>(D.incidentNode1());
+        auto& F2 = downcast<EmbeddedFace>(D.incidentNode2());
         os << "{" << ((F1.mDebugNum==nodeNum)?F1.mDebugNum:
                                               F2.mDebugNum) << ","
            <<        ((F1.mDebugNum==nodeNum)?F2.mDebugNum:
@@ -3141,8 +3270,8 @@ std::ostream& ETNodeAux::debugPrint(std::ostream& os, size_t indent)
 
 void VisRepFinder::debugPrint(EmbeddedBCTree::ExplorationNode& N, size_t indent)
 {
-    auto& EBN = dynamic_cast<EmbeddedBCTreeNode&>(N.IGBackwardLinkRef());
-    auto& BN  = dynamic_cast<BCTreeNode&>(EBN.IGBackwardLinkRef());
+    auto& EBN = downcast<EmbeddedBCTreeNode>(N.IGBackwardLinkRef());
+    auto& BN  = downcast<BCTreeNode>(EBN.IGBackwardLinkRef());
     auto& B   = BN.block();
 
     debugIndent(std::cerr, indent);
@@ -3151,9 +3280,9 @@ void VisRepFinder::debugPrint(EmbeddedBCTree::ExplorationNode& N, size_t indent)
     cerr << "\n";
     for (auto enit = EBN.embeddedGraph().nodes().first;
          enit != EBN.embeddedGraph().nodes().second; enit++ ) {
-         auto& EN = dynamic_cast<EmbeddedNode&>(*(*enit));
-         auto& BN = dynamic_cast<BlockNode&>(EN.IGBackwardLinkRef());
-         auto& LN = dynamic_cast<VRRectLabelNode&>(BN.IGBackwardLinkRef());
+         auto& EN = downcast<EmbeddedNode>(*(*enit));
+         auto& BN = downcast<BlockNode>(EN.IGBackwardLinkRef());
+         auto& LN = downcast<VRRectLabelNode>(BN.IGBackwardLinkRef());
          debugIndent(std::cerr, indent+4);
          cerr << "EmbeddedNode: " << LN.mDebugNum << " ";
          mAux[EBN.utility()].mEGNodeAux[EN.utility()].debugPrint(
@@ -3162,13 +3291,13 @@ void VisRepFinder::debugPrint(EmbeddedBCTree::ExplorationNode& N, size_t indent)
     }
     for (auto eeit = EBN.embeddedGraph().edges().first;
          eeit != EBN.embeddedGraph().edges().second; eeit++ ) {
-         auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*eeit));
-         auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-         auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-         auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-         auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-         auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-         auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+         auto& EE  = downcast<EmbeddedEdge>(*(*eeit));
+         auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+         auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+         auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+         auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+         auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+         auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
          debugIndent(std::cerr, indent+4);
          cerr << "EmbeddedEdge: {" << LN1.mDebugNum << ","
                                                       << LN2.mDebugNum << "} ";
@@ -3177,7 +3306,7 @@ void VisRepFinder::debugPrint(EmbeddedBCTree::ExplorationNode& N, size_t indent)
     }
     for (auto fit = EBN.dualGraph().nodes().first;
          fit != EBN.dualGraph().nodes().second; fit++ ) {
-         auto& F = dynamic_cast<EmbeddedFace&>(*(*fit));
+         auto& F = downcast<EmbeddedFace>(*(*fit));
          debugIndent(std::cerr, indent+4);
          cerr << "EmbeddedFace: " << F.mDebugNum << " ";
          mAux[EBN.utility()].mDGFaceAux[F.utility()].debugPrint(
@@ -3186,16 +3315,16 @@ void VisRepFinder::debugPrint(EmbeddedBCTree::ExplorationNode& N, size_t indent)
     }
     for (auto deit = EBN.dualGraph().edges().first;
          deit != EBN.dualGraph().edges().second; deit++ ) {
-         auto& DE  = dynamic_cast<DualEdge&>(*(*deit));
-         auto& F1 = dynamic_cast<EmbeddedFace&>(DE.incidentNode1());
-         auto& F2 = dynamic_cast<EmbeddedFace&>(DE.incidentNode2());
-         auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*(DE.mEmbeddedEdge)));
-         auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-         auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-         auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-         auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-         auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-         auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+         auto& DE  = downcast<DualEdge>(*(*deit));
+         auto& F1 = downcast<EmbeddedFace>(DE.incidentNode1());
+         auto& F2 = downcast<EmbeddedFace>(DE.incidentNode2());
+         auto& EE  = downcast<EmbeddedEdge>(*(*(DE.mEmbeddedEdge)));
+         auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+         auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+         auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+         auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+         auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+         auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
 
          debugIndent(std::cerr, indent+4);
          cerr << "DualEdge: {" << F1.mDebugNum << "," << F2.mDebugNum << "} ";
@@ -3218,39 +3347,39 @@ void VisRepFinder::debugPrintFindBottomNodeAndLeftMostFace(
 
     debugIndent(std::cerr, indent);
     cerr << "findBottomNodeAndLeftMostFace()\n";
-    auto& BTN = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
+    auto& BTN = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
     auto& B   = BTN.block();
     debugIndent(std::cerr, indent);
     cerr << "Block: " << B.mDebugNum << " ";
     auto& TopEN = ETN.topNode();
-    auto& TopBN = dynamic_cast<BlockNode&>(TopEN.IGBackwardLinkRef());
-    auto& TopLN = dynamic_cast<VRRectLabelNode&>(TopBN.IGBackwardLinkRef());
+    auto& TopBN = downcast<BlockNode>(TopEN.IGBackwardLinkRef());
+    auto& TopLN = downcast<VRRectLabelNode>(TopBN.IGBackwardLinkRef());
     cerr << "Top Node: " << TopLN.mDebugNum << " ";
 
-    auto& BottomEN = dynamic_cast<EmbeddedNode&>(*(*bottomIt));
-    auto& BottomBN = dynamic_cast<BlockNode&>(BottomEN.IGBackwardLinkRef());
-    auto& BottomLN = dynamic_cast<VRRectLabelNode&>(
+    auto& BottomEN = downcast<EmbeddedNode>(*(*bottomIt));
+    auto& BottomBN = downcast<BlockNode>(BottomEN.IGBackwardLinkRef());
+    auto& BottomLN = downcast<VRRectLabelNode>(
                                                  BottomBN.IGBackwardLinkRef());
     cerr << "Bottom Node: " << BottomLN.mDebugNum << " ";
 
     auto& OuterF = ETN.outerFace();
     cerr << "Outer Face: " << OuterF.mDebugNum << " ";
 
-    auto& RightF = dynamic_cast<EmbeddedFace&>(*(*rightIt));
+    auto& RightF = downcast<EmbeddedFace>(*(*rightIt));
     cerr << "Right Face: " << RightF.mDebugNum << " ";
 
-    auto& ST = dynamic_cast<EmbeddedEdge&>(*(*stIt));
-    auto& EN1 = dynamic_cast<EmbeddedNode&>(ST.incidentNode1());
-    auto& EN2 = dynamic_cast<EmbeddedNode&>(ST.incidentNode2());
-    auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-    auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-    auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-    auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+    auto& ST = downcast<EmbeddedEdge>(*(*stIt));
+    auto& EN1 = downcast<EmbeddedNode>(ST.incidentNode1());
+    auto& EN2 = downcast<EmbeddedNode>(ST.incidentNode2());
+    auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+    auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+    auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+    auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
     cerr << "ST: {" << LN1.mDebugNum << "," << LN2.mDebugNum << "} ";   
 
-    auto& STDual = dynamic_cast<DualEdge&>(*(*stDualIt));
-    auto& F1 = dynamic_cast<EmbeddedFace&>(STDual.incidentNode1());
-    auto& F2 = dynamic_cast<EmbeddedFace&>(STDual.incidentNode2());
+    auto& STDual = downcast<DualEdge>(*(*stDualIt));
+    auto& F1 = downcast<EmbeddedFace>(STDual.incidentNode1());
+    auto& F2 = downcast<EmbeddedFace>(STDual.incidentNode2());
     cerr << "ST dual: {" << F1.mDebugNum << "," << F2.mDebugNum << "} ";       
 
     cerr << "\n";
@@ -3262,7 +3391,7 @@ void VisRepFinder::debugPrintOrientEGandDG(
     EmbeddedBCTreeNode& ETN,
     size_t              indent
 ) {
-    auto& BN  = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
+    auto& BN  = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
     auto& B   = BN.block();
 
     debugIndent(std::cerr, indent);
@@ -3270,9 +3399,9 @@ void VisRepFinder::debugPrintOrientEGandDG(
 
     for (auto enit = ETN.embeddedGraph().nodes().first;
         enit != ETN.embeddedGraph().nodes().second; enit++ ) {
-        auto& EN = dynamic_cast<EmbeddedNode&>(*(*enit));
-        auto& BN = dynamic_cast<BlockNode&>(EN.IGBackwardLinkRef());
-        auto& LN = dynamic_cast<VRRectLabelNode&>(BN.IGBackwardLinkRef());
+        auto& EN = downcast<EmbeddedNode>(*(*enit));
+        auto& BN = downcast<BlockNode>(EN.IGBackwardLinkRef());
+        auto& LN = downcast<VRRectLabelNode>(BN.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedNode: " << LN.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mEGNodeAux[EN.utility()];
@@ -3281,13 +3410,13 @@ void VisRepFinder::debugPrintOrientEGandDG(
         cerr << "mEdgesIn: ";
         for (auto e : aux.mEdgesIn) {
 
-            auto& E  = dynamic_cast<EmbeddedEdge&>(*(*e));
-            auto& N1 = dynamic_cast<EmbeddedNode&>(E.incidentNode1());
-            auto& N2 = dynamic_cast<EmbeddedNode&>(E.incidentNode2());
-            auto& B1 = dynamic_cast<BlockNode&>(N1.IGBackwardLinkRef());
-            auto& B2 = dynamic_cast<BlockNode&>(N2.IGBackwardLinkRef());
-            auto& L1 = dynamic_cast<VRRectLabelNode&>(B1.IGBackwardLinkRef());
-            auto& L2 = dynamic_cast<VRRectLabelNode&>(B2.IGBackwardLinkRef());
+            auto& E  = downcast<EmbeddedEdge>(*(*e));
+            auto& N1 = downcast<EmbeddedNode>(E.incidentNode1());
+            auto& N2 = downcast<EmbeddedNode>(E.incidentNode2());
+            auto& B1 = downcast<BlockNode>(N1.IGBackwardLinkRef());
+            auto& B2 = downcast<BlockNode>(N2.IGBackwardLinkRef());
+            auto& L1 = downcast<VRRectLabelNode>(B1.IGBackwardLinkRef());
+            auto& L2 = downcast<VRRectLabelNode>(B2.IGBackwardLinkRef());
 
             cerr << "{" << ((L1.mDebugNum==LN.mDebugNum)?L2.mDebugNum:
                                                     L1.mDebugNum) << ","
@@ -3298,13 +3427,13 @@ void VisRepFinder::debugPrintOrientEGandDG(
         cerr << "mEdgesOut: ";
         for (auto e : aux.mEdgesOut) {
 
-            auto& E  = dynamic_cast<EmbeddedEdge&>(*(*e));
-            auto& N1 = dynamic_cast<EmbeddedNode&>(E.incidentNode1());
-            auto& N2 = dynamic_cast<EmbeddedNode&>(E.incidentNode2());
-            auto& B1 = dynamic_cast<BlockNode&>(N1.IGBackwardLinkRef());
-            auto& B2 = dynamic_cast<BlockNode&>(N2.IGBackwardLinkRef());
-            auto& L1 = dynamic_cast<VRRectLabelNode&>(B1.IGBackwardLinkRef());
-            auto& L2 = dynamic_cast<VRRectLabelNode&>(B2.IGBackwardLinkRef());
+            auto& E  = downcast<EmbeddedEdge>(*(*e));
+            auto& N1 = downcast<EmbeddedNode>(E.incidentNode1());
+            auto& N2 = downcast<EmbeddedNode>(E.incidentNode2());
+            auto& B1 = downcast<BlockNode>(N1.IGBackwardLinkRef());
+            auto& B2 = downcast<BlockNode>(N2.IGBackwardLinkRef());
+            auto& L1 = downcast<VRRectLabelNode>(B1.IGBackwardLinkRef());
+            auto& L2 = downcast<VRRectLabelNode>(B2.IGBackwardLinkRef());
             cerr << "{" << ((L1.mDebugNum==LN.mDebugNum)?L1.mDebugNum:
                                                     L2.mDebugNum) << ","
                  <<        ((L1.mDebugNum==LN.mDebugNum)?L2.mDebugNum:
@@ -3317,13 +3446,13 @@ void VisRepFinder::debugPrintOrientEGandDG(
 
     for (auto eeit = ETN.embeddedGraph().edges().first;
          eeit != ETN.embeddedGraph().edges().second; eeit++ ) {
-         auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*eeit));
-         auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-         auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-         auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-         auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-         auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-         auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+         auto& EE  = downcast<EmbeddedEdge>(*(*eeit));
+         auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+         auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+         auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+         auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+         auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+         auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
          debugIndent(std::cerr, indent+4);
          cerr << "EmbeddedEdge: {" << LN1.mDebugNum << "," 
                                                       << LN2.mDebugNum << "} ";
@@ -3334,7 +3463,7 @@ void VisRepFinder::debugPrintOrientEGandDG(
 
     for (auto fit = ETN.dualGraph().nodes().first;
         fit != ETN.dualGraph().nodes().second; fit++ ) {
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& F = downcast<EmbeddedFace>(*(*fit));
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedFace: " << F.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mDGFaceAux[F.utility()];
@@ -3342,9 +3471,9 @@ void VisRepFinder::debugPrintOrientEGandDG(
         cerr << "mEdgesIn: ";
         for (auto e : aux.mEdgesIn) {
 
-            auto& D  = dynamic_cast<DualEdge&>(*(*e));
-            auto& F1 = dynamic_cast<EmbeddedFace&>(D.incidentNode1());
-            auto& F2 = dynamic_cast<EmbeddedFace&>(D.incidentNode2());
+            auto& D  = downcast<DualEdge>(*(*e));
+            auto& F1 = downcast<EmbeddedFace>(D.incidentNode1());
+            auto& F2 = downcast<EmbeddedFace>(D.incidentNode2());
             cerr << "{" << ((F1.mDebugNum==F.mDebugNum)?F2.mDebugNum:
                                                     F1.mDebugNum) << ","
                  <<        ((F1.mDebugNum==F.mDebugNum)?F1.mDebugNum:
@@ -3354,9 +3483,9 @@ void VisRepFinder::debugPrintOrientEGandDG(
         cerr << "mEdgesOut: ";
         for (auto e : aux.mEdgesOut) {
 
-            auto& D  = dynamic_cast<DualEdge&>(*(*e));
-            auto& F1 = dynamic_cast<EmbeddedFace&>(D.incidentNode1());
-            auto& F2 = dynamic_cast<EmbeddedFace&>(D.incidentNode2());
+            auto& D  = downcast<DualEdge>(*(*e));
+            auto& F1 = downcast<EmbeddedFace>(D.incidentNode1());
+            auto& F2 = downcast<EmbeddedFace>(D.incidentNode2());
             cerr << "{" << ((F1.mDebugNum==F.mDebugNum)?F1.mDebugNum:
                                                     F2.mDebugNum) << ","
                  <<        ((F1.mDebugNum==F.mDebugNum)?F2.mDebugNum:
@@ -3368,17 +3497,17 @@ void VisRepFinder::debugPrintOrientEGandDG(
 
     for (auto deit = ETN.dualGraph().edges().first;
          deit != ETN.dualGraph().edges().second; deit++ ) {
-         auto& DE  = dynamic_cast<DualEdge&>(*(*deit));
-         auto& F1 = dynamic_cast<EmbeddedFace&>(DE.incidentNode1());
-         auto& F2 = dynamic_cast<EmbeddedFace&>(DE.incidentNode2());
-
-         auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*(DE.mEmbeddedEdge)));
-         auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-         auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-         auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-         auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-         auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-         auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+         auto& DE  = downcast<DualEdge>(*(*deit));
+         auto& F1 = downcast<EmbeddedFace>(DE.incidentNode1());
+         auto& F2 = downcast<EmbeddedFace>(DE.incidentNode2());
+
+         auto& EE  = downcast<EmbeddedEdge>(*(*(DE.mEmbeddedEdge)));
+         auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+         auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+         auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+         auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+         auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+         auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
 
          debugIndent(std::cerr, indent+4);
          cerr << "DualEdge: {" << F1.mDebugNum << "," << F2.mDebugNum << "} ";
@@ -3396,7 +3525,7 @@ void VisRepFinder::debugPrintHandleNodeLabels(
     EmbeddedBCTreeNode& ETN,
     size_t              indent
 ) {
-    auto& BN  = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
+    auto& BN  = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
     auto& B   = BN.block();
 
     debugIndent(std::cerr, indent);
@@ -3404,9 +3533,9 @@ void VisRepFinder::debugPrintHandleNodeLabels(
 
     for (auto enit = ETN.embeddedGraph().nodes().first;
         enit != ETN.embeddedGraph().nodes().second; enit++ ) {
-        auto& EN = dynamic_cast<EmbeddedNode&>(*(*enit));
-        auto& BN = dynamic_cast<BlockNode&>(EN.IGBackwardLinkRef());
-        auto& LN = dynamic_cast<VRRectLabelNode&>(BN.IGBackwardLinkRef());
+        auto& EN = downcast<EmbeddedNode>(*(*enit));
+        auto& BN = downcast<BlockNode>(EN.IGBackwardLinkRef());
+        auto& LN = downcast<VRRectLabelNode>(BN.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedNode: " << LN.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mEGNodeAux[EN.utility()];
@@ -3416,17 +3545,17 @@ void VisRepFinder::debugPrintHandleNodeLabels(
 
     for (auto deit = ETN.dualGraph().edges().first;
          deit != ETN.dualGraph().edges().second; deit++ ) {
-         auto& DE  = dynamic_cast<DualEdge&>(*(*deit));
-         auto& F1 = dynamic_cast<EmbeddedFace&>(DE.incidentNode1());
-         auto& F2 = dynamic_cast<EmbeddedFace&>(DE.incidentNode2());
-
-         auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*(DE.mEmbeddedEdge)));
-         auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-         auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-         auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-         auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-         auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-         auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+         auto& DE  = downcast<DualEdge>(*(*deit));
+         auto& F1 = downcast<EmbeddedFace>(DE.incidentNode1());
+         auto& F2 = downcast<EmbeddedFace>(DE.incidentNode2());
+
+         auto& EE  = downcast<EmbeddedEdge>(*(*(DE.mEmbeddedEdge)));
+         auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+         auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+         auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+         auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+         auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+         auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
 
          debugIndent(std::cerr, indent+4);
          cerr << "DualEdge: {" << F1.mDebugNum << "," << F2.mDebugNum << "} ";
@@ -3446,7 +3575,7 @@ void VisRepFinder::debugPrintHandleEdgeLabels(
     EmbeddedBCTreeNode& ETN,
     size_t              indent
 ) {
-    auto& BN  = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
+    auto& BN  = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
     auto& B   = BN.block();
 
     debugIndent(std::cerr, indent);
@@ -3454,13 +3583,13 @@ void VisRepFinder::debugPrintHandleEdgeLabels(
 
     for (auto eeit = ETN.embeddedGraph().edges().first;
         eeit != ETN.embeddedGraph().edges().second; eeit++ ) {
-        auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*eeit));
-        auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-        auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-        auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-        auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-        auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-        auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+        auto& EE  = downcast<EmbeddedEdge>(*(*eeit));
+        auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+        auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+        auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+        auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+        auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+        auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedEdge: {" << LN1.mDebugNum << ","
                                                       << LN2.mDebugNum << "} ";
@@ -3474,17 +3603,17 @@ void VisRepFinder::debugPrintHandleEdgeLabels(
 
     for (auto deit = ETN.dualGraph().edges().first;
         deit != ETN.dualGraph().edges().second; deit++ ) {
-        auto& DE  = dynamic_cast<DualEdge&>(*(*deit));
-        auto& F1 = dynamic_cast<EmbeddedFace&>(DE.incidentNode1());
-        auto& F2 = dynamic_cast<EmbeddedFace&>(DE.incidentNode2());
-
-        auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*(DE.mEmbeddedEdge)));
-        auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-        auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-        auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-        auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-        auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-        auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+        auto& DE  = downcast<DualEdge>(*(*deit));
+        auto& F1 = downcast<EmbeddedFace>(DE.incidentNode1());
+        auto& F2 = downcast<EmbeddedFace>(DE.incidentNode2());
+
+        auto& EE  = downcast<EmbeddedEdge>(*(*(DE.mEmbeddedEdge)));
+        auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+        auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+        auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+        auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+        auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+        auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "DualEdge: {" << F1.mDebugNum << "," << F2.mDebugNum << "} ";
         cerr << "EmbeddedEdge: {" << LN1.mDebugNum << "," 
@@ -3508,7 +3637,7 @@ void VisRepFinder::debugPrintHandleChildBlocks(
     EmbeddedBCTreeNode& ETN,
     size_t              indent
 ) {
-    auto& BN  = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
+    auto& BN  = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
     auto& B   = BN.block();
 
     debugIndent(std::cerr, indent);
@@ -3523,13 +3652,13 @@ void VisRepFinder::debugPrintHandleChildBlocks(
                                                                       <<  "\n";
     for (auto eeit = ETN.embeddedGraph().edges().first;
         eeit != ETN.embeddedGraph().edges().second; eeit++ ) {
-        auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*eeit));
-        auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-        auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-        auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-        auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-        auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-        auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+        auto& EE  = downcast<EmbeddedEdge>(*(*eeit));
+        auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+        auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+        auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+        auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+        auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+        auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedEdge: {" << LN1.mDebugNum << "," << LN2.mDebugNum 
                                                                        << "} ";
@@ -3547,17 +3676,17 @@ void VisRepFinder::debugPrintHandleChildBlocks(
 
     for (auto deit = ETN.dualGraph().edges().first;
         deit != ETN.dualGraph().edges().second; deit++ ) {
-        auto& DE  = dynamic_cast<DualEdge&>(*(*deit));
-        auto& F1 = dynamic_cast<EmbeddedFace&>(DE.incidentNode1());
-        auto& F2 = dynamic_cast<EmbeddedFace&>(DE.incidentNode2());
-
-        auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*(DE.mEmbeddedEdge)));
-        auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-        auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-        auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-        auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-        auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-        auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+        auto& DE  = downcast<DualEdge>(*(*deit));
+        auto& F1 = downcast<EmbeddedFace>(DE.incidentNode1());
+        auto& F2 = downcast<EmbeddedFace>(DE.incidentNode2());
+
+        auto& EE  = downcast<EmbeddedEdge>(*(*(DE.mEmbeddedEdge)));
+        auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+        auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+        auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+        auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+        auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+        auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "DualEdge: {" << F1.mDebugNum << "," << F2.mDebugNum << "} ";
         cerr << "EmbeddedEdge: {" << LN1.mDebugNum << "," << LN2.mDebugNum 
@@ -3580,7 +3709,7 @@ void VisRepFinder::debugPrintCalculateCosts(
     EmbeddedBCTreeNode& ETN,
     size_t              indent
 ) {
-    auto& BN  = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
+    auto& BN  = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
     auto& B   = BN.block();
 
     debugIndent(std::cerr, indent);
@@ -3588,9 +3717,9 @@ void VisRepFinder::debugPrintCalculateCosts(
 
     for (auto enit = ETN.embeddedGraph().nodes().first;
         enit != ETN.embeddedGraph().nodes().second; enit++ ) {
-        auto& EN = dynamic_cast<EmbeddedNode&>(*(*enit));
-        auto& BN = dynamic_cast<BlockNode&>(EN.IGBackwardLinkRef());
-        auto& LN = dynamic_cast<VRRectLabelNode&>(BN.IGBackwardLinkRef());
+        auto& EN = downcast<EmbeddedNode>(*(*enit));
+        auto& BN = downcast<BlockNode>(EN.IGBackwardLinkRef());
+        auto& LN = downcast<VRRectLabelNode>(BN.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedNode: " << LN.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mEGNodeAux[EN.utility()];
@@ -3600,13 +3729,13 @@ void VisRepFinder::debugPrintCalculateCosts(
 
     for (auto eeit = ETN.embeddedGraph().edges().first;
         eeit != ETN.embeddedGraph().edges().second; eeit++ ) {
-        auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*eeit));
-        auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-        auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-        auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-        auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-        auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-        auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+        auto& EE  = downcast<EmbeddedEdge>(*(*eeit));
+        auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+        auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+        auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+        auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+        auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+        auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedEdge: {" << LN1.mDebugNum << "," << LN2.mDebugNum 
                                                                        << "} ";
@@ -3617,7 +3746,7 @@ void VisRepFinder::debugPrintCalculateCosts(
 
     for (auto fit = ETN.dualGraph().nodes().first;
         fit != ETN.dualGraph().nodes().second; fit++ ) {
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& F = downcast<EmbeddedFace>(*(*fit));
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedFace: " << F.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mDGFaceAux[F.utility()];
@@ -3627,16 +3756,16 @@ void VisRepFinder::debugPrintCalculateCosts(
 
     for (auto deit = ETN.dualGraph().edges().first;
         deit != ETN.dualGraph().edges().second; deit++ ) {
-        auto& DE  = dynamic_cast<DualEdge&>(*(*deit));
-        auto& F1 = dynamic_cast<EmbeddedFace&>(DE.incidentNode1());
-        auto& F2 = dynamic_cast<EmbeddedFace&>(DE.incidentNode2());
-        auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*(DE.mEmbeddedEdge)));
-        auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-        auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-        auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-        auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-        auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-        auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+        auto& DE  = downcast<DualEdge>(*(*deit));
+        auto& F1 = downcast<EmbeddedFace>(DE.incidentNode1());
+        auto& F2 = downcast<EmbeddedFace>(DE.incidentNode2());
+        auto& EE  = downcast<EmbeddedEdge>(*(*(DE.mEmbeddedEdge)));
+        auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+        auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+        auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+        auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+        auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+        auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
 
         debugIndent(std::cerr, indent+4);
         cerr << "DualEdge: {" << F1.mDebugNum << "," << F2.mDebugNum << "} ";
@@ -3655,7 +3784,7 @@ void VisRepFinder::debugPrintScheduleEG(
     EmbeddedBCTreeNode& ETN,
     size_t              indent
 ) {
-    auto& BN  = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
+    auto& BN  = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
     auto& B   = BN.block();
 
     debugIndent(std::cerr, indent);
@@ -3663,9 +3792,9 @@ void VisRepFinder::debugPrintScheduleEG(
 
     for (auto enit = ETN.embeddedGraph().nodes().first;
         enit != ETN.embeddedGraph().nodes().second; enit++ ) {
-        auto& EN = dynamic_cast<EmbeddedNode&>(*(*enit));
-        auto& BN = dynamic_cast<BlockNode&>(EN.IGBackwardLinkRef());
-        auto& LN = dynamic_cast<VRRectLabelNode&>(BN.IGBackwardLinkRef());
+        auto& EN = downcast<EmbeddedNode>(*(*enit));
+        auto& BN = downcast<BlockNode>(EN.IGBackwardLinkRef());
+        auto& LN = downcast<VRRectLabelNode>(BN.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedNode: " << LN.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mEGNodeAux[EN.utility()];
@@ -3679,7 +3808,7 @@ void VisRepFinder::debugPrintScheduleDG(
     EmbeddedBCTreeNode& ETN,
     size_t              indent
 ) {
-    auto& BN  = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
+    auto& BN  = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
     auto& B   = BN.block();
 
     debugIndent(std::cerr, indent);
@@ -3687,7 +3816,7 @@ void VisRepFinder::debugPrintScheduleDG(
 
     for (auto fit = ETN.dualGraph().nodes().first;
         fit != ETN.dualGraph().nodes().second; fit++ ) {
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& F = downcast<EmbeddedFace>(*(*fit));
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedFace: " << F.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mDGFaceAux[F.utility()];
@@ -3701,7 +3830,7 @@ void VisRepFinder::debugPrintAssignCoordinates(
     EmbeddedBCTreeNode& ETN,
     size_t              indent
 ) {
-    auto& BN  = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
+    auto& BN  = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
     auto& B   = BN.block();
 
     debugIndent(std::cerr, indent);
@@ -3725,9 +3854,9 @@ void VisRepFinder::debugPrintAssignCoordinates(
 
     for (auto enit = ETN.embeddedGraph().nodes().first;
         enit != ETN.embeddedGraph().nodes().second; enit++ ) {
-        auto& EN = dynamic_cast<EmbeddedNode&>(*(*enit));
-        auto& BN = dynamic_cast<BlockNode&>(EN.IGBackwardLinkRef());
-        auto& LN = dynamic_cast<VRRectLabelNode&>(BN.IGBackwardLinkRef());
+        auto& EN = downcast<EmbeddedNode>(*(*enit));
+        auto& BN = downcast<BlockNode>(EN.IGBackwardLinkRef());
+        auto& LN = downcast<VRRectLabelNode>(BN.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedNode: " << LN.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mEGNodeAux[EN.utility()];
@@ -3737,13 +3866,13 @@ void VisRepFinder::debugPrintAssignCoordinates(
 
     for (auto eeit = ETN.embeddedGraph().edges().first;
         eeit != ETN.embeddedGraph().edges().second; eeit++ ) {
-        auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*eeit));
-        auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-        auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-        auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-        auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-        auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-        auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+        auto& EE  = downcast<EmbeddedEdge>(*(*eeit));
+        auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+        auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+        auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+        auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+        auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+        auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedEdge: {" << LN1.mDebugNum << "," << LN2.mDebugNum 
                                                                        << "} ";
@@ -3754,7 +3883,7 @@ void VisRepFinder::debugPrintAssignCoordinates(
 
     for (auto fit = ETN.dualGraph().nodes().first;
         fit != ETN.dualGraph().nodes().second; fit++ ) {
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& F = downcast<EmbeddedFace>(*(*fit));
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedFace: " << F.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mDGFaceAux[F.utility()];
@@ -3768,7 +3897,7 @@ void VisRepFinder::debugPrintTranslate(
     EmbeddedBCTreeNode& ETN,
     size_t              indent
 ) {
-    auto& BN  = dynamic_cast<BCTreeNode&>(ETN.IGBackwardLinkRef());
+    auto& BN  = downcast<BCTreeNode>(ETN.IGBackwardLinkRef());
     auto& B   = BN.block();
 
     debugIndent(std::cerr, indent);
@@ -3786,9 +3915,9 @@ void VisRepFinder::debugPrintTranslate(
 
     for (auto enit = ETN.embeddedGraph().nodes().first;
         enit != ETN.embeddedGraph().nodes().second; enit++ ) {
-        auto& EN = dynamic_cast<EmbeddedNode&>(*(*enit));
-        auto& BN = dynamic_cast<BlockNode&>(EN.IGBackwardLinkRef());
-        auto& LN = dynamic_cast<VRRectLabelNode&>(BN.IGBackwardLinkRef());
+        auto& EN = downcast<EmbeddedNode>(*(*enit));
+        auto& BN = downcast<BlockNode>(EN.IGBackwardLinkRef());
+        auto& LN = downcast<VRRectLabelNode>(BN.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedNode: " << LN.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mEGNodeAux[EN.utility()];
@@ -3798,13 +3927,13 @@ void VisRepFinder::debugPrintTranslate(
 
     for (auto eeit = ETN.embeddedGraph().edges().first;
         eeit != ETN.embeddedGraph().edges().second; eeit++ ) {
-        auto& EE  = dynamic_cast<EmbeddedEdge&>(*(*eeit));
-        auto& EN1 = dynamic_cast<EmbeddedNode&>(EE.incidentNode1());
-        auto& EN2 = dynamic_cast<EmbeddedNode&>(EE.incidentNode2());
-        auto& BN1 = dynamic_cast<BlockNode&>(EN1.IGBackwardLinkRef());
-        auto& LN1 = dynamic_cast<VRRectLabelNode&>(BN1.IGBackwardLinkRef());
-        auto& BN2 = dynamic_cast<BlockNode&>(EN2.IGBackwardLinkRef());
-        auto& LN2 = dynamic_cast<VRRectLabelNode&>(BN2.IGBackwardLinkRef());
+        auto& EE  = downcast<EmbeddedEdge>(*(*eeit));
+        auto& EN1 = downcast<EmbeddedNode>(EE.incidentNode1());
+        auto& EN2 = downcast<EmbeddedNode>(EE.incidentNode2());
+        auto& BN1 = downcast<BlockNode>(EN1.IGBackwardLinkRef());
+        auto& LN1 = downcast<VRRectLabelNode>(BN1.IGBackwardLinkRef());
+        auto& BN2 = downcast<BlockNode>(EN2.IGBackwardLinkRef());
+        auto& LN2 = downcast<VRRectLabelNode>(BN2.IGBackwardLinkRef());
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedEdge: {" << LN1.mDebugNum << "," << LN2.mDebugNum << "} ";
         auto& aux = mAux[ETN.utility()].mEGEdgeAux[EE.utility()];
@@ -3814,7 +3943,7 @@ void VisRepFinder::debugPrintTranslate(
 
     for (auto fit = ETN.dualGraph().nodes().first;
         fit != ETN.dualGraph().nodes().second; fit++ ) {
-        auto& F = dynamic_cast<EmbeddedFace&>(*(*fit));
+        auto& F = downcast<EmbeddedFace>(*(*fit));
         debugIndent(std::cerr, indent+4);
         cerr << "EmbeddedFace: " << F.mDebugNum << " ";
         auto& aux = mAux[ETN.utility()].mDGFaceAux[F.utility()];
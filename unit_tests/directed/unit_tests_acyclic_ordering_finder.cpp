@@ -20,6 +20,8 @@ class AcyclicOrderingFinderTests : public ::testing::Test {
 
     bool isFeedbackEdge(AOFEdge& e) { return e.mFeedbackEdge; }
 
+    long edgeCost(AOFEdge& e) { return e.mCost; }
+
     long findCyclicRanks(AcyclicOrderingFinder& finder, long n){
         return finder.findCyclicRanks(n);
     }
@@ -488,6 +490,165 @@ TEST_F(AcyclicOrderingFinderTests, Test6) {
 
 }
 
+/**  @brief greedy strategy on the graph of Test2.
+ */
+TEST_F(AcyclicOrderingFinderTests, Test7) {
+
+    DiGraph g01;
+ 
+    auto np01 = std::make_unique<AOFNode>();
+    auto& N01 = dynamic_cast<AOFNode&>(g01.addNode(std::move(np01)));
+    N01.mDebugId = 1;
+    auto np02 = std::make_unique<AOFNode>();
+    auto& N02 = dynamic_cast<AOFNode&>(g01.addNode(std::move(np02)));
+    N02.mDebugId = 2;
+    auto np03 = std::make_unique<AOFNode>();
+    auto& N03 = dynamic_cast<AOFNode&>(g01.addNode(std::move(np03)));
+    N03.mDebugId = 3;
+    auto np04 = std::make_unique<AOFNode>();
+    auto& N04 = dynamic_cast<AOFNode&>(g01.addNode(std::move(np04)));
+    N04.mDebugId = 4;
+    auto np05 = std::make_unique<AOFNode>();
+    auto& N05 = dynamic_cast<AOFNode&>(g01.addNode(std::move(np05)));
+    N05.mDebugId = 5;
+
+    auto ep01_02 = std::make_unique<AOFEdge>();
+    auto& E01_02 = dynamic_cast<AOFEdge&>(
+                                    g01.addEdge(std::move(ep01_02), N01, N02));
+    E01_02.setCost(10);
+    auto ep01_03 = std::make_unique<AOFEdge>();
+    auto& E01_03 = dynamic_cast<AOFEdge&>(
+                                    g01.addEdge(std::move(ep01_03), N01, N03));
+    E01_03.setCost(8);
+    auto ep04_01 = std::make_unique<AOFEdge>();
+    auto& E04_01 = dynamic_cast<AOFEdge&>(
+                                    g01.addEdge(std::move(ep04_01), N04, N01));
+    E04_01.setCost(1);
+    auto ep02_03 = std::make_unique<AOFEdge>();
+    auto& E02_03 = dynamic_cast<AOFEdge&>(
+                                    g01.addEdge(std::move(ep02_03), N02, N03));
+    E02_03.setCost(2);
+    auto ep03_04 = std::make_unique<AOFEdge>();
+    auto& E03_04 = dynamic_cast<AOFEdge&>(
+                                    g01.addEdge(std::move(ep03_04), N03, N04));
+    E03_04.setCost(1);
+    auto ep03_05 = std::make_unique<AOFEdge>();
+    auto& E03_05 = dynamic_cast<AOFEdge&>(
+                                    g01.addEdge(std::move(ep03_05), N03, N05));
+    E03_05.setCost(4);
+    auto ep04_05 = std::make_unique<AOFEdge>();
+    auto& E04_05 = dynamic_cast<AOFEdge&>(
+                                    g01.addEdge(std::move(ep04_05), N04, N05));
+    E04_05.setCost(12);
+    auto ep05_02 = std::make_unique<AOFEdge>();
+    auto& E05_02 = dynamic_cast<AOFEdge&>(
+                                    g01.addEdge(std::move(ep05_02), N05, N02));
+    E05_02.setCost(7);
+
+    AcyclicOrderingFinder finder(g01);
+
+    vector<node_list_it_t> vec_01 = finder.find();
+    EXPECT_EQ(finder.feedbackCost(vec_01), 5);
+
+    finder.setStrategy(AcyclicOrderingFinder::GREEDY);
+    vector<node_list_it_t> vec_02 = finder.find();
+    EXPECT_EQ(vec_02.size(), 5);
+    auto vit = vec_02.begin();
+    EXPECT_EQ(*vit, N01.backIt());
+    vit++;
+    EXPECT_EQ(*vit, N04.backIt());
+    vit++;
+    EXPECT_EQ(*vit, N05.backIt());
+    vit++;
+    EXPECT_EQ(*vit, N02.backIt());
+    vit++;
+    EXPECT_EQ(*vit, N03.backIt());
+
+    EXPECT_EQ(N01.rank(), 0);
+    EXPECT_EQ(N04.rank(), 1);
+    EXPECT_EQ(N05.rank(), 2);
+    EXPECT_EQ(N02.rank(), 3);
+    EXPECT_EQ(N03.rank(), 4);
+
+    EXPECT_EQ(finder.feedbackCost(vec_02), 6);
+
+    EXPECT_EQ(isFeedbackEdge(E01_02), false);
+    EXPECT_EQ(isFeedbackEdge(E01_03), false);
+    EXPECT_EQ(isFeedbackEdge(E04_01), true);
+    EXPECT_EQ(isFeedbackEdge(E02_03), false);
+    EXPECT_EQ(isFeedbackEdge(E03_04), true);
+    EXPECT_EQ(isFeedbackEdge(E03_05), true);
+    EXPECT_EQ(isFeedbackEdge(E04_05), false);
+    EXPECT_EQ(isFeedbackEdge(E05_02), false);
+}
+
+
+/**  @brief greedy strategy on random digraphs.
+ *          It gives a topological ordering for acyclic ones.
+ */
+TEST_F(AcyclicOrderingFinderTests, Test8) {
+
+    unsigned long seed = 24680;
+    auto nextRandom = [&seed]() {
+        seed = (seed * 1103515245 + 12345) % 2147483648UL;
+        return seed;
+    };
+
+    for (long trial = 0; trial < 20; trial++) {
+
+        bool acyclic  = (trial % 2 == 0);
+        long numNodes = 1 + nextRandom() % 60;
+        long numEdges = nextRandom() % (numNodes * 3);
+
+        DiGraph g01;
+        vector<node_list_it_t> nodes;
+        for (long i = 0; i < numNodes; i++) {
+            auto& N = dynamic_cast<AOFNode&>(
+                              g01.addNode(std::make_unique<AOFNode>()));
+            N.mDebugId = i;
+            nodes.push_back(N.backIt());
+        }
+        for (long i = 0; i < numEdges; i++) {
+            long src = nextRandom() % numNodes;
+            long dst = nextRandom() % numNodes;
+            if (acyclic) {
+                if (src == dst) {
+                    continue;
+                }
+                if (src > dst) {
+                    std::swap(src, dst);
+                }
+            }
+            auto& E = dynamic_cast<AOFEdge&>(g01.addEdge(
+                std::make_unique<AOFEdge>(), *(*nodes[src]), *(*nodes[dst])));
+            E.setCost(1 + nextRandom() % 10);
+        }
+
+        AcyclicOrderingFinder finder(g01);
+        finder.setStrategy(AcyclicOrderingFinder::GREEDY);
+        vector<node_list_it_t> vec_01 = finder.find();
+
+        EXPECT_EQ(vec_01.size(), numNodes);
+        for (long i = 0; i < long(vec_01.size()); i++) {
+            auto& N = dynamic_cast<AOFNode&>(*(*vec_01[i]));
+            EXPECT_EQ(N.rank(), i);
+        }
+
+        long cost = 0;
+        for (auto eit = g01.edges().first; eit != g01.edges().second; eit++){
+            auto& E = dynamic_cast<AOFEdge&>(*(*eit));
+            if (isFeedbackEdge(E)) {
+                cost += edgeCost(E);
+            }
+        }
+        EXPECT_EQ(finder.feedbackCost(vec_01), cost);
+        if (acyclic) {
+            EXPECT_EQ(cost, 0);
+        }
+    }
+}
+
+
 } // namespace Directed
 
 } // namespace Wailea
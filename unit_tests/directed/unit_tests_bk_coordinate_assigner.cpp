@@ -0,0 +1,246 @@
+#include "gtest/gtest.h"
+#include "directed/bk_coordinate_assigner.hpp"
+
+#include <random>
+
+namespace Wailea {
+
+namespace Directed {
+
+class BKCoordinateAssignerTests : public ::testing::Test {
+
+  protected:
+
+    BKCoordinateAssignerTests(){;};
+    virtual ~BKCoordinateAssignerTests(){;};
+    virtual void SetUp() {;};
+    virtual void TearDown() {;};
+
+    /** @brief builds a SugiyamaDiGraph from the given edges over the nodes
+     *         whose ranks are given by nodeRanks, and returns the ranks
+     *         including the virtual nodes.
+     */
+    vector<vector<node_list_it_t> > makeRanks(
+        DiGraph&                    g,
+        SugiyamaDiGraph&            sg,
+        vector<long>&               nodeRanks,
+        vector<pair<long,long> >&   edges,
+        vector<double>&             widths
+    ) {
+        vector<node_list_it_t> nodes;
+        for (size_t i = 0; i < nodeRanks.size(); i++) {
+            auto  np = std::make_unique<NumDiNode>(i);
+            auto& N  = dynamic_cast<NumDiNode&>(g.addNode(std::move(np)));
+            nodes.push_back(N.backIt());
+        }
+        for (auto& e : edges) {
+            auto ep = std::make_unique<DiEdge>();
+            g.addEdge(std::move(ep), *(*nodes[e.first]), *(*nodes[e.second]));
+        }
+
+        long maxRank = 0;
+        for (auto r : nodeRanks) {
+            maxRank = std::max(maxRank, r);
+        }
+        vector<node_list_it_t> ordering;
+        for (long r = 0; r <= maxRank; r++) {
+            for (size_t i = 0; i < nodeRanks.size(); i++) {
+                if (nodeRanks[i] == r) {
+                    ordering.push_back(nodes[i]);
+                }
+            }
+        }
+        sg.generateFromAcyclicOrdering(ordering);
+
+        vector<vector<node_list_it_t> > ranksIn(maxRank + 1);
+        for (size_t i = 0; i < nodeRanks.size(); i++) {
+            auto& N  = dynamic_cast<NumDiNode&>(*(*nodes[i]));
+            auto& Ns = dynamic_cast<SugiyamaDiNode&>(N.IGForwardLinkRef());
+            Ns.setWidth(widths[i]);
+            ranksIn[nodeRanks[i]].push_back(Ns.backIt());
+        }
+        return sg.rankNodesAndAddVirtualNodes(ranksIn);
+    }
+
+    /** @brief checks the separation and the normalization.
+     */
+    void checkLayout(vector<vector<node_list_it_t> >& ranks, double sep) {
+
+        bool   first   = true;
+        double minLeft = 0.0;
+        for (auto& rank : ranks) {
+            for (size_t i = 0; i < rank.size(); i++) {
+                auto& N = dynamic_cast<SugiyamaDiNode&>(*(*rank[i]));
+                double left = N.x() - N.width() / 2.0;
+                if (first || left < minLeft) {
+                    minLeft = left;
+                    first   = false;
+                }
+                if (i > 0) {
+                    auto& P = dynamic_cast<SugiyamaDiNode&>(*(*rank[i-1]));
+                    double gap = N.x() - P.x()
+                               - (N.width() + P.width()) / 2.0;
+                    EXPECT_GE(gap, sep - 1.0e-9);
+                }
+            }
+        }
+        if (!first) {
+            EXPECT_NEAR(minLeft, 0.0, 1.0e-9);
+        }
+    }
+
+    double xOf(node_list_it_t it) {
+        return dynamic_cast<SugiyamaDiNode&>(*(*it)).x();
+    }
+
+    bool isVirtual(node_list_it_t it) {
+        return dynamic_cast<SugiyamaDiNode&>(*(*it)).isVirtual();
+    }
+
+};
+
+
+/**  @brief empty ranks
+ */
+TEST_F(BKCoordinateAssignerTests, Test1) {
+
+    DiGraph         g01;
+    SugiyamaDiGraph g02(g01);
+
+    vector<vector<node_list_it_t> > ranks;
+    BKCoordinateAssigner assigner(g02);
+    assigner.assign(ranks);
+
+    EXPECT_EQ(g02.numNodes(), 0);
+
+}
+
+
+/**  @brief a chain is drawn vertically
+ */
+TEST_F(BKCoordinateAssignerTests, Test2) {
+
+    DiGraph         g01;
+    SugiyamaDiGraph g02(g01);
+
+    vector<long>             nodeRanks{0, 1, 2, 3};
+    vector<pair<long,long> > edges{{0,1},{1,2},{2,3}};
+    vector<double>           widths{2.0, 1.0, 3.0, 1.0};
+
+    auto ranks = makeRanks(g01, g02, nodeRanks, edges, widths);
+
+    BKCoordinateAssigner assigner(g02);
+    assigner.assign(ranks);
+
+    EXPECT_EQ(ranks.size(), 4);
+    for (auto& rank : ranks) {
+        EXPECT_EQ(rank.size(), 1);
+        EXPECT_DOUBLE_EQ(xOf(rank[0]), 1.5);
+    }
+    checkLayout(ranks, BKCoordinateAssigner::kDefaultNodeSeparation);
+
+}
+
+
+/**  @brief a long edge is drawn straight, and a node with two children
+ *          is placed between them.
+ *
+ *      rank 0:  0       1
+ *               |\     /
+ *      rank 1:  2 v   3
+ *               | |   |
+ *      rank 2:  4 v   5
+ *               |/
+ *      rank 3:  6
+ */
+TEST_F(BKCoordinateAssignerTests, Test3) {
+
+    DiGraph         g01;
+    SugiyamaDiGraph g02(g01);
+
+    vector<long>             nodeRanks{0, 0, 1, 1, 2, 2, 3};
+    vector<pair<long,long> > edges{{0,2},{0,6},{1,3},{2,4},{3,5},{4,6}};
+    vector<double>           widths{1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+
+    auto ranks = makeRanks(g01, g02, nodeRanks, edges, widths);
+    EXPECT_EQ(ranks.size(), 4);
+    EXPECT_EQ(ranks[1].size(), 3);
+    EXPECT_EQ(ranks[2].size(), 3);
+
+    // Put the virtual nodes in the middle.
+    for (size_t r = 1; r <= 2; r++) {
+        for (size_t i = 0; i < ranks[r].size(); i++) {
+            if (isVirtual(ranks[r][i]) && i != 1) {
+                std::swap(ranks[r][i], ranks[r][1]);
+            }
+        }
+        EXPECT_TRUE(isVirtual(ranks[r][1]));
+    }
+
+    BKCoordinateAssigner assigner(g02);
+    assigner.setNodeSeparation(0.5);
+    assigner.assign(ranks);
+
+    checkLayout(ranks, 0.5);
+    EXPECT_DOUBLE_EQ(xOf(ranks[1][1]), xOf(ranks[2][1]));
+    EXPECT_DOUBLE_EQ(xOf(ranks[1][0]), xOf(ranks[2][0]));
+    EXPECT_DOUBLE_EQ(xOf(ranks[1][2]), xOf(ranks[2][2]));
+
+}
+
+
+/**  @brief random layered graphs with and without the refinement.
+ */
+TEST_F(BKCoordinateAssignerTests, Test4) {
+
+    std::mt19937 gen(1);
+    for (size_t trial = 0; trial < 50; trial++) {
+
+        size_t numNodes = 5 + gen() % 40;
+        size_t numRanks = 2 + gen() % 6;
+
+        vector<long>   nodeRanks;
+        vector<double> widths;
+        for (size_t i = 0; i < numNodes; i++) {
+            nodeRanks.push_back(gen() % numRanks);
+            widths.push_back(0.5 + (gen() % 5) * 0.5);
+        }
+        vector<pair<long,long> > edges;
+        size_t numEdges = numNodes + gen() % (numNodes * 2);
+        for (size_t i = 0; i < numEdges; i++) {
+            long u = gen() % numNodes;
+            long v = gen() % numNodes;
+            if (nodeRanks[u] < nodeRanks[v]) {
+                edges.push_back(make_pair(u, v));
+            }
+            else if (nodeRanks[v] < nodeRanks[u]) {
+                edges.push_back(make_pair(v, u));
+            }
+        }
+
+        for (size_t refine = 0; refine < 2; refine++) {
+
+            DiGraph         g01;
+            SugiyamaDiGraph g02(g01);
+            auto ranks = makeRanks(g01, g02, nodeRanks, edges, widths);
+
+            for (auto& rank : ranks) {
+                std::shuffle(rank.begin(), rank.end(), gen);
+            }
+
+            BKCoordinateAssigner assigner(g02);
+            assigner.setNodeSeparation(1.0);
+            if (refine == 1) {
+                assigner.setRefinement(BKCoordinateAssigner::PRIORITY_METHOD);
+            }
+            assigner.assign(ranks);
+            checkLayout(ranks, 1.0);
+        }
+    }
+
+}
+
+
+} // namespace Directed
+
+} // namespace Wailea
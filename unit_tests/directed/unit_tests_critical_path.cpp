@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 #include "directed/critical_path.hpp"
 
+#include <random>
+
 namespace Wailea {
 
 namespace Directed { 
@@ -21,6 +23,50 @@ class CriticalPathTests : public ::testing::Test {
         return std::make_unique<CPDiEdge>(length);
     }
 
+    /** @brief generates a random DAG. The edges go from a node to a later
+     *         node in nodes. Some edge lengths are negative.
+     */
+    void generateRandomDAG(
+        DiGraph&           g,
+        vector<CPDiNode*>& nodes,
+        vector<CPDiEdge*>& edges,
+        size_t             numNodes,
+        size_t             numEdges,
+        std::mt19937&      gen
+    ) {
+        std::uniform_int_distribution<long>   nodeLength(0, 9);
+        std::uniform_int_distribution<long>   edgeLength(-2, 5);
+        std::uniform_int_distribution<size_t> pick(0, numNodes - 1);
+        for (size_t i = 0; i < numNodes; i++) {
+            auto& N = dynamic_cast<CPDiNode&>(
+                           g.addNode(generate_node(nodeLength(gen))));
+            nodes.push_back(&N);
+        }
+        for (size_t i = 0; i < numEdges; i++) {
+            size_t n1 = pick(gen);
+            size_t n2 = pick(gen);
+            if (n1 == n2) {
+                continue;
+            }
+            if (n1 > n2) {
+                std::swap(n1, n2);
+            }
+            auto& E = dynamic_cast<CPDiEdge&>(g.addEdge(
+                    generate_edge(edgeLength(gen)), *nodes[n1], *nodes[n2]));
+            edges.push_back(&E);
+        }
+    }
+
+    /** @brief returns earliest and latest start times of the nodes.
+     */
+    vector<pair<long, long>> times(vector<CPDiNode*>& nodes) {
+        vector<pair<long, long>> t;
+        for (auto* N : nodes) {
+            t.push_back(make_pair(N->earliestStart(), N->latestStart()));
+        }
+        return t;
+    }
+
     CriticalPathTests(){;};
     virtual ~CriticalPathTests(){;};
     virtual void SetUp() {;};
@@ -999,6 +1045,125 @@ TEST_F(CriticalPathTests, Test3) {
 
 }
 
+
+/**  @brief parallel mode gives the same result as sequential mode.
+ */
+TEST_F(CriticalPathTests, Test4) {
+
+    std::mt19937 gen(4);
+    for (size_t round = 0; round < 20; round++) {
+
+        DiGraph           g1;
+        vector<CPDiNode*> nodes;
+        vector<CPDiEdge*> edges;
+        generateRandomDAG(g1, nodes, edges, 200, 600, gen);
+
+        CriticalPath cp1;
+        cp1.findCriticalPaths(g1);
+        auto expected = times(nodes);
+
+        for (size_t numThreads : { 0, 1, 2, 3, 8 }) {
+            CriticalPath cp2;
+            cp2.setExecutionMode(CriticalPath::PARALLEL, numThreads);
+            cp2.findCriticalPaths(g1);
+            EXPECT_EQ(times(nodes), expected);
+        }
+    }
+}
+
+
+/**  @brief incremental updates give the same result as the full
+ *          computation.
+ */
+TEST_F(CriticalPathTests, Test5) {
+
+    std::mt19937 gen(5);
+    for (size_t round = 0; round < 20; round++) {
+
+        DiGraph           g1;
+        vector<CPDiNode*> nodes;
+        vector<CPDiEdge*> edges;
+        generateRandomDAG(g1, nodes, edges, 100, 250, gen);
+        ASSERT_GT(edges.size(), 0);
+
+        CriticalPath cp1;
+        cp1.findCriticalPaths(g1);
+
+        std::uniform_int_distribution<size_t> pickNode(0, nodes.size() - 1);
+        std::uniform_int_distribution<size_t> pickEdge(0, edges.size() - 1);
+        std::uniform_int_distribution<long>   length(-3, 20);
+        std::uniform_int_distribution<size_t> numChanges(1, 4);
+
+        for (size_t step = 0; step < 30; step++) {
+            size_t num = numChanges(gen);
+            for (size_t i = 0; i < num; i++) {
+                if (gen() % 2 == 0) {
+                    cp1.setNodeLength(*nodes[pickNode(gen)], length(gen));
+                }
+                else {
+                    cp1.setEdgeLength(*edges[pickEdge(gen)], length(gen));
+                }
+            }
+            cp1.updateCriticalPaths();
+            auto incremental = times(nodes);
+
+            CriticalPath cp2;
+            cp2.findCriticalPaths(g1);
+            EXPECT_EQ(incremental, times(nodes));
+        }
+    }
+}
+
+
+/**  @brief the lengths can be changed only for the digraph given to
+ *          findCriticalPaths().
+ */
+TEST_F(CriticalPathTests, Test6) {
+
+    DiGraph g1;
+    auto&   n1 = dynamic_cast<CPDiNode&>(g1.addNode(generate_node(3)));
+    auto&   n2 = dynamic_cast<CPDiNode&>(g1.addNode(generate_node(4)));
+    auto&   n3 = dynamic_cast<CPDiNode&>(g1.addNode(generate_node(5)));
+    auto&   e1 = dynamic_cast<CPDiEdge&>(
+                               g1.addEdge(generate_edge(0), n1, n2));
+    auto&   e2 = dynamic_cast<CPDiEdge&>(
+                               g1.addEdge(generate_edge(1), n1, n3));
+
+    DiGraph g2;
+    auto&   n4 = dynamic_cast<CPDiNode&>(g2.addNode(generate_node(3)));
+
+    CriticalPath cp;
+    EXPECT_THROW(cp.setNodeLength(n1, 1), std::invalid_argument);
+
+    cp.findCriticalPaths(g1);
+    EXPECT_EQ(n2.earliestStart(), 3);
+    EXPECT_EQ(n2.latestStart(),   3);
+    EXPECT_EQ(n3.earliestStart(), 4);
+    EXPECT_EQ(n3.latestStart(),   4);
+
+    EXPECT_THROW(cp.setNodeLength(n4, 1), std::invalid_argument);
+
+    cp.setNodeLength(n1, 10);
+    cp.setEdgeLength(e1, 2);
+    EXPECT_EQ(n1.length(), 10);
+    EXPECT_EQ(e1.length(), 2);
+    EXPECT_EQ(n2.earliestStart(), 3);
+
+    cp.updateCriticalPaths();
+    EXPECT_EQ(n1.earliestStart(), 0);
+    EXPECT_EQ(n1.latestStart(),   0);
+    EXPECT_EQ(n2.earliestStart(), 12);
+    EXPECT_EQ(n2.latestStart(),   12);
+    EXPECT_EQ(n3.earliestStart(), 11);
+    EXPECT_EQ(n3.latestStart(),   11);
+
+    cp.setEdgeLength(e2, 5);
+    cp.updateCriticalPaths();
+    EXPECT_EQ(n3.earliestStart(), 15);
+    EXPECT_EQ(n3.latestStart(),   15);
+    EXPECT_EQ(n2.earliestStart(), 12);
+}
+
 } // namespace Directed
 
 } // namespace Wailea
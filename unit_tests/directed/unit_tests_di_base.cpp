@@ -94,8 +94,8 @@ class DiGraphTests : public ::testing::Test {
     generation_t mGeneration(DiEdge& e){ return e.mGeneration;};
     void setGeneration(DiEdge&e, generation_t v){e.mGeneration=v;};
 
-    list<node_ptr_t>& mNodes(DiGraph&g){ return g.mNodes;};
-    list<edge_ptr_t>& mEdges(DiGraph&g){ return g.mEdges; }
+    node_list_t& mNodes(DiGraph&g){ return g.mNodes;};
+    edge_list_t& mEdges(DiGraph&g){ return g.mEdges; }
     generation_t mGeneration(DiGraph& g){ return g.mGeneration; };
     void setGeneration(DiGraph& g, generation_t v){ g.mGeneration=v;};
  
@@ -183,8 +183,8 @@ TEST_F(DiGraphTests, DefaultConstructor) {
      */
     DiGraph G;
     EXPECT_EQ(mGeneration(G),0) << "mGeneration is incorrect";
-    list<node_ptr_t>& graph_mNodes = mNodes(G);
-    list<edge_ptr_t>& graph_mEdges = mEdges(G);
+    node_list_t& graph_mNodes = mNodes(G);
+    edge_list_t& graph_mEdges = mEdges(G);
     EXPECT_EQ(graph_mNodes.size(),0) << "mNodes is incorrect.";    
     EXPECT_EQ(graph_mEdges.size(),0) << "mEdges is incorrect.";    
 
@@ -225,8 +225,8 @@ TEST_F(DiGraphTests, AddNodeToEmptyGraph) {
     auto& n1 = dynamic_cast<DiNode&>(G.addNode(std::move(np)));
 
     EXPECT_EQ(mGeneration(G),0) << "mGeneration is incorrect";
-    list<node_ptr_t>& graph_mNodes = mNodes(G);
-    list<edge_ptr_t>& graph_mEdges = mEdges(G);
+    node_list_t& graph_mNodes = mNodes(G);
+    edge_list_t& graph_mEdges = mEdges(G);
     EXPECT_EQ(graph_mNodes.size(),1) << "mNodes is incorrect.";    
     EXPECT_EQ(graph_mEdges.size(),0) << "mEdges is incorrect.";    
     Node& n2 = *(*(graph_mNodes.begin()));
@@ -288,8 +288,8 @@ TEST_F(DiGraphTests, RemoveNodeFromGraph) {
     std::unique_ptr<Node> np2 = G.removeNode(n1);
 
     EXPECT_EQ(mGeneration(G),0)     << "mGeneration is incorrect";
-    list<node_ptr_t>& g1_mNodes = mNodes(G);
-    list<edge_ptr_t>& g1_mEdges = mEdges(G);
+    node_list_t& g1_mNodes = mNodes(G);
+    edge_list_t& g1_mEdges = mEdges(G);
     EXPECT_EQ(g1_mNodes.size(),0)    << "mNodes is incorrect.";
     EXPECT_EQ(g1_mEdges.size(),0)    << "mEdges is incorrect.";
 
@@ -355,8 +355,8 @@ TEST_F(DiGraphTests, AddEdgeToGraph) {
     auto& e2 = dynamic_cast<DiEdge&>(G.addEdge(std::move(ep1),n1, n2));
 
     EXPECT_EQ(mGeneration(G),0) << "mGeneration is incorrect";
-    list<node_ptr_t>& g1_mNodes = mNodes(G);
-    list<edge_ptr_t>& g1_mEdges = mEdges(G);
+    node_list_t& g1_mNodes = mNodes(G);
+    edge_list_t& g1_mEdges = mEdges(G);
     EXPECT_EQ(g1_mNodes.size(),2) << "mNodes is incorrect.";    
     EXPECT_EQ(g1_mEdges.size(),1) << "mEdges is incorrect.";    
 
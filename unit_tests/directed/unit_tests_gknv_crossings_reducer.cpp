@@ -50,23 +50,107 @@ class GKNVcrossingsReducerTests : public ::testing::Test {
         r.initialOrderByDFS(ranks);
     }
 
+    void setMinNodesPerTransposeThread(GKNVcrossingsReducer& r, size_t n) {
+        r.mMinNodesPerTransposeThread = n;
+    }
+
     long calculateNumberOfCrossings(
         GKNVcrossingsReducer&   r,
         vector<node_list_it_t>& leftNodes,
         vector<node_list_it_t>& rightNodes
     ) {
-        return r.calculateNumberOfCrossings(leftNodes,rightNodes);
+        vector<long> positionOf(r.mG.numNodes());
+        r.pushNodeIndices();
+        auto numCrossings =
+                r.calculateNumberOfCrossings(leftNodes, rightNodes, positionOf);
+        r.popNodeIndices();
+        return numCrossings;
     } 
 
 
+    void tryTransposeLeft(
+        GKNVcrossingsReducer&   r,
+        vector<node_list_it_t>& leftRank,
+        vector<node_list_it_t>& rightRank
+    ) {
+        vector<long> positionOf(r.mG.numNodes());
+        r.pushNodeIndices();
+        r.tryTransposeLeft(leftRank, rightRank, positionOf);
+        r.popNodeIndices();
+    }
+
+    void tryTransposeMid(
+        GKNVcrossingsReducer&   r,
+        vector<node_list_it_t>& leftRank,
+        vector<node_list_it_t>& midRank,
+        vector<node_list_it_t>& rightRank
+    ) {
+        vector<long> positionOf(r.mG.numNodes());
+        r.pushNodeIndices();
+        r.tryTransposeMid(leftRank, midRank, rightRank, positionOf);
+        r.popNodeIndices();
+    }
+
+    void tryTransposeRight(
+        GKNVcrossingsReducer&   r,
+        vector<node_list_it_t>& leftRank,
+        vector<node_list_it_t>& rightRank
+    ) {
+        vector<long> positionOf(r.mG.numNodes());
+        r.pushNodeIndices();
+        r.tryTransposeRight(leftRank, rightRank, positionOf);
+        r.popNodeIndices();
+    }
+
+    long countCrossingsByPairs(
+        vector<node_list_it_t>& leftNodes,
+        vector<node_list_it_t>& rightNodes
+    ) {
+        long numCrossings = 0;
+        for (size_t i = 0; i < leftNodes.size(); i++) {
+            for (size_t j = i + 1; j < leftNodes.size(); j++) {
+                auto& Ni = dynamic_cast<DiNode&>(*(*leftNodes[i]));
+                auto& Nj = dynamic_cast<DiNode&>(*(*leftNodes[j]));
+                for (auto sit = Ni.incidentEdgesOut().first;
+                                  sit != Ni.incidentEdgesOut().second; sit++) {
+                    auto& Ns = dynamic_cast<DiEdge&>(*(*(*sit)))
+                                                          .incidentNodeDst();
+                    for (auto tit = Nj.incidentEdgesOut().first;
+                                  tit != Nj.incidentEdgesOut().second; tit++) {
+                        auto& Nt = dynamic_cast<DiEdge&>(*(*(*tit)))
+                                                          .incidentNodeDst();
+                        long s = position(rightNodes, Ns.backIt());
+                        long t = position(rightNodes, Nt.backIt());
+                        if (s > t) {
+                            numCrossings++;
+                        }
+                    }
+                }
+            }
+        }
+        return numCrossings;
+    }
+
+    long position(vector<node_list_it_t>& nodes, node_list_it_t nit) {
+        for (size_t i = 0; i < nodes.size(); i++) {
+            if (nodes[i] == nit) {
+                return long(i);
+            }
+        }
+        return -1;
+    }
+
     void reorderRightSideByMedianHeuristic(
         GKNVcrossingsReducer&   r,
         vector<node_list_it_t>& leftNodes,
         vector<node_list_it_t>& rightNodes,
         vector<node_list_it_t>& newRightNodes
     ) {
+        vector<long> positionOf(r.mG.numNodes());
+        r.pushNodeIndices();
         r.reorderRightSideByMedianHeuristic(
-                                          leftNodes,rightNodes,newRightNodes);
+                              leftNodes, rightNodes, newRightNodes, positionOf);
+        r.popNodeIndices();
     }
 
     void reorderLeftSideByMedianHeuristic(
@@ -75,8 +159,11 @@ class GKNVcrossingsReducerTests : public ::testing::Test {
         vector<node_list_it_t>& rightNodes,
         vector<node_list_it_t>& newLeftNodes
     ) {
+        vector<long> positionOf(r.mG.numNodes());
+        r.pushNodeIndices();
         r.reorderLeftSideByMedianHeuristic(
-                                          leftNodes,rightNodes,newLeftNodes);
+                               leftNodes, rightNodes, newLeftNodes, positionOf);
+        r.popNodeIndices();
     }
 
 
@@ -1470,6 +1557,220 @@ TEST_F(GKNVcrossingsReducerTests, Test23) {
     
 }
 
+/**  @brief test calculateNumberOfCrossings() with the accumulator tree
+ *          against counting all the pairs of edges on random bilayer graphs.
+ */
+TEST_F(GKNVcrossingsReducerTests, Test24) {
+
+    unsigned long seed = 12345;
+    auto nextRandom = [&seed]() {
+        seed = (seed * 1103515245 + 12345) % 2147483648UL;
+        return seed;
+    };
+
+    for (long trial = 0; trial < 20; trial++) {
+
+        DiGraph g01;
+        long numLeft  = 1 + nextRandom() % 12;
+        long numRight = 1 + nextRandom() % 12;
+
+        vector<node_list_it_t> leftNodes;
+        vector<node_list_it_t> rightNodes;
+        for (long i = 0; i < numLeft; i++) {
+            leftNodes.push_back(
+                          g01.addNode(std::make_unique<NumDiNode>(i)).backIt());
+        }
+        for (long i = 0; i < numRight; i++) {
+            rightNodes.push_back(
+                   g01.addNode(std::make_unique<NumDiNode>(100+i)).backIt());
+        }
+        for (auto lit : leftNodes) {
+            for (auto rit : rightNodes) {
+                if (nextRandom() % 3 == 0) {
+                    g01.addEdge(std::make_unique<DiEdge>(), *(*lit), *(*rit));
+                }
+            }
+        }
+
+        GKNVcrossingsReducer  reducer(g01);
+        EXPECT_EQ(calculateNumberOfCrossings(reducer, leftNodes, rightNodes),
+                  countCrossingsByPairs(leftNodes, rightNodes));
+
+        // Transposition never increases the crossings.
+        auto numBefore = countCrossingsByPairs(leftNodes, rightNodes);
+        tryTransposeLeft(reducer, leftNodes, rightNodes);
+        auto numAfterLeft = countCrossingsByPairs(leftNodes, rightNodes);
+        EXPECT_LE(numAfterLeft, numBefore);
+        tryTransposeRight(reducer, leftNodes, rightNodes);
+        auto numAfterRight = countCrossingsByPairs(leftNodes, rightNodes);
+        EXPECT_LE(numAfterRight, numAfterLeft);
+        EXPECT_EQ(calculateNumberOfCrossings(reducer, leftNodes, rightNodes),
+                  numAfterRight);
+    }
+}
+
+
+/**  @brief test tryTransposeLeft(), tryTransposeMid(), and 
+ *          tryTransposeRight() on a graph with one crossing on each side.
+ *
+ *     N01  N03  N05
+ *        \/   \/
+ *        /\   /\
+ *     N02  N04  N06
+ */
+TEST_F(GKNVcrossingsReducerTests, Test25) {
+
+    DiGraph g01;
+
+    auto& N01 = g01.addNode(std::make_unique<NumDiNode>(1));
+    auto& N02 = g01.addNode(std::make_unique<NumDiNode>(2));
+    auto& N03 = g01.addNode(std::make_unique<NumDiNode>(3));
+    auto& N04 = g01.addNode(std::make_unique<NumDiNode>(4));
+    auto& N05 = g01.addNode(std::make_unique<NumDiNode>(5));
+    auto& N06 = g01.addNode(std::make_unique<NumDiNode>(6));
+
+    g01.addEdge(std::make_unique<DiEdge>(), N01, N04);
+    g01.addEdge(std::make_unique<DiEdge>(), N02, N03);
+    g01.addEdge(std::make_unique<DiEdge>(), N03, N06);
+    g01.addEdge(std::make_unique<DiEdge>(), N04, N05);
+
+    GKNVcrossingsReducer  reducer(g01);
+
+    vector<node_list_it_t> rank_00;
+    rank_00.push_back(N01.backIt());
+    rank_00.push_back(N02.backIt());
+    vector<node_list_it_t> rank_01;
+    rank_01.push_back(N03.backIt());
+    rank_01.push_back(N04.backIt());
+    vector<node_list_it_t> rank_02;
+    rank_02.push_back(N05.backIt());
+    rank_02.push_back(N06.backIt());
+
+    EXPECT_EQ(calculateNumberOfCrossings(reducer, rank_00, rank_01), 1);
+    EXPECT_EQ(calculateNumberOfCrossings(reducer, rank_01, rank_02), 1);
+
+    // Swapping N03 and N04 removes both crossings.
+    tryTransposeMid(reducer, rank_00, rank_01, rank_02);
+    EXPECT_EQ(rank_01[0], N04.backIt());
+    EXPECT_EQ(rank_01[1], N03.backIt());
+    EXPECT_EQ(calculateNumberOfCrossings(reducer, rank_00, rank_01), 0);
+    EXPECT_EQ(calculateNumberOfCrossings(reducer, rank_01, rank_02), 0);
+
+    // No improvement. The order does not change.
+    tryTransposeLeft(reducer, rank_00, rank_01);
+    EXPECT_EQ(rank_00[0], N01.backIt());
+    EXPECT_EQ(rank_00[1], N02.backIt());
+    tryTransposeRight(reducer, rank_01, rank_02);
+    EXPECT_EQ(rank_02[0], N05.backIt());
+    EXPECT_EQ(rank_02[1], N06.backIt());
+
+    // Swapping N05 and N06 creates a crossing. It is removed again.
+    std::swap(rank_02[0], rank_02[1]);
+    EXPECT_EQ(calculateNumberOfCrossings(reducer, rank_01, rank_02), 1);
+    tryTransposeRight(reducer, rank_01, rank_02);
+    EXPECT_EQ(rank_02[0], N05.backIt());
+    EXPECT_EQ(calculateNumberOfCrossings(reducer, rank_01, rank_02), 0);
+}
+
+
+/**  @brief test reduce() in PARALLEL mode on random layered graphs.
+ *          The result does not depend on the number of threads, and the
+ *          returned number of crossings is that of the resultant order.
+ *          The graph is below the size threshold of the threads for the
+ *          transposition, and the threshold is lowered to run them.
+ */
+TEST_F(GKNVcrossingsReducerTests, Test26) {
+
+    const long numRanks     = 12;
+    const long numNodesRank = 15;
+
+    // Runs reduce() on the same graph generated from scratch.
+    auto runReduce = [&](
+        enum GKNVcrossingsReducer::executionMode mode,
+        size_t                                   numRestarts,
+        size_t                                   numThreads,
+        size_t                                   minNodesPerThread,
+        vector<vector<long> >&                   nums
+    ) {
+        unsigned long seed = 54321;
+        auto nextRandom = [&seed]() {
+            seed = (seed * 1103515245 + 12345) % 2147483648UL;
+            return seed;
+        };
+
+        DiGraph g01;
+        vector<vector<node_list_it_t> > ranks(numRanks);
+        for (long i = 0; i < numRanks; i++) {
+            for (long j = 0; j < numNodesRank; j++) {
+                ranks[i].push_back(g01.addNode(
+                  std::make_unique<NumDiNode>(i * numNodesRank + j)).backIt());
+            }
+        }
+        for (long i = 0; i < numRanks - 1; i++) {
+            for (auto lit : ranks[i]) {
+                for (auto rit : ranks[i+1]) {
+                    if (nextRandom() % 6 == 0) {
+                        g01.addEdge(
+                             std::make_unique<DiEdge>(), *(*lit), *(*rit));
+                    }
+                }
+            }
+        }
+
+        GKNVcrossingsReducer  reducer(g01);
+        reducer.setExecutionMode(mode, numRestarts, numThreads);
+        setMinNodesPerTransposeThread(reducer, minNodesPerThread);
+        auto numCrossings = reducer.reduce(ranks, 20);
+
+        long numCounted = 0;
+        for (long i = 0; i < numRanks - 1; i++) {
+            numCounted += countCrossingsByPairs(ranks[i], ranks[i+1]);
+        }
+        EXPECT_EQ(numCrossings, numCounted);
+
+        nums.clear();
+        for (auto& rank : ranks) {
+            EXPECT_EQ(rank.size(), numNodesRank);
+            vector<long> v;
+            for (auto nit : rank) {
+                v.push_back(dynamic_cast<NumDiNode&>(*(*nit)).num());
+            }
+            nums.push_back(std::move(v));
+        }
+        return numCrossings;
+    };
+
+    vector<vector<long> > numsSeq;
+    vector<vector<long> > numsPar1;
+    vector<vector<long> > numsPar4;
+
+    const size_t kMin = GKNVcrossingsReducer::kMinNodesPerTransposeThread;
+    auto numSeq = runReduce(
+                     GKNVcrossingsReducer::SEQUENTIAL, 1, 1, kMin, numsSeq);
+    EXPECT_GT(numSeq, 0);
+
+    // Multiple restarts.
+    auto numPar1 = runReduce(
+                     GKNVcrossingsReducer::PARALLEL, 4, 1, kMin, numsPar1);
+    auto numPar4 = runReduce(
+                     GKNVcrossingsReducer::PARALLEL, 4, 4, kMin, numsPar4);
+    EXPECT_EQ(numPar1, numPar4);
+    EXPECT_EQ(numsPar1, numsPar4);
+
+    // Single restart. The transposition runs in the threads.
+    numPar1 = runReduce(GKNVcrossingsReducer::PARALLEL, 1, 1, 1, numsPar1);
+    numPar4 = runReduce(GKNVcrossingsReducer::PARALLEL, 1, 3, 1, numsPar4);
+    EXPECT_EQ(numPar1, numPar4);
+    EXPECT_EQ(numsPar1, numsPar4);
+
+    // Single restart below the threshold. It falls back to one thread.
+    numPar4 = runReduce(
+                     GKNVcrossingsReducer::PARALLEL, 1, 3, kMin, numsPar4);
+    EXPECT_EQ(numPar1, numPar4);
+    EXPECT_EQ(numsPar1, numsPar4);
+}
+
+
 } // namespace Directed
 
 } // namespace Wailea
@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 #include "directed/network_simplex.hpp"
 
+#include <set>
+
 namespace Wailea {
 
 namespace Directed { 
@@ -14,6 +16,499 @@ class NetworkSimplexTests : public ::testing::Test {
     virtual void SetUp() {;};
     virtual void TearDown() {;};
 
+    /** @brief makes a feasible network with random supply/demand and costs
+     *         on a bidirectional chain of the nodes plus random edges.
+     *         supplies and costs receive the values in the same order as
+     *         the nodes and edges in g.
+     */
+    void makeRandomNetwork(
+        DiGraph&      g,
+        long          numNodes,
+        long          numExtraEdges,
+        vector<long>& supplies,
+        vector<long>& costs
+    ) {
+        vector<node_list_it_t> nodes;
+        unsigned long seed = 12345;
+        auto nextRand = [&seed]() {
+            seed = seed * 1103515245 + 12345;
+            return long((seed / 65536) % 32768);
+        };
+
+        long totalB = 0;
+        for (long i = 0; i < numNodes; i++) {
+            auto& N = dynamic_cast<NetworkSimplexNode&>(
+                          g.addNode(std::make_unique<NetworkSimplexNode>(i)));
+            long b = (i == numNodes - 1) ? -1 * totalB : nextRand() % 21 - 10;
+            N.setB(b);
+            supplies.push_back(b);
+            totalB += b;
+            nodes.push_back(N.backIt());
+        }
+
+        for (long i = 0; i < numNodes - 1; i++) {
+            auto& N1 = *(*nodes[i]);
+            auto& N2 = *(*nodes[i+1]);
+            auto& E1 = dynamic_cast<NetworkSimplexEdge&>(g.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N1, N2));
+            costs.push_back(50 + nextRand() % 50);
+            E1.setC(costs.back());
+            auto& E2 = dynamic_cast<NetworkSimplexEdge&>(g.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N2, N1));
+            costs.push_back(50 + nextRand() % 50);
+            E2.setC(costs.back());
+        }
+
+        for (long i = 0; i < numExtraEdges; i++) {
+            long n1 = nextRand() % numNodes;
+            long n2 = nextRand() % numNodes;
+            if (n1 == n2) {
+                continue;
+            }
+            auto& E = dynamic_cast<NetworkSimplexEdge&>(g.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(),
+                         *(*nodes[n1]), *(*nodes[n2])));
+            costs.push_back(nextRand() % 100);
+            E.setC(costs.back());
+        }
+    }
+
+    /** @brief checks the primal feasibility, dual feasibility, and 
+     *         complementary slackness of the solution.
+     *
+     *  @return the objective value
+     */
+    long checkOptimality(
+        DiGraph&      g,
+        vector<long>& supplies,
+        vector<long>& costs
+    ) {
+        long   objective = 0;
+        size_t index     = 0;
+        for (auto eit = g.edges().first; eit != g.edges().second; eit++) {
+            auto& E  = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+            auto& Ns = dynamic_cast<NetworkSimplexNode&>(E.incidentNodeSrc());
+            auto& Nd = dynamic_cast<NetworkSimplexNode&>(E.incidentNodeDst());
+            long c = costs[index++];
+            long z = c - Nd.y() + Ns.y();
+            EXPECT_GE(E.x(), 0);
+            EXPECT_GE(z, 0);
+            if (E.x() > 0) {
+                EXPECT_EQ(z, 0);
+            }
+            objective += c * E.x();
+        }
+
+        index = 0;
+        for (auto nit = g.nodes().first; nit != g.nodes().second; nit++) {
+            auto& N = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+            long flow = 0;
+            for (auto iit  = N.incidentEdgesIn().first;
+                      iit != N.incidentEdgesIn().second; iit++) {
+                flow += dynamic_cast<NetworkSimplexEdge&>(*(*(*iit))).x();
+            }
+            for (auto iit  = N.incidentEdgesOut().first;
+                      iit != N.incidentEdgesOut().second; iit++) {
+                flow -= dynamic_cast<NetworkSimplexEdge&>(*(*(*iit))).x();
+            }
+            EXPECT_EQ(flow, -1 * supplies[index++]);
+        }
+        return objective;
+    }
+
+    /** @brief returns the parent of the node in the spanning tree, or
+     *         nullptr for the root.
+     */
+    NSSpanningTreeNode* parentInTree(
+        NetworkSimplex&     ns,
+        NSSpanningTreeNode& Nst
+    ) {
+        if (Nst.mPrec == ns.mSpanningTree.edges().second) {
+            return nullptr;
+        }
+        auto& Est = dynamic_cast<NSSpanningTreeEdge&>(*(*(Nst.mPrec)));
+        return &(dynamic_cast<NSSpanningTreeNode&>(Est.adjacentNode(Nst)));
+    }
+
+    /** @brief returns true if Nst is Mst or a descendant of it found by
+     *         following the parent edges.
+     */
+    bool isDescendant(
+        NetworkSimplex&     ns,
+        NSSpanningTreeNode& Nst,
+        NSSpanningTreeNode& Mst
+    ) {
+        for (auto* Pst = &Nst; Pst != nullptr; Pst = parentInTree(ns, *Pst)) {
+            if (Pst == &Mst) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** @brief checks that the parent edges make the basis a tree rooted
+     *         at the root, and the subtree sizes.
+     */
+    void checkSpanningTree(NetworkSimplex& ns) {
+
+        auto&  T = ns.mSpanningTree;
+        size_t n = T.numNodes();
+        EXPECT_EQ(T.numEdges(), n - 1);
+
+        size_t numBasis = 0;
+        for (auto eit = ns.mG.edges().first; eit != ns.mG.edges().second;
+                                                                      eit++) {
+            auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+            if (Eg.mInBasis) {
+                numBasis++;
+                EXPECT_EQ(Eg.IGForwardLinksSize(), 1);
+            }
+        }
+        EXPECT_EQ(numBasis, n - 1);
+
+        auto& Rg  = dynamic_cast<NetworkSimplexNode&>(*(*(ns.mRootIt)));
+        auto& Rst = dynamic_cast<NSSpanningTreeNode&>(Rg.IGForwardLinkRef());
+        EXPECT_EQ(parentInTree(ns, Rst), nullptr);
+
+        vector<NSSpanningTreeNode*> nodes;
+        for (auto nit = T.nodes().first; nit != T.nodes().second; nit++) {
+            nodes.push_back(&(dynamic_cast<NSSpanningTreeNode&>(*(*nit))));
+        }
+
+        // Every node reaches the root within n steps, and each tree edge
+        // is the parent edge of exactly one node.
+        size_t numParentEdges = 0;
+        for (auto* Nst : nodes) {
+            size_t steps = 0;
+            auto*  Pst   = Nst;
+            while (Pst != &Rst && Pst != nullptr && steps <= n) {
+                Pst = parentInTree(ns, *Pst);
+                steps++;
+            }
+            EXPECT_EQ(Pst, &Rst);
+            if (Pst != &Rst) {
+                return;
+            }
+            if (Nst != &Rst) {
+                numParentEdges++;
+            }
+        }
+        EXPECT_EQ(numParentEdges, n - 1);
+
+        for (auto* Nst : nodes) {
+            long size = 0;
+            for (auto* Mst : nodes) {
+                if (isDescendant(ns, *Mst, *Nst)) {
+                    size++;
+                }
+            }
+            EXPECT_EQ(Nst->mSize, size);
+        }
+    }
+
+    /** @brief checks the flow conservation of X, and Z against Y.
+     *         The basis edges must have zero Z, the non-basis ones must
+     *         have zero X, and mNegativeZEdges must hold the non-basis
+     *         edges with negative Z that can enter the basis.
+     */
+    void checkValues(NetworkSimplex& ns) {
+
+        size_t numNegativeZ = 0;
+        for (auto eit = ns.mG.edges().first; eit != ns.mG.edges().second;
+                                                                      eit++) {
+            auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+            auto& Ns = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeSrc());
+            auto& Nd = dynamic_cast<NetworkSimplexNode&>(Eg.incidentNodeDst());
+            EXPECT_EQ(Eg.mZ, Eg.mC - Nd.mY + Ns.mY);
+            if (Eg.mInBasis) {
+                EXPECT_EQ(Eg.mZ, 0);
+            }
+            else {
+                EXPECT_EQ(Eg.mX, 0);
+                if (Eg.mZ < 0 && ns.isEnteringCandidate(Eg)) {
+                    numNegativeZ++;
+                }
+            }
+        }
+        EXPECT_EQ(ns.mNegativeZEdges.size(), numNegativeZ);
+        for (auto eit : ns.mNegativeZEdges) {
+            auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+            EXPECT_EQ(Eg.mInBasis, false);
+            EXPECT_LT(Eg.mZ, 0);
+        }
+
+        for (auto nit = ns.mG.nodes().first; nit != ns.mG.nodes().second;
+                                                                      nit++) {
+            auto& N = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+            long flow = 0;
+            for (auto iit  = N.incidentEdgesIn().first;
+                      iit != N.incidentEdgesIn().second; iit++) {
+                flow += dynamic_cast<NetworkSimplexEdge&>(*(*(*iit))).mX;
+            }
+            for (auto iit  = N.incidentEdgesOut().first;
+                      iit != N.incidentEdgesOut().second; iit++) {
+                flow -= dynamic_cast<NetworkSimplexEdge&>(*(*(*iit))).mX;
+            }
+            EXPECT_EQ(flow, -1 * N.mB);
+        }
+    }
+
+    /** @brief checks that every basis edge with zero X is oriented from
+     *         the child to the parent, i.e., toward the root.
+     */
+    void checkStronglyFeasible(NetworkSimplex& ns) {
+
+        for (auto eit = ns.mG.edges().first; eit != ns.mG.edges().second;
+                                                                      eit++) {
+            auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+            if (!Eg.mInBasis || Eg.mX != 0) {
+                continue;
+            }
+            auto& Ns  = dynamic_cast<NetworkSimplexNode&>(
+                                                       Eg.incidentNodeSrc());
+            auto& Nst = dynamic_cast<NSSpanningTreeNode&>(
+                                                       Ns.IGForwardLinkRef());
+            EXPECT_EQ(Nst.mPrec, Eg.IGForwardLink());
+        }
+    }
+
+    /** @brief makes a network of a random DAG with unit costs plus a chain
+     *         through all the nodes. The supply/demand comes from random
+     *         weights of the DAG edges. Most of the pivots on it are
+     *         degenerate.
+     */
+    void makeUnitCostNetwork(
+        DiGraph&      g,
+        long          numNodes,
+        vector<long>& supplies,
+        vector<long>& costs
+    ) {
+        vector<node_list_it_t> nodes;
+        unsigned long long seed = 777;
+        auto nextRand = [&seed]() {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            return long((seed >> 33) & 0x7fffffff);
+        };
+
+        supplies.assign(numNodes, 0);
+        for (long i = 0; i < numNodes; i++) {
+            auto& N = dynamic_cast<NetworkSimplexNode&>(
+                          g.addNode(std::make_unique<NetworkSimplexNode>(i)));
+            nodes.push_back(N.backIt());
+        }
+
+        for (long k = 0; k < numNodes * 3; k++) {
+            long i = nextRand() % numNodes;
+            long j = nextRand() % numNodes;
+            if (i == j) {
+                continue;
+            }
+            if (i > j) {
+                swap(i, j);
+            }
+            auto& E = dynamic_cast<NetworkSimplexEdge&>(g.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(),
+                         *(*nodes[i]), *(*nodes[j])));
+            E.setC(1);
+            costs.push_back(1);
+            long weight = 1 + nextRand() % 3;
+            supplies[i] += weight;
+            supplies[j] -= weight;
+        }
+
+        for (long i = 0; i < numNodes - 1; i++) {
+            auto& E = dynamic_cast<NetworkSimplexEdge&>(g.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(),
+                         *(*nodes[i]), *(*nodes[i+1])));
+            E.setC(1);
+            costs.push_back(1);
+        }
+
+        for (long i = 0; i < numNodes; i++) {
+            dynamic_cast<NetworkSimplexNode&>(*(*nodes[i])).setB(supplies[i]);
+        }
+    }
+
+    /** @brief runs the two phases of STRONGLY_FEASIBLE_TREE pivot by pivot
+     *         checking the strong feasibility, the spanning tree, and the
+     *         values after each pivot. The artificial edges must keep zero
+     *         X in the second phase.
+     *
+     *  @return number of the degenerate pivots.
+     */
+    size_t runStronglyFeasiblePivotsWithChecks(NetworkSimplex& ns) {
+
+        size_t numDegenerate = 0;
+
+        ns.mStronglyFeasible = true;
+        ns.makeAuxGraph(true);
+        ns.makeInitialStronglyFeasibleSpanningTree();
+        ns.createInitialInternalStructureForSpanningTree();
+        ns.findInitialAuxX();
+        ns.findInitialY();
+        ns.findInitialZ();
+        ns.mSpanningTreeBuilt = true;
+
+        EXPECT_EQ(ns.mRootIt, ns.mArtificialNodeIt);
+        checkStronglyFeasible(ns);
+
+        for (long phase = 1; phase <= 2; phase++) {
+
+            if (phase == 2) {
+                for (auto eit = ns.mG.edges().first;
+                                      eit != ns.mG.edges().second; eit++) {
+                    auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+                    EXPECT_EQ(Eg.mArtificial && Eg.mX != 0, false);
+                    Eg.mC = Eg.mArtificial ? 0 : Eg.mCreal;
+                }
+                ns.mArtificialEdgesFixed = true;
+                ns.mNegativeZEdges.clear();
+                ns.mPricingCursor = ns.mNegativeZEdges.end();
+                ns.findInitialY();
+                ns.findInitialZ();
+            }
+
+            while (!ns.mNegativeZEdges.empty()) {
+
+                auto& Eenter = ns.findEnteringEdge();
+                ns.findCycle(Eenter, ns.mCycle);
+                auto& Eleave = ns.findLeavingEdge(Eenter, ns.mCycle);
+                if (&Eleave != &Eenter && Eleave.mX == 0) {
+                    numDegenerate++;
+                }
+
+                EXPECT_EQ(ns.pivot(), true);
+
+                checkStronglyFeasible(ns);
+                checkSpanningTree(ns);
+                checkValues(ns);
+                if (phase == 2) {
+                    for (auto eit : ns.mArtificialEdges) {
+                        auto& Eg = dynamic_cast<NetworkSimplexEdge&>(
+                                                                   *(*eit));
+                        EXPECT_EQ(Eg.mX, 0);
+                    }
+                }
+            }
+        }
+        return numDegenerate;
+    }
+
+    /** @brief compares the side and the cut found by findSubtree() and
+     *         findCutSet() for the basis edge with the ones found naively.
+     *
+     *  @return true if STnr is the smaller side.
+     */
+    bool checkPartition(NetworkSimplex& ns, NetworkSimplexEdge& Eg) {
+
+        auto& LDst = ns.deeperSpanningTreeNode(Eg);
+
+        ns.findSubtree(Eg, ns.mSideNodes);
+        ns.findCutSet(ns.mSideNodes, ns.mCut);
+
+        std::set<Node*> subtree;
+        for (auto nit = ns.mG.nodes().first; nit != ns.mG.nodes().second;
+                                                                      nit++) {
+            auto& Ng  = dynamic_cast<NetworkSimplexNode&>(*(*nit));
+            auto& Nst = dynamic_cast<NSSpanningTreeNode&>(
+                                                        Ng.IGForwardLinkRef());
+            bool inSubtree = isDescendant(ns, Nst, LDst);
+            EXPECT_EQ(ns.isInSubtree(Nst), inSubtree);
+            if (inSubtree) {
+                subtree.insert(&Ng);
+            }
+        }
+
+        bool subtreeSide = subtree.size() * 2 <= ns.mG.numNodes();
+        EXPECT_EQ(ns.mSideIsSubtree, subtreeSide);
+
+        std::set<Node*> side;
+        for (auto nit : ns.mSideNodes) {
+            side.insert(&(*(*nit)));
+        }
+        EXPECT_EQ(side.size(), ns.mSideNodes.size());
+        EXPECT_EQ(side.size(), subtreeSide ?
+                            subtree.size() : ns.mG.numNodes() - subtree.size());
+        for (auto* N : side) {
+            EXPECT_EQ(subtree.count(N) == 1, subtreeSide);
+        }
+
+        std::set<Edge*> cut;
+        for (auto eit : ns.mCut) {
+            cut.insert(&(*(*eit)));
+        }
+        EXPECT_EQ(cut.size(), ns.mCut.size());
+        size_t numCut = 0;
+        for (auto eit = ns.mG.edges().first; eit != ns.mG.edges().second;
+                                                                      eit++) {
+            auto& E = *(*eit);
+            if ((subtree.count(&(E.incidentNode1())) == 1) !=
+                (subtree.count(&(E.incidentNode2())) == 1)   ) {
+                EXPECT_EQ(cut.count(&E), 1);
+                numCut++;
+            }
+        }
+        EXPECT_EQ(cut.size(), numCut);
+
+        return subtreeSide;
+    }
+
+    /** @brief runs the phase 1 pivots of the auxiliary problem checking the
+     *         partition and the cut made by every basis edge before each
+     *         pivot, and the spanning tree and the values after it.
+     *
+     *  @param numSubtreeSide (out): number of pivots whose leaving edge had
+     *                               STnr as the smaller side.
+     *
+     *  @param numRestSide    (out): number of pivots whose leaving edge had
+     *                               ST\STnr as the smaller side.
+     */
+    void runAuxPivotsWithChecks(
+        NetworkSimplex& ns,
+        size_t&         numSubtreeSide,
+        size_t&         numRestSide
+    ) {
+        numSubtreeSide = 0;
+        numRestSide    = 0;
+
+        ns.makeAuxGraph(false);
+        ns.makeInitialAuxSpanningTree();
+        ns.createInitialInternalStructureForSpanningTree();
+        ns.findInitialAuxX();
+        ns.findInitialY();
+        ns.findInitialZ();
+        ns.mSpanningTreeBuilt = true;
+
+        checkSpanningTree(ns);
+        checkValues(ns);
+
+        while (!ns.mNegativeZEdges.empty()) {
+
+            for (auto eit = ns.mG.edges().first; eit != ns.mG.edges().second;
+                                                                      eit++) {
+                auto& Eg = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+                if (Eg.mInBasis) {
+                    checkPartition(ns, Eg);
+                }
+            }
+
+            auto& Eenter = ns.findEnteringEdge();
+            ns.findCycle(Eenter, ns.mCycle);
+            auto& Eleave = ns.findLeavingEdge(Eenter, ns.mCycle);
+            if (checkPartition(ns, Eleave)) {
+                numSubtreeSide++;
+            }
+            else {
+                numRestSide++;
+            }
+
+            EXPECT_EQ(ns.pivot(), true);
+
+            checkSpanningTree(ns);
+            checkValues(ns);
+        }
+    }
+
 };
 
 
@@ -1063,6 +1558,562 @@ TEST_F(NetworkSimplexTests, Test17) {
 
 }
 
+
+/**  @brief Large spanning tree solved without simultaneous equations.
+ *          Binary tree with the edges oriented from the parent to the child.
+ *          The root supplies one unit to each of the other nodes.
+ */
+TEST_F(NetworkSimplexTests, Test18) {
+
+    const long numNodes = 5000;
+
+    DiGraph g01;
+    vector<node_list_it_t> nodes;
+    vector<edge_list_it_t> edges;
+
+    for (long i = 0; i < numNodes; i++) {
+        auto  np = std::make_unique<NetworkSimplexNode>(i);
+        auto& N  = dynamic_cast<NetworkSimplexNode&>(
+                                                  g01.addNode(std::move(np)));
+        N.setB((i == 0) ? (numNodes - 1) : -1);
+        nodes.push_back(N.backIt());
+    }
+
+    for (long i = 1; i < numNodes; i++) {
+        auto  ep = std::make_unique<NetworkSimplexEdge>();
+        auto& E  = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::move(ep), *(*nodes[(i-1)/2]), *(*nodes[i])));
+        E.setC(i % 5 + 1);
+        edges.push_back(E.backIt());
+    }
+
+    NetworkSimplex ns(g01);
+    EXPECT_EQ(ns.solve(), true);
+
+    // Expected x: size of the subtree under the edge.
+    // Expected y: sum of the costs from the root.
+    vector<long> subtreeSizes(numNodes, 1);
+    for (long i = numNodes - 1; i > 0; i--) {
+        subtreeSizes[(i-1)/2] += subtreeSizes[i];
+    }
+    vector<long> depths(numNodes, 0);
+    for (long i = 1; i < numNodes; i++) {
+        depths[i] = depths[(i-1)/2] + i % 5 + 1;
+    }
+
+    for (long i = 0; i < numNodes; i++) {
+        auto& N = dynamic_cast<NetworkSimplexNode&>(*(*nodes[i]));
+        EXPECT_EQ(N.y(), depths[i]);
+    }
+    for (long i = 1; i < numNodes; i++) {
+        auto& E = dynamic_cast<NetworkSimplexEdge&>(*(*edges[i-1]));
+        EXPECT_EQ(E.x(), subtreeSizes[i]);
+    }
+}
+
+
+/**  @brief |E| = |V| - 1 but the edges do not span the nodes.
+ */
+TEST_F(NetworkSimplexTests, Test19) {
+
+    DiGraph g01;
+ 
+    auto np01 = std::make_unique<NetworkSimplexNode>(1);
+    auto& N01 = dynamic_cast<NetworkSimplexNode&>(
+                                                g01.addNode(std::move(np01)));
+
+    auto np02 = std::make_unique<NetworkSimplexNode>(2);
+    auto& N02 = dynamic_cast<NetworkSimplexNode&>(
+                                                g01.addNode(std::move(np02)));
+
+    auto np03 = std::make_unique<NetworkSimplexNode>(3);
+    auto& N03 = dynamic_cast<NetworkSimplexNode&>(
+                                                g01.addNode(std::move(np03)));
+
+    auto np04 = std::make_unique<NetworkSimplexNode>(4);
+    auto& N04 = dynamic_cast<NetworkSimplexNode&>(
+                                                g01.addNode(std::move(np04)));
+
+    auto ep01_02 = std::make_unique<NetworkSimplexEdge>();
+    auto& E01_02 = dynamic_cast<NetworkSimplexEdge&>(
+                                    g01.addEdge(std::move(ep01_02), N01, N02));
+
+    auto ep02_03 = std::make_unique<NetworkSimplexEdge>();
+    auto& E02_03 = dynamic_cast<NetworkSimplexEdge&>(
+                                    g01.addEdge(std::move(ep02_03), N02, N03));
+
+    auto ep03_01 = std::make_unique<NetworkSimplexEdge>();
+    auto& E03_01 = dynamic_cast<NetworkSimplexEdge&>(
+                                    g01.addEdge(std::move(ep03_01), N03, N01));
+
+    N01.setB(1);
+    N02.setB(0);
+    N03.setB(0);
+    N04.setB(-1);
+
+    E01_02.setC(1);
+    E02_03.setC(1);
+    E03_01.setC(1);
+
+    NetworkSimplex ns(g01);
+    EXPECT_EQ(ns.checkValidity(), false);
+    EXPECT_EQ(ns.solve(), false);
+
+}
+
+
+/**  @brief Pricing strategies on a random network.
+ *          All of them must reach an optimum of the same cost.
+ */
+TEST_F(NetworkSimplexTests, Test20) {
+
+    vector<NetworkSimplex::pricingType> pricings = {
+        NetworkSimplex::FIRST_ELIGIBLE,
+        NetworkSimplex::MOST_NEGATIVE,
+        NetworkSimplex::BLOCK_SEARCH,
+        NetworkSimplex::CYCLIC
+    };
+
+    vector<long> objectives;
+
+    for (auto pricing : pricings) {
+
+        SCOPED_TRACE(pricing);
+        DiGraph g01;
+        vector<long> supplies;
+        vector<long> costs;
+        makeRandomNetwork(g01, 80, 400, supplies, costs);
+
+        NetworkSimplex ns(g01);
+        ns.setPricing(pricing);
+        EXPECT_EQ(ns.checkValidity(), true);
+        EXPECT_EQ(ns.solve(), true);
+        EXPECT_GT(ns.numPivots(), 0);
+
+        objectives.push_back(checkOptimality(g01, supplies, costs));
+    }
+
+    for (size_t i = 1; i < objectives.size(); i++) {
+        EXPECT_EQ(objectives[i], objectives[0]);
+    }
+}
+
+
+/**  @brief Re-optimization from the previous basis after changes in
+ *          costs, supply/demand, and edges.
+ */
+TEST_F(NetworkSimplexTests, Test21) {
+
+    DiGraph g01;
+    vector<long> supplies;
+    vector<long> costs;
+    makeRandomNetwork(g01, 80, 400, supplies, costs);
+
+    NetworkSimplex ns(g01);
+    EXPECT_EQ(ns.solve(), true);
+    checkOptimality(g01, supplies, costs);
+    size_t numPivotsCold = ns.numPivots();
+
+    // Change costs.
+    size_t index = 0;
+    for (auto eit = g01.edges().first; eit != g01.edges().second; eit++) {
+        if (index % 37 == 0) {
+            auto& E = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+            costs[index] = (costs[index] * 7) % 100;
+            E.setC(costs[index]);
+        }
+        index++;
+    }
+    EXPECT_EQ(ns.resolve(), true);
+    long objective = checkOptimality(g01, supplies, costs);
+    EXPECT_LT(ns.numPivots(), numPivotsCold);
+
+    // Must be the same as the optimum from scratch.
+    EXPECT_EQ(ns.solve(), true);
+    EXPECT_EQ(checkOptimality(g01, supplies, costs), objective);
+    numPivotsCold = ns.numPivots();
+
+    // Change supply/demand.
+    auto nit1 = g01.nodes().first;
+    auto nit2 = std::next(nit1, 40);
+    supplies[0]  += 3;
+    supplies[40] -= 3;
+    dynamic_cast<NetworkSimplexNode&>(*(*nit1)).setB(supplies[0]);
+    dynamic_cast<NetworkSimplexNode&>(*(*nit2)).setB(supplies[40]);
+    EXPECT_EQ(ns.resolve(), true);
+    checkOptimality(g01, supplies, costs);
+
+    // Add an edge.
+    auto& Eadded = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(),
+                         *(*nit2), *(*nit1)));
+    costs.push_back(1);
+    Eadded.setC(1);
+    EXPECT_EQ(ns.resolve(), true);
+    checkOptimality(g01, supplies, costs);
+
+    // Remove the edges with flow, i.e., some basis edges.
+    // It falls back to a solve from scratch.
+    index = 0;
+    vector<long> remainingCosts;
+    for (auto eit = g01.edges().first; eit != g01.edges().second; ) {
+        auto& E = dynamic_cast<NetworkSimplexEdge&>(*(*eit));
+        eit++;
+        if (index >= 2 * 79 && E.x() > 0 && index % 3 == 0) {
+            g01.removeEdge(E);
+        }
+        else {
+            remainingCosts.push_back(costs[index]);
+        }
+        index++;
+    }
+    EXPECT_EQ(ns.resolve(), true);
+    checkOptimality(g01, supplies, remainingCosts);
+}
+
+
+
+/**  @brief Feasible tree initialization on a random network with
+ *          directed cycles and non-negative costs, where Y = 0 is used as
+ *          the initial dual feasible solution.
+ *          It must reach an optimum of the same cost as the two-phase
+ *          method.
+ */
+TEST_F(NetworkSimplexTests, Test22) {
+
+    vector<NetworkSimplex::initialTreeType> initialTrees = {
+        NetworkSimplex::AUXILIARY_PROBLEM,
+        NetworkSimplex::FEASIBLE_TREE,
+        NetworkSimplex::STRONGLY_FEASIBLE_TREE
+    };
+
+    vector<long> objectives;
+
+    for (auto initialTree : initialTrees) {
+
+        SCOPED_TRACE(initialTree);
+        DiGraph g01;
+        vector<long> supplies;
+        vector<long> costs;
+        makeRandomNetwork(g01, 80, 400, supplies, costs);
+
+        NetworkSimplex ns(g01);
+        ns.setInitialTree(initialTree);
+        EXPECT_EQ(ns.solve(), true);
+        objectives.push_back(checkOptimality(g01, supplies, costs));
+    }
+
+    EXPECT_EQ(objectives[1], objectives[0]);
+    EXPECT_EQ(objectives[2], objectives[0]);
+}
+
+
+/**  @brief Feasible tree initialization on rank assignment problems, whose
+ *          networks are acyclic with negative costs.
+ *          The ranks must have the same total edge length as the two-phase
+ *          method.
+ */
+TEST_F(NetworkSimplexTests, Test23) {
+
+    const long numNodes = 300;
+    const long numEdges = 900;
+
+    for (long pattern = 0; pattern < 4; pattern++) {
+
+        vector<long> objectives;
+        vector<long> totalLengths;
+
+        for (auto initialTree : { NetworkSimplex::AUXILIARY_PROBLEM,
+                                  NetworkSimplex::FEASIBLE_TREE,
+                                  NetworkSimplex::STRONGLY_FEASIBLE_TREE } ) {
+
+            SCOPED_TRACE(initialTree);
+            DiGraph g01;
+            vector<node_list_it_t> nodes;
+            vector<long> supplies(numNodes, 0);
+            vector<long> costs;
+            vector<long> weights;
+            vector<pair<long, long> > edgeEnds;
+
+            unsigned long seed = 777 + pattern;
+            auto nextRand = [&seed]() {
+                seed = seed * 1103515245 + 12345;
+                return long((seed / 65536) % 32768);
+            };
+
+            for (long i = 0; i < numNodes; i++) {
+                auto& N = dynamic_cast<NetworkSimplexNode&>(
+                          g01.addNode(std::make_unique<NetworkSimplexNode>(i)));
+                nodes.push_back(N.backIt());
+            }
+
+            // Edge (i,j) with i < j in the layout. The network edge is
+            // (j,i) with the cost -minimum length, and the weight of (i,j)
+            // goes to the supply/demand.
+            for (long k = 0; k < numEdges; k++) {
+                long i = (k < numNodes - 1) ?
+                         nextRand() % (k + 1) : nextRand() % (numNodes - 1);
+                long j = (k < numNodes - 1) ?
+                         k + 1 : i + 1 + nextRand() % (numNodes - 1 - i);
+                long minLength = 1 + nextRand() % 3;
+                long weight    = 1 + nextRand() % 5;
+                auto& E = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                                  std::make_unique<NetworkSimplexEdge>(),
+                                  *(*nodes[j]), *(*nodes[i])));
+                E.setC(-1 * minLength);
+                costs.push_back(-1 * minLength);
+                supplies[i] -= weight;
+                supplies[j] += weight;
+                weights.push_back(weight);
+                edgeEnds.push_back(make_pair(i, j));
+            }
+            for (long i = 0; i < numNodes; i++) {
+                dynamic_cast<NetworkSimplexNode&>(*(*nodes[i])).setB(
+                                                                 supplies[i]);
+            }
+
+            NetworkSimplex ns(g01);
+            ns.setInitialTree(initialTree);
+            EXPECT_EQ(ns.solve(), true);
+            objectives.push_back(checkOptimality(g01, supplies, costs));
+
+            // Total weighted length of the edges in the ranking.
+            long total = 0;
+            for (long k = 0; k < numEdges; k++) {
+                auto& Ni = dynamic_cast<NetworkSimplexNode&>(
+                                               *(*nodes[edgeEnds[k].first]));
+                auto& Nj = dynamic_cast<NetworkSimplexNode&>(
+                                               *(*nodes[edgeEnds[k].second]));
+                EXPECT_GE(Nj.y() - Ni.y(), -1 * costs[k]);
+                total += weights[k] * (Nj.y() - Ni.y());
+            }
+            totalLengths.push_back(total);
+        }
+        EXPECT_EQ(objectives[1], objectives[0]);
+        EXPECT_EQ(objectives[2], objectives[0]);
+        EXPECT_EQ(totalLengths[1], totalLengths[0]);
+        EXPECT_EQ(totalLengths[2], totalLengths[0]);
+    }
+}
+
+
+/**  @brief Feasible tree initialization on infeasible networks.
+ *          The first one is acyclic and the infeasibility is detected by
+ *          the dual pivots. The second one is not connected, and it falls
+ *          back to the two-phase method.
+ */
+TEST_F(NetworkSimplexTests, Test24) {
+
+    {
+        DiGraph g01;
+        auto& N01 = dynamic_cast<NetworkSimplexNode&>(
+                         g01.addNode(std::make_unique<NetworkSimplexNode>(1)));
+        auto& N02 = dynamic_cast<NetworkSimplexNode&>(
+                         g01.addNode(std::make_unique<NetworkSimplexNode>(2)));
+        auto& N03 = dynamic_cast<NetworkSimplexNode&>(
+                         g01.addNode(std::make_unique<NetworkSimplexNode>(3)));
+        auto& E01_02 = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N01, N02));
+        auto& E01_03 = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N01, N03));
+        auto& E02_03 = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N02, N03));
+        N01.setB(-1);
+        N02.setB(0);
+        N03.setB(1);
+        E01_02.setC(1);
+        E01_03.setC(-2);
+        E02_03.setC(1);
+
+        NetworkSimplex ns(g01);
+        ns.setInitialTree(NetworkSimplex::FEASIBLE_TREE);
+        EXPECT_EQ(ns.checkValidity(), true);
+        EXPECT_EQ(ns.solve(), false);
+    }
+    {
+        DiGraph g01;
+        auto& N01 = dynamic_cast<NetworkSimplexNode&>(
+                         g01.addNode(std::make_unique<NetworkSimplexNode>(1)));
+        auto& N02 = dynamic_cast<NetworkSimplexNode&>(
+                         g01.addNode(std::make_unique<NetworkSimplexNode>(2)));
+        auto& N03 = dynamic_cast<NetworkSimplexNode&>(
+                         g01.addNode(std::make_unique<NetworkSimplexNode>(3)));
+        auto& N04 = dynamic_cast<NetworkSimplexNode&>(
+                         g01.addNode(std::make_unique<NetworkSimplexNode>(4)));
+        auto& E01_02 = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N01, N02));
+        auto& E02_03 = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N02, N03));
+        auto& E03_01 = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N03, N01));
+        N01.setB(1);
+        N02.setB(0);
+        N03.setB(0);
+        N04.setB(-1);
+        E01_02.setC(1);
+        E02_03.setC(1);
+        E03_01.setC(1);
+
+        NetworkSimplex ns(g01);
+        ns.setInitialTree(NetworkSimplex::FEASIBLE_TREE);
+        EXPECT_EQ(ns.solve(), false);
+    }
+}
+
+/**  @brief Pivots with the smaller side of the cut.
+ *          Random networks are solved by the auxiliary problem pivot by
+ *          pivot. Before each pivot, the side of the cut and the cut set
+ *          found for every basis edge are compared with the naive ones.
+ *          After each pivot, the spanning tree including the subtree
+ *          sizes, X, Y, and Z are checked. Pivots whose leaving edge
+ *          has the larger STnr and the smaller STnr must both occur.
+ */
+TEST_F(NetworkSimplexTests, Test25) {
+
+    size_t totalSubtreeSide = 0;
+    size_t totalRestSide    = 0;
+
+    for (long numNodes = 10; numNodes <= 40; numNodes += 10) {
+
+        DiGraph      g01;
+        vector<long> supplies;
+        vector<long> costs;
+        makeRandomNetwork(g01, numNodes, numNodes * 2, supplies, costs);
+
+        NetworkSimplex ns(g01);
+        size_t numSubtreeSide;
+        size_t numRestSide;
+        runAuxPivotsWithChecks(ns, numSubtreeSide, numRestSide);
+        totalSubtreeSide += numSubtreeSide;
+        totalRestSide    += numRestSide;
+
+        // The same network is solved to the end.
+        DiGraph      g02;
+        vector<long> supplies02;
+        vector<long> costs02;
+        makeRandomNetwork(g02, numNodes, numNodes * 2, supplies02, costs02);
+        NetworkSimplex ns2(g02);
+        EXPECT_EQ(ns2.solve(), true);
+        checkOptimality(g02, supplies02, costs02);
+    }
+
+    EXPECT_GT(totalSubtreeSide, 0);
+    EXPECT_GT(totalRestSide,    0);
+}
+
+
+/**  @brief Strongly feasible tree on degenerate networks.
+ *          The two phases are run pivot by pivot, and the tree must stay
+ *          strongly feasible after every pivot including the degenerate
+ *          ones. solve() must find the same objective as the two-phase
+ *          method, and leave a spanning tree of the real edges.
+ */
+TEST_F(NetworkSimplexTests, Test26) {
+
+    size_t totalDegenerate = 0;
+
+    for (long numNodes = 10; numNodes <= 30; numNodes += 10) {
+
+        {
+            DiGraph      g01;
+            vector<long> supplies;
+            vector<long> costs;
+            makeUnitCostNetwork(g01, numNodes, supplies, costs);
+            NetworkSimplex ns(g01);
+            totalDegenerate += runStronglyFeasiblePivotsWithChecks(ns);
+        }
+
+        vector<long> objectives;
+        for (auto initialTree : { NetworkSimplex::AUXILIARY_PROBLEM,
+                                  NetworkSimplex::STRONGLY_FEASIBLE_TREE } ) {
+
+            SCOPED_TRACE(initialTree);
+            DiGraph      g01;
+            vector<long> supplies;
+            vector<long> costs;
+            makeUnitCostNetwork(g01, numNodes, supplies, costs);
+            size_t numNodesOrg = g01.numNodes();
+            size_t numEdgesOrg = g01.numEdges();
+
+            NetworkSimplex ns(g01);
+            ns.setInitialTree(initialTree);
+            EXPECT_EQ(ns.solve(), true);
+            objectives.push_back(checkOptimality(g01, supplies, costs));
+
+            EXPECT_EQ(g01.numNodes(), numNodesOrg);
+            EXPECT_EQ(g01.numEdges(), numEdgesOrg);
+            checkSpanningTree(ns);
+            checkValues(ns);
+        }
+        EXPECT_EQ(objectives[1], objectives[0]);
+    }
+
+    EXPECT_GT(totalDegenerate, 0);
+}
+
+
+/**  @brief Strongly feasible tree on an infeasible network. The supply
+ *          can not reach the demand, and the artificial edges keep
+ *          positive X at the end of the first phase.
+ */
+TEST_F(NetworkSimplexTests, Test27) {
+
+    DiGraph g01;
+    auto& N01 = dynamic_cast<NetworkSimplexNode&>(
+                         g01.addNode(std::make_unique<NetworkSimplexNode>(1)));
+    auto& N02 = dynamic_cast<NetworkSimplexNode&>(
+                         g01.addNode(std::make_unique<NetworkSimplexNode>(2)));
+    auto& N03 = dynamic_cast<NetworkSimplexNode&>(
+                         g01.addNode(std::make_unique<NetworkSimplexNode>(3)));
+    auto& E01_02 = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N01, N02));
+    auto& E01_03 = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N01, N03));
+    auto& E02_03 = dynamic_cast<NetworkSimplexEdge&>(g01.addEdge(
+                         std::make_unique<NetworkSimplexEdge>(), N02, N03));
+    N01.setB(-1);
+    N02.setB(0);
+    N03.setB(1);
+    E01_02.setC(1);
+    E01_03.setC(2);
+    E02_03.setC(1);
+
+    NetworkSimplex ns(g01);
+    ns.setInitialTree(NetworkSimplex::STRONGLY_FEASIBLE_TREE);
+    EXPECT_EQ(ns.checkValidity(), true);
+    EXPECT_EQ(ns.solve(), false);
+    EXPECT_EQ(g01.numNodes(), 3);
+    EXPECT_EQ(g01.numEdges(), 3);
+}
+
+
+/**  @brief Dual pivots on a degenerate network. Almost all of the dual
+ *          pivots from the feasible tree are degenerate on it, and
+ *          without Bland's rule they took over 700000 pivots.
+ */
+TEST_F(NetworkSimplexTests, Test28) {
+
+    const long numNodes = 300;
+
+    vector<long> objectives;
+    for (auto initialTree : { NetworkSimplex::AUXILIARY_PROBLEM,
+                              NetworkSimplex::FEASIBLE_TREE     } ) {
+
+        SCOPED_TRACE(initialTree);
+        DiGraph      g01;
+        vector<long> supplies;
+        vector<long> costs;
+        makeUnitCostNetwork(g01, numNodes, supplies, costs);
+
+        NetworkSimplex ns(g01);
+        ns.setInitialTree(initialTree);
+        EXPECT_EQ(ns.solve(), true);
+        objectives.push_back(checkOptimality(g01, supplies, costs));
+        EXPECT_LT(ns.numPivots(), 20000);
+    }
+    EXPECT_EQ(objectives[1], objectives[0]);
+}
+
 } // namespace Directed
 
 } // namespace Wailea
@@ -81,8 +81,8 @@ class GraphTests : public ::testing::Test {
     generation_t mGeneration(Edge& e){ return e.mGeneration;};
     void setGeneration(Edge&e, generation_t v){e.mGeneration=v;};
 
-    list<node_ptr_t>& mNodes(Graph&g){ return g.mNodes;};
-    list<edge_ptr_t>& mEdges(Graph&g){ return g.mEdges; }
+    node_list_t& mNodes(Graph&g){ return g.mNodes;};
+    edge_list_t& mEdges(Graph&g){ return g.mEdges; }
     generation_t mGeneration(Graph& g){ return g.mGeneration; };
     void setGeneration(Graph& g, generation_t v){ g.mGeneration=v;};
 
@@ -170,8 +170,8 @@ TEST_F(GraphTests, DefaultConstructor) {
      */
     Graph& graph = Graph1();
     EXPECT_EQ(mGeneration(graph),0) << "mGeneration is incorrect";
-    list<node_ptr_t>& graph_mNodes = mNodes(graph);
-    list<edge_ptr_t>& graph_mEdges = mEdges(graph);
+    node_list_t& graph_mNodes = mNodes(graph);
+    edge_list_t& graph_mEdges = mEdges(graph);
     EXPECT_EQ(graph_mNodes.size(),0) << "mNodes is incorrect.";    
     EXPECT_EQ(graph_mEdges.size(),0) << "mEdges is incorrect.";    
 
@@ -212,8 +212,8 @@ TEST_F(GraphTests, AddNodeToEmptyGraph) {
     auto& n1 = graph.addNode(std::move(np));
 
     EXPECT_EQ(mGeneration(graph),0) << "mGeneration is incorrect";
-    list<node_ptr_t>& graph_mNodes = mNodes(graph);
-    list<edge_ptr_t>& graph_mEdges = mEdges(graph);
+    node_list_t& graph_mNodes = mNodes(graph);
+    edge_list_t& graph_mEdges = mEdges(graph);
     EXPECT_EQ(graph_mNodes.size(),1) << "mNodes is incorrect.";    
     EXPECT_EQ(graph_mEdges.size(),0) << "mEdges is incorrect.";    
     Node& n2 = *(*(graph_mNodes.begin()));
@@ -268,8 +268,8 @@ TEST_F(GraphTests, RemoveNodeFromGraph) {
     std::unique_ptr<Node> np2 = g1.removeNode(n1);
 
     EXPECT_EQ(mGeneration(g1),0)     << "mGeneration is incorrect";
-    list<node_ptr_t>& g1_mNodes = mNodes(g1);
-    list<edge_ptr_t>& g1_mEdges = mEdges(g1);
+    node_list_t& g1_mNodes = mNodes(g1);
+    edge_list_t& g1_mEdges = mEdges(g1);
     EXPECT_EQ(g1_mNodes.size(),0)    << "mNodes is incorrect.";
     EXPECT_EQ(g1_mEdges.size(),0)    << "mEdges is incorrect.";
 
@@ -332,8 +332,8 @@ TEST_F(GraphTests, AddEdgeToGraph) {
     Edge& e2 = g1.addEdge(std::move(ep1),n1, n2);
 
     EXPECT_EQ(mGeneration(g1),0) << "mGeneration is incorrect";
-    list<node_ptr_t>& g1_mNodes = mNodes(g1);
-    list<edge_ptr_t>& g1_mEdges = mEdges(g1);
+    node_list_t& g1_mNodes = mNodes(g1);
+    edge_list_t& g1_mEdges = mEdges(g1);
     EXPECT_EQ(g1_mNodes.size(),2) << "mNodes is incorrect.";    
     EXPECT_EQ(g1_mEdges.size(),1) << "mEdges is incorrect.";    
 
@@ -0,0 +1,173 @@
+#include "gtest/gtest.h"
+#include "undirected/batch_runner.hpp"
+#include "undirected/text_spec_reader.hpp"
+
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+
+namespace Wailea {
+
+namespace Undirected {
+
+class BatchRunnerTests : public ::testing::Test {
+
+  protected:
+
+    BatchRunnerTests(){;};
+    virtual ~BatchRunnerTests(){;};
+    virtual void SetUp() {;};
+    virtual void TearDown() {;};
+
+    bool readSpec(istream& is, string& spec) {
+        return BatchRunner::readSpec(is, spec);
+    }
+
+    /** @brief sums the numbers in the specification. The specification
+     *         that contains a negative number fails.
+     */
+    static void sum(istream& is, ostream& os, const char* name) {
+        long v;
+        long total = 0;
+        while (is >> v) {
+            if (v < 0) {
+                throw std::invalid_argument("negative");
+            }
+            // Makes the later specifications finish earlier.
+            std::this_thread::sleep_for(std::chrono::microseconds(10 * v));
+            total += v;
+        }
+        os << name << " " << total << "\n";
+    }
+
+    /** @brief parses the pairs of numbers in the way the tools in src_bin
+     *         do. The parser sets the error flag, and the flag is turned
+     *         into an exception.
+     */
+    static bool parsePairs(istream& is, long& total) {
+        TextSpecReader reader;
+        reader.load(is);
+        bool error = false;
+        while (!error && reader.nextLine()) {
+            if (reader.isBlank() || reader.isComment()) {
+                continue;
+            }
+            long n1, n2;
+            if (reader.split() != 2 || !reader.token(0).toLong(n1) ||
+                                       !reader.token(1).toLong(n2)   ) {
+                error = true;
+                break;
+            }
+            total += (n1 + n2);
+        }
+        return !error;
+    }
+
+    static void sumPairs(istream& is, ostream& os, const char* name) {
+        long total = 0;
+        if (!parsePairs(is, total)) {
+            throw std::invalid_argument("syntax error");
+        }
+        os << name << " " << total << "\n";
+    }
+
+};
+
+
+/**  @brief splitting the stream into specifications
+ */
+TEST_F(BatchRunnerTests, Test1) {
+
+    std::istringstream is("1 2\n3\nGRAPH_END\r\n\nGRAPH_END\n4\n\n");
+    string spec;
+
+    EXPECT_TRUE(readSpec(is, spec));
+    EXPECT_EQ(spec, "1 2\n3\n");
+
+    EXPECT_TRUE(readSpec(is, spec));
+    EXPECT_EQ(spec, "\n");
+
+    // The terminator of the last one is omitted.
+    EXPECT_TRUE(readSpec(is, spec));
+    EXPECT_EQ(spec, "4\n\n");
+
+    EXPECT_FALSE(readSpec(is, spec));
+
+    std::istringstream is2("1\nGRAPH_END\n  \n\n");
+    EXPECT_TRUE(readSpec(is2, spec));
+    EXPECT_FALSE(readSpec(is2, spec));
+
+}
+
+
+/**  @brief the results are written in the input order with a failure.
+ */
+TEST_F(BatchRunnerTests, Test2) {
+
+    std::ostringstream in;
+    std::ostringstream expected;
+    const long numSpecs = 100;
+    for (long i = 0; i < numSpecs; i++) {
+        long n = numSpecs - i;
+        if (i == 37) {
+            in << "1 -1\n";
+            expected << "# ERROR: negative\n";
+        }
+        else {
+            in << n << " " << n << "\n";
+            expected << "s:" << (i + 1) << " " << (n * 2) << "\n";
+        }
+        in << "GRAPH_END\n";
+        expected << "GRAPH_END\n";
+    }
+
+    for (size_t numThreads = 1; numThreads <= 8; numThreads *= 2) {
+        std::istringstream is(in.str());
+        std::ostringstream os;
+        BatchRunner runner(sum);
+        runner.setNumThreads(numThreads);
+        runner.setMaxInFlight(numThreads + 1);
+        EXPECT_EQ(runner.run(is, os, "s"), 1);
+        EXPECT_EQ(os.str(), expected.str());
+    }
+
+}
+
+
+/**  @brief empty input
+ */
+TEST_F(BatchRunnerTests, Test3) {
+
+    std::istringstream is("");
+    std::ostringstream os;
+    BatchRunner runner(sum);
+    runner.setNumThreads(4);
+    EXPECT_EQ(runner.run(is, os, "s"), 0);
+    EXPECT_EQ(os.str(), "");
+
+}
+
+
+/**  @brief a malformed specification is reported in its slot, and the
+ *          ones around it are processed.
+ */
+TEST_F(BatchRunnerTests, Test4) {
+
+    std::istringstream is("1 2\n3 4\nGRAPH_END\n"
+                          "1 2\n3 x\nGRAPH_END\n"
+                          "5 6\n");
+    std::ostringstream os;
+    BatchRunner runner(sumPairs);
+    runner.setNumThreads(2);
+    EXPECT_EQ(runner.run(is, os, "s"), 1);
+    EXPECT_EQ(os.str(), "s:1 10\nGRAPH_END\n"
+                        "# ERROR: syntax error\nGRAPH_END\n"
+                        "s:3 11\nGRAPH_END\n");
+
+}
+
+
+} // namespace Undirected
+
+} // namespace Wailea
@@ -0,0 +1,207 @@
+#include "gtest/gtest.h"
+#include "undirected/compact_graph.hpp"
+#include "undirected/connected_decomposer.hpp"
+
+namespace Wailea {
+
+namespace Undirected {
+
+class CompactGraphTests : public ::testing::Test {
+
+  protected:
+
+    CompactGraphTests(){;};
+    virtual ~CompactGraphTests(){;};
+    virtual void SetUp() {;};
+    virtual void TearDown() {;};
+
+    vector<cg_index_t>& mIncidenceOffsets(CompactGraph& g) {
+        return g.mIncidenceOffsets;
+    }
+
+    vector<cg_index_t>& mIncidence(CompactGraph& g) {
+        return g.mIncidence;
+    }
+
+};
+
+
+/**  Empty graph
+ */
+TEST_F(CompactGraphTests, Test1) {
+
+    Graph g;
+    CompactGraph cg;
+    cg.build(g);
+
+    EXPECT_EQ(cg.numNodes(), 0);
+    EXPECT_EQ(cg.numEdges(), 0);
+    EXPECT_EQ(cg.hasOriginal(), false);
+
+}
+
+
+/**  Conversion from Graph preserves the node, edge, and incidence ordering.
+ *
+ *   n1 - n2
+ *   |  /  |
+ *   n3 - n4    n5
+ */
+TEST_F(CompactGraphTests, Test2) {
+
+    Graph g;
+
+    auto& n1 = g.addNode(make_unique<NumNode>(1));
+    auto& n2 = g.addNode(make_unique<NumNode>(2));
+    auto& n3 = g.addNode(make_unique<NumNode>(3));
+    auto& n4 = g.addNode(make_unique<NumNode>(4));
+    auto& n5 = g.addNode(make_unique<NumNode>(5));
+    auto& e12 = g.addEdge(make_unique<Edge>(), n1, n2);
+    auto& e13 = g.addEdge(make_unique<Edge>(), n1, n3);
+    auto& e23 = g.addEdge(make_unique<Edge>(), n2, n3);
+    auto& e24 = g.addEdge(make_unique<Edge>(), n2, n4);
+    auto& e34 = g.addEdge(make_unique<Edge>(), n3, n4);
+
+    vector<edge_list_it_t> n2Incidence;
+    n2Incidence.push_back(e24.backIt());
+    n2Incidence.push_back(e12.backIt());
+    n2Incidence.push_back(e23.backIt());
+    n2.reorderIncidence(std::move(n2Incidence));
+
+    CompactGraph cg;
+    cg.build(g);
+
+    EXPECT_EQ(cg.numNodes(), 5);
+    EXPECT_EQ(cg.numEdges(), 5);
+    EXPECT_EQ(cg.hasOriginal(), true);
+
+    EXPECT_EQ(cg.originalNode(0), n1.backIt());
+    EXPECT_EQ(cg.originalNode(4), n5.backIt());
+    EXPECT_EQ(cg.originalEdge(0), e12.backIt());
+    EXPECT_EQ(cg.originalEdge(4), e34.backIt());
+
+    EXPECT_EQ(cg.incidentNode1(3), 1);
+    EXPECT_EQ(cg.incidentNode2(3), 3);
+    EXPECT_EQ(cg.adjacentNode(3, 3), 1);
+    EXPECT_EQ(cg.adjacentNode(3, 1), 3);
+
+    EXPECT_EQ(cg.degree(0), 2);
+    EXPECT_EQ(cg.degree(1), 3);
+    EXPECT_EQ(cg.degree(4), 0);
+
+    auto p = cg.incidentEdges(1);
+    ASSERT_EQ(p.second - p.first, 3);
+    EXPECT_EQ(p.first[0], 3);
+    EXPECT_EQ(p.first[1], 0);
+    EXPECT_EQ(p.first[2], 2);
+
+    EXPECT_EQ(mIncidenceOffsets(cg).size(), 6);
+    EXPECT_EQ(mIncidence(cg).size(), 10);
+
+    // Utility stacks are restored.
+    EXPECT_EQ(n1.utilitySize(), 0);
+    EXPECT_EQ(e13.utilitySize(), 0);
+
+    EXPECT_THROW(cg.originalNode(5), std::invalid_argument);
+
+}
+
+
+/**  Construction from node index pairs and conversion back to Graph.
+ */
+TEST_F(CompactGraphTests, Test3) {
+
+    vector<pair<cg_index_t,cg_index_t>> edges;
+    edges.push_back(make_pair(0, 1));
+    edges.push_back(make_pair(2, 0));
+    edges.push_back(make_pair(1, 2));
+    edges.push_back(make_pair(3, 2));
+
+    CompactGraph cg;
+    cg.build(4, edges);
+
+    EXPECT_EQ(cg.numNodes(), 4);
+    EXPECT_EQ(cg.numEdges(), 4);
+    EXPECT_EQ(cg.hasOriginal(), false);
+    EXPECT_THROW(cg.originalEdge(0), std::invalid_argument);
+
+    auto p = cg.incidentEdges(2);
+    ASSERT_EQ(p.second - p.first, 3);
+    EXPECT_EQ(p.first[0], 1);
+    EXPECT_EQ(p.first[1], 2);
+    EXPECT_EQ(p.first[2], 3);
+
+    Graph g;
+    vector<node_list_it_t> nodeMap;
+    vector<edge_list_it_t> edgeMap;
+    cg.copyToGraph(g, nodeMap, edgeMap);
+
+    EXPECT_EQ(g.numNodes(), 4);
+    EXPECT_EQ(g.numEdges(), 4);
+    EXPECT_EQ(&((*edgeMap[1])->incidentNode1()), &(*(*nodeMap[2])));
+    EXPECT_EQ(&((*edgeMap[1])->incidentNode2()), &(*(*nodeMap[0])));
+
+    auto& N2 = *(*nodeMap[2]);
+    auto iit = N2.incidentEdges().first;
+    EXPECT_EQ(*iit, edgeMap[1]);
+    iit++;
+    EXPECT_EQ(*iit, edgeMap[2]);
+    iit++;
+    EXPECT_EQ(*iit, edgeMap[3]);
+
+    // Round trip.
+    CompactGraph cg2;
+    cg2.build(g);
+    for (cg_index_t e = 0; e < cg.numEdges(); e++) {
+        EXPECT_EQ(cg2.incidentNode1(e), cg.incidentNode1(e));
+        EXPECT_EQ(cg2.incidentNode2(e), cg.incidentNode2(e));
+    }
+    EXPECT_EQ(mIncidence(cg2), mIncidence(cg));
+
+    EXPECT_THROW(cg.copyToGraph(g, nodeMap, edgeMap), std::invalid_argument);
+
+    edges.push_back(make_pair(4, 0));
+    EXPECT_THROW(cg.build(4, edges), std::invalid_argument);
+
+}
+
+
+/**  Connected decomposition against CompactGraph.
+ */
+TEST_F(CompactGraphTests, Test4) {
+
+    vector<pair<cg_index_t,cg_index_t>> edges;
+    edges.push_back(make_pair(0, 1));
+    edges.push_back(make_pair(3, 4));
+    edges.push_back(make_pair(1, 2));
+    edges.push_back(make_pair(4, 5));
+    edges.push_back(make_pair(5, 3));
+
+    CompactGraph cg;
+    cg.build(7, edges);
+
+    ConnectedDecomposer decomposer;
+    vector<vector<cg_index_t> > nodeSets;
+    vector<vector<cg_index_t> > edgeSets;
+    decomposer.decompose(cg, nodeSets, edgeSets);
+
+    ASSERT_EQ(nodeSets.size(), 3);
+    ASSERT_EQ(edgeSets.size(), 3);
+
+    vector<cg_index_t> nodes_01 = {0, 1, 2};
+    vector<cg_index_t> nodes_02 = {3, 4, 5};
+    vector<cg_index_t> nodes_03 = {6};
+    vector<cg_index_t> edges_01 = {0, 2};
+    vector<cg_index_t> edges_02 = {1, 4, 3};
+    EXPECT_EQ(nodeSets[0], nodes_01);
+    EXPECT_EQ(nodeSets[1], nodes_02);
+    EXPECT_EQ(nodeSets[2], nodes_03);
+    EXPECT_EQ(edgeSets[0], edges_01);
+    EXPECT_EQ(edgeSets[1], edges_02);
+    EXPECT_EQ(edgeSets[2].size(), 0);
+
+}
+
+} // namespace Undirected
+
+} // namespace Wailea
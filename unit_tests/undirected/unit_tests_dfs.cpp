@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "undirected/dfs.hpp"
+#include "undirected/static_dfs.hpp"
 
 namespace Wailea {
 
@@ -146,6 +147,50 @@ class DFSStrategySetNextEdge: public DFSStrategy <Graph,Node,Edge> {
 };
 
 
+/**  @brief records the hook calls as a sequence of numbers, and stops the
+ *          exploration after the given number of the calls if it is not 0.
+ */
+class DFSStrategyRecorder: public DFSStrategy <Graph,Node,Edge> {
+
+  public:
+    DFSStrategyRecorder(size_t earlyOutAfter = 0):
+        mEarlyOutAfter(earlyOutAfter){;}
+    virtual ~DFSStrategyRecorder(){;}
+
+    void enterNode(DNode& n) override { record(1, n, nullptr); }
+    void leaveNode(DNode& n) override { record(2, n, nullptr); }
+    void processFrond(DNode& n, DEdge& c) override { record(3, n, &c); }
+    void beforeVisitingChild(DNode& n, DEdge& c) override {
+        record(4, n, &c);
+    }
+    void afterVisitingChild(DNode& n, DEdge& c) override {
+        record(5, n, &c);
+    }
+    void notVisitingChild(DNode& n, DEdge& c) override { record(6, n, &c); }
+    bool isVisitingChild(DNode& n, DEdge& c) override {
+        // Skip every third candidate child.
+        mNumCandidates++;
+        return (mNumCandidates % 3) != 0;
+    }
+
+    vector<const void*> mRecord;
+
+  private:
+    void record(size_t type, DNode& n, DEdge* e)
+    {
+        mRecord.push_back(reinterpret_cast<const void*>(type));
+        mRecord.push_back(&n);
+        mRecord.push_back(e);
+        if (mEarlyOutAfter != 0 && mRecord.size() / 3 == mEarlyOutAfter) {
+            setEarlyOut();
+        }
+    }
+
+    size_t mEarlyOutAfter;
+    size_t mNumCandidates = 0;
+};
+
+
 /**  @brief DFS for a single node.
  */
 TEST_F(DFSTests, Test1) {
@@ -5310,6 +5355,82 @@ TEST_F(DFSTests, Test11) {
 
 }
 
+
+/**  @brief StaticDFSExplorer calls the hooks in the same order as
+ *          DFSExplorer, including setNextDFSEdge() and early out.
+ */
+TEST_F(DFSTests, Test12) {
+
+    std::unique_ptr<DGraph> gp1 = generate_graph();
+    DGraph&   g1 = *gp1;
+
+    const size_t numNodes = 50;
+    vector<DNode*> nodes;
+    for (size_t i = 0; i < numNodes; i++) {
+        nodes.push_back(&dynamic_cast<DNode&>(g1.addNode(generate_node())));
+    }
+    // A path to make it connected, chords, a multi-edge and a self-loop.
+    for (size_t i = 0; i + 1 < numNodes; i++) {
+        g1.addEdge(generate_edge(), *nodes[i], *nodes[i + 1]);
+    }
+    for (size_t i = 0; i < numNodes; i++) {
+        g1.addEdge(generate_edge(), *nodes[i], *nodes[(i * 7 + 3) % numNodes]);
+    }
+    g1.addEdge(generate_edge(), *nodes[3], *nodes[4]);
+    g1.addEdge(generate_edge(), *nodes[5], *nodes[5]);
+
+    for (size_t earlyOut : {0, 1, 17, 60}) {
+
+        DFSStrategyRecorder dstr1(earlyOut);
+        DExplorer dexpr1(g1, dstr1);
+        dexpr1.reset(g1);
+        dexpr1.run(*nodes[7]);
+
+        DFSStrategyRecorder dstr2(earlyOut);
+        StaticDFSExplorer<Graph,Node,Edge,DFSStrategyRecorder>
+                                                          dexpr2(g1, dstr2);
+        dexpr2.reset(g1);
+        dexpr2.run(*nodes[7]);
+
+        EXPECT_EQ(dstr1.mRecord.empty(), false);
+        EXPECT_EQ(dstr1.mRecord, dstr2.mRecord);
+        if (earlyOut != 0) {
+            EXPECT_EQ(dstr2.mRecord.size(), earlyOut * 3);
+        }
+    }
+
+    // setNextDFSEdge() from the hooks.
+    auto& n1 = *nodes[0];
+    auto  it = n1.incidentEdges().first;
+    it++;
+
+    DFSStrategySetNextEdge dstr3;
+    DExplorer dexpr3(g1, dstr3);
+    dexpr3.reset(g1);
+    dstr3.setNextEdgeAtNextCall(n1.backIt(), it);
+    dexpr3.run(n1);
+    vector<node_incidence_it_t> visiting3;
+    for (auto n : nodes) {
+        visiting3.push_back(edgeVisiting(*n));
+    }
+
+    DFSStrategySetNextEdge dstr4;
+    StaticDFSExplorer<Graph,Node,Edge,DFSStrategySetNextEdge>
+                                                          dexpr4(g1, dstr4);
+    dexpr4.reset(g1);
+    dstr4.setNextEdgeAtNextCall(n1.backIt(), it);
+    dexpr4.run(n1);
+    for (size_t i = 0; i < numNodes; i++) {
+        EXPECT_EQ(edgeVisiting(*nodes[i]), visiting3[i]);
+        EXPECT_EQ(visited(*nodes[i]), true);
+    }
+    EXPECT_EQ(dstr3.enterNodeCnt,          dstr4.enterNodeCnt);
+    EXPECT_EQ(dstr3.leaveNodeCnt,          dstr4.leaveNodeCnt);
+    EXPECT_EQ(dstr3.processFrondCnt,       dstr4.processFrondCnt);
+    EXPECT_EQ(dstr3.beforeVisitingChildCnt,dstr4.beforeVisitingChildCnt);
+    EXPECT_EQ(dstr3.afterVisitingChildCnt, dstr4.afterVisitingChildCnt);
+}
+
 } // namespace Undirected
 
 } // namespace Tarjan
@@ -0,0 +1,252 @@
+#include "gtest/gtest.h"
+#include "undirected/element_pool.hpp"
+#include "undirected/base.hpp"
+#include "undirected/st_numbering.hpp"
+#include "undirected/bl_planarity_tester.hpp"
+
+namespace Wailea {
+
+namespace Undirected {
+
+class ElementPoolTests : public ::testing::Test {
+
+  protected:
+
+    ElementPoolTests(){;};
+    virtual ~ElementPoolTests(){;};
+    virtual void SetUp() {;};
+    virtual void TearDown() {;};
+
+    size_t sizeClass(size_t size) {
+        return ElementPool::sizeClass(size);
+    }
+
+    size_t arenaChunks(ElementArena& arena) {
+        return arena.mChunks.size();
+    }
+
+};
+
+
+/**  Size classes
+ */
+TEST_F(ElementPoolTests, Test1) {
+
+    EXPECT_EQ(sizeClass(1),   0);
+    EXPECT_EQ(sizeClass(16),  0);
+    EXPECT_EQ(sizeClass(17),  1);
+    EXPECT_EQ(sizeClass(32),  1);
+    EXPECT_EQ(sizeClass(512), ElementPool::kNumClasses - 1);
+
+}
+
+
+/**  A freed block is reused for the next request of the same size class,
+ *   and the blocks of different size classes do not alias.
+ */
+TEST_F(ElementPoolTests, Test2) {
+
+    void* p1 = ElementPool::allocate(40);
+    void* p2 = ElementPool::allocate(40);
+    void* p3 = ElementPool::allocate(100);
+    EXPECT_NE(p1, p2);
+    EXPECT_NE(p1, p3);
+    EXPECT_NE(p2, p3);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p1) % ElementPool::kGranularity, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p3) % ElementPool::kGranularity, 0);
+
+    ElementPool::deallocate(p2, 40);
+    void* p4 = ElementPool::allocate(48);
+    EXPECT_EQ(p4, p2);
+
+    ElementPool::deallocate(p3, 100);
+    void* p5 = ElementPool::allocate(40);
+    EXPECT_NE(p5, p3);
+
+    ElementPool::deallocate(p1, 40);
+    ElementPool::deallocate(p4, 48);
+    ElementPool::deallocate(p5, 40);
+    ElementPool::deallocate(nullptr, 40);
+
+    // Larger than kMaxPooledSize goes to the global operator.
+    void* p6 = ElementPool::allocate(ElementPool::kMaxPooledSize + 1);
+    EXPECT_NE(p6, nullptr);
+    ElementPool::deallocate(p6, ElementPool::kMaxPooledSize + 1);
+
+}
+
+
+/**  Working graph elements are recycled through the pool, and the number of
+ *   chunks does not grow when a graph of the same size is rebuilt.
+ */
+TEST_F(ElementPoolTests, Test3) {
+
+    {
+        auto np = make_unique<ST_DFS_Node>();
+        Node* addr = np.get();
+        np = nullptr;
+        auto np2 = make_unique<ST_DFS_Node>();
+        EXPECT_EQ(np2.get(), addr);
+    }
+
+    const size_t numNodes = 5000;
+    size_t numChunksAfterFirst = 0;
+    for (size_t round = 0; round < 3; round++) {
+
+        Graph g;
+        vector<node_list_it_t> nodes;
+        for (size_t i = 0; i < numNodes; i++) {
+            auto& N = g.addNode(make_unique<BLGraphNode>());
+            nodes.push_back(N.backIt());
+        }
+        for (size_t i = 0; i + 1 < numNodes; i++) {
+            g.addEdge(make_unique<BLGraphEdge>(),
+                      *(*nodes[i]), *(*nodes[i+1]));
+        }
+        EXPECT_EQ(g.numNodes(), numNodes);
+        EXPECT_EQ(g.numEdges(), numNodes - 1);
+
+        auto& E = dynamic_cast<BLGraphEdge&>(*(*g.edges().first));
+        EXPECT_EQ(&(E.incidentNode1()), &(*(*nodes[0])));
+
+        if (round == 0) {
+            numChunksAfterFirst = ElementPool::numChunks();
+        }
+        else {
+            EXPECT_EQ(ElementPool::numChunks(), numChunksAfterFirst);
+        }
+    }
+
+}
+
+
+/**  In an arena scope, the elements and the list cells of a graph come from
+ *   the arena. Freeing them does not return them to the free lists, and the
+ *   chunks of the free lists do not grow.
+ */
+TEST_F(ElementPoolTests, Test4) {
+
+    // Warm up the free lists of this thread.
+    {
+        Graph g;
+        auto& N1 = g.addNode(make_unique<BLGraphNode>());
+        auto& N2 = g.addNode(make_unique<BLGraphNode>());
+        g.addEdge(make_unique<BLGraphEdge>(), N1, N2);
+    }
+    const size_t numChunksBefore = ElementPool::numChunks();
+
+    const size_t numNodes = 5000;
+    ElementArena arena;
+    EXPECT_EQ(arenaChunks(arena), 0);
+    {
+        Graph g;
+        {
+            ElementArena::Scope scope(arena);
+            vector<node_list_it_t> nodes;
+            for (size_t i = 0; i < numNodes; i++) {
+                auto& N = g.addNode(make_unique<BLGraphNode>());
+                nodes.push_back(N.backIt());
+            }
+            for (size_t i = 0; i + 1 < numNodes; i++) {
+                g.addEdge(make_unique<BLGraphEdge>(),
+                          *(*nodes[i]), *(*nodes[i+1]));
+            }
+        }
+        EXPECT_GT(arenaChunks(arena), 1);
+        EXPECT_EQ(ElementPool::numChunks(), numChunksBefore);
+
+        // Outside the scope, the requests go to the free lists again, and
+        // a block freed from the arena is not handed out.
+        auto np = g.removeNode(*(*g.nodes().first));
+        Node* addr = np.get();
+        np = nullptr;
+        auto np2 = make_unique<BLGraphNode>();
+        EXPECT_NE(np2.get(), addr);
+
+        // A list can hold the cells from both.
+        auto& N = g.addNode(std::move(np2));
+        auto& M = *(*g.nodes().first);
+        g.addEdge(make_unique<BLGraphEdge>(), N, M);
+        EXPECT_EQ(g.numNodes(), numNodes);
+        EXPECT_EQ(g.numEdges(), numNodes - 1);
+        EXPECT_EQ(M.degree(), 2);
+    }
+    EXPECT_EQ(ElementPool::numChunks(), numChunksBefore);
+
+}
+
+
+/**  The scopes nest, and the innermost arena receives the requests.
+ */
+TEST_F(ElementPoolTests, Test5) {
+
+    ElementArena outer;
+    ElementArena inner;
+    {
+        ElementArena::Scope scope1(outer);
+        void* p1 = ElementPool::allocate(40);
+        {
+            ElementArena::Scope scope2(inner);
+            void* p2 = ElementPool::allocate(40);
+            EXPECT_EQ(arenaChunks(inner), 1);
+            ElementPool::deallocate(p2, 40);
+        }
+        void* p3 = ElementPool::allocate(40);
+        EXPECT_EQ(reinterpret_cast<char*>(p3),
+                  reinterpret_cast<char*>(p1) + 48);
+        EXPECT_EQ(arenaChunks(outer), 1);
+        ElementPool::deallocate(p1, 40);
+        ElementPool::deallocate(p3, 40);
+    }
+    EXPECT_EQ(arenaChunks(outer), 1);
+    EXPECT_EQ(arenaChunks(inner), 1);
+
+    // Outside the scopes, the free lists serve the requests again.
+    void* p4 = ElementPool::allocate(40);
+    ElementPool::deallocate(p4, 40);
+    void* p5 = ElementPool::allocate(40);
+    EXPECT_EQ(p4, p5);
+    ElementPool::deallocate(p5, 40);
+
+}
+
+
+/**  The list cells of node_list_t, edge_list_t, and node_incidence_t are
+ *   recycled through the free lists.
+ */
+TEST_F(ElementPoolTests, Test6) {
+
+    node_incidence_t incidence;
+    incidence.push_back(edge_list_it_t());
+    const edge_list_it_t* addr = &(*incidence.begin());
+    incidence.clear();
+    incidence.push_back(edge_list_it_t());
+    EXPECT_EQ(&(*incidence.begin()), addr);
+
+    const size_t numNodes = 5000;
+    size_t numChunksAfterFirst = 0;
+    for (size_t round = 0; round < 3; round++) {
+
+        Graph g;
+        vector<node_list_it_t> nodes;
+        for (size_t i = 0; i < numNodes; i++) {
+            auto& N = g.addNode(make_unique<Node>());
+            nodes.push_back(N.backIt());
+        }
+        for (size_t i = 0; i + 1 < numNodes; i++) {
+            g.addEdge(make_unique<Edge>(), *(*nodes[i]), *(*nodes[i+1]));
+        }
+        if (round == 0) {
+            numChunksAfterFirst = ElementPool::numChunks();
+        }
+        else {
+            EXPECT_EQ(ElementPool::numChunks(), numChunksAfterFirst);
+        }
+    }
+
+}
+
+
+} // namespace Undirected
+
+} // namespace Wailea
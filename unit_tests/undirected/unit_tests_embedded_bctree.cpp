@@ -3030,6 +3030,118 @@ TEST_F(EmbeddedBCTreeTests, MultipleUGs) {
 }
 
 
+/**  @brief blocks embedded concurrently give the same embedding and the
+ *          same unification groups as the sequential run.
+ */
+TEST_F(EmbeddedBCTreeTests, ParallelBlocks) {
+
+    // Chain of wheels of various sizes. Each wheel shares a rim node with
+    // the previous one, and every fourth one also has a pendant edge and a
+    // triangle hanging from its hub.
+    auto  gp1 = generate_graph();
+    auto& g1  = *gp1;
+    long  num = 0;
+    auto addNode = [&]() -> Node& {
+        return g1.addNode(generate_node(num++));
+    };
+    auto addEdge = [&](Node& n1, Node& n2) {
+        g1.addEdge(generate_edge(), n1, n2);
+    };
+
+    Node* shared = &addNode();
+    for (size_t i = 0; i < 40; i++) {
+        size_t        rimSize = 3 + (i * 7) % 11;
+        Node&         hub     = addNode();
+        vector<Node*> rim;
+        rim.push_back(shared);
+        for (size_t j = 1; j < rimSize; j++) {
+            rim.push_back(&addNode());
+        }
+        for (size_t j = 0; j < rimSize; j++) {
+            addEdge(*rim[j], *rim[(j + 1) % rimSize]);
+            addEdge(hub, *rim[j]);
+        }
+        if (i % 4 == 0) {
+            Node& p  = addNode();
+            addEdge(hub, p);
+            Node& t1 = addNode();
+            Node& t2 = addNode();
+            addEdge(hub, t1);
+            addEdge(t1, t2);
+            addEdge(t2, hub);
+        }
+        shared = rim[rimSize / 2];
+    }
+
+    auto signature = [](EmbeddedBCTree& ebcT) {
+        vector<long> sig;
+        for (auto nit = ebcT.nodes().first; nit != ebcT.nodes().second;
+                                                                      nit++) {
+            auto& ETN = dynamic_cast<EmbeddedBCTreeNode&>(*(*nit));
+            if (ETN.type() == BCTreeNode::BlockType) {
+                auto& EG = ETN.embeddedGraph();
+                sig.push_back(EG.numNodes());
+                sig.push_back(ETN.dualGraph().numNodes());
+                for (auto enit  = EG.nodes().first;
+                          enit != EG.nodes().second; enit++) {
+                    auto& EN = dynamic_cast<EmbeddedNode&>(*(*enit));
+                    auto& BN = dynamic_cast<BlockNode&>(
+                                                       EN.IGBackwardLinkRef());
+                    auto& N  = dynamic_cast<NumNode&>(BN.IGBackwardLinkRef());
+                    sig.push_back(N.num());
+                    for (auto eit  = EN.incidentEdges().first;
+                              eit != EN.incidentEdges().second; eit++) {
+                        auto& A  = (*(*eit))->adjacentNode(EN);
+                        auto& AB = dynamic_cast<BlockNode&>(
+                                                        A.IGBackwardLinkRef());
+                        sig.push_back(dynamic_cast<NumNode&>(
+                                              AB.IGBackwardLinkRef()).num());
+                    }
+                }
+            }
+            else {
+                sig.push_back(-1);
+                for (size_t i = 0; i < ETN.numUnificationGroups(); i++) {
+                    auto& UG = ETN.unificationGroup(i);
+                    sig.push_back(UG.size());
+                    for (size_t j = 0; j < UG.size(); j++) {
+                        auto& UF = UG.at(j);
+                        sig.push_back(UF.faceInDG().degree());
+                        auto& EN = UF.cutVertexInEG();
+                        auto& A  = UF.edgeCWInEG().adjacentNode(EN);
+                        auto& AB = dynamic_cast<BlockNode&>(
+                                                        A.IGBackwardLinkRef());
+                        sig.push_back(dynamic_cast<NumNode&>(
+                                              AB.IGBackwardLinkRef()).num());
+                    }
+                }
+            }
+        }
+        return sig;
+    };
+
+    BiconnectedDecomposer decomp1;
+    BCTree                bcT1 = decomp1.decompose(g1);
+    EmbeddedBCTree        ebcT1(bcT1);
+    ebcT1.makeDefaultEmbedding();
+    auto                  sig1 = signature(ebcT1);
+    EXPECT_EQ(bcT1.numNodes() > 100, true);
+    ebcT1.findGeometricEmbedding();
+    auto                  expSize1 = ebcT1.explorationTree().numNodes();
+
+    for (size_t numThreads : {0, 2, 3, 8}) {
+        BiconnectedDecomposer decomp2;
+        BCTree                bcT2 = decomp2.decompose(g1);
+        EmbeddedBCTree        ebcT2(bcT2);
+        ebcT2.makeDefaultEmbedding(numThreads);
+        EXPECT_EQ(signature(ebcT2), sig1);
+
+        ebcT2.findGeometricEmbedding();
+        EXPECT_EQ(ebcT2.explorationTree().numNodes(), expSize1);
+    }
+}
+
+
 // /**  @brief realistic example
 //  */
 // TEST_F(EmbeddedBCTreeTests, Realistic1) {
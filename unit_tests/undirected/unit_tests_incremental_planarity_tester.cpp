@@ -0,0 +1,266 @@
+#include "gtest/gtest.h"
+#include "undirected/incremental_planarity_tester.hpp"
+#include "undirected/bl_planarity_tester.hpp"
+#include "undirected/st_numbering.hpp"
+
+namespace Wailea {
+
+namespace Undirected {
+
+class IncrementalPlanarityTesterTests : public ::testing::Test {
+
+  protected:
+
+    IncrementalPlanarityTesterTests(){;};
+    virtual ~IncrementalPlanarityTesterTests(){;};
+    virtual void SetUp() {;};
+    virtual void TearDown() {;};
+
+    size_t numFaces(IncrementalPlanarityTester& tester) {
+        return tester.mNumFaces;
+    }
+
+    /** @brief checks |N| - |E| + |F| = 2 and that every side of every edge
+     *         is on the face with its label.
+     */
+    void checkFaces(IncrementalPlanarityTester& tester, Graph& g) {
+
+        EXPECT_EQ(g.numNodes() + numFaces(tester), g.numEdges() + 2);
+        EXPECT_EQ(tester.mFaces.size(), 2 * g.numEdges());
+        vector<size_t> faceSizes(numFaces(tester), 0);
+        for (size_t h = 0; h < tester.mFaces.size(); h++) {
+            EXPECT_EQ(tester.mFaces[tester.nextHalfEdge(h)],
+                      tester.mFaces[h]);
+            faceSizes[tester.mFaces[h]]++;
+        }
+        for (auto s : faceSizes) {
+            EXPECT_GE(s, 3);
+        }
+    }
+
+    void makeCycle(Graph& g, vector<node_list_it_t>& nodes, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            nodes.push_back(g.addNode(make_unique<Node>()).backIt());
+        }
+        for (size_t i = 0; i < n; i++) {
+            g.addEdge(make_unique<Edge>(),
+                      *(*nodes[i]), *(*nodes[(i + 1) % n]));
+        }
+    }
+
+    bool isAdjacent(Node& n1, Node& n2) {
+        for (auto iit  = n1.incidentEdges().first;
+                  iit != n1.incidentEdges().second; iit++) {
+            if (&((*(*(*iit))).adjacentNode(n1)) == &n2) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+};
+
+
+/**  Chords of a cycle of 6 nodes. The first one goes into the inner face,
+ *   the second one into the outer face, and the third one, which would make
+ *   K3,3, is rejected by the full test.
+ */
+TEST_F(IncrementalPlanarityTesterTests, Test1) {
+
+    Graph g;
+    vector<node_list_it_t> n;
+    makeCycle(g, n, 6);
+    size_t utilitySize = (*g.edges().first)->utilitySize();
+
+    STNumbering st;
+    vector<node_list_it_t> stOrder =
+                          st.getBipolarOrientation(g, *(*n[0]), *(*n[1]));
+
+    IncrementalPlanarityTester tester;
+    tester.initialize(g, stOrder);
+    EXPECT_EQ(numFaces(tester), 2);
+    EXPECT_EQ(tester.isTriconnected(), false);
+    checkFaces(tester, g);
+
+    EXPECT_EQ(tester.insertEdgeIfPlanar(
+                            make_unique<Edge>(), *(*n[0]), *(*n[3])), true);
+    EXPECT_EQ(tester.numFullTests(), 0);
+    EXPECT_EQ(g.numEdges(), 7);
+    checkFaces(tester, g);
+
+    EXPECT_EQ(tester.insertEdgeIfPlanar(
+                            make_unique<Edge>(), *(*n[1]), *(*n[4])), true);
+    EXPECT_EQ(tester.numFullTests(), 0);
+    EXPECT_EQ(g.numEdges(), 8);
+    checkFaces(tester, g);
+
+    edge_ptr_t ep = make_unique<Edge>();
+    Edge* addr = ep.get();
+    EXPECT_EQ(tester.insertEdgeIfPlanar(
+                                 std::move(ep), *(*n[2]), *(*n[5])), false);
+    EXPECT_EQ(tester.numFullTests(), 1);
+    EXPECT_EQ(g.numEdges(), 8);
+    EXPECT_EQ(ep.get(), addr);
+    checkFaces(tester, g);
+
+    tester.cleanUp();
+    for (auto eit = g.edges().first; eit != g.edges().second; eit++) {
+        EXPECT_EQ((*eit)->utilitySize(), utilitySize);
+    }
+
+}
+
+
+/**  On the cube, which is triconnected, the edges are accepted or
+ *   rejected without a full test.
+ */
+TEST_F(IncrementalPlanarityTesterTests, Test2) {
+
+    Graph g;
+    vector<node_list_it_t> n;
+    for (size_t i = 0; i < 8; i++) {
+        n.push_back(g.addNode(make_unique<Node>()).backIt());
+    }
+    // Node i and node i^1, i^2, i^4 are adjacent.
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t b = 1; b < 8; b <<= 1) {
+            if (i < (i ^ b)) {
+                g.addEdge(make_unique<Edge>(), *(*n[i]), *(*n[i ^ b]));
+            }
+        }
+    }
+
+    STNumbering st;
+    vector<node_list_it_t> stOrder =
+                          st.getBipolarOrientation(g, *(*n[0]), *(*n[1]));
+
+    IncrementalPlanarityTester tester;
+    tester.initialize(g, stOrder);
+    EXPECT_EQ(numFaces(tester), 6);
+    EXPECT_EQ(tester.isTriconnected(), true);
+    checkFaces(tester, g);
+
+    // Antipodal nodes.
+    EXPECT_EQ(tester.insertEdgeIfPlanar(
+                            make_unique<Edge>(), *(*n[0]), *(*n[7])), false);
+    // Diagonal of the face {0,1,3,2}.
+    EXPECT_EQ(tester.insertEdgeIfPlanar(
+                            make_unique<Edge>(), *(*n[0]), *(*n[3])), true);
+    // Diagonal of the same face that crosses the one above.
+    EXPECT_EQ(tester.insertEdgeIfPlanar(
+                            make_unique<Edge>(), *(*n[1]), *(*n[2])), false);
+    // Diagonal of the face {4,5,7,6}.
+    EXPECT_EQ(tester.insertEdgeIfPlanar(
+                            make_unique<Edge>(), *(*n[5]), *(*n[6])), true);
+
+    EXPECT_EQ(tester.numFullTests(), 0);
+    EXPECT_EQ(g.numEdges(), 14);
+    checkFaces(tester, g);
+    tester.cleanUp();
+
+}
+
+
+/**  Random edges on a cycle against a full BL test per edge.
+ */
+TEST_F(IncrementalPlanarityTesterTests, Test3) {
+
+    for (unsigned long long seed = 1; seed <= 5; seed++) {
+
+        const size_t numNodes = 40;
+
+        Graph g1;
+        vector<node_list_it_t> n1;
+        makeCycle(g1, n1, numNodes);
+        STNumbering st;
+        vector<node_list_it_t> stOrder1 =
+                        st.getBipolarOrientation(g1, *(*n1[0]), *(*n1[1]));
+
+        Graph g2;
+        vector<node_list_it_t> n2;
+        makeCycle(g2, n2, numNodes);
+        vector<node_list_it_t> stOrder2 =
+                        st.getBipolarOrientation(g2, *(*n2[0]), *(*n2[1]));
+
+        IncrementalPlanarityTester tester;
+        tester.initialize(g2, stOrder2);
+        BLPlanarityTester bl;
+
+        size_t numQueries = 0;
+        unsigned long long r = seed;
+        for (size_t k = 0; k < 400; k++) {
+
+            r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+            size_t i = (r >> 33) % numNodes;
+            r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+            size_t j = (r >> 33) % numNodes;
+            if (i == j || isAdjacent(*(*n1[i]), *(*n1[j]))) {
+                continue;
+            }
+            numQueries++;
+
+            auto& E = g1.addEdge(make_unique<Edge>(), *(*n1[i]), *(*n1[j]));
+            bool expected = bl.isPlanar(g1, stOrder1);
+            if (!expected) {
+                g1.removeEdge(E);
+            }
+
+            bool actual = tester.insertEdgeIfPlanar(
+                                  make_unique<Edge>(), *(*n2[i]), *(*n2[j]));
+            EXPECT_EQ(actual, expected);
+            EXPECT_EQ(g2.numEdges(), g1.numEdges());
+        }
+        EXPECT_GT(g2.numEdges(), 2 * numNodes);
+        EXPECT_LT(tester.numFullTests(), numQueries);
+        checkFaces(tester, g2);
+        tester.cleanUp();
+    }
+
+}
+
+
+/**  K2,4. In any embedding two pairs of the four middle nodes are not on a
+ *   common face, and the edges between them are added after a full test.
+ */
+TEST_F(IncrementalPlanarityTesterTests, Test4) {
+
+    size_t numFullTests = 0;
+    for (size_t i = 1; i <= 4; i++) {
+        for (size_t j = i + 1; j <= 4; j++) {
+
+            Graph g;
+            vector<node_list_it_t> n;
+            for (size_t k = 0; k < 6; k++) {
+                n.push_back(g.addNode(make_unique<Node>()).backIt());
+            }
+            for (size_t k = 1; k <= 4; k++) {
+                g.addEdge(make_unique<Edge>(), *(*n[0]), *(*n[k]));
+                g.addEdge(make_unique<Edge>(), *(*n[k]), *(*n[5]));
+            }
+
+            STNumbering st;
+            vector<node_list_it_t> stOrder =
+                          st.getBipolarOrientation(g, *(*n[0]), *(*n[5]));
+
+            IncrementalPlanarityTester tester;
+            tester.initialize(g, stOrder);
+            EXPECT_EQ(numFaces(tester), 4);
+            EXPECT_EQ(tester.isTriconnected(), false);
+
+            EXPECT_EQ(tester.insertEdgeIfPlanar(
+                            make_unique<Edge>(), *(*n[i]), *(*n[j])), true);
+            EXPECT_EQ(g.numEdges(), 9);
+            checkFaces(tester, g);
+
+            numFullTests += tester.numFullTests();
+            tester.cleanUp();
+        }
+    }
+    EXPECT_EQ(numFullTests, 2);
+
+}
+
+
+} // namespace Undirected
+
+} // namespace Wailea
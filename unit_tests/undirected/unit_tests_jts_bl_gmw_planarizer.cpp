@@ -1671,6 +1671,284 @@ TEST_F(JTS_BL_GMW_PlanarizerTests, Test12) {
 
 }
 
+/**  @brief tests maximalizePlanarSubgraph() on K8 with some edges of the
+ *          planar subgraph removed against inserting the removed edges
+ *          one by one.
+ */
+TEST_F(JTS_BL_GMW_PlanarizerTests, Test13) {
+
+    const size_t numNodes = 8;
+
+    auto prepare = [&](
+        Graph&                  g,
+        PlanarizableGraph&      pg,
+        vector<edge_list_it_t>& removedEdges,
+        vector<edge_list_it_t>& edgesInOrder
+    ) {
+        vector<node_list_it_t> nodes;
+        for (size_t i = 0; i < numNodes; i++) {
+            nodes.push_back(g.addNode(make_unique<NumNode>(i+1)).backIt());
+        }
+        for (size_t i = 0; i < numNodes; i++) {
+            for (size_t j = i + 1; j < numNodes; j++) {
+                edgesInOrder.push_back(g.addEdge(make_unique<Edge>(),
+                                       *(*nodes[i]), *(*nodes[j])).backIt());
+            }
+        }
+
+        JTS_BL_GMW_Planarizer planarizer;
+        findPlanarSubgraph(planarizer, g, pg, removedEdges);
+
+        // Remove every 4th edge from the planar subgraph.
+        vector<edge_list_it_t> toBeRemoved;
+        size_t index = 0;
+        for (auto eit = pg.edges().first; eit != pg.edges().second; eit++) {
+            if (index++ % 4 == 1) {
+                toBeRemoved.push_back(eit);
+            }
+        }
+        for (auto peit : toBeRemoved) {
+            auto& PE = dynamic_cast<PlanarizableEdge&>(*(*peit));
+            auto  eit = PE.IGBackwardLink();
+            auto& E = *(*eit);
+            E.setIGForwardLink(pg.edges().second);
+            E.setUtility(JTSPlanarizer::kForwardTypeRemoved);
+            pg.removeEdge(PE);
+            removedEdges.push_back(eit);
+        }
+    };
+
+    auto indexOf = [](
+        vector<edge_list_it_t>& edgesInOrder,
+        edge_list_it_t          eit
+    ) {
+        for (size_t i = 0; i < edgesInOrder.size(); i++) {
+            if (edgesInOrder[i] == eit) {
+                return i;
+            }
+        }
+        return edgesInOrder.size();
+    };
+
+    // Reference: insert one by one.
+    Graph                  g_1;
+    PlanarizableGraph      pg_1;
+    vector<edge_list_it_t> removedEdges_1;
+    vector<edge_list_it_t> edgesInOrder_1;
+    prepare(g_1, pg_1, removedEdges_1, edgesInOrder_1);
+
+    auto& S_1 = (*(g_1.nodes().first))->IGForwardLinkRef();
+    auto& T_1 = (*(std::next(g_1.nodes().first)))->IGForwardLinkRef();
+    STNumbering st;
+    vector<node_list_it_t> stOrder_1 =
+                                    st.getBipolarOrientation(pg_1, S_1, T_1);
+
+    vector<size_t> expectedRemoved;
+    for (auto eit : removedEdges_1) {
+        auto& E  = *(*eit);
+        auto& N1 = E.incidentNode1().IGForwardLinkRef();
+        auto& N2 = E.incidentNode2().IGForwardLinkRef();
+        auto& Etry = pg_1.addEdge(make_unique<PlanarizableEdge>(), N1, N2);
+        BLPlanarityTester bl;
+        if (!bl.isPlanar(pg_1, stOrder_1)) {
+            pg_1.removeEdge(Etry);
+            expectedRemoved.push_back(indexOf(edgesInOrder_1, eit));
+        }
+    }
+
+    // Batched insertion.
+    Graph                  g_2;
+    PlanarizableGraph      pg_2;
+    vector<edge_list_it_t> removedEdges_2;
+    vector<edge_list_it_t> edgesInOrder_2;
+    prepare(g_2, pg_2, removedEdges_2, edgesInOrder_2);
+
+    JTS_BL_GMW_Planarizer  planarizer;
+    maximalizePlanarSubgraph(planarizer, g_2, pg_2, removedEdges_2);
+
+    vector<size_t> actualRemoved;
+    for (auto eit : removedEdges_2) {
+        actualRemoved.push_back(indexOf(edgesInOrder_2, eit));
+    }
+
+    EXPECT_EQ(actualRemoved, expectedRemoved);
+    EXPECT_EQ(pg_2.numEdges(), pg_1.numEdges());
+    EXPECT_EQ(pg_2.numEdges() + removedEdges_2.size(), g_2.numEdges());
+
+    for (auto eit = g_2.edges().first; eit != g_2.edges().second; eit++) {
+        auto& E = *(*eit);
+        if (E.utility() == JTSPlanarizer::kForwardTypeInPlanarSubgraph) {
+            auto& PE = dynamic_cast<PlanarizableEdge&>(E.IGForwardLinkRef());
+            EXPECT_EQ(PE.IGBackwardLink(), eit);
+        }
+    }
+
+    auto& S_2 = (*(g_2.nodes().first))->IGForwardLinkRef();
+    auto& T_2 = (*(std::next(g_2.nodes().first)))->IGForwardLinkRef();
+    vector<node_list_it_t> stOrder_2 =
+                                    st.getBipolarOrientation(pg_2, S_2, T_2);
+    BLPlanarityTester bl;
+    EXPECT_EQ(bl.isPlanar(pg_2, stOrder_2), true);
+
+}
+
+
+/**  @brief tests SPECULATIVE_BATCH insertion on K9.
+ *          The result must be planar, must represent all the edges of the
+ *          input, and must not depend on the number of threads.
+ */
+TEST_F(JTS_BL_GMW_PlanarizerTests, Test14) {
+
+    const size_t numNodes = 9;
+
+    auto planarize = [&](
+        Graph&             g,
+        PlanarizableGraph& pg,
+        size_t             numThreads,
+        size_t             batchSize
+    ) {
+        vector<node_list_it_t> nodes;
+        for (size_t i = 0; i < numNodes; i++) {
+            nodes.push_back(g.addNode(make_unique<NumNode>(i+1)).backIt());
+        }
+        for (size_t i = 0; i < numNodes; i++) {
+            for (size_t j = i + 1; j < numNodes; j++) {
+                g.addEdge(make_unique<Edge>(), *(*nodes[i]), *(*nodes[j]));
+            }
+        }
+        JTS_BL_GMW_Planarizer planarizer;
+        planarizer.setInsertionMode(
+            JTS_BL_GMW_Planarizer::SPECULATIVE_BATCH, numThreads, batchSize);
+        planarizer.planarizeBiconnectedGraph(g, pg);
+    };
+
+    auto numVirtualNodes = [](PlanarizableGraph& pg) {
+        size_t cnt = 0;
+        for (auto nit = pg.nodes().first; nit != pg.nodes().second; nit++) {
+            auto& N = dynamic_cast<PlanarizableNode&>(*(*nit));
+            if (N.isVirtual()) {
+                cnt++;
+            }
+        }
+        return cnt;
+    };
+
+    auto check = [&](Graph& g, PlanarizableGraph& pg) {
+
+        size_t numVirtual = numVirtualNodes(pg);
+        EXPECT_EQ(pg.numNodes(), numNodes + numVirtual);
+        EXPECT_EQ(pg.numEdges(), g.numEdges() + 2 * numVirtual);
+
+        // Every edge of g is represented by at least one edge in pg.
+        g.pushDefaultUtilityToEdges();
+        for (auto eit = pg.edges().first; eit != pg.edges().second; eit++) {
+            auto& PE = dynamic_cast<PlanarizableEdge&>(*(*eit));
+            (*(PE.IGBackwardLink()))->setUtility(1);
+        }
+        for (auto eit = g.edges().first; eit != g.edges().second; eit++) {
+            EXPECT_EQ((*eit)->utility(), 1);
+        }
+        g.popUtilityFromEdges();
+
+        auto& S = (*(g.nodes().first))->IGForwardLinkRef();
+        auto& T = (*(std::next(g.nodes().first)))->IGForwardLinkRef();
+        STNumbering st;
+        vector<node_list_it_t> stOrder = st.getBipolarOrientation(pg, S, T);
+        BLPlanarityTester bl;
+        EXPECT_EQ(bl.isPlanar(pg, stOrder), true);
+    };
+
+    Graph             g_1;
+    PlanarizableGraph pg_1;
+    planarize(g_1, pg_1, 1, 0);
+    check(g_1, pg_1);
+
+    Graph             g_2;
+    PlanarizableGraph pg_2;
+    planarize(g_2, pg_2, 4, 0);
+    check(g_2, pg_2);
+
+    EXPECT_EQ(pg_2.numNodes(), pg_1.numNodes());
+    EXPECT_EQ(pg_2.numEdges(), pg_1.numEdges());
+
+    // Small batches force many rounds.
+    Graph             g_3;
+    PlanarizableGraph pg_3;
+    planarize(g_3, pg_3, 3, 2);
+    check(g_3, pg_3);
+
+}
+
+
+/**  @brief tests planarizeConnectedGraph() with the blocks processed by
+ *          multiple threads. Three K7 are joined at cut vertices. The result
+ *          must not depend on the number of threads.
+ */
+TEST_F(JTS_BL_GMW_PlanarizerTests, Test15) {
+
+    const size_t numNodes  = 7;
+    const size_t numBlocks = 3;
+
+    auto planarize = [&](
+        Graph&             g,
+        PlanarizableGraph& pg,
+        size_t             numThreads
+    ) {
+        node_list_it_t cv = g.nodes().second;
+        for (size_t b = 0; b < numBlocks; b++) {
+            vector<node_list_it_t> nodes;
+            if (cv != g.nodes().second) {
+                nodes.push_back(cv);
+            }
+            while (nodes.size() < numNodes) {
+                nodes.push_back(g.addNode(
+                     make_unique<NumNode>(g.numNodes() + 1)).backIt());
+            }
+            for (size_t i = 0; i < numNodes; i++) {
+                for (size_t j = i + 1; j < numNodes; j++) {
+                    g.addEdge(make_unique<Edge>(),
+                                            *(*nodes[i]), *(*nodes[j]));
+                }
+            }
+            cv = nodes[numNodes - 1];
+        }
+        JTS_BL_GMW_Planarizer planarizer;
+        planarizer.setNumBlockThreads(numThreads);
+        planarizer.planarizeConnectedGraph(g, pg);
+    };
+
+    auto edgeEnds = [](PlanarizableGraph& pg) {
+        vector<pair<long, long>> ends;
+        for (auto eit = pg.edges().first; eit != pg.edges().second; eit++) {
+            auto& PE  = dynamic_cast<PlanarizableEdge&>(*(*eit));
+            auto& PN1 = dynamic_cast<PlanarizableNode&>(PE.incidentNode1());
+            auto& PN2 = dynamic_cast<PlanarizableNode&>(PE.incidentNode2());
+            long  n1  = PN1.isVirtual() ? -1 :
+                  dynamic_cast<NumNode&>(PN1.IGBackwardLinkRef()).num();
+            long  n2  = PN2.isVirtual() ? -1 :
+                  dynamic_cast<NumNode&>(PN2.IGBackwardLinkRef()).num();
+            ends.push_back(make_pair(n1, n2));
+        }
+        return ends;
+    };
+
+    Graph             g_1;
+    PlanarizableGraph pg_1;
+    planarize(g_1, pg_1, 1);
+    EXPECT_GT(pg_1.numNodes(), g_1.numNodes());
+
+    for (size_t numThreads : { 0, 2, 3, 8 }) {
+        Graph             g_2;
+        PlanarizableGraph pg_2;
+        planarize(g_2, pg_2, numThreads);
+        EXPECT_EQ(pg_2.numNodes(), pg_1.numNodes());
+        EXPECT_EQ(pg_2.numEdges(), pg_1.numEdges());
+        EXPECT_EQ(edgeEnds(pg_2), edgeEnds(pg_1));
+    }
+
+}
+
+
 } // namespace Undirected
 
 } // namespace Wailea
@@ -0,0 +1,300 @@
+#include "gtest/gtest.h"
+#include "undirected/layout_pipeline.hpp"
+
+#include <stdexcept>
+
+namespace Wailea {
+
+namespace Undirected {
+
+class LayoutPipelineTests : public ::testing::Test {
+
+  protected:
+
+    LayoutPipelineTests(){;};
+    virtual ~LayoutPipelineTests(){;};
+    virtual void SetUp() {;};
+    virtual void TearDown() {;};
+
+    VRRectLabelNode& addNode(VRRectLabelGraph& G, coord_t w, coord_t h) {
+        auto np = std::make_unique<VRRectLabelNode>(w, h);
+        return dynamic_cast<VRRectLabelNode&>(G.addNode(std::move(np)));
+    }
+
+    VRRectLabelEdge& addEdge(
+        VRRectLabelGraph& G,
+        VRRectLabelNode&  N1,
+        VRRectLabelNode&  N2
+    ) {
+        auto  ep = std::make_unique<VRRectLabelEdge>();
+        auto& E  = dynamic_cast<VRRectLabelEdge&>(
+                                           G.addEdge(std::move(ep), N1, N2));
+        E.setLabelNode1Side(VRRectLabelEdge::POS_CLOCKWISE, 3.0, 4.0);
+        E.setLabelMiddle(VRRectLabelEdge::POS_CENTER, 5.0, 6.0);
+        E.setLabelNode2Side(VRRectLabelEdge::POS_COUNTER_CLOCKWISE, 7.0, 8.0);
+        return E;
+    }
+
+    /** @brief generates K_n whose node i has the label (10+i) x (20+i).
+     */
+    void generateComplete(VRRectLabelGraph& G, size_t n) {
+        G.setHorizontalGap(2.0);
+        G.setVerticalGap(3.0);
+        vector<VRRectLabelNode*> nodes;
+        for (size_t i = 0; i < n; i++) {
+            nodes.push_back(&addNode(G, 10.0 + i, 20.0 + i));
+        }
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = i + 1; j < n; j++) {
+                addEdge(G, *nodes[i], *nodes[j]);
+            }
+        }
+    }
+
+    /** @brief checks the links, the chains, the labels, and the
+     *         coordinates of LG against G.
+     */
+    void checkLayout(VRRectLabelGraph& G, VRRectLabelGraph& LG) {
+
+        EXPECT_EQ(LG.horizontalGap(), G.horizontalGap());
+        EXPECT_EQ(LG.verticalGap(),   G.verticalGap());
+
+        size_t numVirtual = 0;
+        for (auto nit = LG.nodes().first; nit != LG.nodes().second; nit++) {
+            auto& LN = dynamic_cast<VRRectLabelNode&>(*(*nit));
+            if (LN.isVirtual()) {
+                numVirtual++;
+                EXPECT_EQ(LN.IGBackwardLink(), G.nodes().second);
+                EXPECT_EQ(LN.width(),  G.horizontalGap() * 2.0);
+                EXPECT_EQ(LN.height(), G.verticalGap()   * 2.0);
+                EXPECT_EQ(LN.degree(), 4);
+            }
+            else {
+                auto& GN = dynamic_cast<VRRectLabelNode&>(
+                                                      LN.IGBackwardLinkRef());
+                EXPECT_EQ(GN.IGForwardLink(), nit);
+                EXPECT_EQ(LN.width(),  GN.width());
+                EXPECT_EQ(LN.height(), GN.height());
+                EXPECT_EQ(LN.degree(), GN.degree());
+            }
+            EXPECT_LE(LN.xLeft(), LN.xRight());
+        }
+        EXPECT_EQ(LG.numNodes(), G.numNodes() + numVirtual);
+        EXPECT_EQ(LG.numEdges(), G.numEdges() + numVirtual * 2);
+
+        for (auto eit = G.edges().first; eit != G.edges().second; eit++) {
+
+            auto& GE = dynamic_cast<VRRectLabelEdge&>(*(*eit));
+
+            // Walk the chain from node 1 to node 2.
+            auto   leit     = GE.IGForwardLink();
+            auto   cur      = GE.incidentNode1().IGForwardLink();
+            size_t numEdges = 0;
+            vector<VRRectLabelEdge*> chain;
+            while (true) {
+                auto& LE = dynamic_cast<VRRectLabelEdge&>(*(*leit));
+                EXPECT_EQ(LE.IGBackwardLink(), eit);
+                EXPECT_EQ(LE.incidentNode1().backIt(), cur);
+                cur = LE.incidentNode2().backIt();
+                chain.push_back(&LE);
+                numEdges++;
+                if (LE.isTerminalN2()) {
+                    break;
+                }
+                auto& LEnext = dynamic_cast<VRRectLabelEdge&>(
+                                                         *(*(LE.chainN2())));
+                EXPECT_EQ(LEnext.chainN1(), leit);
+                EXPECT_TRUE(dynamic_cast<VRRectLabelNode&>(
+                                                  *(*cur)).isVirtual());
+                leit = LE.chainN2();
+            }
+            EXPECT_TRUE(chain[0]->isTerminalN1());
+            EXPECT_EQ(cur, GE.incidentNode2().IGForwardLink());
+
+            for (size_t i = 0; i < numEdges; i++) {
+                auto& LE = *chain[i];
+                EXPECT_EQ(LE.hasNode1Label(),  i == 0);
+                EXPECT_EQ(LE.hasNode2Label(),  i == numEdges - 1);
+                EXPECT_EQ(LE.hasMiddleLabel(), i == (numEdges - 1) / 2);
+            }
+            EXPECT_EQ(chain[0]->typeNode1(),   GE.typeNode1());
+            EXPECT_EQ(chain[0]->widthNode1(),  GE.widthNode1());
+            EXPECT_EQ(chain[0]->heightNode1(), GE.heightNode1());
+            auto& LEM = *chain[(numEdges - 1) / 2];
+            EXPECT_EQ(LEM.typeMiddle(),        GE.typeMiddle());
+            EXPECT_EQ(LEM.widthMiddle(),       GE.widthMiddle());
+            EXPECT_EQ(LEM.heightMiddle(),      GE.heightMiddle());
+            auto& LEL = *chain[numEdges - 1];
+            EXPECT_EQ(LEL.typeNode2(),         GE.typeNode2());
+            EXPECT_EQ(LEL.widthNode2(),        GE.widthNode2());
+            EXPECT_EQ(LEL.heightNode2(),       GE.heightNode2());
+        }
+
+        // The vertical segment of each edge is attached to its end nodes.
+        for (auto eit = LG.edges().first; eit != LG.edges().second; eit++) {
+            auto& LE  = dynamic_cast<VRRectLabelEdge&>(*(*eit));
+            auto& LN1 = dynamic_cast<VRRectLabelNode&>(LE.incidentNode1());
+            auto& LN2 = dynamic_cast<VRRectLabelNode&>(LE.incidentNode2());
+            EXPECT_GE(LE.x(), LN1.xLeft());
+            EXPECT_LE(LE.x(), LN1.xRight());
+            EXPECT_GE(LE.x(), LN2.xLeft());
+            EXPECT_LE(LE.x(), LN2.xRight());
+            EXPECT_TRUE( (LE.y1() == LN1.y() && LE.y2() == LN2.y()) ||
+                         (LE.y1() == LN2.y() && LE.y2() == LN1.y())   );
+            EXPECT_NE(LN1.y(), LN2.y());
+        }
+        EXPECT_GT(LG.width(),  0.0);
+        EXPECT_GT(LG.height(), 0.0);
+    }
+
+    /** @brief returns the coordinates of LG in the order of the nodes and
+     *         the edges.
+     */
+    vector<coord_t> coordinates(VRRectLabelGraph& LG) {
+        vector<coord_t> coords;
+        coords.push_back(LG.width());
+        coords.push_back(LG.height());
+        for (auto nit = LG.nodes().first; nit != LG.nodes().second; nit++) {
+            auto& LN = dynamic_cast<VRRectLabelNode&>(*(*nit));
+            coords.push_back(LN.xLeft());
+            coords.push_back(LN.xRight());
+            coords.push_back(LN.y());
+        }
+        for (auto eit = LG.edges().first; eit != LG.edges().second; eit++) {
+            auto& LE = dynamic_cast<VRRectLabelEdge&>(*(*eit));
+            coords.push_back(LE.x());
+            coords.push_back(LE.y1());
+            coords.push_back(LE.y2());
+        }
+        return coords;
+    }
+
+};
+
+
+/**  @brief empty graph and non-empty output graph
+ */
+TEST_F(LayoutPipelineTests, Test1) {
+
+    VRRectLabelGraph G;
+    VRRectLabelGraph LG;
+    LayoutPipeline   pipeline;
+    pipeline.layout(G, LG);
+    EXPECT_EQ(LG.numNodes(), 0);
+    EXPECT_EQ(LG.numEdges(), 0);
+
+    addNode(LG, 1.0, 1.0);
+    EXPECT_THROW(pipeline.layout(G, LG), std::invalid_argument);
+
+}
+
+
+/**  @brief planar graph with K4 {1,2,3,4}, a triangle {4,5,6}, and a pendant
+ *          edge {6,7}, with node 5 at the top.
+ */
+TEST_F(LayoutPipelineTests, Test2) {
+
+    VRRectLabelGraph G;
+    G.setHorizontalGap(5.0);
+    G.setVerticalGap(6.0);
+    auto& N1 = addNode(G, 10.0, 11.0);
+    auto& N2 = addNode(G, 12.0, 13.0);
+    auto& N3 = addNode(G, 14.0, 15.0);
+    auto& N4 = addNode(G, 16.0, 17.0);
+    auto& N5 = addNode(G, 18.0, 19.0);
+    auto& N6 = addNode(G, 20.0, 21.0);
+    auto& N7 = addNode(G, 22.0, 23.0);
+    addEdge(G, N1, N2);
+    addEdge(G, N1, N3);
+    addEdge(G, N2, N3);
+    addEdge(G, N1, N4);
+    addEdge(G, N2, N4);
+    addEdge(G, N3, N4);
+    addEdge(G, N4, N5);
+    addEdge(G, N5, N6);
+    addEdge(G, N4, N6);
+    addEdge(G, N6, N7);
+
+    VRRectLabelGraph LG;
+    LayoutPipeline   pipeline;
+    pipeline.layout(G, LG, N5.backIt());
+    checkLayout(G, LG);
+    EXPECT_EQ(LG.numNodes(), G.numNodes());
+
+    // The top node is at the extreme of the vertical order.
+    auto& LN5 = dynamic_cast<VRRectLabelNode&>(N5.IGForwardLinkRef());
+    for (auto nit = LG.nodes().first; nit != LG.nodes().second; nit++) {
+        auto& LN = dynamic_cast<VRRectLabelNode&>(*(*nit));
+        EXPECT_LE(LN.y(), LN5.y());
+    }
+
+}
+
+
+/**  @brief non-planar graphs are planarized with labeled chains.
+ */
+TEST_F(LayoutPipelineTests, Test3) {
+
+    for (size_t n = 5; n <= 8; n++) {
+
+        VRRectLabelGraph G;
+        generateComplete(G, n);
+
+        VRRectLabelGraph LG;
+        LayoutPipeline   pipeline;
+        pipeline.layout(G, LG);
+        checkLayout(G, LG);
+        EXPECT_GT(LG.numNodes(), G.numNodes());
+
+    }
+
+}
+
+
+/**  @brief the result does not depend on the number of threads.
+ */
+TEST_F(LayoutPipelineTests, Test4) {
+
+    // Three K6 joined at a chain of cut vertices.
+    auto generate = [this](VRRectLabelGraph& G) {
+        generateComplete(G, 6);
+        auto prev = G.nodes().first;
+        for (size_t b = 0; b < 2; b++) {
+            vector<VRRectLabelNode*> nodes;
+            nodes.push_back(&dynamic_cast<VRRectLabelNode&>(*(*prev)));
+            for (size_t i = 1; i < 6; i++) {
+                nodes.push_back(&addNode(G, 30.0 + i, 40.0 + b));
+            }
+            for (size_t i = 0; i < 6; i++) {
+                for (size_t j = i + 1; j < 6; j++) {
+                    addEdge(G, *nodes[i], *nodes[j]);
+                }
+            }
+            prev = nodes[5]->backIt();
+        }
+    };
+
+    VRRectLabelGraph G_1;
+    generate(G_1);
+    VRRectLabelGraph LG_1;
+    LayoutPipeline   pipeline_1;
+    pipeline_1.layout(G_1, LG_1, G_1.nodes().first);
+    checkLayout(G_1, LG_1);
+
+    for (size_t numThreads : { 0, 2, 4 }) {
+        VRRectLabelGraph G_2;
+        generate(G_2);
+        VRRectLabelGraph LG_2;
+        LayoutPipeline   pipeline_2;
+        pipeline_2.setNumThreads(numThreads);
+        pipeline_2.layout(G_2, LG_2, G_2.nodes().first);
+        checkLayout(G_2, LG_2);
+        EXPECT_EQ(coordinates(LG_2), coordinates(LG_1));
+    }
+
+}
+
+
+} // namespace Undirected
+
+} // namespace Wailea
@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+#include "undirected/parallel_for.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace Wailea {
+
+namespace Undirected {
+
+class ParallelForTests : public ::testing::Test {
+
+  protected:
+
+    ParallelForTests(){;};
+    virtual ~ParallelForTests(){;};
+    virtual void SetUp() {;};
+    virtual void TearDown() {;};
+
+};
+
+
+/**  The number of the threads is clamped to [1, numTasks], and 0 means
+ *   the hardware concurrency.
+ */
+TEST_F(ParallelForTests, Test1) {
+
+    EXPECT_EQ(numWorkerThreads(4, 10), 4);
+    EXPECT_EQ(numWorkerThreads(4, 3),  3);
+    EXPECT_EQ(numWorkerThreads(4, 0),  1);
+    EXPECT_EQ(numWorkerThreads(1, 10), 1);
+    EXPECT_GE(numWorkerThreads(0, 10), 1);
+    EXPECT_LE(numWorkerThreads(0, 10), 10);
+
+}
+
+
+/**  Every index is called exactly once, and index 0 is on the calling
+ *   thread.
+ */
+TEST_F(ParallelForTests, Test2) {
+
+    for (size_t numThreads = 0; numThreads <= 5; numThreads++) {
+
+        size_t expected = std::max(numThreads, size_t(1));
+        vector<size_t> counts(expected, 0);
+        std::thread::id idZero;
+        parallelFor(numThreads, [&](size_t t) {
+            counts[t]++;
+            if (t == 0) {
+                idZero = std::this_thread::get_id();
+            }
+        });
+        for (auto c : counts) {
+            EXPECT_EQ(c, 1);
+        }
+        EXPECT_EQ(idZero, std::this_thread::get_id());
+    }
+
+}
+
+
+/**  An exception from a worker is rethrown after all of them have
+ *   finished. The one from the lowest index is chosen.
+ */
+TEST_F(ParallelForTests, Test3) {
+
+    std::atomic<size_t> numFinished(0);
+    try {
+        parallelFor(4, [&](size_t t) {
+            numFinished++;
+            if (t == 1 || t == 3) {
+                throw std::runtime_error(t == 1 ? "one" : "three");
+            }
+        });
+        FAIL();
+    }
+    catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "one");
+    }
+    EXPECT_EQ(numFinished, 4);
+
+}
+
+
+} // namespace Undirected
+
+} // namespace Wailea
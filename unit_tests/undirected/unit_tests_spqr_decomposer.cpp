@@ -617,7 +617,6 @@ TEST_F(SPQRDecomposerTests, Test2) {
     auto np = make_unique<DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>>();
     edge_list_it_t it;
     np->mOrderedAdjacencyType1.clear();
-    np->mOrderedAdjacencyType1Back.clear();
     /*auto nd_start_it = */copyInputGraph(decomposer, g_1, g_2, n_01.backIt());
 
     auto nit = g_2.nodes().first;
@@ -1041,7 +1040,6 @@ TEST_F(SPQRDecomposerTests, Test3) {
     auto np = make_unique<DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>>();
     edge_list_it_t it;
     np->mOrderedAdjacencyType1.clear();
-    np->mOrderedAdjacencyType1Back.clear();
     /*auto nd_start_it = */copyInputGraph(decomposer, g_1, g_2, n_01.backIt());
 
     auto nit = g_2.nodes().first;
@@ -2778,6 +2776,310 @@ TEST_F(SPQRDecomposerTests, Test9) {
     }
 }
 
+
+/**  @brief bonds with several branches, one nested in a branch of the other.
+ *         The P-nodes are merged, and each long branch becomes one S-node.
+ *
+ *          SB    SD
+ *           \   /
+ *  SA ------ P1{1,2}            SC
+ *   \                          /
+ *    P2{3,4} -----------------
+ *                              \
+ *                               SE
+ */
+TEST_F(SPQRDecomposerTests, Test10) {
+
+    for (size_t i = 0 ; i < 11; i++) {
+        Graph g_1;
+        vector<node_list_it_t> nodes;
+        for (size_t j = 0 ; j < 11; j++) {
+            nodes.push_back(g_1.addNode(make_unique<Node>()).backIt());
+        }
+        auto& n_01 = *(*nodes[0]);
+        auto& n_02 = *(*nodes[1]);
+        auto& n_03 = *(*nodes[2]);
+        auto& n_04 = *(*nodes[3]);
+        auto& n_05 = *(*nodes[4]);
+        auto& n_06 = *(*nodes[5]);
+        auto& n_07 = *(*nodes[6]);
+        auto& n_08 = *(*nodes[7]);
+        auto& n_09 = *(*nodes[8]);
+        auto& n_10 = *(*nodes[9]);
+        auto& n_11 = *(*nodes[10]);
+
+        auto& e_01_02 = g_1.addEdge(make_unique<Edge>(),n_01, n_02);
+        auto& e_01_03 = g_1.addEdge(make_unique<Edge>(),n_01, n_03);
+        auto& e_03_04 = g_1.addEdge(make_unique<Edge>(),n_03, n_04);
+        auto& e_02_04 = g_1.addEdge(make_unique<Edge>(),n_02, n_04);
+        auto& e_01_05 = g_1.addEdge(make_unique<Edge>(),n_01, n_05);
+        auto& e_05_06 = g_1.addEdge(make_unique<Edge>(),n_05, n_06);
+        auto& e_06_07 = g_1.addEdge(make_unique<Edge>(),n_06, n_07);
+        auto& e_02_07 = g_1.addEdge(make_unique<Edge>(),n_02, n_07);
+        auto& e_01_10 = g_1.addEdge(make_unique<Edge>(),n_01, n_10);
+        auto& e_02_10 = g_1.addEdge(make_unique<Edge>(),n_02, n_10);
+        auto& e_03_08 = g_1.addEdge(make_unique<Edge>(),n_03, n_08);
+        auto& e_08_09 = g_1.addEdge(make_unique<Edge>(),n_08, n_09);
+        auto& e_04_09 = g_1.addEdge(make_unique<Edge>(),n_04, n_09);
+        auto& e_03_11 = g_1.addEdge(make_unique<Edge>(),n_03, n_11);
+        auto& e_04_11 = g_1.addEdge(make_unique<Edge>(),n_04, n_11);
+
+        SPQRDecomposer decomposer;
+        auto& nStart = *(*nodes[i]);
+        SPQRTree spqrTree = decomposer.decompose(g_1,nStart);
+
+        EXPECT_EQ(spqrTree.numNodes(), 7);
+        EXPECT_EQ(spqrTree.numEdges(), 6);
+
+        // P1
+        testTreeElem tte_01;
+        tte_01.mNodeNumber = 1;
+        tte_01.mNumComponentEdges = 4;
+        tte_01.mRealEdges.push_back(e_01_02.backIt());
+        tte_01.mNodes.push_back(n_01.backIt());
+        tte_01.mNodes.push_back(n_02.backIt());
+        tte_01.mNeighbors.push_back(2);
+        tte_01.mNeighbors.push_back(3);
+        tte_01.mNeighbors.push_back(4);
+        tte_01.mType = SPQRTreeNode::PType;
+
+        // SA
+        testTreeElem tte_02;
+        tte_02.mNodeNumber = 2;
+        tte_02.mNumComponentEdges = 4;
+        tte_02.mRealEdges.push_back(e_01_03.backIt());
+        tte_02.mRealEdges.push_back(e_02_04.backIt());
+        tte_02.mNodes.push_back(n_01.backIt());
+        tte_02.mNodes.push_back(n_02.backIt());
+        tte_02.mNodes.push_back(n_03.backIt());
+        tte_02.mNodes.push_back(n_04.backIt());
+        tte_02.mNeighbors.push_back(1);
+        tte_02.mNeighbors.push_back(5);
+        tte_02.mType = SPQRTreeNode::SType;
+
+        // SB
+        testTreeElem tte_03;
+        tte_03.mNodeNumber = 3;
+        tte_03.mNumComponentEdges = 5;
+        tte_03.mRealEdges.push_back(e_01_05.backIt());
+        tte_03.mRealEdges.push_back(e_05_06.backIt());
+        tte_03.mRealEdges.push_back(e_06_07.backIt());
+        tte_03.mRealEdges.push_back(e_02_07.backIt());
+        tte_03.mNodes.push_back(n_01.backIt());
+        tte_03.mNodes.push_back(n_02.backIt());
+        tte_03.mNodes.push_back(n_05.backIt());
+        tte_03.mNodes.push_back(n_06.backIt());
+        tte_03.mNodes.push_back(n_07.backIt());
+        tte_03.mNeighbors.push_back(1);
+        tte_03.mType = SPQRTreeNode::SType;
+
+        // SD
+        testTreeElem tte_04;
+        tte_04.mNodeNumber = 4;
+        tte_04.mNumComponentEdges = 3;
+        tte_04.mRealEdges.push_back(e_01_10.backIt());
+        tte_04.mRealEdges.push_back(e_02_10.backIt());
+        tte_04.mNodes.push_back(n_01.backIt());
+        tte_04.mNodes.push_back(n_02.backIt());
+        tte_04.mNodes.push_back(n_10.backIt());
+        tte_04.mNeighbors.push_back(1);
+        tte_04.mType = SPQRTreeNode::SType;
+
+        // P2
+        testTreeElem tte_05;
+        tte_05.mNodeNumber = 5;
+        tte_05.mNumComponentEdges = 4;
+        tte_05.mRealEdges.push_back(e_03_04.backIt());
+        tte_05.mNodes.push_back(n_03.backIt());
+        tte_05.mNodes.push_back(n_04.backIt());
+        tte_05.mNeighbors.push_back(2);
+        tte_05.mNeighbors.push_back(6);
+        tte_05.mNeighbors.push_back(7);
+        tte_05.mType = SPQRTreeNode::PType;
+
+        // SC
+        testTreeElem tte_06;
+        tte_06.mNodeNumber = 6;
+        tte_06.mNumComponentEdges = 4;
+        tte_06.mRealEdges.push_back(e_03_08.backIt());
+        tte_06.mRealEdges.push_back(e_08_09.backIt());
+        tte_06.mRealEdges.push_back(e_04_09.backIt());
+        tte_06.mNodes.push_back(n_03.backIt());
+        tte_06.mNodes.push_back(n_04.backIt());
+        tte_06.mNodes.push_back(n_08.backIt());
+        tte_06.mNodes.push_back(n_09.backIt());
+        tte_06.mNeighbors.push_back(5);
+        tte_06.mType = SPQRTreeNode::SType;
+
+        // SE
+        testTreeElem tte_07;
+        tte_07.mNodeNumber = 7;
+        tte_07.mNumComponentEdges = 3;
+        tte_07.mRealEdges.push_back(e_03_11.backIt());
+        tte_07.mRealEdges.push_back(e_04_11.backIt());
+        tte_07.mNodes.push_back(n_03.backIt());
+        tte_07.mNodes.push_back(n_04.backIt());
+        tte_07.mNodes.push_back(n_11.backIt());
+        tte_07.mNeighbors.push_back(5);
+        tte_07.mType = SPQRTreeNode::SType;
+
+        vector<testTreeElem> elems;
+        elems.push_back(tte_01);
+        elems.push_back(tte_02);
+        elems.push_back(tte_03);
+        elems.push_back(tte_04);
+        elems.push_back(tte_05);
+        elems.push_back(tte_06);
+        elems.push_back(tte_07);
+
+        EXPECT_EQ(testTree(spqrTree, elems),true);
+
+        for (auto eit = g_1.edges().first; eit != g_1.edges().second; eit++) {
+            auto& E = *(*eit);
+            EXPECT_EQ(E.utilitySize(), 1);
+            EXPECT_EQ(E.IGForwardLinksSize(), 1);
+            EXPECT_EQ(E.IGBackwardLinksSize(), 0);
+            if (&E == &e_01_02 || &E == &e_03_04) {
+                EXPECT_EQ(E.utility(),
+                                    SPQRTree::kForwardEdgeTypeSeparatingEdge);
+            }
+            else {
+                EXPECT_EQ(E.utility(), SPQRTree::kForwardEdgeTypeOrdinaryEdge);
+            }
+        }
+    }
+}
+
+
+/**  @brief a cycle of 12 nodes with two chords {1,4} and {4,8}.
+ *         The pieces of the long paths are merged into S-nodes, one of
+ *         which has the virtual edges to both P-nodes.
+ *
+ *    S{1,2,3,4} - P{1,4} - S{1,4,8,9,10,11,12} - P{4,8} - S{4,5,6,7,8}
+ */
+TEST_F(SPQRDecomposerTests, Test11) {
+
+    for (size_t i = 0 ; i < 12; i++) {
+        Graph g_1;
+        vector<node_list_it_t> nodes;
+        for (size_t j = 0 ; j < 12; j++) {
+            nodes.push_back(g_1.addNode(make_unique<Node>()).backIt());
+        }
+        vector<edge_list_it_t> cycle;
+        for (size_t j = 0 ; j < 12; j++) {
+            cycle.push_back(g_1.addEdge(make_unique<Edge>(),
+                             *(*nodes[j]), *(*nodes[(j + 1) % 12])).backIt());
+        }
+        auto& e_01_04 = g_1.addEdge(
+                              make_unique<Edge>(),*(*nodes[0]), *(*nodes[3]));
+        auto& e_04_08 = g_1.addEdge(
+                              make_unique<Edge>(),*(*nodes[3]), *(*nodes[7]));
+
+        SPQRDecomposer decomposer;
+        auto& nStart = *(*nodes[i]);
+        SPQRTree spqrTree = decomposer.decompose(g_1,nStart);
+
+        EXPECT_EQ(spqrTree.numNodes(), 5);
+        EXPECT_EQ(spqrTree.numEdges(), 4);
+
+        // S{1,2,3,4}
+        testTreeElem tte_01;
+        tte_01.mNodeNumber = 1;
+        tte_01.mNumComponentEdges = 4;
+        for (size_t j = 0 ; j < 3; j++) {
+            tte_01.mRealEdges.push_back(cycle[j]);
+        }
+        for (size_t j = 0 ; j < 4; j++) {
+            tte_01.mNodes.push_back(nodes[j]);
+        }
+        tte_01.mNeighbors.push_back(2);
+        tte_01.mType = SPQRTreeNode::SType;
+
+        // P{1,4}
+        testTreeElem tte_02;
+        tte_02.mNodeNumber = 2;
+        tte_02.mNumComponentEdges = 3;
+        tte_02.mRealEdges.push_back(e_01_04.backIt());
+        tte_02.mNodes.push_back(nodes[0]);
+        tte_02.mNodes.push_back(nodes[3]);
+        tte_02.mNeighbors.push_back(1);
+        tte_02.mNeighbors.push_back(3);
+        tte_02.mType = SPQRTreeNode::PType;
+
+        // S{1,4,8,9,10,11,12}
+        testTreeElem tte_03;
+        tte_03.mNodeNumber = 3;
+        tte_03.mNumComponentEdges = 7;
+        for (size_t j = 7 ; j < 12; j++) {
+            tte_03.mRealEdges.push_back(cycle[j]);
+        }
+        tte_03.mNodes.push_back(nodes[0]);
+        tte_03.mNodes.push_back(nodes[3]);
+        for (size_t j = 7 ; j < 12; j++) {
+            tte_03.mNodes.push_back(nodes[j]);
+        }
+        tte_03.mNeighbors.push_back(2);
+        tte_03.mNeighbors.push_back(4);
+        tte_03.mType = SPQRTreeNode::SType;
+
+        // P{4,8}
+        testTreeElem tte_04;
+        tte_04.mNodeNumber = 4;
+        tte_04.mNumComponentEdges = 3;
+        tte_04.mRealEdges.push_back(e_04_08.backIt());
+        tte_04.mNodes.push_back(nodes[3]);
+        tte_04.mNodes.push_back(nodes[7]);
+        tte_04.mNeighbors.push_back(3);
+        tte_04.mNeighbors.push_back(5);
+        tte_04.mType = SPQRTreeNode::PType;
+
+        // S{4,5,6,7,8}
+        testTreeElem tte_05;
+        tte_05.mNodeNumber = 5;
+        tte_05.mNumComponentEdges = 5;
+        for (size_t j = 3 ; j < 7; j++) {
+            tte_05.mRealEdges.push_back(cycle[j]);
+        }
+        for (size_t j = 3 ; j < 8; j++) {
+            tte_05.mNodes.push_back(nodes[j]);
+        }
+        tte_05.mNeighbors.push_back(4);
+        tte_05.mType = SPQRTreeNode::SType;
+
+        vector<testTreeElem> elems;
+        elems.push_back(tte_01);
+        elems.push_back(tte_02);
+        elems.push_back(tte_03);
+        elems.push_back(tte_04);
+        elems.push_back(tte_05);
+
+        EXPECT_EQ(testTree(spqrTree, elems),true);
+
+        // The S-node in the middle has the virtual edges to both P-nodes.
+        for (auto tnit = spqrTree.nodes().first;
+                                    tnit != spqrTree.nodes().second; tnit++) {
+            auto& TN = dynamic_cast<SPQRTreeNode&>(*(*tnit));
+            if (TN.component().numEdges() == 7) {
+                EXPECT_EQ(TN.degree(), 2);
+            }
+        }
+
+        for (auto eit = g_1.edges().first; eit != g_1.edges().second; eit++) {
+            auto& E = *(*eit);
+            EXPECT_EQ(E.utilitySize(), 1);
+            EXPECT_EQ(E.IGForwardLinksSize(), 1);
+            EXPECT_EQ(E.IGBackwardLinksSize(), 0);
+            if (&E == &e_01_04 || &E == &e_04_08) {
+                EXPECT_EQ(E.utility(),
+                                    SPQRTree::kForwardEdgeTypeSeparatingEdge);
+            }
+            else {
+                EXPECT_EQ(E.utility(), SPQRTree::kForwardEdgeTypeOrdinaryEdge);
+            }
+        }
+    }
+}
+
 } // namespace Undirected
 
 } // namespace Wailea
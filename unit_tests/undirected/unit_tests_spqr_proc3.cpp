@@ -353,7 +353,6 @@ TEST_F(SPQRProc3Tests, Test1) {
     auto np = make_unique<DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>>();
     edge_list_it_t it;
     np->mOrderedAdjacencyType1.clear();
-    np->mOrderedAdjacencyType1Back.clear();
     /*auto nd_start_it = */copyInputGraph(decomposer, g_1, g_2, n_01.backIt());
 
     auto nit = g_2.nodes().first;
@@ -1191,7 +1190,6 @@ TEST_F(SPQRProc3Tests, Test2) {
     auto np = make_unique<DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>>();
     edge_list_it_t it;
     np->mOrderedAdjacencyType1.clear();
-    np->mOrderedAdjacencyType1Back.clear();
     /*auto nd_start_it = */copyInputGraph(decomposer, g_1, g_2, n_01.backIt());
 
     auto nit = g_2.nodes().first;
@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 #include "undirected/spqr_decomposer.hpp"
 
+#include <algorithm>
+#include <map>
+
 namespace Wailea {
 
 namespace Undirected { 
@@ -178,6 +181,151 @@ static bool testTreeNode(
 }
 
 
+/** @brief makes a canonical form of the tree for comparison.
+ *         Each tree node is represented by its type followed by the sorted
+ *         codes of its component edges. A code is made of the numbers of
+ *         the original end nodes and the number of the original edge, or
+ *         zero for a virtual edge.
+ */
+static vector<vector<long long>> treeSignature(
+    SPQRTree&                     t,
+    map<const Node*, long long>&  nodeNums,
+    map<const Edge*, long long>&  edgeNums
+) {
+    long long numNodes = nodeNums.size() + 1;
+    long long numEdges = edgeNums.size() + 1;
+    vector<vector<long long>> sig;
+    for (auto tnit = t.nodes().first; tnit != t.nodes().second; tnit++) {
+        auto& TN = dynamic_cast<SPQRTreeNode&>(*(*tnit));
+        auto& C  = TN.component();
+        vector<long long> codes;
+        for (auto ceit = C.edges().first; ceit != C.edges().second; ceit++) {
+            auto& CE = dynamic_cast<SPQRComponentEdge&>(*(*ceit));
+            long long n1 = nodeNums[&(*(*(CE.incidentNode1().IGBackwardLink())))];
+            long long n2 = nodeNums[&(*(*(CE.incidentNode2().IGBackwardLink())))];
+            long long e  = 0;
+            if (CE.type() == SPQRComponentEdge::OrdinaryType) {
+                e = edgeNums[&(*(*(CE.IGBackwardLink())))];
+            }
+            codes.push_back(
+                 (std::min(n1,n2) * numNodes + std::max(n1,n2)) * numEdges + e);
+        }
+        sort(codes.begin(), codes.end());
+        codes.insert(codes.begin(), (long long)TN.type());
+        sig.push_back(codes);
+    }
+    sort(sig.begin(), sig.end());
+    return sig;
+}
+
+
+/** @brief checks the links between the tree nodes, the components, and the
+ *         original graph.
+ */
+static bool checkTreeLinks(SPQRTree& t, Graph& g)
+{
+    for (auto tnit = t.nodes().first; tnit != t.nodes().second; tnit++) {
+        auto& TN = dynamic_cast<SPQRTreeNode&>(*(*tnit));
+        auto& C  = TN.component();
+        if (&(C.SPQRTreeNode()) != &TN) {
+            return false;
+        }
+        size_t numVirtual = 0;
+        for (auto ceit = C.edges().first; ceit != C.edges().second; ceit++) {
+            auto& CE = dynamic_cast<SPQRComponentEdge&>(*(*ceit));
+            if (CE.type() == SPQRComponentEdge::OrdinaryType) {
+                auto& E = *(*(CE.IGBackwardLink()));
+                if (E.IGForwardLink() != ceit) {
+                    return false;
+                }
+                utility_t expected = (TN.type() == SPQRTreeNode::PType) ?
+                                     SPQRTree::kForwardEdgeTypeSeparatingEdge:
+                                     SPQRTree::kForwardEdgeTypeOrdinaryEdge;
+                if (E.utility() != expected) {
+                    return false;
+                }
+                continue;
+            }
+            numVirtual++;
+            auto& PE = CE.pairVirtualEdge();
+            auto& PT = CE.pairTreeNode();
+            auto& TE = CE.treeEdge();
+            if (&(PE.pairVirtualEdge()) != &CE || &(PE.pairTreeNode()) != &TN
+                || &(PE.graph()) != &(PT.component())
+                || &(PE.treeEdge()) != &TE) {
+                return false;
+            }
+            if (&(TE.incidentNode1()) == &TN) {
+                if (TE.virtualEdge1() != ceit ||
+                    &(TE.incidentNode2()) != &PT) {
+                    return false;
+                }
+            }
+            else if (TE.virtualEdge2() != ceit ||
+                     &(TE.incidentNode1()) != &PT) {
+                return false;
+            }
+        }
+        if (numVirtual != TN.degree()) {
+            return false;
+        }
+    }
+    return t.numEdges() + 1 == t.numNodes();
+}
+
+
+/** @brief compares the tree with the one made from scratch.
+ */
+static bool sameAsDecomposed(SPQRTree& t, Graph& g)
+{
+    map<const Node*, long long> nodeNums;
+    map<const Edge*, long long> edgeNums;
+    for (auto nit = g.nodes().first; nit != g.nodes().second; nit++) {
+        nodeNums[&(*(*nit))] = nodeNums.size() + 1;
+    }
+    for (auto eit = g.edges().first; eit != g.edges().second; eit++) {
+        edgeNums[&(*(*eit))] = edgeNums.size() + 1;
+    }
+    auto sigUpdated = treeSignature(t, nodeNums, edgeNums);
+
+    bool same;
+    {
+        SPQRDecomposer decomposer;
+        SPQRTree fresh = decomposer.decompose(g, *(*(g.nodes().first)));
+        same = (treeSignature(fresh, nodeNums, edgeNums) == sigUpdated);
+    }
+    for (auto eit = g.edges().first; eit != g.edges().second; eit++) {
+        (*eit)->popIGForwardLink();
+        (*eit)->popUtility();
+    }
+    return same;
+}
+
+
+/** @brief adds an edge to the graph and the tree.
+ */
+static Edge& insertEdge(SPQRTree& t, Graph& g, Node& n1, Node& n2)
+{
+    auto& E = g.addEdge(make_unique<Edge>(), n1, n2);
+    t.insertEdge(E.backIt());
+    return E;
+}
+
+
+/** @brief puts a new node on the edge in the graph and the tree.
+ */
+static Node& subdivideEdge(SPQRTree& t, Graph& g, Edge& e)
+{
+    auto& N  = g.addNode(make_unique<Node>());
+    auto& E1 = g.addEdge(make_unique<Edge>(), e.incidentNode1(), N);
+    auto& E2 = g.addEdge(make_unique<Edge>(), N, e.incidentNode2());
+    t.subdivideEdge(e.backIt(), E1.backIt(), E2.backIt());
+    g.removeEdge(e);
+    return N;
+}
+
+
+
 static bool testTreeEdge(
     SPQRTreeEdge& te,
     SPQRTreeNode& n1,
@@ -1024,7 +1172,6 @@ TEST_F(SPQRTreeTests, Test2) {
     auto np = make_unique<DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>>();
     edge_list_it_t it;
     np->mOrderedAdjacencyType1.clear();
-    np->mOrderedAdjacencyType1Back.clear();
     /*auto nd_start_it = */copyInputGraph(decomposer, g_1, g_2, n_01.backIt());
 
     auto nit = g_2.nodes().first;
@@ -1199,7 +1346,6 @@ TEST_F(SPQRTreeTests, Test3) {
     auto np = make_unique<DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>>();
     edge_list_it_t it;
     np->mOrderedAdjacencyType1.clear();
-    np->mOrderedAdjacencyType1Back.clear();
     /*auto nd_start_it = */copyInputGraph(decomposer, g_1, g_2, n_01.backIt());
 
     auto nit = g_2.nodes().first;
@@ -1499,7 +1645,6 @@ TEST_F(SPQRTreeTests, Test4) {
     auto np = make_unique<DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>>();
     edge_list_it_t it;
     np->mOrderedAdjacencyType1.clear();
-    np->mOrderedAdjacencyType1Back.clear();
     /*auto nd_start_it = */copyInputGraph(decomposer, g_1, g_2, n_01.backIt());
 
     auto nit = g_2.nodes().first;
@@ -1726,7 +1871,6 @@ TEST_F(SPQRTreeTests, Test5) {
     auto np = make_unique<DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>>();
     edge_list_it_t it;
     np->mOrderedAdjacencyType1.clear();
-    np->mOrderedAdjacencyType1Back.clear();
     /*auto nd_start_it = */copyInputGraph(decomposer, g_1, g_2, n_01.backIt());
 
     auto nit = g_2.nodes().first;
@@ -2048,7 +2192,6 @@ TEST_F(SPQRTreeTests, Test6) {
     auto np = make_unique<DFSNode<Graph, SPQR_DFS_Node, SPQR_DFS_Edge>>();
     edge_list_it_t it;
     np->mOrderedAdjacencyType1.clear();
-    np->mOrderedAdjacencyType1Back.clear();
     /*auto nd_start_it = */copyInputGraph(decomposer, g_1, g_2, n_01.backIt());
 
     auto nit = g_2.nodes().first;
@@ -2310,6 +2453,170 @@ TEST_F(SPQRTreeTests, Test6) {
 
 }
 
+
+/**  @brief insertEdge() and subdivideEdge() on each type of the tree nodes.
+ */
+TEST_F(SPQRTreeTests, Test7) {
+
+    Graph g_1;
+    auto& n_01 = g_1.addNode(make_unique<Node>());
+    auto& n_02 = g_1.addNode(make_unique<Node>());
+    auto& n_03 = g_1.addNode(make_unique<Node>());
+    auto& n_04 = g_1.addNode(make_unique<Node>());
+    auto& n_05 = g_1.addNode(make_unique<Node>());
+    auto& n_06 = g_1.addNode(make_unique<Node>());
+
+    /*auto& e_01_02 = */g_1.addEdge(make_unique<Edge>(),n_01,n_02);
+    /*auto& e_02_03 = */g_1.addEdge(make_unique<Edge>(),n_02,n_03);
+    /*auto& e_03_04 = */g_1.addEdge(make_unique<Edge>(),n_03,n_04);
+    /*auto& e_04_05 = */g_1.addEdge(make_unique<Edge>(),n_04,n_05);
+    /*auto& e_05_06 = */g_1.addEdge(make_unique<Edge>(),n_05,n_06);
+    /*auto& e_06_01 = */g_1.addEdge(make_unique<Edge>(),n_06,n_01);
+
+    SPQRDecomposer decomposer;
+    SPQRTree t = decomposer.decompose(g_1, n_01);
+    EXPECT_EQ(t.numNodes(), 1);
+    EXPECT_EQ(t.STypeNodes().size(), 1);
+
+    // A chord splits the cycle into two S nodes and a P node.
+    auto& e_01_04 = insertEdge(t, g_1, n_01, n_04);
+    EXPECT_EQ(t.numNodes(), 3);
+    EXPECT_EQ(t.STypeNodes().size(), 2);
+    EXPECT_EQ(t.PTypeNodes().size(), 1);
+    EXPECT_EQ(e_01_04.utility(), SPQRTree::kForwardEdgeTypeSeparatingEdge);
+    EXPECT_EQ(checkTreeLinks(t, g_1), true);
+    EXPECT_EQ(sameAsDecomposed(t, g_1), true);
+
+    // S-P-S on the path merges into an R node of K4 with two S nodes.
+    auto& e_02_05 = insertEdge(t, g_1, n_02, n_05);
+    EXPECT_EQ(t.numNodes(), 3);
+    EXPECT_EQ(t.RTypeNodes().size(), 1);
+    EXPECT_EQ(t.STypeNodes().size(), 2);
+    EXPECT_EQ(e_01_04.utility(), SPQRTree::kForwardEdgeTypeOrdinaryEdge);
+    EXPECT_EQ(e_02_05.utility(), SPQRTree::kForwardEdgeTypeOrdinaryEdge);
+    EXPECT_EQ(checkTreeLinks(t, g_1), true);
+    EXPECT_EQ(sameAsDecomposed(t, g_1), true);
+
+    // S-R-S on the path merges into one R node of K3,3.
+    insertEdge(t, g_1, n_03, n_06);
+    EXPECT_EQ(t.numNodes(), 1);
+    EXPECT_EQ(t.RTypeNodes().size(), 1);
+    auto& TN = dynamic_cast<SPQRTreeNode&>(*(*(t.nodes().first)));
+    EXPECT_EQ(TN.component().numNodes(), 6);
+    EXPECT_EQ(TN.component().numEdges(), 9);
+    EXPECT_EQ(checkTreeLinks(t, g_1), true);
+    EXPECT_EQ(sameAsDecomposed(t, g_1), true);
+
+    // An edge in the R node is replaced with a triangle.
+    auto& n_07 = subdivideEdge(t, g_1, e_01_04);
+    EXPECT_EQ(t.numNodes(), 2);
+    EXPECT_EQ(t.RTypeNodes().size(), 1);
+    EXPECT_EQ(t.STypeNodes().size(), 1);
+    EXPECT_EQ(checkTreeLinks(t, g_1), true);
+    EXPECT_EQ(sameAsDecomposed(t, g_1), true);
+
+    // The triangle gets longer.
+    auto  e_07_04_it = *(n_07.incidentEdges().first);
+    if (&((*(*e_07_04_it)).adjacentNode(n_07)) != &n_04) {
+        e_07_04_it = *(++(n_07.incidentEdges().first));
+    }
+    auto& n_08 = subdivideEdge(t, g_1, *(*e_07_04_it));
+    EXPECT_EQ(t.numNodes(), 2);
+    EXPECT_EQ(t.STypeNodes().size(), 1);
+    EXPECT_EQ(checkTreeLinks(t, g_1), true);
+    EXPECT_EQ(sameAsDecomposed(t, g_1), true);
+
+    // A new edge between the separation pair {1,4} makes a P node.
+    insertEdge(t, g_1, n_01, n_04);
+    EXPECT_EQ(t.numNodes(), 3);
+    EXPECT_EQ(t.PTypeNodes().size(), 1);
+    EXPECT_EQ(checkTreeLinks(t, g_1), true);
+    EXPECT_EQ(sameAsDecomposed(t, g_1), true);
+
+    // Another edge between the same pair goes to the P node.
+    insertEdge(t, g_1, n_01, n_04);
+    EXPECT_EQ(t.numNodes(), 3);
+    EXPECT_EQ(t.PTypeNodes().size(), 1);
+    EXPECT_EQ(checkTreeLinks(t, g_1), true);
+
+    // The S node of {1,7,8,4} and the R node merge through the P node.
+    // The path {1,7,8} is left in an S node, and the two real edges {1,4}
+    // are left in a P node.
+    insertEdge(t, g_1, n_08, n_02);
+    EXPECT_EQ(t.numNodes(), 3);
+    EXPECT_EQ(t.RTypeNodes().size(), 1);
+    EXPECT_EQ(t.PTypeNodes().size(), 1);
+    EXPECT_EQ(t.STypeNodes().size(), 1);
+    EXPECT_EQ(checkTreeLinks(t, g_1), true);
+
+    // An edge parallel to an edge in the R node makes a P node.
+    insertEdge(t, g_1, n_02, n_03);
+    EXPECT_EQ(t.numNodes(), 4);
+    EXPECT_EQ(t.PTypeNodes().size(), 2);
+    EXPECT_EQ(checkTreeLinks(t, g_1), true);
+
+    // The new node is not in the tree.
+    auto& n_99 = g_1.addNode(make_unique<Node>());
+    auto& e_99 = g_1.addEdge(make_unique<Edge>(), n_01, n_99);
+    EXPECT_THROW(t.insertEdge(e_99.backIt()), std::invalid_argument);
+}
+
+
+/**  @brief random sequences of insertEdge() and subdivideEdge() compared
+ *          with the decomposition from scratch.
+ */
+TEST_F(SPQRTreeTests, Test8) {
+
+    for (unsigned long long seed = 1; seed <= 20; seed++) {
+
+        unsigned long long state = seed;
+        auto rnd = [&state](size_t m) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return size_t((state >> 33) % m);
+        };
+
+        Graph g_1;
+        vector<Node*> nodes;
+        for (size_t i = 0; i < 5; i++) {
+            nodes.push_back(&(g_1.addNode(make_unique<Node>())));
+        }
+        for (size_t i = 0; i < 5; i++) {
+            g_1.addEdge(make_unique<Edge>(), *nodes[i], *nodes[(i+1)%5]);
+        }
+
+        SPQRDecomposer decomposer;
+        SPQRTree t = decomposer.decompose(g_1, *nodes[0]);
+
+        for (size_t step = 0; step < 60; step++) {
+
+            if (rnd(3) == 0) {
+                auto eit = g_1.edges().first;
+                for (size_t i = rnd(g_1.numEdges()); i > 0; i--) {
+                    eit++;
+                }
+                nodes.push_back(&(subdivideEdge(t, g_1, *(*eit))));
+            }
+            else {
+                auto& N1 = *nodes[rnd(nodes.size())];
+                auto& N2 = *nodes[rnd(nodes.size())];
+                bool  adjacent = (&N1 == &N2);
+                for (auto iit  = N1.incidentEdges().first;
+                          iit != N1.incidentEdges().second; iit++) {
+                    if (&((*(*(*iit))).adjacentNode(N1)) == &N2) {
+                        adjacent = true;
+                    }
+                }
+                if (adjacent) {
+                    continue;
+                }
+                insertEdge(t, g_1, N1, N2);
+            }
+            EXPECT_EQ(checkTreeLinks(t, g_1), true);
+            EXPECT_EQ(sameAsDecomposed(t, g_1), true);
+        }
+    }
+}
+
 } // namespace Undirected
 
 } // namespace Wailea
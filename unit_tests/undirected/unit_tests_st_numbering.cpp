@@ -398,6 +398,122 @@ TEST_F(STNumberingTests, Test5) {
 
 }
 
+
+/**  @brief checks that every node other than s and t has a lower and a
+ *          higher neighbor in L on a CompactGraph.
+ */
+static bool testCompactOrientation(
+    const CompactGraph&        g,
+    vector<cg_index_t>&        L,
+    bool                       hasEdgeST
+) {
+    if (L.size() != g.numNodes()) {
+        return false;
+    }
+    vector<size_t> position(g.numNodes(), g.numNodes());
+    for (size_t i = 0; i < L.size(); i++) {
+        position[L[i]] = i;
+    }
+    for (size_t n = 0; n < g.numNodes(); n++) {
+        if (position[n] == g.numNodes()) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < L.size(); i++) {
+        bool lower  = (i == 0);
+        bool higher = (i == L.size() - 1);
+        for (auto iit  = g.incidentEdges(L[i]).first;
+                  iit != g.incidentEdges(L[i]).second; iit++) {
+            auto p = position[g.adjacentNode(*iit, L[i])];
+            lower  = lower  || (p < i);
+            higher = higher || (p > i);
+        }
+        if (!hasEdgeST && (i == 0 || i == L.size() - 1)) {
+            // s and t are adjacent only through the virtual edge {s,t}.
+            continue;
+        }
+        if (!lower || !higher) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**  @brief test on a CompactGraph built from the node index pairs.
+ *          A wheel of 9 nodes with the hub 0. Every pair of nodes is
+ *          tried, with and without {s,t} in the graph.
+ */
+TEST_F(STNumberingTests, Test6) {
+
+    const cg_index_t numRim = 8;
+    vector<pair<cg_index_t,cg_index_t>> edges;
+    for (cg_index_t i = 1; i <= numRim; i++) {
+        edges.push_back(make_pair(0, i));
+        edges.push_back(make_pair(i, (i % numRim) + 1));
+    }
+    CompactGraph g;
+    g.build(numRim + 1, edges);
+
+    for (cg_index_t s = 0; s <= numRim; s++) {
+        for (cg_index_t t = 0; t <= numRim; t++) {
+            if (s == t) {
+                continue;
+            }
+            bool hasEdgeST = false;
+            for (auto& e : edges) {
+                if ((e.first == s && e.second == t) ||
+                    (e.first == t && e.second == s)   ) {
+                    hasEdgeST = true;
+                }
+            }
+            STNumbering st;
+            auto L = st.getBipolarOrientation(g, s, t);
+            EXPECT_EQ(L.front(), s);
+            EXPECT_EQ(L.back(),  t);
+            EXPECT_EQ(testCompactOrientation(g, L, hasEdgeST), true);
+        }
+    }
+}
+
+
+/**  @brief the orientation on a Graph is the one on its CompactGraph
+ *          mapped back to the nodes.
+ */
+TEST_F(STNumberingTests, Test7) {
+
+    Graph g_1;
+    vector<node_list_it_t> n;
+    for (size_t i = 0; i < 7; i++) {
+        n.push_back(g_1.addNode(make_unique<Node>()).backIt());
+    }
+    // A cycle with chords.
+    for (size_t i = 0; i < 7; i++) {
+        g_1.addEdge(make_unique<Edge>(), *(*n[i]), *(*n[(i + 1) % 7]));
+    }
+    g_1.addEdge(make_unique<Edge>(), *(*n[0]), *(*n[3]));
+    g_1.addEdge(make_unique<Edge>(), *(*n[2]), *(*n[5]));
+
+    CompactGraph cg;
+    cg.build(g_1);
+
+    for (cg_index_t s = 0; s < 7; s++) {
+        for (cg_index_t t = 0; t < 7; t++) {
+            if (s == t) {
+                continue;
+            }
+            STNumbering st1;
+            auto nlist = st1.getBipolarOrientation(g_1, *(*n[s]), *(*n[t]));
+            STNumbering st2;
+            auto L     = st2.getBipolarOrientation(cg, s, t);
+            EXPECT_EQ(nlist.size(), L.size());
+            for (size_t i = 0; i < L.size() && i < nlist.size(); i++) {
+                EXPECT_EQ(nlist[i], cg.originalNode(L[i]));
+            }
+        }
+    }
+}
+
 } // namespace Undirected
 
 } // namespace Wailea
@@ -0,0 +1,258 @@
+#include "gtest/gtest.h"
+#include "undirected/text_spec_reader.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <unistd.h>
+
+namespace Wailea {
+
+namespace Undirected {
+
+class TextSpecReaderTests : public ::testing::Test {
+
+  protected:
+
+    TextSpecReaderTests(){;};
+    virtual ~TextSpecReaderTests(){;};
+    virtual void SetUp() {;};
+    virtual void TearDown() {;};
+
+    bool toLong(const std::string& s, long& val) {
+        TextSpecReader::Token t(s.data(), s.data() + s.size());
+        return t.toLong(val);
+    }
+
+    bool toDouble(const std::string& s, double& val) {
+        TextSpecReader::Token t(s.data(), s.data() + s.size());
+        return t.toDouble(val);
+    }
+
+    void loadString(TextSpecReader& reader, const std::string& s) {
+        std::istringstream is(s);
+        reader.load(is);
+    }
+
+};
+
+
+/**  @brief lines, line numbers, blank and comment lines.
+ */
+TEST_F(TextSpecReaderTests, Test1) {
+
+    TextSpecReader reader;
+    loadString(reader, "NODES\r\n1\n\n# comment\n  2  3 \n4\n5\t 6\t7,8");
+
+    EXPECT_EQ(reader.nextLine(), true);
+    EXPECT_EQ(reader.lineNumber(), 1);
+    EXPECT_EQ(reader.line(), "NODES");
+    EXPECT_EQ(reader.startsWith("NODES"), true);
+    EXPECT_EQ(reader.startsWith("NODES_"), false);
+    EXPECT_EQ(reader.isBlank(), false);
+
+    EXPECT_EQ(reader.nextLine(), true);
+    EXPECT_EQ(reader.lineNumber(), 2);
+    EXPECT_EQ(reader.line(), "1");
+
+    EXPECT_EQ(reader.nextLine(), true);
+    EXPECT_EQ(reader.lineNumber(), 3);
+    EXPECT_EQ(reader.isBlank(), true);
+    EXPECT_EQ(reader.isComment(), false);
+
+    EXPECT_EQ(reader.nextLine(), true);
+    EXPECT_EQ(reader.lineNumber(), 4);
+    EXPECT_EQ(reader.isComment(), true);
+
+    EXPECT_EQ(reader.nextLine(), true);
+    EXPECT_EQ(reader.lineNumber(), 5);
+    EXPECT_EQ(reader.split(), 2);
+    EXPECT_EQ(reader.numTokens(), 2);
+    EXPECT_EQ(reader.token(0).str(), "2");
+    EXPECT_EQ(reader.token(1).str(), "3");
+    EXPECT_EQ(reader.token(1).equals("3"), true);
+    EXPECT_EQ(reader.token(1).equals("33"), false);
+
+    EXPECT_EQ(reader.nextLine(), true);
+    EXPECT_EQ(reader.lineNumber(), 6);
+    EXPECT_EQ(reader.line(), "4");
+    EXPECT_EQ(reader.split(','), 1);
+
+    EXPECT_EQ(reader.nextLine(), true);
+    EXPECT_EQ(reader.split(), 3);
+    EXPECT_EQ(reader.token(0).str(), "5");
+    EXPECT_EQ(reader.token(1).str(), "6");
+    EXPECT_EQ(reader.token(2).str(), "7,8");
+    EXPECT_EQ(reader.split(','), 2);
+    EXPECT_EQ(reader.token(0).str(), "5\t 6\t7");
+
+    EXPECT_EQ(reader.nextLine(), false);
+    EXPECT_EQ(reader.numTokens(), 0);
+}
+
+
+/**  @brief integer conversion.
+ */
+TEST_F(TextSpecReaderTests, Test2) {
+
+    long val = 0;
+    EXPECT_EQ(toLong("0", val), true);
+    EXPECT_EQ(val, 0);
+    EXPECT_EQ(toLong("12345", val), true);
+    EXPECT_EQ(val, 12345);
+    EXPECT_EQ(toLong("-42", val), true);
+    EXPECT_EQ(val, -42);
+    EXPECT_EQ(toLong("+7", val), true);
+    EXPECT_EQ(val, 7);
+
+    EXPECT_EQ(toLong("9223372036854775807", val), true);
+    EXPECT_EQ(val, std::numeric_limits<long>::max());
+    EXPECT_EQ(toLong("-9223372036854775808", val), true);
+    EXPECT_EQ(val, std::numeric_limits<long>::min());
+
+    val = 99;
+    EXPECT_EQ(toLong("9223372036854775808", val), false);
+    EXPECT_EQ(toLong("-9223372036854775809", val), false);
+    EXPECT_EQ(toLong("99999999999999999999", val), false);
+    EXPECT_EQ(toLong("", val), false);
+    EXPECT_EQ(toLong("-", val), false);
+    EXPECT_EQ(toLong("12a", val), false);
+    EXPECT_EQ(toLong("1.5", val), false);
+    EXPECT_EQ(toLong("CENTER", val), false);
+    EXPECT_EQ(val, 99);
+}
+
+
+/**  @brief floating point conversion.
+ */
+TEST_F(TextSpecReaderTests, Test3) {
+
+    double val = 0.0;
+    EXPECT_EQ(toDouble("1.5", val), true);
+    EXPECT_EQ(val, 1.5);
+    EXPECT_EQ(toDouble("-2", val), true);
+    EXPECT_EQ(val, -2.0);
+    EXPECT_EQ(toDouble("1e3", val), true);
+    EXPECT_EQ(val, 1000.0);
+
+    val = 9.0;
+    EXPECT_EQ(toDouble("", val), false);
+    EXPECT_EQ(toDouble("1.5x", val), false);
+    EXPECT_EQ(toDouble("abc", val), false);
+    EXPECT_EQ(toDouble(std::string(100, '1'), val), false);
+    EXPECT_EQ(val, 9.0);
+}
+
+
+/**  @brief counting the lines for pre-sizing.
+ */
+TEST_F(TextSpecReaderTests, Test4) {
+
+    TextSpecReader reader;
+    loadString(reader, "NODES\n1\n2\n\n3\nEDGES\n1 2\n2 3");
+
+    EXPECT_EQ(reader.countLines(), 8);
+    EXPECT_EQ(reader.nextLine(), true);
+    EXPECT_EQ(reader.countLines(), 7);
+    EXPECT_EQ(reader.countSectionLines(), 4);
+
+    for (size_t i = 0; i < 5; i++) {
+        EXPECT_EQ(reader.nextLine(), true);
+    }
+    EXPECT_EQ(reader.startsWith("EDGES"), true);
+    EXPECT_EQ(reader.countSectionLines(), 2);
+
+    TextSpecReader empty;
+    loadString(empty, "");
+    EXPECT_EQ(empty.countLines(), 0);
+    EXPECT_EQ(empty.nextLine(), false);
+}
+
+
+/**  @brief mapped file gives the same lines as the stream.
+ */
+TEST_F(TextSpecReaderTests, Test5) {
+
+    std::string content = "GAPS\n1 2\n# c\nNODES\n10 20 30\n";
+    char        name[]  = "/tmp/wailea_text_spec_reader_XXXXXX";
+    int         fd      = mkstemp(name);
+    ASSERT_NE(fd, -1);
+    close(fd);
+    {
+        std::ofstream os(name);
+        os << content;
+    }
+
+    TextSpecReader fromFile;
+    EXPECT_EQ(fromFile.open(name), true);
+    TextSpecReader fromStream;
+    loadString(fromStream, content);
+
+    size_t numLines = 0;
+    while (fromFile.nextLine()) {
+        EXPECT_EQ(fromStream.nextLine(), true);
+        EXPECT_EQ(fromFile.lineNumber(), fromStream.lineNumber());
+        EXPECT_EQ(fromFile.line(), fromStream.line());
+        EXPECT_EQ(fromFile.split(), fromStream.split());
+        numLines++;
+    }
+    EXPECT_EQ(fromStream.nextLine(), false);
+    EXPECT_EQ(numLines, 5);
+
+    // Reopening resets the line number.
+    EXPECT_EQ(fromFile.open(name), true);
+    EXPECT_EQ(fromFile.nextLine(), true);
+    EXPECT_EQ(fromFile.lineNumber(), 1);
+    EXPECT_EQ(fromFile.line(), "GAPS");
+
+    std::remove(name);
+
+    TextSpecReader missing;
+    EXPECT_EQ(missing.open(name), false);
+    EXPECT_EQ(missing.nextLine(), false);
+}
+
+
+/**  @brief the two differences from the former std::getline and std::stol
+ *          parsing. The blank lines are counted in the line numbers, and
+ *          a number followed by other characters is rejected.
+ */
+TEST_F(TextSpecReaderTests, Test6) {
+
+    TextSpecReader reader;
+    loadString(reader, "NODES\n\n\n1\n\n12abc\n");
+
+    EXPECT_EQ(reader.nextLine(), true);
+    EXPECT_EQ(reader.lineNumber(), 1);
+
+    long val = 0;
+    while (reader.nextLine()) {
+        if (reader.isBlank()) {
+            continue;
+        }
+        EXPECT_EQ(reader.split(), 1);
+        if (!reader.token(0).toLong(val)) {
+            break;
+        }
+        EXPECT_EQ(val, 1);
+        EXPECT_EQ(reader.lineNumber(), 4);
+    }
+    // std::stol("12abc") gives 12, and the former parser reported it at
+    // line 3.
+    EXPECT_EQ(reader.lineNumber(), 6);
+    EXPECT_EQ(reader.token(0).str(), "12abc");
+    EXPECT_EQ(val, 1);
+
+    EXPECT_EQ(toLong("12abc", val), false);
+    EXPECT_EQ(toLong("12 ", val), false);
+    EXPECT_EQ(toLong(" 12", val), false);
+    EXPECT_EQ(val, 1);
+}
+
+
+} // namespace Undirected
+
+} // namespace Wailea
@@ -2807,6 +2807,64 @@ TEST_F(VisRepFinderTests, InnerFaceBottomCV04_nest4) {
 //    g.debugPrint();
 }
 
+
+/**  @brief PARALLEL must produce the same result as SEQUENTIAL bit by bit.
+ */
+TEST_F(VisRepFinderTests, ParallelExecution) {
+
+    const char* patterns[] = {
+        "./unit_tests/undirected/vis_rep_patterns/vr_test_pattern_30_nest4.txt",
+        "./unit_tests/undirected/vis_rep_patterns/vr_test_pattern_31_nest3.txt"
+    };
+
+    for (auto pattern : patterns) {
+
+        VisRepTestGraphParser p1;
+        p1.parseSpec(pattern);
+        VisRepTestGraphGenerator g1(p1);
+        g1.generateGraphs();
+        VisRepFinder vr1(g1.getEBCTree());
+        vr1.find();
+
+        VisRepTestGraphParser p2;
+        p2.parseSpec(pattern);
+        VisRepTestGraphGenerator g2(p2);
+        g2.generateGraphs();
+        VisRepFinder vr2(g2.getEBCTree());
+        vr2.setExecutionMode(VisRepFinder::PARALLEL, 4);
+        vr2.find();
+        EXPECT_EQ(g2.inspect(), true);
+
+        auto& LG1 = dynamic_cast<VRRectLabelGraph&>(
+                                       g1.getEBCTree().bcTree().original());
+        auto& LG2 = dynamic_cast<VRRectLabelGraph&>(
+                                       g2.getEBCTree().bcTree().original());
+        EXPECT_EQ(LG2.width(),  LG1.width());
+        EXPECT_EQ(LG2.height(), LG1.height());
+
+        auto nit2 = LG2.nodes().first;
+        for (auto nit1 = LG1.nodes().first; nit1 != LG1.nodes().second;
+                                                             nit1++, nit2++) {
+            auto& N1 = dynamic_cast<VRRectLabelNode&>(*(*nit1));
+            auto& N2 = dynamic_cast<VRRectLabelNode&>(*(*nit2));
+            EXPECT_EQ(N2.xLeft(),  N1.xLeft());
+            EXPECT_EQ(N2.xRight(), N1.xRight());
+            EXPECT_EQ(N2.y(),      N1.y());
+        }
+
+        auto eit2 = LG2.edges().first;
+        for (auto eit1 = LG1.edges().first; eit1 != LG1.edges().second;
+                                                             eit1++, eit2++) {
+            auto& E1 = dynamic_cast<VRRectLabelEdge&>(*(*eit1));
+            auto& E2 = dynamic_cast<VRRectLabelEdge&>(*(*eit2));
+            EXPECT_EQ(E2.x(),  E1.x());
+            EXPECT_EQ(E2.y1(), E1.y1());
+            EXPECT_EQ(E2.y2(), E1.y2());
+            EXPECT_EQ(E2.isFlipped(), E1.isFlipped());
+        }
+    }
+}
+
 } // namespace Undirected
 
 } // namespace Wailea